@@ -679,5 +679,8 @@ static const rtems_filesystem_file_handlers_r rtems_tfs_handlers = {
   .kqfilter_h = rtems_filesystem_default_kqfilter,
   .poll_h = rtems_filesystem_default_poll,
   .readv_h = rtems_filesystem_default_readv,
-  .writev_h = rtems_filesystem_default_writev
+  .writev_h = rtems_filesystem_default_writev,
+  .loan_h = rtems_filesystem_default_loan,
+  .preadv_h = rtems_filesystem_default_preadv,
+  .pwritev_h = rtems_filesystem_default_pwritev
 };
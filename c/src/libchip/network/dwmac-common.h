@@ -303,13 +303,16 @@ struct dwmac_common_desc_ops {
   /* Free tx data buffers */
   void (*release_tx_bufs) ( dwmac_common_context *self );
 
-  /* Invoked by the xmit function to prepare the tx descriptor */
+  /* Invoked by the xmit function to prepare the tx descriptor.  The
+   * csum_flags are the checksum offload flags (CSUM_*) of the frame, they are
+   * only relevant for the first descriptor of a frame. */
   void (*prepare_tx_desc) (
     dwmac_common_context *self,
     const unsigned int    idx,
     const bool            is_first,
     const size_t          len,
-    const void           *pdata );
+    const void           *pdata,
+    const int             csum_flags );
 
   /* Set/get the owner of the descriptor */
   void (*release_tx_ownership) (
@@ -948,13 +948,25 @@ static void dwmac_desc_enh_prepare_tx_desc(
   const unsigned int    idx,
   const bool            is_first,
   const size_t          len,
-  const void           *pdata )
+  const void           *pdata,
+  const int             csum_flags )
 {
   volatile dwmac_desc_ext *p_enh = (volatile dwmac_desc_ext *) self->dma_tx;
 
 
   if ( is_first ) {
     p_enh[idx].etx.des0_3.des0 |= DWMAC_DESC_ETX_DES0_FIRST_SEGMENT;
+
+    /* The stack provides the pseudo header checksum in the TCP or UDP
+     * checksum field, so the payload checksum mode without pseudo header
+     * calculation is used */
+    if ( ( csum_flags & ( CSUM_TCP | CSUM_UDP ) ) != 0 ) {
+      p_enh[idx].etx.des0_3.des0 |=
+        DWMAC_DESC_ETX_DES0_CHECKSUM_INSERTION_CONTROL( 2 );
+    } else if ( ( csum_flags & CSUM_IP ) != 0 ) {
+      p_enh[idx].etx.des0_3.des0 |=
+        DWMAC_DESC_ETX_DES0_CHECKSUM_INSERTION_CONTROL( 1 );
+    }
   }
 
   dwmac_desc_enh_set_tx_desc_len( &p_enh[idx], len );
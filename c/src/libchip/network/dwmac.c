@@ -974,6 +974,29 @@ static inline unsigned int dwmac_increment(
   }
 }
 
+/* Tell the stack about the checksums verified by the receive checksum
+ * offload engine.  Frames with checksum errors are already discarded.  The
+ * engine does not verify the payload of IP fragments. */
+static void dwmac_rx_csum(
+  const struct ifnet        *ifp,
+  const struct ether_header *eh,
+  struct mbuf               *m )
+{
+  if ( ( ifp->if_capenable & IFCAP_RXCSUM ) != 0
+       && eh->ether_type == htons( ETHERTYPE_IP )
+       && m->m_len >= (int) sizeof( struct ip ) ) {
+    const struct ip *ip = mtod( m, const struct ip * );
+
+    m->m_pkthdr.csum_flags = CSUM_IP_CHECKED | CSUM_IP_VALID;
+
+    if ( ( ip->ip_off & htons( IP_MF | IP_OFFMASK ) ) == 0
+         && ( ip->ip_p == IPPROTO_TCP || ip->ip_p == IPPROTO_UDP ) ) {
+      m->m_pkthdr.csum_flags |= CSUM_DATA_VALID | CSUM_PSEUDO_HDR;
+      m->m_pkthdr.csum_data   = 0xffff;
+    }
+  }
+}
+
 /* Receive task
  * It handles receiving frames */
 static void dwmac_task_rx( void *arg )
@@ -1127,6 +1150,10 @@ static void dwmac_task_rx( void *arg )
               p_m->m_pkthdr.len = sz;
               p_m->m_data       = mtod( p_m, char * ) + ETHER_HDR_LEN;
 
+              if ( is_first_seg && is_last_seg ) {
+                dwmac_rx_csum( &self->arpcom.ac_if, eh, p_m );
+              }
+
               DWMAC_COMMON_DSB();
 
               DWMAC_PRINT_DBG(
@@ -1544,7 +1571,9 @@ static void dwmac_task_tx( void *arg )
               idx_transmit,
               is_first,
               size,
-              mtod( p_m, const void * )
+              mtod( p_m, const void * ),
+              ( is_first && ( p_m->m_flags & M_PKTHDR ) != 0 ) ?
+              p_m->m_pkthdr.csum_flags : 0
               );
             self->mbuf_addr_tx[idx_transmit] = p_m;
 
@@ -1747,6 +1776,34 @@ static void dwmac_dma_operation_mode( dwmac_common_context *self )
   }
 }
 
+/* Advertise the checksum offload capabilities of the hardware.  They are
+ * enabled by default. */
+static void dwmac_set_capabilities( dwmac_common_context *self )
+{
+  struct ifnet *ifp          = &self->arpcom.ac_if;
+  int           capabilities = 0;
+  int           hwassist     = 0;
+
+
+  if ( ( self->dmagrp->hw_feature & DMAGRP_HW_FEATURE_RXTYP1COE ) != 0
+       || ( self->dmagrp->hw_feature & DMAGRP_HW_FEATURE_RXTYP2COE ) != 0 ) {
+    capabilities |= IFCAP_RXCSUM;
+  }
+
+  if ( ( self->dmagrp->hw_feature & DMAGRP_HW_FEATURE_TXOESEL ) != 0 ) {
+    capabilities |= IFCAP_TXCSUM;
+    hwassist     |= CSUM_IP | CSUM_TCP | CSUM_UDP;
+  }
+
+  if ( ifp->if_capabilities == 0 ) {
+    ifp->if_capenable = capabilities;
+  }
+
+  ifp->if_capabilities = capabilities;
+  ifp->if_capenable   &= capabilities;
+  ifp->if_hwassist     = hwassist;
+}
+
 static void dwmac_mmc_setup( dwmac_common_context *self )
 {
   /* Mask MMC irq, counters are managed in HW and registers
@@ -1811,6 +1868,7 @@ static int dwmac_if_up_or_down(
 
       /* Set the HW DMA mode and the COE */
       dwmac_dma_operation_mode( self );
+      dwmac_set_capabilities( self );
 
       /* Set up mmc counters */
       dwmac_mmc_setup( self );
@@ -1970,6 +2028,10 @@ static int dwmac_if_interface_ioctl(
       }
 #endif /* COMMENTED_OUT */
       break;
+    case SIOCSIFCAP:
+      /* The transmit checksum offload is selected per frame and the receive
+       * checksum status is evaluated depending on if_capenable */
+      break;
     case SIO_RTEMS_SHOW_STATS:
       eno = dwmac_if_interface_stats( self );
       break;
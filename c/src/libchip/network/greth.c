@@ -78,6 +78,12 @@ extern void ipalign(struct mbuf *m);
  /* event to send when tx buffers become available */
 #define GRETH_TX_WAIT_EVENT  RTEMS_EVENT_3
 
+/*
+ * Received frames are passed to the stack in batches of at most this many
+ * frames.  This must not exceed the IP input queue length.
+ */
+#define GRETH_RX_BATCH	16
+
 #if (MCLBYTES < RBUF_SIZE)
 # error "Driver must have MCLBYTES > RBUF_SIZE"
 #endif
@@ -148,6 +154,7 @@ struct greth_softc
    unsigned long rxInterrupts;
 
    unsigned long rxPackets;
+   unsigned long rxBatches;
    unsigned long rxLengthError;
    unsigned long rxNonOctet;
    unsigned long rxBadCRC;
@@ -287,6 +294,7 @@ greth_initialize_hardware (struct greth_softc *sc)
     /* Reset the controller.  */
     greth.rxInterrupts = 0;
     greth.rxPackets = 0;
+    greth.rxBatches = 0;
 
     regs->ctrl = 0;
     regs->ctrl = GRETH_CTRL_RST;	/* Reset ON */
@@ -533,6 +541,23 @@ void ipalign(struct mbuf *m)
 }
 #endif
 
+/*
+ * Pass the collected frames to the stack
+ */
+static void
+greth_rx_flush (struct greth_softc *dp, struct mbuf **head,
+                struct mbuf ***tail, int *count)
+{
+    if (*head != NULL)
+      {
+        ether_input_chain (&dp->arpcom.ac_if, *head);
+        dp->rxBatches++;
+        *head = NULL;
+        *tail = head;
+        *count = 0;
+      }
+}
+
 static void
 greth_Daemon (void *arg)
 {
@@ -540,6 +565,9 @@ greth_Daemon (void *arg)
     struct greth_softc *dp = (struct greth_softc *) &greth;
     struct ifnet *ifp = &dp->arpcom.ac_if;
     struct mbuf *m;
+    struct mbuf *head = NULL;
+    struct mbuf **tail = &head;
+    int count = 0;
     unsigned int len, len_status, bad;
     rtems_event_set events;
     rtems_interrupt_level level;
@@ -634,7 +662,17 @@ again:
                             }
 #endif
 
-                            ether_input (ifp, eh, m);
+                            if (mtod (m, struct ether_header *) - 1 == eh) {
+                                    /* collect the frame for ether_input_chain() */
+                                    *tail = m;
+                                    tail = &m->m_nextpkt;
+                                    if (++count == GRETH_RX_BATCH)
+                                            greth_rx_flush (dp, &head, &tail, &count);
+                            } else {
+                                    /* realigned, the header is elsewhere */
+                                    greth_rx_flush (dp, &head, &tail, &count);
+                                    ether_input (ifp, eh, m);
+                            }
                             MGETHDR (m, M_WAIT, MT_DATA);
                             MCLGET (m, M_WAIT);
                             if (dp->gbit_mac)
@@ -656,6 +694,8 @@ again:
                     dp->rx_ptr = (dp->rx_ptr + 1) % dp->rxbufs;
             }
 
+        greth_rx_flush (dp, &head, &tail, &count);
+
         /* Always scan twice to avoid deadlock */
         if ( first ){
             first=0;
@@ -1062,6 +1102,7 @@ greth_stats (struct greth_softc *sc)
 {
   printf ("      Rx Interrupts:%-8lu", sc->rxInterrupts);
   printf ("      Rx Packets:%-8lu", sc->rxPackets);
+  printf ("      Rx Batches:%-8lu", sc->rxBatches);
   printf ("          Length:%-8lu", sc->rxLengthError);
   printf ("       Non-octet:%-8lu\n", sc->rxNonOctet);
   printf ("            Bad CRC:%-8lu", sc->rxBadCRC);
@@ -108,6 +108,12 @@ struct MDRX
 #define OETH_SUSPEND_NOTXBUF
  */
 
+/*
+ * Received frames are passed to the stack in batches of at most this many
+ * frames.  This must not exceed the IP input queue length.
+ */
+#define OPEN_ETH_RX_BATCH	16
+
 #if (MCLBYTES < RBUF_SIZE)
 # error "Driver must have MCLBYTES > RBUF_SIZE"
 #endif
@@ -134,12 +140,14 @@ struct open_eth_softc
     struct MDRX *rxdesc;
     rtems_vector_number vector;
     unsigned int en100MHz;
+    unsigned int rxModeration;
 
     /*
      * Statistics
      */
     unsigned long rxInterrupts;
     unsigned long rxPackets;
+    unsigned long rxBatches;
     unsigned long rxLengthError;
     unsigned long rxNonOctet;
     unsigned long rxBadCRC;
@@ -176,6 +184,9 @@ open_eth_interrupt_handler (rtems_vector_number v)
     if (status & (OETH_INT_RXF | OETH_INT_RXE))
       {
 	  oc.rxInterrupts++;
+	  /* With RX moderation the RX daemon polls until the ring is empty */
+	  if (oc.rxModeration)
+	    oc.regs->int_mask &= ~(OETH_INT_MASK_RXF | OETH_INT_MASK_RXE);
 	  rtems_bsdnet_event_send (oc.rxDaemonTid, INTERRUPT_EVENT);
       }
 #ifdef OETH_SUSPEND_NOTXBUF
@@ -345,17 +356,40 @@ open_eth_initialize_hardware (struct open_eth_softc *sc)
     regs->moder |= OETH_MODER_RXEN | OETH_MODER_TXEN;
 }
 
+/*
+ * Pass the collected frames to the stack
+ */
+static void
+open_eth_rx_flush (struct open_eth_softc *dp, struct mbuf **head,
+		   struct mbuf ***tail, int *count)
+{
+    if (*head != NULL)
+      {
+	  ether_input_chain (&dp->arpcom.ac_if, *head);
+	  dp->rxBatches++;
+	  *head = NULL;
+	  *tail = head;
+	  *count = 0;
+      }
+}
+
 static void
 open_eth_rxDaemon (void *arg)
 {
+#ifdef CPU_U32_FIX
     struct ether_header *eh;
+#endif
     struct open_eth_softc *dp = (struct open_eth_softc *) &oc;
     struct ifnet *ifp = &dp->arpcom.ac_if;
     struct mbuf *m;
+    struct mbuf *head = NULL;
+    struct mbuf **tail = &head;
+    int count = 0;
     unsigned int len;
     uint32_t len_status;
     unsigned int bad;
     rtems_event_set events;
+    rtems_interrupt_level level;
 
 
     for (;;)
@@ -368,6 +402,7 @@ open_eth_rxDaemon (void *arg)
     printf ("r\n");
 #endif
 
+again:
 	  while (!
 		 ((len_status =
 		   dp->regs->xd[dp->rx_ptr+dp->txbufs].len_status) & OETH_RX_BD_EMPTY))
@@ -411,13 +446,22 @@ open_eth_rxDaemon (void *arg)
 		      m = (struct mbuf *) (dp->rxdesc[dp->rx_ptr].m);
 		      m->m_len = m->m_pkthdr.len =
 			  len - sizeof (struct ether_header);
+#ifdef CPU_U32_FIX
 		      eh = mtod (m, struct ether_header *);
 		      m->m_data += sizeof (struct ether_header);
-#ifdef CPU_U32_FIX
 	              ipalign(m);	/* Align packet on 32-bit boundary */
-#endif
 
+		      /* the header no longer precedes the data, no batching */
 		      ether_input (ifp, eh, m);
+#else
+		      m->m_data += sizeof (struct ether_header);
+
+		      /* collect the frame, ether_input_chain() finds the header */
+		      *tail = m;
+		      tail = &m->m_nextpkt;
+		      if (++count == OPEN_ETH_RX_BATCH)
+			open_eth_rx_flush (dp, &head, &tail, &count);
+#endif
 
 		      /* get a new mbuf */
 		      MGETHDR (m, M_WAIT, MT_DATA);
@@ -434,6 +478,21 @@ open_eth_rxDaemon (void *arg)
 		    ~OETH_TX_BD_STATS) | OETH_TX_BD_READY;
 		dp->rx_ptr = (dp->rx_ptr + 1) % dp->rxbufs;
 	    }
+
+	  open_eth_rx_flush (dp, &head, &tail, &count);
+
+	  /*
+	   * Enable the RX interrupts again and scan once more, a frame
+	   * may have arrived before they were enabled
+	   */
+	  if (dp->rxModeration &&
+	      !(dp->regs->int_mask & OETH_INT_MASK_RXF))
+	    {
+	      rtems_interrupt_disable (level);
+	      dp->regs->int_mask |= OETH_INT_MASK_RXF | OETH_INT_MASK_RXE;
+	      rtems_interrupt_enable (level);
+	      goto again;
+	    }
       }
 }
 
@@ -636,7 +695,8 @@ open_eth_stats (struct open_eth_softc *sc)
     printf ("Retransmit Limit:%-8lu", sc->txRetryLimit);
     printf ("  Late Collision:%-8lu\n", sc->txLateCollision);
     printf ("           Underrun:%-8lu", sc->txUnderrun);
-    printf (" Raw output wait:%-8lu\n", sc->txRawWait);
+    printf (" Raw output wait:%-8lu", sc->txRawWait);
+    printf ("      Rx Batches:%-8lu\n", sc->rxBatches);
 }
 
 /*
@@ -733,6 +793,7 @@ rtems_open_eth_driver_attach (struct rtems_bsdnet_ifconfig *config,
     sc->txbufs = chip->txd_count;
     sc->rxbufs = chip->rxd_count;
     sc->en100MHz = chip->en100MHz;
+    sc->rxModeration = chip->rx_moderation;
 
 
     /*
@@ -13,6 +13,7 @@ typedef struct {
   uint32_t                txd_count;
   uint32_t                rxd_count;
   uint32_t                en100MHz;
+  uint32_t                rx_moderation;   /* mask RX interrupts while polling */
 } open_eth_configuration_t;
 
 
@@ -0,0 +1,9 @@
+AC_DEFUN([RTEMS_ENABLE_JFFS2_SUMMARY],
+  [AC_ARG_ENABLE(jffs2-summary,
+    [AS_HELP_STRING([--enable-jffs2-summary],[enable the JFFS2 erase block summary support (default=yes)])],
+    [case "${enableval}" in 
+      yes) RTEMS_HAS_JFFS2_SUMMARY=yes ;;
+      no) RTEMS_HAS_JFFS2_SUMMARY=no ;;
+      *) AC_MSG_ERROR(bad value ${enableval} for enable jffs2-summary option) ;;
+    esac],
+    [RTEMS_HAS_JFFS2_SUMMARY=yes])])
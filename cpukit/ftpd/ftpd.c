@@ -141,6 +141,7 @@
  * MDTM xxx     - Send file modification date/time to the client.
  *                xxx = filename.
  * PASV         - Use passive mode data connection.
+ * REST xxx     - Restart the next RETR or STOR at file offset xxx.
  *
  *
  * The public routines contained in this file are:
@@ -264,6 +265,9 @@ typedef struct
   int                 idle;        /* Timeout in seconds */
   int                 xfer_mode;   /* Transfer mode (ASCII/binary) */
   rtems_id            tid;         /* Task id */
+  char                *data_buf;   /* Buffer for file transfers */
+  size_t              data_size;   /* Size of file transfer buffer */
+  off_t               restart;     /* Offset set by REST command */
   char                *user;       /* user name (0 if not supplied) */
   char                *pass;       /* password (0 if not supplied) */
   bool                auth;        /* true if user/pass was valid, false if not or not supplied */
@@ -277,6 +281,7 @@ typedef struct
 {
   FTPD_SessionInfo_t    *info;
   FTPD_SessionInfo_t    **queue;
+  char                  *data_bufs;
   int                   count;
   int                   head;
   int                   tail;
@@ -364,12 +369,15 @@ task_pool_done(int count)
     free(task_pool.info);
   if(task_pool.queue)
     free(task_pool.queue);
+  if(task_pool.data_bufs)
+    free(task_pool.data_bufs);
   if(task_pool.mutex != (rtems_id)-1)
     rtems_semaphore_delete(task_pool.mutex);
   if(task_pool.sem != (rtems_id)-1)
     rtems_semaphore_delete(task_pool.sem);
   task_pool.info = 0;
   task_pool.queue = 0;
+  task_pool.data_bufs = 0;
   task_pool.count = 0;
   task_pool.sem = -1;
   task_pool.mutex = -1;
@@ -381,8 +389,9 @@ task_pool_done(int count)
  * Initialize task pool.
  *
  * Input parameters:
- *   count    - number of entries in task pool to create
- *   priority - priority tasks are started with
+ *   count     - number of entries in task pool to create
+ *   priority  - priority tasks are started with
+ *   data_size - size of the file transfer buffer of each task
  *
  * Output parameters:
  *   returns 1 on success, 0 on failure.
@@ -391,7 +400,7 @@ task_pool_done(int count)
 static void session(rtems_task_argument arg); /* Forward declare */
 
 static int
-task_pool_init(int count, rtems_task_priority priority)
+task_pool_init(int count, rtems_task_priority priority, size_t data_size)
 {
   int i;
   rtems_status_code sc;
@@ -430,7 +439,9 @@ task_pool_init(int count, rtems_task_priority priority)
     malloc(sizeof(FTPD_SessionInfo_t) * count);
   task_pool.queue = (FTPD_SessionInfo_t**)
     malloc(sizeof(FTPD_SessionInfo_t*) * count);
-  if (NULL == task_pool.info || NULL == task_pool.queue)
+  task_pool.data_bufs = (char*)malloc(data_size * count);
+  if (NULL == task_pool.info || NULL == task_pool.queue ||
+    NULL == task_pool.data_bufs)
   {
     task_pool_done(0);
     syslog(LOG_ERR, "ftpd: Not enough memory");
@@ -440,6 +451,8 @@ task_pool_init(int count, rtems_task_priority priority)
   for(i = 0; i < count; ++i)
   {
     FTPD_SessionInfo_t *info = &task_pool.info[i];
+    info->data_buf = task_pool.data_bufs + i * data_size;
+    info->data_size = data_size;
     sc = rtems_task_create(rtems_build_name('F', 'T', 'P', id),
       priority, FTPD_STACKSIZE,
       RTEMS_PREEMPT | RTEMS_NO_TIMESLICE |
@@ -769,17 +782,19 @@ send_mode_reply(FTPD_SessionInfo_t *info)
  * Input parameters:
  *   info - corresponding SessionInfo structure
  *   char *filename  - source filename.
+ *   restart - file offset to start the transfer at
  *
  * Output parameters:
  *   NONE
  *
  */
 static void
-command_retrieve(FTPD_SessionInfo_t  *info, char const *filename)
+command_retrieve(FTPD_SessionInfo_t  *info, char const *filename,
+  off_t restart)
 {
   int                 s = -1;
   int                 fd = -1;
-  char                buf[FTPD_DATASIZE];
+  char                *buf = info->data_buf;
   struct stat         stat_buf;
   int                 res = 0;
 
@@ -813,16 +828,17 @@ command_retrieve(FTPD_SessionInfo_t  *info, char const *filename)
 
     if(info->xfer_mode == TYPE_I)
     {
-      while ((n = read(fd, buf, FTPD_DATASIZE)) > 0)
-      {
-        if(send(s, buf, n, 0) != n)
-          break;
-      }
+      /* Let the network stack send the file data without a copy into buf */
+      off_t sent;
+
+      if (0 == sendfile(fd, s, restart, 0, NULL, &sent, 0))
+        n = 0;
     }
-    else if (info->xfer_mode == TYPE_A)
+    else if (info->xfer_mode == TYPE_A &&
+      (restart == 0 || lseek(fd, restart, SEEK_SET) == restart))
     {
       int rest = 0;
-      while (rest == 0 && (n = read(fd, buf, FTPD_DATASIZE)) > 0)
+      while (rest == 0 && (n = read(fd, buf, info->data_size)) > 0)
       {
         char const* e = buf;
         char const* b;
@@ -909,18 +925,20 @@ discard(int fd, void const* buf, size_t count)
  * Input parameters:
  *   info - corresponding SessionInfo structure
  *   char *filename   - Destination filename.
+ *   restart - file offset to start the transfer at, the file is not
+ *             truncated if this is not zero
  *
  * Output parameters:
  *   NONE
  */
 static void
-command_store(FTPD_SessionInfo_t *info, char const *filename)
+command_store(FTPD_SessionInfo_t *info, char const *filename, off_t restart)
 {
   int                    s;
   int                    n;
   unsigned long          size = 0;
   struct rtems_ftpd_hook *usehook = NULL;
-  char                   buf[FTPD_DATASIZE];
+  char                   *buf = info->data_buf;
   int                    res = 1;
   int                    bare_lfs = 0;
   int                    null = 0;
@@ -1026,8 +1044,15 @@ command_store(FTPD_SessionInfo_t *info, char const *filename)
     int fd = 0;
 
     if(!null)
-      fd = creat(filename,
+    {
+      fd = open(filename, O_WRONLY | O_CREAT | (restart == 0 ? O_TRUNC : 0),
         S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH);
+      if (0 <= fd && restart != 0 && lseek(fd, restart, SEEK_SET) != restart)
+      {
+        close(fd);
+        fd = -1;
+      }
+    }
 
     if (0 > fd)
     {
@@ -1038,7 +1063,8 @@ command_store(FTPD_SessionInfo_t *info, char const *filename)
 
     if(info->xfer_mode == TYPE_I)
     {
-      while ((n = recv(s, buf, FTPD_DATASIZE, 0)) > 0)
+      /* Fill the buffer to write the file in large chunks */
+      while ((n = recv(s, buf, info->data_size, MSG_WAITALL)) > 0)
       {
         if (wrt(fd, buf, n) != n)
         {
@@ -1051,7 +1077,7 @@ command_store(FTPD_SessionInfo_t *info, char const *filename)
     {
       int rest = 0;
       int pended_cr = 0;
-      while (res && rest == 0 && (n = recv(s, buf, FTPD_DATASIZE, 0)) > 0)
+      while (res && rest == 0 && (n = recv(s, buf, info->data_size, 0)) > 0)
       {
         char const* e = buf;
         char const* b;
@@ -1443,6 +1469,46 @@ command_size(FTPD_SessionInfo_t *info, char const* fname)
   }
 }
 
+/*
+ * command_rest
+ *
+ * Perform the "REST" command (set offset for the next transfer).  Several
+ * sessions may use this to transfer segments of one file in parallel.  The
+ * offset stays set across other commands, e.g. PASV or PORT, and is consumed
+ * by the next RETR or STOR.  An invalid offset clears it.
+ *
+ * Input parameters:
+ *   info - corresponding SessionInfo structure
+ *   args - arguments to the "REST" command
+ *
+ * Output parameters:
+ *   info->restart is set to the offset on success and to zero otherwise.
+ */
+static void
+command_rest(FTPD_SessionInfo_t *info, char const *args)
+{
+  char buf[FTPD_BUFSIZE];
+  char *end;
+  uintmax_t offset;
+
+  errno = 0;
+  offset = strtoumax(args, &end, 10);
+  if (end == args || *end != '\0' || errno != 0 || (off_t) offset < 0 ||
+    (uintmax_t) (off_t) offset != offset)
+  {
+    errno = 0;
+    info->restart = 0;
+    send_reply(info, 501, "Invalid restart offset.");
+  }
+  else
+  {
+    info->restart = (off_t) offset;
+    snprintf(buf, FTPD_BUFSIZE,
+      "Restarting at %" PRIuMAX ". Send STORE or RETRIEVE.", offset);
+    send_reply(info, 350, buf);
+  }
+}
+
 /*
  * command_port
  *
@@ -1688,6 +1754,7 @@ exec_command(FTPD_SessionInfo_t *info, char* cmd, char* args)
 {
   char fname[FTPD_BUFSIZE];
   int wrong_command = 0;
+  off_t restart = info->restart;
 
   fname[0] = '\0';
 
@@ -1702,12 +1769,18 @@ exec_command(FTPD_SessionInfo_t *info, char* cmd, char* args)
   else if (!strcmp("RETR", cmd))
   {
     strncpy(fname, args, 254);
-    command_retrieve(info, fname);
+    info->restart = 0;
+    command_retrieve(info, fname, restart);
   }
   else if (!strcmp("STOR", cmd))
   {
     strncpy(fname, args, 254);
-    command_store(info, fname);
+    info->restart = 0;
+    command_store(info, fname, restart);
+  }
+  else if (!strcmp("REST", cmd))
+  {
+    command_rest(info, args);
   }
   else if (!strcmp("LIST", cmd))
   {
@@ -2009,7 +2082,7 @@ daemon(rtems_task_argument args __attribute__((unused)))
 
   if (0 > bind(s, (struct sockaddr *)&addr, sizeof(addr)))
     syslog(LOG_ERR, "ftpd: Error binding control socket: %s", serr());
-  else if (0 > listen(s, 1))
+  else if (0 > listen(s, rtems_ftpd_configuration.tasks_count))
     syslog(LOG_ERR, "ftpd: Error listening on control socket: %s", serr());
   else while (1)
   {
@@ -2053,6 +2126,7 @@ daemon(rtems_task_argument args __attribute__((unused)))
             info->pasv_socket = -1;
             info->data_socket = -1;
             info->xfer_mode   = TYPE_A;
+            info->restart     = 0;
             info->data_addr.sin_port =
               htons(ntohs(info->ctrl_addr.sin_port) - 1);
             info->idle = ftpd_timeout;
@@ -2093,6 +2167,7 @@ rtems_initialize_ftpd(void)
   rtems_id            tid;
   rtems_task_priority priority;
   int count;
+  size_t data_size;
 
   if (rtems_ftpd_configuration.port == 0)
   {
@@ -2123,7 +2198,11 @@ rtems_initialize_ftpd(void)
     rtems_ftpd_configuration.tasks_count = 1;
   count = rtems_ftpd_configuration.tasks_count;
 
-  if (!task_pool_init(count, priority))
+  if (rtems_ftpd_configuration.data_buffer_size < FTPD_DATASIZE)
+    rtems_ftpd_configuration.data_buffer_size = FTPD_DATASIZE;
+  data_size = rtems_ftpd_configuration.data_buffer_size;
+
+  if (!task_pool_init(count, priority, data_size))
   {
     syslog(LOG_ERR, "ftpd: Could not initialize task pool.");
     return RTEMS_UNSATISFIED;
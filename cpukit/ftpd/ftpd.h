@@ -54,6 +54,9 @@ struct rtems_ftpd_configuration
                                                   3 - browse-only */
    rtems_shell_login_check_t login;            /* Login check or 0 to ignore
                                                   user/passwd. */
+   size_t                  data_buffer_size;   /* Size of file transfer
+                                                  buffer of each session,
+                                                  at least FTPD_DATASIZE */
 };
 
 /*
@@ -102,6 +102,9 @@ int	copyinuio(struct iovec *iovp, u_int iovcnt, struct uio **uiop);
 void	uio_yield(void);
 int	uiomove(void *cp, int n, struct uio *uio);
 int	uiomove_frombuf(void *buf, int buflen, struct uio *uio);
+#ifdef __rtems__
+int	uiomove_cksum(void *cp, int n, struct uio *uio, u_short *sum);
+#endif /* __rtems__ */
 #ifndef __rtems__
 int	uiomove_fromphys(struct vm_page *ma[], vm_offset_t offset, int n,
 	    struct uio *uio);
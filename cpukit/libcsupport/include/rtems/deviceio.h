@@ -78,6 +78,20 @@ int rtems_deviceio_control(
   rtems_device_minor_number minor
 );
 
+/**
+ * @brief Attaches a kernel event filter to a device.
+ *
+ * The filter is passed to the driver control entry with the
+ * RTEMS_IO_KQFILTER command.  Drivers which do not support this command, for
+ * example drivers without a termios back end, yield EINVAL.
+ */
+int rtems_deviceio_kqfilter(
+  rtems_libio_t *iop,
+  struct knote *kn,
+  rtems_device_major_number major,
+  rtems_device_minor_number minor
+);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1022,6 +1022,112 @@ typedef int (*rtems_filesystem_kqfilter_t)(
   struct knote *kn
 );
 
+/**
+ * @brief File data lent by a file system.
+ *
+ * @see rtems_filesystem_loan_t.
+ */
+typedef struct rtems_filesystem_loan rtems_filesystem_loan;
+
+struct rtems_filesystem_loan {
+  /**
+   * @brief Start of the lent file data.
+   */
+  const void *data;
+
+  /**
+   * @brief Returns the file data to the file system.
+   *
+   * May be NULL.  This handler may be called by another task.
+   */
+  void (*release)( rtems_filesystem_loan *loan );
+
+  /**
+   * @brief Argument of the release handler.
+   */
+  void *arg;
+};
+
+/**
+ * @brief Lends file data to the caller.
+ *
+ * The file system provides a pointer to the file data at the offset instead
+ * of copying it into a buffer.  This is used by sendfile() to attach file
+ * data to network buffers.  The file data stays valid until the release
+ * handler of the loan is called.  The caller must not change the file data.
+ * The file offset of the IO descriptor is not changed.
+ *
+ * @param[in, out] iop The IO pointer.
+ * @param[in] offset The file offset of the data.
+ * @param[in] count The maximum count of bytes to lend.
+ * @param[out] loan The loan.  Valid only if a positive count is returned.
+ *
+ * @retval positive Count of lent contiguous bytes.  This may be less than
+ * the requested count, for example at the end of a file block.
+ * @retval 0 The offset is at or beyond the end of file.
+ * @retval -1 An error occurred.  The errno is set to indicate the error.  A
+ * file system which cannot lend its data sets the errno to ENOTSUP.
+ *
+ * @see rtems_filesystem_default_loan().
+ */
+typedef ssize_t (*rtems_filesystem_loan_t)(
+  rtems_libio_t *iop,
+  off_t offset,
+  size_t count,
+  rtems_filesystem_loan *loan
+);
+
+/**
+ * @brief Reads an IO vector from a node at a file offset.
+ *
+ * This handler must not change the offset field of the IO descriptor.
+ *
+ * @param[in, out] iop The IO pointer.
+ * @param[in] iov The IO vector with buffer for read data.  The caller must
+ * ensure that the IO vector values are valid.
+ * @param[in] iovcnt The count of buffers in the IO vector.
+ * @param[in] offset The non-negative file offset to start reading at.
+ * @param[in] total The total count of bytes in the buffers in the IO vector.
+ *
+ * @retval non-negative Count of read characters.
+ * @retval -1 An error occurred.  The errno is set to indicate the error.
+ *
+ * @see rtems_filesystem_default_preadv().
+ */
+typedef ssize_t (*rtems_filesystem_preadv_t)(
+  rtems_libio_t      *iop,
+  const struct iovec *iov,
+  int                 iovcnt,
+  off_t               offset,
+  ssize_t             total
+);
+
+/**
+ * @brief Writes an IO vector to a node at a file offset.
+ *
+ * This handler must not change the offset field of the IO descriptor.  The
+ * data is written at the offset even if the file is open for append.
+ *
+ * @param[in, out] iop The IO pointer.
+ * @param[in] iov The IO vector with buffer for write data.  The caller must
+ * ensure that the IO vector values are valid.
+ * @param[in] iovcnt The count of buffers in the IO vector.
+ * @param[in] offset The non-negative file offset to start writing at.
+ * @param[in] total The total count of bytes in the buffers in the IO vector.
+ *
+ * @retval non-negative Count of written characters.
+ * @retval -1 An error occurred.  The errno is set to indicate the error.
+ *
+ * @see rtems_filesystem_default_pwritev().
+ */
+typedef ssize_t (*rtems_filesystem_pwritev_t)(
+  rtems_libio_t      *iop,
+  const struct iovec *iov,
+  int                 iovcnt,
+  off_t               offset,
+  ssize_t             total
+);
+
 /**
  * @brief File system node operations table.
  */
@@ -1041,6 +1147,9 @@ struct _rtems_filesystem_file_handlers_r {
   rtems_filesystem_kqfilter_t kqfilter_h;
   rtems_filesystem_readv_t readv_h;
   rtems_filesystem_writev_t writev_h;
+  rtems_filesystem_loan_t loan_h;
+  rtems_filesystem_preadv_t preadv_h;
+  rtems_filesystem_pwritev_t pwritev_h;
 };
 
 /**
@@ -1262,6 +1371,50 @@ int rtems_filesystem_default_kqfilter(
   struct knote *kn
 );
 
+/**
+ * @brief Default loan handler.
+ *
+ * @retval -1 Always.  The errno is set to ENOTSUP.
+ *
+ * @see rtems_filesystem_loan_t.
+ */
+ssize_t rtems_filesystem_default_loan(
+  rtems_libio_t *iop,
+  off_t offset,
+  size_t count,
+  rtems_filesystem_loan *loan
+);
+
+/**
+ * @retval -1 Always.  The errno is set to ESPIPE.
+ *
+ * File systems with seekable nodes must provide a native handler.
+ *
+ * @see rtems_filesystem_preadv_t.
+ */
+ssize_t rtems_filesystem_default_preadv(
+  rtems_libio_t      *iop,
+  const struct iovec *iov,
+  int                 iovcnt,
+  off_t               offset,
+  ssize_t             total
+);
+
+/**
+ * @retval -1 Always.  The errno is set to ESPIPE.
+ *
+ * File systems with seekable nodes must provide a native handler.
+ *
+ * @see rtems_filesystem_pwritev_t.
+ */
+ssize_t rtems_filesystem_default_pwritev(
+  rtems_libio_t      *iop,
+  const struct iovec *iov,
+  int                 iovcnt,
+  off_t               offset,
+  ssize_t             total
+);
+
 /** @} */
 
 /**
@@ -1328,6 +1481,7 @@ struct rtems_libio_tt {
   rtems_driver_name_t                    *driver;
   off_t                                   offset;    /* current offset into file */
   uint32_t                                flags;
+  uint32_t                                reference_count; /* operations in progress */
   rtems_filesystem_location_info_t        pathinfo;
   uint32_t                                data0;     /* private to "driver" */
   void                                   *data1;     /* ... */
@@ -1379,6 +1533,7 @@ typedef struct {
 #define LIBIO_FLAGS_APPEND        0x0200U  /* all writes append */
 #define LIBIO_FLAGS_CREATE        0x0400U  /* create file */
 #define LIBIO_FLAGS_CLOSE_ON_EXEC 0x0800U  /* close on process exec() */
+#define LIBIO_FLAGS_FREE_PENDING  0x1000U  /* free after last operation */
 #define LIBIO_FLAGS_READ_WRITE    (LIBIO_FLAGS_READ | LIBIO_FLAGS_WRITE)
 
 /** @} */
@@ -1570,6 +1725,7 @@ extern int rtems_mkdir(const char *path, mode_t mode);
 #define RTEMS_FILESYSTEM_TYPE_DOSFS "dosfs"
 #define RTEMS_FILESYSTEM_TYPE_RFS "rfs"
 #define RTEMS_FILESYSTEM_TYPE_JFFS2 "jffs2"
+#define RTEMS_FILESYSTEM_TYPE_CROMFS "cromfs"
 
 /** @} */
 
@@ -1696,6 +1852,7 @@ int unmount(
  *
  * To mount a standard file system instance one of the following defines should
  * be used to select the file system type
+ * - RTEMS_FILESYSTEM_TYPE_CROMFS,
  * - RTEMS_FILESYSTEM_TYPE_DEVFS,
  * - RTEMS_FILESYSTEM_TYPE_DOSFS,
  * - RTEMS_FILESYSTEM_TYPE_FTPFS,
@@ -1709,6 +1866,7 @@ int unmount(
  * Only configured or registered file system types are available.  You can add
  * file system types to your application configuration with the following
  * configuration options
+ * - CONFIGURE_FILESYSTEM_CROMFS,
  * - CONFIGURE_FILESYSTEM_DEVFS,
  * - CONFIGURE_FILESYSTEM_DOSFS,
  * - CONFIGURE_FILESYSTEM_FTPFS,
@@ -1739,8 +1897,8 @@ int unmount(
  * @retval 0 Successful operation.
  * @retval -1 An error occurred.  The @c errno indicates the error.
  *
- * @see rtems_filesystem_register(), mount_and_make_target_path(), @ref DOSFS
- * and @ref JFFS2.
+ * @see rtems_filesystem_register(), mount_and_make_target_path(), @ref CROMFS,
+ * @ref DOSFS and @ref JFFS2.
  */
 int mount(
   const char                 *source,
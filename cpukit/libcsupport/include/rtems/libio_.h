@@ -253,6 +253,56 @@ static inline void rtems_libio_unlock( void )
   rtems_semaphore_release( rtems_libio_semaphore );
 }
 
+/**
+ * @brief Protects the free list and the reference counts of the file
+ * descriptor table.
+ *
+ * This is an interrupt lock and not the libio semaphore, so that open() and
+ * close() bursts do not serialize on a blocking lock.
+ */
+extern rtems_interrupt_lock rtems_libio_iop_lock_control;
+
+#define rtems_libio_iop_declare_lock_context( ctx ) \
+  rtems_interrupt_lock_context ctx
+
+#define rtems_libio_iop_lock( ctx ) \
+  rtems_interrupt_lock_acquire( &rtems_libio_iop_lock_control, &ctx )
+
+#define rtems_libio_iop_unlock( ctx ) \
+  rtems_interrupt_lock_release( &rtems_libio_iop_lock_control, &ctx )
+
+/**
+ * @brief Obtains a reference to an open file descriptor for an operation.
+ *
+ * While the reference is held, a concurrent close() does not return the file
+ * descriptor to the free list.  Release the reference with
+ * rtems_libio_iop_drop().
+ *
+ * @retval true The file descriptor is open and the reference is obtained.
+ * @retval false The file descriptor is not open.
+ */
+static inline bool rtems_libio_iop_hold( rtems_libio_t *iop )
+{
+  bool open;
+  rtems_libio_iop_declare_lock_context( lock_context );
+
+  rtems_libio_iop_lock( lock_context );
+  open = ( iop->flags & LIBIO_FLAGS_OPEN ) != 0;
+  if ( open ) {
+    ++iop->reference_count;
+  }
+  rtems_libio_iop_unlock( lock_context );
+
+  return open;
+}
+
+/**
+ * @brief Releases a reference obtained by rtems_libio_iop_hold().
+ *
+ * The last reference of a closed file descriptor frees it.
+ */
+void rtems_libio_iop_drop( rtems_libio_t *iop );
+
 static inline void rtems_filesystem_mt_lock( void )
 {
   rtems_libio_lock();
@@ -314,12 +364,22 @@ int rtems_libio_to_fcntl_flags( uint32_t flags );
 
 /**
  * This routine frees the resources associated with an IOP (file descriptor)
- * and clears the slot in the IOP Table.
+ * and clears the slot in the IOP Table.  In case operations obtained by
+ * rtems_libio_iop_hold() are still in progress, the last
+ * rtems_libio_iop_drop() frees it.
  */
 void rtems_libio_free(
   rtems_libio_t *iop
 );
 
+/**
+ * @brief Removes the kevent() registrations of a file descriptor.
+ *
+ * This handler is called by close().  It is installed by the first kqueue()
+ * call, so that close() does not search the event queues if none exists.
+ */
+extern void (*rtems_libio_kqueue_fdclose)( int fd );
+
 /*
  *  File System Routine Prototypes
  */
@@ -21,6 +21,7 @@
 #include <rtems/assoc.h>
 #include <stdint.h>
 #include <termios.h>
+#include <sys/event.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -52,6 +53,48 @@ struct rtems_termios_rawbuf {
   volatile unsigned int  Size;
   rtems_id    Semaphore;
 };
+/**
+ * @brief Termios statistics.
+ *
+ * The counters are maintained for interrupt and task driven devices, polled
+ * devices only maintain the transmit counters.  An application may determine
+ * the throughput via the differences of two samples.
+ *
+ * @see RTEMS_IO_GET_STATISTICS.
+ */
+typedef struct {
+  /**
+   * @brief Count of received characters placed into the raw input buffer.
+   */
+  uint64_t rx_characters;
+
+  /**
+   * @brief Count of received characters dropped due to a raw input buffer
+   * overflow.
+   */
+  uint64_t rx_dropped;
+
+  /**
+   * @brief Count of rtems_termios_enqueue_raw_characters() invocations.
+   */
+  uint64_t rx_bursts;
+
+  /**
+   * @brief Count of read operations served by the raw mode fast path.
+   */
+  uint64_t rx_raw_reads;
+
+  /**
+   * @brief Count of characters reported as transmitted by the device.
+   */
+  uint64_t tx_characters;
+
+  /**
+   * @brief Count of device write invocations with characters to transmit.
+   */
+  uint64_t tx_bursts;
+} rtems_termios_statistics;
+
 /*
  * Variables associated with each termios instance.
  * One structure for each hardware I/O device.
@@ -115,6 +158,11 @@ struct rtems_termios_tty {
   int  t_dqlen; /* count of characters dequeued from device */
   enum {rob_idle, rob_busy, rob_wait }  rawOutBufState;
 
+  /*
+   * Statistics, see RTEMS_IO_GET_STATISTICS
+   */
+  rtems_termios_statistics statistics;
+
   /*
    * Callbacks to device-specific routines
    */
@@ -141,6 +189,12 @@ struct rtems_termios_tty {
   struct ttywakeup tty_rcv;
   int              tty_rcvwakeup;
 
+  /*
+   * kevent() filters
+   */
+  struct knlist    tty_rnote;
+  struct knlist    tty_wnote;
+
   rtems_interrupt_lock interrupt_lock;
 };
 
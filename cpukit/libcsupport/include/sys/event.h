@@ -145,7 +145,11 @@ struct knlist {
 };
 
 
-#ifdef _KERNEL
+/*
+ * RTEMS: The kevent() support of the file system handlers and the termios
+ * devices is not compiled with _KERNEL, it defines _WANT_KNOTE instead.
+ */
+#if defined(_KERNEL) || defined(_WANT_KNOTE)
 
 #ifdef MALLOC_DECLARE
 MALLOC_DECLARE(M_KQUEUE);
@@ -262,7 +266,9 @@ extern int 	kqfd_register(int fd, struct kevent *kev, struct thread *p,
 extern int	kqueue_add_filteropts(int filt, struct filterops *filtops);
 extern int	kqueue_del_filteropts(int filt);
 
-#else 	/* !_KERNEL */
+#endif /* _KERNEL || _WANT_KNOTE */
+
+#ifndef _KERNEL
 
 #include <sys/cdefs.h>
 struct timespec;
@@ -20,18 +20,40 @@
 
 #include <rtems/libio_.h>
 
+void (*rtems_libio_kqueue_fdclose)( int fd );
+
 int close(
   int  fd
 )
 {
   rtems_libio_t      *iop;
   int                 rc;
+  bool                open;
+  rtems_libio_iop_declare_lock_context( lock_context );
 
   rtems_libio_check_fd(fd);
   iop = rtems_libio_iop(fd);
   rtems_libio_check_is_open(iop);
 
+  if ( rtems_libio_kqueue_fdclose != NULL ) {
+    (*rtems_libio_kqueue_fdclose)( fd );
+  }
+
+  /*
+   *  Only one of concurrent close() calls may close the file.  The close
+   *  handler runs immediately even if operations obtained by
+   *  rtems_libio_iop_hold() still use the file, since it aborts blocked
+   *  operations, e.g. a read() of a socket or pipe.  Only the reuse of the
+   *  descriptor waits for the last reference, see rtems_libio_free().
+   */
+  rtems_libio_iop_lock( lock_context );
+  open = ( iop->flags & LIBIO_FLAGS_OPEN ) != 0;
   iop->flags &= ~LIBIO_FLAGS_OPEN;
+  rtems_libio_iop_unlock( lock_context );
+
+  if ( !open ) {
+    rtems_set_errno_and_return_minus_one( EBADF );
+  }
 
   rc = (*iop->pathinfo.handlers->close_h)( iop );
 
@@ -110,11 +110,16 @@ static int vfcntl(
   int            flags;
   int            mask;
   int            ret = 0;
+  rtems_libio_iop_declare_lock_context( lock_context );
 
   rtems_libio_check_fd( fd );
   iop = rtems_libio_iop( fd );
   rtems_libio_check_is_open(iop);
 
+  if ( !rtems_libio_iop_hold( iop ) ) {
+    rtems_set_errno_and_return_minus_one( EBADF );
+  }
+
   /*
    *  Now process the fcntl().
    */
@@ -146,10 +151,17 @@ static int vfcntl(
        *  F_GETFD work.
        */
 
-      if ( va_arg( ap, int ) )
+      flags = va_arg( ap, int );
+
+      /*
+       *  A concurrent close() changes the flags under the lock as well.
+       */
+      rtems_libio_iop_lock( lock_context );
+      if ( flags )
         iop->flags |= LIBIO_FLAGS_CLOSE_ON_EXEC;
       else
         iop->flags &= ~LIBIO_FLAGS_CLOSE_ON_EXEC;
+      rtems_libio_iop_unlock( lock_context );
       break;
 
     case F_GETFL:        /* more flags (cloexec) */
@@ -164,7 +176,9 @@ static int vfcntl(
        *  XXX If we are turning on append, should we seek to the end?
        */
 
+      rtems_libio_iop_lock( lock_context );
       iop->flags = (iop->flags & ~mask) | (flags & mask);
+      rtems_libio_iop_unlock( lock_context );
       break;
 
     case F_GETLK:
@@ -210,6 +224,9 @@ static int vfcntl(
       ret = -1;
     }
   }
+
+  rtems_libio_iop_drop( iop );
+
   return ret;
 }
 
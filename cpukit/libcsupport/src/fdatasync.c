@@ -28,15 +28,24 @@ int fdatasync(
 )
 {
   rtems_libio_t *iop;
+  int            rv;
 
   rtems_libio_check_fd( fd );
   iop = rtems_libio_iop( fd );
   rtems_libio_check_is_open(iop);
   rtems_libio_check_permissions_with_error( iop, LIBIO_FLAGS_WRITE, EBADF );
 
+  if ( !rtems_libio_iop_hold( iop ) ) {
+    rtems_set_errno_and_return_minus_one( EBADF );
+  }
+
   /*
    *  Now process the fdatasync().
    */
 
-  return (*iop->pathinfo.handlers->fdatasync_h)( iop );
+  rv = (*iop->pathinfo.handlers->fdatasync_h)( iop );
+
+  rtems_libio_iop_drop( iop );
+
+  return rv;
 }
@@ -26,6 +26,7 @@ int fstat(
 )
 {
   rtems_libio_t *iop;
+  int            rv;
 
   /*
    *  Check to see if we were passed a valid pointer.
@@ -40,13 +41,21 @@ int fstat(
   rtems_libio_check_fd( fd );
   rtems_libio_check_is_open(iop);
 
+  if ( !rtems_libio_iop_hold( iop ) ) {
+    rtems_set_errno_and_return_minus_one( EBADF );
+  }
+
   /*
    *  Zero out the stat structure so the various support
    *  versions of stat don't have to.
    */
   memset( sbuf, 0, sizeof(struct stat) );
 
-  return (*iop->pathinfo.handlers->fstat_h)( &iop->pathinfo, sbuf );
+  rv = (*iop->pathinfo.handlers->fstat_h)( &iop->pathinfo, sbuf );
+
+  rtems_libio_iop_drop( iop );
+
+  return rv;
 }
 
 /*
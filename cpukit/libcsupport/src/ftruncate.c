@@ -34,7 +34,13 @@ int ftruncate( int fd, off_t length )
     rtems_libio_check_is_open( iop );
     rtems_libio_check_permissions( iop, LIBIO_FLAGS_WRITE );
 
+    if ( !rtems_libio_iop_hold( iop ) ) {
+      rtems_set_errno_and_return_minus_one( EBADF );
+    }
+
     rv = (*iop->pathinfo.handlers->ftruncate_h)( iop, length );
+
+    rtems_libio_iop_drop( iop );
   } else {
     errno = EINVAL;
     rv = -1;
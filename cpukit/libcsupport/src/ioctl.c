@@ -43,6 +43,10 @@ int ioctl(
   iop = rtems_libio_iop( fd );
   rtems_libio_check_is_open(iop);
 
+  if ( !rtems_libio_iop_hold( iop ) ) {
+    rtems_set_errno_and_return_minus_one( EBADF );
+  }
+
   va_start(ap, command);
 
   buffer = va_arg(ap, void *);
@@ -53,5 +57,8 @@ int ioctl(
   rc = (*iop->pathinfo.handlers->ioctl_h)( iop, command, buffer );
 
   va_end( ap );
+
+  rtems_libio_iop_drop( iop );
+
   return rc;
 }
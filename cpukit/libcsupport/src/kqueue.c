@@ -0,0 +1,627 @@
+/**
+ * @file
+ *
+ * @brief Kernel Event Notification
+ * @ingroup libcsupport
+ */
+
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#if HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#define _WANT_KNOTE
+
+#include <sys/types.h>
+#include <sys/event.h>
+#include <errno.h>
+#include <stdlib.h>
+
+#include <rtems/libio_.h>
+#include <rtems/seterr.h>
+#include <rtems/timespec.h>
+#include <rtems/score/threaddispatch.h>
+
+#define KQUEUE_EVENT RTEMS_EVENT_SYSTEM_KQUEUE
+
+#define KQUEUE_HASH_SIZE 64
+
+#define KQUEUE_HASH(ident) ((ident) & (KQUEUE_HASH_SIZE - 1))
+
+typedef struct kqueue_waiter {
+  struct kqueue_waiter *next;
+  rtems_id task;
+} kqueue_waiter;
+
+/*
+ * The registered knotes are kept in a hash table indexed by the file
+ * descriptor.  Triggered knotes are appended to the active queue, so that
+ * kevent() only looks at descriptors which are ready.
+ */
+struct kqueue {
+  SLIST_ENTRY(kqueue) kq_link;
+  TAILQ_HEAD(, knote) kq_head;
+  int kq_count;
+  kqueue_waiter *kq_waiters;
+  struct klist kq_hash[KQUEUE_HASH_SIZE];
+};
+
+/*
+ * The list of all kernel event queues and the hash tables are protected by
+ * the libio lock.
+ */
+static struct kqlist kqueues = SLIST_HEAD_INITIALIZER(kqueues);
+
+/*
+ * Protects the knote lists of the objects, the active queues and the waiter
+ * lists.  The knote() function may be called from interrupt context, for
+ * example by the termios receive interrupt.
+ */
+static rtems_interrupt_lock kqueue_lock =
+  RTEMS_INTERRUPT_LOCK_INITIALIZER("kqueue");
+
+static const rtems_filesystem_file_handlers_r kqueue_handlers;
+
+/*
+ * Called with the kqueue lock held and thread dispatching disabled.
+ */
+static void kqueue_wakeup(struct kqueue *kq)
+{
+  kqueue_waiter *waiter = kq->kq_waiters;
+
+  kq->kq_waiters = NULL;
+
+  while (waiter != NULL) {
+    kqueue_waiter *next = waiter->next;
+    rtems_id task = waiter->task;
+
+    rtems_event_system_send(task, KQUEUE_EVENT);
+    waiter = next;
+  }
+}
+
+/*
+ * Called with the kqueue lock held and thread dispatching disabled.
+ */
+static void knote_activate(struct knote *kn)
+{
+  struct kqueue *kq = kn->kn_kq;
+
+  kn->kn_status |= KN_ACTIVE;
+
+  if ((kn->kn_status & (KN_QUEUED | KN_DISABLED)) == 0) {
+    TAILQ_INSERT_TAIL(&kq->kq_head, kn, kn_tqe);
+    kn->kn_status |= KN_QUEUED;
+    ++kq->kq_count;
+    kqueue_wakeup(kq);
+  }
+}
+
+/*
+ * Called with the libio lock held.
+ */
+static void knote_drop(struct knote *kn)
+{
+  struct kqueue *kq = kn->kn_kq;
+  rtems_interrupt_lock_context lock_context;
+
+  (*kn->kn_fop->f_detach)(kn);
+
+  rtems_interrupt_lock_acquire(&kqueue_lock, &lock_context);
+  if ((kn->kn_status & KN_QUEUED) != 0) {
+    TAILQ_REMOVE(&kq->kq_head, kn, kn_tqe);
+    --kq->kq_count;
+  }
+  rtems_interrupt_lock_release(&kqueue_lock, &lock_context);
+
+  SLIST_REMOVE(&kq->kq_hash[KQUEUE_HASH(kn->kn_id)], kn, knote, kn_link);
+  free(kn);
+}
+
+void knote(struct knlist *list, long hint, int lockflags)
+{
+  rtems_interrupt_lock_context lock_context;
+  struct knote *kn;
+
+  (void) lockflags;
+
+  _Thread_Disable_dispatch();
+  rtems_interrupt_lock_acquire(&kqueue_lock, &lock_context);
+
+  SLIST_FOREACH(kn, &list->kl_list, kn_selnext) {
+    if ((*kn->kn_fop->f_event)(kn, hint)) {
+      knote_activate(kn);
+    }
+  }
+
+  rtems_interrupt_lock_release(&kqueue_lock, &lock_context);
+  _Thread_Enable_dispatch();
+}
+
+void knlist_add(struct knlist *knl, struct knote *kn, int islocked)
+{
+  rtems_interrupt_lock_context lock_context;
+
+  (void) islocked;
+
+  rtems_interrupt_lock_acquire(&kqueue_lock, &lock_context);
+  SLIST_INSERT_HEAD(&knl->kl_list, kn, kn_selnext);
+  kn->kn_knlist = knl;
+  rtems_interrupt_lock_release(&kqueue_lock, &lock_context);
+}
+
+void knlist_remove(struct knlist *knl, struct knote *kn, int islocked)
+{
+  rtems_interrupt_lock_context lock_context;
+
+  (void) islocked;
+
+  rtems_interrupt_lock_acquire(&kqueue_lock, &lock_context);
+  SLIST_REMOVE(&knl->kl_list, kn, knote, kn_selnext);
+  kn->kn_knlist = NULL;
+  rtems_interrupt_lock_release(&kqueue_lock, &lock_context);
+}
+
+int knlist_empty(struct knlist *knl)
+{
+  return SLIST_EMPTY(&knl->kl_list);
+}
+
+static struct knote *kqueue_find(struct kqueue *kq, const struct kevent *kev)
+{
+  struct knote *kn;
+
+  SLIST_FOREACH(kn, &kq->kq_hash[KQUEUE_HASH(kev->ident)], kn_link) {
+    if (kn->kn_id == kev->ident && kn->kn_filter == kev->filter) {
+      return kn;
+    }
+  }
+
+  return NULL;
+}
+
+/*
+ * Called with the libio lock held.
+ */
+static int kqueue_register(struct kqueue *kq, const struct kevent *kev)
+{
+  rtems_interrupt_lock_context lock_context;
+  rtems_libio_t *iop;
+  struct knote *kn;
+
+  if (kev->filter != EVFILT_READ && kev->filter != EVFILT_WRITE) {
+    return EINVAL;
+  }
+
+  if (kev->ident >= rtems_libio_number_iops) {
+    return EBADF;
+  }
+
+  iop = rtems_libio_iop(kev->ident);
+  if ((iop->flags & LIBIO_FLAGS_OPEN) == 0) {
+    return EBADF;
+  }
+
+  kn = kqueue_find(kq, kev);
+  if (kn == NULL) {
+    int error;
+
+    if ((kev->flags & EV_ADD) == 0) {
+      return ENOENT;
+    }
+
+    kn = calloc(1, sizeof(*kn));
+    if (kn == NULL) {
+      return ENOMEM;
+    }
+
+    kn->kn_kq = kq;
+    kn->kn_kevent = *kev;
+    kn->kn_flags &= ~(EV_ADD | EV_DELETE | EV_ENABLE | EV_DISABLE | EV_RECEIPT);
+    kn->kn_fflags = 0;
+    kn->kn_data = 0;
+    kn->kn_sfflags = kev->fflags;
+    kn->kn_sdata = kev->data;
+
+    error = (*iop->pathinfo.handlers->kqfilter_h)(iop, kn);
+    if (error == 0 && kn->kn_fop == NULL) {
+      error = EINVAL;
+    }
+
+    if (error != 0) {
+      free(kn);
+      return error;
+    }
+
+    SLIST_INSERT_HEAD(&kq->kq_hash[KQUEUE_HASH(kev->ident)], kn, kn_link);
+  } else if ((kev->flags & EV_ADD) != 0) {
+    rtems_interrupt_lock_acquire(&kqueue_lock, &lock_context);
+    kn->kn_sfflags = kev->fflags;
+    kn->kn_sdata = kev->data;
+    kn->kn_kevent.udata = kev->udata;
+    rtems_interrupt_lock_release(&kqueue_lock, &lock_context);
+  }
+
+  if ((kev->flags & EV_DELETE) != 0) {
+    knote_drop(kn);
+    return 0;
+  }
+
+  _Thread_Disable_dispatch();
+  rtems_interrupt_lock_acquire(&kqueue_lock, &lock_context);
+
+  if ((kev->flags & EV_DISABLE) != 0) {
+    kn->kn_status |= KN_DISABLED;
+  }
+
+  if ((kev->flags & EV_ENABLE) != 0) {
+    kn->kn_status &= ~KN_DISABLED;
+  }
+
+  if ((*kn->kn_fop->f_event)(kn, 0)) {
+    knote_activate(kn);
+  }
+
+  rtems_interrupt_lock_release(&kqueue_lock, &lock_context);
+  _Thread_Enable_dispatch();
+
+  return 0;
+}
+
+/*
+ * Moves the ready events of the active queue to the event list.  Called with
+ * the libio lock held.  The kqueue lock is released after each knote to keep
+ * the interrupt latency low.
+ */
+static int kqueue_collect(
+  struct kqueue *kq,
+  struct kevent *eventlist,
+  int nevents
+)
+{
+  rtems_interrupt_lock_context lock_context;
+  int count = 0;
+  int budget;
+
+  rtems_interrupt_lock_acquire(&kqueue_lock, &lock_context);
+  budget = kq->kq_count;
+
+  while (count < nevents && budget > 0) {
+    struct knote *kn = TAILQ_FIRST(&kq->kq_head);
+
+    if (kn == NULL) {
+      break;
+    }
+
+    --budget;
+    TAILQ_REMOVE(&kq->kq_head, kn, kn_tqe);
+    kn->kn_status &= ~KN_QUEUED;
+    --kq->kq_count;
+
+    if ((kn->kn_status & KN_DISABLED) != 0) {
+      /* Keep KN_ACTIVE, so that EV_ENABLE queues it again */
+    } else if ((kn->kn_flags & EV_ONESHOT) != 0) {
+      kn->kn_status &= ~KN_ACTIVE;
+      eventlist[count] = kn->kn_kevent;
+      ++count;
+
+      rtems_interrupt_lock_release(&kqueue_lock, &lock_context);
+      knote_drop(kn);
+      rtems_interrupt_lock_acquire(&kqueue_lock, &lock_context);
+    } else if (!(*kn->kn_fop->f_event)(kn, 0)) {
+      kn->kn_status &= ~KN_ACTIVE;
+    } else {
+      eventlist[count] = kn->kn_kevent;
+      ++count;
+
+      if ((kn->kn_flags & EV_CLEAR) != 0) {
+        kn->kn_data = 0;
+        kn->kn_fflags = 0;
+        kn->kn_status &= ~KN_ACTIVE;
+      } else if ((kn->kn_flags & EV_DISPATCH) != 0) {
+        kn->kn_status &= ~KN_ACTIVE;
+        kn->kn_status |= KN_DISABLED;
+      } else {
+        /* Level triggered: check it again in the next kevent() call */
+        TAILQ_INSERT_TAIL(&kq->kq_head, kn, kn_tqe);
+        kn->kn_status |= KN_QUEUED;
+        ++kq->kq_count;
+      }
+    }
+
+    rtems_interrupt_lock_release(&kqueue_lock, &lock_context);
+    rtems_interrupt_lock_acquire(&kqueue_lock, &lock_context);
+  }
+
+  rtems_interrupt_lock_release(&kqueue_lock, &lock_context);
+
+  return count;
+}
+
+static rtems_status_code kqueue_wait(
+  struct kqueue *kq,
+  rtems_interval ticks
+)
+{
+  rtems_interrupt_lock_context lock_context;
+  kqueue_waiter waiter;
+  kqueue_waiter **link;
+  rtems_event_set events;
+  rtems_status_code sc;
+
+  rtems_interrupt_lock_acquire(&kqueue_lock, &lock_context);
+
+  if (kq->kq_count > 0) {
+    rtems_interrupt_lock_release(&kqueue_lock, &lock_context);
+    return RTEMS_SUCCESSFUL;
+  }
+
+  waiter.task = rtems_task_self();
+  waiter.next = kq->kq_waiters;
+  kq->kq_waiters = &waiter;
+
+  rtems_interrupt_lock_release(&kqueue_lock, &lock_context);
+
+  sc = rtems_event_system_receive(
+    KQUEUE_EVENT,
+    RTEMS_EVENT_ANY | RTEMS_WAIT,
+    ticks,
+    &events
+  );
+
+  rtems_interrupt_lock_acquire(&kqueue_lock, &lock_context);
+
+  for (link = &kq->kq_waiters; *link != NULL; link = &(*link)->next) {
+    if (*link == &waiter) {
+      *link = waiter.next;
+      break;
+    }
+  }
+
+  rtems_interrupt_lock_release(&kqueue_lock, &lock_context);
+
+  return sc;
+}
+
+static int kqueue_scan(
+  struct kqueue *kq,
+  struct kevent *eventlist,
+  int nevents,
+  const struct timespec *timeout
+)
+{
+  rtems_interval ticks = RTEMS_NO_TIMEOUT;
+  rtems_interval then = 0;
+  bool poll = false;
+  int count;
+
+  if (timeout != NULL) {
+    if (timeout->tv_sec < 0 || timeout->tv_nsec < 0 ||
+        timeout->tv_nsec >= 1000000000) {
+      rtems_set_errno_and_return_minus_one(EINVAL);
+    }
+
+    if (timeout->tv_sec != 0 || timeout->tv_nsec != 0) {
+      ticks = rtems_timespec_to_ticks(timeout);
+      if (ticks == 0) {
+        ticks = 1;
+      }
+
+      then = rtems_clock_get_ticks_since_boot();
+    } else {
+      poll = true;
+    }
+  }
+
+  while (true) {
+    rtems_status_code sc;
+
+    rtems_libio_lock();
+    count = kqueue_collect(kq, eventlist, nevents);
+    rtems_libio_unlock();
+
+    if (count > 0 || poll) {
+      break;
+    }
+
+    if (timeout != NULL) {
+      rtems_interval now = rtems_clock_get_ticks_since_boot();
+      rtems_interval elapsed = now - then;
+
+      if (elapsed >= ticks) {
+        break;
+      }
+
+      ticks -= elapsed;
+      then = now;
+    }
+
+    sc = kqueue_wait(kq, ticks);
+    if (sc == RTEMS_TIMEOUT) {
+      rtems_libio_lock();
+      count = kqueue_collect(kq, eventlist, nevents);
+      rtems_libio_unlock();
+      break;
+    }
+  }
+
+  return count;
+}
+
+static void kqueue_fdclose(int fd)
+{
+  uintptr_t ident = (uintptr_t) fd;
+  struct kqueue *kq;
+
+  rtems_libio_lock();
+
+  SLIST_FOREACH(kq, &kqueues, kq_link) {
+    struct knote *kn = SLIST_FIRST(&kq->kq_hash[KQUEUE_HASH(ident)]);
+
+    while (kn != NULL) {
+      struct knote *next = SLIST_NEXT(kn, kn_link);
+
+      if (kn->kn_id == ident) {
+        knote_drop(kn);
+      }
+
+      kn = next;
+    }
+  }
+
+  rtems_libio_unlock();
+}
+
+static int kqueue_close(rtems_libio_t *iop)
+{
+  struct kqueue *kq = iop->data1;
+  size_t i;
+
+  rtems_libio_lock();
+
+  for (i = 0; i < KQUEUE_HASH_SIZE; ++i) {
+    struct knote *kn;
+
+    while ((kn = SLIST_FIRST(&kq->kq_hash[i])) != NULL) {
+      knote_drop(kn);
+    }
+  }
+
+  SLIST_REMOVE(&kqueues, kq, kqueue, kq_link);
+
+  rtems_libio_unlock();
+
+  free(kq);
+
+  return 0;
+}
+
+int kqueue(void)
+{
+  rtems_libio_t *iop;
+  struct kqueue *kq;
+
+  kq = calloc(1, sizeof(*kq));
+  if (kq == NULL) {
+    rtems_set_errno_and_return_minus_one(ENOMEM);
+  }
+
+  TAILQ_INIT(&kq->kq_head);
+
+  iop = rtems_libio_allocate();
+  if (iop == NULL) {
+    free(kq);
+    rtems_set_errno_and_return_minus_one(ENFILE);
+  }
+
+  iop->flags |= LIBIO_FLAGS_READ;
+  iop->data1 = kq;
+  iop->pathinfo.handlers = &kqueue_handlers;
+  iop->pathinfo.mt_entry = &rtems_filesystem_null_mt_entry;
+  rtems_filesystem_location_add_to_mt_entry(&iop->pathinfo);
+
+  rtems_libio_lock();
+  SLIST_INSERT_HEAD(&kqueues, kq, kq_link);
+  rtems_libio_kqueue_fdclose = kqueue_fdclose;
+  rtems_libio_unlock();
+
+  return rtems_libio_iop_to_descriptor(iop);
+}
+
+int kevent(
+  int kq_fd,
+  const struct kevent *changelist,
+  int nchanges,
+  struct kevent *eventlist,
+  int nevents,
+  const struct timespec *timeout
+)
+{
+  rtems_libio_t *iop;
+  struct kqueue *kq;
+  rtems_event_set events;
+  int errors = 0;
+  int i;
+
+  rtems_libio_check_fd(kq_fd);
+  iop = rtems_libio_iop(kq_fd);
+  rtems_libio_check_is_open(iop);
+
+  if (iop->pathinfo.handlers != &kqueue_handlers) {
+    rtems_set_errno_and_return_minus_one(EBADF);
+  }
+
+  if (nchanges < 0 || nevents < 0) {
+    rtems_set_errno_and_return_minus_one(EINVAL);
+  }
+
+  if ((nchanges > 0 && changelist == NULL) ||
+      (nevents > 0 && eventlist == NULL)) {
+    rtems_set_errno_and_return_minus_one(EFAULT);
+  }
+
+  kq = iop->data1;
+
+  /* Soak up a wakeup left over from a previous call */
+  rtems_event_system_receive(
+    KQUEUE_EVENT,
+    RTEMS_EVENT_ANY | RTEMS_NO_WAIT,
+    RTEMS_NO_TIMEOUT,
+    &events
+  );
+
+  rtems_libio_lock();
+
+  for (i = 0; i < nchanges; ++i) {
+    const struct kevent *kev = &changelist[i];
+    int error = kqueue_register(kq, kev);
+
+    if (error != 0 || (kev->flags & EV_RECEIPT) != 0) {
+      if (errors < nevents) {
+        eventlist[errors] = *kev;
+        eventlist[errors].flags = EV_ERROR;
+        eventlist[errors].data = error;
+        ++errors;
+      } else if (error != 0) {
+        rtems_libio_unlock();
+        rtems_set_errno_and_return_minus_one(error);
+      }
+    }
+  }
+
+  rtems_libio_unlock();
+
+  if (errors > 0 || nevents == 0) {
+    return errors;
+  }
+
+  return kqueue_scan(kq, eventlist, nevents, timeout);
+}
+
+static const rtems_filesystem_file_handlers_r kqueue_handlers = {
+  .open_h = rtems_filesystem_default_open,
+  .close_h = kqueue_close,
+  .read_h = rtems_filesystem_default_read,
+  .write_h = rtems_filesystem_default_write,
+  .ioctl_h = rtems_filesystem_default_ioctl,
+  .lseek_h = rtems_filesystem_default_lseek,
+  .fstat_h = rtems_filesystem_default_fstat,
+  .ftruncate_h = rtems_filesystem_default_ftruncate,
+  .fsync_h = rtems_filesystem_default_fsync_or_fdatasync,
+  .fdatasync_h = rtems_filesystem_default_fsync_or_fdatasync,
+  .fcntl_h = rtems_filesystem_default_fcntl,
+  .kqfilter_h = rtems_filesystem_default_kqfilter,
+  .poll_h = rtems_filesystem_default_poll,
+  .readv_h = rtems_filesystem_default_readv,
+  .writev_h = rtems_filesystem_default_writev,
+  .loan_h = rtems_filesystem_default_loan,
+  .preadv_h = rtems_filesystem_default_preadv,
+  .pwritev_h = rtems_filesystem_default_pwritev
+};
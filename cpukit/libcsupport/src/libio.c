@@ -113,33 +113,86 @@ int rtems_libio_to_fcntl_flags( uint32_t flags )
 
 rtems_libio_t *rtems_libio_allocate( void )
 {
-  rtems_libio_t *iop = NULL;
+  rtems_libio_t *iop;
+  rtems_libio_iop_declare_lock_context( lock_context );
 
-  rtems_libio_lock();
+  rtems_libio_iop_lock( lock_context );
 
-  if (rtems_libio_iop_freelist) {
-    iop = rtems_libio_iop_freelist;
+  iop = rtems_libio_iop_freelist;
+  if ( iop != NULL ) {
     rtems_libio_iop_freelist = iop->data1;
+  }
+
+  rtems_libio_iop_unlock( lock_context );
+
+  /*
+   * The entry is no longer on the free list and the descriptor is not yet
+   * handed out, so the initialization needs no protection.  The reference
+   * count is already zero.
+   */
+  if ( iop != NULL ) {
     memset( iop, 0, sizeof(*iop) );
     iop->flags = LIBIO_FLAGS_OPEN;
   }
 
-  rtems_libio_unlock();
-
   return iop;
 }
 
-void rtems_libio_free(
+static void rtems_libio_release(
   rtems_libio_t *iop
 )
 {
+  rtems_libio_iop_declare_lock_context( lock_context );
+
   rtems_filesystem_location_free( &iop->pathinfo );
 
-  rtems_libio_lock();
+  rtems_libio_iop_lock( lock_context );
 
     iop->flags = 0;
     iop->data1 = rtems_libio_iop_freelist;
     rtems_libio_iop_freelist = iop;
 
-  rtems_libio_unlock();
+  rtems_libio_iop_unlock( lock_context );
+}
+
+void rtems_libio_free(
+  rtems_libio_t *iop
+)
+{
+  bool busy;
+  rtems_libio_iop_declare_lock_context( lock_context );
+
+  rtems_libio_iop_lock( lock_context );
+
+    iop->flags &= ~LIBIO_FLAGS_OPEN;
+    busy = iop->reference_count != 0;
+    if ( busy ) {
+      iop->flags |= LIBIO_FLAGS_FREE_PENDING;
+    }
+
+  rtems_libio_iop_unlock( lock_context );
+
+  if ( !busy ) {
+    rtems_libio_release( iop );
+  }
+}
+
+void rtems_libio_iop_drop(
+  rtems_libio_t *iop
+)
+{
+  bool release;
+  rtems_libio_iop_declare_lock_context( lock_context );
+
+  rtems_libio_iop_lock( lock_context );
+
+    --iop->reference_count;
+    release = iop->reference_count == 0
+      && ( iop->flags & LIBIO_FLAGS_FREE_PENDING ) != 0;
+
+  rtems_libio_iop_unlock( lock_context );
+
+  if ( release ) {
+    rtems_libio_release( iop );
+  }
 }
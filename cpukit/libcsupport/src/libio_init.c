@@ -41,6 +41,9 @@ rtems_id           rtems_libio_semaphore;
 rtems_libio_t     *rtems_libio_iops;
 rtems_libio_t     *rtems_libio_iop_freelist;
 
+rtems_interrupt_lock rtems_libio_iop_lock_control =
+  RTEMS_INTERRUPT_LOCK_INITIALIZER("IOP table");
+
 void rtems_libio_init( void )
 {
     rtems_status_code rc;
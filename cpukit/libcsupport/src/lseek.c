@@ -20,12 +20,21 @@
 off_t lseek( int fd, off_t offset, int whence )
 {
   rtems_libio_t *iop;
+  off_t          rv;
 
   rtems_libio_check_fd( fd );
   iop = rtems_libio_iop( fd );
   rtems_libio_check_is_open(iop);
 
-  return (*iop->pathinfo.handlers->lseek_h)( iop, offset, whence );
+  if ( !rtems_libio_iop_hold( iop ) ) {
+    rtems_set_errno_and_return_minus_one( EBADF );
+  }
+
+  rv = (*iop->pathinfo.handlers->lseek_h)( iop, offset, whence );
+
+  rtems_libio_iop_drop( iop );
+
+  return rv;
 }
 
 /*
@@ -0,0 +1,62 @@
+/**
+ *  @file
+ *
+ *  @brief Write a Vector at a File Offset
+ *  @ingroup libcsupport
+ */
+
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <sys/uio.h>
+
+#include <rtems/libio_.h>
+
+/**
+ *  pwritev() - Write a vector at a file offset without a change of the file
+ *  offset of the file descriptor.  The data is written at the offset even if
+ *  the file is open with O_APPEND.
+ */
+ssize_t pwritev(
+  int                 fd,
+  const struct iovec *iov,
+  int                 iovcnt,
+  off_t               offset
+)
+{
+  ssize_t        total;
+  rtems_libio_t *iop;
+
+  total = rtems_libio_iovec_eval( fd, iov, iovcnt, LIBIO_FLAGS_WRITE, &iop );
+
+  if ( total >= 0 && offset < 0 ) {
+    rtems_set_errno_and_return_minus_one( EINVAL );
+  }
+
+  if ( total > 0 ) {
+    if ( rtems_libio_iop_hold( iop ) ) {
+      total = ( *iop->pathinfo.handlers->pwritev_h )(
+        iop,
+        iov,
+        iovcnt,
+        offset,
+        total
+      );
+      rtems_libio_iop_drop( iop );
+    } else {
+      errno = EBADF;
+      total = -1;
+    }
+  }
+
+  return total;
+}
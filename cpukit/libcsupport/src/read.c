@@ -31,6 +31,7 @@ ssize_t read(
 )
 {
   rtems_libio_t *iop;
+  ssize_t        n;
 
   rtems_libio_check_fd( fd );
   iop = rtems_libio_iop( fd );
@@ -39,10 +40,18 @@ ssize_t read(
   rtems_libio_check_count( count );
   rtems_libio_check_permissions_with_error( iop, LIBIO_FLAGS_READ, EBADF );
 
+  if ( !rtems_libio_iop_hold( iop ) ) {
+    rtems_set_errno_and_return_minus_one( EBADF );
+  }
+
   /*
    *  Now process the read().
    */
-  return (*iop->pathinfo.handlers->read_h)( iop, buffer, count );
+  n = (*iop->pathinfo.handlers->read_h)( iop, buffer, count );
+
+  rtems_libio_iop_drop( iop );
+
+  return n;
 }
 
 #if defined(RTEMS_NEWLIB) && !defined(HAVE__READ_R)
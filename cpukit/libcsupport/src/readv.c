@@ -41,7 +41,13 @@ ssize_t readv(
   total = rtems_libio_iovec_eval( fd, iov, iovcnt, LIBIO_FLAGS_READ, &iop );
 
   if ( total > 0 ) {
-    total = ( *iop->pathinfo.handlers->readv_h )( iop, iov, iovcnt, total );
+    if ( rtems_libio_iop_hold( iop ) ) {
+      total = ( *iop->pathinfo.handlers->readv_h )( iop, iov, iovcnt, total );
+      rtems_libio_iop_drop( iop );
+    } else {
+      errno = EBADF;
+      total = -1;
+    }
   }
 
   return total;
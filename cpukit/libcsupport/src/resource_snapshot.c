@@ -81,21 +81,20 @@ static const Objects_Information *objects_info_table[] = {
 
 static int open_files(void)
 {
-  int free_count = 0;
-  rtems_libio_t *iop;
-
-  rtems_libio_lock();
-
-  iop = rtems_libio_iop_freelist;
-  while (iop != NULL) {
-    ++free_count;
-
-    iop = iop->data1;
+  int open_count = 0;
+  uint32_t i;
+
+  /*
+   * A file descriptor is free if and only if its flags are zero.  This avoids
+   * a walk through the free list with interrupts disabled.
+   */
+  for (i = 0; i < rtems_libio_number_iops; ++i) {
+    if (rtems_libio_iops[i].flags != 0) {
+      ++open_count;
+    }
   }
 
-  rtems_libio_unlock();
-
-  return (int) rtems_libio_number_iops - free_count;
+  return open_count;
 }
 
 void rtems_resource_snapshot_take(rtems_resource_snapshot *snapshot)
@@ -21,6 +21,8 @@
 #include <rtems/deviceio.h>
 #include <rtems/rtems/status.h>
 
+#include <errno.h>
+
 int rtems_deviceio_open(
   rtems_libio_t *iop,
   const char *path,
@@ -138,3 +140,26 @@ int rtems_deviceio_control(
     return rtems_status_code_to_errno(status);
   }
 }
+
+int rtems_deviceio_kqfilter(
+  rtems_libio_t *iop,
+  struct knote *kn,
+  rtems_device_major_number major,
+  rtems_device_minor_number minor
+)
+{
+  rtems_status_code status;
+  rtems_libio_ioctl_args_t args;
+
+  args.iop = iop;
+  args.command = RTEMS_IO_KQFILTER;
+  args.buffer = kn;
+  args.ioctl_return = EINVAL;
+
+  status = rtems_io_control( major, minor, &args );
+  if ( status == RTEMS_SUCCESSFUL ) {
+    return args.ioctl_return;
+  } else {
+    return EINVAL;
+  }
+}
@@ -17,12 +17,15 @@
 #include "config.h"
 #endif
 
+#define _WANT_KNOTE
+
 #include <rtems.h>
 #include <rtems/libio.h>
 #include <ctype.h>
 #include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <termios.h>
 #include <unistd.h>
 #include <sys/ttycom.h>
@@ -533,6 +536,95 @@ termios_set_flowctrl(struct rtems_termios_tty *tty)
   }
 }
 
+static void
+rtems_termios_kqfilter_read_detach (struct knote *kn)
+{
+  struct rtems_termios_tty *tty = kn->kn_hook;
+
+  knlist_remove (&tty->tty_rnote, kn, 0);
+}
+
+/*
+ * Input is ready if the raw or the canonical buffer contains characters.
+ * The line discipline may need a complete line in canonical mode, so this
+ * is a hint only, the read() may still block.
+ */
+static int
+rtems_termios_kqfilter_read_event (struct knote *kn, long hint)
+{
+  struct rtems_termios_tty *tty = kn->kn_hook;
+  unsigned int size = tty->rawInBuf.Size;
+
+  kn->kn_data = (tty->rawInBuf.Tail - tty->rawInBuf.Head + size) % size;
+  kn->kn_data += tty->ccount - tty->cindex;
+
+  return kn->kn_data > 0;
+}
+
+static void
+rtems_termios_kqfilter_write_detach (struct knote *kn)
+{
+  struct rtems_termios_tty *tty = kn->kn_hook;
+
+  knlist_remove (&tty->tty_wnote, kn, 0);
+}
+
+static int
+rtems_termios_kqfilter_write_event (struct knote *kn, long hint)
+{
+  struct rtems_termios_tty *tty = kn->kn_hook;
+  unsigned int size = tty->rawOutBuf.Size;
+
+  if (tty->device.outputUsesInterrupts == TERMIOS_POLLED) {
+    kn->kn_data = size;
+  } else {
+    kn->kn_data = size - 1 -
+      (tty->rawOutBuf.Head - tty->rawOutBuf.Tail + size) % size;
+  }
+
+  return kn->kn_data > 0;
+}
+
+static struct filterops rtems_termios_kqfilter_read_ops = {
+  .f_isfd = 1,
+  .f_detach = rtems_termios_kqfilter_read_detach,
+  .f_event = rtems_termios_kqfilter_read_event
+};
+
+static struct filterops rtems_termios_kqfilter_write_ops = {
+  .f_isfd = 1,
+  .f_detach = rtems_termios_kqfilter_write_detach,
+  .f_event = rtems_termios_kqfilter_write_event
+};
+
+/*
+ * Attach a kevent() filter.  Devices with polled input do not fill the raw
+ * input buffer, so there is nothing which could trigger a read event.
+ */
+static rtems_status_code
+rtems_termios_kqfilter (struct rtems_termios_tty *tty, struct knote *kn)
+{
+  switch (kn->kn_filter) {
+  case EVFILT_READ:
+    if (tty->device.pollRead != NULL) {
+      return RTEMS_NOT_IMPLEMENTED;
+    }
+    kn->kn_fop = &rtems_termios_kqfilter_read_ops;
+    kn->kn_hook = tty;
+    knlist_add (&tty->tty_rnote, kn, 0);
+    break;
+  case EVFILT_WRITE:
+    kn->kn_fop = &rtems_termios_kqfilter_write_ops;
+    kn->kn_hook = tty;
+    knlist_add (&tty->tty_wnote, kn, 0);
+    break;
+  default:
+    return RTEMS_INVALID_NUMBER;
+  }
+
+  return RTEMS_SUCCESSFUL;
+}
+
 rtems_status_code
 rtems_termios_ioctl (void *arg)
 {
@@ -624,6 +716,24 @@ rtems_termios_ioctl (void *arg)
     tty->tty_rcv = *wakeup;
     break;
 
+  case RTEMS_IO_KQFILTER:
+    sc = rtems_termios_kqfilter (tty, args->buffer);
+    if (sc == RTEMS_SUCCESSFUL) {
+      args->ioctl_return = 0;
+    } else {
+      args->ioctl_return = EINVAL;
+    }
+    break;
+
+  case RTEMS_IO_GET_STATISTICS: {
+      rtems_interrupt_lock_context lock_context;
+
+      rtems_termios_interrupt_lock_acquire (tty, &lock_context);
+      *(rtems_termios_statistics *)args->buffer = tty->statistics;
+      rtems_termios_interrupt_lock_release (tty, &lock_context);
+    }
+    break;
+
     /*
      * FIXME: add various ioctl code handlers
      */
@@ -671,31 +781,25 @@ rtems_termios_puts (
   const void *_buf, size_t len, struct rtems_termios_tty *tty)
 {
   const char *buf = _buf;
-  unsigned int newHead;
+  unsigned int head;
   rtems_interrupt_lock_context lock_context;
   rtems_status_code sc;
 
   if (tty->device.outputUsesInterrupts == TERMIOS_POLLED) {
     (*tty->device.write)(tty->minor, buf, len);
+    rtems_termios_interrupt_lock_acquire (tty, &lock_context);
+    tty->statistics.tx_characters += len;
+    ++tty->statistics.tx_bursts;
+    rtems_termios_interrupt_lock_release (tty, &lock_context);
     return;
   }
-  newHead = tty->rawOutBuf.Head;
+  head = tty->rawOutBuf.Head;
   while (len) {
-    /*
-     * Performance improvement could be made here.
-     * Copy multiple bytes to raw buffer:
-     * if (len > 1) && (space to buffer end, or tail > 1)
-     *  ncopy = MIN (len, space to buffer end or tail)
-     *  memcpy (raw buffer, buf, ncopy)
-     *  buf += ncopy
-     *  len -= ncopy
-     *
-     * To minimize latency, the memcpy should be done
-     * with interrupts enabled.
-     */
-    newHead = (newHead + 1) % tty->rawOutBuf.Size;
+    unsigned int tail;
+    size_t ncopy;
+
     rtems_termios_interrupt_lock_acquire (tty, &lock_context);
-    while (newHead == tty->rawOutBuf.Tail) {
+    while ((head + 1) % tty->rawOutBuf.Size == tty->rawOutBuf.Tail) {
       tty->rawOutBufState = rob_wait;
       rtems_termios_interrupt_lock_release (tty, &lock_context);
       sc = rtems_semaphore_obtain(
@@ -704,13 +808,46 @@ rtems_termios_puts (
         rtems_fatal_error_occurred (sc);
       rtems_termios_interrupt_lock_acquire (tty, &lock_context);
     }
-    tty->rawOutBuf.theBuf[tty->rawOutBuf.Head] = *buf++;
-    tty->rawOutBuf.Head = newHead;
+    tail = tty->rawOutBuf.Tail;
+    rtems_termios_interrupt_lock_release (tty, &lock_context);
+
+    /*
+     * Copy the largest contiguous span to the raw buffer.  The transmitter
+     * consumes characters only up to the head, so the copy can be done with
+     * interrupts enabled.  A tail moved meanwhile only adds space.
+     */
+    if (tail > head)
+      ncopy = tail - head - 1;
+    else if (tail == 0)
+      ncopy = tty->rawOutBuf.Size - head - 1;
+    else
+      ncopy = tty->rawOutBuf.Size - head;
+    if (ncopy > len)
+      ncopy = len;
+    memcpy (&tty->rawOutBuf.theBuf[head], buf, ncopy);
+    buf += ncopy;
+    len -= ncopy;
+    head = (head + ncopy) % tty->rawOutBuf.Size;
+
+    rtems_termios_interrupt_lock_acquire (tty, &lock_context);
+    tty->rawOutBuf.Head = head;
     if (tty->rawOutBufState == rob_idle) {
       /* check, whether XOFF has been received */
       if (!(tty->flow_ctrl & FL_ORCVXOF)) {
+        int nToSend;
+
+        /* start the transmitter with all contiguous characters */
+        tail = tty->rawOutBuf.Tail;
+        if (tail > head)
+          nToSend = tty->rawOutBuf.Size - tail;
+        else
+          nToSend = head - tail;
+        if (tty->flow_ctrl & (FL_MDXON | FL_MDXOF)) {
+          nToSend = 1;
+        }
+        ++tty->statistics.tx_bursts;
         (*tty->device.write)(
-          tty->minor, &tty->rawOutBuf.theBuf[tty->rawOutBuf.Tail],1);
+          tty->minor, &tty->rawOutBuf.theBuf[tail], nToSend);
       } else {
         /* remember that output has been stopped due to flow ctrl*/
         tty->flow_ctrl |= FL_OSTOP;
@@ -718,7 +855,6 @@ rtems_termios_puts (
       tty->rawOutBufState = rob_busy;
     }
     rtems_termios_interrupt_lock_release (tty, &lock_context);
-    len--;
   }
 }
 
@@ -1107,6 +1243,79 @@ fillBufferQueue (struct rtems_termios_tty *tty)
   return RTEMS_SUCCESSFUL;
 }
 
+/*
+ * Check whether received characters pass unchanged from the raw input queue
+ * to the reader.  This is the case in non-canonical mode without echo, input
+ * character translations and input flow control.
+ */
+static bool
+isRawTransparent (const struct rtems_termios_tty *tty)
+{
+  return (tty->termios.c_lflag & (ICANON | ECHO)) == 0
+    && (tty->termios.c_iflag & (ISTRIP | IUCLC | IGNCR | ICRNL | INLCR)) == 0
+    && (tty->flow_ctrl & (FL_MDXON | FL_MDXOF | FL_MDRTS)) == 0;
+}
+
+/*
+ * Copy characters from the raw input queue directly to the reader in raw
+ * mode.  Contiguous spans of the raw input buffer are copied at once and the
+ * canonical buffer is bypassed.  The VMIN and VTIME semantics are the same as
+ * in fillBufferQueue().
+ */
+static rtems_status_code
+readRaw (struct rtems_termios_tty *tty, rtems_libio_rw_args_t *args)
+{
+  rtems_interval timeout = tty->rawInBufSemaphoreFirstTimeout;
+  uint32_t count = args->count;
+  uint32_t moved = 0;
+  rtems_interrupt_lock_context lock_context;
+  rtems_status_code sc;
+
+  while (moved < count) {
+    unsigned int head = tty->rawInBuf.Head;
+    unsigned int tail = tty->rawInBuf.Tail;
+
+    while ((head != tail) && (moved < count)) {
+      unsigned int start = (head + 1) % tty->rawInBuf.Size;
+      uint32_t n;
+
+      if (tail >= start)
+        n = tail - start + 1;
+      else
+        n = tty->rawInBuf.Size - start;
+      if (n > count - moved)
+        n = count - moved;
+
+      memcpy (&args->buffer[moved], &tty->rawInBuf.theBuf[start], n);
+      moved += n;
+      head = (head + n) % tty->rawInBuf.Size;
+      tty->rawInBuf.Head = head;
+      timeout = tty->rawInBufSemaphoreTimeout;
+    }
+
+    if ((moved > 0) && (moved >= tty->termios.c_cc[VMIN]))
+      break;
+
+    /*
+     * Wait for characters
+     */
+    if (moved < count) {
+      sc = rtems_semaphore_obtain(
+        tty->rawInBuf.Semaphore, tty->rawInBufSemaphoreOptions, timeout);
+      if (sc != RTEMS_SUCCESSFUL)
+        break;
+    }
+  }
+
+  args->bytes_moved = moved;
+
+  rtems_termios_interrupt_lock_acquire (tty, &lock_context);
+  ++tty->statistics.rx_raw_reads;
+  rtems_termios_interrupt_lock_release (tty, &lock_context);
+
+  return RTEMS_SUCCESSFUL;
+}
+
 rtems_status_code
 rtems_termios_read (void *arg)
 {
@@ -1133,6 +1342,12 @@ rtems_termios_read (void *arg)
     if (tty->device.pollRead != NULL &&
         tty->device.outputUsesInterrupts == TERMIOS_POLLED)
       sc = fillBufferPoll (tty);
+    else if (isRawTransparent (tty)) {
+      sc = readRaw (tty, args);
+      tty->tty_rcvwakeup = 0;
+      rtems_semaphore_release (tty->isem);
+      return sc;
+    }
     else
       sc = fillBufferQueue (tty);
 
@@ -1162,6 +1377,46 @@ void rtems_termios_rxirq_occured(struct rtems_termios_tty *tty)
   rtems_event_send(tty->rxTaskId,TERMIOS_RX_PROC_EVENT);
 }
 
+/*
+ * Place characters on raw queue in contiguous spans.  This is used if no
+ * input flow control is active, so that received characters need no
+ * inspection.
+ * Returns the number of characters dropped because of overflow.
+ */
+static int
+enqueueRawSpans (struct rtems_termios_tty *tty, const char *buf, int len)
+{
+  unsigned int size = tty->rawInBuf.Size;
+  unsigned int tail = tty->rawInBuf.Tail;
+  unsigned int start = (tail + 1) % size;
+  unsigned int nfree;
+  unsigned int ncopy;
+  unsigned int nfirst;
+  rtems_interrupt_lock_context lock_context;
+
+  nfree = (tty->rawInBuf.Head + size - start) % size;
+  ncopy = (unsigned int) len < nfree ? (unsigned int) len : nfree;
+  nfirst = size - start < ncopy ? size - start : ncopy;
+
+  memcpy (&tty->rawInBuf.theBuf[start], buf, nfirst);
+  memcpy (&tty->rawInBuf.theBuf[0], buf + nfirst, ncopy - nfirst);
+
+  rtems_termios_interrupt_lock_acquire (tty, &lock_context);
+  tty->rawInBuf.Tail = (tail + ncopy) % size;
+  tty->statistics.rx_characters += ncopy;
+  rtems_termios_interrupt_lock_release (tty, &lock_context);
+
+  /*
+   * check to see if rcv wakeup callback was set
+   */
+  if (ncopy > 0 && !tty->tty_rcvwakeup && tty->tty_rcv.sw_pfn != NULL) {
+    (*tty->tty_rcv.sw_pfn)(&tty->termios, tty->tty_rcv.sw_arg);
+    tty->tty_rcvwakeup = 1;
+  }
+
+  return len - (int) ncopy;
+}
+
 /*
  * Place characters on raw queue.
  * NOTE: This routine runs in the context of the
@@ -1194,6 +1449,15 @@ rtems_termios_enqueue_raw_characters (void *ttyp, const char *buf, int len)
     return 0;
   }
 
+  /*
+   * Without flow control the characters are copied in contiguous spans, which
+   * lets drivers deliver whole DMA or FIFO buffers at once.
+   */
+  if ((tty->flow_ctrl & (FL_MDXON | FL_MDXOF | FL_MDRTS)) == 0) {
+    dropped = enqueueRawSpans (tty, buf, len);
+    len = 0;
+  }
+
   while (len--) {
     c = *buf++;
     /* FIXME: implement IXANY: any character restarts output */
@@ -1271,6 +1535,7 @@ rtems_termios_enqueue_raw_characters (void *ttyp, const char *buf, int len)
       } else {
         tty->rawInBuf.theBuf[newTail] = c;
         tty->rawInBuf.Tail = newTail;
+        ++tty->statistics.rx_characters;
 
         /*
          * check to see if rcv wakeup callback was set
@@ -1284,6 +1549,13 @@ rtems_termios_enqueue_raw_characters (void *ttyp, const char *buf, int len)
   }
 
   tty->rawInBufDropped += dropped;
+  rtems_termios_interrupt_lock_acquire (tty, &lock_context);
+  tty->statistics.rx_dropped += dropped;
+  ++tty->statistics.rx_bursts;
+  rtems_termios_interrupt_lock_release (tty, &lock_context);
+  if (!KNLIST_EMPTY (&tty->tty_rnote)) {
+    KNOTE_UNLOCKED (&tty->tty_rnote, 0);
+  }
   rtems_semaphore_release (tty->rawInBuf.Semaphore);
   return dropped;
 }
@@ -1394,6 +1666,7 @@ rtems_termios_refill_transmitter (struct rtems_termios_tty *tty)
         nToSend = 1;
       }
       tty->rawOutBufState = rob_busy; /*apm*/
+      ++tty->statistics.tx_bursts;
       (*tty->device.write)(
         tty->minor, &tty->rawOutBuf.theBuf[newTail], nToSend);
     }
@@ -1402,6 +1675,10 @@ rtems_termios_refill_transmitter (struct rtems_termios_tty *tty)
 
   rtems_termios_interrupt_lock_release (tty, &lock_context);
 
+  if (!KNLIST_EMPTY (&tty->tty_wnote)) {
+    KNOTE_UNLOCKED (&tty->tty_wnote, 0);
+  }
+
   if (wakeUpWriterTask) {
     rtems_semaphore_release (tty->rawOutBuf.Semaphore);
   }
@@ -1428,6 +1705,7 @@ rtems_termios_dequeue_characters (void *ttyp, int len)
    * sum up character count already sent
    */
   tty->t_dqlen += len;
+  tty->statistics.tx_characters += len;
 
   if (tty->device.outputUsesInterrupts == TERMIOS_TASK_DRIVEN) {
     /*
@@ -34,6 +34,7 @@ ssize_t write(
 )
 {
   rtems_libio_t     *iop;
+  ssize_t            n;
 
   rtems_libio_check_fd( fd );
   iop = rtems_libio_iop( fd );
@@ -42,8 +43,16 @@ ssize_t write(
   rtems_libio_check_count( count );
   rtems_libio_check_permissions_with_error( iop, LIBIO_FLAGS_WRITE, EBADF );
 
+  if ( !rtems_libio_iop_hold( iop ) ) {
+    rtems_set_errno_and_return_minus_one( EBADF );
+  }
+
   /*
    *  Now process the write() request.
    */
-  return (*iop->pathinfo.handlers->write_h)( iop, buffer, count );
+  n = (*iop->pathinfo.handlers->write_h)( iop, buffer, count );
+
+  rtems_libio_iop_drop( iop );
+
+  return n;
 }
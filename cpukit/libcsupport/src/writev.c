@@ -33,7 +33,13 @@ ssize_t writev(
   total = rtems_libio_iovec_eval( fd, iov, iovcnt, LIBIO_FLAGS_WRITE, &iop );
 
   if ( total > 0 ) {
-    total = ( *iop->pathinfo.handlers->writev_h )( iop, iov, iovcnt, total );
+    if ( rtems_libio_iop_hold( iop ) ) {
+      total = ( *iop->pathinfo.handlers->writev_h )( iop, iov, iovcnt, total );
+      rtems_libio_iop_drop( iop );
+    } else {
+      errno = EBADF;
+      total = -1;
+    }
   }
 
   return total;
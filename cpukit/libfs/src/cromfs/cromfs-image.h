@@ -0,0 +1,168 @@
+/**
+ * @file
+ *
+ * @brief Compressed ROM File System (CROMFS) Image Format
+ *
+ * @ingroup CROMFS
+ */
+
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifndef RTEMS_CROMFS_IMAGE_H
+#define RTEMS_CROMFS_IMAGE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * @addtogroup CROMFS
+ *
+ * This header file is shared with the host image packer rtems-mkcromfs, so it
+ * must not depend on RTEMS header files.
+ *
+ * An image consists of a metadata area followed by the data area.  The
+ * metadata area starts with the superblock, followed by the node table, the
+ * names, the symbolic link targets and the block indices of the regular
+ * files.  The data area contains the compressed blocks of the regular files.
+ *
+ * All values are 32-bit unsigned integers in big endian byte order.  They are
+ * not necessarily aligned, so they must be accessed with
+ * rtems_cromfs_get_u32() and rtems_cromfs_set_u32().  Offsets are relative to
+ * the image begin.
+ *
+ * Node zero is the root directory.  The nodes of a directory are stored
+ * contiguously in the node table and are sorted by name in strcmp() order, so
+ * that a lookup can use a binary search.
+ *
+ * A regular file of size S is split into blocks of the block size B.  Its
+ * block index contains ceil(S / B) + 1 offsets.  Block i occupies the image
+ * from entry i up to entry i + 1 of the block index.  In case this length is
+ * equal to the uncompressed length of the block, then the block is stored
+ * uncompressed, otherwise it is a zlib stream.
+ *
+ * @{
+ */
+
+/**
+ * @brief The magic number "CROM" at the begin of each image.
+ */
+#define RTEMS_CROMFS_MAGIC 0x43524f4dUL
+
+#define RTEMS_CROMFS_VERSION 1
+
+#define RTEMS_CROMFS_MIN_BLOCK_SIZE 512
+
+#define RTEMS_CROMFS_MAX_BLOCK_SIZE (1UL << 20)
+
+/**
+ * @brief Maximum length of a name without the terminating NUL character.
+ */
+#define RTEMS_CROMFS_NAME_MAX 254
+
+/**
+ * @name Superblock
+ *
+ * @{
+ */
+
+#define RTEMS_CROMFS_SB_MAGIC 0
+
+#define RTEMS_CROMFS_SB_VERSION 4
+
+#define RTEMS_CROMFS_SB_BLOCK_SIZE 8
+
+#define RTEMS_CROMFS_SB_NODE_COUNT 12
+
+#define RTEMS_CROMFS_SB_NODE_OFFSET 16
+
+/**
+ * @brief Offset of the data area which is the size of the metadata area.
+ */
+#define RTEMS_CROMFS_SB_DATA_OFFSET 20
+
+#define RTEMS_CROMFS_SB_IMAGE_SIZE 24
+
+#define RTEMS_CROMFS_SB_RESERVED 28
+
+#define RTEMS_CROMFS_SB_SIZE 32
+
+/** @} */
+
+/**
+ * @name Node
+ *
+ * @{
+ */
+
+#define RTEMS_CROMFS_NODE_MODE 0
+
+/**
+ * @brief The user identifier in the upper and the group identifier in the
+ * lower 16 bits.
+ */
+#define RTEMS_CROMFS_NODE_OWNER 4
+
+#define RTEMS_CROMFS_NODE_MTIME 8
+
+/**
+ * @brief The file size of a regular file or the length of a symbolic link
+ * target.
+ */
+#define RTEMS_CROMFS_NODE_SIZE 12
+
+/**
+ * @brief Offset of the name string.
+ */
+#define RTEMS_CROMFS_NODE_NAME 16
+
+/**
+ * @brief Index of the parent directory node.
+ */
+#define RTEMS_CROMFS_NODE_PARENT 20
+
+/**
+ * @brief Index of the first child node of a directory, offset of the block
+ * index of a regular file, or offset of the symbolic link target string.
+ */
+#define RTEMS_CROMFS_NODE_FIRST 24
+
+/**
+ * @brief Count of child nodes of a directory or count of blocks of a regular
+ * file.
+ */
+#define RTEMS_CROMFS_NODE_COUNT 28
+
+#define RTEMS_CROMFS_NODE_ENTRY_SIZE 32
+
+/** @} */
+
+static inline uint32_t rtems_cromfs_get_u32(const uint8_t *p)
+{
+  return ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16)
+    | ((uint32_t) p[2] << 8) | (uint32_t) p[3];
+}
+
+static inline void rtems_cromfs_set_u32(uint8_t *p, uint32_t v)
+{
+  p[0] = (uint8_t) (v >> 24);
+  p[1] = (uint8_t) (v >> 16);
+  p[2] = (uint8_t) (v >> 8);
+  p[3] = (uint8_t) v;
+}
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* RTEMS_CROMFS_IMAGE_H */
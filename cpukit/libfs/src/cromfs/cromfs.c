@@ -0,0 +1,1128 @@
+/**
+ * @file
+ *
+ * @brief Compressed ROM File System (CROMFS)
+ *
+ * @ingroup CROMFS
+ */
+
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#if HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "cromfs.h"
+#include "cromfs-image.h"
+
+#include <sys/param.h>
+#include <sys/stat.h>
+#include <assert.h>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <rtems/libio_.h>
+
+#define RTEMS_CROMFS_NO_NODE UINT32_MAX
+
+typedef struct {
+  rtems_chain_node node;
+  uint32_t file;
+  uint32_t block;
+  uint8_t *data;
+} rtems_cromfs_cache_entry;
+
+typedef struct {
+  rtems_id mutex;
+  int fd;
+  const uint8_t *image;
+  const uint8_t *meta;
+  uint8_t *meta_copy;
+  uint8_t *compressed;
+  uint8_t *cache_data;
+  uint32_t block_size;
+  uint32_t node_count;
+  uint32_t node_offset;
+  uint32_t data_offset;
+  uint32_t image_size;
+  bool stream_initialized;
+  z_stream stream;
+  rtems_chain_control lru;
+  uint32_t cache_blocks;
+  rtems_cromfs_cache_entry cache[];
+} rtems_cromfs_fs_info;
+
+static const rtems_filesystem_file_handlers_r rtems_cromfs_directory_handlers;
+
+static const rtems_filesystem_file_handlers_r rtems_cromfs_file_handlers;
+
+static const rtems_filesystem_file_handlers_r rtems_cromfs_link_handlers;
+
+static void rtems_cromfs_do_lock(const rtems_cromfs_fs_info *fs)
+{
+  rtems_status_code sc;
+
+  sc = rtems_semaphore_obtain(fs->mutex, RTEMS_WAIT, RTEMS_NO_TIMEOUT);
+  assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static void rtems_cromfs_do_unlock(const rtems_cromfs_fs_info *fs)
+{
+  rtems_status_code sc;
+
+  sc = rtems_semaphore_release(fs->mutex);
+  assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static int rtems_cromfs_eno_to_rv_and_errno(int eno)
+{
+  if (eno == 0) {
+    return 0;
+  } else {
+    errno = eno;
+
+    return -1;
+  }
+}
+
+static rtems_cromfs_fs_info *rtems_cromfs_get_fs_info_by_location(
+  const rtems_filesystem_location_info_t *loc
+)
+{
+  return loc->mt_entry->fs_info;
+}
+
+static const uint8_t *rtems_cromfs_get_node_by_location(
+  const rtems_filesystem_location_info_t *loc
+)
+{
+  return loc->node_access;
+}
+
+static const uint8_t *rtems_cromfs_get_node(
+  const rtems_cromfs_fs_info *fs,
+  uint32_t index
+)
+{
+  return fs->meta + fs->node_offset + index * RTEMS_CROMFS_NODE_ENTRY_SIZE;
+}
+
+static uint32_t rtems_cromfs_get_node_index(
+  const rtems_cromfs_fs_info *fs,
+  const uint8_t *node
+)
+{
+  return (uint32_t) (node - fs->meta - fs->node_offset)
+    / RTEMS_CROMFS_NODE_ENTRY_SIZE;
+}
+
+static uint32_t rtems_cromfs_get_field(const uint8_t *node, size_t field)
+{
+  return rtems_cromfs_get_u32(node + field);
+}
+
+static mode_t rtems_cromfs_get_mode(const uint8_t *node)
+{
+  return (mode_t) rtems_cromfs_get_field(node, RTEMS_CROMFS_NODE_MODE);
+}
+
+static const char *rtems_cromfs_get_string(
+  const rtems_cromfs_fs_info *fs,
+  uint32_t offset
+)
+{
+  return (const char *) fs->meta + offset;
+}
+
+static void rtems_cromfs_set_location(
+  rtems_filesystem_location_info_t *loc,
+  const uint8_t *node
+)
+{
+  loc->node_access = (void *) node;
+
+  switch (rtems_cromfs_get_mode(node) & S_IFMT) {
+    case S_IFDIR:
+      loc->handlers = &rtems_cromfs_directory_handlers;
+      break;
+    case S_IFREG:
+      loc->handlers = &rtems_cromfs_file_handlers;
+      break;
+    default:
+      loc->handlers = &rtems_cromfs_link_handlers;
+      break;
+  }
+}
+
+/*
+ * The nodes of a directory are sorted by name, so a binary search finds the
+ * entry.
+ */
+static const uint8_t *rtems_cromfs_lookup(
+  const rtems_cromfs_fs_info *fs,
+  const uint8_t *dir,
+  const char *token,
+  size_t tokenlen
+)
+{
+  uint32_t lo = rtems_cromfs_get_field(dir, RTEMS_CROMFS_NODE_FIRST);
+  uint32_t hi = lo + rtems_cromfs_get_field(dir, RTEMS_CROMFS_NODE_COUNT);
+
+  while (lo < hi) {
+    uint32_t mid = lo + (hi - lo) / 2;
+    const uint8_t *node = rtems_cromfs_get_node(fs, mid);
+    const char *name = rtems_cromfs_get_string(
+      fs,
+      rtems_cromfs_get_field(node, RTEMS_CROMFS_NODE_NAME)
+    );
+    int cmp = strncmp(name, token, tokenlen);
+
+    if (cmp == 0 && name[tokenlen] != '\0') {
+      cmp = 1;
+    }
+
+    if (cmp == 0) {
+      return node;
+    } else if (cmp < 0) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+
+  return NULL;
+}
+
+static int rtems_cromfs_read_device(
+  int fd,
+  void *buf,
+  size_t size,
+  off_t offset
+)
+{
+  uint8_t *out = buf;
+
+  while (size > 0) {
+    ssize_t n = pread(fd, out, size, offset);
+
+    if (n <= 0) {
+      return EIO;
+    }
+
+    out += n;
+    size -= (size_t) n;
+    offset += n;
+  }
+
+  return 0;
+}
+
+static int rtems_cromfs_inflate(
+  rtems_cromfs_fs_info *fs,
+  const uint8_t *src,
+  uint32_t src_len,
+  uint8_t *dst,
+  uint32_t dst_len
+)
+{
+  z_stream *stream = &fs->stream;
+  int z;
+
+  inflateReset(stream);
+
+  stream->next_in = (Bytef *) src;
+  stream->avail_in = src_len;
+  stream->next_out = dst;
+  stream->avail_out = dst_len;
+
+  /*
+   * The output buffer takes the complete block, so the inflate needs no
+   * sliding window.
+   */
+  z = inflate(stream, Z_FINISH);
+
+  return z == Z_STREAM_END && stream->avail_out == 0 ? 0 : EIO;
+}
+
+/*
+ * Returns the data of a block of a regular file.  Uncompressed blocks of an
+ * image in memory are used in place, all other blocks go through the cache of
+ * decompressed blocks.  The cache is a least recently used list.
+ */
+static int rtems_cromfs_get_block(
+  rtems_cromfs_fs_info *fs,
+  const uint8_t *node,
+  uint32_t block,
+  const uint8_t **data
+)
+{
+  uint32_t file = rtems_cromfs_get_node_index(fs, node);
+  uint32_t size = rtems_cromfs_get_field(node, RTEMS_CROMFS_NODE_SIZE);
+  uint32_t block_size = fs->block_size;
+  uint32_t len = MIN(block_size, size - block * block_size);
+  const uint8_t *index = fs->meta
+    + rtems_cromfs_get_field(node, RTEMS_CROMFS_NODE_FIRST)
+    + block * 4;
+  uint32_t begin = rtems_cromfs_get_u32(index);
+  uint32_t end = rtems_cromfs_get_u32(index + 4);
+  uint32_t compressed_len;
+  rtems_chain_node *current;
+  rtems_chain_node *tail;
+  rtems_cromfs_cache_entry *entry;
+  const uint8_t *src;
+  int eno;
+
+  if (
+    begin < fs->data_offset
+      || end < begin
+      || end > fs->image_size
+      || end - begin > block_size
+  ) {
+    return EIO;
+  }
+
+  compressed_len = end - begin;
+
+  if (compressed_len == len && fs->image != NULL) {
+    *data = fs->image + begin;
+
+    return 0;
+  }
+
+  current = rtems_chain_first(&fs->lru);
+  tail = rtems_chain_tail(&fs->lru);
+
+  while (current != tail) {
+    entry = (rtems_cromfs_cache_entry *) current;
+
+    if (entry->file == file && entry->block == block) {
+      rtems_chain_extract_unprotected(current);
+      rtems_chain_prepend_unprotected(&fs->lru, current);
+      *data = entry->data;
+
+      return 0;
+    }
+
+    current = rtems_chain_next(current);
+  }
+
+  entry = (rtems_cromfs_cache_entry *) rtems_chain_last(&fs->lru);
+  entry->file = RTEMS_CROMFS_NO_NODE;
+
+  if (fs->image != NULL) {
+    src = fs->image + begin;
+    eno = 0;
+  } else {
+    src = fs->compressed;
+    eno = rtems_cromfs_read_device(
+      fs->fd,
+      fs->compressed,
+      compressed_len,
+      begin
+    );
+  }
+
+  if (eno == 0) {
+    if (compressed_len == len) {
+      memcpy(entry->data, src, len);
+    } else {
+      eno = rtems_cromfs_inflate(fs, src, compressed_len, entry->data, len);
+    }
+  }
+
+  if (eno == 0) {
+    entry->file = file;
+    entry->block = block;
+    rtems_chain_extract_unprotected(&entry->node);
+    rtems_chain_prepend_unprotected(&fs->lru, &entry->node);
+    *data = entry->data;
+  }
+
+  return eno;
+}
+
+static int rtems_cromfs_fstat(
+  const rtems_filesystem_location_info_t *loc,
+  struct stat *buf
+)
+{
+  const rtems_cromfs_fs_info *fs = rtems_cromfs_get_fs_info_by_location(loc);
+  const uint8_t *node = rtems_cromfs_get_node_by_location(loc);
+  uint32_t owner = rtems_cromfs_get_field(node, RTEMS_CROMFS_NODE_OWNER);
+  time_t mtime = (time_t) rtems_cromfs_get_field(node, RTEMS_CROMFS_NODE_MTIME);
+  mode_t mode = rtems_cromfs_get_mode(node);
+
+  buf->st_ino = rtems_cromfs_get_node_index(fs, node) + 1;
+  buf->st_mode = mode;
+  buf->st_nlink = 1;
+  buf->st_uid = (uid_t) (owner >> 16);
+  buf->st_gid = (gid_t) (owner & 0xffff);
+  buf->st_atime = mtime;
+  buf->st_mtime = mtime;
+  buf->st_ctime = mtime;
+  buf->st_blksize = fs->block_size;
+
+  if (!S_ISDIR(mode)) {
+    buf->st_size = rtems_cromfs_get_field(node, RTEMS_CROMFS_NODE_SIZE);
+  }
+
+  return 0;
+}
+
+static int rtems_cromfs_fill_dirent(
+  struct dirent *de,
+  off_t off,
+  uint32_t ino,
+  const char *name
+)
+{
+  int eno = 0;
+  size_t len;
+
+  memset(de, 0, sizeof(*de));
+
+  de->d_off = off * sizeof(*de);
+  de->d_reclen = sizeof(*de);
+  de->d_ino = ino;
+
+  len = strlen(name);
+  de->d_namlen = len;
+
+  if (len < sizeof(de->d_name) - 1) {
+    memcpy(&de->d_name[0], name, len);
+  } else {
+    eno = EOVERFLOW;
+  }
+
+  return eno;
+}
+
+static ssize_t rtems_cromfs_dir_read(rtems_libio_t *iop, void *buf, size_t len)
+{
+  const rtems_cromfs_fs_info *fs =
+    rtems_cromfs_get_fs_info_by_location(&iop->pathinfo);
+  const uint8_t *dir = rtems_cromfs_get_node_by_location(&iop->pathinfo);
+  uint32_t first = rtems_cromfs_get_field(dir, RTEMS_CROMFS_NODE_FIRST);
+  uint32_t count = rtems_cromfs_get_field(dir, RTEMS_CROMFS_NODE_COUNT);
+  struct dirent *de = buf;
+  int eno = 0;
+  off_t begin;
+  off_t end;
+  off_t off;
+
+  begin = iop->offset;
+  end = begin + len / sizeof(*de);
+  off = begin;
+
+  if (off == 0 && off < end) {
+    eno = rtems_cromfs_fill_dirent(
+      de,
+      off,
+      rtems_cromfs_get_node_index(fs, dir) + 1,
+      "."
+    );
+    ++off;
+    ++de;
+  }
+
+  if (off == 1 && off < end) {
+    eno = rtems_cromfs_fill_dirent(
+      de,
+      off,
+      rtems_cromfs_get_field(dir, RTEMS_CROMFS_NODE_PARENT) + 1,
+      ".."
+    );
+    ++off;
+    ++de;
+  }
+
+  while (eno == 0 && off < end && off - 2 < count) {
+    uint32_t index = first + (uint32_t) (off - 2);
+    const uint8_t *node = rtems_cromfs_get_node(fs, index);
+
+    eno = rtems_cromfs_fill_dirent(
+      de,
+      off,
+      index + 1,
+      rtems_cromfs_get_string(
+        fs,
+        rtems_cromfs_get_field(node, RTEMS_CROMFS_NODE_NAME)
+      )
+    );
+    ++off;
+    ++de;
+  }
+
+  if (eno == 0) {
+    iop->offset = off;
+
+    return (off - begin) * sizeof(*de);
+  } else {
+    return rtems_cromfs_eno_to_rv_and_errno(eno);
+  }
+}
+
+static const rtems_filesystem_file_handlers_r
+rtems_cromfs_directory_handlers = {
+  .open_h = rtems_filesystem_default_open,
+  .close_h = rtems_filesystem_default_close,
+  .read_h = rtems_cromfs_dir_read,
+  .write_h = rtems_filesystem_default_write,
+  .ioctl_h = rtems_filesystem_default_ioctl,
+  .lseek_h = rtems_filesystem_default_lseek_directory,
+  .fstat_h = rtems_cromfs_fstat,
+  .ftruncate_h = rtems_filesystem_default_ftruncate_directory,
+  .fsync_h = rtems_filesystem_default_fsync_or_fdatasync,
+  .fdatasync_h = rtems_filesystem_default_fsync_or_fdatasync,
+  .fcntl_h = rtems_filesystem_default_fcntl,
+  .kqfilter_h = rtems_filesystem_default_kqfilter,
+  .poll_h = rtems_filesystem_default_poll,
+  .readv_h = rtems_filesystem_default_readv,
+  .writev_h = rtems_filesystem_default_writev,
+  .loan_h = rtems_filesystem_default_loan,
+  .preadv_h = rtems_filesystem_default_preadv,
+  .pwritev_h = rtems_filesystem_default_pwritev
+};
+
+static int rtems_cromfs_read_at(
+  rtems_cromfs_fs_info *fs,
+  const uint8_t *node,
+  void *buf,
+  size_t *len,
+  off_t pos
+)
+{
+  uint32_t size = rtems_cromfs_get_field(node, RTEMS_CROMFS_NODE_SIZE);
+  uint32_t block_size = fs->block_size;
+  uint8_t *out = buf;
+  size_t done = 0;
+  int eno = 0;
+
+  if (pos < (off_t) size) {
+    uint32_t max_available = size - (uint32_t) pos;
+
+    if (*len > max_available) {
+      *len = max_available;
+    }
+  } else {
+    *len = 0;
+  }
+
+  if (*len > 0) {
+    rtems_cromfs_do_lock(fs);
+
+    while (eno == 0 && done < *len) {
+      uint32_t file_pos = (uint32_t) pos + (uint32_t) done;
+      uint32_t offset = file_pos % block_size;
+      const uint8_t *data;
+
+      eno = rtems_cromfs_get_block(fs, node, file_pos / block_size, &data);
+      if (eno == 0) {
+        size_t n = MIN(block_size - offset, *len - done);
+
+        memcpy(out + done, data + offset, n);
+        done += n;
+      }
+    }
+
+    rtems_cromfs_do_unlock(fs);
+  }
+
+  return eno;
+}
+
+static ssize_t rtems_cromfs_file_read(
+  rtems_libio_t *iop,
+  void *buf,
+  size_t len
+)
+{
+  rtems_cromfs_fs_info *fs =
+    rtems_cromfs_get_fs_info_by_location(&iop->pathinfo);
+  const uint8_t *node = rtems_cromfs_get_node_by_location(&iop->pathinfo);
+  int eno;
+
+  eno = rtems_cromfs_read_at(fs, node, buf, &len, iop->offset);
+  if (eno == 0) {
+    iop->offset += (off_t) len;
+
+    return (ssize_t) len;
+  } else {
+    return rtems_cromfs_eno_to_rv_and_errno(eno);
+  }
+}
+
+static ssize_t rtems_cromfs_file_preadv(
+  rtems_libio_t *iop,
+  const struct iovec *iov,
+  int iovcnt,
+  off_t offset,
+  ssize_t total
+)
+{
+  rtems_cromfs_fs_info *fs =
+    rtems_cromfs_get_fs_info_by_location(&iop->pathinfo);
+  const uint8_t *node = rtems_cromfs_get_node_by_location(&iop->pathinfo);
+  ssize_t done = 0;
+  int eno = 0;
+  int v;
+
+  for (v = 0; eno == 0 && v < iovcnt; ++v) {
+    size_t len = iov[v].iov_len;
+
+    eno = rtems_cromfs_read_at(fs, node, iov[v].iov_base, &len, offset + done);
+    if (eno == 0) {
+      done += (ssize_t) len;
+
+      if (len != iov[v].iov_len) {
+        break;
+      }
+    }
+  }
+
+  if (eno == 0) {
+    return done;
+  } else {
+    return rtems_cromfs_eno_to_rv_and_errno(eno);
+  }
+}
+
+static const rtems_filesystem_file_handlers_r rtems_cromfs_file_handlers = {
+  .open_h = rtems_filesystem_default_open,
+  .close_h = rtems_filesystem_default_close,
+  .read_h = rtems_cromfs_file_read,
+  .write_h = rtems_filesystem_default_write,
+  .ioctl_h = rtems_filesystem_default_ioctl,
+  .lseek_h = rtems_filesystem_default_lseek_file,
+  .fstat_h = rtems_cromfs_fstat,
+  .ftruncate_h = rtems_filesystem_default_ftruncate,
+  .fsync_h = rtems_filesystem_default_fsync_or_fdatasync,
+  .fdatasync_h = rtems_filesystem_default_fsync_or_fdatasync,
+  .fcntl_h = rtems_filesystem_default_fcntl,
+  .kqfilter_h = rtems_filesystem_default_kqfilter,
+  .poll_h = rtems_filesystem_default_poll,
+  .readv_h = rtems_filesystem_default_readv,
+  .writev_h = rtems_filesystem_default_writev,
+  .loan_h = rtems_filesystem_default_loan,
+  .preadv_h = rtems_cromfs_file_preadv,
+  .pwritev_h = rtems_filesystem_default_pwritev
+};
+
+static const rtems_filesystem_file_handlers_r rtems_cromfs_link_handlers = {
+  .open_h = rtems_filesystem_default_open,
+  .close_h = rtems_filesystem_default_close,
+  .read_h = rtems_filesystem_default_read,
+  .write_h = rtems_filesystem_default_write,
+  .ioctl_h = rtems_filesystem_default_ioctl,
+  .lseek_h = rtems_filesystem_default_lseek,
+  .fstat_h = rtems_cromfs_fstat,
+  .ftruncate_h = rtems_filesystem_default_ftruncate,
+  .fsync_h = rtems_filesystem_default_fsync_or_fdatasync,
+  .fdatasync_h = rtems_filesystem_default_fsync_or_fdatasync,
+  .fcntl_h = rtems_filesystem_default_fcntl,
+  .kqfilter_h = rtems_filesystem_default_kqfilter,
+  .poll_h = rtems_filesystem_default_poll,
+  .readv_h = rtems_filesystem_default_readv,
+  .writev_h = rtems_filesystem_default_writev,
+  .loan_h = rtems_filesystem_default_loan,
+  .preadv_h = rtems_filesystem_default_preadv,
+  .pwritev_h = rtems_filesystem_default_pwritev
+};
+
+static void rtems_cromfs_lock(
+  const rtems_filesystem_mount_table_entry_t *mt_entry
+)
+{
+  rtems_cromfs_do_lock(mt_entry->fs_info);
+}
+
+static void rtems_cromfs_unlock(
+  const rtems_filesystem_mount_table_entry_t *mt_entry
+)
+{
+  rtems_cromfs_do_unlock(mt_entry->fs_info);
+}
+
+static bool rtems_cromfs_eval_is_directory(
+  rtems_filesystem_eval_path_context_t *ctx,
+  void *arg
+)
+{
+  rtems_filesystem_location_info_t *currentloc =
+    rtems_filesystem_eval_path_get_currentloc(ctx);
+  const uint8_t *node = rtems_cromfs_get_node_by_location(currentloc);
+
+  return S_ISDIR(rtems_cromfs_get_mode(node));
+}
+
+static rtems_filesystem_eval_path_generic_status rtems_cromfs_eval_token(
+  rtems_filesystem_eval_path_context_t *ctx,
+  void *arg,
+  const char *token,
+  size_t tokenlen
+)
+{
+  rtems_filesystem_eval_path_generic_status status =
+    RTEMS_FILESYSTEM_EVAL_PATH_GENERIC_DONE;
+  rtems_filesystem_location_info_t *currentloc =
+    rtems_filesystem_eval_path_get_currentloc(ctx);
+  const rtems_cromfs_fs_info *fs =
+    rtems_cromfs_get_fs_info_by_location(currentloc);
+  const uint8_t *dir = rtems_cromfs_get_node_by_location(currentloc);
+  uint32_t owner = rtems_cromfs_get_field(dir, RTEMS_CROMFS_NODE_OWNER);
+  bool access_ok = rtems_filesystem_eval_path_check_access(
+    ctx,
+    RTEMS_FS_PERMS_EXEC,
+    rtems_cromfs_get_mode(dir),
+    (uid_t) (owner >> 16),
+    (gid_t) (owner & 0xffff)
+  );
+
+  if (access_ok) {
+    const uint8_t *entry;
+
+    if (rtems_filesystem_is_current_directory(token, tokenlen)) {
+      entry = dir;
+    } else if (rtems_filesystem_is_parent_directory(token, tokenlen)) {
+      entry = rtems_cromfs_get_node(
+        fs,
+        rtems_cromfs_get_field(dir, RTEMS_CROMFS_NODE_PARENT)
+      );
+    } else {
+      entry = rtems_cromfs_lookup(fs, dir, token, tokenlen);
+    }
+
+    if (entry != NULL) {
+      bool terminal = !rtems_filesystem_eval_path_has_path(ctx);
+      int eval_flags = rtems_filesystem_eval_path_get_flags(ctx);
+      bool follow_sym_link = (eval_flags & RTEMS_FS_FOLLOW_SYM_LINK) != 0;
+      mode_t mode = rtems_cromfs_get_mode(entry);
+
+      rtems_filesystem_eval_path_clear_token(ctx);
+
+      if (S_ISLNK(mode) && (follow_sym_link || !terminal)) {
+        const char *target = rtems_cromfs_get_string(
+          fs,
+          rtems_cromfs_get_field(entry, RTEMS_CROMFS_NODE_FIRST)
+        );
+
+        rtems_filesystem_eval_path_recursive(ctx, target, strlen(target));
+      } else {
+        rtems_cromfs_set_location(currentloc, entry);
+
+        if (!terminal) {
+          status = RTEMS_FILESYSTEM_EVAL_PATH_GENERIC_CONTINUE;
+        }
+      }
+    } else {
+      status = RTEMS_FILESYSTEM_EVAL_PATH_GENERIC_NO_ENTRY;
+    }
+  }
+
+  return status;
+}
+
+static const rtems_filesystem_eval_path_generic_config
+rtems_cromfs_eval_config = {
+  .is_directory = rtems_cromfs_eval_is_directory,
+  .eval_token = rtems_cromfs_eval_token
+};
+
+static void rtems_cromfs_eval_path(rtems_filesystem_eval_path_context_t *ctx)
+{
+  rtems_filesystem_eval_path_generic(ctx, NULL, &rtems_cromfs_eval_config);
+}
+
+static rtems_filesystem_node_types_t rtems_cromfs_node_type(
+  const rtems_filesystem_location_info_t *loc
+)
+{
+  const uint8_t *node = rtems_cromfs_get_node_by_location(loc);
+  rtems_filesystem_node_types_t type;
+
+  switch (rtems_cromfs_get_mode(node) & S_IFMT) {
+    case S_IFDIR:
+      type = RTEMS_FILESYSTEM_DIRECTORY;
+      break;
+    case S_IFREG:
+      type = RTEMS_FILESYSTEM_MEMORY_FILE;
+      break;
+    case S_IFLNK:
+      type = RTEMS_FILESYSTEM_SYM_LINK;
+      break;
+    default:
+      type = RTEMS_FILESYSTEM_INVALID_NODE_TYPE;
+      break;
+  }
+
+  return type;
+}
+
+static ssize_t rtems_cromfs_readlink(
+  const rtems_filesystem_location_info_t *loc,
+  char *buf,
+  size_t bufsize
+)
+{
+  const rtems_cromfs_fs_info *fs = rtems_cromfs_get_fs_info_by_location(loc);
+  const uint8_t *node = rtems_cromfs_get_node_by_location(loc);
+  const char *target = rtems_cromfs_get_string(
+    fs,
+    rtems_cromfs_get_field(node, RTEMS_CROMFS_NODE_FIRST)
+  );
+  ssize_t i;
+
+  for (i = 0; i < (ssize_t) bufsize && target[i] != '\0'; ++i) {
+    buf[i] = target[i];
+  }
+
+  return i;
+}
+
+static int rtems_cromfs_statvfs(
+  const rtems_filesystem_location_info_t *__restrict loc,
+  struct statvfs *__restrict buf
+)
+{
+  const rtems_cromfs_fs_info *fs = rtems_cromfs_get_fs_info_by_location(loc);
+
+  buf->f_bsize = fs->block_size;
+  buf->f_frsize = fs->block_size;
+  buf->f_blocks = (fs->image_size + fs->block_size - 1) / fs->block_size;
+  buf->f_bfree = 0;
+  buf->f_bavail = 0;
+  buf->f_files = fs->node_count;
+  buf->f_ffree = 0;
+  buf->f_favail = 0;
+  buf->f_fsid = RTEMS_CROMFS_MAGIC;
+  buf->f_namemax = RTEMS_CROMFS_NAME_MAX;
+
+  return 0;
+}
+
+static void rtems_cromfs_free_fs_info(rtems_cromfs_fs_info *fs)
+{
+  if (fs->stream_initialized) {
+    inflateEnd(&fs->stream);
+  }
+
+  if (fs->mutex != 0) {
+    rtems_status_code sc = rtems_semaphore_delete(fs->mutex);
+    assert(sc == RTEMS_SUCCESSFUL);
+  }
+
+  if (fs->fd >= 0) {
+    close(fs->fd);
+  }
+
+  free(fs->cache_data);
+  free(fs->compressed);
+  free(fs->meta_copy);
+  free(fs);
+}
+
+static void rtems_cromfs_fsunmount(
+  rtems_filesystem_mount_table_entry_t *mt_entry
+)
+{
+  rtems_cromfs_free_fs_info(mt_entry->fs_info);
+}
+
+static const rtems_filesystem_operations_table rtems_cromfs_ops = {
+  .lock_h = rtems_cromfs_lock,
+  .unlock_h = rtems_cromfs_unlock,
+  .eval_path_h = rtems_cromfs_eval_path,
+  .link_h = rtems_filesystem_default_link,
+  .are_nodes_equal_h = rtems_filesystem_default_are_nodes_equal,
+  .node_type_h = rtems_cromfs_node_type,
+  .mknod_h = rtems_filesystem_default_mknod,
+  .rmnod_h = rtems_filesystem_default_rmnod,
+  .fchmod_h = rtems_filesystem_default_fchmod,
+  .chown_h = rtems_filesystem_default_chown,
+  .clonenod_h = rtems_filesystem_default_clonenode,
+  .freenod_h = rtems_filesystem_default_freenode,
+  .mount_h = rtems_filesystem_default_mount,
+  .fsmount_me_h = rtems_cromfs_initialize,
+  .unmount_h = rtems_filesystem_default_unmount,
+  .fsunmount_me_h = rtems_cromfs_fsunmount,
+  .utime_h = rtems_filesystem_default_utime,
+  .symlink_h = rtems_filesystem_default_symlink,
+  .readlink_h = rtems_cromfs_readlink,
+  .rename_h = rtems_filesystem_default_rename,
+  .statvfs_h = rtems_cromfs_statvfs
+};
+
+static int rtems_cromfs_check_superblock(
+  rtems_cromfs_fs_info *fs,
+  const uint8_t *sb
+)
+{
+  uint32_t block_size = rtems_cromfs_get_u32(sb + RTEMS_CROMFS_SB_BLOCK_SIZE);
+  uint64_t node_end;
+
+  if (
+    rtems_cromfs_get_u32(sb + RTEMS_CROMFS_SB_MAGIC) != RTEMS_CROMFS_MAGIC
+      || rtems_cromfs_get_u32(sb + RTEMS_CROMFS_SB_VERSION)
+        != RTEMS_CROMFS_VERSION
+  ) {
+    return EINVAL;
+  }
+
+  if (
+    block_size < RTEMS_CROMFS_MIN_BLOCK_SIZE
+      || block_size > RTEMS_CROMFS_MAX_BLOCK_SIZE
+      || (block_size & (block_size - 1)) != 0
+  ) {
+    return EINVAL;
+  }
+
+  fs->block_size = block_size;
+  fs->node_count = rtems_cromfs_get_u32(sb + RTEMS_CROMFS_SB_NODE_COUNT);
+  fs->node_offset = rtems_cromfs_get_u32(sb + RTEMS_CROMFS_SB_NODE_OFFSET);
+  fs->data_offset = rtems_cromfs_get_u32(sb + RTEMS_CROMFS_SB_DATA_OFFSET);
+  fs->image_size = rtems_cromfs_get_u32(sb + RTEMS_CROMFS_SB_IMAGE_SIZE);
+
+  node_end = fs->node_offset
+    + (uint64_t) fs->node_count * RTEMS_CROMFS_NODE_ENTRY_SIZE;
+
+  if (
+    fs->node_count == 0
+      || fs->node_offset < RTEMS_CROMFS_SB_SIZE
+      || node_end > fs->data_offset
+      || fs->data_offset > fs->image_size
+  ) {
+    return EINVAL;
+  }
+
+  return 0;
+}
+
+static bool rtems_cromfs_is_string(
+  const rtems_cromfs_fs_info *fs,
+  uint32_t offset
+)
+{
+  return offset < fs->data_offset
+    && memchr(fs->meta + offset, '\0', fs->data_offset - offset) != NULL;
+}
+
+/*
+ * Checks all metadata references once, so that the path evaluation and the
+ * file handlers can use them without further checks.  The block offsets are
+ * checked on each access.
+ */
+static int rtems_cromfs_check_nodes(const rtems_cromfs_fs_info *fs)
+{
+  uint32_t i;
+
+  if (!S_ISDIR(rtems_cromfs_get_mode(rtems_cromfs_get_node(fs, 0)))) {
+    return EINVAL;
+  }
+
+  for (i = 0; i < fs->node_count; ++i) {
+    const uint8_t *node = rtems_cromfs_get_node(fs, i);
+    uint32_t parent = rtems_cromfs_get_field(node, RTEMS_CROMFS_NODE_PARENT);
+    uint32_t size = rtems_cromfs_get_field(node, RTEMS_CROMFS_NODE_SIZE);
+    uint32_t first = rtems_cromfs_get_field(node, RTEMS_CROMFS_NODE_FIRST);
+    uint32_t count = rtems_cromfs_get_field(node, RTEMS_CROMFS_NODE_COUNT);
+    bool ok;
+
+    if (
+      !rtems_cromfs_is_string(
+        fs,
+        rtems_cromfs_get_field(node, RTEMS_CROMFS_NODE_NAME)
+      )
+        || parent >= fs->node_count
+        || !S_ISDIR(rtems_cromfs_get_mode(rtems_cromfs_get_node(fs, parent)))
+    ) {
+      return EINVAL;
+    }
+
+    switch (rtems_cromfs_get_mode(node) & S_IFMT) {
+      case S_IFDIR:
+        ok = (uint64_t) first + count <= fs->node_count;
+        break;
+      case S_IFREG:
+        ok = count == ((uint64_t) size + fs->block_size - 1) / fs->block_size
+          && first + ((uint64_t) count + 1) * 4 <= fs->data_offset;
+        break;
+      case S_IFLNK:
+        ok = rtems_cromfs_is_string(fs, first);
+        break;
+      default:
+        ok = false;
+        break;
+    }
+
+    if (!ok) {
+      return EINVAL;
+    }
+  }
+
+  return 0;
+}
+
+static int rtems_cromfs_open_image(
+  rtems_cromfs_fs_info *fs,
+  const rtems_cromfs_mount_data *mount_data
+)
+{
+  int eno;
+
+  if (mount_data->image_size < RTEMS_CROMFS_SB_SIZE) {
+    return EINVAL;
+  }
+
+  fs->image = mount_data->image;
+  fs->meta = fs->image;
+
+  eno = rtems_cromfs_check_superblock(fs, fs->image);
+  if (eno == 0 && fs->image_size > mount_data->image_size) {
+    eno = EINVAL;
+  }
+
+  return eno;
+}
+
+static int rtems_cromfs_open_device(
+  rtems_cromfs_fs_info *fs,
+  const char *source
+)
+{
+  uint8_t sb[RTEMS_CROMFS_SB_SIZE];
+  int eno;
+
+  fs->fd = open(source, O_RDONLY);
+  if (fs->fd < 0) {
+    return errno;
+  }
+
+  eno = rtems_cromfs_read_device(fs->fd, &sb[0], sizeof(sb), 0);
+  if (eno == 0) {
+    eno = rtems_cromfs_check_superblock(fs, &sb[0]);
+  }
+
+  if (eno == 0) {
+    fs->meta_copy = malloc(fs->data_offset);
+    fs->compressed = malloc(fs->block_size);
+
+    if (fs->meta_copy == NULL || fs->compressed == NULL) {
+      eno = ENOMEM;
+    }
+  }
+
+  if (eno == 0) {
+    fs->meta = fs->meta_copy;
+    eno = rtems_cromfs_read_device(fs->fd, fs->meta_copy, fs->data_offset, 0);
+  }
+
+  return eno;
+}
+
+static int rtems_cromfs_init_cache(rtems_cromfs_fs_info *fs)
+{
+  uint32_t i;
+
+  fs->cache_data = malloc((size_t) fs->cache_blocks * fs->block_size);
+  if (fs->cache_data == NULL) {
+    return ENOMEM;
+  }
+
+  for (i = 0; i < fs->cache_blocks; ++i) {
+    rtems_cromfs_cache_entry *entry = &fs->cache[i];
+
+    entry->file = RTEMS_CROMFS_NO_NODE;
+    entry->data = fs->cache_data + (size_t) i * fs->block_size;
+    rtems_chain_append_unprotected(&fs->lru, &entry->node);
+  }
+
+  if (inflateInit(&fs->stream) != Z_OK) {
+    return ENOMEM;
+  }
+
+  fs->stream_initialized = true;
+
+  return 0;
+}
+
+int rtems_cromfs_initialize(
+  rtems_filesystem_mount_table_entry_t *mt_entry,
+  const void *data
+)
+{
+  const rtems_cromfs_mount_data *mount_data = data;
+  uint32_t cache_blocks = RTEMS_CROMFS_DEFAULT_CACHE_BLOCKS;
+  rtems_cromfs_fs_info *fs;
+  int eno;
+
+  if (mount_data != NULL && mount_data->cache_blocks != 0) {
+    cache_blocks = mount_data->cache_blocks;
+  }
+
+  fs = calloc(1, sizeof(*fs) + (size_t) cache_blocks * sizeof(fs->cache[0]));
+  if (fs == NULL) {
+    errno = ENOMEM;
+
+    return -1;
+  }
+
+  fs->fd = -1;
+  fs->cache_blocks = cache_blocks;
+  rtems_chain_initialize_empty(&fs->lru);
+
+  if (mount_data != NULL && mount_data->image != NULL) {
+    eno = rtems_cromfs_open_image(fs, mount_data);
+  } else if (mt_entry->dev != NULL) {
+    eno = rtems_cromfs_open_device(fs, mt_entry->dev);
+  } else {
+    eno = EINVAL;
+  }
+
+  if (eno == 0) {
+    eno = rtems_cromfs_check_nodes(fs);
+  }
+
+  if (eno == 0) {
+    eno = rtems_cromfs_init_cache(fs);
+  }
+
+  if (eno == 0) {
+    rtems_status_code sc = rtems_semaphore_create(
+      rtems_build_name('C', 'R', 'O', 'M'),
+      1,
+      RTEMS_PRIORITY | RTEMS_INHERIT_PRIORITY | RTEMS_BINARY_SEMAPHORE,
+      0,
+      &fs->mutex
+    );
+
+    eno = sc == RTEMS_SUCCESSFUL ? 0 : ENOMEM;
+  }
+
+  if (eno == 0) {
+    mt_entry->fs_info = fs;
+    mt_entry->ops = &rtems_cromfs_ops;
+    mt_entry->writeable = false;
+    mt_entry->mt_fs_root->location.node_access =
+      (void *) rtems_cromfs_get_node(fs, 0);
+    mt_entry->mt_fs_root->location.handlers =
+      &rtems_cromfs_directory_handlers;
+
+    return 0;
+  } else {
+    rtems_cromfs_free_fs_info(fs);
+    errno = eno;
+
+    return -1;
+  }
+}
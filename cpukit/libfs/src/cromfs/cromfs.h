@@ -0,0 +1,148 @@
+/**
+ * @file
+ *
+ * @brief Compressed ROM File System (CROMFS)
+ *
+ * @ingroup CROMFS
+ */
+
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifndef RTEMS_CROMFS_H
+#define RTEMS_CROMFS_H
+
+#include <rtems.h>
+#include <rtems/fs.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * @defgroup CROMFS Compressed ROM File System (CROMFS) Support
+ *
+ * @ingroup FileSystemTypesAndMount
+ *
+ * @brief Mount options for the Compressed ROM File System (CROMFS).
+ *
+ * The CROMFS is a read-only file system for static content like web pages or
+ * FPGA bitstreams.  The file data is split into blocks which are compressed
+ * individually with the zlib, so that a read decompresses only the blocks it
+ * touches.  Directories, symbolic links and the per file block indices are
+ * stored uncompressed and are used in place.  Blocks which do not compress
+ * are stored uncompressed.  For an image in memory, reads of such blocks copy
+ * directly from the image.
+ *
+ * Decompressed blocks are kept in a cache with a configurable count of
+ * blocks.  The cache is allocated during mount, so the heap usage of a file
+ * system instance is bounded by the cache size plus the metadata of an image
+ * read from a device.
+ *
+ * Images are created on the host with the rtems-mkcromfs tool, for example
+ * "rtems-mkcromfs -b 4096 www www.img", and can be converted into a C array
+ * with rtems-bin2c.  The image format is defined in <rtems/cromfs-image.h>.
+ *
+ * The image may reside in memory or on a device.  For an image in memory the
+ * mount options must specify the image and the mount source should be
+ * @c NULL.  For an image on a device the source is the path of the device
+ * file, which is read with pread().  In this case the mount options are
+ * optional.  The file system instance is always read-only.
+ *
+ * The application must enable CROMFS support with rtems_filesystem_register()
+ * or CONFIGURE_FILESYSTEM_CROMFS via <rtems/confdefs.h>.  Each mounted
+ * instance needs a semaphore, see also CONFIGURE_MAXIMUM_CROMFS_MOUNTS.
+ *
+ * @code
+ * #include <assert.h>
+ *
+ * #include <rtems/cromfs.h>
+ * #include <rtems/libio.h>
+ *
+ * #include "www_img.h"
+ *
+ * static const rtems_cromfs_mount_data mount_data = {
+ *   .image = www_img,
+ *   .image_size = sizeof(www_img),
+ *   .cache_blocks = 16
+ * };
+ *
+ * void example_cromfs_mount(void)
+ * {
+ *   int rv;
+ *
+ *   rv = mount_and_make_target_path(
+ *     NULL,
+ *     "/www",
+ *     RTEMS_FILESYSTEM_TYPE_CROMFS,
+ *     RTEMS_FILESYSTEM_READ_ONLY,
+ *     &mount_data
+ *   );
+ *   assert(rv == 0);
+ * }
+ * @endcode
+ *
+ * @{
+ */
+
+/**
+ * @brief Default count of cached decompressed blocks.
+ */
+#define RTEMS_CROMFS_DEFAULT_CACHE_BLOCKS 4
+
+/**
+ * @brief CROMFS mount options.
+ */
+typedef struct {
+  /**
+   * @brief Begin of the image in memory.
+   *
+   * In case this pointer is @c NULL, then the image is read from the mount
+   * source device.
+   */
+  const void *image;
+
+  /**
+   * @brief Size in bytes of the image in memory.
+   */
+  size_t image_size;
+
+  /**
+   * @brief Count of cached decompressed blocks.
+   *
+   * In case this value is zero, then RTEMS_CROMFS_DEFAULT_CACHE_BLOCKS is
+   * used.
+   */
+  uint32_t cache_blocks;
+} rtems_cromfs_mount_data;
+
+/**
+ * @brief Initialization handler of the CROMFS file system.
+ *
+ * @param[in, out] mt_entry The mount table entry.
+ * @param[in] data The mount options.  It may be @c NULL for an image on the
+ * mount source device, otherwise it must point to a valid
+ * @ref rtems_cromfs_mount_data structure.
+ *
+ * @retval 0 Successful operation.
+ * @retval -1 An error occurred.  The @c errno indicates the error.
+ *
+ * @see mount().
+ */
+int rtems_cromfs_initialize(
+  rtems_filesystem_mount_table_entry_t *mt_entry,
+  const void *data
+);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* RTEMS_CROMFS_H */
@@ -0,0 +1,32 @@
+/**
+ * @file
+ *
+ * @brief Default Loan Handler
+ *
+ * @ingroup LibIOFSHandler
+ */
+
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#if HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <rtems/libio_.h>
+#include <rtems/seterr.h>
+
+ssize_t rtems_filesystem_default_loan(
+  rtems_libio_t *iop,
+  off_t offset,
+  size_t count,
+  rtems_filesystem_loan *loan
+)
+{
+  rtems_set_errno_and_return_minus_one( ENOTSUP );
+}
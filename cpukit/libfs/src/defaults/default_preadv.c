@@ -0,0 +1,40 @@
+/**
+ * @file
+ *
+ * @brief Default Positional Read IO Vector Handler
+ *
+ * @ingroup LibIOFSHandler
+ */
+
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#if HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include <errno.h>
+
+#include <rtems/libio_.h>
+#include <rtems/seterr.h>
+
+ssize_t rtems_filesystem_default_preadv(
+  rtems_libio_t      *iop,
+  const struct iovec *iov,
+  int                 iovcnt,
+  off_t               offset,
+  ssize_t             total
+)
+{
+  /*
+   * An emulation with the lseek and readv handlers would have to change the
+   * offset of the IO descriptor.  File systems with seekable nodes provide
+   * native handlers instead.
+   */
+  rtems_set_errno_and_return_minus_one( ESPIPE );
+}
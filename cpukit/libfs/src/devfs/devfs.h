@@ -168,6 +168,22 @@ extern int devFS_ioctl(
   void            *buffer
 );
 
+/**
+ *  @brief Maps kqfilter Operation to rtems_io_control
+ *
+ *  This handler passes the kernel event filter to the device driver with the
+ *  RTEMS_IO_KQFILTER io control command.
+ *
+ *  @param iop This is the RTEMS's internal representation of file
+ *  @param kn The kernel event filter
+ *
+ *  @retval 0 On success.  Otherwise an error number.
+ */
+extern int devFS_kqfilter(
+  rtems_libio_t *iop,
+  struct knote  *kn
+);
+
 /**
  *  @brief Gets the Device File Information
  *
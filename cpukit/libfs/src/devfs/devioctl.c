@@ -29,3 +29,13 @@ int devFS_ioctl(
 
   return rtems_deviceio_control( iop, command, buffer, np->major, np->minor );
 }
+
+int devFS_kqfilter(
+  rtems_libio_t *iop,
+  struct knote  *kn
+)
+{
+  const devFS_node *np = iop->pathinfo.node_access;
+
+  return rtems_deviceio_kqfilter( iop, kn, np->major, np->minor );
+}
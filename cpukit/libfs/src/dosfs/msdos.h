@@ -347,6 +347,36 @@ ssize_t msdos_file_write(
   size_t         count            /* IN  */
 );
 
+ssize_t msdos_file_readv(
+  rtems_libio_t      *iop,        /* IN  */
+  const struct iovec *iov,        /* IN  */
+  int                 iovcnt,     /* IN  */
+  ssize_t             total       /* IN  */
+);
+
+ssize_t msdos_file_writev(
+  rtems_libio_t      *iop,        /* IN  */
+  const struct iovec *iov,        /* IN  */
+  int                 iovcnt,     /* IN  */
+  ssize_t             total       /* IN  */
+);
+
+ssize_t msdos_file_preadv(
+  rtems_libio_t      *iop,        /* IN  */
+  const struct iovec *iov,        /* IN  */
+  int                 iovcnt,     /* IN  */
+  off_t               offset,     /* IN  */
+  ssize_t             total       /* IN  */
+);
+
+ssize_t msdos_file_pwritev(
+  rtems_libio_t      *iop,        /* IN  */
+  const struct iovec *iov,        /* IN  */
+  int                 iovcnt,     /* IN  */
+  off_t               offset,     /* IN  */
+  ssize_t             total       /* IN  */
+);
+
 int msdos_file_stat(
   const rtems_filesystem_location_info_t *loc,
   struct stat *buf
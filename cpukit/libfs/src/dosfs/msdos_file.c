@@ -178,6 +178,190 @@ msdos_file_write(rtems_libio_t *iop,const void *buffer, size_t count)
     return ret;
 }
 
+/* msdos_file_read_vector --
+ *     This routine reads the IO vector entries one after another from the
+ *     file starting at the offset.  The volume semaphore must be obtained.
+ *
+ * RETURNS:
+ *     the number of bytes read on success, or -1 if error occured (errno set
+ *     appropriately)
+ */
+static ssize_t
+msdos_file_read_vector(msdos_fs_info_t *fs_info, fat_file_fd_t *fat_fd,
+                       const struct iovec *iov, int iovcnt, off_t offset)
+{
+    ssize_t total = 0;
+    int     v;
+
+    for (v = 0; v < iovcnt; ++v)
+    {
+        size_t  len = iov[v].iov_len;
+        ssize_t ret;
+
+        if (len == 0)
+            continue;
+
+        ret = fat_file_read(&fs_info->fat, fat_fd, offset, len,
+                            iov[v].iov_base);
+        if (ret < 0)
+            return -1;
+
+        offset += ret;
+        total += ret;
+
+        if ((size_t) ret != len)
+            break;
+    }
+
+    return total;
+}
+
+/* msdos_file_write_vector --
+ *     This routine writes the IO vector entries one after another to the
+ *     file starting at the offset.  The volume semaphore must be obtained.
+ *
+ * RETURNS:
+ *     the number of bytes written on success, or -1 if error occured
+ *     and errno set appropriately
+ */
+static ssize_t
+msdos_file_write_vector(msdos_fs_info_t *fs_info, fat_file_fd_t *fat_fd,
+                        const struct iovec *iov, int iovcnt, off_t offset)
+{
+    ssize_t total = 0;
+    int     v;
+
+    for (v = 0; v < iovcnt; ++v)
+    {
+        size_t  len = iov[v].iov_len;
+        ssize_t ret;
+
+        if (len == 0)
+            continue;
+
+        ret = fat_file_write(&fs_info->fat, fat_fd, offset, len,
+                             iov[v].iov_base);
+        if (ret < 0)
+            return total > 0 ? total : -1;
+
+        /*
+         * update file size in fat-file descriptor if file was extended
+         */
+        offset += ret;
+        total += ret;
+        if (offset > fat_fd->fat_file_size)
+            fat_fd->fat_file_size = offset;
+
+        if ((size_t) ret != len)
+            break;
+    }
+
+    return total;
+}
+
+/* msdos_file_readv --
+ *     This routine reads from the file into the IO vector at the file
+ *     offset of the file control block.
+ */
+ssize_t
+msdos_file_readv(rtems_libio_t *iop, const struct iovec *iov, int iovcnt,
+                 ssize_t total)
+{
+    ssize_t            ret = 0;
+    rtems_status_code  sc = RTEMS_SUCCESSFUL;
+    msdos_fs_info_t   *fs_info = iop->pathinfo.mt_entry->fs_info;
+    fat_file_fd_t     *fat_fd = iop->pathinfo.node_access;
+
+    sc = rtems_semaphore_obtain(fs_info->vol_sema, RTEMS_WAIT,
+                                MSDOS_VOLUME_SEMAPHORE_TIMEOUT);
+    if (sc != RTEMS_SUCCESSFUL)
+        rtems_set_errno_and_return_minus_one(EIO);
+
+    ret = msdos_file_read_vector(fs_info, fat_fd, iov, iovcnt, iop->offset);
+    if (ret > 0)
+        iop->offset += ret;
+
+    rtems_semaphore_release(fs_info->vol_sema);
+    return ret;
+}
+
+/* msdos_file_writev --
+ *     This routine writes the IO vector into the file at the file offset of
+ *     the file control block.
+ */
+ssize_t
+msdos_file_writev(rtems_libio_t *iop, const struct iovec *iov, int iovcnt,
+                  ssize_t total)
+{
+    ssize_t            ret = 0;
+    rtems_status_code  sc = RTEMS_SUCCESSFUL;
+    msdos_fs_info_t   *fs_info = iop->pathinfo.mt_entry->fs_info;
+    fat_file_fd_t     *fat_fd = iop->pathinfo.node_access;
+
+    sc = rtems_semaphore_obtain(fs_info->vol_sema, RTEMS_WAIT,
+                                MSDOS_VOLUME_SEMAPHORE_TIMEOUT);
+    if (sc != RTEMS_SUCCESSFUL)
+        rtems_set_errno_and_return_minus_one(EIO);
+
+    if ((iop->flags & LIBIO_FLAGS_APPEND) != 0)
+        iop->offset = fat_fd->fat_file_size;
+
+    ret = msdos_file_write_vector(fs_info, fat_fd, iov, iovcnt, iop->offset);
+    if (ret > 0)
+        iop->offset += ret;
+
+    rtems_semaphore_release(fs_info->vol_sema);
+    return ret;
+}
+
+/* msdos_file_preadv --
+ *     This routine reads from the file into the IO vector at the offset.
+ *     The file offset of the file control block stays as is.
+ */
+ssize_t
+msdos_file_preadv(rtems_libio_t *iop, const struct iovec *iov, int iovcnt,
+                  off_t offset, ssize_t total)
+{
+    ssize_t            ret = 0;
+    rtems_status_code  sc = RTEMS_SUCCESSFUL;
+    msdos_fs_info_t   *fs_info = iop->pathinfo.mt_entry->fs_info;
+    fat_file_fd_t     *fat_fd = iop->pathinfo.node_access;
+
+    sc = rtems_semaphore_obtain(fs_info->vol_sema, RTEMS_WAIT,
+                                MSDOS_VOLUME_SEMAPHORE_TIMEOUT);
+    if (sc != RTEMS_SUCCESSFUL)
+        rtems_set_errno_and_return_minus_one(EIO);
+
+    ret = msdos_file_read_vector(fs_info, fat_fd, iov, iovcnt, offset);
+
+    rtems_semaphore_release(fs_info->vol_sema);
+    return ret;
+}
+
+/* msdos_file_pwritev --
+ *     This routine writes the IO vector into the file at the offset.  The
+ *     file offset of the file control block stays as is.
+ */
+ssize_t
+msdos_file_pwritev(rtems_libio_t *iop, const struct iovec *iov, int iovcnt,
+                   off_t offset, ssize_t total)
+{
+    ssize_t            ret = 0;
+    rtems_status_code  sc = RTEMS_SUCCESSFUL;
+    msdos_fs_info_t   *fs_info = iop->pathinfo.mt_entry->fs_info;
+    fat_file_fd_t     *fat_fd = iop->pathinfo.node_access;
+
+    sc = rtems_semaphore_obtain(fs_info->vol_sema, RTEMS_WAIT,
+                                MSDOS_VOLUME_SEMAPHORE_TIMEOUT);
+    if (sc != RTEMS_SUCCESSFUL)
+        rtems_set_errno_and_return_minus_one(EIO);
+
+    ret = msdos_file_write_vector(fs_info, fat_fd, iov, iovcnt, offset);
+
+    rtems_semaphore_release(fs_info->vol_sema);
+    return ret;
+}
+
 /* msdos_file_stat --
  *
  * PARAMETERS:
@@ -35,6 +35,9 @@ const rtems_filesystem_file_handlers_r msdos_file_handlers = {
   .fcntl_h = rtems_filesystem_default_fcntl,
   .kqfilter_h = rtems_filesystem_default_kqfilter,
   .poll_h = rtems_filesystem_default_poll,
-  .readv_h = rtems_filesystem_default_readv,
-  .writev_h = rtems_filesystem_default_writev
+  .readv_h = msdos_file_readv,
+  .writev_h = msdos_file_writev,
+  .loan_h = rtems_filesystem_default_loan,
+  .preadv_h = msdos_file_preadv,
+  .pwritev_h = msdos_file_pwritev
 };
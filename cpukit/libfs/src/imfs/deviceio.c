@@ -122,3 +122,20 @@ int device_ftruncate(
 {
   return 0;
 }
+
+int device_kqfilter(
+  rtems_libio_t *iop,
+  struct knote  *kn
+)
+{
+  IMFS_jnode_t *the_jnode;
+
+  the_jnode = iop->pathinfo.node_access;
+
+  return rtems_deviceio_kqfilter(
+    iop,
+    kn,
+    the_jnode->info.device.major,
+    the_jnode->info.device.minor
+  );
+}
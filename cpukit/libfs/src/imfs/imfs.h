@@ -97,6 +97,30 @@ typedef struct {
 #define IMFS_MEMFILE_BLOCK_SLOTS \
   (IMFS_MEMFILE_BYTES_PER_BLOCK / sizeof(void *))
 
+/**
+ *  IMFS "memfile" extents
+ *
+ *  With a non-zero extent size the file data past the extent size is not
+ *  stored in blocks.  It is stored in contiguous extents instead.  The size
+ *  of the first extent is the extent size and doubles with each of the next
+ *  IMFS_MEMFILE_EXTENT_DOUBLINGS extents.  All later extents have the size
+ *  of the last doubling, so the memory allocated past the end of file is
+ *  bounded.  A file of several megabytes needs a few allocations this way
+ *  and large reads and writes copy long contiguous areas.  Extents never
+ *  move, so the data can be loaned.
+ *
+ *  The extent size must be a power of two which is at least the block size
+ *  and less than the maximum file size with blocks.  Otherwise, extents are
+ *  disabled.  The default extent size is zero (extents disabled).
+ */
+#define IMFS_MEMFILE_DEFAULT_EXTENT_SIZE 0
+  extern int imfs_rq_memfile_extent_size;
+  extern int imfs_memfile_extent_size;
+
+#define IMFS_MEMFILE_EXTENT_SIZE imfs_memfile_extent_size
+#define IMFS_MEMFILE_EXTENT_DOUBLINGS 4
+#define IMFS_MEMFILE_EXTENT_MAXIMUM_SIZE ((off_t) 1 << 30)
+
 typedef uint8_t *block_p;
 typedef block_p *block_ptr;
 
@@ -105,6 +129,10 @@ typedef struct {
   block_ptr     indirect;         /* array of 128 data blocks pointers */
   block_ptr     doubly_indirect;  /* 128 indirect blocks */
   block_ptr     triply_indirect;  /* 128 doubly indirect blocks */
+  block_ptr     extents;          /* array of extent pointers */
+  unsigned int  extent_slots;     /* count of extent pointers */
+  IMFS_jnode_t *released_next;    /* next node with released loans */
+  unsigned short released_loans;  /* loan references to drop */
 } IMFS_memfile_t;
 
 typedef struct {
@@ -778,6 +806,79 @@ extern ssize_t memfile_write(
   size_t         count            /* IN  */
 );
 
+/**
+ * @brief Read a memory file into an IO vector.
+ *
+ * This routine processes the readv() system call.
+ */
+extern ssize_t memfile_readv(
+  rtems_libio_t      *iop,        /* IN  */
+  const struct iovec *iov,        /* IN  */
+  int                 iovcnt,     /* IN  */
+  ssize_t             total       /* IN  */
+);
+
+/**
+ * @brief Write an IO vector to a memory file.
+ *
+ * This routine processes the writev() system call.
+ */
+extern ssize_t memfile_writev(
+  rtems_libio_t      *iop,        /* IN  */
+  const struct iovec *iov,        /* IN  */
+  int                 iovcnt,     /* IN  */
+  ssize_t             total       /* IN  */
+);
+
+/**
+ * @brief Read a memory file into an IO vector at a file offset.
+ *
+ * This routine processes the preadv() system call.
+ */
+extern ssize_t memfile_preadv(
+  rtems_libio_t      *iop,        /* IN  */
+  const struct iovec *iov,        /* IN  */
+  int                 iovcnt,     /* IN  */
+  off_t               offset,     /* IN  */
+  ssize_t             total       /* IN  */
+);
+
+/**
+ * @brief Write an IO vector to a memory file at a file offset.
+ *
+ * This routine processes the pwritev() system call.
+ */
+extern ssize_t memfile_pwritev(
+  rtems_libio_t      *iop,        /* IN  */
+  const struct iovec *iov,        /* IN  */
+  int                 iovcnt,     /* IN  */
+  off_t               offset,     /* IN  */
+  ssize_t             total       /* IN  */
+);
+
+/**
+ * @brief Drop the node references of released memory file loans.
+ *
+ * The release handler of a loan only queues the node since it may be called
+ * with the network semaphore held.  This routine must be called with the
+ * file system lock held.
+ */
+extern void IMFS_memfile_drop_released_loans( void );
+
+/**
+ * @brief Lend the data of a memory file.
+ *
+ * This routine provides the file data to sendfile() without a copy.  The
+ * data of a linear file is lent up to the end of file, otherwise up to the
+ * end of the memory file block.
+ */
+extern ssize_t memfile_loan(
+  rtems_libio_t         *iop,     /* IN  */
+  off_t                  offset,  /* IN  */
+  size_t                 count,   /* IN  */
+  rtems_filesystem_loan *loan     /* OUT */
+);
+
 /** @} */
 
 /**
@@ -822,6 +923,11 @@ extern int device_ftruncate(
   off_t          length             /* IN  */
 );
 
+extern int device_kqfilter(
+  rtems_libio_t *iop,
+  struct knote  *kn
+);
+
 /** @} */
 
 /**
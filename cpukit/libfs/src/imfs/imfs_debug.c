@@ -134,5 +134,8 @@ void IMFS_dump( void )
 
 int IMFS_memfile_maximum_size( void )
 {
+  if ( IMFS_MEMFILE_EXTENT_SIZE != 0 )
+    return IMFS_MEMFILE_EXTENT_MAXIMUM_SIZE;
+
   return IMFS_MEMFILE_MAXIMUM_SIZE;
 }
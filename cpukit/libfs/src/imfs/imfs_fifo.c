@@ -112,6 +112,16 @@ static int IMFS_fifo_ioctl(
   IMFS_FIFO_RETURN(err);
 }
 
+static int IMFS_fifo_kqfilter(
+  rtems_libio_t *iop,
+  struct knote  *kn
+)
+{
+  int err = pipe_kqfilter(LIBIO2PIPE(iop), kn, iop);
+
+  return -err;
+}
+
 static const rtems_filesystem_file_handlers_r IMFS_fifo_handlers = {
   .open_h = IMFS_fifo_open,
   .close_h = IMFS_fifo_close,
@@ -124,10 +134,13 @@ static const rtems_filesystem_file_handlers_r IMFS_fifo_handlers = {
   .fsync_h = rtems_filesystem_default_fsync_or_fdatasync,
   .fdatasync_h = rtems_filesystem_default_fsync_or_fdatasync,
   .fcntl_h = rtems_filesystem_default_fcntl,
-  .kqfilter_h = rtems_filesystem_default_kqfilter,
+  .kqfilter_h = IMFS_fifo_kqfilter,
   .poll_h = rtems_filesystem_default_poll,
   .readv_h = rtems_filesystem_default_readv,
-  .writev_h = rtems_filesystem_default_writev
+  .writev_h = rtems_filesystem_default_writev,
+  .loan_h = rtems_filesystem_default_loan,
+  .preadv_h = rtems_filesystem_default_preadv,
+  .pwritev_h = rtems_filesystem_default_pwritev
 };
 
 const IMFS_node_control IMFS_node_control_fifo = {
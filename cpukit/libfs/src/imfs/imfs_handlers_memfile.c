@@ -47,8 +47,11 @@ static const rtems_filesystem_file_handlers_r IMFS_memfile_handlers = {
   .fcntl_h = rtems_filesystem_default_fcntl,
   .kqfilter_h = rtems_filesystem_default_kqfilter,
   .poll_h = rtems_filesystem_default_poll,
-  .readv_h = rtems_filesystem_default_readv,
-  .writev_h = rtems_filesystem_default_writev
+  .readv_h = memfile_readv,
+  .writev_h = memfile_writev,
+  .loan_h = memfile_loan,
+  .preadv_h = memfile_preadv,
+  .pwritev_h = memfile_pwritev
 };
 
 const IMFS_node_control IMFS_node_control_memfile = {
@@ -55,6 +55,24 @@ static int IMFS_determine_bytes_per_block(
   return 0;
 }
 
+/*
+ *  IMFS_determine_extent_size
+ */
+int imfs_memfile_extent_size = 0;
+
+static void IMFS_determine_extent_size(
+  int *dest_extent_size,
+  int requested_extent_size,
+  int bytes_per_block
+)
+{
+  bool is_valid = requested_extent_size >= bytes_per_block
+    && (size_t) requested_extent_size < IMFS_MEMFILE_MAXIMUM_SIZE
+    && (requested_extent_size & (requested_extent_size - 1)) == 0;
+
+  *dest_extent_size = is_valid ? requested_extent_size : 0;
+}
+
 int IMFS_initialize_support(
   rtems_filesystem_mount_table_entry_t *mt_entry,
   const rtems_filesystem_operations_table *op_table,
@@ -106,6 +124,11 @@ int IMFS_initialize_support(
       imfs_rq_memfile_bytes_per_block,
       IMFS_MEMFILE_DEFAULT_BYTES_PER_BLOCK
     );
+    IMFS_determine_extent_size(
+      &imfs_memfile_extent_size,
+      imfs_rq_memfile_extent_size,
+      imfs_memfile_bytes_per_block
+    );
   }
 
   return rv;
@@ -133,6 +156,8 @@ void IMFS_node_free( const rtems_filesystem_location_info_t *loc )
 {
   IMFS_jnode_t *node = loc->node_access;
 
+  IMFS_memfile_drop_released_loans();
+
   --node->reference_count;
 
   if ( node->reference_count == 0 ) {
@@ -21,8 +21,10 @@
 #include "imfs.h"
 
 #include <sys/stat.h>
+#include <errno.h>
 #include <string.h>
 #include <tar.h>
+#include <unistd.h>
 
 #include <rtems/untar.h>
 
@@ -30,6 +32,79 @@
 
 #define MIN(a,b)   ((a)>(b)?(b):(a))
 
+/*
+ * Get the full path of a tar entry below the mount point.
+ */
+static void rtems_tarfs_full_path(
+  char       *full_filename,
+  const char *mountpoint,
+  const char *filename,
+  size_t      filename_len
+)
+{
+  int len;
+
+  strncpy(full_filename, mountpoint, 255);
+  full_filename[255] = '\0';
+  len = strlen(full_filename);
+  if (len == 0 || full_filename[len-1] != '/')
+    strcat(full_filename, "/");
+  ++len;
+  strncat(full_filename, filename, MIN(filename_len, (size_t) (256-len-1)));
+}
+
+/*
+ * Create the missing directories of a path relative to the mount point.
+ * Tar images need not contain an entry for each directory.
+ */
+static void rtems_tarfs_make_parents(
+  const char *mountpoint,
+  const char *filename,
+  size_t      dirlen
+)
+{
+  char   full_filename[256];
+  size_t i;
+
+  for (i = 1; i < dirlen; ++i) {
+    if (filename[i] == '/') {
+      rtems_tarfs_full_path(full_filename, mountpoint, filename, i);
+      mkdir(full_filename, S_IRWXU | S_IRWXG | S_IRWXO);
+    }
+  }
+}
+
+/*
+ * Create a directory of the tar image.  A directory which exists already is
+ * accepted, for example as the parent of a previous entry.
+ */
+static int rtems_tarfs_make_directory(const char *full_filename)
+{
+  struct stat st;
+  int         rv;
+
+  rv = mkdir(full_filename, S_IRWXU | S_IRWXG | S_IRWXO);
+  if (rv != 0 && errno == EEXIST) {
+    if (stat(full_filename, &st) == 0 && S_ISDIR(st.st_mode)) {
+      rv = 0;
+    } else {
+      errno = EEXIST;
+    }
+  }
+
+  return rv;
+}
+
+/*
+ * Get the length of the directory part of a path including the last slash.
+ */
+static size_t rtems_tarfs_dirname_length(const char *filename)
+{
+  const char *slash = strrchr(filename, '/');
+
+  return slash != NULL ? (size_t) (slash - filename + 1) : 0;
+}
+
 int rtems_tarfs_load(
   const char *mountpoint,
   uint8_t *tar_image,
@@ -39,10 +114,12 @@ int rtems_tarfs_load(
    const char                       *hdr_ptr;
    char                             filename[100];
    char                             full_filename[256];
+   char                             linkname[100];
    int                              hdr_chksum;
    unsigned char                    linkflag;
    unsigned long                    file_size;
    unsigned long                    file_mode;
+   time_t                           file_mtime;
    int                              offset;
    unsigned long                    nblocks;
    IMFS_jnode_t                    *node;
@@ -50,14 +127,14 @@ int rtems_tarfs_load(
    int eval_flags = RTEMS_FS_FOLLOW_LINK;
    rtems_filesystem_eval_path_context_t ctx;
    rtems_filesystem_location_info_t rootloc;
+   rtems_filesystem_location_info_t parentloc;
+   char                             parent[100];
+   size_t                           parentlen = 0;
+   bool                             have_parent = false;
    rtems_filesystem_location_info_t *currentloc =
      rtems_filesystem_eval_path_start( &ctx, mountpoint, eval_flags );
 
    rtems_filesystem_eval_path_extract_currentloc( &ctx, &rootloc );
-   rtems_filesystem_eval_path_set_flags(
-     &ctx,
-     RTEMS_FS_MAKE | RTEMS_FS_EXCLUSIVE
-   );
 
    if (
      rootloc.mt_entry->ops != &IMFS_ops
@@ -88,6 +165,7 @@ int rtems_tarfs_load(
     linkflag   = hdr_ptr[156];
     file_mode  = _rtems_octal2ulong(&hdr_ptr[100], 8);
     file_size  = _rtems_octal2ulong(&hdr_ptr[124], 12);
+    file_mtime = (time_t) _rtems_octal2ulong(&hdr_ptr[136], 12);
     hdr_chksum = _rtems_octal2ulong(&hdr_ptr[148], 8);
 
     if (_rtems_tar_header_checksum(hdr_ptr) != hdr_chksum)
@@ -97,31 +175,100 @@ int rtems_tarfs_load(
      * Generate an IMFS node depending on the file type.
      * - For directories, just create directories as usual.  IMFS
      *   will take care of the rest.
+     * - For symbolic links, create symbolic links as usual.
      * - For files, create a file node with special tarfs properties.
      */
     if (linkflag == DIRTYPE) {
-      int len;
-      strncpy(full_filename, mountpoint, 255);
-      if (full_filename[(len=strlen(full_filename))-1] != '/')
-        strcat(full_filename, "/");
-      ++len;
-      strncat(full_filename, filename, 256-len-1);
-      rv = mkdir(full_filename, S_IRWXU | S_IRWXG | S_IRWXO);
+      rtems_tarfs_full_path(
+        full_filename,
+        mountpoint,
+        filename,
+        strlen(filename)
+      );
+      rtems_tarfs_make_parents(mountpoint, filename, strlen(filename));
+      rv = rtems_tarfs_make_directory(full_filename);
+    }
+    else if (linkflag == SYMTYPE) {
+      strncpy(linkname, &hdr_ptr[157], MAX_NAME_FIELD_SIZE);
+      linkname[MAX_NAME_FIELD_SIZE] = '\0';
+      rtems_tarfs_full_path(
+        full_filename,
+        mountpoint,
+        filename,
+        strlen(filename)
+      );
+      rtems_tarfs_make_parents(
+        mountpoint,
+        filename,
+        rtems_tarfs_dirname_length(filename)
+      );
+      rv = symlink(linkname, full_filename);
     }
     /*
      * Create a LINEAR_FILE node
      */
-    else if (linkflag == REGTYPE) {
-      rtems_filesystem_location_free( currentloc );
-      rtems_filesystem_location_clone( currentloc, &rootloc );
-      rtems_filesystem_eval_path_set_path(
-        &ctx,
-        filename,
-        strlen( filename )
-      );
-      rtems_filesystem_eval_path_continue( &ctx );
+    else if (linkflag == REGTYPE || linkflag == AREGTYPE) {
+      size_t dirlen = rtems_tarfs_dirname_length(filename);
+
+      /*
+       * The entries of a directory are usually consecutive in a tar image.
+       * Keep the location of the last parent directory, so that only the
+       * file name needs to be evaluated for the next file in it.
+       */
+      if (
+        !have_parent
+          || dirlen != parentlen
+          || memcmp(parent, filename, dirlen) != 0
+      ) {
+        if (have_parent) {
+          rtems_filesystem_location_free( &parentloc );
+          have_parent = false;
+        }
+
+        if ( dirlen == 0 ) {
+          rtems_filesystem_location_clone( &parentloc, &rootloc );
+          parentlen = 0;
+          have_parent = true;
+        } else {
+          rtems_tarfs_make_parents(mountpoint, filename, dirlen);
+
+          /*
+           * The token of the previous evaluation must not be taken as the
+           * start of this path.
+           */
+          rtems_filesystem_location_free( currentloc );
+          rtems_filesystem_location_clone( currentloc, &rootloc );
+          rtems_filesystem_eval_path_clear_token( &ctx );
+          rtems_filesystem_eval_path_set_flags( &ctx, RTEMS_FS_FOLLOW_LINK );
+          rtems_filesystem_eval_path_set_path( &ctx, filename, dirlen );
+          rtems_filesystem_eval_path_continue( &ctx );
+
+          if ( !rtems_filesystem_location_is_null( currentloc ) ) {
+            rtems_filesystem_location_clone( &parentloc, currentloc );
+            memcpy(parent, filename, dirlen);
+            parentlen = dirlen;
+            have_parent = true;
+          }
+        }
+      }
 
-      if ( !rtems_filesystem_location_is_null( currentloc ) ) {
+      if ( have_parent ) {
+        rtems_filesystem_location_free( currentloc );
+        rtems_filesystem_location_clone( currentloc, &parentloc );
+        rtems_filesystem_eval_path_clear_token( &ctx );
+        rtems_filesystem_eval_path_set_flags(
+          &ctx,
+          RTEMS_FS_MAKE | RTEMS_FS_EXCLUSIVE
+        );
+        rtems_filesystem_eval_path_set_path(
+          &ctx,
+          &filename[dirlen],
+          strlen( &filename[dirlen] )
+        );
+        rtems_filesystem_eval_path_continue( &ctx );
+      }
+
+      if ( have_parent && !rtems_filesystem_location_is_null( currentloc ) ) {
         node = IMFS_create_node(
           currentloc,
           IMFS_LINEAR_FILE,
@@ -130,8 +277,13 @@ int rtems_tarfs_load(
           (file_mode & (S_IRWXU | S_IRWXG | S_IRWXO)) | S_IFREG,
           NULL
         );
-        node->info.linearfile.size   = file_size;
-        node->info.linearfile.direct = &tar_image[offset];
+        if ( node != NULL ) {
+          node->info.linearfile.size   = file_size;
+          node->info.linearfile.direct = &tar_image[offset];
+          node->stat_mtime             = file_mtime;
+        } else {
+          rv = -1;
+        }
       }
 
       nblocks = (((file_size) + 511) & ~511) / 512;
@@ -139,9 +291,11 @@ int rtems_tarfs_load(
     }
   }
 
+  if ( have_parent )
+    rtems_filesystem_location_free( &parentloc );
+
   rtems_filesystem_location_free( &rootloc );
   rtems_filesystem_eval_path_cleanup( &ctx );
 
   return rv;
 }
-
@@ -23,6 +23,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <rtems/score/threaddispatch.h>
+
 #define MEMFILE_STATIC
 
 /*
@@ -50,6 +52,12 @@ MEMFILE_STATIC block_p *IMFS_memfile_get_block_pointer(
    int             malloc_it
 );
 
+MEMFILE_STATIC unsigned char *IMFS_memfile_get_data(
+   IMFS_jnode_t   *the_jnode,
+   off_t           offset,
+   size_t         *count
+);
+
 MEMFILE_STATIC ssize_t IMFS_memfile_read(
    IMFS_jnode_t    *the_jnode,
    off_t            start,
@@ -94,6 +102,10 @@ int memfile_open(
     the_jnode->info.file.indirect        = 0;
     the_jnode->info.file.doubly_indirect = 0;
     the_jnode->info.file.triply_indirect = 0;
+    the_jnode->info.file.extents         = 0;
+    the_jnode->info.file.extent_slots    = 0;
+    the_jnode->info.file.released_next   = NULL;
+    the_jnode->info.file.released_loans  = 0;
     if ((count != 0)
      && (IMFS_memfile_write(the_jnode, 0, buffer, count) == -1))
         return -1;
@@ -143,6 +155,272 @@ ssize_t memfile_write(
   return status;
 }
 
+/*
+ *  memfile_vector_read
+ *
+ *  Read the IO vector entries one after another starting at the offset.
+ *  Stop at the end of file.
+ */
+static ssize_t memfile_vector_read(
+  IMFS_jnode_t       *the_jnode,
+  const struct iovec *iov,
+  int                 iovcnt,
+  off_t               offset
+)
+{
+  ssize_t total = 0;
+  int     v;
+
+  for ( v = 0 ; v < iovcnt ; ++v ) {
+    size_t  len = iov[ v ].iov_len;
+    ssize_t status;
+
+    if ( len == 0 )
+      continue;
+
+    status = IMFS_memfile_read( the_jnode, offset, iov[ v ].iov_base, len );
+    if ( status < 0 )
+      return -1;
+
+    offset += status;
+    total += status;
+
+    if ( (size_t) status != len )
+      break;
+  }
+
+  return total;
+}
+
+/*
+ *  memfile_vector_write
+ *
+ *  Write the IO vector entries one after another starting at the offset.
+ */
+static ssize_t memfile_vector_write(
+  IMFS_jnode_t       *the_jnode,
+  const struct iovec *iov,
+  int                 iovcnt,
+  off_t               offset
+)
+{
+  ssize_t total = 0;
+  int     v;
+
+  for ( v = 0 ; v < iovcnt ; ++v ) {
+    size_t  len = iov[ v ].iov_len;
+    ssize_t status;
+
+    if ( len == 0 )
+      continue;
+
+    status = IMFS_memfile_write( the_jnode, offset, iov[ v ].iov_base, len );
+    if ( status < 0 )
+      return total > 0 ? total : -1;
+
+    offset += status;
+    total += status;
+
+    if ( (size_t) status != len )
+      break;
+  }
+
+  return total;
+}
+
+ssize_t memfile_readv(
+  rtems_libio_t      *iop,
+  const struct iovec *iov,
+  int                 iovcnt,
+  ssize_t             total
+)
+{
+  IMFS_jnode_t   *the_jnode;
+  ssize_t         status;
+
+  the_jnode = iop->pathinfo.node_access;
+
+  status = memfile_vector_read( the_jnode, iov, iovcnt, iop->offset );
+
+  if ( status > 0 )
+    iop->offset += status;
+
+  return status;
+}
+
+ssize_t memfile_writev(
+  rtems_libio_t      *iop,
+  const struct iovec *iov,
+  int                 iovcnt,
+  ssize_t             total
+)
+{
+  IMFS_jnode_t   *the_jnode;
+  ssize_t         status;
+
+  the_jnode = iop->pathinfo.node_access;
+
+  if ((iop->flags & LIBIO_FLAGS_APPEND) != 0)
+    iop->offset = the_jnode->info.file.size;
+
+  status = memfile_vector_write( the_jnode, iov, iovcnt, iop->offset );
+
+  if ( status > 0 )
+    iop->offset += status;
+
+  return status;
+}
+
+ssize_t memfile_preadv(
+  rtems_libio_t      *iop,
+  const struct iovec *iov,
+  int                 iovcnt,
+  off_t               offset,
+  ssize_t             total
+)
+{
+  return memfile_vector_read(
+    iop->pathinfo.node_access,
+    iov,
+    iovcnt,
+    offset
+  );
+}
+
+ssize_t memfile_pwritev(
+  rtems_libio_t      *iop,
+  const struct iovec *iov,
+  int                 iovcnt,
+  off_t               offset,
+  ssize_t             total
+)
+{
+  return memfile_vector_write(
+    iop->pathinfo.node_access,
+    iov,
+    iovcnt,
+    offset
+  );
+}
+
+/*
+ *  Nodes with released loans.  The network stack releases a loan with the
+ *  network semaphore held, so the release handler must not obtain the file
+ *  system lock.  It queues the node instead and the node references are
+ *  dropped later by IMFS_memfile_drop_released_loans(), see also
+ *  rtems_filesystem_global_location_release().
+ */
+static IMFS_jnode_t *memfile_released_loans;
+
+static void memfile_loan_release(
+  rtems_filesystem_loan *loan
+)
+{
+  IMFS_jnode_t *the_jnode = loan->arg;
+
+  _Thread_Disable_dispatch();
+
+  if ( the_jnode->info.file.released_loans == 0 ) {
+    the_jnode->info.file.released_next = memfile_released_loans;
+    memfile_released_loans = the_jnode;
+  }
+
+  ++the_jnode->info.file.released_loans;
+
+  _Thread_Enable_dispatch();
+}
+
+void IMFS_memfile_drop_released_loans( void )
+{
+  IMFS_jnode_t   *the_jnode;
+  unsigned short  count;
+
+  while ( memfile_released_loans != NULL ) {
+    _Thread_Disable_dispatch();
+
+    the_jnode = memfile_released_loans;
+    count = 0;
+
+    if ( the_jnode != NULL ) {
+      memfile_released_loans = the_jnode->info.file.released_next;
+      count = the_jnode->info.file.released_loans;
+      the_jnode->info.file.released_next = NULL;
+      the_jnode->info.file.released_loans = 0;
+    }
+
+    _Thread_Enable_dispatch();
+
+    if ( the_jnode != NULL ) {
+      the_jnode->reference_count -= count;
+
+      if ( the_jnode->reference_count == 0 )
+        IMFS_node_destroy( the_jnode );
+    }
+  }
+}
+
+ssize_t memfile_loan(
+  rtems_libio_t         *iop,
+  off_t                  offset,
+  size_t                 count,
+  rtems_filesystem_loan *loan
+)
+{
+  IMFS_jnode_t   *the_jnode;
+  unsigned char  *data;
+  size_t          my_length;
+
+  the_jnode = iop->pathinfo.node_access;
+
+  /*
+   *  The data of linear files is part of the tar image and is never freed.
+   */
+  if ( IMFS_type( the_jnode ) == IMFS_LINEAR_FILE ) {
+    if ( offset >= the_jnode->info.linearfile.size )
+      return 0;
+
+    my_length = the_jnode->info.linearfile.size - offset;
+    if ( my_length > count )
+      my_length = count;
+
+    loan->data = (const char *) the_jnode->info.linearfile.direct + offset;
+    loan->release = NULL;
+    loan->arg = NULL;
+
+    return (ssize_t) my_length;
+  }
+
+  if ( offset >= the_jnode->info.file.size )
+    return 0;
+
+  /*
+   *  The loan ends at the end of the block or extent.
+   */
+  data = IMFS_memfile_get_data( the_jnode, offset, &my_length );
+  if ( data == NULL )
+    rtems_set_errno_and_return_minus_one( ENOTSUP );
+
+  if ( my_length > the_jnode->info.file.size - offset )
+    my_length = the_jnode->info.file.size - offset;
+  if ( my_length > count )
+    my_length = count;
+
+  /*
+   *  Keep the node and its blocks until the loan is released, even if the
+   *  file is removed meanwhile.
+   */
+  rtems_filesystem_instance_lock( &iop->pathinfo );
+  IMFS_memfile_drop_released_loans();
+  ++the_jnode->reference_count;
+  rtems_filesystem_instance_unlock( &iop->pathinfo );
+
+  loan->data = (const char *) data;
+  loan->release = memfile_loan_release;
+  loan->arg = the_jnode;
+
+  return (ssize_t) my_length;
+}
+
 /*
  *  memfile_stat
  *
@@ -179,6 +457,138 @@ int memfile_ftruncate(
   return 0;
 }
 
+/*
+ *  IMFS_memfile_get_extent
+ *
+ *  This routine returns the extent number, start offset and size of the
+ *  extent for a file offset which is at least the extent size.
+ */
+static unsigned int IMFS_memfile_get_extent(
+   off_t   offset,
+   off_t  *extent_start,
+   off_t  *extent_size
+)
+{
+  off_t         n = offset / IMFS_MEMFILE_EXTENT_SIZE;
+  off_t         doubled = (off_t) 1 << IMFS_MEMFILE_EXTENT_DOUBLINGS;
+  unsigned int  extent = 0;
+
+  if ( n >= doubled ) {
+    n /= doubled;
+    *extent_size = doubled * IMFS_MEMFILE_EXTENT_SIZE;
+    *extent_start = n * *extent_size;
+
+    return (unsigned int) n - 1 + IMFS_MEMFILE_EXTENT_DOUBLINGS;
+  }
+
+  while ( n > 1 ) {
+    n >>= 1;
+    ++extent;
+  }
+
+  *extent_start = (off_t) IMFS_MEMFILE_EXTENT_SIZE << extent;
+  *extent_size = *extent_start;
+
+  return extent;
+}
+
+/*
+ *  IMFS_memfile_add_extent_slots
+ *
+ *  This routine enlarges the array of extent pointers so that it contains
+ *  the extent.  Only the array moves, the extents stay in place.
+ */
+static int IMFS_memfile_add_extent_slots(
+   IMFS_memfile_t *info,
+   unsigned int    extent
+)
+{
+  block_ptr     extents;
+  unsigned int  slots;
+
+  if ( extent < info->extent_slots )
+    return 0;
+
+  slots = 2 * info->extent_slots;
+  if ( slots <= extent )
+    slots = extent + 1;
+
+  extents = realloc( info->extents, slots * sizeof( block_p ) );
+  if ( !extents )
+    return 1;
+
+  memset(
+    &extents[ info->extent_slots ],
+    0,
+    ( slots - info->extent_slots ) * sizeof( block_p )
+  );
+
+  info->extents = extents;
+  info->extent_slots = slots;
+
+  return 0;
+}
+
+/*
+ *  IMFS_memfile_add_extents
+ *
+ *  This routine allocates the extents for the file data from the extent
+ *  size up to the new length.  Extents are not moved or freed until the
+ *  file is removed.
+ */
+static int IMFS_memfile_add_extents(
+   IMFS_jnode_t  *the_jnode,
+   bool           zero_fill,
+   off_t          new_length
+)
+{
+  IMFS_memfile_t *info;
+  off_t           offset;
+
+  info = &the_jnode->info.file;
+
+  offset = info->size;
+  if ( offset < IMFS_MEMFILE_EXTENT_SIZE )
+    offset = IMFS_MEMFILE_EXTENT_SIZE;
+
+  while ( offset < new_length ) {
+    unsigned int  extent;
+    off_t         extent_start;
+    off_t         extent_size;
+    off_t         extent_end;
+
+    extent = IMFS_memfile_get_extent( offset, &extent_start, &extent_size );
+    extent_end = extent_start + extent_size;
+
+    if ( IMFS_memfile_add_extent_slots( info, extent ) )
+      return 1;
+
+    if ( !info->extents[ extent ] ) {
+      info->extents[ extent ] = malloc( (size_t) extent_size );
+      if ( !info->extents[ extent ] )
+        return 1;
+    }
+
+    if ( extent_end > new_length )
+      extent_end = new_length;
+
+    /*
+     *  The extents are not cleared on allocation, so the zero fill covers
+     *  the complete new area.
+     */
+    if ( zero_fill )
+      memset(
+        &info->extents[ extent ][ offset - extent_start ],
+        0,
+        (size_t) ( extent_end - offset )
+      );
+
+    offset = extent_end;
+  }
+
+  return 0;
+}
+
 /*
  *  IMFS_memfile_extend
  *
@@ -196,6 +606,7 @@ MEMFILE_STATIC int IMFS_memfile_extend(
   unsigned int   new_blocks;
   unsigned int   old_blocks;
   unsigned int   offset;
+  off_t          block_length;
 
   /*
    *  Perform internal consistency checks
@@ -206,7 +617,10 @@ MEMFILE_STATIC int IMFS_memfile_extend(
   /*
    *  Verify new file size is supported
    */
-  if ( new_length >= IMFS_MEMFILE_MAXIMUM_SIZE )
+  if ( IMFS_MEMFILE_EXTENT_SIZE != 0 ) {
+    if ( new_length >= IMFS_MEMFILE_EXTENT_MAXIMUM_SIZE )
+      rtems_set_errno_and_return_minus_one( EFBIG );
+  } else if ( new_length >= IMFS_MEMFILE_MAXIMUM_SIZE )
     rtems_set_errno_and_return_minus_one( EFBIG );
 
   /*
@@ -216,16 +630,30 @@ MEMFILE_STATIC int IMFS_memfile_extend(
     return 0;
 
   /*
-   *  Calculate the number of range of blocks to allocate
+   *  The file data past the extent size is in extents.
+   */
+  block_length = new_length;
+  if ( IMFS_MEMFILE_EXTENT_SIZE != 0 && new_length > IMFS_MEMFILE_EXTENT_SIZE ) {
+    if ( IMFS_memfile_add_extents( the_jnode, zero_fill, new_length ) )
+      rtems_set_errno_and_return_minus_one( ENOSPC );
+
+    block_length = IMFS_MEMFILE_EXTENT_SIZE;
+  }
+
+  /*
+   *  Calculate the number of range of blocks to allocate.  The blocks up to
+   *  the new length are allocated, a block which starts at the new length
+   *  is not needed.
    */
-  new_blocks = new_length / IMFS_MEMFILE_BYTES_PER_BLOCK;
+  new_blocks = ( block_length + IMFS_MEMFILE_BYTES_PER_BLOCK - 1 )
+    / IMFS_MEMFILE_BYTES_PER_BLOCK;
   old_blocks = the_jnode->info.file.size / IMFS_MEMFILE_BYTES_PER_BLOCK;
   offset = the_jnode->info.file.size - old_blocks * IMFS_MEMFILE_BYTES_PER_BLOCK;
 
   /*
    *  Now allocate each of those blocks.
    */
-  for ( block=old_blocks ; block<=new_blocks ; block++ ) {
+  for ( block=old_blocks ; block<new_blocks ; block++ ) {
     if ( !IMFS_memfile_addblock( the_jnode, block ) ) {
        if ( zero_fill ) {
           size_t count = IMFS_MEMFILE_BYTES_PER_BLOCK - offset;
@@ -434,6 +862,15 @@ IMFS_jnode_t *IMFS_memfile_remove(
         (block_p **)&info->triply_indirect, to_free );
   }
 
+  if ( info->extents ) {
+    for ( i=0 ; i<info->extent_slots ; i++ ) {
+      free( info->extents[i] );
+    }
+    free( info->extents );
+    info->extents = 0;
+    info->extent_slots = 0;
+  }
+
   return the_jnode;
 }
 
@@ -455,13 +892,9 @@ MEMFILE_STATIC ssize_t IMFS_memfile_read(
    unsigned int     length
 )
 {
-  block_p             *block_ptr;
-  unsigned int         block;
   unsigned int         my_length;
-  unsigned int         to_copy = 0;
   unsigned int         last_byte;
   unsigned int         copied;
-  unsigned int         start_offset;
   unsigned char       *dest;
 
   dest = destination;
@@ -495,6 +928,13 @@ MEMFILE_STATIC ssize_t IMFS_memfile_read(
     return my_length;
   }
 
+  /*
+   *  There is nothing to read at or past the end of file.  The blocks and
+   *  extents past the end of file may contain stale data.
+   */
+  if ( start >= the_jnode->info.file.size )
+    return 0;
+
   /*
    *  If the last byte we are supposed to read is past the end of this
    *  in memory file, then shorten the length to read.
@@ -506,59 +946,23 @@ MEMFILE_STATIC ssize_t IMFS_memfile_read(
   copied = 0;
 
   /*
-   *  Three phases to the read:
-   *    + possibly the last part of one block
-   *    + all of zero of more blocks
-   *    + possibly the first part of one block
+   *  Copy the data up to the end of each block or extent at once.
    */
+  while ( my_length ) {
+    unsigned char *data;
+    size_t         to_copy;
 
-  /*
-   *  Phase 1: possibly the last part of one block
-   */
-  start_offset = start % IMFS_MEMFILE_BYTES_PER_BLOCK;
-  block = start / IMFS_MEMFILE_BYTES_PER_BLOCK;
-  if ( start_offset )  {
-    to_copy = IMFS_MEMFILE_BYTES_PER_BLOCK - start_offset;
+    data = IMFS_memfile_get_data( the_jnode, start + copied, &to_copy );
+    if ( !data )
+      return copied;
     if ( to_copy > my_length )
       to_copy = my_length;
-    block_ptr = IMFS_memfile_get_block_pointer( the_jnode, block, 0 );
-    if ( !block_ptr )
-      return copied;
-    memcpy( dest, &(*block_ptr)[ start_offset ], to_copy );
-    dest += to_copy;
-    block++;
-    my_length -= to_copy;
-    copied += to_copy;
-  }
-
-  /*
-   *  Phase 2: all of zero of more blocks
-   */
-  to_copy = IMFS_MEMFILE_BYTES_PER_BLOCK;
-  while ( my_length >= IMFS_MEMFILE_BYTES_PER_BLOCK ) {
-    block_ptr = IMFS_memfile_get_block_pointer( the_jnode, block, 0 );
-    if ( !block_ptr )
-      return copied;
-    memcpy( dest, &(*block_ptr)[ 0 ], to_copy );
+    memcpy( dest, data, to_copy );
     dest += to_copy;
-    block++;
     my_length -= to_copy;
     copied += to_copy;
   }
 
-  /*
-   *  Phase 3: possibly the first part of one block
-   */
-  IMFS_assert( my_length < IMFS_MEMFILE_BYTES_PER_BLOCK );
-
-  if ( my_length ) {
-    block_ptr = IMFS_memfile_get_block_pointer( the_jnode, block, 0 );
-    if ( !block_ptr )
-      return copied;
-    memcpy( dest, &(*block_ptr)[ 0 ], my_length );
-    copied += my_length;
-  }
-
   IMFS_update_atime( the_jnode );
 
   return copied;
@@ -577,13 +981,9 @@ MEMFILE_STATIC ssize_t IMFS_memfile_write(
    unsigned int           length
 )
 {
-  block_p             *block_ptr;
-  unsigned int         block;
   int                  status;
   unsigned int         my_length;
-  unsigned int         to_copy = 0;
   unsigned int         last_byte;
-  unsigned int         start_offset;
   int                  copied;
   const unsigned char *src;
 
@@ -614,82 +1014,72 @@ MEMFILE_STATIC ssize_t IMFS_memfile_write(
   copied = 0;
 
   /*
-   *  Three phases to the write:
-   *    + possibly the last part of one block
-   *    + all of zero of more blocks
-   *    + possibly the first part of one block
+   *  Copy the data up to the end of each block or extent at once.
    */
+  while ( my_length ) {
+    unsigned char *data;
+    size_t         to_copy;
 
-  /*
-   *  Phase 1: possibly the last part of one block
-   */
-  start_offset = start % IMFS_MEMFILE_BYTES_PER_BLOCK;
-  block = start / IMFS_MEMFILE_BYTES_PER_BLOCK;
-  if ( start_offset )  {
-    to_copy = IMFS_MEMFILE_BYTES_PER_BLOCK - start_offset;
+    data = IMFS_memfile_get_data( the_jnode, start + copied, &to_copy );
+    if ( !data )
+      return copied;
     if ( to_copy > my_length )
       to_copy = my_length;
-    block_ptr = IMFS_memfile_get_block_pointer( the_jnode, block, 0 );
-    if ( !block_ptr )
-      return copied;
-    #if 0
-      fprintf(
-        stderr,
-        "write %d at %d in %d: %*s\n",
-        to_copy,
-        start_offset,
-        block,
-        to_copy,
-        src
-      );
-    #endif
-    memcpy( &(*block_ptr)[ start_offset ], src, to_copy );
+    memcpy( data, src, to_copy );
     src += to_copy;
-    block++;
     my_length -= to_copy;
     copied += to_copy;
   }
 
-  /*
-   *  Phase 2: all of zero of more blocks
-   */
+  IMFS_mtime_ctime_update( the_jnode );
 
-  to_copy = IMFS_MEMFILE_BYTES_PER_BLOCK;
-  while ( my_length >= IMFS_MEMFILE_BYTES_PER_BLOCK ) {
-    block_ptr = IMFS_memfile_get_block_pointer( the_jnode, block, 0 );
-    if ( !block_ptr )
-      return copied;
-    #if 0
-      fprintf(stdout, "write %d in %d: %*s\n", to_copy, block, to_copy, src );
-    #endif
-    memcpy( &(*block_ptr)[ 0 ], src, to_copy );
-    src += to_copy;
-    block++;
-    my_length -= to_copy;
-    copied += to_copy;
-  }
+  return copied;
+}
 
-  /*
-   *  Phase 3: possibly the first part of one block
-   */
-  IMFS_assert( my_length < IMFS_MEMFILE_BYTES_PER_BLOCK );
+/*
+ *  IMFS_memfile_get_data
+ *
+ *  This routine returns a pointer to the file data at the offset.  The
+ *  number of contiguous bytes up to the end of the block or extent is
+ *  returned in count.  The data must have been allocated by
+ *  IMFS_memfile_extend(), otherwise NULL is returned.
+ */
+MEMFILE_STATIC unsigned char *IMFS_memfile_get_data(
+   IMFS_jnode_t   *the_jnode,
+   off_t           offset,
+   size_t         *count
+)
+{
+  block_p        *block_ptr;
+  unsigned int    start_offset;
 
-  to_copy = my_length;
-  if ( my_length ) {
-    block_ptr = IMFS_memfile_get_block_pointer( the_jnode, block, 0 );
-    if ( !block_ptr )
-      return copied;
-    #if 0
-    fprintf(stdout, "write %d in %d: %*s\n", to_copy, block, to_copy, src );
-    #endif
-    memcpy( &(*block_ptr)[ 0 ], src, my_length );
-    my_length = 0;
-    copied += to_copy;
+  if ( IMFS_MEMFILE_EXTENT_SIZE != 0 && offset >= IMFS_MEMFILE_EXTENT_SIZE ) {
+    block_ptr    extents = the_jnode->info.file.extents;
+    unsigned int extent;
+    off_t        extent_start;
+    off_t        extent_size;
+
+    extent = IMFS_memfile_get_extent( offset, &extent_start, &extent_size );
+    if ( extent >= the_jnode->info.file.extent_slots || !extents[ extent ] )
+      return 0;
+
+    *count = (size_t) ( extent_start + extent_size - offset );
+
+    return &extents[ extent ][ offset - extent_start ];
   }
 
-  IMFS_mtime_ctime_update( the_jnode );
+  block_ptr = IMFS_memfile_get_block_pointer(
+    the_jnode,
+    offset / IMFS_MEMFILE_BYTES_PER_BLOCK,
+    0
+  );
+  if ( !block_ptr || !*block_ptr )
+    return 0;
 
-  return copied;
+  start_offset = offset % IMFS_MEMFILE_BYTES_PER_BLOCK;
+  *count = IMFS_MEMFILE_BYTES_PER_BLOCK - start_offset;
+
+  return &(*block_ptr)[ start_offset ];
 }
 
 /*
@@ -2,6 +2,7 @@
 #define __LINUX_TYPES_H__
 
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <stdint.h>
 
 #define loff_t off_t
@@ -15,6 +15,7 @@
 #ifndef RTEMS_JFFS2_H
 #define RTEMS_JFFS2_H
 
+#include <rtems.h>
 #include <rtems/fs.h>
 #include <sys/param.h>
 #include <zlib.h>
@@ -40,6 +41,13 @@ typedef struct rtems_jffs2_flash_control rtems_jffs2_flash_control;
  * The application can optionally provide a compressor control structure to
  * enable data compression using the selected compression algorithm.
  *
+ * A summary of the nodes of an erase block is written to its end once the
+ * erase block is full.  The mount reads only this erase block summary (EBS)
+ * instead of scanning the complete erase block.  Erase blocks without a valid
+ * summary are scanned as before, so file systems written without summaries
+ * remain compatible.  The summary support is enabled by default and can be
+ * disabled with the --disable-jffs2-summary configure option.
+ *
  * The application must enable JFFS2 support with rtems_filesystem_register()
  * or CONFIGURE_FILESYSTEM_JFFS2 via <rtems/confdefs.h>.
  *
@@ -426,6 +434,47 @@ typedef struct {
    * The compressor is optional and this pointer may be @c NULL.
    */
   rtems_jffs2_compressor_control *compressor_control;
+
+  /**
+   * @brief Priority of the garbage collection task.
+   *
+   * In case this value is zero, then no garbage collection task is created
+   * and the garbage collection runs only on demand in the context of writers
+   * which need free space.  Otherwise, a garbage collection task is created
+   * for this file system instance.  It cleans dirty erase blocks and erases
+   * obsolete erase blocks in advance.  The priority should be lower than the
+   * priorities of the tasks using the file system, so that the garbage
+   * collection uses only idle time.  The application must account for this
+   * task in its task configuration.
+   */
+  rtems_task_priority gc_task_priority;
+
+  /**
+   * @brief Count of free erase blocks below which the garbage collection task
+   * starts to clean dirty erase blocks.
+   *
+   * In case this value is zero, then a default value is used which is
+   * derived from the count of erase blocks reserved for writes.
+   */
+  uint32_t gc_trigger_free_blocks;
+
+  /**
+   * @brief Count of very dirty erase blocks which triggers the garbage
+   * collection task.
+   *
+   * In case this value is zero, then a default value is used which is
+   * derived from the flash size.
+   */
+  uint32_t gc_trigger_very_dirty_blocks;
+
+  /**
+   * @brief Interval in clock ticks at which the garbage collection task
+   * checks the trigger conditions.
+   *
+   * In case this value is zero, then the garbage collection task runs only
+   * in case the file system notices that a garbage collection is due.
+   */
+  rtems_interval gc_task_interval;
 } rtems_jffs2_mount_data;
 
 /**
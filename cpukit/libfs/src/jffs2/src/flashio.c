@@ -122,6 +122,24 @@ jffs2_flash_direct_writev(struct jffs2_sb_info *c, const struct iovec *vecs,
 	return ret;
 }
 
+int
+jffs2_flash_writev(struct jffs2_sb_info *c, const struct iovec *vecs,
+		   unsigned long count, loff_t to, size_t * retlen,
+		   uint32_t sync)
+{
+	(void) sync;
+
+	if (jffs2_sum_active()) {
+		int res = jffs2_sum_add_kvec(c, vecs, count, (uint32_t) to);
+
+		if (res) {
+			return res;
+		}
+	}
+
+	return jffs2_flash_direct_writev(c, vecs, count, to, retlen);
+}
+
 int jffs2_flash_erase(struct jffs2_sb_info * c,
 			   struct jffs2_eraseblock * jeb)
 {
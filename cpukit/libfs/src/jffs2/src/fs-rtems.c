@@ -352,6 +352,151 @@ static void rtems_jffs2_compressor_control_destroy(rtems_jffs2_compressor_contro
 }
 
 
+#define RTEMS_JFFS2_GC_EVENT RTEMS_EVENT_0
+
+#define RTEMS_JFFS2_GC_STOP_EVENT RTEMS_EVENT_1
+
+static bool rtems_jffs2_gc_stop_requested(void)
+{
+	rtems_event_set events;
+
+	rtems_event_receive(
+		RTEMS_JFFS2_GC_STOP_EVENT,
+		RTEMS_EVENT_ALL | RTEMS_NO_WAIT,
+		RTEMS_NO_TIMEOUT,
+		&events
+	);
+
+	return events != 0;
+}
+
+static void rtems_jffs2_gc_task(rtems_task_argument arg)
+{
+	struct super_block *sb = (struct super_block *) arg;
+	struct jffs2_sb_info *c = JFFS2_SB_INFO(sb);
+	rtems_interval interval = sb->s_gc_interval;
+	bool stop = false;
+
+	if (interval == 0) {
+		interval = RTEMS_NO_TIMEOUT;
+	}
+
+	while (!stop) {
+		rtems_event_set events = 0;
+
+		rtems_event_receive(
+			RTEMS_JFFS2_GC_EVENT | RTEMS_JFFS2_GC_STOP_EVENT,
+			RTEMS_EVENT_ANY | RTEMS_WAIT,
+			interval,
+			&events
+		);
+
+		stop = (events & RTEMS_JFFS2_GC_STOP_EVENT) != 0;
+
+		/*
+		 * Do one pass at a time and release the file system lock in between,
+		 * so that tasks waiting for the file system can preempt us.
+		 */
+		while (!stop) {
+			bool wake;
+			int ret = 0;
+
+			rtems_jffs2_do_lock(sb);
+
+			wake = jffs2_thread_should_wake(c);
+			if (wake) {
+				ret = jffs2_garbage_collect_pass(c);
+			}
+
+			rtems_jffs2_do_unlock(sb);
+
+			stop = rtems_jffs2_gc_stop_requested();
+
+			if (!wake || ret != 0) {
+				break;
+			}
+		}
+	}
+
+	rtems_event_transient_send(sb->s_gc_stop_client);
+	rtems_task_delete(RTEMS_SELF);
+}
+
+static int rtems_jffs2_create_gc_task(
+	struct super_block *sb,
+	const rtems_jffs2_mount_data *jffs2_mount_data
+)
+{
+	rtems_status_code sc;
+
+	if (jffs2_mount_data->gc_task_priority == 0 || sb->s_is_readonly) {
+		return 0;
+	}
+
+	sc = rtems_task_create(
+		rtems_build_name('J', 'F', 'G', 'C'),
+		jffs2_mount_data->gc_task_priority,
+		4 * RTEMS_MINIMUM_STACK_SIZE,
+		RTEMS_DEFAULT_MODES,
+		RTEMS_DEFAULT_ATTRIBUTES,
+		&sb->s_gc_task
+	);
+	if (sc != RTEMS_SUCCESSFUL) {
+		sb->s_gc_task = 0;
+
+		return -ENOMEM;
+	}
+
+	sb->s_gc_interval = jffs2_mount_data->gc_task_interval;
+
+	return 0;
+}
+
+static void rtems_jffs2_start_gc_task(struct super_block *sb)
+{
+	if (sb->s_gc_task != 0) {
+		rtems_status_code sc = rtems_task_start(
+			sb->s_gc_task,
+			rtems_jffs2_gc_task,
+			(rtems_task_argument) sb
+		);
+		assert(sc == RTEMS_SUCCESSFUL);
+	}
+}
+
+static void rtems_jffs2_stop_gc_task(struct super_block *sb)
+{
+	if (sb->s_gc_task != 0) {
+		rtems_status_code sc;
+
+		sb->s_gc_stop_client = rtems_task_self();
+
+		sc = rtems_event_send(sb->s_gc_task, RTEMS_JFFS2_GC_STOP_EVENT);
+		assert(sc == RTEMS_SUCCESSFUL);
+
+		sc = rtems_event_transient_receive(RTEMS_WAIT, RTEMS_NO_TIMEOUT);
+		assert(sc == RTEMS_SUCCESSFUL);
+
+		sb->s_gc_task = 0;
+	}
+}
+
+static void rtems_jffs2_set_gc_trigger_levels(
+	struct jffs2_sb_info *c,
+	const rtems_jffs2_mount_data *jffs2_mount_data
+)
+{
+	if (jffs2_mount_data->gc_trigger_free_blocks != 0) {
+		c->resv_blocks_gctrigger = (uint8_t) min_t(uint32_t, UINT8_MAX,
+			jffs2_mount_data->gc_trigger_free_blocks);
+	}
+
+	if (jffs2_mount_data->gc_trigger_very_dirty_blocks != 0) {
+		c->vdirty_blocks_gctrigger = (uint8_t) min_t(uint32_t, UINT8_MAX,
+			jffs2_mount_data->gc_trigger_very_dirty_blocks);
+	}
+}
+
 static void rtems_jffs2_free_fs_info(rtems_jffs2_fs_info *fs_info, bool do_mount_fs_was_successful)
 {
 	struct super_block *sb = &fs_info->sb;
@@ -360,9 +505,15 @@ static void rtems_jffs2_free_fs_info(rtems_jffs2_fs_info *fs_info, bool do_mount
 	if (do_mount_fs_was_successful) {
 		jffs2_free_ino_caches(c);
 		jffs2_free_raw_node_refs(c);
+		jffs2_sum_exit(c);
 		free(c->blocks);
 	}
 
+	if (sb->s_gc_task != 0) {
+		rtems_status_code sc = rtems_task_delete(sb->s_gc_task);
+		assert(sc == RTEMS_SUCCESSFUL);
+	}
+
 	if (sb->s_mutex != 0) {
 		rtems_status_code sc = rtems_semaphore_delete(sb->s_mutex);
 		assert(sc == RTEMS_SUCCESSFUL);
@@ -520,34 +671,91 @@ static const rtems_filesystem_file_handlers_r rtems_jffs2_directory_handlers = {
 	.kqfilter_h = rtems_filesystem_default_kqfilter,
 	.poll_h = rtems_filesystem_default_poll,
 	.readv_h = rtems_filesystem_default_readv,
-	.writev_h = rtems_filesystem_default_writev
+	.writev_h = rtems_filesystem_default_writev,
+	.loan_h = rtems_filesystem_default_loan,
+	.preadv_h = rtems_filesystem_default_preadv,
+	.pwritev_h = rtems_filesystem_default_pwritev
 };
 
-static ssize_t rtems_jffs2_file_read(rtems_libio_t *iop, void *buf, size_t len)
+/* Must be called with the file system lock held */
+static int rtems_jffs2_read_at(struct _inode *inode, void *buf, size_t *len, off_t pos)
 {
-	struct _inode *inode = rtems_jffs2_get_inode_by_iop(iop);
 	struct jffs2_inode_info *f = JFFS2_INODE_INFO(inode);
 	struct jffs2_sb_info *c = JFFS2_SB_INFO(inode->i_sb);
-	int err = 0;
-	off_t pos;
+	uint32_t pos_32;
+	uint32_t max_available;
 
-	rtems_jffs2_do_lock(inode->i_sb);
+	if (pos >= inode->i_size) {
+		*len = 0;
 
-	pos = iop->offset;
+		return 0;
+	}
 
-	if (pos >= inode->i_size) {
-		len = 0;
-	} else {
-		uint32_t pos_32 = (uint32_t) pos;
-		uint32_t max_available = inode->i_size - pos_32;
+	pos_32 = (uint32_t) pos;
+	max_available = inode->i_size - pos_32;
+
+	if (*len > max_available) {
+		*len = max_available;
+	}
+
+	return jffs2_read_inode_range(c, f, buf, pos_32, *len);
+}
+
+/* Must be called with the file system lock held */
+static int rtems_jffs2_write_at(struct _inode *inode, const void *buf, size_t len, off_t pos, uint32_t *writtenlen)
+{
+	struct jffs2_inode_info *f = JFFS2_INODE_INFO(inode);
+	struct jffs2_sb_info *c = JFFS2_SB_INFO(inode->i_sb);
+	struct jffs2_raw_inode ri;
+	int eno = 0;
+
+	memset(&ri, 0, sizeof(ri));
+
+	ri.ino = cpu_to_je32(f->inocache->ino);
+	ri.mode = cpu_to_jemode(inode->i_mode);
+	ri.uid = cpu_to_je16(inode->i_uid);
+	ri.gid = cpu_to_je16(inode->i_gid);
+	ri.atime = ri.ctime = ri.mtime = cpu_to_je32(get_seconds());
+
+	*writtenlen = 0;
+
+	if (pos > inode->i_size) {
+		ri.version = cpu_to_je32(++f->highest_version);
+		eno = -jffs2_extend_file(inode, &ri, pos);
+	}
+
+	if (eno == 0) {
+		ri.isize = cpu_to_je32(inode->i_size);
+
+		eno = -jffs2_write_inode_range(c, f, &ri, (void *) buf, pos, len, writtenlen);
+	}
+
+	if (eno == 0) {
+		pos += *writtenlen;
+
+		inode->i_mtime = inode->i_ctime = je32_to_cpu(ri.mtime);
 
-		if (len > max_available) {
-			len = max_available;
+		if (pos > inode->i_size) {
+			inode->i_size = pos;
 		}
 
-		err = jffs2_read_inode_range(c, f, buf, pos_32, len);
+		if (*writtenlen != len) {
+			eno = ENOSPC;
+		}
 	}
 
+	return eno;
+}
+
+static ssize_t rtems_jffs2_file_read(rtems_libio_t *iop, void *buf, size_t len)
+{
+	struct _inode *inode = rtems_jffs2_get_inode_by_iop(iop);
+	int err;
+
+	rtems_jffs2_do_lock(inode->i_sb);
+
+	err = rtems_jffs2_read_at(inode, buf, &len, iop->offset);
+
 	if (err == 0) {
 		iop->offset += len;
 	}
@@ -566,20 +774,9 @@ static ssize_t rtems_jffs2_file_read(rtems_libio_t *iop, void *buf, size_t len)
 static ssize_t rtems_jffs2_file_write(rtems_libio_t *iop, const void *buf, size_t len)
 {
 	struct _inode *inode = rtems_jffs2_get_inode_by_iop(iop);
-	struct jffs2_inode_info *f = JFFS2_INODE_INFO(inode);
-	struct jffs2_sb_info *c = JFFS2_SB_INFO(inode->i_sb);
-	struct jffs2_raw_inode ri;
 	uint32_t writtenlen;
 	off_t pos;
-	int eno = 0;
-
-	memset(&ri, 0, sizeof(ri));
-
-	ri.ino = cpu_to_je32(f->inocache->ino);
-	ri.mode = cpu_to_jemode(inode->i_mode);
-	ri.uid = cpu_to_je16(inode->i_uid);
-	ri.gid = cpu_to_je16(inode->i_gid);
-	ri.atime = ri.ctime = ri.mtime = cpu_to_je32(get_seconds());
+	int eno;
 
 	rtems_jffs2_do_lock(inode->i_sb);
 
@@ -589,37 +786,92 @@ static ssize_t rtems_jffs2_file_write(rtems_libio_t *iop, const void *buf, size_
 		pos = inode->i_size;
 	}
 
-	if (pos > inode->i_size) {
-		ri.version = cpu_to_je32(++f->highest_version);
-		eno = -jffs2_extend_file(inode, &ri, pos);
+	eno = rtems_jffs2_write_at(inode, buf, len, pos, &writtenlen);
+
+	if (eno == 0) {
+		iop->offset = pos + writtenlen;
 	}
 
+	rtems_jffs2_do_unlock(inode->i_sb);
+
 	if (eno == 0) {
-		ri.isize = cpu_to_je32(inode->i_size);
+		return writtenlen;
+	} else {
+		errno = eno;
 
-		eno = -jffs2_write_inode_range(c, f, &ri, (void *) buf, pos, len, &writtenlen);
+		return -1;
 	}
+}
 
-	if (eno == 0) {
-		pos += writtenlen;
+static ssize_t rtems_jffs2_file_preadv(
+	rtems_libio_t *iop,
+	const struct iovec *iov,
+	int iovcnt,
+	off_t offset,
+	ssize_t total
+)
+{
+	struct _inode *inode = rtems_jffs2_get_inode_by_iop(iop);
+	ssize_t done = 0;
+	int err = 0;
+	int v;
 
-		inode->i_mtime = inode->i_ctime = je32_to_cpu(ri.mtime);
+	rtems_jffs2_do_lock(inode->i_sb);
 
-		if (pos > inode->i_size) {
-			inode->i_size = pos;
+	for (v = 0; err == 0 && v < iovcnt; ++v) {
+		size_t len = iov[v].iov_len;
+
+		err = rtems_jffs2_read_at(inode, iov[v].iov_base, &len, offset + done);
+		if (err == 0) {
+			done += (ssize_t) len;
+
+			if (len != iov[v].iov_len) {
+				break;
+			}
 		}
+	}
 
-		iop->offset = pos;
+	rtems_jffs2_do_unlock(inode->i_sb);
 
-		if (writtenlen != len) {
-			eno = ENOSPC;
+	if (err == 0) {
+		return done;
+	} else {
+		errno = -err;
+
+		return -1;
+	}
+}
+
+static ssize_t rtems_jffs2_file_pwritev(
+	rtems_libio_t *iop,
+	const struct iovec *iov,
+	int iovcnt,
+	off_t offset,
+	ssize_t total
+)
+{
+	struct _inode *inode = rtems_jffs2_get_inode_by_iop(iop);
+	ssize_t done = 0;
+	int eno = 0;
+	int v;
+
+	rtems_jffs2_do_lock(inode->i_sb);
+
+	for (v = 0; eno == 0 && v < iovcnt; ++v) {
+		uint32_t writtenlen;
+
+		if (iov[v].iov_len == 0) {
+			continue;
 		}
+
+		eno = rtems_jffs2_write_at(inode, iov[v].iov_base, iov[v].iov_len, offset + done, &writtenlen);
+		done += (ssize_t) writtenlen;
 	}
 
 	rtems_jffs2_do_unlock(inode->i_sb);
 
 	if (eno == 0) {
-		return writtenlen;
+		return done;
 	} else {
 		errno = eno;
 
@@ -662,7 +914,10 @@ static const rtems_filesystem_file_handlers_r rtems_jffs2_file_handlers = {
 	.kqfilter_h = rtems_filesystem_default_kqfilter,
 	.poll_h = rtems_filesystem_default_poll,
 	.readv_h = rtems_filesystem_default_readv,
-	.writev_h = rtems_filesystem_default_writev
+	.writev_h = rtems_filesystem_default_writev,
+	.loan_h = rtems_filesystem_default_loan,
+	.preadv_h = rtems_jffs2_file_preadv,
+	.pwritev_h = rtems_jffs2_file_pwritev
 };
 
 static const rtems_filesystem_file_handlers_r rtems_jffs2_link_handlers = {
@@ -680,7 +935,10 @@ static const rtems_filesystem_file_handlers_r rtems_jffs2_link_handlers = {
 	.kqfilter_h = rtems_filesystem_default_kqfilter,
 	.poll_h = rtems_filesystem_default_poll,
 	.readv_h = rtems_filesystem_default_readv,
-	.writev_h = rtems_filesystem_default_writev
+	.writev_h = rtems_filesystem_default_writev,
+	.loan_h = rtems_filesystem_default_loan,
+	.preadv_h = rtems_filesystem_default_preadv,
+	.pwritev_h = rtems_filesystem_default_pwritev
 };
 
 static void rtems_jffs2_set_location(rtems_filesystem_location_info_t *loc, struct _inode *inode)
@@ -993,6 +1251,8 @@ static void rtems_jffs2_fsunmount(rtems_filesystem_mount_table_entry_t *mt_entry
 	rtems_jffs2_fs_info *fs_info = mt_entry->fs_info;
 	struct _inode *root_i = mt_entry->mt_fs_root->location.node_access;
 
+	rtems_jffs2_stop_gc_task(&fs_info->sb);
+
 	icache_evict(root_i, NULL);
 	assert(root_i->i_cache_next == NULL);
 	assert(root_i->i_count == 1);
@@ -1210,6 +1470,11 @@ int rtems_jffs2_initialize(
 
 	if (err == 0) {
 		sb->s_is_readonly = !mt_entry->writeable;
+
+		err = rtems_jffs2_create_gc_task(sb, jffs2_mount_data);
+	}
+
+	if (err == 0) {
 		sb->s_flash_control = fc;
 		sb->s_compressor_control = jffs2_mount_data->compressor_control;
 
@@ -1225,6 +1490,8 @@ int rtems_jffs2_initialize(
 	if (err == 0) {
 		do_mount_fs_was_successful = true;
 
+		rtems_jffs2_set_gc_trigger_levels(c, jffs2_mount_data);
+
 		sb->s_root = jffs2_iget(sb, 1);
 		if (IS_ERR(sb->s_root)) {
 			err = PTR_ERR(sb->s_root);
@@ -1243,6 +1510,8 @@ int rtems_jffs2_initialize(
 		mt_entry->mt_fs_root->location.node_access = sb->s_root;
 		mt_entry->mt_fs_root->location.handlers = &rtems_jffs2_directory_handlers;
 
+		rtems_jffs2_start_gc_task(sb);
+
 		return 0;
 	} else {
 		if (fs_info != NULL) {
@@ -1266,6 +1535,15 @@ int rtems_jffs2_initialize(
 //
 //==========================================================================
 
+void jffs2_garbage_collect_trigger(struct jffs2_sb_info *c)
+{
+	struct super_block *sb = OFNI_BS_2SFFJ(c);
+
+	if (sb->s_gc_task != 0 && jffs2_thread_should_wake(c)) {
+		rtems_event_send(sb->s_gc_task, RTEMS_JFFS2_GC_EVENT);
+	}
+}
+
 unsigned char *jffs2_gc_fetch_page(struct jffs2_sb_info *c, 
 				   struct jffs2_inode_info *f, 
 				   unsigned long offset,
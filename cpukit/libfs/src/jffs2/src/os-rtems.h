@@ -105,6 +105,9 @@ struct super_block {
 	bool			s_is_readonly;
 	unsigned char		s_gc_buffer[PAGE_CACHE_SIZE]; // Avoids malloc when user may be under memory pressure
 	rtems_id		s_mutex;
+	rtems_id		s_gc_task;
+	rtems_id		s_gc_stop_client;
+	rtems_interval		s_gc_interval;
 	char			s_name_buf[JFFS2_MAX_NAME_LEN];
 };
 
@@ -118,10 +121,8 @@ static inline bool jffs2_is_readonly(struct jffs2_sb_info *c)
 	return sb->s_is_readonly;
 }
 
-static inline void jffs2_garbage_collect_trigger(struct jffs2_sb_info *c)
-{
-       /* We don't have a GC thread in RTEMS (yet) */
-}
+/* fs-rtems.c */
+void jffs2_garbage_collect_trigger(struct jffs2_sb_info *c);
 
 /* fs-rtems.c */
 struct _inode *jffs2_new_inode (struct _inode *dir_i, int mode, struct jffs2_raw_inode *ri);
@@ -153,6 +154,9 @@ int jffs2_flash_write(struct jffs2_sb_info *c, cyg_uint32 write_buffer_offset,
 			   const size_t size, size_t * return_size, unsigned char * read_buffer);
 int jffs2_flash_direct_writev(struct jffs2_sb_info *c, const struct iovec *vecs,
 			      unsigned long count, loff_t to, size_t *retlen);
+int jffs2_flash_writev(struct jffs2_sb_info *c, const struct iovec *vecs,
+		       unsigned long count, loff_t to, size_t *retlen,
+		       uint32_t sync);
 int jffs2_flash_erase(struct jffs2_sb_info *c, struct jffs2_eraseblock *jeb);
 
 // dir-rtems.c
@@ -183,7 +187,6 @@ static inline void jffs2_erase_pending_trigger(struct jffs2_sb_info *c)
 #define jffs2_flash_setup(c) (0)
 #define jffs2_nand_flash_cleanup(c) do {} while(0)
 #define jffs2_wbuf_dirty(c) (0)
-#define jffs2_flash_writev(a,b,c,d,e,f) jffs2_flash_direct_writev(a,b,c,d,e)
 #define jffs2_wbuf_timeout NULL
 #define jffs2_wbuf_process NULL
 #define jffs2_nor_ecc(c) (0)
@@ -172,7 +172,9 @@ nfsCleanup(void);
  * @brief Dump a list of the currently mounted NFS to a file.
  *
  * Dump a list of the currently mounted NFS to a file
- * (stdout is used in case f==NULL)
+ * (stdout is used in case f==NULL) together with the
+ * attribute cache timeouts and the hit rates of the
+ * attribute and name lookup caches of each NFS.
  */
 int
 nfsMountsShow(FILE *f);
@@ -181,6 +183,17 @@ nfsMountsShow(FILE *f);
  * @brief Filesystem mount table mount handler.
  *
  * Filesystem mount table mount handler. Do not call, use the mount call.
+ *
+ * The data argument of mount() may be NULL or a string of comma separated
+ * options controlling the attribute and name lookup caches (all values in
+ * seconds):
+ *  - acregmin=n, acregmax=n: lifetime of regular file attributes (3, 60),
+ *  - acdirmin=n, acdirmax=n: lifetime of directory attributes and name
+ *    lookups (30, 60),
+ *  - actimeo=n: set all of the above to n,
+ *  - noac: disable the caches,
+ *  - nocto: do not fetch the attributes of a regular file on open
+ *    (close-to-open consistency).
  */
 int
 rtems_nfs_initialize(rtems_filesystem_mount_table_entry_t *mt_entry,
@@ -217,6 +230,38 @@ nfsSetTimeout(uint32_t timeout_ms);
 uint32_t
 nfsGetTimeout(void);
 
+/**
+ * @brief Set the number of READ and WRITE calls (initial default: 4)
+ * kept in flight for a single read or write operation.
+ *
+ * Sequential reads smaller than the NFS transfer size are served from
+ * a per-file read-ahead buffer of 'window' transfers. A window of one
+ * restores the strictly synchronous behaviour.
+ *
+ * @retval 0 on success, nonzero if 'window' is zero or larger than 16.
+ */
+int
+nfsSetWindow(uint32_t window);
+
+/** Read current READ/WRITE window */
+uint32_t
+nfsGetWindow(void);
+
+/**
+ * @brief Set the limit (initial default: 128 KiB) of the memory the
+ * read-ahead buffers of all open files may use together.
+ *
+ * Files which would exceed the limit are read without read-ahead until
+ * other files release their buffers on close.  A limit of zero disables
+ * the read-ahead.
+ */
+void
+nfsSetReadAheadMax(uint32_t bytes);
+
+/** Read current read-ahead memory limit (in bytes) */
+uint32_t
+nfsGetReadAheadMax(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -97,11 +97,30 @@
 #define CONFIG_AVG_NAMLEN				10
 
 #define CONFIG_NFS_SMALL_XACT_SIZE		800			/* size of RPC arguments for non-write ops */
-/* lifetime of NFS attributes in a NfsNode;
- * the time is in seconds and the lifetime is
- * infinite if the symbol is #undef
+
+/* Default lifetime (in seconds) of the attributes
+ * cached in a NfsNode. The attributes of a regular
+ * file are kept for a tenth of the time since its
+ * last modification but at least 'acregmin' and
+ * at most 'acregmax' seconds; directories use
+ * 'acdirmin' and 'acdirmax'.
+ * Name lookups are cached for 'acdirmin' seconds.
+ * The values may be overridden for each mount by
+ * the options string passed to mount(), see
+ * nfsParseOptions().
+ */
+#define DEFAULT_NFS_ACREGMIN			3
+#define DEFAULT_NFS_ACREGMAX			60
+#define DEFAULT_NFS_ACDIRMIN			30
+#define DEFAULT_NFS_ACDIRMAX			60
+
+/* Number of entries of the name lookup cache of
+ * each mounted NFS and the maximal length of a
+ * cached name (including the terminating 0).
+ * Longer names are not cached.
  */
-#define CONFIG_ATTR_LIFETIME			10/*secs*/
+#define CONFIG_NFS_LOOKUP_CACHE_SIZE	64
+#define CONFIG_NFS_LOOKUP_CACHE_NAMLEN	32
 
 /*
  * The 'st_blksize' (stat(2)) value this nfs
@@ -119,6 +138,28 @@
  */
 #define DEFAULT_NFS_ST_BLKSIZE			NFS_MAXDATA
 
+/*
+ * The number of READ and WRITE calls this nfs client
+ * keeps in flight for a single read(2) or write(2).
+ * Sequential reads smaller than NFS_MAXDATA are served
+ * from a read-ahead buffer of this many NFS_MAXDATA
+ * chunks. A value of one disables the pipelining and
+ * the read-ahead.
+ * This value can be changed at run-time with
+ * nfsSetWindow().
+ */
+#define DEFAULT_NFS_WINDOW				4
+#define NFS_MAX_WINDOW					16
+
+/*
+ * Upper limit of the memory the read-ahead buffers
+ * of all open files may use together. Files which
+ * would exceed it are read without read-ahead.
+ * This value can be changed at run-time with
+ * nfsSetReadAheadMax().
+ */
+#define DEFAULT_NFS_READ_AHEAD_MAX		(4 * DEFAULT_NFS_WINDOW * NFS_MAXDATA)
+
 /* dont change this without changing the maximal write size */
 #define CONFIG_NFS_BIG_XACT_SIZE		UDPMSGSIZE	/* dont change this */
 
@@ -126,6 +167,9 @@
 #define NFSCALL_TIMEOUT					(&_nfscalltimeout)
 #define MNTCALL_TIMEOUT					(&_nfscalltimeout)
 static struct timeval _nfscalltimeout = { 10, 0 };	/* {secs, us } */
+static uint32_t       _nfswindow      = DEFAULT_NFS_WINDOW;
+static uint32_t       _nfsramax       = DEFAULT_NFS_READ_AHEAD_MAX;
+static uint32_t       _nfsraused      = 0;	/* protected by nfsGlob.llock */
 
 /* More or less fixed constants; in particular, NFS3 is not supported */
 #define DELIM							'/'
@@ -280,6 +324,20 @@ typedef struct DirInfoRec_ {
 	bool_t		eofreached;
 } DirInfoRec, *DirInfo;
 
+/* ReadAheadRec holds data read ahead of
+ * sequential, small reads of a regular file.
+ * It is attached to the pathinfo.node_access_2
+ * of the open file.
+ */
+typedef struct ReadAheadRec_ {
+	uint32_t	offset;	/* file offset of buf[0]           */
+	uint32_t	len;	/* number of valid bytes in buf    */
+	uint32_t	next;	/* offset following the last read  */
+	uint32_t	size;	/* allocated size of buf           */
+	uint32_t	age;	/* when buf was filled             */
+	char		*buf;
+} ReadAheadRec, *ReadAhead;
+
 /* this deals with one entry / record */
 static bool_t
 xdr_dir_info_entry(XDR *xdrs, DirInfo di)
@@ -506,6 +564,33 @@ nowSeconds(void)
 }
 
 
+/* Attribute cache timeouts (in seconds) */
+typedef struct NfsCacheParamsRec_ {
+	uint32_t	acregmin, acregmax;
+	uint32_t	acdirmin, acdirmax;
+	/* don't revalidate the attributes on open */
+	uint32_t	nocto;
+} NfsCacheParamsRec, *NfsCacheParams;
+
+/* An entry of the name lookup cache;
+ * it maps a directory file handle and a
+ * name to the file handle and the
+ * attributes returned by LOOKUP.
+ */
+typedef struct NfsLookupCacheEntryRec_ {
+	nfs_fh		dir;
+	nfs_fh		file;
+	fattr		attributes;
+	TimeStamp	age;
+	bool_t		valid;
+	/* next entry (index + 1, 0 terminates) with the
+	 * same hash of 'dir' and of 'file', respectively
+	 */
+	u_short		dirNext;
+	u_short		fileNext;
+	char		name[CONFIG_NFS_LOOKUP_CACHE_NAMLEN];
+} NfsLookupCacheEntryRec, *NfsLookupCacheEntry;
+
 /* Per mounted FS structure */
 typedef struct NfsRec_ {
 		/* the NFS server we're talking to.
@@ -540,6 +625,28 @@ typedef struct NfsRec_ {
 		/* Who we pretend we are
 		 */
 	u_long								 uid,gid;
+		/* Attribute cache timeouts
+		 */
+	NfsCacheParamsRec					 ac;
+		/* statistics; attribute cache hits
+		 * and misses (GETATTR calls).
+		 */
+	volatile unsigned long				 attrHits, attrMisses;
+		/* statistics; name lookup cache hits
+		 * and misses (LOOKUP calls).
+		 */
+	volatile unsigned long				 lookupHits, lookupMisses;
+		/* The name lookup cache; protected
+		 * by nfsGlob.lock
+		 */
+	NfsLookupCacheEntryRec				 lookupCache[CONFIG_NFS_LOOKUP_CACHE_SIZE];
+		/* Chains of the valid lookup cache
+		 * entries indexed by the hash of the
+		 * directory and of the file handle
+		 * (index + 1, 0 terminates).
+		 */
+	u_short								 lookupDirHead[CONFIG_NFS_LOOKUP_CACHE_SIZE];
+	u_short								 lookupFileHead[CONFIG_NFS_LOOKUP_CACHE_SIZE];
 } NfsRec, *Nfs;
 
 typedef struct NfsNodeRec_ {
@@ -818,6 +925,10 @@ Nfs rval = calloc(1,sizeof(*rval));
 
 	if (rval) {
 		rval->server     = server;
+		rval->ac.acregmin = DEFAULT_NFS_ACREGMIN;
+		rval->ac.acregmax = DEFAULT_NFS_ACREGMAX;
+		rval->ac.acdirmin = DEFAULT_NFS_ACDIRMIN;
+		rval->ac.acdirmax = DEFAULT_NFS_ACDIRMAX;
 		LOCK(nfsGlob.llock);
 			rval->next 		   = nfsGlob.mounted_fs;
 			nfsGlob.mounted_fs = rval;
@@ -1145,7 +1256,34 @@ int			refuse;
 	return 0;
 }
 
-/* NFS RPC wrapper.
+/* Map a RPC error status to errno and
+ * print the RPC error message to stderr.
+ */
+static void
+nfscallError(int proc, enum clnt_stat stat)
+{
+	fprintf(stderr,
+			"NFS (proc %i) - %s\n",
+			proc,
+			clnt_sperrno(stat));
+
+	switch (stat) {
+		/* TODO: this is probably not complete and/or fully accurate */
+		case RPC_CANTENCODEARGS : errno = EINVAL;	break;
+		case RPC_AUTHERROR  	: errno = EPERM;	break;
+
+		case RPC_CANTSEND		:
+		case RPC_CANTRECV		: /* hope they have errno set */
+		case RPC_SYSTEMERROR	: break;
+
+		default             	: errno = EIO;		break;
+	}
+
+	if (!errno)
+		errno = EIO;
+}
+
+/* Send a NFS RPC without waiting for the reply.
  *
  * ARGS:	srvr	the NFS server we want to call
  * 			proc	the NFSPROC_xx we want to invoke
@@ -1153,30 +1291,29 @@ int			refuse;
  * 			pargs   pointer to the argument object
  * 			xres	xdr routine to unwrap the results
  * 			pres	pointer to the result object
+ * 			pxact	the transaction is returned here
  *
  * RETURNS:	0 on success, -1 on error with errno set.
  *
- * NOTE:	the caller assumes that errno is set to
- *			a nonzero value if this routine returns
- *			an error (nonzero return value).
- *
- *			This routine prints RPC error messages to
- *			stderr.
+ * NOTE:	the arguments are encoded before this routine
+ *			returns; they may be modified afterwards.
+ *			The result object must stay valid until
+ *			nfscallRecv() returns.
+ *			A task may have several calls outstanding.
  */
-STATIC int
-nfscall(
+static int
+nfscallSend(
 	RpcUdpServer	srvr,
 	int				proc,
 	xdrproc_t		xargs,
 	void *			pargs,
 	xdrproc_t		xres,
-	void *			pres)
+	void *			pres,
+	RpcUdpXact		*pxact)
 {
 RpcUdpXact		xact;
 enum clnt_stat	stat;
 RpcUdpXactPool	pool;
-int				rval = -1;
-
 
 	switch (proc) {
 		case NFSPROC_SYMLINK:
@@ -1201,38 +1338,290 @@ int				rval = -1;
 								pres,
 								xargs,
 								pargs,
-								0)) ||
-	     RPC_SUCCESS != (stat=rpcUdpRcv(xact)) ) {
+								0)) ) {
+		nfscallError(proc, stat);
 
-		fprintf(stderr,
-				"NFS (proc %i) - %s\n",
-				proc,
-				clnt_sperrno(stat));
+		/* release the transaction back into the pool */
+		rpcUdpXactPoolPut(xact);
 
-		switch (stat) {
-			/* TODO: this is probably not complete and/or fully accurate */
-			case RPC_CANTENCODEARGS : errno = EINVAL;	break;
-			case RPC_AUTHERROR  	: errno = EPERM;	break;
+		return -1;
+	}
 
-			case RPC_CANTSEND		:
-			case RPC_CANTRECV		: /* hope they have errno set */
-			case RPC_SYSTEMERROR	: break;
+	*pxact = xact;
 
-			default             	: errno = EIO;		break;
-		}
-	} else {
-		rval = 0;
+	return 0;
+}
+
+/* Wait for the reply of a NFS RPC sent
+ * by nfscallSend().
+ *
+ * ARGS:	xact	the transaction returned by nfscallSend()
+ * 			proc	the NFSPROC_xx of this call
+ *
+ * RETURNS:	0 on success, -1 on error with errno set.
+ *
+ * NOTE:	the transaction is released in any case.
+ */
+static int
+nfscallRecv(RpcUdpXact xact, int proc)
+{
+enum clnt_stat	stat;
+int				rval = 0;
+
+	if ( RPC_SUCCESS != (stat=rpcUdpRcv(xact)) ) {
+		nfscallError(proc, stat);
+		rval = -1;
 	}
 
 	/* release the transaction back into the pool */
 	rpcUdpXactPoolPut(xact);
 
-	if (rval && !errno)
-		errno = EIO;
-
 	return rval;
 }
 
+/* NFS RPC wrapper.
+ *
+ * ARGS:	srvr	the NFS server we want to call
+ * 			proc	the NFSPROC_xx we want to invoke
+ * 			xargs   xdr routine to wrap the arguments
+ * 			pargs   pointer to the argument object
+ * 			xres	xdr routine to unwrap the results
+ * 			pres	pointer to the result object
+ *
+ * RETURNS:	0 on success, -1 on error with errno set.
+ *
+ * NOTE:	the caller assumes that errno is set to
+ *			a nonzero value if this routine returns
+ *			an error (nonzero return value).
+ *
+ *			This routine prints RPC error messages to
+ *			stderr.
+ */
+STATIC int
+nfscall(
+	RpcUdpServer	srvr,
+	int				proc,
+	xdrproc_t		xargs,
+	void *			pargs,
+	xdrproc_t		xres,
+	void *			pres)
+{
+RpcUdpXact		xact;
+
+	if ( nfscallSend(srvr, proc, xargs, pargs, xres, pres, &xact) )
+		return -1;
+
+	return nfscallRecv(xact, proc);
+}
+
+/* Compute the lifetime of the attributes cached
+ * in a node: files (and directories) which were
+ * modified recently are likely to change again
+ * soon and are hence checked more frequently.
+ *
+ * RETURNS:	lifetime in seconds
+ */
+static TimeStamp
+nfsAttrLifetime(NfsNode node)
+{
+NfsCacheParams	ac = &node->nfs->ac;
+TimeStamp		min, max, mtime, lifetime = 0;
+
+	if ( NFDIR == SERP_ATTR(node).type ) {
+		min = ac->acdirmin;
+		max = ac->acdirmax;
+	} else {
+		min = ac->acregmin;
+		max = ac->acregmax;
+	}
+
+	mtime = SERP_ATTR(node).mtime.seconds;
+
+	if ( node->age > mtime )
+		lifetime = (node->age - mtime) / 10;
+
+	if ( lifetime < min )
+		lifetime = min;
+	if ( lifetime > max )
+		lifetime = max;
+
+	return lifetime;
+}
+
+static unsigned
+nfsFhHash(const nfs_fh *fh)
+{
+const u_char	*p = (const u_char *)fh->data;
+unsigned		h  = 0;
+int				i;
+
+	for ( i = 0; i < NFS_FHSIZE; i++ )
+		h = h * 31 + p[i];
+
+	return h;
+}
+
+static unsigned
+nfsLookupCacheHash(const nfs_fh *dir, const char *name)
+{
+unsigned		h  = nfsFhHash(dir);
+
+	while ( *name )
+		h = h * 31 + (u_char)*name++;
+
+	return h % CONFIG_NFS_LOOKUP_CACHE_SIZE;
+}
+
+/* Drop entry 'ce' from the cache and
+ * unlink it from its hash chains.
+ * Must be called with nfsGlob.lock held.
+ */
+static void
+nfsLookupCacheDrop(Nfs nfs, NfsLookupCacheEntry ce)
+{
+u_short	me = ce - nfs->lookupCache + 1;
+u_short	*link;
+
+	if ( !ce->valid )
+		return;
+
+	link = &nfs->lookupDirHead[nfsFhHash(&ce->dir) % CONFIG_NFS_LOOKUP_CACHE_SIZE];
+	while ( *link != me )
+		link = &nfs->lookupCache[*link - 1].dirNext;
+	*link = ce->dirNext;
+
+	link = &nfs->lookupFileHead[nfsFhHash(&ce->file) % CONFIG_NFS_LOOKUP_CACHE_SIZE];
+	while ( *link != me )
+		link = &nfs->lookupCache[*link - 1].fileNext;
+	*link = ce->fileNext;
+
+	ce->valid = FALSE;
+}
+
+/* Look up 'name' in directory 'dir' in the
+ * name lookup cache; on a hit, the file handle
+ * and attributes are copied into 'entry'.
+ *
+ * RETURNS:	nonzero on a hit, zero otherwise.
+ */
+static int
+nfsLookupCacheGet(Nfs nfs, const nfs_fh *dir, const char *name, NfsNode entry)
+{
+NfsLookupCacheEntry	ce;
+int					hit = 0;
+
+	if ( 0 == nfs->ac.acdirmin
+	     || strlen(name) >= CONFIG_NFS_LOOKUP_CACHE_NAMLEN )
+		return 0;
+
+	ce = &nfs->lookupCache[nfsLookupCacheHash(dir, name)];
+
+	LOCK(nfsGlob.lock);
+		if ( ce->valid
+		     && nowSeconds() - ce->age < nfs->ac.acdirmin
+		     && 0 == memcmp(&ce->dir, dir, sizeof(*dir))
+		     && 0 == strcmp(ce->name, name) ) {
+			entry->serporid.status = NFS_OK;
+			SERP_FILE(entry)       = ce->file;
+			SERP_ATTR(entry)       = ce->attributes;
+			entry->age             = ce->age;
+			hit                    = 1;
+			nfs->lookupHits++;
+		} else {
+			nfs->lookupMisses++;
+		}
+	UNLOCK(nfsGlob.lock);
+
+	return hit;
+}
+
+/* Enter the result of a successful LOOKUP
+ * into the name lookup cache.
+ */
+static void
+nfsLookupCachePut(Nfs nfs, const nfs_fh *dir, const char *name, NfsNode entry)
+{
+NfsLookupCacheEntry	ce;
+u_short				me;
+u_short				*head;
+
+	if ( 0 == nfs->ac.acdirmin
+	     || strlen(name) >= CONFIG_NFS_LOOKUP_CACHE_NAMLEN )
+		return;
+
+	ce = &nfs->lookupCache[nfsLookupCacheHash(dir, name)];
+	me = ce - nfs->lookupCache + 1;
+
+	LOCK(nfsGlob.lock);
+		nfsLookupCacheDrop(nfs, ce);
+
+		ce->dir        = *dir;
+		ce->file       = SERP_FILE(entry);
+		ce->attributes = SERP_ATTR(entry);
+		ce->age        = entry->age;
+		ce->valid      = TRUE;
+		strcpy(ce->name, name);
+
+		head         = &nfs->lookupDirHead[nfsFhHash(dir) % CONFIG_NFS_LOOKUP_CACHE_SIZE];
+		ce->dirNext  = *head;
+		*head        = me;
+
+		head         = &nfs->lookupFileHead[nfsFhHash(&ce->file) % CONFIG_NFS_LOOKUP_CACHE_SIZE];
+		ce->fileNext = *head;
+		*head        = me;
+	UNLOCK(nfsGlob.lock);
+}
+
+/* Drop all name lookup cache entries of
+ * directory 'fh' and all entries referring
+ * to 'fh' after modifying it.
+ */
+static void
+nfsLookupCacheInvalidate(Nfs nfs, const nfs_fh *fh)
+{
+unsigned	h = nfsFhHash(fh) % CONFIG_NFS_LOOKUP_CACHE_SIZE;
+u_short		i, next;
+
+	LOCK(nfsGlob.lock);
+		for ( i = nfs->lookupDirHead[h]; i; i = next ) {
+			NfsLookupCacheEntry ce = &nfs->lookupCache[i - 1];
+
+			next = ce->dirNext;
+			if ( 0 == memcmp(&ce->dir, fh, sizeof(*fh)) )
+				nfsLookupCacheDrop(nfs, ce);
+		}
+		for ( i = nfs->lookupFileHead[h]; i; i = next ) {
+			NfsLookupCacheEntry ce = &nfs->lookupCache[i - 1];
+
+			next = ce->fileNext;
+			if ( 0 == memcmp(&ce->file, fh, sizeof(*fh)) )
+				nfsLookupCacheDrop(nfs, ce);
+		}
+	UNLOCK(nfsGlob.lock);
+}
+
+/* Store fresh attributes of file 'fh' in the
+ * name lookup cache entries referring to it.
+ */
+static void
+nfsLookupCacheUpdate(Nfs nfs, const nfs_fh *fh, const fattr *attributes, TimeStamp age)
+{
+unsigned	h = nfsFhHash(fh) % CONFIG_NFS_LOOKUP_CACHE_SIZE;
+u_short		i;
+
+	LOCK(nfsGlob.lock);
+		for ( i = nfs->lookupFileHead[h]; i; ) {
+			NfsLookupCacheEntry ce = &nfs->lookupCache[i - 1];
+
+			if ( 0 == memcmp(&ce->file, fh, sizeof(*fh)) ) {
+				ce->attributes = *attributes;
+				ce->age        = age;
+			}
+			i = ce->fileNext;
+		}
+	UNLOCK(nfsGlob.lock);
+}
+
 /* Check the 'age' of a node's stats
  * and read the attributes from the server
  * if necessary.
@@ -1250,11 +1639,20 @@ updateAttr(NfsNode node, int force)
 {
 	int rv = 0;
 
-	if (force
-#ifdef CONFIG_ATTR_LIFETIME
-		|| (nowSeconds() - node->age > CONFIG_ATTR_LIFETIME)
-#endif
-	) {
+	if (!force) {
+		rtems_interrupt_level flags;
+
+		force = nowSeconds() - node->age >= nfsAttrLifetime(node);
+
+		rtems_interrupt_disable(flags);
+		if (force)
+			node->nfs->attrMisses++;
+		else
+			node->nfs->attrHits++;
+		rtems_interrupt_enable(flags);
+	}
+
+	if (force) {
 		rv = nfscall(
 			node->nfs->server,
 			NFSPROC_GETATTR,
@@ -1443,6 +1841,10 @@ static int nfs_search_in_directory(
 	/* remember args / directory fh */
 	memcpy(&entry->args, &SERP_FILE(dir), sizeof(dir->args));
 
+	if (nfsLookupCacheGet(nfs, &SERP_FILE(dir), part, entry)) {
+		return 0;
+	}
+
 #if DEBUG & DEBUG_EVALPATH
 	fprintf(stderr,"Looking up '%s'\n",part);
 #endif
@@ -1455,9 +1857,10 @@ static int nfs_search_in_directory(
 	);
 
 	if (rv == 0 && entry->serporid.status == NFS_OK) {
-		int force_update = 1;
+		/* LOOKUP returns the attributes, too */
+		entry->age = nowSeconds();
 
-		rv = updateAttr(entry, force_update);
+		nfsLookupCachePut(nfs, &entry->args.dir, part, entry);
 	} else {
 		rv = -1;
 	}
@@ -1660,6 +2063,11 @@ char *dupname;
 		(xdrproc_t)xdr_nfsstat, &status
 	);
 
+	/* the link count of the target changed */
+	nfsLookupCacheInvalidate(tNode->nfs, &SERP_FILE(tNode));
+	tNode->age = 0;
+	pNode->age = 0;
+
 	if (rv == 0) {
 		rv = nfsEvaluateStatus(status);
 #if DEBUG & DEBUG_SYSCALLS
@@ -1708,6 +2116,10 @@ char			*name = NFSPROC_REMOVE == proc ?
 		(xdrproc_t)xdr_nfsstat, &status
 	);
 
+	nfsLookupCacheInvalidate(nfs, &node->args.dir);
+	nfsLookupCacheInvalidate(nfs, &SERP_FILE(node));
+	((NfsNode)parentloc->node_access)->age = 0;
+
 	if (rv == 0) {
 		rv = nfsEvaluateStatus(status);
 #if DEBUG & DEBUG_SYSCALLS
@@ -1780,6 +2192,87 @@ Nfs	nfs    = ((NfsNode)pathloc->node_access)->nfs;
  * rather than by recursion.
  */
 
+/* Parse the mount options string 'opts', a
+ * comma separated list of
+ *
+ *   acregmin=<secs>, acregmax=<secs>,
+ *   acdirmin=<secs>, acdirmax=<secs>,
+ *   actimeo=<secs> (sets all four timeouts),
+ *   noac (disables attribute and lookup caching)
+ *
+ * into 'ac'.
+ *
+ * RETURNS:	0 on success, -1 on error with errno set.
+ */
+static int
+nfsParseOptions(NfsCacheParams ac, const char *opts)
+{
+char			*buf, *opt, *val, *end, *save = 0;
+unsigned long	secs;
+int				rval = 0;
+
+	if ( !(buf = strdup(opts)) ) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	for ( opt = strtok_r(buf, ",", &save);
+		  opt && !rval;
+		  opt = strtok_r(0, ",", &save) ) {
+
+		if ( !strcmp(opt, "noac") ) {
+			ac->acregmin = ac->acregmax = 0;
+			ac->acdirmin = ac->acdirmax = 0;
+			continue;
+		}
+
+		if ( !strcmp(opt, "nocto") ) {
+			ac->nocto = 1;
+			continue;
+		}
+
+		if ( !(val = strchr(opt, '=')) ) {
+			rval = -1;
+			break;
+		}
+		*val++ = 0;
+
+		secs = strtoul(val, &end, 0);
+		if ( end == val || *end ) {
+			rval = -1;
+			break;
+		}
+
+		if ( !strcmp(opt, "acregmin") ) {
+			ac->acregmin = secs;
+		} else if ( !strcmp(opt, "acregmax") ) {
+			ac->acregmax = secs;
+		} else if ( !strcmp(opt, "acdirmin") ) {
+			ac->acdirmin = secs;
+		} else if ( !strcmp(opt, "acdirmax") ) {
+			ac->acdirmax = secs;
+		} else if ( !strcmp(opt, "actimeo") ) {
+			ac->acregmin = ac->acregmax = secs;
+			ac->acdirmin = ac->acdirmax = secs;
+		} else {
+			rval = -1;
+		}
+	}
+
+	free(buf);
+
+	if ( !rval
+	     && ( ac->acregmin > ac->acregmax || ac->acdirmin > ac->acdirmax ) )
+		rval = -1;
+
+	if ( rval ) {
+		fprintf(stderr, "NFS: invalid mount options '%s'\n", opts);
+		errno = EINVAL;
+	}
+
+	return rval;
+}
+
 int rtems_nfs_initialize(
   rtems_filesystem_mount_table_entry_t *mt_entry,
   const void                           *data
@@ -1798,6 +2291,10 @@ NfsNode				rootNode  = 0;
 RpcUdpServer		nfsServer = 0;
 int					e         = -1;
 char				*path     = mt_entry->dev;
+NfsCacheParamsRec	ac        = {
+	DEFAULT_NFS_ACREGMIN, DEFAULT_NFS_ACREGMAX,
+	DEFAULT_NFS_ACDIRMIN, DEFAULT_NFS_ACDIRMAX
+};
 
   if (rpcUdpInit () < 0) {
     fprintf (stderr, "error: initialising RPC\n");
@@ -1813,6 +2310,9 @@ char				*path     = mt_entry->dev;
 	printf("Trying to mount %s on %s\n",path,mntpoint);
 #endif
 
+	if ( data && nfsParseOptions(&ac, data) )
+		return -1;
+
 	if ( buildIpAddr(&uid, &gid, &host, &saddr, &path) )
 		return -1;
 
@@ -1890,6 +2390,7 @@ char				*path     = mt_entry->dev;
 
 	nfs->uid  = uid;
 	nfs->gid  = gid;
+	nfs->ac   = ac;
 
 	/* that seemed to work - we now create the root node
 	 * and we also must obtain the root node attributes
@@ -2070,6 +2571,9 @@ char					*dupname;
 		(xdrproc_t)xdr_diropres, &res
 	);
 
+	nfsLookupCacheInvalidate(nfs, &SERP_FILE(node));
+	node->age = 0;
+
 	if (rv == 0) {
 		rv = nfsEvaluateStatus(res.status);
 #if DEBUG & DEBUG_SYSCALLS
@@ -2166,6 +2670,9 @@ char					*dupname;
 		(xdrproc_t)xdr_nfsstat, &status
 	);
 
+	nfsLookupCacheInvalidate(nfs, &SERP_FILE(node));
+	node->age = 0;
+
 	if (rv == 0) {
 		rv = nfsEvaluateStatus(status);
 #if DEBUG & DEBUG_SYSCALLS
@@ -2257,6 +2764,12 @@ static int nfs_rename(
 			&status
 		);
 
+		nfsLookupCacheInvalidate(nfs, &SERP_FILE(oldParentNode));
+		nfsLookupCacheInvalidate(nfs, &SERP_FILE(newParentNode));
+		nfsLookupCacheInvalidate(nfs, &SERP_FILE(oldNode));
+		oldParentNode->age = 0;
+		newParentNode->age = 0;
+
 		if (rv == 0) {
 			rv = nfsEvaluateStatus(status);
 		}
@@ -2357,7 +2870,11 @@ const struct _rtems_filesystem_operations_table nfs_fs_ops = {
 		  'nfs_xxx'.
  *****************************************/
 
-/* stateless NFS protocol makes this trivial */
+/* stateless NFS protocol makes this almost trivial;
+ * the attributes are fetched from the server unless
+ * the 'nocto' option is given and the read-ahead
+ * buffer is allocated by the first read.
+ */
 static int nfs_file_open(
 	rtems_libio_t *iop,
 	const char    *pathname,
@@ -2365,6 +2882,20 @@ static int nfs_file_open(
 	mode_t        mode
 )
 {
+NfsNode node = iop->pathinfo.node_access;
+Nfs		nfs  = node->nfs;
+
+	iop->pathinfo.node_access_2 = 0;
+
+	/* close-to-open consistency: see changes
+	 * made by other clients before their close()
+	 */
+	if ( !nfs->ac.nocto ) {
+		if ( updateAttr(node, 1 /* force */) )
+			return -1;
+		nfsLookupCacheUpdate(nfs, &SERP_FILE(node), &SERP_ATTR(node), node->age);
+	}
+
 	return 0;
 }
 
@@ -2409,10 +2940,61 @@ DirInfo		di;
 	return 0;
 }
 
+/* (Re-)allocate the read-ahead buffer with 'size' bytes
+ * within the global read-ahead limit; a size of zero
+ * releases the buffer.
+ *
+ * RETURNS:	0 on success, -1 if the limit would be
+ *			exceeded or no memory is available; the
+ *			buffer is released in this case.
+ */
+static int nfs_file_read_ahead_resize(
+	ReadAhead ra,
+	uint32_t size
+)
+{
+int ok;
+
+	LOCK(nfsGlob.llock);
+		_nfsraused -= ra->size;
+		ok = _nfsraused + size <= _nfsramax;
+		if ( ok )
+			_nfsraused += size;
+	UNLOCK(nfsGlob.llock);
+
+	free(ra->buf);
+	ra->buf  = 0;
+	ra->len  = 0;
+	ra->size = 0;
+
+	if ( !ok || size == 0 )
+		return ok ? 0 : -1;
+
+	ra->buf = malloc(size);
+
+	if ( !ra->buf ) {
+		LOCK(nfsGlob.llock);
+			_nfsraused -= size;
+		UNLOCK(nfsGlob.llock);
+		return -1;
+	}
+
+	ra->size = size;
+
+	return 0;
+}
+
 static int nfs_file_close(
 	rtems_libio_t *iop
 )
 {
+ReadAhead ra = iop->pathinfo.node_access_2;
+
+	if ( ra ) {
+		nfs_file_read_ahead_resize(ra, 0);
+		free(ra);
+		iop->pathinfo.node_access_2 = 0;
+	}
 	return 0;
 }
 
@@ -2425,50 +3007,104 @@ static int nfs_dir_close(
 	return 0;
 }
 
-static ssize_t nfs_file_read_chunk(
+/* Read 'count' bytes starting at 'offset' into 'buffer'
+ * keeping up to nfsGetWindow() READ calls in flight.
+ *
+ * RETURNS:	the number of bytes read (less than 'count'
+ *			only if the end of file was reached) or -1
+ *			with errno set.
+ */
+static ssize_t nfs_file_read_window(
 	NfsNode node,
 	uint32_t offset,
-	void *buffer,
+	char *buffer,
 	size_t count
 )
 {
-ssize_t rv;
-readres	rr;
-Nfs		nfs  = node->nfs;
+Nfs			nfs    = node->nfs;
+uint32_t	window = _nfswindow;
+RpcUdpXact	xact[NFS_MAX_WINDOW];
+readres		rr[NFS_MAX_WINDOW];
+size_t		asked[NFS_MAX_WINDOW];
+unsigned	head = 0, tail = 0;
+size_t		sent = 0;
+ssize_t		rv   = 0;
+int			eof  = 0;
+int			err  = 0;
 
-	SERP_ARGS(node).readarg.offset		= offset;
-	SERP_ARGS(node).readarg.count	  	= count;
-	SERP_ARGS(node).readarg.totalcount	= UINT32_C(0xdeadbeef);
+	do {
+		/* fill the window */
+		while ( !eof && !err && sent < count && head - tail < window ) {
+			unsigned	i     = head % NFS_MAX_WINDOW;
+			size_t		chunk = count - sent;
+
+			if ( chunk > NFS_MAXDATA )
+				chunk = NFS_MAXDATA;
+
+			SERP_ARGS(node).readarg.offset		= offset + sent;
+			SERP_ARGS(node).readarg.count		= chunk;
+			SERP_ARGS(node).readarg.totalcount	= UINT32_C(0xdeadbeef);
+
+			rr[i].readres_u.reply.data.data_val	= buffer + sent;
+			asked[i]							= chunk;
+
+			if ( nfscallSend(
+					nfs->server,
+					NFSPROC_READ,
+					(xdrproc_t)xdr_readargs, &SERP_FILE(node),
+					(xdrproc_t)xdr_readres, &rr[i],
+					&xact[i]) ) {
+				err = errno;
+				break;
+			}
 
-	rr.readres_u.reply.data.data_val	= buffer;
+			sent += chunk;
+			head++;
+		}
 
-	rv = nfscall(
-		nfs->server,
-		NFSPROC_READ,
-		(xdrproc_t)xdr_readargs, &SERP_FILE(node),
-		(xdrproc_t)xdr_readres, &rr
-	);
+		/* collect the replies in order */
+		if ( tail != head ) {
+			unsigned	i = tail % NFS_MAX_WINDOW;
 
-	if (rv == 0) {
-		rv = nfsEvaluateStatus(rr.status);
+			tail++;
 
-		if (rv == 0) {
-			rv = rr.readres_u.reply.data.data_len;
+			if ( nfscallRecv(xact[i], NFSPROC_READ)
+			     || nfsEvaluateStatus(rr[i].status) ) {
+				if ( !err )
+					err = errno;
+			} else if ( !eof && !err ) {
+				size_t len = rr[i].readres_u.reply.data.data_len;
 
 #if DEBUG & DEBUG_SYSCALLS
-			fprintf(stderr,
-				"Read %i (asked for %i) bytes from offset %i to 0x%08x\n",
-				rr.readres_u.reply.data.data_len,
-				count,
-				iop->offset,
-				rr.readres_u.reply.data.data_val);
+				fprintf(stderr,
+					"Read %i (asked for %i) bytes from offset %i to 0x%08x\n",
+					len,
+					asked[i],
+					offset + rv,
+					rr[i].readres_u.reply.data.data_val);
 #endif
+
+				rv += len;
+
+				/* a short read means end of file */
+				if ( len < asked[i] )
+					eof = 1;
+			}
 		}
+	} while ( tail != head );
+
+	if ( err ) {
+		errno = err;
+		return -1;
 	}
 
 	return rv;
 }
 
+/* Serve a read from the read-ahead buffer, if possible,
+ * and refill the buffer for small sequential reads.
+ * Large reads bypass the buffer.
+ */
 static ssize_t nfs_file_read(
 	rtems_libio_t *iop,
 	void *buffer,
@@ -2477,33 +3113,102 @@ static ssize_t nfs_file_read(
 {
 	ssize_t rv = 0;
 	NfsNode node = iop->pathinfo.node_access;
+	ReadAhead ra = iop->pathinfo.node_access_2;
+	uint32_t window = _nfswindow;
 	uint32_t offset = iop->offset;
 	char *in = buffer;
+	int sequential = (offset == 0);
 
-	do {
-		size_t chunk = count <= NFS_MAXDATA ? count : NFS_MAXDATA;
-		ssize_t done = nfs_file_read_chunk(node, offset, in, chunk);
+	if ( ra ) {
+		/* don't hold on to stale data */
+		if ( nowSeconds() - ra->age >= node->nfs->ac.acregmin )
+			ra->len = 0;
 
-		if (done > 0) {
-			offset += (uint32_t) done;
-			in += done;
-			count -= (size_t) done;
-			rv += done;
+		if ( offset == ra->next )
+			sequential = 1;
+
+		if ( offset >= ra->offset && offset - ra->offset < ra->len ) {
+			size_t avail = ra->len - (offset - ra->offset);
+			size_t n     = count < avail ? count : avail;
+
+			memcpy(in, ra->buf + (offset - ra->offset), n);
+			offset += n;
+			in     += n;
+			count  -= n;
+			rv     += n;
+
+			sequential = 1;
+		}
+	}
+
+	if ( count > 0 ) {
+		ssize_t done;
+
+		if ( window > 1 && count < NFS_MAXDATA && !ra ) {
+			ra = calloc(1, sizeof(*ra));
+			iop->pathinfo.node_access_2 = ra;
+		}
+
+		if ( window > 1 && count < NFS_MAXDATA && ra && sequential ) {
+			uint32_t size = window * NFS_MAXDATA;
+
+			if ( ra->size != size )
+				nfs_file_read_ahead_resize(ra, size);
+
+			if ( ra->buf ) {
+				done = nfs_file_read_window(node, offset, ra->buf, size);
+
+				if ( done >= 0 ) {
+					ra->offset = offset;
+					ra->len    = done;
+					ra->age    = nowSeconds();
+
+					if ( (size_t) done > count )
+						done = count;
+
+					memcpy(in, ra->buf, done);
+				} else {
+					ra->len    = 0;
+				}
+			} else {
+				done = nfs_file_read_window(node, offset, in, count);
+			}
 		} else {
-			count = 0;
-			if (done < 0) {
+			done = nfs_file_read_window(node, offset, in, count);
+		}
+
+		if ( done < 0 ) {
+			/* report what was served from the buffer, if anything */
+			if ( rv == 0 )
 				rv = -1;
-			}
+		} else {
+			offset += (uint32_t) done;
+			rv     += done;
 		}
-	} while (count > 0);
+	}
 
-	if (rv > 0) {
+	if ( rv > 0 ) {
 		iop->offset = offset;
 	}
 
+	if ( ra ) {
+		ra->next = offset;
+	}
+
 	return rv;
 }
 
+/* Drop read-ahead data after modifying the file */
+static void nfs_file_read_ahead_invalidate(
+	rtems_libio_t *iop
+)
+{
+ReadAhead ra = iop->pathinfo.node_access_2;
+
+	if ( ra )
+		ra->len = 0;
+}
+
 /* this is called by readdir() / getdents() */
 static ssize_t nfs_dir_read(
 	rtems_libio_t *iop,
@@ -2565,6 +3270,107 @@ RpcUdpServer	server = ((Nfs)iop->pathinfo.mt_entry->fs_info)->server;
 	return rv;
 }
 
+/* Write 'count' bytes from 'buffer' starting at 'offset'
+ * keeping up to nfsGetWindow() WRITE calls in flight.
+ * The attributes returned by the last successful
+ * call are stored in the node.
+ *
+ * RETURNS:	the number of bytes written or -1 with
+ *			errno set if nothing could be written.
+ */
+static ssize_t nfs_file_write_window(
+	NfsNode node,
+	uint32_t offset,
+	const char *buffer,
+	size_t count
+)
+{
+Nfs			nfs    = node->nfs;
+uint32_t	window = _nfswindow;
+RpcUdpXact	xact[NFS_MAX_WINDOW];
+attrstat	as[NFS_MAX_WINDOW];
+size_t		asked[NFS_MAX_WINDOW];
+unsigned	head = 0, tail = 0;
+size_t		sent = 0;
+ssize_t		rv   = 0;
+int			err  = 0;
+int			last = -1;
+
+	do {
+		/* fill the window */
+		while ( !err && sent < count && head - tail < window ) {
+			unsigned	i     = head % NFS_MAX_WINDOW;
+			size_t		chunk = count - sent;
+
+			if ( chunk > NFS_MAXDATA )
+				chunk = NFS_MAXDATA;
+
+			SERP_ARGS(node).writearg.beginoffset   = UINT32_C(0xdeadbeef);
+			SERP_ARGS(node).writearg.offset	  	   = offset + sent;
+			SERP_ARGS(node).writearg.totalcount	   = UINT32_C(0xdeadbeef);
+			SERP_ARGS(node).writearg.data.data_len = chunk;
+			SERP_ARGS(node).writearg.data.data_val = (void*)(buffer + sent);
+
+			asked[i] = chunk;
+
+			/* write XDR buffer size will be chosen by nfscallSend
+			 * based on the PROC specifier
+			 */
+			if ( nfscallSend(
+					nfs->server,
+					NFSPROC_WRITE,
+					(xdrproc_t)xdr_writeargs, &SERP_FILE(node),
+					(xdrproc_t)xdr_attrstat, &as[i],
+					&xact[i]) ) {
+				err = errno;
+				break;
+			}
+
+			sent += chunk;
+			head++;
+		}
+
+		/* collect the replies in order */
+		if ( tail != head ) {
+			unsigned	i = tail % NFS_MAX_WINDOW;
+
+			tail++;
+
+			if ( nfscallRecv(xact[i], NFSPROC_WRITE)
+			     || nfsEvaluateStatus(as[i].status) ) {
+				if ( !err )
+					err = errno;
+			} else if ( !err ) {
+				rv  += asked[i];
+				last = i;
+			}
+		}
+	} while ( tail != head );
+
+	if ( last >= 0 ) {
+		node->serporid.status = NFS_OK;
+		SERP_ATTR(node)       = as[last].attrstat_u.attributes;
+		node->age             = nowSeconds();
+
+		/* refresh rather than drop the lookup cache entries */
+		nfsLookupCacheUpdate(nfs, &SERP_FILE(node), &SERP_ATTR(node), node->age);
+	}
+
+	if ( err ) {
+		nfsLookupCacheInvalidate(nfs, &SERP_FILE(node));
+
+		/* try at least to recover the current attributes */
+		updateAttr(node, 1 /* force */);
+
+		if ( rv == 0 ) {
+			errno = err;
+			return -1;
+		}
+	}
+
+	return rv;
+}
+
 static ssize_t nfs_file_write(
 	rtems_libio_t *iop,
 	const void    *buffer,
@@ -2573,48 +3379,23 @@ static ssize_t nfs_file_write(
 {
 ssize_t rv;
 NfsNode 	node = iop->pathinfo.node_access;
-Nfs			nfs  = node->nfs;
-
-	if (count > NFS_MAXDATA)
-		count = NFS_MAXDATA;
+uint32_t	offset;
 
+	nfs_file_read_ahead_invalidate(iop);
 
-	SERP_ARGS(node).writearg.beginoffset   = UINT32_C(0xdeadbeef);
 	if ( LIBIO_FLAGS_APPEND & iop->flags ) {
 		if ( updateAttr(node, 0) ) {
 			return -1;
 		}
-		SERP_ARGS(node).writearg.offset	  	   = SERP_ATTR(node).size;
+		offset = SERP_ATTR(node).size;
 	} else {
-		SERP_ARGS(node).writearg.offset	  	   = iop->offset;
+		offset = iop->offset;
 	}
-	SERP_ARGS(node).writearg.totalcount	   = UINT32_C(0xdeadbeef);
-	SERP_ARGS(node).writearg.data.data_len = count;
-	SERP_ARGS(node).writearg.data.data_val = (void*)buffer;
 
-	/* write XDR buffer size will be chosen by nfscall based
-	 * on the PROC specifier
-	 */
+	rv = nfs_file_write_window(node, offset, buffer, count);
 
-	rv = nfscall(
-		nfs->server,
-		NFSPROC_WRITE,
-		(xdrproc_t)xdr_writeargs, &SERP_FILE(node),
-		(xdrproc_t)xdr_attrstat, &node->serporid
-	);
-
-	if (rv == 0) {
-		rv = nfsEvaluateStatus(node->serporid.status);
-
-		if (rv == 0) {
-			node->age = nowSeconds();
-
-			iop->offset += count;
-			rv = count;
-		} else {
-			/* try at least to recover the current attributes */
-			updateAttr(node, 1 /* force */);
-		}
+	if ( rv > 0 ) {
+		iop->offset += rv;
 	}
 
 	return rv;
@@ -2805,6 +3586,8 @@ u_int					mode;
 
 	node->serporid.status = NFS_OK;
 
+	nfsLookupCacheInvalidate(node->nfs, &SERP_FILE(node));
+
 	rv = nfscall(
 		node->nfs->server,
 		NFSPROC_SETATTR,
@@ -2846,6 +3629,8 @@ static int nfs_file_ftruncate(
 {
 sattr					arg;
 
+	nfs_file_read_ahead_invalidate(iop);
+
 	arg.size = length;
 	/* must not modify any other attribute; if we are not the owner
 	 * of the file or directory but only have write access changing
@@ -2873,7 +3658,10 @@ struct _rtems_filesystem_file_handlers_r nfs_file_file_handlers = {
 	.kqfilter_h  = rtems_filesystem_default_kqfilter,
 	.poll_h      = rtems_filesystem_default_poll,
 	.readv_h     = rtems_filesystem_default_readv,
-	.writev_h    = rtems_filesystem_default_writev
+	.writev_h    = rtems_filesystem_default_writev,
+	.loan_h      = rtems_filesystem_default_loan,
+	.preadv_h    = rtems_filesystem_default_preadv,
+	.pwritev_h   = rtems_filesystem_default_pwritev
 };
 
 /* the directory handlers table */
@@ -2893,7 +3681,10 @@ struct _rtems_filesystem_file_handlers_r nfs_dir_file_handlers = {
 	.kqfilter_h  = rtems_filesystem_default_kqfilter,
 	.poll_h      = rtems_filesystem_default_poll,
 	.readv_h     = rtems_filesystem_default_readv,
-	.writev_h    = rtems_filesystem_default_writev
+	.writev_h    = rtems_filesystem_default_writev,
+	.loan_h      = rtems_filesystem_default_loan,
+	.preadv_h    = rtems_filesystem_default_preadv,
+	.pwritev_h   = rtems_filesystem_default_pwritev
 };
 
 /* the link handlers table */
@@ -2913,7 +3704,10 @@ struct _rtems_filesystem_file_handlers_r nfs_link_file_handlers = {
 	.kqfilter_h  = rtems_filesystem_default_kqfilter,
 	.poll_h      = rtems_filesystem_default_poll,
 	.readv_h     = rtems_filesystem_default_readv,
-	.writev_h    = rtems_filesystem_default_writev
+	.writev_h    = rtems_filesystem_default_writev,
+	.loan_h      = rtems_filesystem_default_loan,
+	.preadv_h    = rtems_filesystem_default_preadv,
+	.pwritev_h   = rtems_filesystem_default_pwritev
 };
 
 /* we need a dummy driver entry table to get a
@@ -2951,6 +3745,14 @@ static rtems_driver_address_table	drvNfs = {
 		0					/* control */
 };
 
+static unsigned long
+nfsHitRate(unsigned long hits, unsigned long misses)
+{
+	unsigned long long total = (unsigned long long)hits + misses;
+
+	return total ? (unsigned long)((100ULL * hits) / total) : 0;
+}
+
 /* Dump a list of the currently mounted NFS to a  file */
 int
 nfsMountsShow(FILE *f)
@@ -2976,6 +3778,19 @@ Nfs		nfs;
 			fprintf(f,"<UNABLE TO LOOKUP MOUNTPOINT>\n");
 		else
 			fprintf(f,"%s\n",mntpt);
+		fprintf(f,"  acregmin=%lu,acregmax=%lu,acdirmin=%lu,acdirmax=%lu\n",
+				(unsigned long)nfs->ac.acregmin,
+				(unsigned long)nfs->ac.acregmax,
+				(unsigned long)nfs->ac.acdirmin,
+				(unsigned long)nfs->ac.acdirmax);
+		fprintf(f,"  attribute cache: %lu hits, %lu misses (%lu%% hit rate)\n",
+				nfs->attrHits,
+				nfs->attrMisses,
+				nfsHitRate(nfs->attrHits, nfs->attrMisses));
+		fprintf(f,"  lookup cache:    %lu hits, %lu misses (%lu%% hit rate)\n",
+				nfs->lookupHits,
+				nfs->lookupMisses,
+				nfsHitRate(nfs->lookupHits, nfs->lookupMisses));
 	}
 
 	UNLOCK(nfsGlob.llock);
@@ -3225,3 +4040,34 @@ uint32_t              s,us;
 	rtems_interrupt_enable(k);
 	return s*1000 + us/1000;
 }
+
+int
+nfsSetWindow(uint32_t window)
+{
+	if ( window < 1 || window > NFS_MAX_WINDOW ) {
+		/* out of range */
+		return -1;
+	}
+
+	_nfswindow = window;
+
+	return 0;
+}
+
+uint32_t
+nfsGetWindow( void )
+{
+	return _nfswindow;
+}
+
+void
+nfsSetReadAheadMax(uint32_t bytes)
+{
+	_nfsramax = bytes;
+}
+
+uint32_t
+nfsGetReadAheadMax( void )
+{
+	return _nfsramax;
+}
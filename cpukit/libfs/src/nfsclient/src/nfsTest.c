@@ -48,6 +48,14 @@
  *    pipeline 'reader' and 'cruncher' threads.
  *  - read is not completely asynchronous; synchronization is still
  *    performed at 'big block' boundaries (num_readers * chunk_size).
+ *
+ * int
+ * nfsTestWindow(char *file_name, int size, int chunk_size, int max_window);
+ *
+ * writes and reads back 'file_name' for each window size 1..'max_window'
+ * (see nfsSetWindow()) and prints the throughput. The NFS client itself
+ * keeps up to 'window' READ/WRITE calls in flight which achieves what
+ * nfsTestRead() does with multiple threads.
  */
 
 
@@ -106,9 +114,13 @@
 #include <rtems.h>
 #include <rtems/error.h>
 
+#include <librtemsNfs.h>
+
 #include <fcntl.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#include <unistd.h>
 
 unsigned nfsTestReaderPri = 80;
 
@@ -384,3 +396,95 @@ cleanup:
 	free(buf);
 	return now;
 }
+
+/* Measure the effect of the NFS client's READ/WRITE
+ * window (see nfsSetWindow()).
+ *
+ * For each window size 1..'maxw' file 'fnam' is written
+ * with 'sz' bytes (in chunks of 'chunk' bytes) and then
+ * read back in chunks of 'chunk' bytes. The throughput
+ * is printed to stdout. Small chunks exercise the
+ * read-ahead buffer, chunks bigger than 8k exercise the
+ * pipelining of a single read/write call.
+ *
+ * The original window is restored when done.
+ *
+ * RETURNS: 0 on success, -1 on error.
+ */
+int
+nfsTestWindow(char *fnam, int sz, int chunk, int maxw)
+{
+int               w,i,n,rval = -1;
+uint32_t          orig = nfsGetWindow();
+rtems_interval    then, tickspsec;
+unsigned long     wms, rms;
+int		          fd=-1;
+char	          *buf=0;
+
+	if ( sz <= 0 || chunk <= 0 || maxw <= 0 ) {
+		fprintf(stderr,"Usage: nfsTestWindow(file_name, size, chunk, max_window)\n");
+		return -1;
+	}
+
+	if ( ! (buf=malloc(chunk)) ) {
+		perror("allocating buffer");
+		return -1;
+	}
+	memset(buf, 0xa5, chunk);
+
+	tickspsec = rtems_clock_get_ticks_per_second();
+
+	for ( w=1; w<=maxw; w++ ) {
+		if ( nfsSetWindow(w) ) {
+			fprintf(stderr,"Invalid window %i\n", w);
+			goto cleanup;
+		}
+
+		then = rtems_clock_get_ticks_since_boot();
+
+		if ( (fd=open(fnam,O_CREAT|O_TRUNC|O_WRONLY,0644)) < 0 ) {
+			perror("opening file for writing");
+			goto cleanup;
+		}
+		for ( i=0; i<sz; i+=n ) {
+			n = sz - i > chunk ? chunk : sz - i;
+			if ( (n = write(fd, buf, n)) <= 0 ) {
+				perror("writing");
+				goto cleanup;
+			}
+		}
+		close(fd); fd = -1;
+
+		wms = (rtems_clock_get_ticks_since_boot() - then)*1000/tickspsec;
+
+		then = rtems_clock_get_ticks_since_boot();
+
+		if ( (fd=open(fnam,O_RDONLY)) < 0 ) {
+			perror("opening file for reading");
+			goto cleanup;
+		}
+		while ( (n = read(fd, buf, chunk)) > 0 )
+			/* nothing else to do */;
+		if ( n < 0 ) {
+			perror("reading");
+			goto cleanup;
+		}
+		close(fd); fd = -1;
+
+		rms = (rtems_clock_get_ticks_since_boot() - then)*1000/tickspsec;
+
+		printf("window %2i: write %6lu KiB/s, read %6lu KiB/s\n",
+			w,
+			wms ? (unsigned long)sz/wms*1000/1024 : 0,
+			rms ? (unsigned long)sz/rms*1000/1024 : 0);
+	}
+
+	rval = 0;
+
+cleanup:
+	if ( fd >= 0 )
+		close(fd);
+	nfsSetWindow(orig);
+	free(buf);
+	return rval;
+}
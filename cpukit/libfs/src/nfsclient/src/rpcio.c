@@ -328,6 +328,7 @@ typedef struct RpcUdpXactRec_ {
 		long				age;		/* age info; needed to manage retransmission    */
 		long				trip;		/* record round trip time in ticks              */
 		rtems_id			requestor;	/* the task waiting for this XACT to complete   */
+		volatile int		done;		/* set by the daemon when this XACT completed   */
 		RpcUdpXactPool		pool;		/* if this XACT belong to a pool, this is it    */
 		XDR					xdrs;		/* argument encoder stream                      */
 		int					xdrpos;     /* stream position after the (permanent) header */
@@ -819,6 +820,7 @@ va_list			ap;
 	va_end(ap);
 
 	rtems_task_ident(RTEMS_SELF, RTEMS_WHO_AM_I, &xact->requestor);
+	xact->done = 0;
 	if ( rtems_message_queue_send( msgQ, &xact, sizeof(xact)) ) {
 		return RPC_CANTSEND;
 	}
@@ -846,13 +848,18 @@ rtems_event_set		gotEvents;
 
 	do {
 
-	/* block for the reply */
-	status = rtems_event_receive(
-		RTEMS_RPC_EVENT,
-		RTEMS_WAIT | RTEMS_EVENT_ANY,
-		RTEMS_NO_TIMEOUT,
-		&gotEvents);
-	ASSERT( status == RTEMS_SUCCESSFUL );
+	/* block for the reply; a task may have several
+	 * transactions outstanding, so the event might
+	 * have been sent on behalf of another one.
+	 */
+	while ( !xact->done ) {
+		status = rtems_event_receive(
+			RTEMS_RPC_EVENT,
+			RTEMS_WAIT | RTEMS_EVENT_ANY,
+			RTEMS_NO_TIMEOUT,
+			&gotEvents);
+		ASSERT( status == RTEMS_SUCCESSFUL );
+	}
 
 	if (xact->status.re_status) {
 #ifdef MBUF_RX
@@ -908,6 +915,7 @@ rtems_event_set		gotEvents;
 
 	if (refresh && locked_refresh(xact->server)) {
 		rtems_task_ident(RTEMS_SELF, RTEMS_WHO_AM_I, &xact->requestor);
+		xact->done = 0;
 		if ( rtems_message_queue_send(msgQ, &xact, sizeof(xact)) ) {
 			return RPC_CANTSEND;
 		}
@@ -1278,6 +1286,7 @@ rtems_status_code	status;
 				}
 
 				/* wakeup requestor */
+				xact->done = 1;
 				rtems_event_send(xact->requestor, RTEMS_RPC_EVENT);
 			}
 		}
@@ -1333,6 +1342,7 @@ rtems_status_code	status;
 #if (DEBUG) & DEBUG_TIMEOUT
 					fprintf(stderr,"RPCIO XACT timed out; waking up requestor\n");
 #endif
+					xact->done = 1;
 					if ( rtems_event_send(xact->requestor, RTEMS_RPC_EVENT) ) {
 						rtems_panic("RPCIO PANIC file %s line: %i, requestor id was 0x%08x",
 									__FILE__,
@@ -1367,6 +1377,7 @@ rtems_status_code	status;
 
 						/* wakeup requestor */
 						fprintf(stderr,"RPCIO: SEND failure\n");
+						xact->done = 1;
 						status = rtems_event_send(xact->requestor, RTEMS_RPC_EVENT);
 						assert( status == RTEMS_SUCCESSFUL );
 
@@ -159,6 +159,10 @@ rpcUdpSend(
 
 /**
  * @brief Wait for a transaction to complete.
+ *
+ * A task may send several transactions before it waits
+ * for their completion.  The transactions may be waited
+ * for in any order.
  */
 enum clnt_stat
 rpcUdpRcv(RpcUdpXact xact);
@@ -18,6 +18,8 @@
 #include "config.h"
 #endif
 
+#define _WANT_KNOTE
+
 #include <errno.h>
 #include <stdlib.h>
 #include <string.h>
@@ -43,6 +45,20 @@ static rtems_id pipe_semaphore = RTEMS_ID_NONE;
 #define PIPE_SPACE(_pipe) (_pipe->Size - _pipe->Length)
 #define PIPE_WSTART(_pipe) ((_pipe->Start + _pipe->Length) % _pipe->Size)
 
+/*
+ * A blocking writer of more than the buffer size waits until this fill level
+ * is reached, so that reader and writer do not wake each other up for every
+ * few bytes.
+ */
+#define PIPE_WRITE_LOWAT(_pipe) (_pipe->Size / 2)
+
+/*
+ * Transfers of at least this size are copied without the pipe lock.  The
+ * reader owns the occupied and the writer owns the free part of the buffer,
+ * so that the lock is only needed to update the buffer indices.
+ */
+#define PIPE_UNLOCKED_COPY_MIN 256
+
 #define PIPE_LOCK(_pipe)  \
   ( rtems_semaphore_obtain(_pipe->Semaphore, RTEMS_WAIT, RTEMS_NO_TIMEOUT)  \
    == RTEMS_SUCCESSFUL )
@@ -63,6 +79,14 @@ static rtems_id pipe_semaphore = RTEMS_ID_NONE;
 #define PIPE_WAKEUPWRITERS(_pipe) \
   do {uint32_t n; rtems_barrier_release(_pipe->writeBarrier, &n); } while(0)
 
+#define PIPE_NOTEREADERS(_pipe) \
+  do { if (!KNLIST_EMPTY(&_pipe->readNote)) \
+    KNOTE_UNLOCKED(&_pipe->readNote, 0); } while(0)
+
+#define PIPE_NOTEWRITERS(_pipe) \
+  do { if (!KNLIST_EMPTY(&_pipe->writeNote)) \
+    KNOTE_UNLOCKED(&_pipe->writeNote, 0); } while(0)
+
 
 #ifdef RTEMS_POSIX_API
 #include <rtems/rtems/barrier.h>
@@ -275,11 +299,23 @@ void pipe_release(
     pipe_free(pipe);
     *pipep = NULL;
   }
-  else if (pipe->Readers == 0 && mode != LIBIO_FLAGS_WRITE)
-    /* Notify waiting Writers that all their partners left */
-    PIPE_WAKEUPWRITERS(pipe);
-  else if (pipe->Writers == 0 && mode != LIBIO_FLAGS_READ)
-    PIPE_WAKEUPREADERS(pipe);
+  else {
+    /* Abort the operations blocked on the closed file descriptor */
+    if (mode & LIBIO_FLAGS_READ)
+      PIPE_WAKEUPREADERS(pipe);
+    if (mode & LIBIO_FLAGS_WRITE)
+      PIPE_WAKEUPWRITERS(pipe);
+
+    if (pipe->Readers == 0 && mode != LIBIO_FLAGS_WRITE) {
+      /* Notify waiting Writers that all their partners left */
+      PIPE_WAKEUPWRITERS(pipe);
+      PIPE_NOTEWRITERS(pipe);
+    }
+    else if (pipe->Writers == 0 && mode != LIBIO_FLAGS_READ) {
+      PIPE_WAKEUPREADERS(pipe);
+      PIPE_NOTEREADERS(pipe);
+    }
+  }
 
   pipe_unlock();
 
@@ -378,6 +414,51 @@ out_error:
   return err;
 }
 
+/* Copy chunk bytes starting at buffer offset start to the user buffer. */
+static void pipe_copy_out(
+  const pipe_control_t *pipe,
+  unsigned int          start,
+  char                 *buffer,
+  unsigned int          chunk
+)
+{
+  unsigned int chunk1 = pipe->Size - start;
+
+  if (chunk > chunk1) {
+    memcpy(buffer, pipe->Buffer + start, chunk1);
+    memcpy(buffer + chunk1, pipe->Buffer, chunk - chunk1);
+  }
+  else
+    memcpy(buffer, pipe->Buffer + start, chunk);
+}
+
+/* Copy chunk bytes from the user buffer to buffer offset start. */
+static void pipe_copy_in(
+  pipe_control_t *pipe,
+  unsigned int    start,
+  const char     *buffer,
+  unsigned int    chunk
+)
+{
+  unsigned int chunk1 = pipe->Size - start;
+
+  if (chunk > chunk1) {
+    memcpy(pipe->Buffer + start, buffer, chunk1);
+    memcpy(pipe->Buffer, buffer + chunk1, chunk - chunk1);
+  }
+  else
+    memcpy(pipe->Buffer + start, buffer, chunk);
+}
+
+/* Wake up the waiting writers once the space they wait for is available. */
+static void pipe_wakeup_writers(
+  pipe_control_t *pipe
+)
+{
+  if (pipe->waitingWriters > 0 && PIPE_SPACE(pipe) >= pipe->writeWanted)
+    PIPE_WAKEUPWRITERS(pipe);
+}
+
 ssize_t pipe_read(
   pipe_control_t *pipe,
   void           *buffer,
@@ -385,14 +466,16 @@ ssize_t pipe_read(
   rtems_libio_t  *iop
 )
 {
-  int chunk, chunk1, read = 0, ret = 0;
+  int chunk, read = 0, ret = 0;
+  unsigned int start;
 
   if (! PIPE_LOCK(pipe))
     return -EINTR;
 
-  while (PIPE_EMPTY(pipe)) {
+  /* Wait for data and for another reader which copies without the lock */
+  while (PIPE_EMPTY(pipe) || pipe->readBusy) {
     /* Not an error */
-    if (pipe->Writers == 0)
+    if (PIPE_EMPTY(pipe) && pipe->Writers == 0)
       goto out_locked;
 
     if (LIBIO_NODELAY(iop)) {
@@ -413,27 +496,44 @@ ssize_t pipe_read(
     pipe->waitingReaders --;
     if (ret != 0)
       goto out_locked;
+
+    /* The file descriptor was closed meanwhile */
+    if (! (iop->flags & LIBIO_FLAGS_OPEN)) {
+      ret = -EBADF;
+      goto out_locked;
+    }
   }
 
   /* Read chunk bytes */
   chunk = MIN(count - read,  pipe->Length);
-  chunk1 = pipe->Size - pipe->Start;
-  if (chunk > chunk1) {
-    memcpy(buffer + read, pipe->Buffer + pipe->Start, chunk1);
-    memcpy(buffer + read + chunk1, pipe->Buffer, chunk - chunk1);
+  start = pipe->Start;
+  if (chunk >= PIPE_UNLOCKED_COPY_MIN) {
+    pipe->readBusy = true;
+    PIPE_UNLOCK(pipe);
+    pipe_copy_out(pipe, start, (char *) buffer + read, chunk);
+    if (! PIPE_LOCK(pipe)) {
+      /* The chunk stays in the pipe, let the other readers take it */
+      pipe->readBusy = false;
+      PIPE_WAKEUPREADERS(pipe);
+      ret = -EINTR;
+      goto out_nolock;
+    }
+    pipe->readBusy = false;
+    if (pipe->waitingReaders > 0)
+      PIPE_WAKEUPREADERS(pipe);
   }
   else
-    memcpy(buffer + read, pipe->Buffer + pipe->Start, chunk);
+    pipe_copy_out(pipe, start, (char *) buffer + read, chunk);
 
   pipe->Start += chunk;
   pipe->Start %= pipe->Size;
   pipe->Length -= chunk;
   /* For buffering optimization */
-  if (PIPE_EMPTY(pipe))
+  if (PIPE_EMPTY(pipe) && ! pipe->writeBusy)
     pipe->Start = 0;
 
-  if (pipe->waitingWriters > 0)
-    PIPE_WAKEUPWRITERS(pipe);
+  pipe_wakeup_writers(pipe);
+  PIPE_NOTEWRITERS(pipe);
   read += chunk;
 
 out_locked:
@@ -452,7 +552,8 @@ ssize_t pipe_write(
   rtems_libio_t  *iop
 )
 {
-  int chunk, chunk1, written = 0, ret = 0;
+  int chunk, written = 0, ret = 0;
+  unsigned int start;
 
   /* Write nothing */
   if (count == 0)
@@ -466,17 +567,25 @@ ssize_t pipe_write(
     goto out_locked;
   }
 
-  /* Write of PIPE_BUF bytes or less shall not be interleaved */
-  chunk = count <= pipe->Size ? count : 1;
-
   while (written < count) {
-    while (PIPE_SPACE(pipe) < chunk) {
+    /* Write of PIPE_BUF bytes or less shall not be interleaved */
+    if (written == 0 && count <= pipe->Size)
+      chunk = count;
+    else if (LIBIO_NODELAY(iop))
+      chunk = 1;
+    else
+      chunk = MIN(count - written, PIPE_WRITE_LOWAT(pipe));
+
+    /* Wait for space and for another writer which copies without the lock */
+    if (PIPE_SPACE(pipe) < chunk || pipe->writeBusy) {
       if (LIBIO_NODELAY(iop)) {
         ret = -EAGAIN;
         goto out_locked;
       }
 
       /* Wait until there is chunk bytes space or no reader exists */
+      if (pipe->waitingWriters == 0 || chunk < pipe->writeWanted)
+        pipe->writeWanted = chunk;
       pipe->waitingWriters ++;
       PIPE_UNLOCK(pipe);
       if (! PIPE_WRITEWAIT(pipe))
@@ -490,27 +599,46 @@ ssize_t pipe_write(
       if (ret != 0)
         goto out_locked;
 
+      /* The file descriptor was closed meanwhile */
+      if (! (iop->flags & LIBIO_FLAGS_OPEN)) {
+        ret = -EBADF;
+        goto out_locked;
+      }
+
       if (pipe->Readers == 0) {
         ret = -EPIPE;
         goto out_locked;
       }
+
+      /* The buffer size may have changed meanwhile */
+      continue;
     }
 
     chunk = MIN(count - written, PIPE_SPACE(pipe));
-    chunk1 = pipe->Size - PIPE_WSTART(pipe);
-    if (chunk > chunk1) {
-      memcpy(pipe->Buffer + PIPE_WSTART(pipe), buffer + written, chunk1);
-      memcpy(pipe->Buffer, buffer + written + chunk1, chunk - chunk1);
+    start = PIPE_WSTART(pipe);
+    if (chunk >= PIPE_UNLOCKED_COPY_MIN) {
+      pipe->writeBusy = true;
+      PIPE_UNLOCK(pipe);
+      pipe_copy_in(pipe, start, (const char *) buffer + written, chunk);
+      if (! PIPE_LOCK(pipe)) {
+        /* The chunk is not added to the pipe, let the other writers go on */
+        pipe->writeBusy = false;
+        PIPE_WAKEUPWRITERS(pipe);
+        ret = -EINTR;
+        goto out_nolock;
+      }
+      pipe->writeBusy = false;
+      if (pipe->waitingWriters > 0)
+        PIPE_WAKEUPWRITERS(pipe);
     }
     else
-      memcpy(pipe->Buffer + PIPE_WSTART(pipe), buffer + written, chunk);
+      pipe_copy_in(pipe, start, (const char *) buffer + written, chunk);
 
     pipe->Length += chunk;
     if (pipe->waitingReaders > 0)
       PIPE_WAKEUPREADERS(pipe);
+    PIPE_NOTEREADERS(pipe);
     written += chunk;
-    /* Write of more than PIPE_BUF bytes can be interleaved */
-    chunk = 1;
   }
 
 out_locked:
@@ -528,6 +656,36 @@ out_nolock:
   return ret;
 }
 
+/* Called with the pipe locked. */
+static int pipe_set_size(
+  pipe_control_t *pipe,
+  int             size
+)
+{
+  char *buffer;
+
+  if (size < PIPE_BUF || size > PIPE_MAX_SIZE)
+    return -EINVAL;
+
+  if (pipe->readBusy || pipe->writeBusy || (unsigned int) size < pipe->Length)
+    return -EBUSY;
+
+  buffer = malloc(size);
+  if (buffer == NULL)
+    return -ENOMEM;
+
+  pipe_copy_out(pipe, pipe->Start, buffer, pipe->Length);
+  free(pipe->Buffer);
+  pipe->Buffer = buffer;
+  pipe->Size = size;
+  pipe->Start = 0;
+
+  if (pipe->waitingWriters > 0)
+    PIPE_WAKEUPWRITERS(pipe);
+  PIPE_NOTEWRITERS(pipe);
+  return 0;
+}
+
 int pipe_ioctl(
   pipe_control_t  *pipe,
   ioctl_command_t  cmd,
@@ -535,6 +693,8 @@ int pipe_ioctl(
   rtems_libio_t   *iop
 )
 {
+  int err = 0;
+
   if (cmd == FIONREAD) {
     if (buffer == NULL)
       return -EFAULT;
@@ -548,5 +708,106 @@ int pipe_ioctl(
     return 0;
   }
 
+  if (cmd == RTEMS_IO_GET_PIPE_SIZE || cmd == RTEMS_IO_SET_PIPE_SIZE) {
+    if (buffer == NULL)
+      return -EFAULT;
+
+    if (! PIPE_LOCK(pipe))
+      return -EINTR;
+
+    if (cmd == RTEMS_IO_SET_PIPE_SIZE)
+      err = pipe_set_size(pipe, *(int *)buffer);
+    else
+      *(int *)buffer = (int) pipe->Size;
+
+    PIPE_UNLOCK(pipe);
+    return err;
+  }
+
   return -EINVAL;
 }
+
+static void pipe_read_detach(struct knote *kn)
+{
+  pipe_control_t *pipe = kn->kn_hook;
+
+  knlist_remove(&pipe->readNote, kn, 0);
+}
+
+static int pipe_read_event(struct knote *kn, long hint)
+{
+  pipe_control_t *pipe = kn->kn_hook;
+
+  kn->kn_data = pipe->Length;
+
+  if (pipe->Writers == 0) {
+    kn->kn_flags |= EV_EOF;
+    return 1;
+  }
+
+  return kn->kn_data > 0;
+}
+
+static void pipe_write_detach(struct knote *kn)
+{
+  pipe_control_t *pipe = kn->kn_hook;
+
+  knlist_remove(&pipe->writeNote, kn, 0);
+}
+
+static int pipe_write_event(struct knote *kn, long hint)
+{
+  pipe_control_t *pipe = kn->kn_hook;
+
+  kn->kn_data = PIPE_SPACE(pipe);
+
+  if (pipe->Readers == 0) {
+    kn->kn_flags |= EV_EOF;
+    return 1;
+  }
+
+  if (kn->kn_sfflags & NOTE_LOWAT)
+    return kn->kn_data >= kn->kn_sdata;
+
+  return kn->kn_data > 0;
+}
+
+static struct filterops pipe_read_filtops = {
+  .f_isfd = 1,
+  .f_detach = pipe_read_detach,
+  .f_event = pipe_read_event
+};
+
+static struct filterops pipe_write_filtops = {
+  .f_isfd = 1,
+  .f_detach = pipe_write_detach,
+  .f_event = pipe_write_event
+};
+
+/*
+ * The filter events are evaluated without the pipe lock, since knote() may
+ * be called from interrupt context.  They only read the counters.
+ */
+int pipe_kqfilter(
+  pipe_control_t *pipe,
+  struct knote   *kn,
+  rtems_libio_t  *iop
+)
+{
+  switch (kn->kn_filter) {
+    case EVFILT_READ:
+      kn->kn_fop = &pipe_read_filtops;
+      kn->kn_hook = pipe;
+      knlist_add(&pipe->readNote, kn, 0);
+      break;
+    case EVFILT_WRITE:
+      kn->kn_fop = &pipe_write_filtops;
+      kn->kn_hook = pipe;
+      knlist_add(&pipe->writeNote, kn, 0);
+      break;
+    default:
+      return -EINVAL;
+  }
+
+  return 0;
+}
@@ -19,6 +19,7 @@
 #define _RTEMS_PIPE_H
 
 #include <rtems/libio.h>
+#include <sys/event.h>
 
 /**
  * @defgroup FIFO_PIPE FIFO/Pipe File System Support
@@ -33,6 +34,14 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Maximum pipe buffer size which can be set with the
+ * RTEMS_IO_SET_PIPE_SIZE IO control.
+ *
+ * The minimum size is PIPE_BUF.
+ */
+#define PIPE_MAX_SIZE (1024 * 1024)
+
 /* Control block to manage each pipe */
 typedef struct pipe_control {
   char *Buffer;
@@ -43,11 +52,16 @@ typedef struct pipe_control {
   unsigned int Writers;
   unsigned int waitingReaders;
   unsigned int waitingWriters;
+  unsigned int writeWanted;       /* space wanted by the waiting writers */
+  bool readBusy;                  /* a reader copies without the lock */
+  bool writeBusy;                 /* a writer copies without the lock */
   unsigned int readerCounter;     /* incremental counters */
   unsigned int writerCounter;     /* for differentiation of successive opens */
   rtems_id Semaphore;
   rtems_id readBarrier;   /* wait queues */
   rtems_id writeBarrier;
+  struct knlist readNote; /* kevent() filters */
+  struct knlist writeNote;
 #if 0
   boolean Anonymous;      /* anonymous pipe or FIFO */
 #endif
@@ -115,7 +129,11 @@ extern ssize_t pipe_write(
 /**
  * @brief File system Input/Output control.
  *
- * Interface to file system ioctl.
+ * Interface to file system ioctl.  In addition to FIONREAD, the
+ * RTEMS_IO_GET_PIPE_SIZE and RTEMS_IO_SET_PIPE_SIZE commands get and set the
+ * pipe buffer size via an int pointer.  The size must be in the range from
+ * PIPE_BUF to PIPE_MAX_SIZE and must be large enough for the data currently
+ * in the pipe.
  */
 extern int pipe_ioctl(
   pipe_control_t  *pipe,
@@ -124,6 +142,17 @@ extern int pipe_ioctl(
   rtems_libio_t   *iop
 );
 
+/**
+ * @brief File system kernel event filter.
+ *
+ * Interface to file system kqfilter.
+ */
+extern int pipe_kqfilter(
+  pipe_control_t *pipe,
+  struct knote   *kn,
+  rtems_libio_t  *iop
+);
+
 /** @} */
 
 #ifdef __cplusplus
@@ -254,6 +254,45 @@ rtems_rfs_bitmap_map_test (rtems_rfs_bitmap_control* control,
   return 0;
 }
 
+int
+rtems_rfs_bitmap_map_set_run (rtems_rfs_bitmap_control* control,
+                              rtems_rfs_bitmap_bit      bit,
+                              size_t                    count,
+                              size_t*                   length)
+{
+  rtems_rfs_bitmap_map map;
+  rtems_rfs_bitmap_map search_map;
+  int                  rc;
+  *length = 0;
+  rc = rtems_rfs_bitmap_load_map (control, &map);
+  if (rc > 0)
+    return rc;
+  if (bit >= control->size)
+    return EINVAL;
+  search_map = control->search_bits;
+  while ((*length < count) && (bit < control->size))
+  {
+    int index  = rtems_rfs_bitmap_map_index (bit);
+    int offset = rtems_rfs_bitmap_map_offset (bit);
+    if (rtems_rfs_bitmap_test (map[index], offset))
+      break;
+    map[index] = rtems_rfs_bitmap_set (map[index], 1 << offset);
+    if (rtems_rfs_bitmap_match (map[index], RTEMS_RFS_BITMAP_ELEMENT_SET))
+    {
+      int search_index  = rtems_rfs_bitmap_map_index (index);
+      int search_offset = rtems_rfs_bitmap_map_offset (index);
+      search_map[search_index] =
+        rtems_rfs_bitmap_set (search_map[search_index], 1 << search_offset);
+    }
+    control->free--;
+    (*length)++;
+    bit++;
+  }
+  if (*length)
+    rtems_rfs_buffer_mark_dirty (control->buffer);
+  return 0;
+}
+
 int
 rtems_rfs_bitmap_map_set_all (rtems_rfs_bitmap_control* control)
 {
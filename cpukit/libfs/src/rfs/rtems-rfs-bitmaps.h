@@ -245,6 +245,23 @@ rtems_rfs_bitmap_map_test (rtems_rfs_bitmap_control* control,
                            rtems_rfs_bitmap_bit      bit,
                            bool*                     state);
 
+/**
+ * Set a run of clear bits in a map with a single load of the map. The run
+ * stops at the first bit already set or at the end of the map.
+ *
+ * @param[in] control is the control for the map.
+ * @param[in] bit is the first bit in the map to set.
+ * @param[in] count is the maximum number of bits to set.
+ * @param[out] length is the number of bits set.
+ *
+ * @retval 0 Successful operation.
+ * @retval error_code An error occurred.
+ */
+int rtems_rfs_bitmap_map_set_run (rtems_rfs_bitmap_control* control,
+                                  rtems_rfs_bitmap_bit      bit,
+                                  size_t                    count,
+                                  size_t*                   length);
+
 /**
  * Set all bits in the bitmap and set the dirty bit.
  *
@@ -37,6 +37,7 @@
 #endif
 
 #include <inttypes.h>
+#include <stddef.h>
 #include <string.h>
 
 #include <rtems/rfs/rtems-rfs-block.h>
@@ -44,6 +45,12 @@
 #include <rtems/rfs/rtems-rfs-group.h>
 #include <rtems/rfs/rtems-rfs-inode.h>
 
+/**
+ * The number of runs reserved by other maps skipped when looking for a run of
+ * blocks to reserve.
+ */
+#define RTEMS_RFS_BLOCK_MAP_RESERVE_SKIPS (4)
+
 void
 rtems_rfs_block_get_bpos (rtems_rfs_file_system* fs,
                           rtems_rfs_pos          pos,
@@ -90,6 +97,53 @@ rtems_rfs_block_get_size (rtems_rfs_file_system* fs,
   return (((uint64_t) (size->count - 1)) * block_size) + offset;
 }
 
+/**
+ * Drop the reservation of the blocks left in the map's run.
+ *
+ * @param map The map the reservation is dropped for.
+ */
+static void
+rtems_rfs_block_map_drop_reserve (rtems_rfs_block_map* map)
+{
+  if (!rtems_chain_is_node_off_chain (&map->reserve_link))
+  {
+    rtems_chain_extract_unprotected (&map->reserve_link);
+    rtems_chain_set_off_chain (&map->reserve_link);
+  }
+  map->reserve_count = 0;
+}
+
+/**
+ * Find the map other than the map given reserving a block.
+ *
+ * @param fs The file system data.
+ * @param map The map looking for the block.
+ * @param block The block to check.
+ * @return rtems_rfs_block_map* The map reserving the block or NULL.
+ */
+static rtems_rfs_block_map*
+rtems_rfs_block_map_reserved_by (rtems_rfs_file_system* fs,
+                                 rtems_rfs_block_map*   map,
+                                 rtems_rfs_block_no     block)
+{
+  rtems_chain_node* node = rtems_chain_first (&fs->reservations);
+
+  while (!rtems_chain_is_tail (&fs->reservations, node))
+  {
+    rtems_rfs_block_map* other;
+
+    other = (rtems_rfs_block_map*)
+      ((char*) node - offsetof (rtems_rfs_block_map, reserve_link));
+    if ((other != map) && (block >= other->reserve_block) &&
+        (block < (other->reserve_block + other->reserve_count)))
+      return other;
+
+    node = rtems_chain_next (node);
+  }
+
+  return NULL;
+}
+
 int
 rtems_rfs_block_map_open (rtems_rfs_file_system*  fs,
                           rtems_rfs_inode_handle* inode,
@@ -106,6 +160,11 @@ rtems_rfs_block_map_open (rtems_rfs_file_system*  fs,
 
   map->dirty = false;
   map->inode = NULL;
+  map->reserve = false;
+  map->reserve_block = 0;
+  map->reserve_count = 0;
+  map->reserve_taken = 0;
+  rtems_chain_set_off_chain (&map->reserve_link);
   rtems_rfs_block_set_size_zero (&map->size);
   rtems_rfs_block_set_bpos_zero (&map->bpos);
 
@@ -148,6 +207,9 @@ rtems_rfs_block_map_close (rtems_rfs_file_system* fs,
   int rc = 0;
   int brc;
 
+  rtems_rfs_block_map_free_taken (fs, map);
+  rtems_rfs_block_map_drop_reserve (map);
+
   if (map->dirty && map->inode)
   {
     brc = rtems_rfs_inode_load (fs, map->inode);
@@ -401,6 +463,160 @@ rtems_rfs_block_map_indirect_alloc (rtems_rfs_file_system*   fs,
   return 0;
 }
 
+/**
+ * Allocate a data block for a map and reserve a run of blocks following it.
+ * The search starts at the map's last data block and skips the runs reserved
+ * by other maps. If all free blocks found are reserved by other maps the block
+ * is used without a run.
+ *
+ * @param fs The file system data.
+ * @param map The map the allocation is for.
+ * @param blocks The number of blocks still to be allocated.
+ * @param block The block number of the data block allocated.
+ * @return int The error number (errno). No error if 0.
+ */
+static int
+rtems_rfs_block_map_reserve_run (rtems_rfs_file_system* fs,
+                                 rtems_rfs_block_map*   map,
+                                 size_t                 blocks,
+                                 rtems_rfs_bitmap_bit*  block)
+{
+  rtems_rfs_block_map* other;
+  rtems_rfs_block_no   goal = map->last_data_block;
+  size_t               count = rtems_rfs_fs_reserve_blocks (fs);
+  size_t               length;
+  size_t               n;
+  int                  tries = 0;
+  int                  rc;
+
+  if (count < blocks)
+    count = blocks;
+
+  while (true)
+  {
+    rc = rtems_rfs_group_bitmap_alloc (fs, goal, false, block);
+    if (rc > 0)
+      return rc;
+
+    other = rtems_rfs_block_map_reserved_by (fs, map, *block);
+    if ((other == NULL) || (tries >= RTEMS_RFS_BLOCK_MAP_RESERVE_SKIPS))
+      break;
+
+    rc = rtems_rfs_group_bitmap_free (fs, false, *block);
+    if (rc > 0)
+      return rc;
+
+    goal = other->reserve_block + other->reserve_count;
+    tries++;
+  }
+
+  if (other != NULL)
+    return 0;
+
+  rc = rtems_rfs_group_bitmap_clear_run (fs, *block + 1, count - 1, &length);
+  if ((rc > 0) && (rc != EINVAL))
+    return rc;
+
+  for (n = 0; n < length; n++)
+    if (rtems_rfs_block_map_reserved_by (fs, map, *block + 1 + n))
+      break;
+
+  if (n > 0)
+  {
+    map->reserve_block = *block + 1;
+    map->reserve_count = n;
+    rtems_chain_append_unprotected (&fs->reservations, &map->reserve_link);
+
+    if (rtems_rfs_trace (RTEMS_RFS_TRACE_BLOCK_MAP_GROW))
+      printf ("rtems-rfs: block-map-grow: reserve: block=%" PRIu32
+              " count=%zu\n", map->reserve_block, map->reserve_count);
+  }
+
+  return 0;
+}
+
+int
+rtems_rfs_block_map_take (rtems_rfs_file_system* fs,
+                          rtems_rfs_block_map*   map,
+                          size_t                 blocks)
+{
+  int rc;
+
+  if ((map->reserve_taken > 0) || (map->reserve_count == 0))
+    return 0;
+
+  if (blocks > map->reserve_count)
+    blocks = map->reserve_count;
+
+  rc = rtems_rfs_group_bitmap_alloc_run (fs, map->reserve_block, blocks,
+                                         &map->reserve_taken);
+  if (rc > 0)
+    return rc;
+
+  map->reserve_block += map->reserve_taken;
+  map->reserve_count -= map->reserve_taken;
+
+  /*
+   * Drop the run if it is used up or another allocation took the next block.
+   */
+  if ((map->reserve_count == 0) || (map->reserve_taken < blocks))
+    rtems_rfs_block_map_drop_reserve (map);
+
+  return 0;
+}
+
+void
+rtems_rfs_block_map_free_taken (rtems_rfs_file_system* fs,
+                                rtems_rfs_block_map*   map)
+{
+  while (map->reserve_taken)
+  {
+    rtems_rfs_group_bitmap_free (fs, false,
+                                 map->reserve_block - map->reserve_taken);
+    map->reserve_taken--;
+  }
+}
+
+/**
+ * Allocate a data block for a map. If the map reserves blocks the block is
+ * taken from the reserved run and a new run is reserved when the run is empty
+ * or another allocation took the next block of the run. Taking blocks from a
+ * run keeps the data blocks of files that grow together contiguous.
+ *
+ * @param fs The file system data.
+ * @param map The map the allocation is for.
+ * @param blocks The number of blocks still to be allocated.
+ * @param block The block number of the data block allocated.
+ * @return int The error number (errno). No error if 0.
+ */
+static int
+rtems_rfs_block_map_data_alloc (rtems_rfs_file_system* fs,
+                                rtems_rfs_block_map*   map,
+                                size_t                 blocks,
+                                rtems_rfs_bitmap_bit*  block)
+{
+  int rc;
+
+  if (!map->reserve)
+    return rtems_rfs_group_bitmap_alloc (fs, map->last_data_block,
+                                         false, block);
+
+  rc = rtems_rfs_block_map_take (fs, map, blocks);
+  if (rc > 0)
+    return rc;
+
+  if (map->reserve_taken)
+  {
+    *block = map->reserve_block - map->reserve_taken;
+    map->reserve_taken--;
+    return 0;
+  }
+
+  rtems_rfs_block_map_drop_reserve (map);
+
+  return rtems_rfs_block_map_reserve_run (fs, map, blocks, block);
+}
+
 int
 rtems_rfs_block_map_grow (rtems_rfs_file_system* fs,
                           rtems_rfs_block_map*   map,
@@ -430,8 +646,7 @@ rtems_rfs_block_map_grow (rtems_rfs_file_system* fs,
      * allocated free this block.
      */
 
-    rc = rtems_rfs_group_bitmap_alloc (fs, map->last_data_block,
-                                       false, &block);
+    rc = rtems_rfs_block_map_data_alloc (fs, map, blocks - b, &block);
     if (rc > 0)
       return rc;
 
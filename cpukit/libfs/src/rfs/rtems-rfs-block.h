@@ -128,6 +128,38 @@ typedef struct rtems_rfs_block_map_s
    */
   rtems_rfs_block_no last_data_block;
 
+  /**
+   * Reserve blocks as the map grows. Only set for maps of regular files when
+   * the file system has block reservation enabled.
+   */
+  bool reserve;
+
+  /**
+   * The node on the file system's list of reservations while the map holds a
+   * run of reserved blocks.
+   */
+  rtems_chain_node reserve_link;
+
+  /**
+   * The next block in the run of reserved blocks. The run is only reserved in
+   * memory, other maps do not start their runs in it. A block of the run is
+   * allocated in the bitmaps when the map takes it.
+   */
+  rtems_rfs_block_no reserve_block;
+
+  /**
+   * The number of blocks left in the reserved run.
+   */
+  size_t reserve_count;
+
+  /**
+   * The number of blocks before the reserve block taken from the run. The
+   * blocks are allocated in the bitmaps with a single update and are added to
+   * the map as it grows. The blocks not added are freed at the end of the
+   * write that took them.
+   */
+  size_t reserve_taken;
+
   /**
    * The block map.
    */
@@ -193,6 +225,11 @@ typedef struct rtems_rfs_block_map_s
  */
 #define rtems_rfs_block_map_block_offset(_m) ((_m)->bpos.boff)
 
+/**
+ * Enable block reservation for the map.
+ */
+#define rtems_rfs_block_map_set_reserve(_m) ((_m)->reserve = true)
+
 /**
  * Set the size offset for the map. The map is tagged as dirty.
  *
@@ -238,7 +275,8 @@ int rtems_rfs_block_map_open (rtems_rfs_file_system*  fs,
 
 /**
  * Close the map. The buffer handles are closed and any help buffers are
- * released.
+ * released. Taken blocks not added to the map are freed and the reservation
+ * of any blocks not used is dropped.
  *
  * @param[in] fs is the file system data.
  * @param[in] map is a pointer to the map that is opened.
@@ -297,6 +335,32 @@ int rtems_rfs_block_map_next_block (rtems_rfs_file_system*  fs,
                                     rtems_rfs_block_map*    map,
                                     rtems_rfs_buffer_block* block);
 
+/**
+ * Take blocks from the map's reserved run for the following grows of the map.
+ * The blocks are allocated in the bitmaps with a single update and the grows
+ * add them to the map without a bitmap update. Nothing is taken if the map
+ * has no reserved run or still holds blocks taken before.
+ *
+ * @param[in] fs is the file system data.
+ * @param[in] map is a pointer to the open map.
+ * @param[in] blocks is the number of blocks the map is about to grow by.
+ *
+ * @retval 0 Successful operation.
+ * @retval error_code An error occurred.
+ */
+int rtems_rfs_block_map_take (rtems_rfs_file_system* fs,
+                              rtems_rfs_block_map*   map,
+                              size_t                 blocks);
+
+/**
+ * Free the blocks taken from the map's reserved run and not added to the map.
+ *
+ * @param[in] fs is the file system data.
+ * @param[in] map is a pointer to the open map.
+ */
+void rtems_rfs_block_map_free_taken (rtems_rfs_file_system* fs,
+                                     rtems_rfs_block_map*   map);
+
 /**
  * Grow the block map by the specified number of blocks.
  *
@@ -314,6 +378,32 @@ int rtems_rfs_block_map_grow (rtems_rfs_file_system* fs,
                               size_t                 blocks,
                               rtems_rfs_block_no*    new_block);
 
+/**
+ * Take blocks from the map's reserved run for the following grows of the map.
+ * The blocks are allocated in the bitmaps with a single update and the grows
+ * add them to the map without a bitmap update. Nothing is taken if the map
+ * has no reserved run or still holds blocks taken before.
+ *
+ * @param[in] fs is the file system data.
+ * @param[in] map is a pointer to the open map.
+ * @param[in] blocks is the number of blocks the map is about to grow by.
+ *
+ * @retval 0 Successful operation.
+ * @retval error_code An error occurred.
+ */
+int rtems_rfs_block_map_take (rtems_rfs_file_system* fs,
+                              rtems_rfs_block_map*   map,
+                              size_t                 blocks);
+
+/**
+ * Free the blocks taken from the map's reserved run and not added to the map.
+ *
+ * @param[in] fs is the file system data.
+ * @param[in] map is a pointer to the open map.
+ */
+void rtems_rfs_block_map_free_taken (rtems_rfs_file_system* fs,
+                                     rtems_rfs_block_map*   map);
+
 /**
  * Grow the block map by the specified number of blocks.
  *
@@ -110,6 +110,17 @@ rtems_rfs_fs_read_superblock (rtems_rfs_file_system* fs)
     return EIO;
   }
 
+  /*
+   * Version 1 or later superblocks hold the flags. A version 0 superblock has
+   * all ones in the field so it cannot be used.
+   */
+  if (read_sb (RTEMS_RFS_SB_OFFSET_VERSION) >= RTEMS_RFS_VERSION_SB_FLAGS)
+  {
+    uint32_t sb_flags = read_sb (RTEMS_RFS_SB_OFFSET_FLAGS);
+    if ((sb_flags & RTEMS_RFS_SB_FLAG_RESERVE) != 0)
+      fs->flags |= RTEMS_RFS_FS_RESERVE;
+  }
+
   fs->bad_blocks      = read_sb (RTEMS_RFS_SB_OFFSET_BAD_BLOCKS);
   fs->max_name_length = read_sb (RTEMS_RFS_SB_OFFSET_MAX_NAME_LENGTH);
   fs->group_count     = read_sb (RTEMS_RFS_SB_OFFSET_GROUPS);
@@ -224,8 +235,10 @@ rtems_rfs_fs_open (const char*             name,
   rtems_chain_initialize_empty (&(*fs)->release);
   rtems_chain_initialize_empty (&(*fs)->release_modified);
   rtems_chain_initialize_empty (&(*fs)->file_shares);
+  rtems_chain_initialize_empty (&(*fs)->reservations);
 
   (*fs)->max_held_buffers = max_held_buffers;
+  (*fs)->reserve_blocks = RTEMS_RFS_FS_RESERVE_BLOCKS;
   (*fs)->buffers_count = 0;
   (*fs)->release_count = 0;
   (*fs)->release_modified_count = 0;
@@ -37,11 +37,27 @@
 #define RTEMS_RFS_SB_OFFSET_GROUP_BLOCKS    (RTEMS_RFS_SB_OFFSET_GROUPS          + 4)
 #define RTEMS_RFS_SB_OFFSET_GROUP_INODES    (RTEMS_RFS_SB_OFFSET_GROUP_BLOCKS    + 4)
 #define RTEMS_RFS_SB_OFFSET_INODE_SIZE      (RTEMS_RFS_SB_OFFSET_GROUP_INODES    + 4)
+#define RTEMS_RFS_SB_OFFSET_FLAGS           (RTEMS_RFS_SB_OFFSET_INODE_SIZE      + 4)
 
 /**
- * RFS Version Number.
+ * Superblock flags. The flags are only present in version 1 or later
+ * superblocks.
  */
-#define RTEMS_RFS_VERSION (0x00000000)
+#define RTEMS_RFS_SB_FLAG_RESERVE (1 << 0) /**< Reserve blocks for files as
+                                            * they grow by default. */
+
+/**
+ * RFS Version Number. Version 1 adds the superblock flags. The layout of the
+ * inodes and block maps is not changed so the version mask is left as is and
+ * a version 0 file system can be mounted and a version 1 file system can be
+ * mounted by a version 0 implementation.
+ */
+#define RTEMS_RFS_VERSION (0x00000001)
+
+/**
+ * The first version with the superblock flags field.
+ */
+#define RTEMS_RFS_VERSION_SB_FLAGS (0x00000001)
 
 /**
  * RFS Version Number Mask. The mask determines which bits of the version
@@ -84,6 +100,12 @@
  */
 #define RTEMS_RFS_FS_MAX_HELD_BUFFERS (5)
 
+/**
+ * The default number of blocks reserved for a file when block reservation is
+ * enabled.
+ */
+#define RTEMS_RFS_FS_RESERVE_BLOCKS (16)
+
 /**
  * Absolute position. Make a 64bit value.
  */
@@ -109,6 +131,11 @@ typedef int64_t rtems_rfs_pos_rel;
 #define RTEMS_RFS_FS_READ_ONLY         (1 << 3) /**< Make the mount
                                                  * read-only. Currently not
                                                  * supported. */
+#define RTEMS_RFS_FS_RESERVE           (1 << 4) /**< Reserve a run of
+                                                 * contiguous blocks for a
+                                                 * file as it grows and
+                                                 * release the unused blocks
+                                                 * when the file is closed. */
 /**
  * RFS File System data.
  */
@@ -215,6 +242,11 @@ struct _rtems_rfs_file_system
    */
   uint32_t max_held_buffers;
 
+  /**
+   * Number of blocks reserved for a file when block reservation is enabled.
+   */
+  size_t reserve_blocks;
+
   /**
    * List of buffers attached to buffer handles. Allows sharing.
    */
@@ -253,6 +285,13 @@ struct _rtems_rfs_file_system
    */
   rtems_chain_control file_shares;
 
+  /**
+   * List of block maps holding a run of reserved blocks. The reservations are
+   * only held in memory. A reserved block is set in the bitmaps when the file
+   * uses it so nothing leaks on disk if the file system is not unmounted.
+   */
+  rtems_chain_control reservations;
+
   /**
    * Pointer to user data supplied when opening.
    */
@@ -279,6 +318,20 @@ struct _rtems_rfs_file_system
  */
 #define rtems_rfs_fs_no_local_cache(_f) ((_f)->flags & RTEMS_RFS_FS_NO_LOCAL_CACHE)
 
+/**
+ * Are blocks reserved for files as they grow ?
+ *
+ * @param[in] _fs is a pointer to the file system.
+ */
+#define rtems_rfs_fs_reserve(_f) ((_f)->flags & RTEMS_RFS_FS_RESERVE)
+
+/**
+ * The number of blocks reserved for a file as it grows.
+ *
+ * @param[in] _fs is a pointer to the file system.
+ */
+#define rtems_rfs_fs_reserve_blocks(_f) ((_f)->reserve_blocks)
+
 /**
  * The disk device number.
  *
@@ -115,6 +115,9 @@ rtems_rfs_file_open (rtems_rfs_file_system*  fs,
       return rc;
     }
 
+    if (rtems_rfs_fs_reserve (fs))
+      rtems_rfs_block_map_set_reserve (&shared->map);
+
     shared->references = 1;
     shared->size.count = rtems_rfs_inode_get_block_count (&shared->inode);
     shared->size.offset = rtems_rfs_inode_get_block_offset (&shared->inode);
@@ -230,6 +233,8 @@ rtems_rfs_file_io_start (rtems_rfs_file_handle* handle,
   if (!rtems_rfs_buffer_handle_has_block (&handle->buffer))
   {
     rtems_rfs_buffer_block block;
+    size_t                 block_size;
+    size_t                 blocks;
     bool                   request_read;
     int                    rc;
 
@@ -256,6 +261,19 @@ rtems_rfs_file_io_start (rtems_rfs_file_handle* handle,
       if (rtems_rfs_trace (RTEMS_RFS_TRACE_FILE_IO))
         printf ("rtems-rfs: file-io: start: grow\n");
 
+      /*
+       * Take the blocks the rest of the write needs from the reserved run in
+       * one go. The write frees the blocks it does not use when it ends.
+       */
+      block_size = rtems_rfs_fs_block_size (rtems_rfs_file_fs (handle));
+      blocks = *available + rtems_rfs_file_block_offset (handle);
+      blocks = (blocks + block_size - 1) / block_size;
+      rc = rtems_rfs_block_map_take (rtems_rfs_file_fs (handle),
+                                     rtems_rfs_file_map (handle),
+                                     blocks);
+      if (rc > 0)
+        return rc;
+
       rc = rtems_rfs_block_map_grow (rtems_rfs_file_fs (handle),
                                      rtems_rfs_file_map (handle),
                                      1, &block);
@@ -391,10 +391,12 @@ rtems_rfs_write_group (rtems_rfs_file_system* fs,
 }
 
 static bool
-rtems_rfs_write_superblock (rtems_rfs_file_system* fs)
+rtems_rfs_write_superblock (rtems_rfs_file_system*         fs,
+                            const rtems_rfs_format_config* config)
 {
   rtems_rfs_buffer_handle handle;
   uint8_t*                sb;
+  uint32_t                sb_flags = 0;
   int                     rc;
 
   rc = rtems_rfs_buffer_handle_open (fs, &handle);
@@ -431,6 +433,11 @@ rtems_rfs_write_superblock (rtems_rfs_file_system* fs)
   write_sb (RTEMS_RFS_SB_OFFSET_GROUP_INODES, fs->group_inodes);
   write_sb (RTEMS_RFS_SB_OFFSET_INODE_SIZE, RTEMS_RFS_INODE_SIZE);
 
+  if (config->reserve_blocks)
+    sb_flags |= RTEMS_RFS_SB_FLAG_RESERVE;
+
+  write_sb (RTEMS_RFS_SB_OFFSET_FLAGS, sb_flags);
+
   rtems_rfs_buffer_mark_dirty (&handle);
 
   rc = rtems_rfs_buffer_handle_release (fs, &handle);
@@ -542,6 +549,7 @@ rtems_rfs_format (const char* name, const rtems_rfs_format_config* config)
   rtems_chain_initialize_empty (&fs.release);
   rtems_chain_initialize_empty (&fs.release_modified);
   rtems_chain_initialize_empty (&fs.file_shares);
+  rtems_chain_initialize_empty (&fs.reservations);
 
   fs.max_held_buffers = RTEMS_RFS_FS_MAX_HELD_BUFFERS;
 
@@ -601,6 +609,8 @@ rtems_rfs_format (const char* name, const rtems_rfs_format_config* config)
     printf ("rtems-rfs: format: groups = %u\n", fs.group_count);
     printf ("rtems-rfs: format: group blocks = %zu\n", fs.group_blocks);
     printf ("rtems-rfs: format: group inodes = %zu\n", fs.group_inodes);
+    printf ("rtems-rfs: format: reserve blocks = %s\n",
+            config->reserve_blocks ? "yes" : "no");
   }
 
   rc = rtems_rfs_buffer_setblksize (&fs, rtems_rfs_fs_block_size (&fs));
@@ -611,7 +621,7 @@ rtems_rfs_format (const char* name, const rtems_rfs_format_config* config)
     return -1;
   }
 
-  if (!rtems_rfs_write_superblock (&fs))
+  if (!rtems_rfs_write_superblock (&fs, config))
   {
     printf ("rtems-rfs: format: superblock write failed\n");
     return -1;
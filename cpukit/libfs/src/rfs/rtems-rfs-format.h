@@ -65,6 +65,12 @@ typedef struct _rtems_rfs_format_config
    */
   bool initialise_inodes;
 
+  /**
+   * Set the superblock flag so blocks are reserved for files as they grow
+   * when the file system is mounted.
+   */
+  bool reserve_blocks;
+
   /**
    * Is the format verbose.
    */
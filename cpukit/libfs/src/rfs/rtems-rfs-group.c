@@ -258,6 +258,79 @@ rtems_rfs_group_bitmap_alloc (rtems_rfs_file_system* fs,
   return ENOSPC;
 }
 
+int
+rtems_rfs_group_bitmap_alloc_run (rtems_rfs_file_system* fs,
+                                  rtems_rfs_bitmap_bit   no,
+                                  size_t                 count,
+                                  size_t*                length)
+{
+  rtems_rfs_bitmap_control* bitmap;
+  unsigned int              group;
+  rtems_rfs_bitmap_bit      bit;
+  int                       rc;
+
+  *length = 0;
+
+  if ((no < RTEMS_RFS_SUPERBLOCK_SIZE) || (no >= rtems_rfs_fs_blocks (fs)))
+    return EINVAL;
+
+  no -= RTEMS_RFS_SUPERBLOCK_SIZE;
+  group = no / fs->group_blocks;
+  bit = (rtems_rfs_bitmap_bit) (no % fs->group_blocks);
+  bitmap = &fs->groups[group].block_bitmap;
+
+  rc = rtems_rfs_bitmap_map_set_run (bitmap, bit, count, length);
+
+  if (rtems_rfs_fs_release_bitmaps (fs))
+    rtems_rfs_bitmap_release_buffer (fs, bitmap);
+
+  if (rtems_rfs_trace (RTEMS_RFS_TRACE_GROUP_BITMAPS))
+    printf ("rtems-rfs: group-bitmap-alloc-run: block=%" PRId32
+            " count=%zu allocated=%zu\n",
+            no + RTEMS_RFS_SUPERBLOCK_SIZE, count, *length);
+
+  return rc;
+}
+
+int
+rtems_rfs_group_bitmap_clear_run (rtems_rfs_file_system* fs,
+                                  rtems_rfs_bitmap_bit   no,
+                                  size_t                 count,
+                                  size_t*                length)
+{
+  rtems_rfs_bitmap_control* bitmap;
+  unsigned int              group;
+  rtems_rfs_bitmap_bit      bit;
+  int                       rc = 0;
+
+  *length = 0;
+
+  if ((no < RTEMS_RFS_SUPERBLOCK_SIZE) || (no >= rtems_rfs_fs_blocks (fs)))
+    return EINVAL;
+
+  no -= RTEMS_RFS_SUPERBLOCK_SIZE;
+  group = no / fs->group_blocks;
+  bit = (rtems_rfs_bitmap_bit) (no % fs->group_blocks);
+  bitmap = &fs->groups[group].block_bitmap;
+
+  while ((*length < count) && (bit < bitmap->size))
+  {
+    bool state;
+
+    rc = rtems_rfs_bitmap_map_test (bitmap, bit, &state);
+    if ((rc > 0) || state)
+      break;
+
+    (*length)++;
+    bit++;
+  }
+
+  if (rtems_rfs_fs_release_bitmaps (fs))
+    rtems_rfs_bitmap_release_buffer (fs, bitmap);
+
+  return rc;
+}
+
 int
 rtems_rfs_group_bitmap_free (rtems_rfs_file_system* fs,
                              bool                   inode,
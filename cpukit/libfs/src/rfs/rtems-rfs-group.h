@@ -139,6 +139,41 @@ int rtems_rfs_group_bitmap_alloc (rtems_rfs_file_system* fs,
                                   bool                   inode,
                                   rtems_rfs_bitmap_bit*  result);
 
+/**
+ * @brief Allocate a run of blocks starting at a block.
+ *
+ * The blocks are set in the group's block bitmap with a single update of the
+ * bitmap. The run stops at the first allocated block or at the end of the
+ * block's group.
+ *
+ * @param fs The file system data.
+ * @param no The first block number to allocate.
+ * @param count The maximum number of blocks to allocate.
+ * @param length The number of blocks allocated.
+ * @retval int The error number (errno). No error if 0.
+ */
+int rtems_rfs_group_bitmap_alloc_run (rtems_rfs_file_system* fs,
+                                      rtems_rfs_bitmap_bit   no,
+                                      size_t                 count,
+                                      size_t*                length);
+
+/**
+ * @brief Count the free blocks starting at a block.
+ *
+ * The blocks are not allocated. The count stops at the first allocated block
+ * or at the end of the block's group.
+ *
+ * @param fs The file system data.
+ * @param no The first block number.
+ * @param count The maximum number of blocks to count.
+ * @param length The number of free blocks in the run.
+ * @retval int The error number (errno). No error if 0.
+ */
+int rtems_rfs_group_bitmap_clear_run (rtems_rfs_file_system* fs,
+                                      rtems_rfs_bitmap_bit   no,
+                                      size_t                 count,
+                                      size_t*                length);
+
 /**
  * @brief Free the group allocated bit.
  *
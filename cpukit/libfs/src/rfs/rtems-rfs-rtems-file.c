@@ -104,6 +104,135 @@ rtems_rfs_rtems_file_close (rtems_libio_t* iop)
   return rc;
 }
 
+/**
+ * Copy file data at the block position of the file handle to the buffer.  The
+ * file system must be locked.
+ *
+ * @param file
+ * @param data
+ * @param count
+ * @return ssize_t
+ */
+static ssize_t
+rtems_rfs_rtems_file_read_data (rtems_rfs_file_handle* file,
+                                uint8_t*               data,
+                                size_t                 count)
+{
+  ssize_t read = 0;
+  int     rc;
+
+  while (count)
+  {
+    size_t size;
+
+    rc = rtems_rfs_file_io_start (file, &size, true);
+    if (rc > 0)
+    {
+      read = rtems_rfs_rtems_error ("file-read: read: io-start", rc);
+      break;
+    }
+
+    if (size == 0)
+      break;
+
+    if (size > count)
+      size = count;
+
+    memcpy (data, rtems_rfs_file_data (file), size);
+
+    data  += size;
+    count -= size;
+    read  += size;
+
+    rc = rtems_rfs_file_io_end (file, size, true);
+    if (rc > 0)
+    {
+      read = rtems_rfs_rtems_error ("file-read: read: io-end", rc);
+      break;
+    }
+  }
+
+  return read;
+}
+
+/**
+ * Copy the buffer to the file at the block position of the file handle.  The
+ * file system must be locked.
+ *
+ * @param file
+ * @param data
+ * @param count
+ * @return ssize_t
+ */
+static ssize_t
+rtems_rfs_rtems_file_write_data (rtems_rfs_file_handle* file,
+                                 const uint8_t*         data,
+                                 size_t                 count)
+{
+  ssize_t write = 0;
+  int     rc;
+
+  while (count)
+  {
+    size_t size = count;
+
+    rc = rtems_rfs_file_io_start (file, &size, false);
+    if (rc)
+    {
+      /*
+       * If we have run out of space and have written some data return that
+       * amount first as the inode will have accounted for it. This means
+       * there was no error and the return code from can be ignored.
+       */
+      if (!write)
+        write = rtems_rfs_rtems_error ("file-write: write open", rc);
+      break;
+    }
+
+    if (size > count)
+      size = count;
+
+    memcpy (rtems_rfs_file_data (file), data, size);
+
+    data  += size;
+    count -= size;
+    write  += size;
+
+    rc = rtems_rfs_file_io_end (file, size, false);
+    if (rc)
+    {
+      write = rtems_rfs_rtems_error ("file-write: write close", rc);
+      break;
+    }
+  }
+
+  /*
+   * Free the blocks taken from a reserved run the write did not use.
+   */
+  rtems_rfs_block_map_free_taken (rtems_rfs_file_fs (file),
+                                  rtems_rfs_file_map (file));
+
+  return write;
+}
+
+/**
+ * Move the block position of the file handle back to the offset of the IO
+ * descriptor after a positional read or write.  The file system must be
+ * locked.
+ *
+ * @param iop
+ * @param file
+ * @return int
+ */
+static int
+rtems_rfs_rtems_file_restore_bpos (rtems_libio_t*         iop,
+                                   rtems_rfs_file_handle* file)
+{
+  rtems_rfs_pos pos = iop->offset;
+
+  return rtems_rfs_file_seek (file, pos, &pos);
+}
+
 /**
  * This routine processes the read() system call.
  *
@@ -119,9 +248,7 @@ rtems_rfs_rtems_file_read (rtems_libio_t* iop,
 {
   rtems_rfs_file_handle* file = rtems_rfs_rtems_get_iop_file_handle (iop);
   rtems_rfs_pos          pos;
-  uint8_t*               data = buffer;
   ssize_t                read = 0;
-  int                    rc;
 
   if (rtems_rfs_rtems_trace (RTEMS_RFS_RTEMS_DEBUG_FILE_READ))
     printf("rtems-rfs: file-read: handle:%p count:%zd\n", file, count);
@@ -131,41 +258,73 @@ rtems_rfs_rtems_file_read (rtems_libio_t* iop,
   pos = iop->offset;
 
   if (pos < rtems_rfs_file_size (file))
-  {
-    while (count)
-    {
-      size_t size;
+    read = rtems_rfs_rtems_file_read_data (file, buffer, count);
 
-      rc = rtems_rfs_file_io_start (file, &size, true);
-      if (rc > 0)
-      {
-        read = rtems_rfs_rtems_error ("file-read: read: io-start", rc);
-        break;
-      }
+  if (read >= 0)
+    iop->offset = pos + read;
 
-      if (size == 0)
-        break;
+  rtems_rfs_rtems_unlock (rtems_rfs_file_fs (file));
 
-      if (size > count)
-        size = count;
+  return read;
+}
 
-      memcpy (data, rtems_rfs_file_data (file), size);
+/**
+ * This routine processes the preadv() system call.  The file offset of the
+ * IO descriptor stays as is.
+ *
+ * @param iop
+ * @param iov
+ * @param iovcnt
+ * @param offset
+ * @param total
+ * @return ssize_t
+ */
+static ssize_t
+rtems_rfs_rtems_file_preadv (rtems_libio_t*      iop,
+                             const struct iovec* iov,
+                             int                 iovcnt,
+                             off_t               offset,
+                             ssize_t             total)
+{
+  rtems_rfs_file_handle* file = rtems_rfs_rtems_get_iop_file_handle (iop);
+  rtems_rfs_pos          pos = offset;
+  ssize_t                read = 0;
+  int                    rc;
+  int                    v;
 
-      data  += size;
-      count -= size;
-      read  += size;
+  if (rtems_rfs_rtems_trace (RTEMS_RFS_RTEMS_DEBUG_FILE_READ))
+    printf("rtems-rfs: file-preadv: handle:%p count:%zd offset:%" PRIdoff_t "\n",
+           file, total, offset);
+
+  rtems_rfs_rtems_lock (rtems_rfs_file_fs (file));
+
+  if (pos < rtems_rfs_file_size (file))
+  {
+    rc = rtems_rfs_file_seek (file, pos, &pos);
+    if (rc)
+      read = rtems_rfs_rtems_error ("file-preadv: seek", rc);
+
+    for (v = 0; read >= 0 && v < iovcnt; ++v)
+    {
+      size_t  len = iov[v].iov_len;
+      ssize_t size = rtems_rfs_rtems_file_read_data (file, iov[v].iov_base, len);
 
-      rc = rtems_rfs_file_io_end (file, size, true);
-      if (rc > 0)
+      if (size < 0)
       {
-        read = rtems_rfs_rtems_error ("file-read: read: io-end", rc);
+        read = size;
         break;
       }
+
+      read += size;
+
+      if ((size_t) size != len)
+        break;
     }
-  }
 
-  if (read >= 0)
-    iop->offset = pos + read;
+    rc = rtems_rfs_rtems_file_restore_bpos (iop, file);
+    if (rc && read >= 0)
+      read = rtems_rfs_rtems_error ("file-preadv: restore", rc);
+  }
 
   rtems_rfs_rtems_unlock (rtems_rfs_file_fs (file));
 
@@ -188,8 +347,7 @@ rtems_rfs_rtems_file_write (rtems_libio_t* iop,
   rtems_rfs_file_handle* file = rtems_rfs_rtems_get_iop_file_handle (iop);
   rtems_rfs_pos          pos;
   rtems_rfs_pos          file_size;
-  const uint8_t*         data = buffer;
-  ssize_t                write = 0;
+  ssize_t                write;
   int                    rc;
 
   if (rtems_rfs_rtems_trace (RTEMS_RFS_RTEMS_DEBUG_FILE_WRITE))
@@ -226,42 +384,91 @@ rtems_rfs_rtems_file_write (rtems_libio_t* iop,
     }
   }
 
-  while (count)
-  {
-    size_t size = count;
+  write = rtems_rfs_rtems_file_write_data (file, buffer, count);
 
-    rc = rtems_rfs_file_io_start (file, &size, false);
+  if (write >= 0)
+    iop->offset = pos + write;
+
+  rtems_rfs_rtems_unlock (rtems_rfs_file_fs (file));
+
+  return write;
+}
+
+/**
+ * This routine processes the pwritev() system call.  The file offset of the
+ * IO descriptor stays as is.
+ *
+ * @param iop
+ * @param iov
+ * @param iovcnt
+ * @param offset
+ * @param total
+ * @return ssize_t
+ */
+static ssize_t
+rtems_rfs_rtems_file_pwritev (rtems_libio_t*      iop,
+                              const struct iovec* iov,
+                              int                 iovcnt,
+                              off_t               offset,
+                              ssize_t             total)
+{
+  rtems_rfs_file_handle* file = rtems_rfs_rtems_get_iop_file_handle (iop);
+  rtems_rfs_pos          pos = offset;
+  ssize_t                write = 0;
+  int                    rc;
+  int                    v;
+
+  if (rtems_rfs_rtems_trace (RTEMS_RFS_RTEMS_DEBUG_FILE_WRITE))
+    printf("rtems-rfs: file-pwritev: handle:%p count:%zd offset:%" PRIdoff_t "\n",
+           file, total, offset);
+
+  rtems_rfs_rtems_lock (rtems_rfs_file_fs (file));
+
+  if (pos > rtems_rfs_file_size (file))
+  {
+    /*
+     * See rtems_rfs_rtems_file_write().
+     */
+    rc = rtems_rfs_file_set_size (file, pos);
     if (rc)
     {
-      /*
-       * If we have run out of space and have written some data return that
-       * amount first as the inode will have accounted for it. This means
-       * there was no error and the return code from can be ignored.
-       */
-      if (!write)
-        write = rtems_rfs_rtems_error ("file-write: write open", rc);
-      break;
+      rtems_rfs_rtems_unlock (rtems_rfs_file_fs (file));
+      return rtems_rfs_rtems_error ("file-pwritev: write extend", rc);
     }
 
-    if (size > count)
-      size = count;
-
-    memcpy (rtems_rfs_file_data (file), data, size);
+    rtems_rfs_file_set_bpos (file, pos);
+  }
+  else
+  {
+    rc = rtems_rfs_file_seek (file, pos, &pos);
+    if (rc)
+    {
+      rtems_rfs_rtems_unlock (rtems_rfs_file_fs (file));
+      return rtems_rfs_rtems_error ("file-pwritev: seek", rc);
+    }
+  }
 
-    data  += size;
-    count -= size;
-    write  += size;
+  for (v = 0; v < iovcnt; ++v)
+  {
+    size_t  len = iov[v].iov_len;
+    ssize_t size = rtems_rfs_rtems_file_write_data (file, iov[v].iov_base, len);
 
-    rc = rtems_rfs_file_io_end (file, size, false);
-    if (rc)
+    if (size < 0)
     {
-      write = rtems_rfs_rtems_error ("file-write: write close", rc);
+      if (!write)
+        write = size;
       break;
     }
+
+    write += size;
+
+    if ((size_t) size != len)
+      break;
   }
 
-  if (write >= 0)
-    iop->offset = pos + write;
+  rc = rtems_rfs_rtems_file_restore_bpos (iop, file);
+  if (rc && write >= 0)
+    write = rtems_rfs_rtems_error ("file-pwritev: restore", rc);
 
   rtems_rfs_rtems_unlock (rtems_rfs_file_fs (file));
 
@@ -357,5 +564,8 @@ const rtems_filesystem_file_handlers_r rtems_rfs_rtems_file_handlers = {
   .kqfilter_h  = rtems_filesystem_default_kqfilter,
   .poll_h      = rtems_filesystem_default_poll,
   .readv_h     = rtems_filesystem_default_readv,
-  .writev_h    = rtems_filesystem_default_writev
+  .writev_h    = rtems_filesystem_default_writev,
+  .loan_h      = rtems_filesystem_default_loan,
+  .preadv_h    = rtems_rfs_rtems_file_preadv,
+  .pwritev_h   = rtems_rfs_rtems_file_pwritev
 };
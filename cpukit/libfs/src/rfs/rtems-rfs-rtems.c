@@ -784,7 +784,10 @@ const rtems_filesystem_file_handlers_r rtems_rfs_rtems_link_handlers =
   .kqfilter_h  = rtems_filesystem_default_kqfilter,
   .poll_h      = rtems_filesystem_default_poll,
   .readv_h     = rtems_filesystem_default_readv,
-  .writev_h    = rtems_filesystem_default_writev
+  .writev_h    = rtems_filesystem_default_writev,
+  .loan_h      = rtems_filesystem_default_loan,
+  .preadv_h    = rtems_filesystem_default_preadv,
+  .pwritev_h   = rtems_filesystem_default_pwritev
 };
 
 /**
@@ -835,6 +838,7 @@ rtems_rfs_rtems_initialise (rtems_filesystem_mount_table_entry_t* mt_entry,
   rtems_rfs_file_system*   fs;
   uint32_t                 flags = 0;
   uint32_t                 max_held_buffers = RTEMS_RFS_FS_MAX_HELD_BUFFERS;
+  size_t                   reserve_blocks = 0;
   const char*              options = data;
   int                      rc;
 
@@ -855,6 +859,22 @@ rtems_rfs_rtems_initialise (rtems_filesystem_mount_table_entry_t* mt_entry,
     {
       max_held_buffers = strtoul (options + sizeof ("max-held-bufs"), 0, 0);
     }
+    else if (strncmp (options, "reserve-blocks=",
+                      sizeof ("reserve-blocks=") - 1) == 0)
+    {
+      char* end;
+
+      flags |= RTEMS_RFS_FS_RESERVE;
+      reserve_blocks = strtoul (options + sizeof ("reserve-blocks=") - 1,
+                                &end, 0);
+      if ((reserve_blocks == 0) || ((*end != '\0') && (*end != ',')))
+        return rtems_rfs_rtems_error ("initialise: invalid reserve-blocks",
+                                      EINVAL);
+    }
+    else if ((strncmp (options, "reserve", sizeof ("reserve") - 1) == 0) &&
+             ((options[sizeof ("reserve") - 1] == '\0') ||
+              (options[sizeof ("reserve") - 1] == ',')))
+      flags |= RTEMS_RFS_FS_RESERVE;
     else
       return rtems_rfs_rtems_error ("initialise: invalid option", EINVAL);
 
@@ -895,6 +915,9 @@ rtems_rfs_rtems_initialise (rtems_filesystem_mount_table_entry_t* mt_entry,
     return rtems_rfs_rtems_error ("initialise: open", errno);
   }
 
+  if (reserve_blocks)
+    fs->reserve_blocks = reserve_blocks;
+
   mt_entry->fs_info                          = fs;
   mt_entry->ops                              = &rtems_rfs_ops;
   mt_entry->mt_fs_root->location.node_access = (void*) RTEMS_RFS_ROOT_INO;
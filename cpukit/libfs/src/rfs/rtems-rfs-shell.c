@@ -711,6 +711,10 @@ rtems_shell_rfs_format (int argc, char* argv[])
           config.initialise_inodes = true;
           break;
 
+        case 'r':
+          config.reserve_blocks = true;
+          break;
+
         case 'o':
           arg++;
           if (arg >= argc)
@@ -43,6 +43,7 @@
 #include <sys/proc.h>
 #include <sys/malloc.h>
 #include <sys/queue.h>
+#include <netinet/in.h>
 
 int
 uiomove(void *cp, int n, struct uio *uio)
@@ -96,6 +97,61 @@ uiomove(void *cp, int n, struct uio *uio)
 	return (0);
 }
 
+/*
+ * Like uiomove(), but the data is copied with in_cksum_copy() and the sum
+ * of the n bytes at cp is returned in *sum, see in_cksum_data().  The
+ * copyin() and copyout() of the user space case are plain copies on RTEMS.
+ */
+int
+uiomove_cksum(void *cp, int n, struct uio *uio, u_short *sum)
+{
+	struct iovec *iov;
+	u_short part = 0;
+	u_short s = 0;
+	int off = 0;
+	u_int cnt;
+
+#ifdef DIAGNOSTIC
+	if (uio->uio_rw != UIO_READ && uio->uio_rw != UIO_WRITE)
+		panic("uiomove_cksum: mode");
+#endif
+	while (n > 0 && uio->uio_resid) {
+		iov = uio->uio_iov;
+		cnt = iov->iov_len;
+		if (cnt == 0) {
+			uio->uio_iov++;
+			uio->uio_iovcnt--;
+			continue;
+		}
+		if (cnt > n)
+			cnt = n;
+
+		switch (uio->uio_segflg) {
+
+		case UIO_USERSPACE:
+		case UIO_SYSSPACE:
+			if (uio->uio_rw == UIO_READ)
+				part = in_cksum_copy(cp, iov->iov_base, (int)cnt);
+			else
+				part = in_cksum_copy(iov->iov_base, cp, (int)cnt);
+			break;
+		case UIO_NOCOPY:
+			part = in_cksum_data(cp, (int)cnt);
+			break;
+		}
+		s = in_cksum_add(s, part, off);
+		iov->iov_base += cnt;
+		iov->iov_len -= cnt;
+		uio->uio_resid -= cnt;
+		uio->uio_offset += cnt;
+		cp += cnt;
+		n -= cnt;
+		off += cnt;
+	}
+	*sum = s;
+	return (0);
+}
+
 /*
  * General routine to allocate a hash table.
  */
@@ -39,6 +39,7 @@
 #include <sys/syslog.h>
 #include <sys/domain.h>
 #include <sys/protosw.h>
+#include <netinet/in.h>
 
 #include <vm/vm.h>
 #include <vm/vm_param.h>
@@ -53,8 +54,6 @@ SYSINIT(mbuf, SI_SUB_MBUF, SI_ORDER_FIRST, mbinit, NULL)
 struct mbuf *mbutl;
 char	*mclrefcnt;
 struct mbstat mbstat;
-struct mbuf *mmbfree;
-union mcluster *mclfree;
 int	max_linkhdr;
 int	max_protohdr;
 int	max_hdr;
@@ -300,7 +299,11 @@ m_copypacket(struct mbuf *m, int how)
 	n->m_len = m->m_len;
 	if (m->m_flags & M_EXT) {
 		n->m_data = m->m_data;
-		mclrefcnt[mtocl(m->m_ext.ext_buf)]++;
+		if(!m->m_ext.ext_ref)
+			mclrefcnt[mtocl(m->m_ext.ext_buf)]++;
+		else
+			(*(m->m_ext.ext_ref))(m->m_ext.ext_buf,
+						m->m_ext.ext_size);
 		n->m_ext = m->m_ext;
 		n->m_flags |= M_EXT;
 	} else {
@@ -319,7 +322,11 @@ m_copypacket(struct mbuf *m, int how)
 		n->m_len = m->m_len;
 		if (m->m_flags & M_EXT) {
 			n->m_data = m->m_data;
-			mclrefcnt[mtocl(m->m_ext.ext_buf)]++;
+			if(!m->m_ext.ext_ref)
+				mclrefcnt[mtocl(m->m_ext.ext_buf)]++;
+			else
+				(*(m->m_ext.ext_ref))(m->m_ext.ext_buf,
+							m->m_ext.ext_size);
 			n->m_ext = m->m_ext;
 			n->m_flags |= M_EXT;
 		} else {
@@ -383,6 +390,44 @@ m_copydata(const struct mbuf *m, int off, int len, caddr_t cp)
     return 0;
 }
 
+/*
+ * Like m_copydata(), but the data is copied with in_cksum_copy() and the
+ * sum of the len bytes at cp is returned in *sum, see in_cksum_data().
+ */
+int
+m_copydata_cksum(const struct mbuf *m, int off, int len, caddr_t cp,
+    u_short *sum)
+{
+	u_short s = 0;
+	int done = 0;
+	u_int count;
+
+	if (off < 0 || len < 0)
+		panic("m_copydata_cksum");
+	while (off > 0) {
+		if (m == 0)
+			return -1;
+		if (off < m->m_len)
+			break;
+		off -= m->m_len;
+		m = m->m_next;
+	}
+	while (len > 0) {
+		if (m == 0)
+			return -1;
+		count = min(m->m_len - off, len);
+		s = in_cksum_add(s, in_cksum_copy(mtod(m, caddr_t) + off, cp,
+		    (int)count), done);
+		len -= count;
+		cp += count;
+		done += count;
+		off = 0;
+		m = m->m_next;
+	}
+	*sum = s;
+	return 0;
+}
+
 /*
  * Concatenate mbuf chain n to m.
  * Both chains must be of the same type (e.g. MT_DATA).
@@ -738,3 +783,50 @@ m_copyback(struct mbuf *m0, int off, int len, caddr_t cp)
 		m->m_pkthdr.len = totlen;
 	return 0;
 }
+
+static void
+m_extref_free(caddr_t buf, u_int size)
+{
+	m_extref_rele((struct m_extref *)buf);
+}
+
+static void
+m_extref_ref(caddr_t buf, u_int size)
+{
+	++((struct m_extref *)buf)->er_refcnt;
+}
+
+/*
+ * Initialize reference counted external storage.  The caller owns the
+ * first reference and drops it with m_extref_rele() when it no longer
+ * attaches data to mbufs.
+ */
+void
+m_extref_init(struct m_extref *er, void (*free)(struct m_extref *))
+{
+	er->er_refcnt = 1;
+	er->er_free = free;
+}
+
+/*
+ * Attach len bytes of external data to an empty mbuf.
+ */
+void
+m_extref_add(struct mbuf *m, struct m_extref *er, caddr_t data, int len)
+{
+	++er->er_refcnt;
+	m->m_ext.ext_buf = (caddr_t)er;
+	m->m_ext.ext_free = m_extref_free;
+	m->m_ext.ext_ref = m_extref_ref;
+	m->m_ext.ext_size = 0;
+	m->m_data = data;
+	m->m_len = len;
+	m->m_flags |= M_EXT;
+}
+
+void
+m_extref_rele(struct m_extref *er)
+{
+	if (--er->er_refcnt == 0)
+		(*er->er_free)(er);
+}
@@ -44,6 +44,7 @@
 #include <sys/resourcevar.h>
 #include <sys/signalvar.h>
 #include <sys/sysctl.h>
+#include <netinet/in.h>
 #include <limits.h>
 
 static int somaxconn = SOMAXCONN;
@@ -302,12 +303,28 @@ bad:
 int
 sosend(struct socket *so, struct mbuf *addr, struct uio *uio,
     struct mbuf *top, struct mbuf *control, int flags)
+{
+	return (sosend_extref(so, addr, uio, top, control, flags, NULL));
+}
+
+/*
+ * RTEMS: Like sosend(), but if "er" is nonzero, the data described by
+ * "uio" is attached to the mbufs as external storage instead of being
+ * copied.  The uio must use UIO_NOCOPY in this case.
+ */
+int
+sosend_extref(struct socket *so, struct mbuf *addr, struct uio *uio,
+    struct mbuf *top, struct mbuf *control, int flags, struct m_extref *er)
 {
 	struct mbuf **mp;
 	register struct mbuf *m;
 	register long space, len, resid;
 	int clen = 0, error, s, dontroute, mlen;
 	int atomic = sosendallatonce(so) || top;
+	int cksum = er == NULL &&
+	    (so->so_proto->pr_flags & PR_CKSUMCOPY) != 0 &&
+	    in_pcbcksumcopy(so);
+	u_short sum = 0, dsum = 0;
 
 	if (uio)
 		resid = uio->uio_resid;
@@ -399,11 +416,21 @@ restart:
 				mlen = MHLEN;
 				m->m_pkthdr.len = 0;
 				m->m_pkthdr.rcvif = (struct ifnet *)0;
+				dsum = 0;
 			} else {
 				MGET(m, M_WAIT, MT_DATA);
 				mlen = MLEN;
 			}
-			if (resid >= MINCLSIZE) {
+			if (er != NULL) {
+				while (uio->uio_iov->iov_len == 0) {
+					uio->uio_iov++;
+					uio->uio_iovcnt--;
+				}
+				len = min(min((long)uio->uio_iov->iov_len,
+				    resid), space);
+				m_extref_add(m, er, uio->uio_iov->iov_base,
+				    (int)len);
+			} else if (resid >= MINCLSIZE) {
 				MCLGET(m, M_WAIT);
 				if ((m->m_flags & M_EXT) == 0)
 					goto nopages;
@@ -420,20 +447,35 @@ nopages:
 					MH_ALIGN(m, len);
 			}
 			space -= len;
-			error = uiomove(mtod(m, caddr_t), (int)len, uio);
+			if (er != NULL)
+				error = uiomove(mtod(m, caddr_t), (int)len, uio);
+			else
+				error = rtems_bsdnet_uiomove_unlocked(mtod(m, caddr_t), (int)len, uio,
+				    cksum ? &sum : NULL);
 			resid = uio->uio_resid;
 			m->m_len = len;
 			*mp = m;
 			top->m_pkthdr.len += len;
 			if (error)
 				goto release;
+			if (cksum)
+				dsum = in_cksum_add(dsum, sum,
+				    (int)(top->m_pkthdr.len - len));
 			mp = &m->m_next;
 			if (resid <= 0) {
 				if (flags & MSG_EOR)
 					top->m_flags |= M_EOR;
 				break;
 			}
-		    } while (space > 0 && atomic);
+		    } while (space > 0 && (atomic || er != NULL));
+		    /*
+		     * Hand the data sum to the protocol, so that it need not
+		     * read the data again.
+		     */
+		    if (cksum && uio != NULL) {
+			top->m_pkthdr.csum_flags |= CSUM_DATA_SUM;
+			top->m_pkthdr.csum_data = dsum;
+		    }
 		    if (dontroute)
 			    so->so_options |= SO_DONTROUTE;
 		    s = splnet();				/* XXX */
@@ -677,7 +719,7 @@ dontblock:
 		 */
 		if (mp == 0) {
 			splx(s);
-			error = uiomove(mtod(m, caddr_t) + moff, (int)len, uio);
+			error = rtems_bsdnet_uiomove_unlocked(mtod(m, caddr_t) + moff, (int)len, uio, NULL);
 			s = splnet();
 			if (error)
 				goto release;
@@ -806,7 +848,8 @@ sorflush(struct socket *so)
 	socantrcvmore(so);
 	sbunlock(sb);
 	asb = *sb;
-	bzero((caddr_t)sb, sizeof (*sb));
+	/* Keep the kevent() filters attached to the socket */
+	bzero((caddr_t)sb, (caddr_t)&sb->sb_note - (caddr_t)sb);
 	splx(s);
 	if (pr->pr_flags & PR_RIGHTS && pr->pr_domain->dom_dispose)
 		(*pr->pr_domain->dom_dispose)(asb.sb_mb);
@@ -1101,3 +1144,94 @@ sohasoutofband(struct socket *so)
 	selwakeup(&so->so_rcv.sb_sel);
 #endif
 }
+
+static void
+filt_sordetach(struct knote *kn)
+{
+	struct socket *so = kn->kn_hook;
+
+	knlist_remove(&so->so_rcv.sb_note, kn, 0);
+}
+
+static int
+filt_soread(struct knote *kn, long hint)
+{
+	struct socket *so = kn->kn_hook;
+
+	if (so->so_options & SO_ACCEPTCONN) {
+		kn->kn_data = so->so_qlen;
+		return (!TAILQ_EMPTY(&so->so_comp));
+	}
+	kn->kn_data = so->so_rcv.sb_cc;
+	if (so->so_state & SS_CANTRCVMORE) {
+		kn->kn_flags |= EV_EOF;
+		kn->kn_fflags = so->so_error;
+		return (1);
+	}
+	if (so->so_error)
+		return (1);
+	if (kn->kn_sfflags & NOTE_LOWAT)
+		return (kn->kn_data >= kn->kn_sdata);
+	return (kn->kn_data >= so->so_rcv.sb_lowat);
+}
+
+static void
+filt_sowdetach(struct knote *kn)
+{
+	struct socket *so = kn->kn_hook;
+
+	knlist_remove(&so->so_snd.sb_note, kn, 0);
+}
+
+static int
+filt_sowrite(struct knote *kn, long hint)
+{
+	struct socket *so = kn->kn_hook;
+
+	kn->kn_data = sbspace(&so->so_snd);
+	if (so->so_state & SS_CANTSENDMORE) {
+		kn->kn_flags |= EV_EOF;
+		kn->kn_fflags = so->so_error;
+		return (1);
+	}
+	if (so->so_error)
+		return (1);
+	if (((so->so_state & SS_ISCONNECTED) == 0) &&
+	    (so->so_proto->pr_flags & PR_CONNREQUIRED))
+		return (0);
+	if (kn->kn_sfflags & NOTE_LOWAT)
+		return (kn->kn_data >= kn->kn_sdata);
+	return (kn->kn_data >= so->so_snd.sb_lowat);
+}
+
+static struct filterops soread_filtops =
+	{ 1, NULL, filt_sordetach, filt_soread, NULL };
+static struct filterops sowrite_filtops =
+	{ 1, NULL, filt_sowdetach, filt_sowrite, NULL };
+
+/*
+ * Attach a kevent() filter to a socket.  The filters are evaluated
+ * without the network semaphore, see knote().
+ */
+int
+sokqfilter(struct socket *so, struct knote *kn)
+{
+	struct sockbuf *sb;
+
+	switch (kn->kn_filter) {
+	case EVFILT_READ:
+		kn->kn_fop = &soread_filtops;
+		sb = &so->so_rcv;
+		break;
+	case EVFILT_WRITE:
+		kn->kn_fop = &sowrite_filtops;
+		sb = &so->so_snd;
+		break;
+	default:
+		return (EINVAL);
+	}
+
+	kn->kn_hook = so;
+	knlist_add(&sb->sb_note, kn, 0);
+	return (0);
+}
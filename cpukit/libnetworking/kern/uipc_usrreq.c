@@ -0,0 +1,470 @@
+/*
+ * This file has undergone several changes to reflect the
+ * differences between the RTEMS and FreeBSD kernels.
+ */
+
+/*
+ * Copyright (c) 1982, 1986, 1989, 1991, 1993
+ *	The Regents of the University of California.  All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ * 3. All advertising materials mentioning features or use of this software
+ *    must display the following acknowledgement:
+ *	This product includes software developed by the University of
+ *	California, Berkeley and its contributors.
+ * 4. Neither the name of the University nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+ * OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+ * OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ *	From: @(#)uipc_usrreq.c	8.3 (Berkeley) 1/4/94
+ */
+
+/*
+ * Local domain sockets for socketpair()
+ *
+ * The data of a local domain socket is appended directly to the receive
+ * buffer of its peer, there is no protocol processing in between.  There
+ * is no file system name space for the sockets, so they can only be
+ * created in connected pairs.
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <sys/param.h>
+#include <sys/systm.h>
+#include <sys/kernel.h>
+#include <sys/domain.h>
+#include <sys/malloc.h>
+#include <sys/mbuf.h>
+#include <sys/protosw.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/socketvar.h>
+#include <sys/un.h>
+#include <errno.h>
+
+/*
+ * Protocol control block of a local domain socket
+ */
+struct unpcb {
+	struct	socket *unp_socket;	/* pointer back to socket */
+	struct	unpcb *unp_conn;	/* control block of connected socket */
+	u_long	unp_cc;			/* copy of rcv.sb_cc */
+	u_long	unp_mbcnt;		/* copy of rcv.sb_mbcnt */
+};
+
+#define	sotounpcb(so)	((struct unpcb *)((so)->so_pcb))
+
+static struct	sockaddr_un sun_noname = { sizeof(sun_noname), AF_LOCAL };
+
+/*
+ * Both send and receive buffers are allocated PIPSIZ bytes of buffering
+ * for stream sockets, although the total for sender and receiver is
+ * actually only PIPSIZ.
+ * Datagram sockets really use the sendspace as the maximum datagram size,
+ * and don't really want to reserve the sendspace.  Their recvspace should
+ * be large enough for at least one max-size datagram plus address.
+ */
+#ifndef PIPSIZ
+#define	PIPSIZ	8192
+#endif
+static u_long	unpst_sendspace = PIPSIZ;
+static u_long	unpst_recvspace = PIPSIZ;
+static u_long	unpdg_sendspace = 2*1024;	/* really max datagram size */
+static u_long	unpdg_recvspace = 4*1024;
+
+static void	unp_disconnect(struct unpcb *);
+static void	unp_drop(struct unpcb *, int);
+static void	unp_shutdown(struct unpcb *);
+
+static int
+uipc_abort(struct socket *so)
+{
+	struct unpcb *unp = sotounpcb(so);
+
+	if (unp == NULL)
+		return EINVAL;
+	unp_drop(unp, ECONNABORTED);
+	return 0;
+}
+
+static int
+uipc_attach(struct socket *so, intptr_t proto)
+{
+	struct unpcb *unp = sotounpcb(so);
+	int error;
+
+	if (unp != NULL)
+		return EISCONN;
+	if (so->so_snd.sb_hiwat == 0 || so->so_rcv.sb_hiwat == 0) {
+		switch (so->so_type) {
+
+		case SOCK_STREAM:
+			error = soreserve(so, unpst_sendspace, unpst_recvspace);
+			break;
+
+		case SOCK_DGRAM:
+			error = soreserve(so, unpdg_sendspace, unpdg_recvspace);
+			break;
+
+		default:
+			panic("unp_attach");
+		}
+		if (error)
+			return error;
+	}
+	MALLOC(unp, struct unpcb *, sizeof *unp, M_PCB, M_NOWAIT);
+	if (unp == NULL)
+		return ENOBUFS;
+	bzero((caddr_t)unp, sizeof *unp);
+	unp->unp_socket = so;
+	so->so_pcb = (caddr_t)unp;
+	return 0;
+}
+
+static int
+uipc_connect2(struct socket *so, struct socket *so2)
+{
+	struct unpcb *unp = sotounpcb(so);
+	struct unpcb *unp2;
+
+	if (unp == NULL)
+		return EINVAL;
+	if (so2->so_type != so->so_type)
+		return EPROTOTYPE;
+	unp2 = sotounpcb(so2);
+	if (unp2 == NULL || so2->so_proto != so->so_proto)
+		return EPROTOTYPE;
+	unp->unp_conn = unp2;
+	switch (so->so_type) {
+
+	case SOCK_DGRAM:
+		soisconnected(so);
+		break;
+
+	case SOCK_STREAM:
+		unp2->unp_conn = unp;
+		soisconnected(so);
+		soisconnected(so2);
+		break;
+
+	default:
+		panic("unp_connect2");
+	}
+	return 0;
+}
+
+static int
+uipc_detach(struct socket *so)
+{
+	struct unpcb *unp = sotounpcb(so);
+	struct unpcb *unp2;
+
+	if (unp == NULL)
+		return EINVAL;
+	unp2 = unp->unp_conn;
+	unp_disconnect(unp);
+
+	/*
+	 * The datagram peer of a socket pair still refers to this socket
+	 */
+	if (unp2 != NULL && unp2->unp_conn == unp)
+		unp_drop(unp2, ECONNRESET);
+	so->so_pcb = NULL;
+	FREE(unp, M_PCB);
+	return 0;
+}
+
+static int
+uipc_disconnect(struct socket *so)
+{
+	struct unpcb *unp = sotounpcb(so);
+
+	if (unp == NULL)
+		return EINVAL;
+	unp_disconnect(unp);
+	return 0;
+}
+
+/*
+ * There is no name space for local domain sockets, they are only
+ * connected by socketpair()
+ */
+static int
+uipc_notsupp(struct socket *so, struct mbuf *nam)
+{
+	return EOPNOTSUPP;
+}
+
+static int
+uipc_control(struct socket *so, intptr_t cmd, caddr_t data, struct ifnet *ifp)
+{
+	return EOPNOTSUPP;
+}
+
+static int
+uipc_addr(struct socket *so, struct mbuf *nam)
+{
+	nam->m_len = sizeof(sun_noname);
+	bcopy((caddr_t)&sun_noname, mtod(nam, caddr_t), sizeof(sun_noname));
+	return 0;
+}
+
+static int
+uipc_peeraddr(struct socket *so, struct mbuf *nam)
+{
+	struct unpcb *unp = sotounpcb(so);
+
+	if (unp == NULL)
+		return EINVAL;
+	if (unp->unp_conn == NULL)
+		return ENOTCONN;
+	return uipc_addr(so, nam);
+}
+
+/*
+ * The receiver took data from its buffer, give the space back to the
+ * sender.
+ */
+static int
+uipc_rcvd(struct socket *so, intptr_t flags)
+{
+	struct unpcb *unp = sotounpcb(so);
+	struct socket *so2;
+
+	if (unp == NULL)
+		return EINVAL;
+	switch (so->so_type) {
+
+	case SOCK_DGRAM:
+		panic("uipc_rcvd DGRAM?");
+		/*NOTREACHED*/
+
+	case SOCK_STREAM:
+		if (unp->unp_conn == NULL)
+			break;
+		so2 = unp->unp_conn->unp_socket;
+		/*
+		 * Adjust backpressure on sender
+		 * and wakeup any waiting to write.
+		 */
+		so2->so_snd.sb_mbmax += unp->unp_mbcnt - so->so_rcv.sb_mbcnt;
+		unp->unp_mbcnt = so->so_rcv.sb_mbcnt;
+		so2->so_snd.sb_hiwat += unp->unp_cc - so->so_rcv.sb_cc;
+		unp->unp_cc = so->so_rcv.sb_cc;
+		sowwakeup(so2);
+		break;
+
+	default:
+		panic("uipc_rcvd unknown socktype");
+	}
+	return 0;
+}
+
+/*
+ * Move the data directly to the receive buffer of the peer
+ */
+static int
+uipc_send(struct socket *so, int flags, struct mbuf *m, struct mbuf *nam,
+	  struct mbuf *control)
+{
+	struct unpcb *unp = sotounpcb(so);
+	struct socket *so2;
+	int error = 0;
+
+	if (unp == NULL) {
+		error = EINVAL;
+		goto release;
+	}
+	if ((flags & PRUS_OOB) || control != NULL || nam != NULL) {
+		error = EOPNOTSUPP;
+		goto release;
+	}
+	if (so->so_state & SS_CANTSENDMORE) {
+		error = EPIPE;
+		goto release;
+	}
+	if (unp->unp_conn == NULL) {
+		error = ENOTCONN;
+		goto release;
+	}
+	so2 = unp->unp_conn->unp_socket;
+
+	switch (so->so_type) {
+
+	case SOCK_DGRAM:
+		if (sbappendaddr(&so2->so_rcv, (struct sockaddr *)&sun_noname,
+		    m, NULL)) {
+			sorwakeup(so2);
+			m = NULL;
+		} else
+			error = ENOBUFS;
+		break;
+
+	case SOCK_STREAM:
+		/*
+		 * Send to paired receive port, and then reduce
+		 * send buffer hiwater marks to maintain backpressure.
+		 * Wake up readers.
+		 */
+		sbappend(&so2->so_rcv, m);
+		so->so_snd.sb_mbmax -=
+		    so2->so_rcv.sb_mbcnt - unp->unp_conn->unp_mbcnt;
+		unp->unp_conn->unp_mbcnt = so2->so_rcv.sb_mbcnt;
+		so->so_snd.sb_hiwat -=
+		    so2->so_rcv.sb_cc - unp->unp_conn->unp_cc;
+		unp->unp_conn->unp_cc = so2->so_rcv.sb_cc;
+		sorwakeup(so2);
+		m = NULL;
+		break;
+
+	default:
+		panic("uipc_send unknown socktype");
+	}
+
+	/*
+	 * SEND_EOF is equivalent to a SEND followed by
+	 * a SHUTDOWN.
+	 */
+	if (flags & PRUS_EOF) {
+		socantsendmore(so);
+		unp_shutdown(unp);
+	}
+
+release:
+	if (control != NULL)
+		m_freem(control);
+	if (m != NULL)
+		m_freem(m);
+	return error;
+}
+
+static int
+uipc_sense(struct socket *so, struct stat *sb)
+{
+	struct unpcb *unp = sotounpcb(so);
+
+	if (unp == NULL)
+		return EINVAL;
+	sb->st_blksize = so->so_snd.sb_hiwat;
+	if (so->so_type == SOCK_STREAM && unp->unp_conn != NULL)
+		sb->st_blksize += unp->unp_conn->unp_socket->so_rcv.sb_cc;
+	return 0;
+}
+
+static int
+uipc_shutdown(struct socket *so)
+{
+	struct unpcb *unp = sotounpcb(so);
+
+	if (unp == NULL)
+		return EINVAL;
+	socantsendmore(so);
+	unp_shutdown(unp);
+	return 0;
+}
+
+static int
+uipc_listen(struct socket *so)
+{
+	return EOPNOTSUPP;
+}
+
+static int
+uipc_rcvoob(struct socket *so, struct mbuf *m, intptr_t flags)
+{
+	return EOPNOTSUPP;
+}
+
+static struct pr_usrreqs uipc_usrreqs = {
+	uipc_abort, uipc_notsupp, uipc_attach, uipc_notsupp,
+	uipc_notsupp, uipc_connect2, uipc_control, uipc_detach,
+	uipc_disconnect, uipc_listen, uipc_peeraddr, uipc_rcvd,
+	uipc_rcvoob, uipc_send, uipc_sense, uipc_shutdown,
+	uipc_addr
+};
+
+static void
+unp_disconnect(struct unpcb *unp)
+{
+	struct unpcb *unp2 = unp->unp_conn;
+
+	if (unp2 == NULL)
+		return;
+	unp->unp_conn = NULL;
+	switch (unp->unp_socket->so_type) {
+
+	case SOCK_DGRAM:
+		unp->unp_socket->so_state &= ~SS_ISCONNECTED;
+		break;
+
+	case SOCK_STREAM:
+		soisdisconnected(unp->unp_socket);
+		unp2->unp_conn = NULL;
+		soisdisconnected(unp2->unp_socket);
+		break;
+	}
+}
+
+static void
+unp_drop(struct unpcb *unp, int error)
+{
+	struct socket *so = unp->unp_socket;
+
+	so->so_error = error;
+	unp_disconnect(unp);
+}
+
+static void
+unp_shutdown(struct unpcb *unp)
+{
+	struct socket *so;
+
+	if (unp->unp_socket->so_type == SOCK_STREAM && unp->unp_conn &&
+	    (so = unp->unp_conn->unp_socket))
+		socantrcvmore(so);
+}
+
+/*
+ * Definitions of protocols supported in the LOCAL domain.
+ */
+
+static struct protosw localsw[] = {
+{ SOCK_STREAM,	&localdomain,	0,	PR_CONNREQUIRED|PR_WANTRCVD,
+  0,		0,		0,		0,
+  0,
+  0,		0,		0,		0,
+  &uipc_usrreqs
+},
+{ SOCK_DGRAM,	&localdomain,	0,		PR_ATOMIC|PR_ADDR,
+  0,		0,		0,		0,
+  0,
+  0,		0,		0,		0,
+  &uipc_usrreqs
+}
+};
+
+struct domain localdomain =
+    { AF_LOCAL, "local", 0, 0, 0,
+      localsw, &localsw[sizeof(localsw)/sizeof(localsw[0])] };
@@ -510,6 +510,11 @@ ifioctl(struct socket *so, u_long cmd, caddr_t data, struct proc *p)
 		ifr->ifr_phys = ifp->if_physical;
 		break;
 
+	case SIOCGIFCAP:
+		ifr->ifr_reqcap = ifp->if_capabilities;
+		ifr->ifr_curcap = ifp->if_capenable;
+		break;
+
 	case SIOCSIFFLAGS:
 		error = suser(p->p_ucred, &p->p_acflag);
 		if (error)
@@ -550,6 +555,34 @@ ifioctl(struct socket *so, u_long cmd, caddr_t data, struct proc *p)
 			microtime(&ifp->if_lastchange);
 		return(error);
 
+	case SIOCSIFCAP: {
+		int capenable;
+
+		error = suser(p->p_ucred, &p->p_acflag);
+		if (error)
+			return (error);
+		if (ifr->ifr_reqcap & ~ifp->if_capabilities)
+			return (EINVAL);
+		if (ifr->ifr_reqcap == ifp->if_capenable)
+			return (0);
+		/*
+		 * The stack uses only the enabled capabilities, see
+		 * ip_output().  The driver is notified so that it may
+		 * reprogram the hardware.
+		 */
+		capenable = ifp->if_capenable;
+		ifp->if_capenable = ifr->ifr_reqcap;
+		if (ifp->if_ioctl) {
+			error = (*ifp->if_ioctl)(ifp, cmd, data);
+			if (error) {
+				ifp->if_capenable = capenable;
+				return (error);
+			}
+		}
+		microtime(&ifp->if_lastchange);
+		break;
+	}
+
 	case SIOCSIFMTU:
 		error = suser(p->p_ucred, &p->p_acflag);
 		if (error)
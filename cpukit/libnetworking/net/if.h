@@ -147,6 +147,20 @@ struct if_data {
 	    IFF_SIMPLEX|IFF_MULTICAST|IFF_ALLMULTI|IFF_SMART|IFF_PROMISC|\
 	    IFF_POLLING)
 
+/*
+ * Capabilities that interfaces can advertise.
+ *
+ * The if_capabilities field of the ifnet lists the capabilities of the
+ * hardware, the if_capenable field the capabilities currently in use.  The
+ * SIOCSIFCAP request changes if_capenable.
+ */
+#define	IFCAP_RXCSUM		0x0001	/* can offload checksum on RX */
+#define	IFCAP_TXCSUM		0x0002	/* can offload checksum on TX */
+#define	IFCAP_TSO4		0x0100	/* can do TCP Segmentation Offload */
+
+#define	IFCAP_HWCSUM	(IFCAP_RXCSUM | IFCAP_TXCSUM)
+#define	IFCAP_TSO	IFCAP_TSO4
+
 /*
  * Values for if_link_state.
  */
@@ -213,6 +227,7 @@ struct	ifreq {
 		int32_t	ifru_mtu;
 		int	ifru_phys;
 		int	ifru_media;
+		int	ifru_cap[2];
 		caddr_t	ifru_data;
 		int	(*ifru_tap)(struct ifnet *, struct ether_header *, struct mbuf *);
 	} ifr_ifru;
@@ -225,6 +240,8 @@ struct	ifreq {
 #define	ifr_mtu		ifr_ifru.ifru_mtu	/* mtu */
 #define ifr_phys	ifr_ifru.ifru_phys	/* physical wire */
 #define ifr_media	ifr_ifru.ifru_media	/* physical media */
+#define	ifr_reqcap	ifr_ifru.ifru_cap[0]	/* requested capabilities */
+#define	ifr_curcap	ifr_ifru.ifru_cap[1]	/* current capabilities */
 #define	ifr_data	ifr_ifru.ifru_data	/* for use by interface */
 #define ifr_tap		ifr_ifru.ifru_tap	/* tap function */
 };
@@ -301,23 +301,24 @@ bad:
 }
 
 /*
- * Process a received Ethernet packet;
- * the packet is in the mbuf chain m without
- * the ether header, which is provided separately.
+ * Classify a received Ethernet packet and return the input queue of its
+ * protocol with the software interrupt to schedule in isr.  Returns NULL if
+ * the packet was consumed or dropped.
  */
-void
-ether_input(struct ifnet *ifp, struct ether_header *eh, struct mbuf *m)
+static struct ifqueue *
+ether_input_classify(struct ifnet *ifp, struct ether_header *eh,
+    struct mbuf **mp, int *isr)
 {
+	register struct mbuf *m = *mp;
 	register struct ifqueue *inq;
 	u_short ether_type;
-	int s;
 #if defined(NETATALK)
 	struct llc *l;
 #endif
 
 	if ((ifp->if_flags & IFF_UP) == 0) {
 		m_freem(m);
-		return;
+		return (NULL);
 	}
 	ifp->if_ibytes += m->m_pkthdr.len + sizeof (*eh);
 	if (bcmp((caddr_t)etherbroadcastaddr, (caddr_t)eh->ether_dhost,
@@ -334,7 +335,7 @@ ether_input(struct ifnet *ifp, struct ether_header *eh, struct mbuf *m)
 	 */
 	if (ifp->if_tap && (*ifp->if_tap)(ifp, eh, m)) {
 		m_freem(m);
-		return;
+		return (NULL);
 	}
 
 	ether_type = ntohs(eh->ether_type);
@@ -342,30 +343,30 @@ ether_input(struct ifnet *ifp, struct ether_header *eh, struct mbuf *m)
 	switch (ether_type) {
 #ifdef INET
 	case ETHERTYPE_IP:
-		schednetisr(NETISR_IP);
+		*isr = NETISR_IP;
 		inq = &ipintrq;
 		break;
 
 	case ETHERTYPE_ARP:
-		schednetisr(NETISR_ARP);
+		*isr = NETISR_ARP;
 		inq = &arpintrq;
 		break;
 #endif
 #ifdef IPX
 	case ETHERTYPE_IPX:
-		schednetisr(NETISR_IPX);
+		*isr = NETISR_IPX;
 		inq = &ipxintrq;
 		break;
 #endif
 #ifdef NETATALK
         case ETHERTYPE_AT:
-                schednetisr(NETISR_ATALK);
+                *isr = NETISR_ATALK;
                 inq = &atintrq1;
                 break;
         case ETHERTYPE_AARP:
 		/* probably this should be done with a NETISR as well */
                 aarpinput((struct arpcom *)ifp, m); /* XXX */
-                return;
+                return (NULL);
 #endif /* NETATALK */
 	default:
 #if defined (ISO) || defined (LLC) || defined(NETATALK)
@@ -385,7 +386,7 @@ ether_input(struct ifnet *ifp, struct ether_header *eh, struct mbuf *m)
 			     ntohs(l->llc_snap_ether_type) == ETHERTYPE_AT) {
 			    inq = &atintrq2;
 			    m_adj( m, sizeof( struct llc ));
-			    schednetisr(NETISR_ATALK);
+			    *isr = NETISR_ATALK;
 			    break;
 			}
 
@@ -394,7 +395,7 @@ ether_input(struct ifnet *ifp, struct ether_header *eh, struct mbuf *m)
 			     ntohs(l->llc_snap_ether_type) == ETHERTYPE_AARP) {
 			    m_adj( m, sizeof( struct llc ));
 			    aarpinput((struct arpcom *)ifp, m); /* XXX */
-			    return;
+			    return (NULL);
 			}
 		
 		    default:
@@ -417,12 +418,12 @@ ether_input(struct ifnet *ifp, struct ether_header *eh, struct mbuf *m)
 					m->m_pkthdr.len -= 3;	/* XXX */
 					M_PREPEND(m, sizeof *eh, M_DONTWAIT);
 					if (m == 0)
-						return;
+						return (NULL);
 					*mtod(m, struct ether_header *) = *eh;
 					IFDEBUG(D_ETHER)
 						printf("clnp packet");
 					ENDDEBUG
-					schednetisr(NETISR_ISO);
+					*isr = NETISR_ISO;
 					inq = &clnlintrq;
 					break;
 				}
@@ -460,11 +461,11 @@ ether_input(struct ifnet *ifp, struct ether_header *eh, struct mbuf *m)
 					eh->ether_shost[i] = c;
 				}
 				ifp->if_output(ifp, m, &sa, NULL);
-				return;
+				return (NULL);
 			}
 			default:
 				m_freem(m);
-				return;
+				return (NULL);
 			}
 			break;
 #endif /* ISO */
@@ -475,7 +476,7 @@ ether_input(struct ifnet *ifp, struct ether_header *eh, struct mbuf *m)
 				m_adj(m, ether_type - m->m_pkthdr.len);
 			M_PREPEND(m, sizeof(struct sdl_hdr) , M_DONTWAIT);
 			if (m == 0)
-				return;
+				return (NULL);
 			if ( !sdl_sethdrif(ifp, eh->ether_shost, LLC_X25_LSAP,
 					    eh->ether_dhost, LLC_X25_LSAP, 6,
 					    mtod(m, struct sdl_hdr *)))
@@ -484,7 +485,7 @@ ether_input(struct ifnet *ifp, struct ether_header *eh, struct mbuf *m)
 #ifdef LLC_DEBUG
 				printf("llc packet\n");
 #endif /* LLC_DEBUG */
-			schednetisr(NETISR_CCITT);
+			*isr = NETISR_CCITT;
 			inq = &llcintrq;
 			break;
 		}
@@ -492,14 +493,35 @@ ether_input(struct ifnet *ifp, struct ether_header *eh, struct mbuf *m)
 		dropanyway:
 		default:
 			m_freem(m);
-			return;
+			return (NULL);
 		}
 #else /* ISO || LLC || NETATALK */
 	    m_freem(m);
-	    return;
+	    return (NULL);
 #endif /* ISO || LLC || NETATALK */
 	}
 
+	*mp = m;
+	return (inq);
+}
+
+/*
+ * Process a received Ethernet packet;
+ * the packet is in the mbuf chain m without
+ * the ether header, which is provided separately.
+ */
+void
+ether_input(struct ifnet *ifp, struct ether_header *eh, struct mbuf *m)
+{
+	struct ifqueue *inq;
+	int isr;
+	int s;
+
+	inq = ether_input_classify(ifp, eh, &m, &isr);
+	if (inq == NULL)
+		return;
+	schednetisr(isr);
+
 	s = splimp();
 	if (IF_QFULL(inq)) {
 		IF_DROP(inq);
@@ -509,6 +531,46 @@ ether_input(struct ifnet *ifp, struct ether_header *eh, struct mbuf *m)
 	splx(s);
 }
 
+/*
+ * Process a batch of received Ethernet packets linked through m_nextpkt.
+ * The data of each packet starts after its ether header, which must
+ * directly precede it in the same buffer, as drivers set it up for
+ * ether_input().  The packets are queued under one splimp() and each
+ * software interrupt is scheduled once for the whole batch, which saves
+ * an event send to the network daemon per packet.  The batch should not
+ * exceed the length of the protocol input queues.
+ */
+void
+ether_input_chain(struct ifnet *ifp, struct mbuf *m)
+{
+	struct ifqueue *inq;
+	struct mbuf *next;
+	u_int32_t isrs = 0;
+	int isr;
+	int s;
+
+	s = splimp();
+	for (; m != NULL; m = next) {
+		next = m->m_nextpkt;
+		m->m_nextpkt = NULL;
+		inq = ether_input_classify(ifp,
+		    mtod(m, struct ether_header *) - 1, &m, &isr);
+		if (inq == NULL)
+			continue;
+		isrs |= 1U << isr;
+		if (IF_QFULL(inq)) {
+			IF_DROP(inq);
+			m_freem(m);
+		} else
+			IF_ENQUEUE(inq, m);
+	}
+	splx(s);
+
+	for (isr = 0; isrs != 0; isr++, isrs >>= 1)
+		if (isrs & 1)
+			schednetisr(isr);
+}
+
 /*
  * Convert Ethernet address to printable (loggable) representation.
  * The static buffer isn't a really huge problem since this code
@@ -117,6 +117,8 @@ rtems_bsdnet_initialize_loop(void)
 	    ifp->if_hdrlen = 0;
 	    ifp->if_addrlen = 0;
 	    ifp->if_snd.ifq_maxlen = ifqmaxlen;
+	    ifp->if_capabilities = IFCAP_HWCSUM;
+	    ifp->if_hwassist = CSUM_IP | CSUM_TCP | CSUM_UDP;
 	    if_attach(ifp);
 #if NBPFILTER > 0
 	    bpfattach(ifp, DLT_NULL, sizeof(u_int));
@@ -129,6 +131,7 @@ looutput(struct ifnet *ifp, struct mbuf *m, struct sockaddr *dst,
     struct rtentry *rt)
 {
 	int s, isr;
+	int csum_flags;
 	register struct ifqueue *ifq = 0;
 
 	if ((m->m_flags & M_PKTHDR) == 0)
@@ -163,6 +166,20 @@ looutput(struct ifnet *ifp, struct mbuf *m, struct sockaddr *dst,
 #endif
 	m->m_pkthdr.rcvif = ifp;
 
+	/*
+	 * The packet was generated by this host, so checksums which are still
+	 * pending need not be computed.  Tell the input path that they are
+	 * valid.
+	 */
+	csum_flags = m->m_pkthdr.csum_flags;
+	m->m_pkthdr.csum_flags = 0;
+	if (csum_flags & CSUM_DELAY_IP)
+		m->m_pkthdr.csum_flags |= CSUM_IP_CHECKED | CSUM_IP_VALID;
+	if (csum_flags & CSUM_DELAY_DATA) {
+		m->m_pkthdr.csum_flags |= CSUM_DATA_VALID | CSUM_PSEUDO_HDR;
+		m->m_pkthdr.csum_data = 0xffff;
+	}
+
 	if (rt && rt->rt_flags & (RTF_REJECT|RTF_BLACKHOLE)) {
 		m_freem(m);
 		return (rt->rt_flags & RTF_BLACKHOLE ? 0 :
@@ -275,6 +292,7 @@ loioctl(struct ifnet *ifp, ioctl_command_t cmd, caddr_t data)
 		break;
 
 	case SIOCSIFFLAGS:
+	case SIOCSIFCAP:
 		break;
 
 	default:
@@ -133,6 +133,9 @@ struct ifnet {
 		(struct ifnet *, struct ether_header *, struct mbuf *);
 	struct	ifqueue if_snd;		/* output queue */
 	struct	ifqueue *if_poll_slowq;	/* input queue for slow devices */
+	int	if_capabilities;	/* interface capabilities */
+	int	if_capenable;		/* enabled features */
+	int	if_hwassist;		/* CSUM_* the hardware performs */
 };
 
 typedef void if_init_f_t(void *);
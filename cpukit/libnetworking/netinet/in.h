@@ -431,10 +431,16 @@ struct ip_mreq {
 #ifdef _KERNEL
 
 struct ifnet; struct mbuf;	/* forward declarations for Standard C */
+struct socket;
 
 int	 in_broadcast(struct in_addr, struct ifnet *);
 int	 in_canforward(struct in_addr);
 int	 in_cksum(struct mbuf *, int);
+u_short	 in_cksum_add(u_short, u_short, int);
+u_short	 in_cksum_copy(const void *, void *, int);
+u_short	 in_cksum_data(const void *, int);
+u_short	 in_pseudo(u_int32_t, u_int32_t, u_int32_t);
+int	 in_pcbcksumcopy(struct socket *);
 int	 in_localaddr(struct in_addr);
 char 	*inet_ntoa(struct in_addr); /* in libkern */
 
@@ -0,0 +1,200 @@
+/*
+ * Portable Internet checksum of contiguous data
+ *
+ * The data is summed 32 bits at a time into a 64-bit accumulator, so the
+ * carries need not be folded back inside the loops.  The main loop is
+ * unrolled to eight words.  The sums are ones complement sums of the 16-bit
+ * words in memory order, they are correct for both byte orders if stored
+ * back to memory as is.  This file depends only on the C library, so it can
+ * be compiled on the host to test it.
+ *
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+
+u_short	in_cksum_add(u_short, u_short, int);
+u_short	in_cksum_data(const void *, int);
+u_short	in_cksum_copy(const void *, void *, int);
+
+static inline u_short
+in_cksum_fold(uint64_t sum)
+{
+	sum = (sum & 0xffffffff) + (sum >> 32);
+	sum = (sum & 0xffffffff) + (sum >> 32);
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum = (sum & 0xffff) + (sum >> 16);
+	return ((u_short)sum);
+}
+
+/*
+ * Returns the 16-bit word made of the bytes a and b in memory order.
+ */
+static inline u_short
+in_cksum_word(uint8_t a, uint8_t b)
+{
+	union {
+		uint8_t	c[2];
+		u_short	s;
+	} u;
+
+	u.c[0] = a;
+	u.c[1] = b;
+	return (u.s);
+}
+
+static inline u_short
+in_cksum_swap(u_short s)
+{
+	return ((u_short)((s << 8) | (s >> 8)));
+}
+
+/*
+ * Sum of data starting at a 4-byte aligned address.
+ */
+static uint64_t
+in_cksum_aligned(const uint8_t *p, int len)
+{
+	const uint32_t *w = (const uint32_t *)p;
+	uint64_t sum = 0;
+
+	while (len >= 32) {
+		sum += w[0]; sum += w[1]; sum += w[2]; sum += w[3];
+		sum += w[4]; sum += w[5]; sum += w[6]; sum += w[7];
+		w += 8;
+		len -= 32;
+	}
+	while (len >= 4) {
+		sum += *w++;
+		len -= 4;
+	}
+	p = (const uint8_t *)w;
+	if (len >= 2) {
+		sum += *(const u_short *)p;
+		p += 2;
+		len -= 2;
+	}
+	if (len > 0)
+		sum += in_cksum_word(*p, 0);
+	return (sum);
+}
+
+/*
+ * Adds the sum part of data starting at byte offset off to sum.  A part at
+ * an odd offset has its bytes swapped with respect to the 16-bit words of
+ * the whole.
+ */
+u_short
+in_cksum_add(u_short sum, u_short part, int off)
+{
+	uint32_t s;
+
+	if (off & 1)
+		part = in_cksum_swap(part);
+	s = (uint32_t)sum + part;
+	s = (s & 0xffff) + (s >> 16);
+	return ((u_short)s);
+}
+
+/*
+ * Returns the ones complement sum of the data, folded to 16 bits and not
+ * complemented.  The data may start at any address.
+ */
+u_short
+in_cksum_data(const void *buf, int len)
+{
+	const uint8_t *p = buf;
+	uint64_t sum = 0;
+	int odd;
+
+	if (len <= 0)
+		return (0);
+
+	/*
+	 * Sum from the next even address.  The words are then shifted by
+	 * one byte, with a leading zero byte this is the byte swapped sum.
+	 */
+	odd = (uintptr_t)p & 1;
+	if (odd) {
+		sum = in_cksum_word(0, *p);
+		++p;
+		--len;
+	}
+	if (((uintptr_t)p & 2) && len >= 2) {
+		sum += *(const u_short *)p;
+		p += 2;
+		len -= 2;
+	}
+	sum += in_cksum_aligned(p, len);
+
+	if (odd)
+		return (in_cksum_swap(in_cksum_fold(sum)));
+	return (in_cksum_fold(sum));
+}
+
+/*
+ * Copies the data from src to dst and returns the sum of it like
+ * in_cksum_data().  If the buffers have the same alignment, the data is
+ * summed while it is copied.  Otherwise, it is summed after the copy
+ * while it is still in the cache.
+ */
+u_short
+in_cksum_copy(const void *src, void *dst, int len)
+{
+	const uint8_t *s = src;
+	uint8_t *d = dst;
+	const uint32_t *sw;
+	uint32_t *dw;
+	uint64_t sum = 0;
+	u_short head;
+	int n;
+
+	if (len < 64 || (((uintptr_t)s ^ (uintptr_t)d) & 3) != 0) {
+		memcpy(d, s, (size_t)len);
+		return (in_cksum_data(d, len));
+	}
+
+	n = (int)(-(uintptr_t)s & 3);
+	memcpy(d, s, (size_t)n);
+	head = in_cksum_data(d, n);
+	s += n;
+	d += n;
+	len -= n;
+
+	sw = (const uint32_t *)s;
+	dw = (uint32_t *)d;
+	while (len >= 32) {
+		uint32_t w0 = sw[0], w1 = sw[1], w2 = sw[2], w3 = sw[3];
+		uint32_t w4 = sw[4], w5 = sw[5], w6 = sw[6], w7 = sw[7];
+
+		dw[0] = w0; dw[1] = w1; dw[2] = w2; dw[3] = w3;
+		dw[4] = w4; dw[5] = w5; dw[6] = w6; dw[7] = w7;
+		sum += w0; sum += w1; sum += w2; sum += w3;
+		sum += w4; sum += w5; sum += w6; sum += w7;
+		sw += 8;
+		dw += 8;
+		len -= 32;
+	}
+	while (len >= 4) {
+		uint32_t w0 = *sw++;
+
+		*dw++ = w0;
+		sum += w0;
+		len -= 4;
+	}
+	d = (uint8_t *)dw;
+	memcpy(d, sw, (size_t)len);
+	sum += in_cksum_aligned(d, len);
+
+	return (in_cksum_add(head, in_cksum_fold(sum), n));
+}
@@ -387,6 +387,31 @@ in_pcbladdr(struct inpcb *inp, struct mbuf *nam, struct sockaddr_in **plocal_sin
 	return(0);
 }
 
+/*
+ * Return true, if sosend() should sum the data of the socket while it is
+ * copied in.  This is the case unless the interface of the cached route
+ * checksums the protocol, see also tcp_csum_enabled().  Without a cached
+ * route the checksum is done in software.
+ */
+int
+in_pcbcksumcopy(struct socket *so)
+{
+	struct inpcb *inp = sotoinpcb(so);
+	struct rtentry *rt;
+	struct ifnet *ifp;
+	int csum;
+
+	if (inp == NULL)
+		return (0);
+	rt = inp->inp_route.ro_rt;
+	if (rt == NULL || (rt->rt_flags & RTF_UP) == 0)
+		return (1);
+	csum = so->so_proto->pr_protocol == IPPROTO_UDP ? CSUM_UDP : CSUM_TCP;
+	ifp = rt->rt_ifp;
+	return ((ifp->if_capenable & IFCAP_TXCSUM) == 0 ||
+	    (ifp->if_hwassist & csum) == 0);
+}
+
 /*
  * Outer subroutine:
  * Connect from a socket to a specified address.
@@ -450,7 +475,10 @@ in_pcbdetach(struct inpcb *inp)
 	ip_freemoptions(inp->inp_moptions);
 	s = splnet();
 	LIST_REMOVE(inp, inp_hash);
+	if (inp->inp_portlist.le_prev != NULL)
+		LIST_REMOVE(inp, inp_portlist);
 	LIST_REMOVE(inp, inp_list);
+	ipi->ipi_count--;
 	splx(s);
 	FREE(inp, M_PCB);
 }
@@ -606,7 +634,16 @@ in_pcblookup(struct inpcbinfo *pcbinfo,
 
 	s = splnet();
 
-	for (inp = pcbinfo->listhead->lh_first; inp != NULL; inp = inp->inp_list.le_next) {
+	/*
+	 * All PCBs bound to the local port are on its port hash chain.
+	 */
+	if (lport != 0)
+		inp = pcbinfo->porthashbase[INP_PCBPORTHASH(lport,
+		    pcbinfo->hashmask)].lh_first;
+	else
+		inp = pcbinfo->listhead->lh_first;
+	for (; inp != NULL; inp = lport != 0 ?
+	    inp->inp_portlist.le_next : inp->inp_list.le_next) {
 		if (inp->inp_lport != lport)
 			continue;
 		wildcard = 0;
@@ -655,14 +692,17 @@ in_pcblookuphash(struct inpcbinfo *pcbinfo,
 	struct inpcbhead *head;
 	register struct inpcb *inp;
 	u_short fport = fport_arg, lport = lport_arg;
+	u_long steps = 0;
 	int s;
 
 	s = splnet();
+	++pcbinfo->ipi_lookups;
 	/*
 	 * First look for an exact match.
 	 */
 	head = &pcbinfo->hashbase[INP_PCBHASH(faddr.s_addr, lport, fport, pcbinfo->hashmask)];
 	for (inp = head->lh_first; inp != NULL; inp = inp->inp_hash.le_next) {
+		++steps;
 		if (inp->inp_faddr.s_addr == faddr.s_addr &&
 		    inp->inp_laddr.s_addr == laddr.s_addr &&
 		    inp->inp_fport == fport &&
@@ -672,10 +712,10 @@ in_pcblookuphash(struct inpcbinfo *pcbinfo,
 	if (wildcard) {
 		struct inpcb *local_wild = NULL;
 
-		head = &pcbinfo->hashbase[INP_PCBHASH(INADDR_ANY, lport, 0, pcbinfo->hashmask)];
+		head = &pcbinfo->wildhashbase[INP_PCBPORTHASH(lport, pcbinfo->hashmask)];
 		for (inp = head->lh_first; inp != NULL; inp = inp->inp_hash.le_next) {
-			if (inp->inp_faddr.s_addr == INADDR_ANY &&
-			    inp->inp_fport == 0 && inp->inp_lport == lport) {
+			++steps;
+			if (inp->inp_lport == lport) {
 				if (inp->inp_laddr.s_addr == laddr.s_addr)
 					goto found;
 				else if (inp->inp_laddr.s_addr == INADDR_ANY)
@@ -687,10 +727,12 @@ in_pcblookuphash(struct inpcbinfo *pcbinfo,
 			goto found;
 		}
 	}
+	pcbinfo->ipi_lookupsteps += steps;
 	splx(s);
 	return (NULL);
 
 found:
+	pcbinfo->ipi_lookupsteps += steps;
 	/*
 	 * Move PCB to head of this hash chain so that it can be
 	 * found more quickly in the future.
@@ -706,32 +748,126 @@ found:
 }
 
 /*
- * Insert PCB into hash chain. Must be called at splnet.
+ * Return the chain of the PCB in the connection or wildcard hash table.
+ */
+static struct inpcbhead *
+in_pcbhashhead(struct inpcbinfo *pcbinfo, struct inpcb *inp)
+{
+	if (inp->inp_faddr.s_addr != INADDR_ANY)
+		return (&pcbinfo->hashbase[INP_PCBHASH(inp->inp_faddr.s_addr,
+		    inp->inp_lport, inp->inp_fport, pcbinfo->hashmask)]);
+	return (&pcbinfo->wildhashbase[INP_PCBPORTHASH(inp->inp_lport,
+	    pcbinfo->hashmask)]);
+}
+
+/*
+ * Insert PCB into the port hash chain once it is bound to a local port.
+ * Must be called at splnet.
  */
 static void
-in_pcbinshash(struct inpcb *inp)
+in_pcbinsporthash(struct inpcb *inp)
 {
-	struct inpcbhead *head;
+	struct inpcbinfo *pcbinfo = inp->inp_pcbinfo;
 
-	head = &inp->inp_pcbinfo->hashbase[INP_PCBHASH(inp->inp_faddr.s_addr,
-		 inp->inp_lport, inp->inp_fport, inp->inp_pcbinfo->hashmask)];
+	if (inp->inp_lport != 0 && inp->inp_portlist.le_prev == NULL)
+		LIST_INSERT_HEAD(&pcbinfo->porthashbase[INP_PCBPORTHASH(
+		    inp->inp_lport, pcbinfo->hashmask)], inp, inp_portlist);
+}
 
-	LIST_INSERT_HEAD(head, inp, inp_hash);
+/*
+ * Insert PCB into hash chain. Must be called at splnet.
+ */
+static void
+in_pcbinshash(struct inpcb *inp)
+{
+	LIST_INSERT_HEAD(in_pcbhashhead(inp->inp_pcbinfo, inp), inp, inp_hash);
+	in_pcbinsporthash(inp);
 }
 
 void
 in_pcbrehash(struct inpcb *inp)
 {
-	struct inpcbhead *head;
 	int s;
 
 	s = splnet();
 	LIST_REMOVE(inp, inp_hash);
+	in_pcbinshash(inp);
+	splx(s);
+}
+
+/*
+ * Allocate the connection, wildcard and port hash tables in one block.
+ * The number of chains is the largest power of two not above elements.
+ */
+static struct inpcbhead *
+in_pcbhashalloc(u_long elements, u_long *hashmask, int how)
+{
+	struct inpcbhead *base;
+	u_long hashsize;
+	u_long i;
+
+	if (elements < 1)
+		elements = 1;
+	if (elements > INP_HASHMAX)
+		elements = INP_HASHMAX;
+	for (hashsize = 1; hashsize <= elements; hashsize <<= 1)
+		continue;
+	hashsize >>= 1;
+	base = malloc(3 * hashsize * sizeof(*base), M_PCB, how);
+	if (base == NULL)
+		return (NULL);
+	for (i = 0; i < 3 * hashsize; i++)
+		LIST_INIT(&base[i]);
+	*hashmask = hashsize - 1;
+	return (base);
+}
 
-	head = &inp->inp_pcbinfo->hashbase[INP_PCBHASH(inp->inp_faddr.s_addr,
-		inp->inp_lport, inp->inp_fport, inp->inp_pcbinfo->hashmask)];
+static void
+in_pcbhashset(struct inpcbinfo *pcbinfo, struct inpcbhead *base,
+	u_long hashmask)
+{
+	pcbinfo->hashbase = base;
+	pcbinfo->wildhashbase = base + hashmask + 1;
+	pcbinfo->porthashbase = base + 2 * (hashmask + 1);
+	pcbinfo->hashmask = hashmask;
+}
 
-	LIST_INSERT_HEAD(head, inp, inp_hash);
-	inp->inp_pcbinfo->ipi_count--;
+/*
+ * Initialize the hash tables of a PCB list.
+ */
+void
+in_pcbhashinit(struct inpcbinfo *pcbinfo, u_long elements)
+{
+	struct inpcbhead *base;
+	u_long hashmask;
+
+	base = in_pcbhashalloc(elements, &hashmask, M_WAITOK);
+	in_pcbhashset(pcbinfo, base, hashmask);
+}
+
+/*
+ * Move the PCBs of a list to new hash tables with about elements chains.
+ */
+int
+in_pcbhashresize(struct inpcbinfo *pcbinfo, u_long elements)
+{
+	struct inpcbhead *base, *old;
+	struct inpcb *inp;
+	u_long hashmask;
+	int s;
+
+	base = in_pcbhashalloc(elements, &hashmask, M_NOWAIT);
+	if (base == NULL)
+		return (ENOMEM);
+	s = splnet();
+	old = pcbinfo->hashbase;
+	in_pcbhashset(pcbinfo, base, hashmask);
+	for (inp = pcbinfo->listhead->lh_first; inp != NULL;
+	    inp = inp->inp_list.le_next) {
+		inp->inp_portlist.le_prev = NULL;
+		in_pcbinshash(inp);
+	}
 	splx(s);
+	free(old, M_PCB);
+	return (0);
 }
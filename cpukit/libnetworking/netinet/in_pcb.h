@@ -52,6 +52,7 @@ typedef	u_int64_t inp_gen_t;
 struct inpcb {
 	LIST_ENTRY(inpcb) inp_hash; /* hash list */
 	LIST_ENTRY(inpcb) inp_list; /* list for all PCBs of this proto */
+	LIST_ENTRY(inpcb) inp_portlist; /* local port hash list */
 	struct	inpcbinfo *inp_pcbinfo;	/* PCB list info */
 	struct	in_addr inp_faddr;	/* foreign host table entry */
 	struct	in_addr inp_laddr;	/* local host table entry */
@@ -98,19 +99,37 @@ struct	xinpgen {
 };
 #endif /* _SYS_SOCKETVAR_H_ */
 
+/*
+ * The PCBs with a foreign address are in the connection hash table
+ * (hashbase), the others are in the wildcard hash table (wildhashbase)
+ * keyed by the local port.  All PCBs bound to a local port are also in
+ * the port hash table (porthashbase).  The three tables have the same
+ * number of chains and are allocated together by in_pcbhashinit().
+ */
 struct inpcbinfo {		/* XXX documentation, prefixes */
 	struct	inpcbhead *listhead;
 	struct	inpcbhead *hashbase;
+	struct	inpcbhead *wildhashbase;
+	struct	inpcbhead *porthashbase;
 	unsigned long hashmask;
 	unsigned short lastport;
 	unsigned short lastlow;
 	unsigned short lasthi;
 	u_int	ipi_count;	/* number of pcbs in this list */
 	u_int64_t ipi_gencnt;	/* current generation count */
+	u_long	ipi_lookups;	/* in_pcblookuphash() calls */
+	u_long	ipi_lookupsteps; /* PCBs compared by these calls */
 };
 
+/* Largest number of chains of a PCB hash table */
+#define	INP_HASHMAX		65536
+
 #define INP_PCBHASH(faddr, lport, fport, mask) \
-	(((faddr) ^ ((faddr) >> 16) ^ (lport) ^ (fport)) & (mask))
+	(((((faddr) ^ ((u_int32_t)(lport) << 16) ^ (fport)) * 0x9e3779b1U) \
+	    >> 16) & (mask))
+
+#define INP_PCBPORTHASH(lport, mask) \
+	(ntohs(lport) & (mask))
 
 /* flags in inp_flags: */
 #define	INP_RECVOPTS		0x01	/* receive incoming IP options */
@@ -134,6 +153,8 @@ int	in_pcbbind(struct inpcb *, struct mbuf *);
 int	in_pcbconnect(struct inpcb *, struct mbuf *);
 void	in_pcbdetach(struct inpcb *);
 void	in_pcbdisconnect(struct inpcb *);
+void	in_pcbhashinit(struct inpcbinfo *, u_long);
+int	in_pcbhashresize(struct inpcbinfo *, u_long);
 int	in_pcbladdr(struct inpcb *, struct mbuf *,
 	    struct sockaddr_in **);
 struct inpcb *
@@ -109,7 +109,7 @@ div_init(void)
 	 * to allocate a one entry hash list than it is to check all
 	 * over the place for hashbase == NULL.
 	 */
-	divcbinfo.hashbase = hashinit(1, M_PCB, &divcbinfo.hashmask);
+	in_pcbhashinit(&divcbinfo, 1);
 }
 
 /*
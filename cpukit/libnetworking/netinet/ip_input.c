@@ -295,7 +295,9 @@ ip_input(struct mbuf *m)
 		}
 		ip = mtod(m, struct ip *);
 	}
-	if (hlen == sizeof(struct ip)) {
+	if (m->m_pkthdr.csum_flags & CSUM_IP_CHECKED) {
+		sum = !(m->m_pkthdr.csum_flags & CSUM_IP_VALID);
+	} else if (hlen == sizeof(struct ip)) {
 		sum = in_cksum_hdr(ip);
 	} else {
 		sum = in_cksum(m, hlen);
@@ -490,6 +492,10 @@ ours:
 			}
 			ip = mtod(m, struct ip *);
 		}
+		/*
+		 * A data checksum of the interface covers only this fragment.
+		 */
+		m->m_pkthdr.csum_flags &= ~(CSUM_DATA_VALID | CSUM_PSEUDO_HDR);
 		sum = IPREASS_HASH(ip->ip_src.s_addr, ip->ip_id);
 		/*
 		 * Look for queue of fragments
@@ -98,6 +98,7 @@ ip_output(struct mbuf *m0, struct mbuf *opt, struct route *ro, int flags,
 	struct sockaddr_in *dst;
 	struct in_ifaddr *ia;
 	int isbroadcast;
+	int sw_csum, hwassist;
 
 #ifdef	DIAGNOSTIC
 	if ((m->m_flags & M_PKTHDR) == 0)
@@ -383,22 +384,52 @@ sendit:
 	}
 #endif /* COMPAT_IPFW */
 
+	/*
+	 * Leave the checksums enabled for offload to the interface, the
+	 * others are computed here.  Segmentation offload is only possible
+	 * together with the TCP checksum offload.
+	 */
+	hwassist = 0;
+	if (ifp->if_capenable & IFCAP_TXCSUM) {
+		hwassist = ifp->if_hwassist & (CSUM_DELAY_IP | CSUM_DELAY_DATA);
+		if ((ifp->if_capenable & IFCAP_TSO4) && (hwassist & CSUM_TCP))
+			hwassist |= ifp->if_hwassist & CSUM_TSO;
+	}
+	sw_csum = m->m_pkthdr.csum_flags | CSUM_DELAY_IP;
+	m->m_pkthdr.csum_flags = sw_csum & hwassist;
+	sw_csum &= ~hwassist;
+	if (sw_csum & CSUM_TSO) {
+		/*
+		 * The route changed to an interface without segmentation
+		 * offload.  TCP will send smaller segments.
+		 */
+		error = EMSGSIZE;
+		goto bad;
+	}
+	if (sw_csum & CSUM_DELAY_DATA) {
+		in_delayed_cksum(m);
+		sw_csum &= ~CSUM_DELAY_DATA;
+	}
+
 	/*
 	 * If small enough for interface, or the interface will take
 	 * care of the fragmentation for us, we can just send directly.
 	 */
-	if ((u_short)ip->ip_len <= ifp->if_mtu) {
+	if ((u_short)ip->ip_len <= ifp->if_mtu ||
+	    (m->m_pkthdr.csum_flags & CSUM_TSO) != 0) {
 		ip->ip_len = htons(ip->ip_len);
 		ip->ip_off = htons(ip->ip_off);
 		ip->ip_sum = 0;
+		if (sw_csum & CSUM_DELAY_IP) {
 #ifdef _IP_VHL
-		if (ip->ip_vhl == IP_VHL_BORING) {
+			if (ip->ip_vhl == IP_VHL_BORING) {
 #else
-		if ((ip->ip_hl == 5) && (ip->ip_v = IPVERSION)) {
+			if ((ip->ip_hl == 5) && (ip->ip_v = IPVERSION)) {
 #endif
-			ip->ip_sum = in_cksum_hdr(ip);
-		} else {
-			ip->ip_sum = in_cksum(m, hlen);
+				ip->ip_sum = in_cksum_hdr(ip);
+			} else {
+				ip->ip_sum = in_cksum(m, hlen);
+			}
 		}
 		error = (*ifp->if_output)(ifp, m,
 				(struct sockaddr *)dst, ro->ro_rt);
@@ -431,6 +462,14 @@ sendit:
 		goto bad;
 	}
 
+	/*
+	 * The interface cannot compute the data checksum of fragments.
+	 */
+	if (m->m_pkthdr.csum_flags & CSUM_DELAY_DATA) {
+		in_delayed_cksum(m);
+		m->m_pkthdr.csum_flags &= ~CSUM_DELAY_DATA;
+	}
+
     {
 	int mhlen, firstlen = len;
 	struct mbuf **mnext = &m->m_nextpkt;
@@ -479,16 +518,19 @@ sendit:
 		}
 		m->m_pkthdr.len = mhlen + len;
 		m->m_pkthdr.rcvif = NULL;
+		m->m_pkthdr.csum_flags = m0->m_pkthdr.csum_flags;
 		mhip->ip_off = htons(mhip->ip_off);
 		mhip->ip_sum = 0;
+		if (sw_csum & CSUM_DELAY_IP) {
 #ifdef _IP_VHL
-		if (mhip->ip_vhl == IP_VHL_BORING) {
+			if (mhip->ip_vhl == IP_VHL_BORING) {
 #else
-		if ((mhip->ip_hl == 5) && (mhip->ip_v == IPVERSION) ) {
+			if ((mhip->ip_hl == 5) && (mhip->ip_v == IPVERSION) ) {
 #endif
-			mhip->ip_sum = in_cksum_hdr(mhip);
-		} else {
-			mhip->ip_sum = in_cksum(m, mhlen);
+				mhip->ip_sum = in_cksum_hdr(mhip);
+			} else {
+				mhip->ip_sum = in_cksum(m, mhlen);
+			}
 		}
 		*mnext = m;
 		mnext = &m->m_nextpkt;
@@ -505,14 +547,16 @@ sendit:
 	ip->ip_off |= IP_MF;
 	ip->ip_off = htons(ip->ip_off);
 	ip->ip_sum = 0;
+	if (sw_csum & CSUM_DELAY_IP) {
 #ifdef _IP_VHL
-	if (ip->ip_vhl == IP_VHL_BORING) {
+		if (ip->ip_vhl == IP_VHL_BORING) {
 #else
-	if ((ip->ip_hl == 5) && (ip->ip_v == IPVERSION) ) {
+		if ((ip->ip_hl == 5) && (ip->ip_v == IPVERSION) ) {
 #endif
-		ip->ip_sum = in_cksum_hdr(ip);
-	} else {
-		ip->ip_sum = in_cksum(m, hlen);
+			ip->ip_sum = in_cksum_hdr(ip);
+		} else {
+			ip->ip_sum = in_cksum(m, hlen);
+		}
 	}
 sendorfree:
 	for (m = m0; m; m = m0) {
@@ -535,6 +579,38 @@ bad:
 	goto done;
 }
 
+/*
+ * Compute the data checksum which a protocol delayed in the hope that the
+ * interface computes it, see CSUM_DELAY_DATA.  The checksum field contains
+ * the pseudo header sum.  The IP length is in host byte order.
+ */
+void
+in_delayed_cksum(struct mbuf *m)
+{
+	struct ip *ip;
+	u_short csum;
+	int offset;
+
+	ip = mtod(m, struct ip *);
+#ifdef _IP_VHL
+	offset = IP_VHL_HL(ip->ip_vhl) << 2;
+#else
+	offset = ip->ip_hl << 2;
+#endif
+	m->m_data += offset;
+	m->m_len -= offset;
+	csum = (u_short)in_cksum(m, (u_short)ip->ip_len - offset);
+	m->m_data -= offset;
+	m->m_len += offset;
+	if (csum == 0 && (m->m_pkthdr.csum_flags & CSUM_UDP) != 0)
+		csum = 0xffff;
+	offset += m->m_pkthdr.csum_data;
+	if (offset + (int)sizeof(csum) > m->m_len)
+		m_copyback(m, offset, sizeof(csum), (caddr_t)&csum);
+	else
+		*(u_short *)(mtod(m, caddr_t) + offset) = csum;
+}
+
 /*
  * Insert IP options into preformed packet.
  * Adjust IP destination as required for IP source routing,
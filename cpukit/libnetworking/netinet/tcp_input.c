@@ -82,7 +82,6 @@ static int log_in_vain = 0;
 SYSCTL_INT(_net_inet_tcp, OID_AUTO, log_in_vain, CTLFLAG_RW, 
 	&log_in_vain, 0, "");
 
-u_long	tcp_now;
 struct inpcbhead tcb;
 struct inpcbinfo tcbinfo;
 
@@ -113,7 +112,7 @@ static void	 tcp_xmit_timer(struct tcpcb *, int);
 		if (ti->ti_flags & TH_PUSH) \
 			tp->t_flags |= TF_ACKNOW; \
 		else \
-			tp->t_flags |= TF_DELACK; \
+			TCP_SET_DELACK(tp); \
 		(tp)->rcv_nxt += (ti)->ti_len; \
 		flags = (ti)->ti_flags & TH_FIN; \
 		tcpstat.tcps_rcvpack++;\
@@ -130,7 +129,7 @@ static void	 tcp_xmit_timer(struct tcpcb *, int);
 	if ((ti)->ti_seq == (tp)->rcv_nxt && \
 	    (tp)->seg_next == (struct tcpiphdr *)(tp) && \
 	    (tp)->t_state == TCPS_ESTABLISHED) { \
-		tp->t_flags |= TF_DELACK; \
+		TCP_SET_DELACK(tp); \
 		(tp)->rcv_nxt += (ti)->ti_len; \
 		flags = (ti)->ti_flags & TH_FIN; \
 		tcpstat.tcps_rcvpack++;\
@@ -311,7 +310,8 @@ tcp_input(struct mbuf *m, int iphlen)
 	}
 
 	/*
-	 * Checksum extended TCP header and data.
+	 * Checksum extended TCP header and data.  Use the sum of the
+	 * interface if available.
 	 */
 	tlen = ((struct ip *)ti)->ip_len;
 	len = sizeof (struct ip) + tlen;
@@ -319,7 +319,17 @@ tcp_input(struct mbuf *m, int iphlen)
 	ti->ti_x1 = 0;
 	ti->ti_len = (u_short)tlen;
 	HTONS(ti->ti_len);
-	ti->ti_sum = in_cksum(m, len);
+	if (m->m_pkthdr.csum_flags & CSUM_DATA_VALID) {
+		if (m->m_pkthdr.csum_flags & CSUM_PSEUDO_HDR)
+			ti->ti_sum = m->m_pkthdr.csum_data;
+		else
+			ti->ti_sum = in_pseudo(ti->ti_src.s_addr,
+			    ti->ti_dst.s_addr, htonl((u_short)tlen +
+			    m->m_pkthdr.csum_data + IPPROTO_TCP));
+		ti->ti_sum ^= 0xffff;
+	} else {
+		ti->ti_sum = in_cksum(m, len);
+	}
 	if (ti->ti_sum) {
 		tcpstat.tcps_rcvbadsum++;
 		goto drop;
@@ -469,9 +479,9 @@ findpcb:
 	 * Segment received on connection.
 	 * Reset idle time and keep-alive timer.
 	 */
-	tp->t_idle = 0;
+	tp->t_rcvtime = tcp_ticks;
 	if (TCPS_HAVEESTABLISHED(tp->t_state))
-		tp->t_timer[TCPT_KEEP] = tcp_keepidle;
+		TCP_TIMER_ARM(tp, TCPT_KEEP, tcp_keepidle);
 
 	/*
 	 * Process options if not in LISTEN state,
@@ -534,12 +544,13 @@ findpcb:
 				 * this is a pure ack for outstanding data.
 				 */
 				++tcpstat.tcps_predack;
-				if ((to.to_flags & TOF_TS) != 0)
+				if (tp->t_rtt &&
+				    SEQ_GT(ti->ti_ack, tp->t_rtseq))
 					tcp_xmit_timer(tp,
-					    tcp_now - to.to_tsecr + 1);
-				else if (tp->t_rtt &&
-					    SEQ_GT(ti->ti_ack, tp->t_rtseq))
-					tcp_xmit_timer(tp, tp->t_rtt);
+					    tcp_ticks - tp->t_rtttime + 1);
+				else if ((to.to_flags & TOF_TS) != 0)
+					tcp_xmit_timer(tp, TCP_TS_TO_TICKS(
+					    tcp_now - to.to_tsecr) + 1);
 				acked = ti->ti_ack - tp->snd_una;
 				tcpstat.tcps_rcvackpack++;
 				tcpstat.tcps_rcvackbyte += acked;
@@ -557,9 +568,9 @@ findpcb:
 				 * decide between more output or persist.
 				 */
 				if (tp->snd_una == tp->snd_max)
-					tp->t_timer[TCPT_REXMT] = 0;
-				else if (tp->t_timer[TCPT_PERSIST] == 0)
-					tp->t_timer[TCPT_REXMT] = tp->t_rxtcur;
+					TCP_TIMER_DISARM(tp, TCPT_REXMT);
+				else if (!TCP_TIMER_ISARMED(tp, TCPT_PERSIST))
+					TCP_TIMER_ARM(tp, TCPT_REXMT, tp->t_rxtcur);
 
 				if (so->so_snd.sb_flags & SB_NOTIFY)
 					sowwakeup(so);
@@ -594,10 +605,10 @@ findpcb:
 				tp->t_flags |= TF_ACKNOW;
 				tcp_output(tp);
 			} else {
-				tp->t_flags |= TF_DELACK;
+				TCP_SET_DELACK(tp);
 			}
 #else
-			tp->t_flags |= TF_DELACK;
+			TCP_SET_DELACK(tp);
 #endif
 			return;
 		}
@@ -726,9 +737,10 @@ findpcb:
 			 * the other side is slow starting.
 			 */
 			if ((tiflags & TH_FIN) || (ti->ti_len != 0 &&
-			    in_localaddr(inp->inp_faddr)))
-				tp->t_flags |= (TF_DELACK | TF_NEEDSYN);
-			else
+			    in_localaddr(inp->inp_faddr))) {
+				TCP_SET_DELACK(tp);
+				tp->t_flags |= TF_NEEDSYN;
+			} else
 				tp->t_flags |= (TF_ACKNOW | TF_NEEDSYN);
 
 			/*
@@ -739,7 +751,7 @@ findpcb:
 			tp->rcv_adv += min(tp->rcv_wnd, TCP_MAXWIN);
 			tcpstat.tcps_connects++;
 			soisconnected(so);
-			tp->t_timer[TCPT_KEEP] = tcp_keepinit;
+			TCP_TIMER_ARM(tp, TCPT_KEEP, tcp_keepinit);
 			dropsocket = 0;		/* committed to socket */
 			tcpstat.tcps_accepts++;
 			goto trimthenstep6;
@@ -758,7 +770,7 @@ findpcb:
 		 */
 		tp->t_flags |= TF_ACKNOW;
 		tp->t_state = TCPS_SYN_RECEIVED;
-		tp->t_timer[TCPT_KEEP] = tcp_keepinit;
+		TCP_TIMER_ARM(tp, TCPT_KEEP, tcp_keepinit);
 		dropsocket = 0;		/* committed to socket */
 		tcpstat.tcps_accepts++;
 		goto trimthenstep6;
@@ -864,7 +876,7 @@ findpcb:
 			 * ACKNOW will be turned on later.
 			 */
 			if (ti->ti_len != 0)
-				tp->t_flags |= TF_DELACK;
+				TCP_SET_DELACK(tp);
 			else
 				tp->t_flags |= TF_ACKNOW;
 			/*
@@ -879,7 +891,7 @@ findpcb:
 				tiflags &= ~TH_SYN;
 			} else {
 				tp->t_state = TCPS_ESTABLISHED;
-				tp->t_timer[TCPT_KEEP] = tcp_keepidle;
+				TCP_TIMER_ARM(tp, TCPT_KEEP, tcp_keepidle);
 			}
 		} else {
 		/*
@@ -892,7 +904,7 @@ findpcb:
 		 *  If there was no CC option, clear cached CC value.
 		 */
 			tp->t_flags |= TF_ACKNOW;
-			tp->t_timer[TCPT_REXMT] = 0;
+			TCP_TIMER_DISARM(tp, TCPT_REXMT);
 			if (to.to_flags & TOF_CC) {
 				if (taop->tao_cc != 0 &&
 				    CC_GT(to.to_cc, taop->tao_cc)) {
@@ -907,7 +919,7 @@ findpcb:
 						tp->t_flags &= ~TF_NEEDFIN;
 					} else {
 						tp->t_state = TCPS_ESTABLISHED;
-						tp->t_timer[TCPT_KEEP] = tcp_keepidle;
+						TCP_TIMER_ARM(tp, TCPT_KEEP, tcp_keepidle);
 					}
 					tp->t_flags |= TF_NEEDSYN;
 				} else
@@ -966,7 +978,7 @@ trimthenstep6:
 		if ((tiflags & TH_SYN) &&
 		    (to.to_flags & TOF_CC) && tp->cc_recv != 0) {
 			if (tp->t_state == TCPS_TIME_WAIT &&
-					tp->t_duration > TCPTV_MSL)
+					TCP_DURATION(tp) > TCPTV_MSL)
 				goto dropwithreset;
 			if (CC_GT(to.to_cc, tp->cc_recv)) {
 				tp = tcp_close(tp);
@@ -1230,7 +1242,7 @@ trimthenstep6:
 			tp->t_flags &= ~TF_NEEDFIN;
 		} else {
 			tp->t_state = TCPS_ESTABLISHED;
-			tp->t_timer[TCPT_KEEP] = tcp_keepidle;
+			TCP_TIMER_ARM(tp, TCPT_KEEP, tcp_keepidle);
 		}
 		/*
 		 * If segment contains data or ACK, will call tcp_reass()
@@ -1285,7 +1297,7 @@ trimthenstep6:
 				 * to keep a constant cwnd packets in the
 				 * network.
 				 */
-				if (tp->t_timer[TCPT_REXMT] == 0 ||
+				if (!TCP_TIMER_ISARMED(tp, TCPT_REXMT) ||
 				    ti->ti_ack != tp->snd_una)
 					tp->t_dupacks = 0;
 				else if (++tp->t_dupacks == tcprexmtthresh) {
@@ -1297,7 +1309,7 @@ trimthenstep6:
 					if (win < 2)
 						win = 2;
 					tp->snd_ssthresh = win * tp->t_maxseg;
-					tp->t_timer[TCPT_REXMT] = 0;
+					TCP_TIMER_DISARM(tp, TCPT_REXMT);
 					tp->t_rtt = 0;
 					tp->snd_nxt = ti->ti_ack;
 					tp->snd_cwnd = tp->t_maxseg;
@@ -1356,18 +1368,19 @@ process_ACK:
 		tcpstat.tcps_rcvackbyte += acked;
 
 		/*
-		 * If we have a timestamp reply, update smoothed
-		 * round trip time.  If no timestamp is present but
-		 * transmit timer is running and timed sequence
-		 * number was acked, update smoothed round trip time.
+		 * If the transmit timer is running and the timed
+		 * sequence number was acked, update smoothed round trip
+		 * time.  Otherwise use a timestamp reply, which has
+		 * only the resolution of the timestamp clock.
 		 * Since we now have an rtt measurement, cancel the
 		 * timer backoff (cf., Phil Karn's retransmit alg.).
 		 * Recompute the initial retransmit timer.
 		 */
-		if (to.to_flags & TOF_TS)
-			tcp_xmit_timer(tp, tcp_now - to.to_tsecr + 1);
-		else if (tp->t_rtt && SEQ_GT(ti->ti_ack, tp->t_rtseq))
-			tcp_xmit_timer(tp,tp->t_rtt);
+		if (tp->t_rtt && SEQ_GT(ti->ti_ack, tp->t_rtseq))
+			tcp_xmit_timer(tp, tcp_ticks - tp->t_rtttime + 1);
+		else if (to.to_flags & TOF_TS)
+			tcp_xmit_timer(tp,
+			    TCP_TS_TO_TICKS(tcp_now - to.to_tsecr) + 1);
 
 		/*
 		 * If all outstanding data is acked, stop retransmit
@@ -1376,10 +1389,10 @@ process_ACK:
 		 * timer, using current (possibly backed-off) value.
 		 */
 		if (ti->ti_ack == tp->snd_max) {
-			tp->t_timer[TCPT_REXMT] = 0;
+			TCP_TIMER_DISARM(tp, TCPT_REXMT);
 			needoutput = 1;
-		} else if (tp->t_timer[TCPT_PERSIST] == 0)
-			tp->t_timer[TCPT_REXMT] = tp->t_rxtcur;
+		} else if (!TCP_TIMER_ISARMED(tp, TCPT_PERSIST))
+			TCP_TIMER_ARM(tp, TCPT_REXMT, tp->t_rxtcur);
 
 		/*
 		 * If no data (only SYN) was ACK'd,
@@ -1436,7 +1449,7 @@ process_ACK:
 				 */
 				if (so->so_state & SS_CANTRCVMORE) {
 					soisdisconnected(so);
-					tp->t_timer[TCPT_2MSL] = tcp_maxidle;
+					TCP_TIMER_ARM(tp, TCPT_2MSL, tcp_maxidle);
 				}
 				tp->t_state = TCPS_FIN_WAIT_2;
 			}
@@ -1454,11 +1467,11 @@ process_ACK:
 				tcp_canceltimers(tp);
 				/* Shorten TIME_WAIT [RFC-1644, p.28] */
 				if (tp->cc_recv != 0 &&
-				    tp->t_duration < TCPTV_MSL)
-					tp->t_timer[TCPT_2MSL] =
-					    tp->t_rxtcur * TCPTV_TWTRUNC;
+				    TCP_DURATION(tp) < TCPTV_MSL)
+					TCP_TIMER_ARM(tp, TCPT_2MSL,
+					    tp->t_rxtcur * TCPTV_TWTRUNC);
 				else
-					tp->t_timer[TCPT_2MSL] = 2 * TCPTV_MSL;
+					TCP_TIMER_ARM(tp, TCPT_2MSL, 2 * TCPTV_MSL);
 				soisdisconnected(so);
 			}
 			break;
@@ -1482,7 +1495,7 @@ process_ACK:
 		 * it and restart the finack timer.
 		 */
 		case TCPS_TIME_WAIT:
-			tp->t_timer[TCPT_2MSL] = 2 * TCPTV_MSL;
+			TCP_TIMER_ARM(tp, TCPT_2MSL, 2 * TCPTV_MSL);
 			goto dropafterack;
 		}
 	}
@@ -1606,7 +1619,7 @@ dodata:							/* XXX */
 			 *  more input can be expected, send ACK now.
 			 */
 			if (tp->t_flags & TF_NEEDSYN)
-				tp->t_flags |= TF_DELACK;
+				TCP_SET_DELACK(tp);
 			else
 				tp->t_flags |= TF_ACKNOW;
 			tp->rcv_nxt++;
@@ -1640,14 +1653,14 @@ dodata:							/* XXX */
 			tcp_canceltimers(tp);
 			/* Shorten TIME_WAIT [RFC-1644, p.28] */
 			if (tp->cc_recv != 0 &&
-			    tp->t_duration < TCPTV_MSL) {
-				tp->t_timer[TCPT_2MSL] =
-				    tp->t_rxtcur * TCPTV_TWTRUNC;
+			    TCP_DURATION(tp) < TCPTV_MSL) {
+				TCP_TIMER_ARM(tp, TCPT_2MSL,
+				    tp->t_rxtcur * TCPTV_TWTRUNC);
 				/* For transaction client, force ACK now. */
 				tp->t_flags |= TF_ACKNOW;
 			}
 			else
-				tp->t_timer[TCPT_2MSL] = 2 * TCPTV_MSL;
+				TCP_TIMER_ARM(tp, TCPT_2MSL, 2 * TCPTV_MSL);
 			soisdisconnected(so);
 			break;
 
@@ -1655,7 +1668,7 @@ dodata:							/* XXX */
 		 * In TIME_WAIT state restart the 2 MSL time_wait timer.
 		 */
 		case TCPS_TIME_WAIT:
-			tp->t_timer[TCPT_2MSL] = 2 * TCPTV_MSL;
+			TCP_TIMER_ARM(tp, TCPT_2MSL, 2 * TCPTV_MSL);
 			break;
 		}
 	}
@@ -2016,7 +2029,7 @@ tcp_mss(struct tcpcb *tp, int offer)
 	/*
 	 * While we're here, check if there's an initial rtt
 	 * or rttvar.  Convert from the route-table units
-	 * to scaled multiples of the slow timeout timer.
+	 * to scaled multiples of the TCP_HZ clock.
 	 */
 	if (tp->t_srtt == 0 && (rtt = rt->rt_rmx.rmx_rtt)) {
 		/*
@@ -2024,12 +2037,12 @@ tcp_mss(struct tcpcb *tp, int offer)
 		 * is also a minimum value; this is subject to time.
 		 */
 		if (rt->rt_rmx.rmx_locks & RTV_RTT)
-			tp->t_rttmin = rtt / (RTM_RTTUNIT / PR_SLOWHZ);
-		tp->t_srtt = rtt / (RTM_RTTUNIT / (PR_SLOWHZ * TCP_RTT_SCALE));
+			tp->t_rttmin = max(TCP_RTM_TO_RTT(rtt, 1), 2);
+		tp->t_srtt = TCP_RTM_TO_RTT(rtt, TCP_RTT_SCALE);
 		tcpstat.tcps_usedrtt++;
 		if (rt->rt_rmx.rmx_rttvar) {
-			tp->t_rttvar = rt->rt_rmx.rmx_rttvar /
-			    (RTM_RTTUNIT / (PR_SLOWHZ * TCP_RTTVAR_SCALE));
+			tp->t_rttvar = TCP_RTM_TO_RTT(rt->rt_rmx.rmx_rttvar,
+			    TCP_RTTVAR_SCALE);
 			tcpstat.tcps_usedrttvar++;
 		} else {
 			/* default variation is +- 1 rtt */
@@ -44,7 +44,9 @@
 #include <sys/socket.h>
 #include <sys/socketvar.h>
 #include <errno.h>
+#include <stddef.h>
 
+#include <net/if.h>
 #include <net/route.h>
 
 #include <netinet/in.h>
@@ -67,6 +69,46 @@
 extern struct mbuf *m_copypack();
 #endif
 
+/*
+ * Largest amount of data sent in one segment handed to an interface with
+ * TCP segmentation offload.
+ */
+#define	TCP_TSO_MAXLEN \
+	(IP_MAXPACKET - sizeof (struct tcpiphdr) - TCP_MAXOLEN)
+
+/*
+ * Return true, if the interface of the connection route does TCP
+ * segmentation offload.
+ */
+static int
+tcp_tso_enabled(struct tcpcb *tp)
+{
+	struct rtentry *rt = tp->t_inpcb->inp_route.ro_rt;
+	struct ifnet *ifp;
+
+	if (rt == NULL || (rt->rt_flags & RTF_UP) == 0)
+		return (0);
+	ifp = rt->rt_ifp;
+	return ((ifp->if_capenable & (IFCAP_TXCSUM | IFCAP_TSO4)) ==
+	    (IFCAP_TXCSUM | IFCAP_TSO4) &&
+	    (ifp->if_hwassist & (CSUM_TCP | CSUM_TSO)) == (CSUM_TCP | CSUM_TSO));
+}
+
+/*
+ * Return true, if the interface of the connection route checksums TCP.
+ */
+static int
+tcp_csum_enabled(struct tcpcb *tp)
+{
+	struct rtentry *rt = tp->t_inpcb->inp_route.ro_rt;
+	struct ifnet *ifp;
+
+	if (rt == NULL || (rt->rt_flags & RTF_UP) == 0)
+		return (0);
+	ifp = rt->rt_ifp;
+	return ((ifp->if_capenable & IFCAP_TXCSUM) != 0 &&
+	    (ifp->if_hwassist & CSUM_TCP) != 0);
+}
 
 /*
  * Tcp output routine: figure out what should be sent and send it.
@@ -82,7 +124,9 @@ tcp_output(
 	register struct tcpiphdr *ti;
 	u_char opt[TCP_MAXOLEN];
 	unsigned optlen, hdrlen;
-	int idle, sendalot;
+	u_short tso_segsz = 0;
+	u_short dsum = 0;
+	int idle, sendalot, tso, swcsum = 0;
 	struct rmxp_tao *taop;
 	struct rmxp_tao tao_noncached;
 
@@ -93,7 +137,7 @@ tcp_output(
 	 * to send, then transmit; otherwise, investigate further.
 	 */
 	idle = (tp->snd_max == tp->snd_una);
-	if (idle && tp->t_idle >= tp->t_rxtcur)
+	if (idle && TCP_IDLE(tp) >= tp->t_rxtcur)
 		/*
 		 * We have been idle for "a while" and no acks are
 		 * expected to clock out any data we send --
@@ -102,6 +146,7 @@ tcp_output(
 		tp->snd_cwnd = tp->t_maxseg;
 again:
 	sendalot = 0;
+	tso = 0;
 	off = tp->snd_nxt - tp->snd_una;
 	win = min(tp->snd_wnd, tp->snd_cwnd);
 
@@ -143,7 +188,7 @@ again:
 				flags &= ~TH_FIN;
 			win = 1;
 		} else {
-			tp->t_timer[TCPT_PERSIST] = 0;
+			TCP_TIMER_DISARM(tp, TCPT_PERSIST);
 			tp->t_rxtshift = 0;
 		}
 	}
@@ -194,16 +239,38 @@ again:
 		 */
 		len = 0;
 		if (win == 0) {
-			tp->t_timer[TCPT_REXMT] = 0;
+			TCP_TIMER_DISARM(tp, TCPT_REXMT);
 			tp->t_rxtshift = 0;
 			tp->snd_nxt = tp->snd_una;
-			if (tp->t_timer[TCPT_PERSIST] == 0)
+			if (!TCP_TIMER_ISARMED(tp, TCPT_PERSIST))
 				tcp_setpersist(tp);
 		}
 	}
 	if (len > tp->t_maxseg) {
-		len = tp->t_maxseg;
-		sendalot = 1;
+		/*
+		 * Let the interface cut the data into segments if it is able
+		 * to.  Only the last segment may be shorter than the
+		 * maximum segment size.
+		 */
+		if ((flags & TH_SYN) == 0 && tp->t_inpcb->inp_options == NULL &&
+		    tcp_tso_enabled(tp)) {
+			tso = 1;
+			if (len > (long)TCP_TSO_MAXLEN) {
+				len = TCP_TSO_MAXLEN;
+				sendalot = 1;
+			}
+			if (sendalot || off + len < so->so_snd.sb_cc) {
+				long moff = len % tp->t_maxseg;
+
+				if (moff != 0) {
+					len -= moff;
+					sendalot = 1;
+				}
+			}
+		} else {
+			len = tp->t_maxseg;
+			sendalot = 1;
+		}
 	}
 	if (SEQ_LT(tp->snd_nxt + len, tp->snd_una + so->so_snd.sb_cc))
 		flags &= ~TH_FIN;
@@ -221,7 +288,7 @@ again:
 	 * to send into a small window), then must resend.
 	 */
 	if (len) {
-		if (len == tp->t_maxseg)
+		if (len >= tp->t_maxseg)
 			goto send;
 		if ((idle || tp->t_flags & TF_NODELAY) &&
 		    (tp->t_flags & TF_NOPUSH) == 0 &&
@@ -284,13 +351,13 @@ again:
 	 *	persisting		to move a small or zero window
 	 *	(re)transmitting	and thereby not persisting
 	 *
-	 * tp->t_timer[TCPT_PERSIST]
-	 *	is set when we are in persist state.
+	 * the TCPT_PERSIST timer
+	 *	is armed when we are in persist state.
 	 * tp->t_force
 	 *	is set when we are called to send a persist packet.
-	 * tp->t_timer[TCPT_REXMT]
-	 *	is set when we are retransmitting
-	 * The output side is idle when both timers are zero.
+	 * the TCPT_REXMT timer
+	 *	is armed when we are retransmitting
+	 * The output side is idle when both timers are stopped.
 	 *
 	 * If send window is too small, there is data to transmit, and no
 	 * retransmit or persist is pending, then go to persist state.
@@ -298,8 +365,8 @@ again:
 	 * if window is nonzero, transmit what we can,
 	 * otherwise force out a byte.
 	 */
-	if (so->so_snd.sb_cc && tp->t_timer[TCPT_REXMT] == 0 &&
-	    tp->t_timer[TCPT_PERSIST] == 0) {
+	if (so->so_snd.sb_cc && !TCP_TIMER_ISARMED(tp, TCPT_REXMT) &&
+	    !TCP_TIMER_ISARMED(tp, TCPT_PERSIST)) {
 		tp->t_rxtshift = 0;
 		tcp_setpersist(tp);
 	}
@@ -435,13 +502,22 @@ send:
 
  	hdrlen += optlen;
 
+	/*
+	 * With segmentation offload each segment carries the options.
+	 */
+	if (tso) {
+		tso_segsz = tp->t_maxopd - optlen;
+		if (len <= tso_segsz)
+			tso = 0;
+	}
+
 	/*
 	 * Adjust data length if insertion of options will
 	 * bump the packet length beyond the t_maxopd length.
 	 * Clear the FIN bit because we cut off the tail of
 	 * the segment.
 	 */
-	 if (len + optlen > tp->t_maxopd) {
+	 if (!tso && len + optlen > tp->t_maxopd) {
 		/*
 		 * If there is still more to send, don't close the connection.
 		 */
@@ -490,8 +566,18 @@ send:
 		m->m_data += max_linkhdr;
 		m->m_len = hdrlen;
 		if (len <= MHLEN - hdrlen - max_linkhdr) {
-			m_copydata(so->so_snd.sb_mb, off, (int) len,
-			    mtod(m, caddr_t) + hdrlen);
+			/*
+			 * Sum the data while it is copied if the checksum
+			 * is done in software anyway.
+			 */
+			if (tcp_csum_enabled(tp))
+				m_copydata(so->so_snd.sb_mb, off, (int) len,
+				    mtod(m, caddr_t) + hdrlen);
+			else {
+				m_copydata_cksum(so->so_snd.sb_mb, off,
+				    (int) len, mtod(m, caddr_t) + hdrlen, &dsum);
+				swcsum = 1;
+			}
 			m->m_len += len;
 		} else {
 			m->m_next = m_copy(so->so_snd.sb_mb, off, (int) len);
@@ -555,7 +641,8 @@ send:
 	 * case, since we know we aren't doing a retransmission.
 	 * (retransmit and persist are mutually exclusive...)
 	 */
-	if (len || (flags & (TH_SYN|TH_FIN)) || tp->t_timer[TCPT_PERSIST])
+	if (len || (flags & (TH_SYN|TH_FIN)) ||
+	    TCP_TIMER_ISARMED(tp, TCPT_PERSIST))
 		ti->ti_seq = htonl(tp->snd_nxt);
 	else
 		ti->ti_seq = htonl(tp->snd_max);
@@ -589,19 +676,40 @@ send:
 		tp->snd_up = tp->snd_una;		/* drag it along */
 
 	/*
-	 * Put TCP length in extended header, and then
-	 * checksum extended header and data.
+	 * Put the pseudo header sum in the checksum field and let
+	 * ip_output() or the interface checksum the header and data.  For
+	 * segmentation offload the TCP length is left out, the interface
+	 * adds the length of each segment.  If the data was summed while
+	 * it was copied, only the header is left to sum.
 	 */
-	if (len + optlen)
-		ti->ti_len = htons((u_short)(sizeof (struct tcphdr) +
-		    optlen + len));
-	ti->ti_sum = in_cksum(m, (int)(hdrlen + len));
+	if (swcsum) {
+		u_short sum;
+
+		ti->ti_sum = in_pseudo(ti->ti_src.s_addr, ti->ti_dst.s_addr,
+		    htons((u_short)(sizeof (struct tcphdr) + optlen + len +
+		    IPPROTO_TCP)));
+		sum = in_cksum_data((caddr_t)ti + sizeof (struct ip),
+		    (int)(sizeof (struct tcphdr) + optlen));
+		ti->ti_sum = ~in_cksum_add(sum, dsum, 0);
+		m->m_pkthdr.csum_flags = 0;
+	} else if (tso) {
+		ti->ti_sum = in_pseudo(ti->ti_src.s_addr, ti->ti_dst.s_addr,
+		    htons(IPPROTO_TCP));
+		m->m_pkthdr.csum_flags = CSUM_TCP | CSUM_TSO;
+		m->m_pkthdr.tso_segsz = tso_segsz;
+	} else {
+		ti->ti_sum = in_pseudo(ti->ti_src.s_addr, ti->ti_dst.s_addr,
+		    htons((u_short)(sizeof (struct tcphdr) + optlen + len +
+		    IPPROTO_TCP)));
+		m->m_pkthdr.csum_flags = CSUM_TCP;
+	}
+	m->m_pkthdr.csum_data = offsetof(struct tcphdr, th_sum);
 
 	/*
 	 * In transmit state, time the transmission and arrange for
 	 * the retransmit.  In persist state, just set snd_max.
 	 */
-	if (tp->t_force == 0 || tp->t_timer[TCPT_PERSIST] == 0) {
+	if (tp->t_force == 0 || !TCP_TIMER_ISARMED(tp, TCPT_PERSIST)) {
 		tcp_seq startseq = tp->snd_nxt;
 
 		/*
@@ -624,6 +732,7 @@ send:
 			 */
 			if (tp->t_rtt == 0) {
 				tp->t_rtt = 1;
+				tp->t_rtttime = tcp_ticks;
 				tp->t_rtseq = startseq;
 				tcpstat.tcps_segstimed++;
 			}
@@ -637,11 +746,11 @@ send:
 		 * Initialize shift counter which is used for backoff
 		 * of retransmit time.
 		 */
-		if (tp->t_timer[TCPT_REXMT] == 0 &&
+		if (!TCP_TIMER_ISARMED(tp, TCPT_REXMT) &&
 		    tp->snd_nxt != tp->snd_una) {
-			tp->t_timer[TCPT_REXMT] = tp->t_rxtcur;
-			if (tp->t_timer[TCPT_PERSIST]) {
-				tp->t_timer[TCPT_PERSIST] = 0;
+			TCP_TIMER_ARM(tp, TCPT_REXMT, tp->t_rxtcur);
+			if (TCP_TIMER_ISARMED(tp, TCPT_PERSIST)) {
+				TCP_TIMER_DISARM(tp, TCPT_PERSIST);
 				tp->t_rxtshift = 0;
 			}
 		}
@@ -730,6 +839,7 @@ out:
 		tp->rcv_adv = tp->rcv_nxt + win;
 	tp->last_ack_sent = tp->rcv_nxt;
 	tp->t_flags &= ~(TF_ACKNOW|TF_DELACK);
+	callout_stop(&tp->t_delack);
 	if (sendalot)
 		goto again;
 	return (0);
@@ -740,15 +850,16 @@ tcp_setpersist(
 	register struct tcpcb *tp)
 {
 	register int t = ((tp->t_srtt >> 2) + tp->t_rttvar) >> 1;
+	int persist;
 
-	if (tp->t_timer[TCPT_REXMT])
+	if (TCP_TIMER_ISARMED(tp, TCPT_REXMT))
 		panic("tcp_output REXMT");
 	/*
 	 * Start/restart persistance timer.
 	 */
-	TCPT_RANGESET(tp->t_timer[TCPT_PERSIST],
-	    t * tcp_backoff[tp->t_rxtshift],
+	TCPT_RANGESET(persist, t * tcp_backoff[tp->t_rxtshift],
 	    TCPTV_PERSMIN, TCPTV_PERSMAX);
+	TCP_TIMER_ARM(tp, TCPT_PERSIST, persist);
 	if (tp->t_rxtshift < TCP_MAXRXTSHIFT)
 		tp->t_rxtshift++;
 }
@@ -72,7 +72,7 @@
 	(tp)->snd_una = (tp)->snd_nxt = (tp)->snd_max = (tp)->snd_up = \
 	    (tp)->iss
 
-#define TCP_PAWS_IDLE	(uint32_t)(24L * 24L * 60L * 60L * PR_SLOWHZ)
+#define TCP_PAWS_IDLE	(24 * 24 * 60 * 60 * TCP_TS_HZ)
 					/* timestamp wrap-around time */
 
 #ifdef _KERNEL
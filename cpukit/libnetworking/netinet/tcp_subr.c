@@ -77,7 +77,7 @@ SYSCTL_INT(_net_inet_tcp, TCPCTL_MSSDFLT, mssdflt, CTLFLAG_RW,
 
 static int	tcp_do_rfc1323 = 1;
 #if !defined(__rtems__)
-static int 	tcp_rttdflt = TCPTV_SRTTDFLT / PR_SLOWHZ;
+static int 	tcp_rttdflt = TCPTV_SRTTDFLT / TCP_HZ;
 SYSCTL_INT(_net_inet_tcp, TCPCTL_RTTDFLT, rttdflt,
 	CTLFLAG_RW, &tcp_rttdflt , 0, "");
 
@@ -88,13 +88,23 @@ SYSCTL_INT(_net_inet_tcp, TCPCTL_DO_RFC1323, rfc1323,
 static void	tcp_notify(struct inpcb *, int);
 
 /*
- * Target size of TCP PCB hash table. Will be rounded down to a prime
- * number.
+ * Target size of TCP PCB hash table. Will be rounded down to a power
+ * of two.
  */
 #ifndef TCBHASHSIZE
 #define TCBHASHSIZE	128
 #endif
 
+static u_long	tcbhashsize = TCBHASHSIZE;
+
+#if defined(__rtems__)
+void rtems_set_tcp_hash_size(u_long hashsize)
+{
+    if ( hashsize != 0 )
+      tcbhashsize = hashsize;
+}
+#endif
+
 /*
  * Tcp initialization
  */
@@ -106,7 +116,8 @@ tcp_init(void)
 	tcp_ccgen = 1;
 	LIST_INIT(&tcb);
 	tcbinfo.listhead = &tcb;
-	tcbinfo.hashbase = hashinit(TCBHASHSIZE, M_PCB, &tcbinfo.hashmask);
+	in_pcbhashinit(&tcbinfo, tcbhashsize);
+	tcp_timer_init();
 	if (max_protohdr < sizeof(struct tcpiphdr))
 		max_protohdr = sizeof(struct tcpiphdr);
 	if (max_linkhdr + sizeof(struct tcpiphdr) > MHLEN)
@@ -247,6 +258,7 @@ struct tcpcb *
 tcp_newtcpcb(struct inpcb *inp)
 {
 	struct tcpcb *tp;
+	int i;
 
 	tp = malloc(sizeof(*tp), M_PCB, M_NOWAIT);
 	if (tp == NULL)
@@ -254,6 +266,9 @@ tcp_newtcpcb(struct inpcb *inp)
 	bzero((char *) tp, sizeof(struct tcpcb));
 	tp->seg_next = tp->seg_prev = (struct tcpiphdr *)tp;
 	tp->t_maxseg = tp->t_maxopd = tcp_mssdflt;
+	for (i = 0; i < TCPT_NTIMERS; i++)
+		callout_init(&tp->t_timer[i]);
+	callout_init(&tp->t_delack);
 
 	if (tcp_do_rfc1323)
 		tp->t_flags = (TF_REQ_SCALE|TF_REQ_TSTMP);
@@ -265,8 +280,9 @@ tcp_newtcpcb(struct inpcb *inp)
 	 */
 	tp->t_srtt = TCPTV_SRTTBASE;
 	tp->t_rttvar = ((TCPTV_RTOBASE - TCPTV_SRTTBASE) << TCP_RTTVAR_SHIFT) / 4;
-	tp->t_rttmin = TCPTV_MIN;
+	tp->t_rttmin = tcp_rexmit_min;
 	tp->t_rxtcur = TCPTV_RTOBASE;
+	tp->t_rcvtime = tp->t_starttime = tcp_ticks;
 	tp->snd_cwnd = TCP_MAXWIN << TCP_MAX_WINSHIFT;
 	tp->snd_ssthresh = TCP_MAXWIN << TCP_MAX_WINSHIFT;
 	inp->inp_ip_ttl = ip_defttl;
@@ -328,8 +344,7 @@ tcp_close(struct tcpcb *tp)
 		register u_long i = 0;
 
 		if ((rt->rt_rmx.rmx_locks & RTV_RTT) == 0) {
-			i = tp->t_srtt *
-			    (RTM_RTTUNIT / (PR_SLOWHZ * TCP_RTT_SCALE));
+			i = TCP_RTT_TO_RTM(tp->t_srtt, TCP_RTT_SCALE);
 			if (rt->rt_rmx.rmx_rtt && i)
 				/*
 				 * filter this update to half the old & half
@@ -344,8 +359,7 @@ tcp_close(struct tcpcb *tp)
 			tcpstat.tcps_cachedrtt++;
 		}
 		if ((rt->rt_rmx.rmx_locks & RTV_RTTVAR) == 0) {
-			i = tp->t_rttvar *
-			    (RTM_RTTUNIT / (PR_SLOWHZ * TCP_RTTVAR_SCALE));
+			i = TCP_RTT_TO_RTM(tp->t_rttvar, TCP_RTTVAR_SCALE);
 			if (rt->rt_rmx.rmx_rttvar && i)
 				rt->rt_rmx.rmx_rttvar =
 				    (rt->rt_rmx.rmx_rttvar + i) / 2;
@@ -393,6 +407,8 @@ tcp_close(struct tcpcb *tp)
 	}
 	if (tp->t_template)
 		(void) m_free(dtom(tp->t_template));
+	tcp_canceltimers(tp);
+	callout_stop(&tp->t_delack);
 	free(tp, M_PCB);
 	inp->inp_ppcb = 0;
 	soisdisconnected(so);
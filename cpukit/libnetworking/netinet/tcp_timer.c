@@ -68,25 +68,37 @@
 #include <netinet/tcp_debug.h>
 #endif
 
-int	tcp_keepinit = TCPTV_KEEP_INIT;
+/*
+ * The time values are in clock ticks and depend on the clock tick length,
+ * so they are set up by tcp_timer_init().
+ */
+int	tcp_keepinit;
 SYSCTL_INT(_net_inet_tcp, TCPCTL_KEEPINIT, keepinit,
 	CTLFLAG_RW, &tcp_keepinit , 0, "");
 
-int	tcp_keepidle = TCPTV_KEEP_IDLE;
+int	tcp_keepidle;
 SYSCTL_INT(_net_inet_tcp, TCPCTL_KEEPIDLE, keepidle,
 	CTLFLAG_RW, &tcp_keepidle , 0, "");
 
-static int	tcp_keepintvl = TCPTV_KEEPINTVL;
+static int	tcp_keepintvl;
 SYSCTL_INT(_net_inet_tcp, TCPCTL_KEEPINTVL, keepintvl,
 	CTLFLAG_RW, &tcp_keepintvl , 0, "");
 
+int	tcp_delacktime;
+SYSCTL_INT(_net_inet_tcp, TCPCTL_DELACKTIME, delacktime,
+	CTLFLAG_RW, &tcp_delacktime , 0, "");
+
+int	tcp_rexmit_min;
+SYSCTL_INT(_net_inet_tcp, TCPCTL_REXMITMIN, rexmit_min,
+	CTLFLAG_RW, &tcp_rexmit_min , 0, "");
+
 static int	always_keepalive = 0;
 SYSCTL_INT(_net_inet_tcp, OID_AUTO, always_keepalive,
 	CTLFLAG_RW, &always_keepalive , 0, "");
 
 static int	tcp_keepcnt = TCPTV_KEEPCNT;
 	/* max idle probes */
-static int	tcp_maxpersistidle = TCPTV_KEEP_IDLE;
+static int	tcp_maxpersistidle;
 	/* max idle time in persist */
 int	tcp_maxidle;
 #else /* TUBA_INCLUDE */
@@ -94,93 +106,149 @@ int	tcp_maxidle;
 static	int tcp_maxpersistidle;
 #endif /* TUBA_INCLUDE */
 
+#if defined(__rtems__)
+static u_long	tcp_delack_usec;
+static u_long	tcp_rexmit_min_usec;
+
+/*
+ * Set the delayed ACK time and the minimum retransmit timeout in
+ * microseconds, zero selects the default.  Call before the network is
+ * initialized.
+ */
+void rtems_set_tcp_timer_resolution(u_long delack_usec, u_long rexmit_min_usec)
+{
+	tcp_delack_usec = delack_usec;
+	tcp_rexmit_min_usec = rexmit_min_usec;
+}
+
+static int
+tcp_usec_to_ticks(u_long usec)
+{
+	int t = (int)(((u_int64_t)usec * TCP_HZ + 999999) / 1000000);
+
+	return (t > 0 ? t : 1);
+}
+#endif
+
+/*
+ * Set up the time constants, which are in TCP_HZ units.
+ */
+void
+tcp_timer_init(void)
+{
+	tcp_keepinit = TCPTV_KEEP_INIT;
+	tcp_keepidle = TCPTV_KEEP_IDLE;
+	tcp_keepintvl = TCPTV_KEEPINTVL;
+	tcp_maxpersistidle = TCPTV_KEEP_IDLE;
+	tcp_maxidle = tcp_keepcnt * tcp_keepintvl;
+	tcp_delacktime = TCPTV_DELACK;
+	tcp_rexmit_min = TCPTV_MIN;
+#if defined(__rtems__)
+	if (tcp_delack_usec != 0)
+		tcp_delacktime = tcp_usec_to_ticks(tcp_delack_usec);
+	if (tcp_rexmit_min_usec != 0)
+		tcp_rexmit_min = tcp_usec_to_ticks(tcp_rexmit_min_usec);
+#endif
+	if (tcp_delacktime < 1)
+		tcp_delacktime = 1;
+	if (tcp_rexmit_min < 2)
+		tcp_rexmit_min = 2;
+}
+
 /*
- * Fast timeout routine for processing delayed acks
+ * Delayed ACK timer of a connection
  */
 void
-tcp_fasttimo(void)
+tcp_timer_delack(void *xtp)
 {
-	register struct inpcb *inp;
-	register struct tcpcb *tp;
+	struct tcpcb *tp = xtp;
 	int s;
 
 	s = splnet();
-
-	for (inp = tcb.lh_first; inp != NULL; inp = inp->inp_list.le_next) {
-		if ((tp = (struct tcpcb *)inp->inp_ppcb) &&
-		    (tp->t_flags & TF_DELACK)) {
-			tp->t_flags &= ~TF_DELACK;
-			tp->t_flags |= TF_ACKNOW;
-			tcpstat.tcps_delack++;
-			(void) tcp_output(tp);
-		}
+	if (tp->t_flags & TF_DELACK) {
+		tp->t_flags &= ~TF_DELACK;
+		tp->t_flags |= TF_ACKNOW;
+		tcpstat.tcps_delack++;
+		(void) tcp_output(tp);
 	}
 	splx(s);
 }
 
 /*
- * Tcp protocol timeout routine called every 500 ms.
- * Updates the timers in all active tcb's and
- * causes finite state machine actions if timers expire.
+ * Run the TCP timer processing of a connection when one of its timers
+ * goes off.
  */
-void
-tcp_slowtimo(void)
+static void
+tcp_timer_expire(struct tcpcb *tp, int timer)
 {
-	register struct inpcb *ip, *ipnxt;
-	register struct tcpcb *tp;
-	register int i;
 	int s;
 #ifdef TCPDEBUG
 	int ostate;
 #endif
 
 	s = splnet();
-
-	tcp_maxidle = tcp_keepcnt * tcp_keepintvl;
-
-	ip = tcb.lh_first;
-	if (ip == NULL) {
-		splx(s);
-		return;
-	}
-	/*
-	 * Search through tcb's and update active timers.
-	 */
-	for (; ip != NULL; ip = ipnxt) {
-		ipnxt = ip->inp_list.le_next;
-		tp = intotcpcb(ip);
-		if (tp == 0 || tp->t_state == TCPS_LISTEN)
-			continue;
-		for (i = 0; i < TCPT_NTIMERS; i++) {
-			if (tp->t_timer[i] && --tp->t_timer[i] == 0) {
 #ifdef TCPDEBUG
-				ostate = tp->t_state;
+	ostate = tp->t_state;
 #endif
-				tp = tcp_timers(tp, i);
-				if (tp == NULL)
-					goto tpgone;
+	tp = tcp_timers(tp, timer);
 #ifdef TCPDEBUG
-				if (tp->t_inpcb->inp_socket->so_options
-				    & SO_DEBUG)
-					tcp_trace(TA_USER, ostate, tp,
-						  (struct tcpiphdr *)0,
-						  PRU_SLOWTIMO);
+	if (tp && (tp->t_inpcb->inp_socket->so_options & SO_DEBUG))
+		tcp_trace(TA_USER, ostate, tp, (struct tcpiphdr *)0,
+			  PRU_SLOWTIMO);
 #endif
-			}
-		}
-		tp->t_idle++;
-		tp->t_duration++;
-		if (tp->t_rtt)
-			tp->t_rtt++;
-tpgone:
-		;
-	}
+	splx(s);
+}
+
+static void
+tcp_timer_rexmt(void *xtp)
+{
+	tcp_timer_expire(xtp, TCPT_REXMT);
+}
+
+static void
+tcp_timer_persist(void *xtp)
+{
+	tcp_timer_expire(xtp, TCPT_PERSIST);
+}
+
+static void
+tcp_timer_keep(void *xtp)
+{
+	tcp_timer_expire(xtp, TCPT_KEEP);
+}
+
+static void
+tcp_timer_2msl(void *xtp)
+{
+	tcp_timer_expire(xtp, TCPT_2MSL);
+}
+
+void (*const tcp_timer_funcs[TCPT_NTIMERS])(void *) = {
+	tcp_timer_rexmt,
+	tcp_timer_persist,
+	tcp_timer_keep,
+	tcp_timer_2msl
+};
+
+/*
+ * Tcp protocol timeout routine called every 500 ms.
+ * The connection timers are callouts of their own, this only
+ * advances the initial send sequence number.
+ */
+void
+tcp_slowtimo(void)
+{
+	int s;
+
+	s = splnet();
+
+	tcp_maxidle = tcp_keepcnt * tcp_keepintvl;
+
 	tcp_iss += TCP_ISSINCR/PR_SLOWHZ;		/* increment iss */
 #ifdef TCP_COMPAT_42
 	if ((int)tcp_iss < 0)
 		tcp_iss = TCP_ISSINCR;			/* XXX */
 #endif
-	tcp_now++;					/* for timestamps */
 	splx(s);
 }
 #ifndef TUBA_INCLUDE
@@ -194,7 +262,7 @@ tcp_canceltimers(struct tcpcb *tp)
 	register int i;
 
 	for (i = 0; i < TCPT_NTIMERS; i++)
-		tp->t_timer[i] = 0;
+		TCP_TIMER_DISARM(tp, i);
 }
 
 int	tcp_backoff[TCP_MAXRXTSHIFT + 1] =
@@ -220,8 +288,8 @@ tcp_timers(struct tcpcb *tp, int timer)
 	 */
 	case TCPT_2MSL:
 		if (tp->t_state != TCPS_TIME_WAIT &&
-		    tp->t_idle <= tcp_maxidle)
-			tp->t_timer[TCPT_2MSL] = tcp_keepintvl;
+		    TCP_IDLE(tp) <= tcp_maxidle)
+			TCP_TIMER_ARM(tp, TCPT_2MSL, tcp_keepintvl);
 		else
 			tp = tcp_close(tp);
 		break;
@@ -243,7 +311,7 @@ tcp_timers(struct tcpcb *tp, int timer)
 		rexmt = TCP_REXMTVAL(tp) * tcp_backoff[tp->t_rxtshift];
 		TCPT_RANGESET(tp->t_rxtcur, rexmt,
 		    tp->t_rttmin, TCPTV_REXMTMAX);
-		tp->t_timer[TCPT_REXMT] = tp->t_rxtcur;
+		TCP_TIMER_ARM(tp, TCPT_REXMT, tp->t_rxtcur);
 		/*
 		 * If losing, let the lower level know and try for
 		 * a better route.  Also, if we backed off this far,
@@ -319,8 +387,8 @@ tcp_timers(struct tcpcb *tp, int timer)
 			if (maxidle < tp->t_rttmin)
 				maxidle = tp->t_rttmin;
 			maxidle *= tcp_totbackoff;
-			if (tp->t_idle >= tcp_maxpersistidle ||
-			    tp->t_idle >= maxidle) {
+			if (TCP_IDLE(tp) >= tcp_maxpersistidle ||
+			    TCP_IDLE(tp) >= maxidle) {
 				tcpstat.tcps_persistdrop++;
 				tp = tcp_drop(tp, ETIMEDOUT);
 				break;
@@ -343,7 +411,7 @@ tcp_timers(struct tcpcb *tp, int timer)
 		if ((always_keepalive ||
 		    tp->t_inpcb->inp_socket->so_options & SO_KEEPALIVE) &&
 		    tp->t_state <= TCPS_CLOSING) {
-		    	if (tp->t_idle >= tcp_keepidle + tcp_maxidle)
+		    	if (TCP_IDLE(tp) >= tcp_keepidle + tcp_maxidle)
 				goto dropit;
 			/*
 			 * Send a packet designed to force a response
@@ -369,9 +437,9 @@ tcp_timers(struct tcpcb *tp, int timer)
 			tcp_respond(tp, tp->t_template, (struct mbuf *)NULL,
 			    tp->rcv_nxt, tp->snd_una - 1, 0);
 #endif
-			tp->t_timer[TCPT_KEEP] = tcp_keepintvl;
+			TCP_TIMER_ARM(tp, TCPT_KEEP, tcp_keepintvl);
 		} else
-			tp->t_timer[TCPT_KEEP] = tcp_keepidle;
+			TCP_TIMER_ARM(tp, TCPT_KEEP, tcp_keepidle);
 		break;
 	dropit:
 		tcpstat.tcps_keepdrops++;
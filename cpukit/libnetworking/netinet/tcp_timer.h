@@ -34,9 +34,12 @@
 #define _NETINET_TCP_TIMER_H_
 
 /*
- * Definitions of the TCP timers.  These timers are counted
- * down PR_SLOWHZ times a second.
+ * Definitions of the TCP timers.  Each timer is a callout of the
+ * connection and the time values are in callout clock units (TCP_HZ), not
+ * in clock ticks.
  */
+#define	TCP_HZ		CALLOUT_HZ
+
 #define	TCPT_NTIMERS	4
 
 #define	TCPT_REXMT	0		/* retransmit */
@@ -83,22 +86,24 @@
 /*
  * Time constants.
  */
-#define	TCPTV_MSL	( 30*PR_SLOWHZ)		/* max seg lifetime (hah!) */
+#define	TCPTV_MSL	( 30*TCP_HZ)		/* max seg lifetime (hah!) */
 #define	TCPTV_SRTTBASE	0			/* base roundtrip time;
 						   if 0, no idea yet */
-#define	TCPTV_RTOBASE	(  3*PR_SLOWHZ)		/* assumed RTO if no info */
-#define	TCPTV_SRTTDFLT	(  3*PR_SLOWHZ)		/* assumed RTT if no info */
+#define	TCPTV_RTOBASE	(  3*TCP_HZ)		/* assumed RTO if no info */
+#define	TCPTV_SRTTDFLT	(  3*TCP_HZ)		/* assumed RTT if no info */
 
-#define	TCPTV_PERSMIN	(  5*PR_SLOWHZ)		/* retransmit persistence */
-#define	TCPTV_PERSMAX	( 60*PR_SLOWHZ)		/* maximum persist interval */
+#define	TCPTV_PERSMIN	(  5*TCP_HZ)		/* retransmit persistence */
+#define	TCPTV_PERSMAX	( 60*TCP_HZ)		/* maximum persist interval */
 
-#define	TCPTV_KEEP_INIT	( 75*PR_SLOWHZ)		/* initial connect keep alive */
-#define	TCPTV_KEEP_IDLE	(120*60*PR_SLOWHZ)	/* dflt time before probing */
-#define	TCPTV_KEEPINTVL	( 75*PR_SLOWHZ)		/* default probe interval */
+#define	TCPTV_KEEP_INIT	( 75*TCP_HZ)		/* initial connect keep alive */
+#define	TCPTV_KEEP_IDLE	(120*60*TCP_HZ)		/* dflt time before probing */
+#define	TCPTV_KEEPINTVL	( 75*TCP_HZ)		/* default probe interval */
 #define	TCPTV_KEEPCNT	8			/* max probes before drop */
 
-#define	TCPTV_MIN	(  1*PR_SLOWHZ)		/* minimum allowable value */
-#define	TCPTV_REXMTMAX	( 64*PR_SLOWHZ)		/* max allowable REXMT value */
+#define	TCPTV_MIN	( TCP_HZ/5 )		/* minimum allowable value */
+#define	TCPTV_REXMTMAX	( 64*TCP_HZ)		/* max allowable REXMT value */
+
+#define	TCPTV_DELACK	( TCP_HZ/10 )		/* time to delay the ACK */
 
 #define TCPTV_TWTRUNC	8			/* RTO factor to truncate TW */
 
@@ -123,11 +128,27 @@ static char *tcptimers[] =
 }
 
 #ifdef _KERNEL
+/*
+ * Start, stop and test the timers of a connection.
+ */
+#define	TCP_TIMER_ARM(tp, timer, nticks) \
+	callout_reset_hr(&(tp)->t_timer[(timer)], (nticks), \
+	    tcp_timer_funcs[(timer)], (tp))
+#define	TCP_TIMER_DISARM(tp, timer) \
+	callout_stop(&(tp)->t_timer[(timer)])
+#define	TCP_TIMER_ISARMED(tp, timer) \
+	callout_pending(&(tp)->t_timer[(timer)])
+
+extern void (*const tcp_timer_funcs[TCPT_NTIMERS])(void *);
+extern int tcp_delacktime;		/* time before sending a delayed ACK */
+extern int tcp_rexmit_min;		/* minimum retransmit timeout */
 extern int tcp_keepinit;		/* time to establish connection */
 extern int tcp_keepidle;		/* time before keepalive probes begin */
 extern int tcp_maxidle;			/* time to drop after starting probes */
 extern int tcp_ttl;			/* time to live for TCP segs */
 extern int tcp_backoff[];
+
+void	tcp_timer_init(void);
 #endif
 
 #endif
@@ -40,6 +40,7 @@
  */
 
 #ifdef __BSD_VISIBLE
+#include <sys/callout.h>
 #include <netinet/tcp_timer.h> /* TCPT_NTIMERS */
 
 /*
@@ -74,7 +75,8 @@ struct tcpcb {
 #define	TF_WASFRECOVERY	0x200000	/* was in NewReno Fast Recovery */
 #define	TF_SIGNATURE	0x400000	/* require MD5 digests (RFC2385) */
 	int	t_force;		/* 1 if forcing out a byte */
-	int	t_timer[TCPT_NTIMERS];	/* tcp timers */
+	struct	callout t_timer[TCPT_NTIMERS];	/* tcp timers */
+	struct	callout t_delack;	/* delayed ACK timer */
 	int	t_rxtshift;		/* log(2) of rexmt exp. backoff */
 	int	t_rxtcur;		/* current retransmit value */
 	int	t_dupacks;		/* consecutive dup acks recd */
@@ -118,8 +120,9 @@ struct tcpcb {
  * transmit timing stuff.  See below for scale of srtt and rttvar.
  * "Variance" is actually smoothed difference.
  */
-	u_int	t_idle;			/* inactivity time */
-	int	t_rtt;			/* round trip time */
+	u_int	t_rcvtime;		/* time of last segment received */
+	int	t_rtt;			/* timing a segment */
+	u_int	t_rtttime;		/* time the timed segment was sent */
 	tcp_seq	t_rtseq;		/* sequence number being timed */
 	int	t_srtt;			/* smoothed round-trip time */
 	int	t_rttvar;		/* variance in round-trip time */
@@ -144,7 +147,7 @@ struct tcpcb {
 /* RFC 1644 variables */
 	tcp_cc	cc_send;		/* send connection count */
 	tcp_cc	cc_recv;		/* receive connection count */
-	u_long	t_duration;		/* connection duration */
+	u_int	t_starttime;		/* time the connection was created */
 
 /* TUBA stuff */
 	caddr_t	t_tuba_pcb;		/* next level down pcb for TCP over z */
@@ -346,7 +349,9 @@ struct	xtcpcb {
 #define	TCPCTL_RECVSPACE	9	/* receive buffer space */
 #define	TCPCTL_KEEPINIT		10	/* timeout for establishing syn */
 #define	TCPCTL_PCBLIST		11	/* list of all outstanding PCBs */
-#define TCPCTL_MAXID		12
+#define	TCPCTL_DELACKTIME	12	/* time before sending delayed ACK */
+#define	TCPCTL_REXMITMIN	13	/* minimum retransmit timeout */
+#define TCPCTL_MAXID		14
 
 #define TCPCTL_NAMES { \
 	{ 0, 0 }, \
@@ -360,6 +365,9 @@ struct	xtcpcb {
 	{ "sendspace", CTLTYPE_INT }, \
 	{ "recvspace", CTLTYPE_INT }, \
 	{ "keepinit", CTLTYPE_INT }, \
+	{ "pcblist", CTLTYPE_STRUCT }, \
+	{ "delacktime", CTLTYPE_INT }, \
+	{ "rexmit_min", CTLTYPE_INT }, \
 }
 
 #ifdef _KERNEL
@@ -371,7 +379,48 @@ extern	struct inpcbhead tcb;		/* head of queue of active tcpcb's */
 extern	struct inpcbinfo tcbinfo;
 extern	struct tcpstat tcpstat;	/* tcp statistics */
 extern	int tcp_mssdflt;	/* XXX */
-extern	u_long tcp_now;		/* for RFC 1323 timestamps */
+
+/*
+ * The TCP timers and the round-trip time measurement use the callout
+ * clock, which counts TCP_HZ times a second, see tcp_timer.h.
+ */
+#define	tcp_ticks	callout_now()
+
+/*
+ * The RFC 1323 timestamp clock counts milliseconds.  It must not run faster
+ * than 1000 Hz, otherwise TCP_PAWS_IDLE does not fit into the signed
+ * timestamp comparisons.
+ */
+#define	TCP_TS_HZ	1000
+#define	tcp_now \
+	((u_int32_t)(rtems_clock_get_uptime_nanoseconds() / \
+	    (1000000000 / TCP_TS_HZ)))
+#define	TCP_TS_TO_TICKS(ts)	((int)(ts) * (TCP_HZ / TCP_TS_HZ))
+
+/*
+ * Convert the scaled round-trip time and variance to and from the route
+ * metrics, which are in RTM_RTTUNIT per second.
+ */
+#define	TCP_RTT_TO_RTM(v, scale) \
+	((u_long)(((u_int64_t)(v) * RTM_RTTUNIT) / \
+	    ((u_int64_t)TCP_HZ * (scale))))
+#define	TCP_RTM_TO_RTT(v, scale) \
+	((int)(((u_int64_t)(v) * TCP_HZ * (scale)) / RTM_RTTUNIT))
+
+/* Time since the last segment was received and since the creation */
+#define	TCP_IDLE(tp)		((u_int)(tcp_ticks - (tp)->t_rcvtime))
+#define	TCP_DURATION(tp)	((u_int)(tcp_ticks - (tp)->t_starttime))
+
+/*
+ * Request a delayed ACK, it is sent by tcp_timer_delack() unless an output
+ * segment carries it earlier.
+ */
+#define	TCP_SET_DELACK(tp) do { \
+	(tp)->t_flags |= TF_DELACK; \
+	if (!callout_pending(&(tp)->t_delack)) \
+		callout_reset_hr(&(tp)->t_delack, tcp_delacktime, \
+		    tcp_timer_delack, (tp)); \
+} while (0)
 
 void	 tcp_canceltimers(struct tcpcb *);
 struct tcpcb *
@@ -381,7 +430,6 @@ int	 tcp_ctloutput(int, struct socket *, int, int, struct mbuf **);
 struct tcpcb *
 	 tcp_drop(struct tcpcb *, int);
 void	 tcp_drain(void);
-void	 tcp_fasttimo(void);
 struct rmxp_tao *
 	 tcp_gettaocache(struct inpcb *);
 void	 tcp_init(void);
@@ -401,6 +449,7 @@ void	 tcp_setpersist(struct tcpcb *);
 void	 tcp_slowtimo(void);
 struct tcpiphdr *
 	 tcp_template(struct tcpcb *);
+void	 tcp_timer_delack(void *);
 struct tcpcb *
 	 tcp_timers(struct tcpcb *, int);
 void	 tcp_trace(short, short, struct tcpcb *, struct tcpiphdr *, int);
@@ -43,6 +43,7 @@
 #include <sys/socket.h>
 #include <sys/socketvar.h>
 #include <errno.h>
+#include <stddef.h>
 #include <sys/stat.h>
 #include <sys/kernel.h>
 #include <sys/sysctl.h>
@@ -84,6 +85,8 @@ struct	inpcbinfo udbinfo;
 #define UDBHASHSIZE 64
 #endif
 
+static u_long	udbhashsize = UDBHASHSIZE;
+
        struct	udpstat udpstat;	/* from udp_var.h */
 SYSCTL_STRUCT(_net_inet_udp, UDPCTL_STATS, stats, CTLFLAG_RD,
 	&udpstat, udpstat, "");
@@ -100,7 +103,7 @@ udp_init(void)
 {
 	LIST_INIT(&udb);
 	udbinfo.listhead = &udb;
-	udbinfo.hashbase = hashinit(UDBHASHSIZE, M_PCB, &udbinfo.hashmask);
+	in_pcbhashinit(&udbinfo, udbhashsize);
 }
 
 void
@@ -159,14 +162,26 @@ udp_input(struct mbuf *m, int iphlen)
 	save_ip = *ip;
 
 	/*
-	 * Checksum extended UDP header and data.
+	 * Checksum extended UDP header and data.  Use the sum of the
+	 * interface if available.
 	 */
 	if (uh->uh_sum) {
-		((struct ipovly *)ip)->ih_next = 0;
-		((struct ipovly *)ip)->ih_prev = 0;
-		((struct ipovly *)ip)->ih_x1 = 0;
-		((struct ipovly *)ip)->ih_len = uh->uh_ulen;
-		uh->uh_sum = in_cksum(m, len + sizeof (struct ip));
+		if (m->m_pkthdr.csum_flags & CSUM_DATA_VALID) {
+			if (m->m_pkthdr.csum_flags & CSUM_PSEUDO_HDR)
+				uh->uh_sum = m->m_pkthdr.csum_data;
+			else
+				uh->uh_sum = in_pseudo(ip->ip_src.s_addr,
+				    ip->ip_dst.s_addr,
+				    htonl((u_short)len +
+				    m->m_pkthdr.csum_data + IPPROTO_UDP));
+			uh->uh_sum ^= 0xffff;
+		} else {
+			((struct ipovly *)ip)->ih_next = 0;
+			((struct ipovly *)ip)->ih_prev = 0;
+			((struct ipovly *)ip)->ih_x1 = 0;
+			((struct ipovly *)ip)->ih_len = uh->uh_ulen;
+			uh->uh_sum = in_cksum(m, len + sizeof (struct ip));
+		}
 		if (uh->uh_sum) {
 			udpstat.udps_badsum++;
 			m_freem(m);
@@ -203,9 +218,13 @@ udp_input(struct mbuf *m, int iphlen)
 		/*
 		 * Locate pcb(s) for datagram.
 		 * (Algorithm copied from raw_intr().)
+		 * All candidates are on the port hash chain of the
+		 * destination port.
 		 */
 		last = NULL;
-		for (inp = udb.lh_first; inp != NULL; inp = inp->inp_list.le_next) {
+		for (inp = udbinfo.porthashbase[INP_PCBPORTHASH(uh->uh_dport,
+		    udbinfo.hashmask)].lh_first; inp != NULL;
+		    inp = inp->inp_portlist.le_next) {
 			if (inp->inp_lport != uh->uh_dport)
 				continue;
 			if (inp->inp_laddr.s_addr != INADDR_ANY) {
@@ -423,13 +442,31 @@ udp_output(struct inpcb *inp, struct mbuf *m, struct mbuf *addr,
 	ui->ui_ulen = ui->ui_len;
 
 	/*
-	 * Stuff checksum and output datagram.
+	 * Stuff the pseudo header sum, ip_output() or the interface
+	 * completes the checksum, and output datagram.  If sosend() summed
+	 * the data while copying it in, only the header is left to sum.
 	 */
 	ui->ui_sum = 0;
 	if (udpcksum) {
-	    if ((ui->ui_sum = in_cksum(m, sizeof (struct udpiphdr) + len)) == 0)
-		ui->ui_sum = 0xffff;
-	}
+		ui->ui_sum = in_pseudo(ui->ui_src.s_addr, ui->ui_dst.s_addr,
+		    htons((u_short)len + sizeof (struct udphdr) + IPPROTO_UDP));
+		if (m->m_pkthdr.csum_flags & CSUM_DATA_SUM) {
+			u_short sum;
+
+			sum = in_pseudo((u_int32_t)ui->ui_sum +
+			    m->m_pkthdr.csum_data,
+			    ((u_int32_t)ui->ui_sport << 16) | ui->ui_dport,
+			    ui->ui_ulen);
+			ui->ui_sum = ~sum;
+			if (ui->ui_sum == 0)
+				ui->ui_sum = 0xffff;
+			m->m_pkthdr.csum_flags = 0;
+		} else {
+			m->m_pkthdr.csum_flags = CSUM_UDP;
+			m->m_pkthdr.csum_data = offsetof(struct udphdr, uh_sum);
+		}
+	} else
+		m->m_pkthdr.csum_flags = 0;
 	((struct ip *)ui)->ip_len = sizeof (struct udpiphdr) + len;
 	((struct ip *)ui)->ip_ttl = inp->inp_ip_ttl;	/* XXX */
 	((struct ip *)ui)->ip_tos = inp->inp_ip_tos;	/* XXX */
@@ -585,6 +622,12 @@ void rtems_set_udp_buffer_sizes(u_long sendspace, u_long recvspace)
     if ( recvspace != 0 )
       udp_recvspace = recvspace;
 }
+
+void rtems_set_udp_hash_size(u_long hashsize)
+{
+    if ( hashsize != 0 )
+      udbhashsize = hashsize;
+}
 #endif
 
 /*ARGSUSED*/
@@ -11,6 +11,7 @@ extern "C" {
 #endif
 
 #include <rtems.h>
+#include <sys/types.h>
 
 /*
  *  If this file is included from inside the Network Stack proper or
@@ -66,6 +67,36 @@ void rtems_bsdnet_show_ip_stats (void);
 void rtems_bsdnet_show_icmp_stats (void);
 void rtems_bsdnet_show_udp_stats (void);
 void rtems_bsdnet_show_tcp_stats (void);
+void rtems_bsdnet_show_pcb_hash_stats (void);
+
+/*
+ * Protocol control block hash tables of UDP and TCP
+ *
+ * The connected PCBs are hashed by their addresses and ports, the
+ * listening and other unconnected PCBs (wildcard PCBs) by their local port.
+ * All bound PCBs are also hashed by their local port for the bind() checks
+ * and the broadcast delivery.
+ */
+struct rtems_bsdnet_pcb_hash_stats {
+	unsigned long	pcb_count;	/* PCBs of the protocol */
+	unsigned long	chain_count;	/* chains of each table */
+	unsigned long	conn_used;	/* non-empty connected PCB chains */
+	unsigned long	conn_max;	/* longest connected PCB chain */
+	unsigned long	wild_used;	/* non-empty wildcard PCB chains */
+	unsigned long	wild_max;	/* longest wildcard PCB chain */
+	unsigned long	port_used;	/* non-empty local port chains */
+	unsigned long	port_max;	/* longest local port chain */
+	unsigned long	lookups;	/* packet demultiplexing lookups */
+	unsigned long	lookup_steps;	/* PCBs compared by the lookups */
+};
+
+/*
+ * The protocol is IPPROTO_UDP or IPPROTO_TCP.  These functions return 0
+ * on success, otherwise -1 with errno set.
+ */
+int rtems_bsdnet_pcb_hash_resize (int protocol, unsigned long chain_count);
+int rtems_bsdnet_pcb_hash_stats (int protocol,
+	struct rtems_bsdnet_pcb_hash_stats *stats);
 
 /*
  * Network configuration
@@ -181,6 +212,35 @@ struct rtems_bsdnet_config {
 	 */
 	unsigned long		tcp_tx_buf_size;
 	unsigned long		tcp_rx_buf_size;
+	/*
+	 * Number of chains of the UDP and TCP PCB hash tables.
+	 * The value is rounded down to a power of two, at most 65536.
+	 * Use about the expected number of sockets.
+	 *
+	 *   UDP = 64
+	 *   TCP = 128
+	 *
+	 * See netinet/in_pcb.c for details, the tables can be resized
+	 * at run time with rtems_bsdnet_pcb_hash_resize().
+	 */
+	unsigned long		udp_hash_size;
+	unsigned long		tcp_hash_size;
+
+	/*
+	 * TCP delayed ACK time and minimum retransmit timeout in
+	 * microseconds.  The TCP timers run on the callout clock, so the
+	 * values are rounded up to 100 microseconds (TCP_HZ).  The network
+	 * daemon wakes up on clock ticks, so a timer expires at the first
+	 * clock tick after its time.
+	 *
+	 *   delayed ACK = 100000
+	 *   minimum RTO = 200000
+	 *
+	 * Both can be changed at run time with the net.inet.tcp.delacktime
+	 * and net.inet.tcp.rexmit_min sysctls, which are in TCP_HZ units.
+	 */
+	unsigned long		tcp_delack_time;
+	unsigned long		tcp_rexmit_min;
 };
 
 /*
@@ -307,6 +367,28 @@ void* rtems_bsdnet_malloc_mbuf(size_t size, int type);
 #define MBUF_MALLOC_MCLREFCNT   (1)
 #define MBUF_MALLOC_MBUF        (2)
 
+/*
+ * Send a buffer on a socket without copying it into mbuf clusters.
+ *
+ * The buffer is attached to the mbufs as external storage.  It must not be
+ * changed or freed until the done handler is called.  This happens once
+ * the network stack no longer references the buffer, for TCP usually after
+ * the peer acknowledged the data.  The done handler is called exactly once
+ * for each call of this function, even if an error occurred, and may be
+ * called before this function returns.  It is called with the network
+ * semaphore held, so it must not use the network stack or block.
+ *
+ * RETURNS: the count of bytes sent, or -1 on failure with errno set.
+ */
+ssize_t rtems_bsdnet_send_zero_copy(
+  int            s,
+  const void    *buf,
+  size_t         len,
+  int            flags,
+  void         (*done)(void *arg),
+  void          *arg
+);
+
 #ifdef __cplusplus
 }
 #endif
@@ -43,8 +43,10 @@ struct mdproc {
  * Other RTEMS/BSD glue
  */
 struct socket;
+struct uio;
 extern int soconnsleep (struct socket *so);
 extern void soconnwakeup (struct socket *so);
+extern int rtems_bsdnet_uiomove_unlocked (void *cp, int n, struct uio *uio, u_short *sum);
 #define splnet()	0
 #define splimp()	0
 #define splx(_s)	do { (_s) = 0; (void) (_s); } while(0)
@@ -202,10 +204,12 @@ int ioctl (int, ioctl_command_t, ...);
  */
 #define SBWAIT_EVENT   RTEMS_EVENT_SYSTEM_NETWORK_SBWAIT
 #define SOSLEEP_EVENT  RTEMS_EVENT_SYSTEM_NETWORK_SOSLEEP
+#define TSLEEP_EVENT   RTEMS_EVENT_SYSTEM_NETWORK_TSLEEP
+#define CALLOUT_EVENT  RTEMS_EVENT_SYSTEM_NETWORK_CALLOUT
 #define NETISR_IP_EVENT        (1L << NETISR_IP)
 #define NETISR_ARP_EVENT       (1L << NETISR_ARP)
 #define NETISR_EVENTS  (NETISR_IP_EVENT|NETISR_ARP_EVENT)
-#if (SBWAIT_EVENT & SOSLEEP_EVENT & NETISR_EVENTS)
+#if (SBWAIT_EVENT & SOSLEEP_EVENT & TSLEEP_EVENT & CALLOUT_EVENT & NETISR_EVENTS)
 # error "Network event conflict"
 #endif
 
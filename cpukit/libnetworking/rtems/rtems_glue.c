@@ -24,6 +24,8 @@
 #include <sys/sockio.h>
 #include <sys/callout.h>
 #include <sys/proc.h>
+#include <sys/systm.h>
+#include <sys/uio.h>
 #include <sys/ioctl.h>
 #include <net/if.h>
 #include <net/route.h>
@@ -66,10 +68,25 @@ int			rtems_bsdnet_microseconds_per_tick;
 
 /*
  * Callout processing
+ *
+ * The pending callouts are kept in a hashed timing wheel.  A callout is in
+ * the slot of its expiration time modulo the wheel size, so starting and
+ * stopping a callout takes constant time.  The wheel runs on the callout
+ * clock derived from the uptime with a resolution of 1/CALLOUT_HZ
+ * seconds, so the TCP timers and round-trip times do not depend on the
+ * clock tick.  The network daemon runs the slots of the time passed since
+ * it last looked and sleeps until the earliest expiration rounded up to
+ * the next clock tick.
  */
-static rtems_interval	ticksWhenCalloutsLastChecked;
-struct callout *callfree = NULL;
-struct callout calltodo;
+#define	CALLWHEEL_SIZE	256
+#define	CALLWHEEL_MASK	(CALLWHEEL_SIZE - 1)
+static LIST_HEAD(, callout) callwheel[CALLWHEEL_SIZE];
+static u_int		callwheel_time;		/* last time processed */
+static u_int		callwheel_next;		/* earliest expiration */
+static u_int		callwheel_wakeup;	/* wake up of daemon */
+static bool		callwheel_sleeping;	/* daemon waits for wakeup */
+static int		callwheel_count;	/* pending callouts */
+static struct callout	*callfree;		/* free timeout() entries */
 
 /*
  * FreeBSD variables
@@ -181,6 +198,7 @@ rtems_bsdnet_free (void *addr, int type)
  */
 extern struct domain routedomain;
 extern struct domain inetdomain;
+extern struct domain localdomain;
 
 /*
  * Do the initializations required by the BSD code
@@ -188,8 +206,8 @@ extern struct domain inetdomain;
 static int
 bsd_init (void)
 {
-	int i;
 	char *p;
+	char *clusters;
 
 	/*
 	 * Set up mbuf cluster data strutures
@@ -199,14 +217,8 @@ bsd_init (void)
 		printf ("Can't get network cluster memory.\n");
 		return -1;
 	}
-	p = (char *)(((intptr_t)p + (MCLBYTES-1)) & ~(MCLBYTES-1));
-	mbutl = (struct mbuf *)p;
-	for (i = 0; i < nmbclusters; i++) {
-		((union mcluster *)p)->mcl_next = mclfree;
-		mclfree = (union mcluster *)p;
-		p += MCLBYTES;
-		mbstat.m_clfree++;
-	}
+	clusters = (char *)(((intptr_t)p + (MCLBYTES-1)) & ~(MCLBYTES-1));
+	mbutl = (struct mbuf *)clusters;
 	mbstat.m_clusters = nmbclusters;
 	mclrefcnt = rtems_bsdnet_malloc_mbuf (nmbclusters, MBUF_MALLOC_MCLREFCNT);
 	if (mclrefcnt == NULL) {
@@ -225,19 +237,23 @@ bsd_init (void)
 		printf ("Can't get network memory.\n");
 		return -1;
 	}
-	for (i = 0; i < nmbuf; i++) {
-		((struct mbuf *)p)->m_next = mmbfree;
-		mmbfree = (struct mbuf *)p;
-		p += MSIZE;
-	}
 	mbstat.m_mbufs = nmbuf;
-	mbstat.m_mtypes[MT_FREE] = nmbuf;
+
+	/*
+	 * Set up the mbuf and cluster pools and the per-processor caches
+	 */
+	if (m_cache_init (clusters, nmbclusters, p, nmbuf) != 0) {
+		printf ("Can't get mbuf cache memory.\n");
+		return -1;
+	}
 
 	/*
 	 * Set up domains
 	 */
 	{
 
+	localdomain.dom_next = domains;
+	domains = &localdomain;
 	routedomain.dom_next = domains;
 	domains = &routedomain;
 	inetdomain.dom_next = domains;
@@ -263,6 +279,9 @@ bsd_init (void)
 extern void rtems_set_udp_buffer_sizes( u_long, u_long );
 extern void rtems_set_tcp_buffer_sizes( u_long, u_long );
 extern void rtems_set_sb_efficiency( u_long );
+extern void rtems_set_udp_hash_size( u_long );
+extern void rtems_set_tcp_hash_size( u_long );
+extern void rtems_set_tcp_timer_resolution( u_long, u_long );
 
 /*
  * Initialize and start network operations
@@ -300,6 +319,15 @@ rtems_bsdnet_initialize (void)
 
         rtems_set_sb_efficiency( rtems_bsdnet_config.sb_efficiency );
 
+        rtems_set_udp_hash_size( rtems_bsdnet_config.udp_hash_size );
+
+        rtems_set_tcp_hash_size( rtems_bsdnet_config.tcp_hash_size );
+
+        rtems_set_tcp_timer_resolution(
+          rtems_bsdnet_config.tcp_delack_time,
+          rtems_bsdnet_config.tcp_rexmit_min
+        );
+
 	/*
 	 * Create the task-synchronization semaphore
 	 */
@@ -332,6 +360,7 @@ rtems_bsdnet_initialize (void)
 		rtems_bsdnet_ticks_per_second = 1;
 	rtems_bsdnet_microseconds_per_tick =
 		1000000 / rtems_bsdnet_ticks_per_second;
+	callwheel_time = callout_now();
 
 	/*
 	 * Set up BSD-style sockets
@@ -489,21 +518,133 @@ sowakeup(
 	if (sb->sb_wakeup) {
 		(*sb->sb_wakeup) (so, sb->sb_wakeuparg);
 	}
+	if (!KNLIST_EMPTY(&sb->sb_note)) {
+		KNOTE_UNLOCKED(&sb->sb_note, 0);
+	}
 }
 
 /*
- * For now, a socket can be used by only one task at a time.
+ * Tasks sleeping in tsleep().
+ * The list is protected by the network semaphore.
+ */
+struct sleeper {
+	struct sleeper *next;
+	void *chan;
+	rtems_id tid;
+};
+static struct sleeper *sleepers;
+
+/*
+ * Wait for a wakeup() on the given channel.
+ * The network semaphore is released while waiting.
+ */
+int
+tsleep (void *chan, int pri, char *wmesg, int timo)
+{
+	struct sleeper me, **p;
+	rtems_event_set events;
+	rtems_status_code sc;
+	uint32_t nest_count;
+
+	/*
+	 * Soak up any pending events.
+	 */
+	rtems_event_system_receive (TSLEEP_EVENT, RTEMS_EVENT_ANY | RTEMS_NO_WAIT, RTEMS_NO_TIMEOUT, &events);
+
+	me.chan = chan;
+	me.tid = rtems_task_self ();
+	me.next = sleepers;
+	sleepers = &me;
+
+	nest_count = rtems_bsdnet_semaphore_release_recursive ();
+	sc = rtems_event_system_receive (TSLEEP_EVENT, RTEMS_EVENT_ANY | RTEMS_WAIT, timo, &events);
+	rtems_bsdnet_semaphore_obtain_recursive (nest_count);
+
+	/*
+	 * Remove us from the list unless wakeup() already did
+	 */
+	for (p = &sleepers; *p != NULL; p = &(*p)->next) {
+		if (*p == &me) {
+			*p = me.next;
+			break;
+		}
+	}
+
+	switch (sc) {
+	case RTEMS_SUCCESSFUL:	return 0;
+	case RTEMS_TIMEOUT:	return EWOULDBLOCK;
+	default:		return ENXIO;
+	}
+}
+
+/*
+ * Wake up all tasks sleeping on the given channel.
+ */
+void
+wakeup (void *chan)
+{
+	struct sleeper **p = &sleepers;
+
+	while (*p != NULL) {
+		struct sleeper *s = *p;
+
+		if (s->chan == chan) {
+			*p = s->next;
+			rtems_event_system_send (s->tid, TSLEEP_EVENT);
+		} else {
+			p = &s->next;
+		}
+	}
+}
+
+/*
+ * Wait until the socket buffer lock is available.
+ * The lock is held across rtems_bsdnet_uiomove_unlocked().
  */
 int
 sb_lock(struct sockbuf *sb)
 {
-	rtems_panic ("Socket buffer is already in use.");
+	int error;
+
+	while (sb->sb_flags & SB_LOCK) {
+		sb->sb_flags |= SB_WANT;
+		error = tsleep ((caddr_t)&sb->sb_flags, 0, "sblock", 0);
+		if (error)
+			return error;
+	}
+	sb->sb_flags |= SB_LOCK;
 	return 0;
 }
-void
-wakeup (void *p)
+
+/*
+ * Copy data between a socket buffer and user space.
+ * Large copies are done without holding the network semaphore
+ * so that the stack can make progress on other sockets in the
+ * meantime.  The caller must hold the socket buffer lock
+ * (sblock()) which keeps other tasks from taking the mbufs
+ * away.  If sum is not NULL, the data is checksummed while it
+ * is copied, see uiomove_cksum().
+ */
+int
+rtems_bsdnet_uiomove_unlocked (void *cp, int n, struct uio *uio, u_short *sum)
 {
-	rtems_panic ("Wakeup called");
+	uint32_t nest_count;
+	int error;
+
+	if (n < MINCLSIZE) {
+		if (sum != NULL)
+			return uiomove_cksum (cp, n, uio, sum);
+		return uiomove (cp, n, uio);
+	}
+
+	nest_count = rtems_bsdnet_semaphore_release_recursive ();
+	if (sum != NULL)
+		error = uiomove_cksum (cp, n, uio, sum);
+	else
+		error = uiomove (cp, n, uio);
+	rtems_bsdnet_semaphore_obtain_recursive (nest_count);
+
+	return error;
 }
 
 /*
@@ -568,6 +709,158 @@ rtems_bsdnet_schednetisr (int n)
 	rtems_event_system_send (networkDaemonTid, 1 << n);
 }
 
+/*
+ * Return the callout clock, see CALLOUT_HZ
+ */
+u_int
+callout_now (void)
+{
+	return (u_int)(rtems_clock_get_uptime_nanoseconds() /
+	    (1000000000 / CALLOUT_HZ));
+}
+
+/*
+ * Run the callouts which expired up to now and determine the next
+ * expiration.
+ */
+static void
+callout_run (void)
+{
+	LIST_HEAD(, callout) expired;
+	u_int now;
+	u_int t;
+	u_int slots;
+	struct callout *c;
+	struct callout *next;
+
+	now = callout_now();
+	if (callwheel_count == 0 || (int)(now - callwheel_next) < 0)
+		return;
+
+	/*
+	 * Collect the expired callouts first, since the callout functions
+	 * may start and stop other callouts of the same slot.
+	 */
+	LIST_INIT(&expired);
+	slots = now - callwheel_time;
+	if (slots > CALLWHEEL_SIZE)
+		slots = CALLWHEEL_SIZE;
+	for (t = now - slots + 1; slots > 0; t++, slots--) {
+		for (c = LIST_FIRST(&callwheel[t & CALLWHEEL_MASK]); c != NULL;
+		    c = next) {
+			next = LIST_NEXT(c, c_links);
+			if ((int)(c->c_time - now) <= 0) {
+				LIST_REMOVE(c, c_links);
+				LIST_INSERT_HEAD(&expired, c, c_links);
+			}
+		}
+	}
+	callwheel_time = now;
+
+	while ((c = LIST_FIRST(&expired)) != NULL) {
+		void *arg;
+		void (*func) (void *);
+
+		LIST_REMOVE(c, c_links);
+		c->c_flags &= ~CALLOUT_PENDING;
+		--callwheel_count;
+		func = c->c_func;
+		arg = c->c_arg;
+		if (c->c_flags & CALLOUT_LOCAL_ALLOC) {
+			LIST_NEXT(c, c_links) = callfree;
+			callfree = c;
+		}
+		(*func)(arg);
+	}
+
+	/*
+	 * Find the next expiration.  The first slot with a callout of its
+	 * own tick has it, other callouts are at least one wheel turn ahead.
+	 */
+	now = callwheel_time;
+	callwheel_next = now + UINT32_MAX / 2;
+	if (callwheel_count == 0)
+		return;
+	for (t = now + 1; t != now + 1 + CALLWHEEL_SIZE; t++) {
+		LIST_FOREACH(c, &callwheel[t & CALLWHEEL_MASK], c_links) {
+			if ((int)(c->c_time - callwheel_next) < 0)
+				callwheel_next = c->c_time;
+		}
+		if (callwheel_next == t)
+			break;
+	}
+}
+
+/*
+ * Return the clock ticks until the next callout expires
+ */
+static rtems_interval
+callout_wait_ticks (void)
+{
+	int delta;
+
+	callwheel_sleeping = true;
+	if (callwheel_count == 0)
+		return RTEMS_NO_TIMEOUT;
+	delta = (int)(callwheel_next - callout_now());
+	callwheel_wakeup = callwheel_next;
+	if (delta <= 0)
+		return 1;
+	return (rtems_interval)(((u_int64_t)delta * hz + CALLOUT_HZ - 1) /
+	    CALLOUT_HZ);
+}
+
+void
+callout_init (struct callout *c)
+{
+	memset (c, 0, sizeof *c);
+}
+
+void
+callout_stop (struct callout *c)
+{
+	if (c->c_flags & CALLOUT_PENDING) {
+		LIST_REMOVE(c, c_links);
+		c->c_flags &= ~CALLOUT_PENDING;
+		--callwheel_count;
+	}
+}
+
+void
+callout_reset (struct callout *c, int ticks, void (*ftn)(void *), void *arg)
+{
+	if (ticks <= 0)
+		ticks = 1;
+	callout_reset_hr (c, (int)(((u_int64_t)ticks * CALLOUT_HZ) / hz),
+	    ftn, arg);
+}
+
+void
+callout_reset_hr (struct callout *c, int time, void (*ftn)(void *),
+    void *arg)
+{
+	callout_stop (c);
+	if (time <= 0)
+		time = 1;
+	c->c_func = ftn;
+	c->c_arg = arg;
+	c->c_time = callout_now() + time;
+	c->c_flags |= CALLOUT_PENDING;
+	LIST_INSERT_HEAD(&callwheel[c->c_time & CALLWHEEL_MASK], c, c_links);
+	if (callwheel_count++ == 0 || (int)(c->c_time - callwheel_next) < 0)
+		callwheel_next = c->c_time;
+
+	/*
+	 * Wake up the network daemon if it sleeps beyond the new expiration
+	 * or without a timeout
+	 */
+	if (callwheel_sleeping &&
+	    (callwheel_count == 1 || (int)(c->c_time - callwheel_wakeup) < 0)) {
+		callwheel_sleeping = false;
+		rtems_event_system_send (networkDaemonTid, CALLOUT_EVENT);
+	}
+}
+
 /*
  * The network daemon
  * This provides a context to run BSD software interrupts
@@ -577,50 +870,22 @@ networkDaemon (void *task_argument)
 {
 	rtems_status_code sc;
 	rtems_event_set events;
-	rtems_interval now;
-	int ticksPassed;
-	uint32_t   timeout;
-	struct callout *c;
+	rtems_interval timeout;
 
 	for (;;) {
-		c = calltodo.c_next;
-		if (c)
-			timeout = c->c_time;
-		else
-			timeout = RTEMS_NO_TIMEOUT;
-
-		sc = rtems_bsdnet_event_receive (NETISR_EVENTS,
+		callout_run ();
+		timeout = callout_wait_ticks ();
+		sc = rtems_bsdnet_event_receive (NETISR_EVENTS | CALLOUT_EVENT,
 						RTEMS_EVENT_ANY | RTEMS_WAIT,
 						timeout,
 						&events);
+		callwheel_sleeping = false;
 		if ( sc == RTEMS_SUCCESSFUL ) {
 			if (events & NETISR_IP_EVENT)
 				ipintr ();
 			if (events & NETISR_ARP_EVENT)
 				arpintr ();
 		}
-
-  		now = rtems_clock_get_ticks_since_boot();
-		ticksPassed = now - ticksWhenCalloutsLastChecked;
-		if (ticksPassed != 0) {
-			ticksWhenCalloutsLastChecked = now;
-
-			c = calltodo.c_next;
-			if (c) {
-				c->c_time -= ticksPassed;
-				while ((c = calltodo.c_next) != NULL && c->c_time <= 0) {
-					void *arg;
-					void (*func) (void *);
-
-					func = c->c_func;
-					arg = c->c_arg;
-					calltodo.c_next = c->c_next;
-					c->c_next = callfree;
-					callfree = c;
-					(*func)(arg);
-				}
-			}
-		}
 	}
 }
 
@@ -728,48 +993,24 @@ rtems_bsdnet_random (void)
 }
 
 /*
- * Callout list processing
+ * Start a callout from the pool of free entries
  */
 void
 rtems_bsdnet_timeout(void (*ftn)(void *), void *arg, int ticks)
 {
-	register struct callout *new, *p, *t;
-
-	if (ticks <= 0)
-		ticks = 1;
+	struct callout *c;
 
-	/* Fill in the next free callout structure. */
 	if (callfree == NULL) {
-		callfree = malloc (sizeof *callfree);
-		if (callfree == NULL)
+		c = malloc (sizeof *c);
+		if (c == NULL)
 			rtems_panic ("No memory for timeout table entry");
-		callfree->c_next = NULL;
+		callout_init (c);
+	} else {
+		c = callfree;
+		callfree = LIST_NEXT(c, c_links);
 	}
-
-	new = callfree;
-	callfree = new->c_next;
-	new->c_arg = arg;
-	new->c_func = ftn;
-
-	/*
-	 * The time for each event is stored as a difference from the time
-	 * of the previous event on the queue.  Walk the queue, correcting
-	 * the ticks argument for queue entries passed.  Correct the ticks
-	 * value for the queue entry immediately after the insertion point
-	 * as well.  Watch out for negative c_time values; these represent
-	 * overdue events.
-	 */
-	for (p = &calltodo;
-	    (t = p->c_next) != NULL && ticks > t->c_time; p = t)
-		if (t->c_time > 0)
-			ticks -= t->c_time;
-	new->c_time = ticks;
-	if (t != NULL)
-		t->c_time -= ticks;
-
-	/* Insert the new entry into the queue. */
-	p->c_next = new;
-	new->c_next = t;
+	c->c_flags = CALLOUT_LOCAL_ALLOC;
+	callout_reset (c, ticks, ftn, arg);
 }
 
 /*
@@ -1240,75 +1481,3 @@ rtems_bsdnet_parse_driver_name (const struct rtems_bsdnet_ifconfig *config, char
 	printf ("Bad network driver name `%s'.\n", config->name);
 	return -1;
 }
-
-/*
- * Handle requests for more network memory
- * XXX: Another possibility would be to use a semaphore here with
- *      a release in the mbuf free macro.  I have chosen this `polling'
- *      approach because:
- *      1) It is simpler.
- *      2) It adds no complexity to the free macro.
- *      3) Running out of mbufs should be a rare
- *         condition -- predeployment testing of
- *         an application should indicate the
- *         required mbuf pool size.
- * XXX: Should there be a panic if a task is stuck in the loop for
- *      more than a minute or so?
- */
-int
-m_mballoc(int nmb, int nowait)
-{
-	if (nowait)
-		return 0;
-	m_reclaim ();
-	if (mmbfree == NULL) {
-		int try = 0;
-		int print_limit = 30 * rtems_bsdnet_ticks_per_second;
-
-		mbstat.m_wait++;
-		for (;;) {
-			uint32_t nest_count = rtems_bsdnet_semaphore_release_recursive ();
-			rtems_task_wake_after (1);
-			rtems_bsdnet_semaphore_obtain_recursive (nest_count);
-			if (mmbfree)
-				break;
-			if (++try >= print_limit) {
-				printf ("Still waiting for mbuf.\n");
-				try = 0;
-			}
-		}
-	}
-	else {
-		mbstat.m_drops++;
-	}
-	return 1;
-}
-
-int
-m_clalloc(int ncl, int nowait)
-{
-	if (nowait)
-		return 0;
-	m_reclaim ();
-	if (mclfree == NULL) {
-		int try = 0;
-		int print_limit = 30 * rtems_bsdnet_ticks_per_second;
-
-		mbstat.m_wait++;
-		for (;;) {
-			uint32_t nest_count = rtems_bsdnet_semaphore_release_recursive ();
-			rtems_task_wake_after (1);
-			rtems_bsdnet_semaphore_obtain_recursive (nest_count);
-			if (mclfree)
-				break;
-			if (++try >= print_limit) {
-				printf ("Still waiting for mbuf cluster.\n");
-				try = 0;
-			}
-		}
-	}
-	else {
-		mbstat.m_drops++;
-	}
-	return 1;
-}
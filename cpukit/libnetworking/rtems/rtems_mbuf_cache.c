@@ -0,0 +1,485 @@
+/*
+ * Per-processor mbuf and cluster caches
+ *
+ * The free mbufs and clusters are kept in a global pool and in a small
+ * cache for each processor in front of it.  The caches are refilled from
+ * and drained to the pool in batches, so most allocations only touch the
+ * cache of the current processor.  The caches and the pool are protected
+ * by interrupt locks and not by the network semaphore.  This allows
+ * network drivers to allocate mbufs and clusters in their receive tasks
+ * without the network semaphore, see m_gethdr_unlocked() and
+ * m_clget_unlocked().
+ *
+ * The allocator statistics changed by the caches are counted per
+ * processor under the cache lock and added to mbstat on read, see
+ * m_cache_mbstat().
+ *
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <string.h>
+
+#include <rtems.h>
+#include <rtems/rtems_bsdnet.h>
+#include <rtems/score/isrlevel.h>
+#include <sys/param.h>
+#include <sys/systm.h>
+#include <sys/mbuf.h>
+
+#define M_CACHE_MBUF	0
+#define M_CACHE_CLUSTER	1
+#define M_CACHE_KINDS	2
+
+#define M_CACHE_MTYPES \
+    ((int)(sizeof(mbstat.m_mtypes) / sizeof(mbstat.m_mtypes[0])))
+
+/*
+ * Count of items moved between a cache and the pool at once.  A cache
+ * holds at most two batches.
+ */
+static const int m_cache_batch[M_CACHE_KINDS] = { 16, 4 };
+
+/*
+ * The free mbufs and clusters are linked through their first word, this
+ * is m_next and mcl_next respectively.
+ */
+struct m_cache_list {
+	void	*head;
+	int	count;
+};
+
+/*
+ * Changes of the mbstat counters by a processor.  The mbuf type counts may
+ * become negative if an mbuf is allocated on one processor and freed on
+ * another.
+ */
+struct m_cache_mbstat {
+	long	clfree;
+	u_long	drops;
+	u_long	wait;
+	long	mtypes[M_CACHE_MTYPES];
+};
+
+struct m_cache {
+	rtems_interrupt_lock	lock;
+	struct m_cache_list	list[M_CACHE_KINDS];
+	struct mbcpustat	stat;
+	struct m_cache_mbstat	mbstat;
+};
+
+static struct m_cache *m_caches;
+
+static uint32_t m_cache_count;
+
+static struct m_cache_list m_pool[M_CACHE_KINDS];
+
+static rtems_interrupt_lock m_pool_lock =
+    RTEMS_INTERRUPT_LOCK_INITIALIZER("mbuf pool");
+
+static void
+m_cache_push(struct m_cache_list *l, void *p)
+{
+	*(void **)p = l->head;
+	l->head = p;
+	++l->count;
+}
+
+static void *
+m_cache_pop(struct m_cache_list *l)
+{
+	void *p = l->head;
+
+	if (p != NULL) {
+		l->head = *(void **)p;
+		--l->count;
+	}
+	return p;
+}
+
+/*
+ * Move up to n items from one list to another.
+ */
+static int
+m_cache_move(struct m_cache_list *to, struct m_cache_list *from, int n)
+{
+	int i;
+
+	for (i = 0; i < n && from->head != NULL; ++i)
+		m_cache_push(to, m_cache_pop(from));
+	return i;
+}
+
+/*
+ * Disable interrupts first, so that the executing thread cannot migrate to
+ * another processor while it uses the cache of the current processor.
+ */
+static struct m_cache *
+m_cache_acquire(rtems_interrupt_level *level,
+    rtems_interrupt_lock_context *lock_context)
+{
+	struct m_cache *mc;
+
+	_ISR_Disable_without_giant(*level);
+	mc = &m_caches[rtems_get_current_processor()];
+	rtems_interrupt_lock_acquire_isr(&mc->lock, lock_context);
+	return mc;
+}
+
+static void
+m_cache_release(struct m_cache *mc, rtems_interrupt_level level,
+    rtems_interrupt_lock_context *lock_context)
+{
+	rtems_interrupt_lock_release_isr(&mc->lock, lock_context);
+	_ISR_Enable_without_giant(level);
+}
+
+static void
+m_cache_update_stat(struct m_cache *mc)
+{
+	mc->stat.mc_mbufs = mc->list[M_CACHE_MBUF].count;
+	mc->stat.mc_clusters = mc->list[M_CACHE_CLUSTER].count;
+}
+
+/*
+ * Allocate an item from the cache of the current processor and refill the
+ * cache from the pool if necessary.
+ */
+static void *
+m_cache_alloc(int kind, int type)
+{
+	struct m_cache *mc;
+	struct m_cache_list *l;
+	rtems_interrupt_level level;
+	rtems_interrupt_lock_context lock_context;
+	void *p;
+
+	mc = m_cache_acquire(&level, &lock_context);
+	l = &mc->list[kind];
+	if (l->head != NULL) {
+		++mc->stat.mc_hits;
+	} else {
+		rtems_interrupt_lock_context pool_context;
+
+		rtems_interrupt_lock_acquire_isr(&m_pool_lock, &pool_context);
+		if (m_cache_move(l, &m_pool[kind], m_cache_batch[kind]) > 0)
+			++mc->stat.mc_refills;
+		rtems_interrupt_lock_release_isr(&m_pool_lock, &pool_context);
+	}
+	p = m_cache_pop(l);
+	if (p != NULL) {
+		if (kind == M_CACHE_MBUF) {
+			struct mbuf *m = p;
+
+			mc->mbstat.mtypes[MT_FREE]--;
+			m->m_type = type;
+			mc->mbstat.mtypes[type]++;
+		} else {
+			mclrefcnt[mtocl(p)] = 1;
+			mc->mbstat.clfree--;
+		}
+	}
+	m_cache_update_stat(mc);
+	m_cache_release(mc, level, &lock_context);
+	return p;
+}
+
+/*
+ * Free an item to the cache of the current processor and drain a batch to
+ * the pool if the cache is full.
+ */
+static void
+m_cache_free(int kind, void *p)
+{
+	struct m_cache *mc;
+	struct m_cache_list *l;
+	rtems_interrupt_level level;
+	rtems_interrupt_lock_context lock_context;
+
+	mc = m_cache_acquire(&level, &lock_context);
+	if (kind == M_CACHE_MBUF) {
+		struct mbuf *m = p;
+
+		mc->mbstat.mtypes[m->m_type]--;
+		m->m_type = MT_FREE;
+		mc->mbstat.mtypes[MT_FREE]++;
+	} else {
+		mc->mbstat.clfree++;
+	}
+	l = &mc->list[kind];
+	m_cache_push(l, p);
+	if (l->count > 2 * m_cache_batch[kind]) {
+		rtems_interrupt_lock_context pool_context;
+
+		rtems_interrupt_lock_acquire_isr(&m_pool_lock, &pool_context);
+		m_cache_move(&m_pool[kind], l, m_cache_batch[kind]);
+		rtems_interrupt_lock_release_isr(&m_pool_lock, &pool_context);
+		++mc->stat.mc_drains;
+	}
+	m_cache_update_stat(mc);
+	m_cache_release(mc, level, &lock_context);
+}
+
+/*
+ * Return the items cached by all processors to the pool.  Used if the pool
+ * is empty, otherwise the caches of idle processors could starve the
+ * others.
+ */
+static void
+m_cache_flush(int kind)
+{
+	uint32_t cpu;
+
+	for (cpu = 0; cpu < m_cache_count; ++cpu) {
+		struct m_cache *mc = &m_caches[cpu];
+		rtems_interrupt_lock_context lock_context;
+		rtems_interrupt_lock_context pool_context;
+
+		rtems_interrupt_lock_acquire(&mc->lock, &lock_context);
+		rtems_interrupt_lock_acquire_isr(&m_pool_lock, &pool_context);
+		m_cache_move(&m_pool[kind], &mc->list[kind], mc->list[kind].count);
+		rtems_interrupt_lock_release_isr(&m_pool_lock, &pool_context);
+		m_cache_update_stat(mc);
+		rtems_interrupt_lock_release(&mc->lock, &lock_context);
+	}
+}
+
+/*
+ * Wait for items freed by other tasks.  The network semaphore is released
+ * during the wait if the caller owns it.
+ *
+ * XXX: Another possibility would be to use a semaphore here with
+ *      a release in the mbuf free macro.  I have chosen this `polling'
+ *      approach because:
+ *      1) It is simpler.
+ *      2) It adds no complexity to the free macro.
+ *      3) Running out of mbufs should be a rare
+ *         condition -- predeployment testing of
+ *         an application should indicate the
+ *         required mbuf pool size.
+ */
+static void *
+m_cache_wait(int kind, int type, int locked)
+{
+	struct m_cache *mc;
+	rtems_interrupt_level level;
+	rtems_interrupt_lock_context lock_context;
+	rtems_interval start = rtems_clock_get_ticks_since_boot();
+	int try = 0;
+	int print_limit = 30 * rtems_bsdnet_ticks_per_second;
+	void *p;
+
+	for (;;) {
+		uint32_t nest_count = 0;
+
+		if (locked)
+			nest_count = rtems_bsdnet_semaphore_release_recursive ();
+		rtems_task_wake_after (1);
+		if (locked)
+			rtems_bsdnet_semaphore_obtain_recursive (nest_count);
+		m_cache_flush(kind);
+		if ((p = m_cache_alloc(kind, type)) != NULL)
+			break;
+		if (++try >= print_limit) {
+			printf ("Still waiting for mbuf%s.\n",
+			    kind == M_CACHE_MBUF ? "" : " cluster");
+			try = 0;
+		}
+	}
+	mc = m_cache_acquire(&level, &lock_context);
+	++mc->stat.mc_waits;
+	++mc->mbstat.wait;
+	mc->stat.mc_wait_ticks += rtems_clock_get_ticks_since_boot() - start;
+	m_cache_release(mc, level, &lock_context);
+	return p;
+}
+
+static void *
+m_cache_get(int kind, int how, int type, int locked)
+{
+	void *p;
+
+	if ((p = m_cache_alloc(kind, type)) != NULL)
+		return p;
+	m_cache_flush(kind);
+	if ((p = m_cache_alloc(kind, type)) != NULL || how != M_WAIT)
+		return p;
+	if (locked) {
+		m_reclaim ();
+		if ((p = m_cache_alloc(kind, type)) != NULL)
+			return p;
+	}
+	return m_cache_wait(kind, type, locked);
+}
+
+/*
+ * Set up the pools with the memory of bsd_init() and the caches.
+ */
+int
+m_cache_init(caddr_t clusters, int ncl, caddr_t mbufs, int nmb)
+{
+	uint32_t cpu;
+	int i;
+
+	m_cache_count = rtems_configuration_get_maximum_processors();
+	m_caches = malloc (m_cache_count * sizeof (*m_caches), M_MBUF,
+	    M_NOWAIT);
+	if (m_caches == NULL)
+		return -1;
+	memset (m_caches, 0, m_cache_count * sizeof (*m_caches));
+	for (cpu = 0; cpu < m_cache_count; ++cpu)
+		rtems_interrupt_lock_initialize(&m_caches[cpu].lock,
+		    "mbuf cache");
+
+	for (i = 0; i < ncl; i++) {
+		m_cache_push(&m_pool[M_CACHE_CLUSTER], clusters);
+		clusters += MCLBYTES;
+	}
+	mbstat.m_clfree = ncl;
+
+	for (i = 0; i < nmb; i++) {
+		m_cache_push(&m_pool[M_CACHE_MBUF], mbufs);
+		mbufs += MSIZE;
+	}
+	mbstat.m_mtypes[MT_FREE] = nmb;
+	return 0;
+}
+
+struct mbuf *
+m_cache_get_mbuf(int how, int type)
+{
+	return m_cache_get(M_CACHE_MBUF, how, type, 1);
+}
+
+void
+m_cache_put_mbuf(struct mbuf *m)
+{
+	m_cache_free(M_CACHE_MBUF, m);
+}
+
+caddr_t
+m_cache_get_cluster(int how)
+{
+	return m_cache_get(M_CACHE_CLUSTER, how, 0, 1);
+}
+
+void
+m_cache_put_cluster(caddr_t p)
+{
+	m_cache_free(M_CACHE_CLUSTER, p);
+}
+
+/*
+ * Like m_gethdr(), but may be called without the network semaphore, e.g.
+ * by the receive task of a network driver to refill its receive ring.  The
+ * protocols are not asked to free space, so it may fail more often.
+ */
+struct mbuf *
+m_gethdr_unlocked(int how, int type)
+{
+	struct mbuf *m;
+
+	m = m_cache_get(M_CACHE_MBUF, how, type, 0);
+	if (m != NULL) {
+		m->m_next = NULL;
+		m->m_nextpkt = NULL;
+		m->m_data = m->m_pktdat;
+		m->m_flags = M_PKTHDR;
+		m->m_pkthdr.csum_flags = 0;
+	} else {
+		struct m_cache *mc;
+		rtems_interrupt_level level;
+		rtems_interrupt_lock_context lock_context;
+
+		mc = m_cache_acquire(&level, &lock_context);
+		++mc->mbstat.drops;
+		m_cache_release(mc, level, &lock_context);
+	}
+	return m;
+}
+
+/*
+ * Like MCLGET(), but may be called without the network semaphore.  The
+ * mbuf must not be visible to other tasks.
+ */
+int
+m_clget_unlocked(struct mbuf *m, int how)
+{
+	caddr_t p;
+
+	p = m_cache_get(M_CACHE_CLUSTER, how, 0, 0);
+	if (p == NULL)
+		return 0;
+	m->m_ext.ext_buf = p;
+	m->m_data = p;
+	m->m_flags |= M_EXT;
+	m->m_ext.ext_free = NULL;
+	m->m_ext.ext_ref = NULL;
+	m->m_ext.ext_size = MCLBYTES;
+	return 1;
+}
+
+int
+m_cache_stat(uint32_t cpu, struct mbcpustat *stat)
+{
+	struct m_cache *mc;
+	rtems_interrupt_lock_context lock_context;
+
+	if (cpu >= m_cache_count)
+		return -1;
+	mc = &m_caches[cpu];
+	rtems_interrupt_lock_acquire(&mc->lock, &lock_context);
+	*stat = mc->stat;
+	rtems_interrupt_lock_release(&mc->lock, &lock_context);
+	return 0;
+}
+
+/*
+ * Change the type of an mbuf, see MCHTYPE().
+ */
+void
+m_cache_chtype(struct mbuf *m, int type)
+{
+	struct m_cache *mc;
+	rtems_interrupt_level level;
+	rtems_interrupt_lock_context lock_context;
+
+	mc = m_cache_acquire(&level, &lock_context);
+	mc->mbstat.mtypes[m->m_type]--;
+	m->m_type = type;
+	mc->mbstat.mtypes[type]++;
+	m_cache_release(mc, level, &lock_context);
+}
+
+/*
+ * Return the allocator statistics with the changes of all processors
+ * added.
+ */
+void
+m_cache_mbstat(struct mbstat *stat)
+{
+	uint32_t cpu;
+	int i;
+
+	*stat = mbstat;
+	for (cpu = 0; cpu < m_cache_count; ++cpu) {
+		struct m_cache *mc = &m_caches[cpu];
+		rtems_interrupt_lock_context lock_context;
+
+		rtems_interrupt_lock_acquire(&mc->lock, &lock_context);
+		stat->m_clfree += mc->mbstat.clfree;
+		stat->m_drops += mc->mbstat.drops;
+		stat->m_wait += mc->mbstat.wait;
+		for (i = 0; i < M_CACHE_MTYPES; ++i)
+			stat->m_mtypes[i] += mc->mbstat.mtypes[i];
+		rtems_interrupt_lock_release(&mc->lock, &lock_context);
+	}
+}
@@ -21,12 +21,24 @@ rtems_bsdnet_show_mbuf_stats (void)
 	int i;
 	int printed = 0;
 	char *cp;
+	uint32_t cpu;
+	struct mbcpustat mc;
+	struct mbstat stat;
 
+	m_cache_mbstat (&stat);
 	printf ("************ MBUF STATISTICS ************\n");
 	printf ("mbufs:%4lu    clusters:%4lu    free:%4lu\n",
-			mbstat.m_mbufs, mbstat.m_clusters, mbstat.m_clfree);
+			stat.m_mbufs, stat.m_clusters, stat.m_clfree);
 	printf ("drops:%4lu       waits:%4lu  drains:%4lu\n",
-			mbstat.m_drops, mbstat.m_wait, mbstat.m_drain);
+			stat.m_drops, stat.m_wait, stat.m_drain);
+	for (cpu = 0; m_cache_stat (cpu, &mc) == 0; cpu++) {
+		printf ("cpu %2lu: cached mbufs:%4lu  clusters:%4lu\n",
+			(u_long)cpu, mc.mc_mbufs, mc.mc_clusters);
+		printf ("  hits:%8lu  refills:%6lu  drains:%6lu\n",
+			mc.mc_hits, mc.mc_refills, mc.mc_drains);
+		printf ("  waits:%4lu  wait ticks:%8lu\n",
+			mc.mc_waits, mc.mc_wait_ticks);
+	}
 	for (i = 0 ; i < 20 ; i++) {
 		switch (i) {
 		case MT_FREE:		cp = "free";		break;
@@ -46,13 +58,13 @@ rtems_bsdnet_show_mbuf_stats (void)
 		case MT_OOBDATA:	cp = "oobdata";		break;
 		default:		cp = NULL;		break;
 		}
-		if ((cp != NULL) || (mbstat.m_mtypes[i] != 0)) {
+		if ((cp != NULL) || (stat.m_mtypes[i] != 0)) {
 			char cbuf[16];
 			if (cp == NULL) {
 				sprintf (cbuf, "Type %d", i);
 				cp = cbuf;
 			}
-			printf ("%10s:%-8u", cp, mbstat.m_mtypes[i]);
+			printf ("%10s:%-8u", cp, stat.m_mtypes[i]);
 			if (++printed == 4) {
 				printf ("\n");
 				printed = 0;
@@ -0,0 +1,157 @@
+/*
+ * Statistics and resizing of the UDP and TCP PCB hash tables
+ *
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#if HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <sys/param.h>
+#include <sys/queue.h>
+#include <sys/systm.h>
+#include <sys/kernel.h>
+#include <sys/proc.h>
+#include <sys/mbuf.h>
+#include <sys/socket.h>
+#include <net/if.h>
+#include <net/route.h>
+#include <netinet/in.h>
+#include <netinet/in_systm.h>
+#include <netinet/ip.h>
+#include <netinet/in_pcb.h>
+#include <netinet/ip_var.h>
+#include <netinet/tcp.h>
+#include <netinet/tcp_timer.h>
+#include <netinet/tcp_var.h>
+#include <netinet/udp.h>
+#include <netinet/udp_var.h>
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <rtems/rtems_bsdnet.h>
+
+static struct inpcbinfo *
+pcbhashinfo (int protocol)
+{
+	switch (protocol) {
+	case IPPROTO_UDP:
+		return &udbinfo;
+	case IPPROTO_TCP:
+		return &tcbinfo;
+	default:
+		return NULL;
+	}
+}
+
+/*
+ * Count the non-empty chains of a table and the length of the longest
+ * chain.  The port hash chains are linked through inp_portlist, the
+ * others through inp_hash.
+ */
+static void
+pcbhashchains (struct inpcbhead *base, unsigned long chains, int port,
+	unsigned long *used, unsigned long *max)
+{
+	unsigned long i;
+
+	*used = 0;
+	*max = 0;
+	for (i = 0; i < chains; i++) {
+		struct inpcb *inp;
+		unsigned long n = 0;
+
+		for (inp = base[i].lh_first; inp != NULL;
+		    inp = port ? inp->inp_portlist.le_next : inp->inp_hash.le_next)
+			n++;
+		if (n != 0)
+			(*used)++;
+		if (n > *max)
+			*max = n;
+	}
+}
+
+int
+rtems_bsdnet_pcb_hash_resize (int protocol, unsigned long chain_count)
+{
+	struct inpcbinfo *pcbinfo = pcbhashinfo (protocol);
+	int error;
+
+	if (pcbinfo == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+	rtems_bsdnet_semaphore_obtain ();
+	error = in_pcbhashresize (pcbinfo, chain_count);
+	rtems_bsdnet_semaphore_release ();
+	if (error) {
+		errno = error;
+		return -1;
+	}
+	return 0;
+}
+
+int
+rtems_bsdnet_pcb_hash_stats (int protocol,
+	struct rtems_bsdnet_pcb_hash_stats *stats)
+{
+	struct inpcbinfo *pcbinfo = pcbhashinfo (protocol);
+	unsigned long chains;
+
+	if (pcbinfo == NULL || stats == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+	memset (stats, 0, sizeof (*stats));
+	rtems_bsdnet_semaphore_obtain ();
+	chains = pcbinfo->hashmask + 1;
+	stats->pcb_count = pcbinfo->ipi_count;
+	stats->chain_count = chains;
+	pcbhashchains (pcbinfo->hashbase, chains, 0,
+	    &stats->conn_used, &stats->conn_max);
+	pcbhashchains (pcbinfo->wildhashbase, chains, 0,
+	    &stats->wild_used, &stats->wild_max);
+	pcbhashchains (pcbinfo->porthashbase, chains, 1,
+	    &stats->port_used, &stats->port_max);
+	stats->lookups = pcbinfo->ipi_lookups;
+	stats->lookup_steps = pcbinfo->ipi_lookupsteps;
+	rtems_bsdnet_semaphore_release ();
+	return 0;
+}
+
+static void
+showpcbhash (const char *name, int protocol)
+{
+	struct rtems_bsdnet_pcb_hash_stats st;
+
+	if (rtems_bsdnet_pcb_hash_stats (protocol, &st) != 0)
+		return;
+	printf ("************ %s PCB Hash Statistics ************\n", name);
+	printf ("PCBs:%-8lu Chains:%-8lu Lookups:%-10lu Steps/Lookup:",
+	    st.pcb_count, st.chain_count, st.lookups);
+	if (st.lookups)
+		printf ("%lu.%02lu\n", st.lookup_steps / st.lookups,
+		    (st.lookup_steps % st.lookups) * 100 / st.lookups);
+	else
+		printf ("-\n");
+	printf ("Connected  chains used:%-8lu longest:%lu\n",
+	    st.conn_used, st.conn_max);
+	printf ("Wildcard   chains used:%-8lu longest:%lu\n",
+	    st.wild_used, st.wild_max);
+	printf ("Local port chains used:%-8lu longest:%lu\n",
+	    st.port_used, st.port_max);
+}
+
+void
+rtems_bsdnet_show_pcb_hash_stats (void)
+{
+	showpcbhash ("UDP", IPPROTO_UDP);
+	showpcbhash ("TCP", IPPROTO_TCP);
+}
@@ -7,6 +7,7 @@
 /* #include <stdlib.h> */
 #include <stdio.h>
 #include <errno.h>
+#include <unistd.h>
 
 #include <rtems.h>
 #include <rtems/libio_.h>
@@ -33,6 +34,7 @@
  */
 ssize_t	send(int, const void *, size_t, int);
 ssize_t	recv(int, void *, size_t, int);
+int	sendfile(int, int, off_t, size_t, struct sf_hdtr *, off_t *, int);
 
 /*
  * Hooks to RTEMS I/O system
@@ -144,6 +146,69 @@ socket (int domain, int type, int protocol)
 	return fd;
 }
 
+/*
+ * Create a pair of connected sockets.  Only the local domain supports
+ * this, data written to one socket is appended directly to the receive
+ * buffer of the other.
+ */
+int
+socketpair (int domain, int type, int protocol, int *rsv)
+{
+	int error;
+	int ret = -1;
+	struct socket *so1, *so2;
+
+	if (rsv == NULL) {
+		errno = EFAULT;
+		return -1;
+	}
+	rsv[0] = -1;
+	rsv[1] = -1;
+	rtems_bsdnet_semaphore_obtain ();
+	error = socreate(domain, &so1, type, protocol, NULL);
+	if (error) {
+		errno = error;
+		goto out;
+	}
+	error = socreate(domain, &so2, type, protocol, NULL);
+	if (error) {
+		soclose (so1);
+		errno = error;
+		goto out;
+	}
+	error = soconnect2(so1, so2);
+	if (error == 0 && type == SOCK_DGRAM) {
+		/*
+		 * Datagram socket connection is asymmetric.
+		 */
+		error = soconnect2(so2, so1);
+	}
+	if (error) {
+		soclose (so1);
+		soclose (so2);
+		errno = error;
+		goto out;
+	}
+	rsv[0] = rtems_bsdnet_makeFdForSocket (so1);
+	if (rsv[0] < 0) {
+		soclose (so1);
+		soclose (so2);
+		goto out;
+	}
+	rsv[1] = rtems_bsdnet_makeFdForSocket (so2);
+	if (rsv[1] < 0) {
+		rtems_libio_free (rtems_libio_iop (rsv[0]));
+		rsv[0] = -1;
+		soclose (so1);
+		soclose (so2);
+		goto out;
+	}
+	ret = 0;
+out:
+	rtems_bsdnet_semaphore_release ();
+	return ret;
+}
+
 int
 bind (int s, struct sockaddr *name, int namelen)
 {
@@ -427,6 +492,310 @@ sendto (int s, const void *buf, size_t buflen, int flags, const struct sockaddr
 	return sendmsg (s, &msg, flags);
 }
 
+/*
+ * Maximum number of consecutive loans sent together.  File systems with
+ * small blocks, like the IMFS, lend one block per loan.
+ */
+#define SENDFILE_LOAN_MAX	32
+
+/*
+ * External storage of the mbufs sent by rtems_bsdnet_send_zero_copy() and
+ * sendfile().  The data is either lent by the file system, owned by the
+ * caller, or copied into the buffer which follows this structure.
+ */
+struct zero_copy_ref {
+	struct m_extref		ref;
+	void			(*done)(void *);
+	void			*arg;
+	int			loan_count;
+	rtems_filesystem_loan	loans[SENDFILE_LOAN_MAX];
+	size_t			loan_len[SENDFILE_LOAN_MAX];
+};
+
+/*
+ * Loans shorter than this in total are not worth an mbuf each, the file
+ * data is copied instead.
+ */
+#define SENDFILE_MIN_LOAN	512
+
+/*
+ * Maximum amount of file data copied or lent per chunk.
+ */
+#define SENDFILE_CHUNK_SIZE	(64 * 1024)
+
+#define SENDFILE_COPY_SIZE	(16 * 1024)
+
+static void
+zero_copy_release_loans (struct zero_copy_ref *zc)
+{
+	int i;
+
+	for (i = 0; i < zc->loan_count; i++) {
+		rtems_filesystem_loan *loan = &zc->loans[i];
+
+		if (loan->release != NULL)
+			(*loan->release)(loan);
+	}
+	zc->loan_count = 0;
+}
+
+static void
+zero_copy_free (struct m_extref *er)
+{
+	struct zero_copy_ref *zc = (struct zero_copy_ref *)er;
+
+	zero_copy_release_loans (zc);
+	if (zc->done != NULL)
+		(*zc->done)(zc->arg);
+	free (zc, M_TEMP);
+}
+
+static struct zero_copy_ref *
+zero_copy_alloc (size_t extra, int how)
+{
+	struct zero_copy_ref *zc;
+
+	zc = malloc (sizeof *zc + extra, M_TEMP, how);
+	if (zc != NULL) {
+		m_extref_init (&zc->ref, zero_copy_free);
+		zc->done = NULL;
+		zc->arg = NULL;
+		zc->loan_count = 0;
+	}
+	return zc;
+}
+
+/*
+ * Send the data of the zero copy reference and drop the reference of the
+ * caller.  Must be called with the network semaphore held.
+ */
+static int
+zero_copy_send (int s, struct zero_copy_ref *zc, size_t len, int flags, size_t *sent)
+{
+	int error;
+	struct uio auio;
+	struct iovec iov[SENDFILE_LOAN_MAX];
+	struct socket *so;
+	int i;
+
+	*sent = 0;
+	if ((so = rtems_bsdnet_fdToSocket (s)) == NULL) {
+		m_extref_rele (&zc->ref);
+		return errno;
+	}
+	for (i = 0; i < zc->loan_count; i++) {
+		iov[i].iov_base = (void *)zc->loans[i].data;
+		iov[i].iov_len = zc->loan_len[i];
+	}
+	auio.uio_iov = iov;
+	auio.uio_iovcnt = zc->loan_count;
+	auio.uio_segflg = UIO_NOCOPY;
+	auio.uio_rw = UIO_WRITE;
+	auio.uio_offset = 0;
+	auio.uio_resid = len;
+	error = sosend_extref (so, NULL, &auio, NULL, NULL, flags, &zc->ref);
+	*sent = len - auio.uio_resid;
+	m_extref_rele (&zc->ref);
+	return error;
+}
+
+ssize_t
+rtems_bsdnet_send_zero_copy (int s, const void *buf, size_t len, int flags,
+    void (*done)(void *arg), void *arg)
+{
+	int error;
+	size_t sent;
+	struct zero_copy_ref *zc;
+
+	rtems_bsdnet_semaphore_obtain ();
+	zc = zero_copy_alloc (0, M_WAITOK);
+	if (zc == NULL) {
+		/* The done handler is called even if the send fails */
+		if (done != NULL)
+			(*done)(arg);
+		rtems_bsdnet_semaphore_release ();
+		errno = ENOBUFS;
+		return -1;
+	}
+	zc->loans[0].data = buf;
+	zc->loans[0].release = NULL;
+	zc->loans[0].arg = NULL;
+	zc->loan_len[0] = len;
+	zc->loan_count = 1;
+	zc->done = done;
+	zc->arg = arg;
+	error = zero_copy_send (s, zc, len, flags, &sent);
+	rtems_bsdnet_semaphore_release ();
+	if (error) {
+		if (sent != 0 && (error == EINTR || error == EWOULDBLOCK))
+			return sent;
+		errno = error;
+		return -1;
+	}
+	return sent;
+}
+
+/*
+ * Get the next chunk of file data.  Ask the file system to lend it and
+ * fall back to a copy.  Called without the network semaphore, since the
+ * file system may block.
+ */
+static int
+sendfile_get_data (int fd, rtems_libio_t *iop, off_t offset, size_t count,
+    struct zero_copy_ref **zcp, size_t *len)
+{
+	struct zero_copy_ref *zc;
+	size_t lent = 0;
+	ssize_t n = 0;
+	int eno = 0;
+
+	*len = 0;
+	zc = zero_copy_alloc (0, M_NOWAIT);
+	if (zc == NULL)
+		return ENOMEM;
+	while (zc->loan_count < SENDFILE_LOAN_MAX && lent < count) {
+		rtems_filesystem_loan *loan = &zc->loans[zc->loan_count];
+
+		loan->release = NULL;
+		n = (*iop->pathinfo.handlers->loan_h)(iop, offset + lent,
+		    count - lent, loan);
+		if (n <= 0) {
+			eno = n < 0 ? errno : 0;
+			break;
+		}
+		zc->loan_len[zc->loan_count] = n;
+		++zc->loan_count;
+		lent += n;
+	}
+	if (lent >= SENDFILE_MIN_LOAN || (lent > 0 && (n == 0 || lent == count))) {
+		*zcp = zc;
+		*len = lent;
+		return 0;
+	}
+	zero_copy_release_loans (zc);
+	free (zc, M_TEMP);
+	if (lent == 0 && eno != 0 && eno != ENOTSUP)
+		return eno;
+
+	/*
+	 * Allocate the copy buffer only now, most chunks of file systems which
+	 * lend their data do not need it.
+	 */
+	if (count > SENDFILE_COPY_SIZE)
+		count = SENDFILE_COPY_SIZE;
+	zc = zero_copy_alloc (count, M_NOWAIT);
+	if (zc == NULL)
+		return ENOMEM;
+	n = pread (fd, zc + 1, count, offset);
+	if (n <= 0) {
+		free (zc, M_TEMP);
+		return n < 0 ? errno : 0;
+	}
+	zc->loans[0].data = zc + 1;
+	zc->loans[0].release = NULL;
+	zc->loans[0].arg = NULL;
+	zc->loan_len[0] = n;
+	zc->loan_count = 1;
+	*zcp = zc;
+	*len = n;
+	return 0;
+}
+
+static int
+sendfile_iov (int s, struct iovec *iov, int iovcnt, off_t *sent)
+{
+	struct msghdr msg;
+	ssize_t len = 0;
+	ssize_t n;
+	int i;
+
+	if (iov == NULL)
+		return 0;
+	for (i = 0; i < iovcnt; i++)
+		len += iov[i].iov_len;
+	memset (&msg, 0, sizeof msg);
+	msg.msg_iov = iov;
+	msg.msg_iovlen = iovcnt;
+	n = sendmsg (s, &msg, 0);
+	if (n < 0)
+		return errno;
+	*sent += n;
+	return n == len ? 0 : EAGAIN;
+}
+
+/*
+ * Send a file on a stream socket.  The file data is lent to the network
+ * stack if the file system supports it, otherwise it is copied once.
+ */
+int
+sendfile (int fd, int s, off_t offset, size_t nbytes, struct sf_hdtr *hdtr,
+    off_t *sbytes, int flags)
+{
+	int error = 0;
+	off_t sent = 0;
+	size_t done = 0;
+	rtems_libio_t *iop;
+	struct socket *so;
+
+	if (sbytes != NULL)
+		*sbytes = 0;
+	if (flags != 0 || offset < 0) {
+		errno = EINVAL;
+		return -1;
+	}
+	if ((uint32_t)fd >= rtems_libio_number_iops) {
+		errno = EBADF;
+		return -1;
+	}
+	iop = &rtems_libio_iops[fd];
+	if ((iop->flags & LIBIO_FLAGS_READ) == 0
+	    || !rtems_libio_iop_hold (iop)) {
+		errno = EBADF;
+		return -1;
+	}
+	rtems_bsdnet_semaphore_obtain ();
+	if ((so = rtems_bsdnet_fdToSocket (s)) == NULL) {
+		rtems_bsdnet_semaphore_release ();
+		rtems_libio_iop_drop (iop);
+		return -1;
+	}
+	if (so->so_type != SOCK_STREAM)
+		error = EINVAL;
+	rtems_bsdnet_semaphore_release ();
+
+	if (error == 0 && hdtr != NULL)
+		error = sendfile_iov (s, hdtr->headers, hdtr->hdr_cnt, &sent);
+	while (error == 0 && (nbytes == 0 || done < nbytes)) {
+		struct zero_copy_ref *zc;
+		size_t count = SENDFILE_CHUNK_SIZE;
+		size_t len;
+		size_t n;
+
+		if (nbytes != 0 && nbytes - done < count)
+			count = nbytes - done;
+		error = sendfile_get_data (fd, iop, offset + done, count, &zc, &len);
+		if (error != 0 || len == 0)
+			break;
+		rtems_bsdnet_semaphore_obtain ();
+		error = zero_copy_send (s, zc, len, 0, &n);
+		rtems_bsdnet_semaphore_release ();
+		done += n;
+		sent += n;
+	}
+	rtems_libio_iop_drop (iop);
+	if (error == 0 && hdtr != NULL)
+		error = sendfile_iov (s, hdtr->trailers, hdtr->trl_cnt, &sent);
+	if (sbytes != NULL)
+		*sbytes = sent;
+	if (error) {
+		if (error == EWOULDBLOCK)
+			error = EAGAIN;
+		errno = error;
+		return -1;
+	}
+	return 0;
+}
+
 /*
  * All `receive' operations end up calling this routine.
  */
@@ -804,6 +1173,20 @@ rtems_bsdnet_fcntl (rtems_libio_t *iop, int cmd)
         return 0;
 }
 
+/*
+ * The libio lock is held by the caller, so the network semaphore must not be
+ * obtained here.  Attaching the filter does not need it.
+ */
+static int
+rtems_bsdnet_kqfilter (rtems_libio_t *iop, struct knote *kn)
+{
+	struct socket *so;
+
+	if ((so = iop->data1) == NULL)
+		return EBADF;
+	return sokqfilter (so, kn);
+}
+
 static int
 rtems_bsdnet_fstat (const rtems_filesystem_location_info_t *loc, struct stat *sp)
 {
@@ -823,8 +1206,11 @@ static const rtems_filesystem_file_handlers_r socket_handlers = {
 	.fsync_h = rtems_filesystem_default_fsync_or_fdatasync,
 	.fdatasync_h = rtems_filesystem_default_fsync_or_fdatasync,
 	.fcntl_h = rtems_bsdnet_fcntl,
-	.kqfilter_h = rtems_filesystem_default_kqfilter,
+	.kqfilter_h = rtems_bsdnet_kqfilter,
 	.poll_h = rtems_filesystem_default_poll,
 	.readv_h = rtems_filesystem_default_readv,
-	.writev_h = rtems_filesystem_default_writev
+	.writev_h = rtems_filesystem_default_writev,
+	.loan_h = rtems_filesystem_default_loan,
+	.preadv_h = rtems_filesystem_default_preadv,
+	.pwritev_h = rtems_filesystem_default_pwritev
 };
@@ -38,16 +38,36 @@
 #ifndef _SYS_CALLOUT_H_
 #define _SYS_CALLOUT_H_
 
+#include <sys/queue.h>
+
+/*
+ * A callout calls a function once after a number of clock ticks.  The
+ * pending callouts are kept in a timing wheel, see rtems_glue.c.  The
+ * wheel runs on the callout clock, which counts CALLOUT_HZ times a second
+ * independent of the clock tick.  callout_reset() takes clock ticks (hz),
+ * callout_reset_hr() takes callout clock units.
+ */
+#define	CALLOUT_HZ	10000
+
 struct callout {
-	struct	callout *c_next;		/* next callout in queue */
+	LIST_ENTRY(callout) c_links;		/* timing wheel slot chain */
 	void	*c_arg;				/* function argument */
 	void	(*c_func)(void *);		/* function to call */
-	int	c_time;				/* ticks to the event */
+	u_int	c_time;				/* callout clock of the event */
+	int	c_flags;			/* state of this entry */
 };
 
+#define	CALLOUT_LOCAL_ALLOC	0x0001	/* allocated by timeout() */
+#define	CALLOUT_PENDING		0x0002	/* on the timing wheel */
+
 #ifdef _KERNEL
-extern struct	callout *callfree, *callout, calltodo;
-extern int	ncallout;
+#define	callout_pending(c)	((c)->c_flags & CALLOUT_PENDING)
+
+void	callout_init(struct callout *);
+void	callout_reset(struct callout *, int, void (*)(void *), void *);
+void	callout_reset_hr(struct callout *, int, void (*)(void *), void *);
+void	callout_stop(struct callout *);
+u_int	callout_now(void);
 #endif
 
 #endif
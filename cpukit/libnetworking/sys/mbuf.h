@@ -81,6 +81,9 @@ struct m_hdr {
 struct	pkthdr {
 	struct	ifnet *rcvif;		/* rcv interface */
 	int32_t	len;			/* total packet length */
+	int	csum_flags;		/* checksum and offload flags */
+	int	csum_data;		/* data field used by csum routines */
+	u_short	tso_segsz;		/* TCP segment size for CSUM_TSO */
 };
 
 /*
@@ -95,6 +98,19 @@ struct m_ext {
 		(caddr_t, u_int);
 };
 
+/*
+ * RTEMS: Reference counted external storage which is not owned by the
+ * network stack, e.g. file data sent by sendfile().  The m_ext.ext_buf of
+ * the mbufs points to this structure and m_data to the data, so
+ * M_TRAILINGSPACE() must not be used on them.  The free routine is called
+ * with the network semaphore held once the last mbuf is freed.
+ */
+struct m_extref {
+	int	er_refcnt;		/* mbufs and owner references */
+	void	(*er_free)		/* called for the last reference */
+		(struct m_extref *);
+};
+
 /*
  * The core of the mbuf object along with some shortcut defines for
  * practical purposes.
@@ -143,6 +159,38 @@ struct mbuf {
  */
 #define	M_COPYFLAGS	(M_PKTHDR|M_EOR|M_PROTO1|M_BCAST|M_MCAST)
 
+/*
+ * Flags indicating hw checksum support and sw checksum requirements.
+ *
+ * On output the CSUM_IP, CSUM_TCP, CSUM_UDP and CSUM_TSO flags request work
+ * from the interface.  The protocol computes only the pseudo-header sum and
+ * stores the offset of the checksum field relative to the end of the IP
+ * header in csum_data.  Work not covered by the if_hwassist of the outgoing
+ * interface is done in software by ip_output().  For CSUM_TSO the pseudo
+ * header sum excludes the TCP length and tso_segsz is the payload size of the
+ * segments, an interface with CSUM_TSO must also provide CSUM_TCP.
+ *
+ * On input the driver reports the checks already done by the hardware.
+ *
+ * A record passed from sosend() to a protocol with PR_CKSUMCOPY has
+ * CSUM_DATA_SUM set and the sum of its data in csum_data, see
+ * in_cksum_data().
+ */
+#define	CSUM_IP		0x0001	/* will csum IP */
+#define	CSUM_TCP	0x0002	/* will csum TCP */
+#define	CSUM_UDP	0x0004	/* will csum UDP */
+#define	CSUM_TSO	0x0020	/* will do TCP segmentation */
+
+#define	CSUM_IP_CHECKED	0x0100	/* did csum IP */
+#define	CSUM_IP_VALID	0x0200	/*   ... the csum is valid */
+#define	CSUM_DATA_VALID	0x0400	/* csum_data field is valid */
+#define	CSUM_PSEUDO_HDR	0x0800	/* csum_data has pseudo hdr */
+
+#define	CSUM_DATA_SUM	0x1000	/* csum_data has sum of data */
+
+#define	CSUM_DELAY_DATA	(CSUM_TCP | CSUM_UDP)
+#define	CSUM_DELAY_IP	(CSUM_IP)
+
 /*
  * mbuf types.
  */
@@ -176,6 +224,19 @@ struct mbstat {
 	u_short	m_mtypes[256];	/* type specific mbuf allocations */
 };
 
+/*
+ * RTEMS: Statistics of the mbuf and cluster cache of a processor.
+ */
+struct mbcpustat {
+	u_long	mc_mbufs;	/* free mbufs in the cache */
+	u_long	mc_clusters;	/* free clusters in the cache */
+	u_long	mc_hits;	/* allocations satisfied by the cache */
+	u_long	mc_refills;	/* batches obtained from the global pool */
+	u_long	mc_drains;	/* batches returned to the global pool */
+	u_long	mc_waits;	/* times waited for space */
+	u_long	mc_wait_ticks;	/* clock ticks spent waiting for space */
+};
+
 
 /* flags to m_get/MGET */
 #define	M_DONTWAIT	M_NOWAIT
@@ -216,43 +277,24 @@ union mcluster {
  * and internal data.
  */
 #define	MGET(m, how, type) { \
-	  int _ms = splimp(); \
-	  if (mmbfree == 0) \
-		(void)m_mballoc(1, (how)); \
-	  if (((m) = mmbfree) != 0) { \
-		mmbfree = (m)->m_next; \
-		mbstat.m_mtypes[MT_FREE]--; \
-		(m)->m_type = (type); \
-		mbstat.m_mtypes[type]++; \
+	  if (((m) = m_cache_get_mbuf((how), (type))) != 0) { \
 		(m)->m_next = (struct mbuf *)NULL; \
 		(m)->m_nextpkt = (struct mbuf *)NULL; \
 		(m)->m_data = (m)->m_dat; \
 		(m)->m_flags = 0; \
-		splx(_ms); \
-	} else { \
-		splx(_ms); \
+	} else \
 		(m) = m_retry((how), (type)); \
-	} \
 }
 
 #define	MGETHDR(m, how, type) { \
-	  int _ms = splimp(); \
-	  if (mmbfree == 0) \
-		(void)m_mballoc(1, (how)); \
-	  if (((m) = mmbfree) != 0) { \
-		mmbfree = (m)->m_next; \
-		mbstat.m_mtypes[MT_FREE]--; \
-		(m)->m_type = (type); \
-		mbstat.m_mtypes[type]++; \
+	  if (((m) = m_cache_get_mbuf((how), (type))) != 0) { \
 		(m)->m_next = (struct mbuf *)NULL; \
 		(m)->m_nextpkt = (struct mbuf *)NULL; \
 		(m)->m_data = (m)->m_pktdat; \
 		(m)->m_flags = M_PKTHDR; \
-		splx(_ms); \
-	} else { \
-		splx(_ms); \
+		(m)->m_pkthdr.csum_flags = 0; \
+	} else \
 		(m) = m_retryhdr((how), (type)); \
-	} \
 }
 
 /*
@@ -265,13 +307,7 @@ union mcluster {
  */
 #define	MCLALLOC(p, how) \
 	MBUFLOCK( \
-	  if (mclfree == 0) \
-		(void)m_clalloc(1, (how)); \
-	  if (((p) = (caddr_t)mclfree) != 0) { \
-		++mclrefcnt[mtocl(p)]; \
-		mbstat.m_clfree--; \
-		mclfree = ((union mcluster *)(p))->mcl_next; \
-	  } \
+	  (p) = m_cache_get_cluster(how); \
 	)
 
 #define	MCLGET(m, how) \
@@ -287,11 +323,8 @@ union mcluster {
 
 #define	MCLFREE(p) \
 	MBUFLOCK ( \
-	  if (--mclrefcnt[mtocl(p)] == 0) { \
-		((union mcluster *)(p))->mcl_next = mclfree; \
-		mclfree = (union mcluster *)(p); \
-		mbstat.m_clfree++; \
-	  } \
+	  if (--mclrefcnt[mtocl(p)] == 0) \
+		m_cache_put_cluster(p); \
 	)
 
 /*
@@ -301,25 +334,18 @@ union mcluster {
  */
 #define	MFREE(m, n) \
 	MBUFLOCK(  \
-	  mbstat.m_mtypes[(m)->m_type]--; \
 	  if ((m)->m_flags & M_EXT) { \
 		if ((m)->m_ext.ext_free) \
 			(*((m)->m_ext.ext_free))((m)->m_ext.ext_buf, \
 			    (m)->m_ext.ext_size); \
 		else { \
 			char *p = (m)->m_ext.ext_buf; \
-			if (--mclrefcnt[mtocl(p)] == 0) { \
-				((union mcluster *)(p))->mcl_next = mclfree; \
-				mclfree = (union mcluster *)(p); \
-				mbstat.m_clfree++; \
-			} \
+			if (--mclrefcnt[mtocl(p)] == 0) \
+				m_cache_put_cluster(p); \
 		} \
 	  } \
 	  (n) = (m)->m_next; \
-	  (m)->m_type = MT_FREE; \
-	  mbstat.m_mtypes[MT_FREE]++; \
-	  (m)->m_next = mmbfree; \
-	  mmbfree = (m); \
+	  m_cache_put_mbuf(m); \
 	)
 
 /*
@@ -386,10 +412,7 @@ union mcluster {
  * Change mbuf to new type.
  * This is a relatively expensive operation and should be avoided.
  */
-#define MCHTYPE(m, t) { \
-	MBUFLOCK(mbstat.m_mtypes[(m)->m_type]--; mbstat.m_mtypes[t]++;) \
-	(m)->m_type = t;\
-}
+#define MCHTYPE(m, t) m_cache_chtype((m), (t))
 
 /* Length to m_copy to copy all. */
 #define	M_COPYALL	(uint32_t)1000000000L
@@ -403,8 +426,6 @@ extern char	*mclrefcnt;		/* cluster reference counts */
 extern struct mbstat mbstat;
 extern uint32_t	nmbclusters;
 extern uint32_t	nmbufs;
-extern struct mbuf *mmbfree;
-extern union mcluster *mclfree;
 extern int	max_linkhdr;		/* largest link-level header */
 extern int	max_protohdr;		/* largest protocol header */
 extern int	max_hdr;		/* largest link+protocol header */
@@ -425,12 +446,24 @@ struct	mbuf *m_retryhdr(int, int);
 struct	mbuf *m_split(struct mbuf *,int,int);
 void	m_adj(struct mbuf *, int);
 void	m_cat(struct mbuf *,struct mbuf *);
-int	m_mballoc(int, int);
-int	m_clalloc(int, int);
 int	m_copyback(struct mbuf *, int, int, caddr_t);
 int	m_copydata(const struct mbuf *, int, int, caddr_t);
+int	m_copydata_cksum(const struct mbuf *, int, int, caddr_t, u_short *);
 void	m_freem(struct mbuf *);
 void	m_reclaim(void);
+void	m_extref_init(struct m_extref *, void (*)(struct m_extref *));
+void	m_extref_add(struct mbuf *, struct m_extref *, caddr_t, int);
+void	m_extref_rele(struct m_extref *);
+int	m_cache_init(caddr_t, int, caddr_t, int);
+struct	mbuf *m_cache_get_mbuf(int, int);
+void	m_cache_put_mbuf(struct mbuf *);
+caddr_t	m_cache_get_cluster(int);
+void	m_cache_put_cluster(caddr_t);
+int	m_cache_stat(uint32_t, struct mbcpustat *);
+void	m_cache_mbstat(struct mbstat *);
+void	m_cache_chtype(struct mbuf *, int);
+struct	mbuf *m_gethdr_unlocked(int, int);
+int	m_clget_unlocked(struct mbuf *, int);
 
 #endif /* _KERNEL */
 
@@ -103,6 +103,10 @@ struct protosw {
  *	and the protocol understands the MSG_EOF flag.  The first property is
  *	is only relevant if PR_CONNREQUIRED is set (otherwise sendto is allowed
  *	anyhow).
+ * PR_CKSUMCOPY means that sosend() sums the data of a record while it is
+ *	copied from user space, see CSUM_DATA_SUM.  It requires PR_ATOMIC.
+ *	The data is not summed if the interface of the cached route does the
+ *	checksum, see in_pcbcksumcopy().
  */
 #define	PR_ATOMIC	0x01		/* exchange atomic messages only */
 #define	PR_ADDR		0x02		/* addresses given with messages */
@@ -111,6 +115,7 @@ struct protosw {
 #define	PR_RIGHTS	0x10		/* passes capabilities */
 #define PR_IMPLOPCL	0x20		/* implied open/close */
 #define	PR_LASTHDR	0x40		/* enforce ipsec policy; last header */
+#define	PR_CKSUMCOPY	0x80		/* sum data while copying it in */
 
 /*
  * The arguments to usrreq are:
@@ -35,6 +35,7 @@
 
 #include <sys/queue.h>			/* for TAILQ macros */
 #include <sys/select.h>			/* for struct selinfo */
+#include <sys/event.h>			/* for struct knlist */
 
 
 /*
@@ -90,6 +91,7 @@ struct socket {
 		int	sb_timeo;	/* timeout for read/write */
 		void	(*sb_wakeup)(struct socket *, void *);
 		void 	*sb_wakeuparg;	/* arg for above */
+		struct	knlist sb_note;	/* kevent() filters, must be last */
 	} so_rcv, so_snd;
 #define	SB_MAX		(256L*1024L)	/* default for max chars in sockbuf */
 #define	SB_LOCK		0x01		/* lock on data queue */
@@ -181,7 +183,7 @@ struct socket {
  */
 #define sblock(sb, wf) ((sb)->sb_flags & SB_LOCK ? \
 		(((wf) == M_WAITOK) ? sb_lock(sb) : EWOULDBLOCK) : \
-		((sb)->sb_flags |= SB_LOCK), 0)
+		((sb)->sb_flags |= SB_LOCK, 0))
 
 /* release lock on sockbuf sb */
 #define	sbunlock(sb) { \
@@ -207,6 +209,7 @@ extern u_long	sb_max;
 
 struct filedesc;
 struct mbuf;
+struct m_extref;
 struct sockaddr;
 struct stat;
 
@@ -240,6 +243,7 @@ void	socantsendmore(struct socket *so);
 int	soclose(struct socket *so);
 int	soconnect(struct socket *so, struct mbuf *nam);
 int	soconnect2(struct socket *so1, struct socket *so2);
+int	sokqfilter(struct socket *so, struct knote *kn);
 int	socreate(int dom, struct socket **aso, int type, int proto,
 	    struct proc *p);
 int	sodisconnect(struct socket *so);
@@ -262,6 +266,9 @@ int	soreserve(struct socket *so, u_long sndcc, u_long rcvcc);
 void	sorflush(struct socket *so);
 int	sosend(struct socket *so, struct mbuf *addr, struct uio *uio,
 	    struct mbuf *top, struct mbuf *control, int flags);
+int	sosend_extref(struct socket *so, struct mbuf *addr, struct uio *uio,
+	    struct mbuf *top, struct mbuf *control, int flags,
+	    struct m_extref *er);
 int	sosetopt(struct socket *so, int level, int optname,
 	    struct mbuf *m0);
 int	soshutdown(struct socket *so, int how);
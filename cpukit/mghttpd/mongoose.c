@@ -211,6 +211,7 @@ typedef struct DIR {
 #include <sys/poll.h>
 #endif
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <arpa/inet.h>
 #include <sys/time.h>
 #include <stdint.h>
@@ -457,6 +458,30 @@ struct socket {
   unsigned ssl_redir:1; // Is port supposed to redirect everything to SSL port
 };
 
+// Describes keep-alive connection which waits for its next request. Worker
+// threads park such connections in the master thread, which watches them
+// together with the listening sockets. This way a few worker threads can
+// serve many persistent connections.
+struct idle_socket {
+  struct socket client; // Connected client
+  time_t park_time;     // Time when connection became idle
+};
+
+// Describes static file contents held in memory. Entries are shared by the
+// worker threads and are protected by the context mutex.
+struct file_cache_entry {
+  struct file_cache_entry *next;  // Next entry, most recently used first
+  char *path;                     // File system path
+  dev_t dev;                      // Device, inode, modification time,
+  ino_t ino;                      // change time and size are used to
+  time_t modification_time;       // detect file changes
+  time_t change_time;
+  int64_t size;
+  int refs;                       // Number of requests sending this data
+  int is_stale;                   // Entry was removed from the cache
+  char data[1];                   // File contents, followed by path
+};
+
 // NOTE(lsm): this enum shoulds be in sync with the config_options below.
 enum {
   CGI_EXTENSIONS, CGI_ENVIRONMENT, PUT_DELETE_PASSWORDS_FILE, CGI_INTERPRETER,
@@ -465,7 +490,8 @@ enum {
   GLOBAL_PASSWORDS_FILE, INDEX_FILES, ENABLE_KEEP_ALIVE, ACCESS_CONTROL_LIST,
   EXTRA_MIME_TYPES, LISTENING_PORTS, DOCUMENT_ROOT, SSL_CERTIFICATE,
   NUM_THREADS, RUN_AS_USER, REWRITE, HIDE_FILES, REQUEST_TIMEOUT,
-  THREAD_STACK_SIZE, THREAD_PRIORITY, THREAD_POLICY,
+  THREAD_STACK_SIZE, THREAD_PRIORITY, THREAD_POLICY, MAX_IDLE_CONNECTIONS,
+  FILE_CACHE_SIZE, ENABLE_TCP_NODELAY,
   NUM_OPTIONS
 };
 
@@ -498,6 +524,9 @@ static const char *config_options[] = {
   "thread_stack_size", NULL,
   "thread_priority", NULL,
   "thread_policy", NULL,
+  "max_idle_connections", "0",
+  "file_cache_size", "0",
+  "enable_tcp_nodelay", "no",
   NULL
 };
 
@@ -520,6 +549,16 @@ struct mg_context {
   volatile int sq_tail;      // Tail of the socket queue
   pthread_cond_t sq_full;    // Signaled when socket is produced
   pthread_cond_t sq_empty;   // Signaled when socket is consumed
+
+  struct idle_socket *idle_sockets; // Parked keep-alive connections
+  int num_idle_sockets;      // Number of parked connections
+  int max_idle_sockets;      // Capacity of idle_sockets, 0 disables parking
+  SOCKET wakeup_sock;        // Wakes up master when connection is parked
+  union usa wakeup_sa;       // Local address of wakeup_sock
+
+  struct file_cache_entry *file_cache; // Cached static files
+  int64_t file_cache_used;   // Total size of cached file contents
+  int64_t file_cache_size;   // Cache capacity in bytes, 0 disables cache
 };
 
 struct mg_connection {
@@ -2954,8 +2993,29 @@ static void send_file_data(struct mg_connection *conn, struct file *filep,
     if (len > filep->size - offset) {
       len = filep->size - offset;
     }
-    mg_write(conn, filep->membuf + offset, (size_t) len);
+    if ((num_written = mg_write(conn, filep->membuf + offset,
+                                (size_t) len)) > 0) {
+      conn->num_bytes_sent += num_written;
+    }
   } else if (len > 0 && filep->fp != NULL) {
+#if defined(__rtems__)
+    if (conn->ssl == NULL && conn->throttle <= 0) {
+      // Let the network stack send the file data without a copy into buf
+      off_t sent = 0;
+      int rv = sendfile(fileno(filep->fp), conn->client.sock, (off_t) offset,
+                        (size_t) len, NULL, &sent, 0);
+
+      conn->num_bytes_sent += sent;
+      offset += sent;
+      len -= sent;
+
+      // Copy the rest only if sendfile() does not work for this file or
+      // socket, otherwise the connection is broken
+      if (rv == 0 || (errno != EINVAL && errno != ENOTSUP)) {
+        len = 0;
+      }
+    }
+#endif // __rtems__
     fseeko(filep->fp, offset, SEEK_SET);
     while (len > 0) {
       // Calculate how much to read from the file in the buffer
@@ -3003,6 +3063,161 @@ static void fclose_on_exec(struct file *filep) {
   }
 }
 
+// Remove entry from the file cache. It is freed as soon as no request sends
+// its data. Must be called with the context mutex held.
+static void evict_file_cache_entry(struct mg_context *ctx,
+                                   struct file_cache_entry **link) {
+  struct file_cache_entry *entry = *link;
+
+  *link = entry->next;
+  ctx->file_cache_used -= entry->size;
+  entry->is_stale = 1;
+  if (entry->refs == 0) {
+    free(entry);
+  }
+}
+
+static int is_same_file(const struct file_cache_entry *entry,
+                        const struct stat *st) {
+  return entry->dev == st->st_dev && entry->ino == st->st_ino &&
+    entry->modification_time == st->st_mtime &&
+    entry->change_time == st->st_ctime && entry->size == st->st_size;
+}
+
+// Return cached contents of given file, read the file into the cache if
+// necessary. Cached data is valid as long as device, inode, modification
+// time, change time and size of the file do not change. Returned entry must
+// be released with release_cached_file(). Return NULL if the file cannot be
+// cached.
+static struct file_cache_entry *get_cached_file(struct mg_connection *conn,
+                                                const char *path,
+                                                const struct file *filep) {
+  struct mg_context *ctx = conn->ctx;
+  struct file_cache_entry *entry, **link;
+  struct stat st;
+  size_t path_len;
+  FILE *fp;
+  int ok = 0;
+
+  if (filep->is_directory || filep->size > ctx->file_cache_size ||
+      stat(path, &st) != 0 || st.st_size != filep->size) {
+    return NULL;
+  }
+
+  (void) pthread_mutex_lock(&ctx->mutex);
+  for (link = &ctx->file_cache; (entry = *link) != NULL; link = &entry->next) {
+    if (strcmp(entry->path, path) == 0) {
+      if (is_same_file(entry, &st)) {
+        // Cache hit, move entry to the front
+        *link = entry->next;
+        entry->next = ctx->file_cache;
+        ctx->file_cache = entry;
+        entry->refs++;
+      } else {
+        evict_file_cache_entry(ctx, link);
+        entry = NULL;
+      }
+      break;
+    }
+  }
+  (void) pthread_mutex_unlock(&ctx->mutex);
+
+  if (entry != NULL) {
+    return entry;
+  }
+
+  // Time stamps have a resolution of one second. A file changed in the
+  // current second may change again without a visible change of its
+  // attributes, so it is not cached yet.
+  if (st.st_mtime >= time(NULL) || st.st_ctime >= time(NULL)) {
+    return NULL;
+  }
+
+  // Cache miss. Read the file without holding the lock.
+  path_len = strlen(path);
+  entry = (struct file_cache_entry *)
+    malloc(sizeof(*entry) + (size_t) st.st_size + path_len);
+  if (entry == NULL) {
+    return NULL;
+  }
+  if ((fp = fopen(path, "rb")) != NULL) {
+    ok = fread(entry->data, 1, (size_t) st.st_size, fp) ==
+      (size_t) st.st_size;
+    fclose(fp);
+  }
+
+  entry->dev = st.st_dev;
+  entry->ino = st.st_ino;
+  entry->modification_time = st.st_mtime;
+  entry->change_time = st.st_ctime;
+  entry->size = st.st_size;
+
+  // Do not cache data which changed while it was read
+  if (!ok || stat(path, &st) != 0 || !is_same_file(entry, &st)) {
+    free(entry);
+    return NULL;
+  }
+
+  entry->path = entry->data + entry->size;
+  memcpy(entry->path, path, path_len + 1);
+  entry->refs = 1;
+  entry->is_stale = 0;
+
+  (void) pthread_mutex_lock(&ctx->mutex);
+
+  // Another thread may have cached the same file in the meantime
+  link = &ctx->file_cache;
+  while (*link != NULL) {
+    if (strcmp((*link)->path, path) == 0) {
+      evict_file_cache_entry(ctx, link);
+    } else {
+      link = &(*link)->next;
+    }
+  }
+
+  // Make room, the least recently used entry is at the end of the list
+  while (ctx->file_cache_used + entry->size > ctx->file_cache_size) {
+    for (link = &ctx->file_cache; (*link)->next != NULL;
+         link = &(*link)->next) {
+    }
+    evict_file_cache_entry(ctx, link);
+  }
+
+  entry->next = ctx->file_cache;
+  ctx->file_cache = entry;
+  ctx->file_cache_used += entry->size;
+  (void) pthread_mutex_unlock(&ctx->mutex);
+
+  return entry;
+}
+
+// Remove file from the cache before it is written or deleted by a request.
+static void invalidate_cached_file(struct mg_context *ctx, const char *path) {
+  struct file_cache_entry **link;
+
+  if (ctx->file_cache_size > 0) {
+    (void) pthread_mutex_lock(&ctx->mutex);
+    link = &ctx->file_cache;
+    while (*link != NULL) {
+      if (strcmp((*link)->path, path) == 0) {
+        evict_file_cache_entry(ctx, link);
+      } else {
+        link = &(*link)->next;
+      }
+    }
+    (void) pthread_mutex_unlock(&ctx->mutex);
+  }
+}
+
+static void release_cached_file(struct mg_context *ctx,
+                                struct file_cache_entry *entry) {
+  (void) pthread_mutex_lock(&ctx->mutex);
+  if (--entry->refs == 0 && entry->is_stale) {
+    free(entry);
+  }
+  (void) pthread_mutex_unlock(&ctx->mutex);
+}
+
 static void handle_file_request(struct mg_connection *conn, const char *path,
                                 struct file *filep) {
   char date[64], lm[64], etag[64], range[64];
@@ -3013,6 +3228,7 @@ static void handle_file_request(struct mg_connection *conn, const char *path,
   int n;
   char gz_path[PATH_MAX];
   char const* encoding = "";
+  struct file_cache_entry *cache_entry = NULL;
 
   get_mime_type(conn->ctx, path, &mime_vec);
   cl = filep->size;
@@ -3028,7 +3244,12 @@ static void handle_file_request(struct mg_connection *conn, const char *path,
     encoding = "Content-Encoding: gzip\r\n";
   }
 
-  if (!mg_fopen(conn, path, "rb", filep)) {
+  // Serve static files from memory if the file cache is enabled
+  if (conn->ctx->file_cache_size > 0 && !filep->gzipped &&
+      filep->membuf == NULL &&
+      (cache_entry = get_cached_file(conn, path, filep)) != NULL) {
+    filep->membuf = cache_entry->data;
+  } else if (!mg_fopen(conn, path, "rb", filep)) {
     send_http_error(conn, 500, http_500_error,
                     "fopen(%s): %s", path, strerror(ERRNO));
     return;
@@ -3080,6 +3301,9 @@ static void handle_file_request(struct mg_connection *conn, const char *path,
     send_file_data(conn, filep, r1, cl);
   }
   mg_fclose(filep);
+  if (cache_entry != NULL) {
+    release_cached_file(conn->ctx, cache_entry);
+  }
 }
 
 void mg_send_file(struct mg_connection *conn, const char *path) {
@@ -3685,6 +3909,8 @@ static void put_file(struct mg_connection *conn, const char *path) {
   int64_t r1, r2;
   int rc;
 
+  invalidate_cached_file(conn->ctx, path);
+
   conn->status_code = mg_stat(conn, path, &file) ? 200 : 201;
 
   if ((rc = put_dir(conn, path)) == 0) {
@@ -4534,6 +4760,7 @@ static void handle_request(struct mg_connection *conn) {
     mkcol(conn, path);
   } else if (!strcmp(ri->request_method, "DELETE")) {
       struct de de;
+      invalidate_cached_file(conn->ctx, path);
       memset(&de.file, 0, sizeof(de.file));
       if(!mg_stat(conn, path, &de.file)) {
           send_http_error(conn, 404, "Not Found", "%s", "File not found");
@@ -4954,6 +5181,39 @@ static int set_acl_option(struct mg_context *ctx) {
   return check_acl(ctx, (uint32_t) 0x7f000001UL) != -1;
 }
 
+// Parking of idle keep-alive connections needs a datagram socket bound to the
+// loopback interface to wake up the master thread, since poll() may only
+// support sockets.
+static int set_idle_connections_option(struct mg_context *ctx) {
+  int max_idle = atoi(ctx->config[MAX_IDLE_CONNECTIONS]);
+  socklen_t len = sizeof(ctx->wakeup_sa);
+
+  if (max_idle <= 0) {
+    return 1;
+  }
+
+  memset(&ctx->wakeup_sa, 0, sizeof(ctx->wakeup_sa));
+  ctx->wakeup_sa.sin.sin_family = AF_INET;
+  ctx->wakeup_sa.sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  if ((ctx->idle_sockets = (struct idle_socket *)
+       calloc(max_idle, sizeof(ctx->idle_sockets[0]))) == NULL ||
+      (ctx->wakeup_sock = socket(PF_INET, SOCK_DGRAM, 0)) == INVALID_SOCKET ||
+      bind(ctx->wakeup_sock, &ctx->wakeup_sa.sa,
+           sizeof(ctx->wakeup_sa.sin)) != 0 ||
+      getsockname(ctx->wakeup_sock, &ctx->wakeup_sa.sa, &len) != 0) {
+    cry(fc(ctx), "%s: cannot set up idle connections: %s", __func__,
+        strerror(ERRNO));
+    return 0;
+  }
+
+  set_non_blocking_mode(ctx->wakeup_sock);
+  set_close_on_exec(ctx->wakeup_sock);
+  ctx->max_idle_sockets = max_idle;
+
+  return 1;
+}
+
 static void reset_per_request_attributes(struct mg_connection *conn) {
   conn->path_info = NULL;
   conn->num_bytes_sent = conn->consumed_content = 0;
@@ -5120,6 +5380,52 @@ struct mg_connection *mg_download(const char *host, int port, int use_ssl,
   return conn;
 }
 
+// Wake up the master thread, so that it watches newly parked connections.
+static void wakeup_master(struct mg_context *ctx) {
+  char c = 0;
+
+  (void) sendto(ctx->wakeup_sock, &c, 1, 0, &ctx->wakeup_sa.sa,
+                sizeof(ctx->wakeup_sa.sin));
+}
+
+// Hand idle keep-alive connection over to the master thread, which queues it
+// again for the worker threads once the next request arrives. Return 1 if the
+// connection was parked, 0 if the worker must wait for the request itself.
+static int park_connection(struct mg_connection *conn) {
+  struct mg_context *ctx = conn->ctx;
+  struct idle_socket *idle;
+  int parked = 0;
+
+  // SSL connections carry state which is bound to the worker
+  if (ctx->max_idle_sockets > 0 && conn->ssl == NULL) {
+    (void) pthread_mutex_lock(&ctx->mutex);
+    if (ctx->stop_flag == 0 && ctx->num_idle_sockets < ctx->max_idle_sockets) {
+      idle = &ctx->idle_sockets[ctx->num_idle_sockets++];
+      idle->client = conn->client;
+      idle->park_time = time(NULL);
+      parked = 1;
+    }
+    (void) pthread_mutex_unlock(&ctx->mutex);
+  }
+
+  if (parked) {
+    conn->client.sock = INVALID_SOCKET;
+    wakeup_master(ctx);
+  }
+
+  return parked;
+}
+
+int mg_get_idle_connection_count(struct mg_context *ctx) {
+  int count;
+
+  (void) pthread_mutex_lock(&ctx->mutex);
+  count = ctx->num_idle_sockets;
+  (void) pthread_mutex_unlock(&ctx->mutex);
+
+  return count;
+}
+
 static void process_new_connection(struct mg_connection *conn) {
   struct mg_request_info *ri = &conn->request_info;
   int keep_alive_enabled, keep_alive, discard_len;
@@ -5174,6 +5480,12 @@ static void process_new_connection(struct mg_connection *conn) {
     conn->data_len -= discard_len;
     assert(conn->data_len >= 0);
     assert(conn->data_len <= conn->buf_size);
+
+    // Pipelined requests are already buffered and processed right away.
+    // Otherwise, let the master thread wait for the next request.
+    if (keep_alive && conn->data_len == 0 && park_connection(conn)) {
+      keep_alive = 0;
+    }
   } while (keep_alive);
 }
 
@@ -5318,15 +5630,54 @@ static void accept_new_connection(const struct socket *listener,
     // is down and will close the server end.
     // Thanks to Igor Klopov who suggested the patch.
     setsockopt(so.sock, SOL_SOCKET, SO_KEEPALIVE, (void *) &on, sizeof(on));
+    // Responses are written in pieces, e.g. headers and file data. With the
+    // Nagle algorithm the last piece of a response may wait for the delayed
+    // acknowledgement of the client, which stalls keep-alive connections and
+    // pipelined requests. Disabling it sends more small segments.
+    if (!mg_strcasecmp(ctx->config[ENABLE_TCP_NODELAY], "yes")) {
+      setsockopt(so.sock, IPPROTO_TCP, TCP_NODELAY, (void *) &on, sizeof(on));
+    }
     set_sock_timeout(so.sock, atoi(ctx->config[REQUEST_TIMEOUT]));
     produce_socket(ctx, &so);
   }
 }
 
+// Queue parked connections which received data or were closed by the
+// client, close connections which were idle for too long. The first n parked
+// connections were polled using pfd.
+static void resume_idle_sockets(struct mg_context *ctx,
+                                const struct pollfd *pfd, int n) {
+  struct socket so;
+  time_t now = time(NULL);
+  int timeout = atoi(ctx->config[REQUEST_TIMEOUT]) / 1000;
+  int i, ready, expired;
+
+  // Workers only append parked connections and removed entries are replaced
+  // by the last one, so going backwards visits each polled entry once.
+  for (i = n - 1; i >= 0; i--) {
+    (void) pthread_mutex_lock(&ctx->mutex);
+    so = ctx->idle_sockets[i].client;
+    ready = pfd[i].revents != 0;
+    expired = now - ctx->idle_sockets[i].park_time > timeout;
+    if (ready || expired) {
+      ctx->idle_sockets[i] = ctx->idle_sockets[--ctx->num_idle_sockets];
+    }
+    (void) pthread_mutex_unlock(&ctx->mutex);
+
+    if (ready) {
+      DEBUG_TRACE(("resuming socket %d", so.sock));
+      produce_socket(ctx, &so);
+    } else if (expired) {
+      closesocket(so.sock);
+    }
+  }
+}
+
 static void *master_thread(void *thread_func_param) {
   struct mg_context *ctx = (struct mg_context *) thread_func_param;
   struct pollfd *pfd;
-  int i;
+  char buf[16];
+  int i, n, num_idle;
 
   // Increase priority of the master thread
 #if defined(_WIN32)
@@ -5339,14 +5690,35 @@ static void *master_thread(void *thread_func_param) {
   pthread_setschedparam(pthread_self(), SCHED_RR, &sched_param);
 #endif
 
-  pfd = (struct pollfd *) calloc(ctx->num_listening_sockets, sizeof(pfd[0]));
+  // Listening sockets are followed by the wakeup socket and the parked
+  // connections, if parking is enabled
+  pfd = (struct pollfd *) calloc(ctx->num_listening_sockets + 1 +
+                                 ctx->max_idle_sockets, sizeof(pfd[0]));
   while (pfd != NULL && ctx->stop_flag == 0) {
     for (i = 0; i < ctx->num_listening_sockets; i++) {
       pfd[i].fd = ctx->listening_sockets[i].sock;
       pfd[i].events = POLLIN;
     }
+    n = ctx->num_listening_sockets;
+    num_idle = 0;
+
+    if (ctx->max_idle_sockets > 0) {
+      pfd[n].fd = ctx->wakeup_sock;
+      pfd[n].events = POLLIN;
+      pfd[n].revents = 0;
+      n++;
+
+      (void) pthread_mutex_lock(&ctx->mutex);
+      num_idle = ctx->num_idle_sockets;
+      for (i = 0; i < num_idle; i++) {
+        pfd[n + i].fd = ctx->idle_sockets[i].client.sock;
+        pfd[n + i].events = POLLIN;
+        pfd[n + i].revents = 0;
+      }
+      (void) pthread_mutex_unlock(&ctx->mutex);
+    }
 
-    if (poll(pfd, ctx->num_listening_sockets, 200) > 0) {
+    if (poll(pfd, n + num_idle, 200) > 0) {
       for (i = 0; i < ctx->num_listening_sockets; i++) {
         // NOTE(lsm): on QNX, poll() returns POLLRDNORM after the
         // successfull poll, and POLLIN is defined as (POLLRDNORM | POLLRDBAND)
@@ -5356,6 +5728,15 @@ static void *master_thread(void *thread_func_param) {
           accept_new_connection(&ctx->listening_sockets[i], ctx);
         }
       }
+
+      if (ctx->max_idle_sockets > 0 && (pfd[n - 1].revents & POLLIN)) {
+        while (recv(ctx->wakeup_sock, buf, sizeof(buf), 0) > 0) {
+        }
+      }
+    }
+
+    if (num_idle > 0 && ctx->stop_flag == 0) {
+      resume_idle_sockets(ctx, pfd + n, num_idle);
     }
   }
   free(pfd);
@@ -5374,6 +5755,12 @@ static void *master_thread(void *thread_func_param) {
   }
   (void) pthread_mutex_unlock(&ctx->mutex);
 
+  // Close parked connections
+  for (i = 0; i < ctx->num_idle_sockets; i++) {
+    closesocket(ctx->idle_sockets[i].client.sock);
+  }
+  ctx->num_idle_sockets = 0;
+
   // All threads exited, no sync is needed. Destroy mutex and condvars
   (void) pthread_mutex_destroy(&ctx->mutex);
   (void) pthread_cond_destroy(&ctx->cond);
@@ -5412,6 +5799,18 @@ static void free_context(struct mg_context *ctx) {
   }
 #endif // !NO_SSL
 
+  if (ctx->wakeup_sock != INVALID_SOCKET) {
+    closesocket(ctx->wakeup_sock);
+  }
+  free(ctx->idle_sockets);
+
+  // Deallocate cached files, all requests are done at this point
+  while (ctx->file_cache != NULL) {
+    struct file_cache_entry *entry = ctx->file_cache;
+    ctx->file_cache = entry->next;
+    free(entry);
+  }
+
   // Deallocate context itself
   free(ctx);
 }
@@ -5450,6 +5849,7 @@ struct mg_context *mg_start(const struct mg_callbacks *callbacks,
   }
   ctx->callbacks = *callbacks;
   ctx->user_data = user_data;
+  ctx->wakeup_sock = INVALID_SOCKET;
 
   while (options && (name = *options++) != NULL) {
     if ((i = get_option_index(name)) == -1) {
@@ -5487,11 +5887,14 @@ struct mg_context *mg_start(const struct mg_callbacks *callbacks,
 #if !defined(_WIN32)
       !set_uid_option(ctx) ||
 #endif
-      !set_acl_option(ctx)) {
+      !set_acl_option(ctx) ||
+      !set_idle_connections_option(ctx)) {
     free_context(ctx);
     return NULL;
   }
 
+  ctx->file_cache_size = strtoll(ctx->config[FILE_CACHE_SIZE], NULL, 10);
+
 #if !defined(_WIN32) && !defined(__SYMBIAN32__)
   // Ignore SIGPIPE signal, so if browser cancels the request, it
   // won't kill the whole process.
@@ -173,6 +173,11 @@ void mg_stop(struct mg_context *);
 const char *mg_get_option(const struct mg_context *ctx, const char *name);
 
 
+// Return the number of idle keep-alive connections which are currently
+// parked in the master thread, see the "max_idle_connections" option.
+int mg_get_idle_connection_count(struct mg_context *ctx);
+
+
 // Return array of strings that represent valid configuration options.
 // For each option, option name and default value is returned, i.e. the
 // number of entries in the array equals to number_of_options x 2.
@@ -31,6 +31,15 @@ extern "C"
 {
 #endif
 
+  /* List of requests submitted by one lio_listio () call */
+  typedef struct
+  {
+    int outstanding;            /* pending requests plus one for the
+				   submitter, protected by the queue mutex */
+    rtems_id waiting_task;      /* task waiting in LIO_WAIT mode */
+    struct sigevent sigevent;   /* notification in LIO_NOWAIT mode */
+  } rtems_aio_list;
+
   /* Actual request being processed */
   typedef struct
   {
@@ -40,6 +49,7 @@ extern "C"
     int priority;               /* see above */
     pthread_t caller_thread;    /* used for notification */
     struct aiocb *aiocbp;       /* aio control block */
+    rtems_aio_list *list;       /* lio_listio () list or NULL */
   } rtems_aio_request;
 
   typedef struct
@@ -64,6 +74,7 @@ extern "C"
     unsigned int initialized;     /* specific value if queue is initialized */
     int active_threads;           /* the number of active threads */
     int idle_threads;             /* number of idle threads */
+    int max_threads;              /* maximum number of worker threads */
 
   } rtems_aio_queue;
 
@@ -79,8 +90,22 @@ extern rtems_aio_queue aio_request_queue;
 #define AIO_MAX_QUEUE_SIZE 30
 #endif
 
+/* Maximum number of requests in one lio_listio () call */
+#ifndef AIO_LISTIO_MAX
+#define AIO_LISTIO_MAX 64
+#endif
+
+/* Maximum number of adjacent requests served by one preadv () or
+   pwritev () call of a worker thread */
+#ifndef AIO_MAX_BATCH
+#define AIO_MAX_BATCH 16
+#endif
+
 int rtems_aio_init (void);
+int rtems_aio_init_with_max_threads (int max_threads);
 int rtems_aio_enqueue (rtems_aio_request *req);
+int rtems_aio_enqueue_batch (rtems_aio_request *const reqs[], int count);
+void rtems_aio_list_release (rtems_aio_list *list);
 rtems_aio_request_chain *rtems_aio_search_fd 
 (
   rtems_chain_control *chain,
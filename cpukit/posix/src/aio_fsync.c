@@ -61,6 +61,7 @@ int aio_fsync(
     rtems_aio_set_errno_return_minus_one (EAGAIN, aiocbp);
 
   req->aiocbp = aiocbp;
+  req->list = NULL;
   req->aiocbp->aio_lio_opcode = LIO_SYNC; 
   
   return rtems_aio_enqueue (req);
@@ -13,10 +13,14 @@
  * http://www.rtems.org/license/LICENSE.
  */
 
+#include <sys/uio.h>
+#include <fcntl.h>
 #include <pthread.h>
+#include <signal.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include <time.h>
+#include <limits.h>
 #include <rtems/posix/aio_misc.h>
 #include <errno.h>
 
@@ -27,7 +31,7 @@ rtems_aio_queue aio_request_queue;
 /* 
  *  rtems_aio_init
  *
- * Initialize the request queue for aio
+ * Initialize the request queue for aio with AIO_MAX_THREADS worker threads
  *
  *  Input parameters:
  *        NONE
@@ -38,9 +42,33 @@ rtems_aio_queue aio_request_queue;
 
 int
 rtems_aio_init (void)
+{
+  return rtems_aio_init_with_max_threads (AIO_MAX_THREADS);
+}
+
+/* 
+ *  rtems_aio_init_with_max_threads
+ *
+ * Initialize the request queue for aio
+ *
+ *  Input parameters:
+ *        max_threads  - maximum number of worker threads, each worker
+ *                       thread serves the requests of one file
+ *                       descriptor at a time
+ *
+ *  Output parameters: 
+ *        0      -    if initialization succeeded
+ *        EINVAL -    if max_threads is less than one
+ */
+
+int
+rtems_aio_init_with_max_threads (int max_threads)
 {
   int result = 0;
 
+  if (max_threads < 1)
+    return EINVAL;
+
   result = pthread_attr_init (&aio_request_queue.attr);
   if (result != 0)
     return result;
@@ -68,6 +96,7 @@ rtems_aio_init (void)
 
   aio_request_queue.active_threads = 0;
   aio_request_queue.idle_threads = 0;
+  aio_request_queue.max_threads = max_threads;
   aio_request_queue.initialized = AIO_QUEUE_INITIALIZED;
 
   return result;
@@ -165,7 +194,8 @@ rtems_aio_move_to_work (rtems_aio_request_chain *r_chain)
  *  rtems_aio_insert_prio
  *
  * Add request to given FD chain. The chain is ordered
- * by priority
+ * by priority, requests of equal priority stay in the
+ * order of submission
  *
  *  Input parameters:
  *        chain        - chain of requests for a given FD
@@ -190,7 +220,7 @@ rtems_aio_insert_prio (rtems_chain_control *chain, rtems_aio_request *req)
     AIO_printf ("Add by priority \n");
     int prio = ((rtems_aio_request *) node)->aiocbp->aio_reqprio;
 
-    while (req->aiocbp->aio_reqprio > prio &&
+    while (req->aiocbp->aio_reqprio >= prio &&
            !rtems_chain_is_tail (chain, node)) {
       node = rtems_chain_next (node);
       prio = ((rtems_aio_request *) node)->aiocbp->aio_reqprio;
@@ -201,6 +231,80 @@ rtems_aio_insert_prio (rtems_chain_control *chain, rtems_aio_request *req)
   }
 }
 
+/* 
+ *  rtems_aio_notify
+ *
+ * Send the completion notification of a request or a list
+ *
+ *  Input parameters:
+ *        sigevent     - notification, only SIGEV_SIGNAL has an effect
+ *
+ *  Output parameters: 
+ *        NONE
+ */
+
+static void
+rtems_aio_notify (const struct sigevent *sigevent)
+{
+  if (sigevent->sigev_notify == SIGEV_SIGNAL)
+    sigqueue (getpid (), sigevent->sigev_signo, sigevent->sigev_value);
+}
+
+/* 
+ *  rtems_aio_list_release
+ *
+ * Drop one reference of a lio_listio () list. The last reference
+ * wakes up the task waiting in LIO_WAIT mode with the transient
+ * event or sends the notification of the LIO_NOWAIT mode and frees
+ * the list. The queue mutex must be locked by the caller.
+ *
+ *  Input parameters:
+ *        list         - the list
+ *
+ *  Output parameters: 
+ *        NONE
+ */
+
+void
+rtems_aio_list_release (rtems_aio_list *list)
+{
+  --list->outstanding;
+
+  if (list->outstanding == 0) {
+    if (list->waiting_task != RTEMS_ID_NONE)
+      rtems_event_transient_send (list->waiting_task);
+    else {
+      rtems_aio_notify (&list->sigevent);
+      free (list);
+    }
+  }
+}
+
+/* 
+ *  rtems_aio_complete
+ *
+ * Notify the completion of a request and free it. The queue mutex
+ * must be locked by the caller in case the request belongs to a list.
+ *
+ *  Input parameters:
+ *        req          - the request with final error code and
+ *                       return value
+ *
+ *  Output parameters: 
+ *        NONE
+ */
+
+static void
+rtems_aio_complete (rtems_aio_request *req)
+{
+  rtems_aio_notify (&req->aiocbp->aio_sigevent);
+
+  if (req->list != NULL)
+    rtems_aio_list_release (req->list);
+
+  free (req);
+}
+
 /* 
  *  rtems_aio_remove_fd
  *
@@ -222,12 +326,12 @@ void rtems_aio_remove_fd (rtems_aio_request_chain *r_chain)
   
   while (!rtems_chain_is_tail (chain, node))
     {
-      rtems_chain_extract (node);
       rtems_aio_request *req = (rtems_aio_request *) node;
       node = rtems_chain_next (node);
+      rtems_chain_extract (&req->next_prio);
       req->aiocbp->error_code = ECANCELED;
       req->aiocbp->return_value = -1;
-      free (req);
+      rtems_aio_complete (req);
     }
 }
 
@@ -269,56 +373,37 @@ int rtems_aio_remove_req (rtems_chain_control *chain, struct aiocb *aiocbp)
       rtems_chain_extract (node);
       current->aiocbp->error_code = ECANCELED;
       current->aiocbp->return_value = -1;
-      free (current); 
+      rtems_aio_complete (current);
     }
     
   return AIO_CANCELED;
 }
 
 /* 
- *  rtems_aio_enqueue
+ *  rtems_aio_enqueue_locked
  *
- * Enqueue requests, and creates threads to process them 
+ * Enqueue a request, and create a thread to process it if necessary.
+ * The queue mutex must be locked by the caller.
  *
  *  Input parameters:
  *        req        - see aio_misc.h
  * 
  *  Output parameters: 
  *         0         - if request was added to queue
- *         errno     - otherwise
+ *         errno     - otherwise, the request was not added to
+ *                     the queue
  */
 
-int
-rtems_aio_enqueue (rtems_aio_request *req)
+static int
+rtems_aio_enqueue_locked (rtems_aio_request *req)
 {
-
   rtems_aio_request_chain *r_chain;
   rtems_chain_control *chain;
   pthread_t thid;
-  int result, policy;
-  struct sched_param param;
-
-  /* The queue should be initialized */
-  AIO_assert (aio_request_queue.initialized == AIO_QUEUE_INITIALIZED);
-
-  result = pthread_mutex_lock (&aio_request_queue.mutex);
-  if (result != 0) {
-    free (req);
-    return result;
-  }
-
-  /* _POSIX_PRIORITIZED_IO and _POSIX_PRIORITY_SCHEDULING are defined, 
-     we can use aio_reqprio to lower the priority of the request */
-  pthread_getschedparam (pthread_self(), &policy, &param);
-
-  req->caller_thread = pthread_self ();
-  req->priority = param.sched_priority - req->aiocbp->aio_reqprio;
-  req->policy = policy;
-  req->aiocbp->error_code = EINPROGRESS;
-  req->aiocbp->return_value = 0;
+  int result;
 
   if ((aio_request_queue.idle_threads == 0) &&
-      aio_request_queue.active_threads < AIO_MAX_THREADS)
+      aio_request_queue.active_threads < aio_request_queue.max_threads)
     /* we still have empty places on the active_threads chain */
     {
       chain = &aio_request_queue.work_req;
@@ -334,7 +419,12 @@ rtems_aio_enqueue (rtems_aio_request *req)
 	result = pthread_create (&thid, &aio_request_queue.attr,
 				 rtems_aio_handle, (void *) r_chain);
 	if (result != 0) {
-	  pthread_mutex_unlock (&aio_request_queue.mutex);
+	  /* nobody would work on this new fd chain */
+	  rtems_chain_extract (&req->next_prio);
+	  rtems_chain_extract (&r_chain->next_fd);
+	  pthread_mutex_destroy (&r_chain->mutex);
+	  pthread_cond_destroy (&r_chain->cond);
+	  free (r_chain);
 	  return result;
 	}
 	++aio_request_queue.active_threads;
@@ -383,10 +473,238 @@ rtems_aio_enqueue (rtems_aio_request *req)
       }
     }
 
-  pthread_mutex_unlock (&aio_request_queue.mutex);
   return 0;
 }
 
+/* 
+ *  rtems_aio_enqueue
+ *
+ * Enqueue requests, and creates threads to process them 
+ *
+ *  Input parameters:
+ *        req        - see aio_misc.h
+ * 
+ *  Output parameters: 
+ *         0         - if request was added to queue
+ *         errno     - otherwise
+ */
+
+int
+rtems_aio_enqueue (rtems_aio_request *req)
+{
+  return rtems_aio_enqueue_batch (&req, 1);
+}
+
+/* 
+ *  rtems_aio_enqueue_batch
+ *
+ * Enqueue several requests with one acquisition of the queue
+ * mutex. The requests of one file descriptor with equal priority
+ * are processed in the order of the array.
+ *
+ *  Input parameters:
+ *        reqs       - array of requests (see aio_misc.h)
+ *        count      - number of requests in the array
+ * 
+ *  Output parameters: 
+ *         0         - if all requests were added to queue
+ *         errno     - otherwise, the requests which could not be
+ *                     added get the error code EAGAIN
+ */
+
+int
+rtems_aio_enqueue_batch (rtems_aio_request *const reqs[], int count)
+{
+  int result, policy, i;
+  struct sched_param param;
+
+  /* The queue should be initialized */
+  AIO_assert (aio_request_queue.initialized == AIO_QUEUE_INITIALIZED);
+
+  result = pthread_mutex_lock (&aio_request_queue.mutex);
+  if (result != 0) {
+    /* no request is queued, so the lists are used by the caller only */
+    for (i = 0; i < count; ++i) {
+      reqs[i]->aiocbp->error_code = EAGAIN;
+      reqs[i]->aiocbp->return_value = -1;
+      if (reqs[i]->list != NULL)
+        rtems_aio_list_release (reqs[i]->list);
+      free (reqs[i]);
+    }
+    return result;
+  }
+
+  /* _POSIX_PRIORITIZED_IO and _POSIX_PRIORITY_SCHEDULING are defined, 
+     we can use aio_reqprio to lower the priority of the request */
+  pthread_getschedparam (pthread_self(), &policy, &param);
+
+  for (i = 0; i < count; ++i) {
+    rtems_aio_request *req = reqs[i];
+
+    req->caller_thread = pthread_self ();
+    req->priority = param.sched_priority - req->aiocbp->aio_reqprio;
+    req->policy = policy;
+    req->aiocbp->error_code = EINPROGRESS;
+    req->aiocbp->return_value = 0;
+
+    if (result == 0)
+      result = rtems_aio_enqueue_locked (req);
+
+    if (result != 0) {
+      /* there is no notification for requests which were not queued */
+      req->aiocbp->error_code = EAGAIN;
+      req->aiocbp->return_value = -1;
+      if (req->list != NULL)
+        rtems_aio_list_release (req->list);
+      free (req);
+    }
+  }
+
+  pthread_mutex_unlock (&aio_request_queue.mutex);
+  return result;
+}
+
+/* 
+ *  rtems_aio_extract_batch
+ *
+ * Extract the first request of a fd chain and the following
+ * requests which continue the same read or write at the adjacent
+ * file offset with the same priority. The fd chain mutex must be
+ * locked by the caller.
+ *
+ *  Input parameters:
+ *        chain      - non-empty chain of requests for a given FD
+ *        batch      - array for AIO_MAX_BATCH requests
+ * 
+ *  Output parameters: 
+ *         count     - number of extracted requests
+ */
+
+static int
+rtems_aio_extract_batch (rtems_chain_control *chain,
+			 rtems_aio_request *batch[])
+{
+  rtems_aio_request *first = (rtems_aio_request *) rtems_chain_first (chain);
+  struct aiocb *last = first->aiocbp;
+  size_t total = last->aio_nbytes;
+  int count = 1;
+
+  rtems_chain_extract (&first->next_prio);
+  batch[0] = first;
+
+  if (last->aio_lio_opcode != LIO_READ && last->aio_lio_opcode != LIO_WRITE)
+    return count;
+
+  while (count < AIO_MAX_BATCH && !rtems_chain_is_empty (chain)) {
+    rtems_aio_request *next = (rtems_aio_request *) rtems_chain_first (chain);
+    struct aiocb *aiocbp = next->aiocbp;
+
+    if (aiocbp->aio_lio_opcode != last->aio_lio_opcode ||
+        next->priority != first->priority ||
+        aiocbp->aio_offset != last->aio_offset + (off_t) last->aio_nbytes ||
+        aiocbp->aio_nbytes > SSIZE_MAX - total)
+      break;
+
+    rtems_chain_extract (&next->next_prio);
+    batch[count] = next;
+    ++count;
+    total += aiocbp->aio_nbytes;
+    last = aiocbp;
+  }
+
+  return count;
+}
+
+/* 
+ *  rtems_aio_process_batch
+ *
+ * Perform the requests extracted by rtems_aio_extract_batch () with
+ * one call to the file system, set their results and complete them
+ *
+ *  Input parameters:
+ *        batch      - array of requests
+ *        count      - number of requests in the array
+ * 
+ *  Output parameters: 
+ *         NONE
+ */
+
+static void
+rtems_aio_process_batch (rtems_aio_request *const batch[], int count)
+{
+  struct aiocb *aiocbp = batch[0]->aiocbp;
+  struct iovec iov[AIO_MAX_BATCH];
+  ssize_t result;
+  int lock = 0;
+  int i;
+
+  switch (aiocbp->aio_lio_opcode) {
+  case LIO_READ:
+  case LIO_WRITE:
+    for (i = 0; i < count; ++i) {
+      iov[i].iov_base = (void *) batch[i]->aiocbp->aio_buf;
+      iov[i].iov_len = batch[i]->aiocbp->aio_nbytes;
+    }
+
+    if (aiocbp->aio_lio_opcode == LIO_READ) {
+      AIO_printf ("read\n");
+      result = preadv (aiocbp->aio_fildes, iov, count, aiocbp->aio_offset);
+    } else {
+      int flags = fcntl (aiocbp->aio_fildes, F_GETFL);
+
+      AIO_printf ("write\n");
+      /* with O_APPEND the data is appended in the order of the requests */
+      if (flags == -1)
+        result = -1;
+      else if ((flags & O_APPEND) != 0)
+        result = writev (aiocbp->aio_fildes, iov, count);
+      else
+        result = pwritev (aiocbp->aio_fildes, iov, count, aiocbp->aio_offset);
+    }
+    break;
+
+  case LIO_SYNC:
+    AIO_printf ("sync\n");
+    result = fsync (aiocbp->aio_fildes);
+    break;
+
+  default:
+    errno = EINVAL;
+    result = -1;
+  }
+
+  if (result == -1) {
+    int eno = errno;
+
+    for (i = 0; i < count; ++i) {
+      batch[i]->aiocbp->return_value = -1;
+      batch[i]->aiocbp->error_code = eno;
+    }
+  } else {
+    /* a short transfer ends in the request containing the last byte */
+    for (i = 0; i < count; ++i) {
+      size_t nbytes = batch[i]->aiocbp->aio_nbytes;
+      ssize_t n = (size_t) result < nbytes ? result : (ssize_t) nbytes;
+
+      batch[i]->aiocbp->return_value = n;
+      batch[i]->aiocbp->error_code = 0;
+      result -= n;
+    }
+  }
+
+  for (i = 0; i < count; ++i)
+    lock |= batch[i]->list != NULL;
+
+  if (lock)
+    pthread_mutex_lock (&aio_request_queue.mutex);
+
+  for (i = 0; i < count; ++i)
+    rtems_aio_complete (batch[i]);
+
+  if (lock)
+    pthread_mutex_unlock (&aio_request_queue.mutex);
+}
+
 /* 
  *  rtems_aio_handle
  *
@@ -430,6 +748,8 @@ rtems_aio_handle (void *arg)
        the request, in this way the user can supply more
        requests to this fd chain */
     if (!rtems_chain_is_empty (chain)) {
+      rtems_aio_request *batch[AIO_MAX_BATCH];
+      int count;
 
       AIO_printf ("Get new request from not empty chain\n");	
       node = rtems_chain_first (chain);
@@ -441,42 +761,11 @@ rtems_aio_handle (void *arg)
       param.sched_priority = req->priority;
       pthread_setschedparam (pthread_self(), req->policy, &param);
 
-      rtems_chain_extract (node);
+      count = rtems_aio_extract_batch (chain, batch);
 
       pthread_mutex_unlock (&r_chain->mutex);
 
-      switch (req->aiocbp->aio_lio_opcode) {
-      case LIO_READ:
-	AIO_printf ("read\n");
-        result = pread (req->aiocbp->aio_fildes,
-                        (void *) req->aiocbp->aio_buf,
-                        req->aiocbp->aio_nbytes, req->aiocbp->aio_offset);
-        break;
-
-      case LIO_WRITE:
-	AIO_printf ("write\n");
-        result = pwrite (req->aiocbp->aio_fildes,
-                         (void *) req->aiocbp->aio_buf,
-                         req->aiocbp->aio_nbytes, req->aiocbp->aio_offset);
-        break;
-        
-      case LIO_SYNC:
-	AIO_printf ("sync\n");
-      	result = fsync (req->aiocbp->aio_fildes);
-      	break;
-
-      default:
-        result = -1;
-      }
-      if (result == -1) {
-        req->aiocbp->return_value = -1;
-	req->aiocbp->error_code = errno;
-      } else {
-        req->aiocbp->return_value = result;
-        req->aiocbp->error_code = 0;
-      }
-
-      // notification needed for lio
+      rtems_aio_process_batch (batch, count);
 
     } else {
       /* If the fd chain is empty we unlock the fd chain
@@ -65,6 +65,7 @@ aio_read (struct aiocb *aiocbp)
     rtems_aio_set_errno_return_minus_one (EAGAIN, aiocbp);
 
   req->aiocbp = aiocbp;
+  req->list = NULL;
   req->aiocbp->aio_lio_opcode = LIO_READ;
 
   return rtems_aio_enqueue (req);
@@ -22,16 +22,176 @@
 
 #include <aio.h>
 #include <errno.h>
-
+#include <fcntl.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <rtems/posix/aio_misc.h>
 #include <rtems/system.h>
 #include <rtems/seterr.h>
 
-int lio_listio(
-  int              mode __attribute__((unused)),
-  struct aiocb    *__restrict const  list[__restrict] __attribute__((unused)),
-  int              nent __attribute__((unused)),
-  struct sigevent *__restrict sig __attribute__((unused))
-)
+/*
+ *  rtems_aio_check_request
+ *
+ * Check a read or write request of a list with the rules of
+ * aio_read () and aio_write ()
+ *
+ *  Input parameters:
+ *        aiocbp - asynchronous I/O control block
+ *
+ *  Output parameters:
+ *        EBADF  - FD not opened for the operation
+ *        EINVAL - invalid aio_lio_opcode, aio_reqprio or aio_offset
+ *        0      - otherwise
+ */
+
+static int
+rtems_aio_check_request (const struct aiocb *aiocbp)
 {
-  rtems_set_errno_and_return_minus_one( ENOSYS );
+  int mode;
+
+  if (aiocbp->aio_lio_opcode != LIO_READ &&
+      aiocbp->aio_lio_opcode != LIO_WRITE)
+    return EINVAL;
+
+  mode = fcntl (aiocbp->aio_fildes, F_GETFL);
+  if (mode == -1)
+    return EBADF;
+
+  mode &= O_ACCMODE;
+  if (mode != O_RDWR &&
+      mode != (aiocbp->aio_lio_opcode == LIO_READ ? O_RDONLY : O_WRONLY))
+    return EBADF;
+
+  if (aiocbp->aio_reqprio < 0 || aiocbp->aio_reqprio > AIO_PRIO_DELTA_MAX)
+    return EINVAL;
+
+  if (aiocbp->aio_offset < 0)
+    return EINVAL;
+
+  return 0;
+}
+
+/*
+ *  lio_listio
+ *
+ * Initiate a list of I/O requests. All requests are queued with one
+ * acquisition of the queue mutex, so that a worker thread can serve
+ * adjacent requests of one file descriptor with a single preadv () or
+ * pwritev () call. In LIO_WAIT mode the caller waits for the transient
+ * event sent by the last completed request.
+ *
+ *  Input parameters:
+ *        mode   - LIO_WAIT or LIO_NOWAIT
+ *        list   - the requests, NULL entries and LIO_NOP requests
+ *                 are ignored
+ *        nent   - number of entries in the list
+ *        sig    - notification after all requests completed in
+ *                 LIO_NOWAIT mode, may be NULL
+ *
+ *  Output parameters:
+ *        -1 - invalid mode or nent (EINVAL)
+ *           - not enough memory for the list (EAGAIN)
+ *           - requests could not be queued (EAGAIN)
+ *           - at least one request failed (EIO), in LIO_NOWAIT
+ *             mode only requests which could not be queued count
+ *         0 - otherwise
+ */
+
+int
+lio_listio (int mode,
+	    struct aiocb *__restrict const list[__restrict],
+	    int nent,
+	    struct sigevent *__restrict sig)
+{
+  rtems_aio_request *reqs[AIO_LISTIO_MAX];
+  rtems_aio_list wait_list;
+  rtems_aio_list *lio;
+  int count = 0;
+  int failed = 0;
+  int result = 0;
+  int i;
+
+  /* The queue should be initialized */
+  AIO_assert (aio_request_queue.initialized == AIO_QUEUE_INITIALIZED);
+
+  if (mode != LIO_WAIT && mode != LIO_NOWAIT)
+    rtems_set_errno_and_return_minus_one (EINVAL);
+
+  if (nent < 0 || nent > AIO_LISTIO_MAX)
+    rtems_set_errno_and_return_minus_one (EINVAL);
+
+  if (mode == LIO_WAIT) {
+    lio = &wait_list;
+    lio->waiting_task = rtems_task_self ();
+    rtems_event_transient_clear ();
+  } else {
+    lio = malloc (sizeof (rtems_aio_list));
+    if (lio == NULL)
+      rtems_set_errno_and_return_minus_one (EAGAIN);
+
+    lio->waiting_task = RTEMS_ID_NONE;
+    if (sig != NULL)
+      lio->sigevent = *sig;
+    else
+      lio->sigevent.sigev_notify = SIGEV_NONE;
+  }
+
+  for (i = 0; i < nent; ++i) {
+    struct aiocb *aiocbp = list[i];
+    rtems_aio_request *req = NULL;
+    int eno;
+
+    if (aiocbp == NULL || aiocbp->aio_lio_opcode == LIO_NOP)
+      continue;
+
+    eno = rtems_aio_check_request (aiocbp);
+    if (eno == 0) {
+      req = malloc (sizeof (rtems_aio_request));
+      if (req == NULL)
+        eno = EAGAIN;
+    }
+
+    if (eno != 0) {
+      aiocbp->error_code = eno;
+      aiocbp->return_value = -1;
+      ++failed;
+      continue;
+    }
+
+    req->aiocbp = aiocbp;
+    req->list = lio;
+    reqs[count] = req;
+    ++count;
+  }
+
+  /* One reference for each request and one for this function, so that
+     the list cannot complete before all requests are queued */
+  lio->outstanding = count + 1;
+
+  if (count > 0)
+    result = rtems_aio_enqueue_batch (reqs, count);
+
+  pthread_mutex_lock (&aio_request_queue.mutex);
+  rtems_aio_list_release (lio);
+  pthread_mutex_unlock (&aio_request_queue.mutex);
+
+  if (mode == LIO_WAIT) {
+    rtems_event_transient_receive (RTEMS_WAIT, RTEMS_NO_TIMEOUT);
+
+    for (i = 0; i < nent; ++i) {
+      const struct aiocb *aiocbp = list[i];
+
+      if (aiocbp != NULL && aiocbp->aio_lio_opcode != LIO_NOP &&
+          aiocbp->error_code != 0)
+        ++failed;
+    }
+  }
+
+  if (result != 0)
+    rtems_set_errno_and_return_minus_one (EAGAIN);
+
+  if (failed > 0)
+    rtems_set_errno_and_return_minus_one (EIO);
+
+  return 0;
 }
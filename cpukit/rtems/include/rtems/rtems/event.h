@@ -313,6 +313,21 @@ rtems_status_code rtems_event_receive (
  */
 #define RTEMS_EVENT_SYSTEM_NETWORK_SOSLEEP RTEMS_EVENT_25
 
+/**
+ * @brief Reserved system event for network tsleep() usage.
+ */
+#define RTEMS_EVENT_SYSTEM_NETWORK_TSLEEP RTEMS_EVENT_26
+
+/**
+ * @brief Reserved system event for kevent() usage.
+ */
+#define RTEMS_EVENT_SYSTEM_KQUEUE RTEMS_EVENT_27
+
+/**
+ * @brief Reserved system event for network callout usage.
+ */
+#define RTEMS_EVENT_SYSTEM_NETWORK_CALLOUT RTEMS_EVENT_28
+
 /**
  * @brief Reserved system event for transient usage.
  */
@@ -242,6 +242,7 @@ const rtems_libio_helper rtems_fs_init_helper =
  *     CONFIGURE_FILESYSTEM_DOSFS    - DOS File System, uses libblock
  *     CONFIGURE_FILESYSTEM_RFS      - RTEMS File System (RFS), uses libblock
  *     CONFIGURE_FILESYSTEM_JFFS2    - Journalling Flash File System, Version 2
+ *     CONFIGURE_FILESYSTEM_CROMFS   - Compressed ROM File System, read-only
  *
  *   Combinations:
  *
@@ -270,6 +271,7 @@ const rtems_libio_helper rtems_fs_init_helper =
     #define CONFIGURE_FILESYSTEM_DOSFS
     #define CONFIGURE_FILESYSTEM_RFS
     #define CONFIGURE_FILESYSTEM_JFFS2
+    #define CONFIGURE_FILESYSTEM_CROMFS
   #endif
 
   /*
@@ -290,7 +292,8 @@ const rtems_libio_helper rtems_fs_init_helper =
         defined(CONFIGURE_FILESYSTEM_NFS) || \
         defined(CONFIGURE_FILESYSTEM_DOSFS) || \
         defined(CONFIGURE_FILESYSTEM_RFS) || \
-        defined(CONFIGURE_FILESYSTEM_JFFS2)
+        defined(CONFIGURE_FILESYSTEM_JFFS2) || \
+        defined(CONFIGURE_FILESYSTEM_CROMFS)
         #error "Configured filesystems but root filesystem was not IMFS!"
         #error "Filesystems could be disabled, DEVFS is root, or"
         #error "  miniIMFS is root!"
@@ -330,6 +333,18 @@ const rtems_libio_helper rtems_fs_init_helper =
                     IMFS_MEMFILE_DEFAULT_BYTES_PER_BLOCK
 #endif
 
+/**
+ * This specifies the extent size for files within the IMFS.  The file data
+ * past the extent size is stored in contiguous extents instead of blocks.
+ * The extent size doubles up to 16 times the configured value.  This raises the maximum file size and speeds up the
+ * access to large files.  It must be a power of two which is at least the
+ * bytes per block.  The default value of zero disables the extents.
+ */
+#ifndef CONFIGURE_IMFS_MEMFILE_EXTENT_SIZE
+  #define CONFIGURE_IMFS_MEMFILE_EXTENT_SIZE \
+                    IMFS_MEMFILE_DEFAULT_EXTENT_SIZE
+#endif
+
 /**
  * This defines the miniIMFS file system table entry.
  */
@@ -483,11 +498,28 @@ const rtems_libio_helper rtems_fs_init_helper =
   #define CONFIGURE_SEMAPHORES_FOR_JFFS2 0
 #endif
 
+/**
+ * CROMFS
+ */
+#if !defined(CONFIGURE_FILESYSTEM_ENTRY_CROMFS) && \
+    defined(CONFIGURE_FILESYSTEM_CROMFS)
+  #include <rtems/cromfs.h>
+  #if !defined(CONFIGURE_MAXIMUM_CROMFS_MOUNTS)
+    #define CONFIGURE_MAXIMUM_CROMFS_MOUNTS 1
+  #endif
+  #define CONFIGURE_FILESYSTEM_ENTRY_CROMFS \
+    { RTEMS_FILESYSTEM_TYPE_CROMFS, rtems_cromfs_initialize }
+  #define CONFIGURE_SEMAPHORES_FOR_CROMFS CONFIGURE_MAXIMUM_CROMFS_MOUNTS
+#else
+  #define CONFIGURE_SEMAPHORES_FOR_CROMFS 0
+#endif
+
 #define CONFIGURE_SEMAPHORES_FOR_FILE_SYSTEMS (CONFIGURE_SEMAPHORES_FOR_FIFOS + \
                                                CONFIGURE_SEMAPHORES_FOR_NFS + \
                                                CONFIGURE_SEMAPHORES_FOR_DOSFS + \
                                                CONFIGURE_SEMAPHORES_FOR_RFS + \
-                                               CONFIGURE_SEMAPHORES_FOR_JFFS2)
+                                               CONFIGURE_SEMAPHORES_FOR_JFFS2 + \
+                                               CONFIGURE_SEMAPHORES_FOR_CROMFS)
 
 #ifdef CONFIGURE_INIT
 
@@ -515,6 +547,7 @@ const rtems_libio_helper rtems_fs_init_helper =
   #if defined(CONFIGURE_FILESYSTEM_IMFS) || \
       defined(CONFIGURE_FILESYSTEM_MINIIMFS)
     int imfs_rq_memfile_bytes_per_block = CONFIGURE_IMFS_MEMFILE_BYTES_PER_BLOCK;
+    int imfs_rq_memfile_extent_size = CONFIGURE_IMFS_MEMFILE_EXTENT_SIZE;
   #endif
 #endif
 
@@ -566,6 +599,10 @@ const rtems_libio_helper rtems_fs_init_helper =
           defined(CONFIGURE_FILESYSTEM_ENTRY_JFFS2)
         CONFIGURE_FILESYSTEM_ENTRY_JFFS2,
       #endif
+      #if defined(CONFIGURE_FILESYSTEM_CROMFS) && \
+          defined(CONFIGURE_FILESYSTEM_ENTRY_CROMFS)
+        CONFIGURE_FILESYSTEM_ENTRY_CROMFS,
+      #endif
       CONFIGURE_FILESYSTEM_NULL
     };
   #endif
@@ -326,6 +326,15 @@ handlers for a single UART.  Some UARTs can generate a unique interrupt vector
 for each interrupt source such as a character has been received or the
 transmitter is ready for another character.
 
+The receive interrupt handler should hand over all received characters with
+one call of @code{rtems_termios_enqueue_raw_characters}.  In case no flow
+control is enabled, the characters are copied in contiguous spans into the raw
+input buffer.  Reads in raw mode (no @code{ICANON}, no @code{ECHO} and no input
+character translations) copy contiguous spans of the raw input buffer directly
+to the reader.  The character and overflow counters of a device are available
+through the @code{RTEMS_IO_GET_STATISTICS} IO control which returns a
+@code{rtems_termios_statistics} structure.
+
 In the simplest case, the @code{my_driver_interrupt_handler} will have to check
 the status of the UART and determine what caused the interrupt.  The following
 describes the operation of an @code{my_driver_interrupt_handler} which has to
@@ -376,12 +385,11 @@ device that the @code{n} characters at @code{buf} are to be transmitted.  The
 return value may be arbitrary since it is not checked from Termios.  It is
 guaranteed that @code{n} is greater than zero.  This routine is invoked either
 from task context with disabled interrupts to start a new transmission process
-with exactly one character in case of an idle output state or from the
-interrupt handler to refill the transmitter.  If the routine is invoked to
-start the transmit process the output state will become busy and Termios starts
-to fill the output buffer.  If the transmit interrupt arises before Termios was
-able to fill the transmit buffer you will end up with one interrupt per
-character.
+in case of an idle output state or from the interrupt handler to refill the
+transmitter.  In both cases @code{buf} refers to a contiguous span of the
+output buffer which may be handed over to a DMA controller as a whole.  Only in
+case XON/XOFF flow control is enabled, exactly one character is passed to
+allow a fast reaction on flow control characters.
 
 On error, the function should return @code{-1}. On success, it should return
 @code{0}, since it the interrupt handler will report the actual number of
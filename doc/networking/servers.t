@@ -68,6 +68,20 @@ struct rtems_ftpd_configuration rtems_ftpd_configuration =
 Specifying 0 for the well-known port causes FTPD to use the
 UNIX standard FTPD port (21).
 
+The @code{data_buffer_size} member of the configuration structure
+specifies the size of the file transfer buffer of each session.
+Values below @code{FTPD_DATASIZE} select @code{FTPD_DATASIZE}.
+Files are sent to clients with @code{sendfile()}, so the buffer size
+matters for received files and ASCII mode transfers.  A large buffer
+lets FTPD write received files in large chunks.
+
+The @code{REST} command sets the file offset for the next @code{RETR}
+or @code{STOR} command.  The offset stays set across other commands,
+e.g. @code{PASV} or @code{PORT}, and only a @code{RETR} or @code{STOR}
+command consumes it.  Clients may use it to transfer segments of a
+large file through several sessions in parallel.  The
+@code{tasks_count} member limits the number of concurrent sessions.
+
 @subsection Using Hooks
 
 In the example above, one hook was installed.  The hook causes
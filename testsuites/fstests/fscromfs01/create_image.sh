@@ -0,0 +1,52 @@
+#!/bin/sh
+
+#  Copyright (c) 2026 agent <agent@local>
+#
+#  The license and distribution terms for this file may be
+#  found in the file LICENSE in this distribution or at
+#  http://www.rtems.org/license/LICENSE.
+
+#
+#  Creates the test image file image.h with the host tools rtems-mkcromfs and
+#  rtems-bin2c.  The test checks the file contents, so keep them in sync with
+#  init.c.
+#
+
+set -e
+
+TOOLS="${1:-/opt/rtems-4.11/bin}"
+DIR=create_image_dir
+IMAGE=image
+IMAGE_BIN=$IMAGE.bin
+
+rm -rf $DIR
+mkdir -p $DIR/dir/sub
+
+printf "Hello, CROMFS!\n" > $DIR/README
+
+i=0
+while [ $i -lt 300 ] ; do
+  printf "line %04i\n" $i
+  i=`expr $i + 1`
+done > $DIR/dir/a.txt
+
+: > $DIR/dir/empty
+
+ln -s dir/a.txt $DIR/link
+
+find $DIR -type d -exec chmod 755 {} \;
+find $DIR -type f -exec chmod 644 {} \;
+find $DIR -exec touch -h -d @1400000000 {} \;
+
+"$TOOLS/rtems-mkcromfs" -b 1024 $DIR "$IMAGE_BIN"
+"$TOOLS/rtems-bin2c" -C -s "$IMAGE_BIN" "$IMAGE"
+{
+  printf "/*\n"
+  printf " *  CROMFS image generated by rtems-mkcromfs with create_image.sh.\n"
+  printf " *  Run create_image.sh to update it.\n"
+  printf " */\n\n"
+  cat "$IMAGE".c
+} > "$IMAGE".h
+rm "$IMAGE".c
+
+rm -rf $DIR "$IMAGE_BIN"
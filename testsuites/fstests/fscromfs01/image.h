@@ -0,0 +1,93 @@
+/*
+ *  CROMFS image generated by rtems-mkcromfs with create_image.sh.
+ *  Run create_image.sh to update it.
+ */
+
+/*
+ *  Declarations for C structure representing binary file image.bin
+ *
+ *  WARNING: Automatically generated -- do not edit!
+ */
+
+#include <sys/types.h>
+
+static const unsigned char image_bin[] = {
+  0x43, 0x52, 0x4f, 0x4d, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x04, 0x00, 
+  0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x01, 0x48, 
+  0x00, 0x00, 0x03, 0x87, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x41, 0xed, 
+  0x00, 0x00, 0x00, 0x00, 0x53, 0x72, 0x4e, 0x00, 0x00, 0x00, 0x00, 0x00, 
+  0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 
+  0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x81, 0xa4, 0x00, 0x00, 0x00, 0x00, 
+  0x53, 0x72, 0x4e, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x00, 0x00, 0x01, 0x01, 
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x2c, 0x00, 0x00, 0x00, 0x01, 
+  0x00, 0x00, 0x41, 0xed, 0x00, 0x00, 0x00, 0x00, 0x53, 0x72, 0x4e, 0x00, 
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x08, 0x00, 0x00, 0x00, 0x00, 
+  0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0xa1, 0xff, 
+  0x00, 0x00, 0x00, 0x00, 0x53, 0x72, 0x4e, 0x00, 0x00, 0x00, 0x00, 0x09, 
+  0x00, 0x00, 0x01, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x11, 
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x81, 0xa4, 0x00, 0x00, 0x00, 0x00, 
+  0x53, 0x72, 0x4e, 0x00, 0x00, 0x00, 0x0b, 0xb8, 0x00, 0x00, 0x01, 0x1b, 
+  0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x01, 0x34, 0x00, 0x00, 0x00, 0x03, 
+  0x00, 0x00, 0x81, 0xa4, 0x00, 0x00, 0x00, 0x00, 0x53, 0x72, 0x4e, 0x00, 
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x21, 0x00, 0x00, 0x00, 0x02, 
+  0x00, 0x00, 0x01, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x41, 0xed, 
+  0x00, 0x00, 0x00, 0x00, 0x53, 0x72, 0x4e, 0x00, 0x00, 0x00, 0x00, 0x00, 
+  0x00, 0x00, 0x01, 0x27, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x07, 
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x52, 0x45, 0x41, 0x44, 0x4d, 0x45, 0x00, 
+  0x64, 0x69, 0x72, 0x00, 0x6c, 0x69, 0x6e, 0x6b, 0x00, 0x64, 0x69, 0x72, 
+  0x2f, 0x61, 0x2e, 0x74, 0x78, 0x74, 0x00, 0x61, 0x2e, 0x74, 0x78, 0x74, 
+  0x00, 0x65, 0x6d, 0x70, 0x74, 0x79, 0x00, 0x73, 0x75, 0x62, 0x00, 0x00, 
+  0x00, 0x00, 0x01, 0x48, 0x00, 0x00, 0x01, 0x57, 0x00, 0x00, 0x01, 0x57, 
+  0x00, 0x00, 0x02, 0x19, 0x00, 0x00, 0x02, 0xd6, 0x00, 0x00, 0x03, 0x87, 
+  0x00, 0x00, 0x03, 0x87, 0x48, 0x65, 0x6c, 0x6c, 0x6f, 0x2c, 0x20, 0x43, 
+  0x52, 0x4f, 0x4d, 0x46, 0x53, 0x21, 0x0a, 0x78, 0xda, 0x3d, 0xd3, 0xb1, 
+  0x71, 0x03, 0x30, 0x0c, 0x04, 0xc1, 0xdc, 0x55, 0xb8, 0x04, 0x83, 0x04, 
+  0x09, 0xa0, 0x20, 0x05, 0x9a, 0xd1, 0xb8, 0xff, 0xd0, 0x0e, 0xa4, 0xfd, 
+  0xe8, 0xb2, 0x8d, 0xfe, 0xf5, 0xfc, 0x7d, 0x7c, 0xff, 0xfc, 0xef, 0xeb, 
+  0xf5, 0xae, 0x50, 0x4b, 0x6d, 0x95, 0xea, 0xa8, 0xab, 0x4a, 0xb5, 0x9a, 
+  0x4f, 0x05, 0x23, 0x18, 0xc1, 0x08, 0x46, 0x30, 0x82, 0x11, 0x8c, 0x60, 
+  0x04, 0x23, 0x18, 0x8b, 0xb1, 0x18, 0x8b, 0xb1, 0x18, 0x8b, 0xb1, 0x18, 
+  0x8b, 0xb1, 0x18, 0x8b, 0xb1, 0x18, 0x9b, 0xb1, 0x19, 0x9b, 0xb1, 0x19, 
+  0x9b, 0xb1, 0x19, 0x9b, 0xb1, 0x19, 0x9b, 0xb1, 0x19, 0xc9, 0x48, 0x46, 
+  0x32, 0x92, 0x91, 0x8c, 0x64, 0x24, 0x23, 0x19, 0xc9, 0x48, 0xc6, 0x61, 
+  0x1c, 0xc6, 0x61, 0x1c, 0xc6, 0x61, 0x1c, 0xc6, 0x61, 0x1c, 0xc6, 0x61, 
+  0x1c, 0xc6, 0x65, 0x5c, 0xc6, 0x65, 0x5c, 0xc6, 0x65, 0x5c, 0xc6, 0x65, 
+  0x5c, 0xc6, 0x65, 0x5c, 0x46, 0x31, 0x8a, 0x51, 0x8c, 0x62, 0x14, 0xa3, 
+  0x18, 0xc5, 0x28, 0x46, 0x31, 0x8a, 0xd1, 0x8c, 0x66, 0x34, 0xa3, 0x19, 
+  0xcd, 0x68, 0x46, 0x33, 0x9a, 0xd1, 0x8c, 0x66, 0x0c, 0x63, 0x18, 0xc3, 
+  0x18, 0xc6, 0x30, 0x86, 0x31, 0x8c, 0x61, 0x0c, 0x63, 0x3e, 0x46, 0xf8, 
+  0x79, 0xbc, 0x7f, 0xfe, 0x07, 0x2f, 0x5e, 0x0b, 0x6b, 0x78, 0xda, 0x3d, 
+  0xcd, 0xb1, 0x6d, 0x04, 0x31, 0x0c, 0x00, 0xb0, 0x3e, 0x53, 0xfc, 0x08, 
+  0x67, 0x49, 0xb6, 0xa5, 0x81, 0x52, 0x04, 0x08, 0x7e, 0xff, 0x32, 0x69, 
+  0x9e, 0x1d, 0x3b, 0xbe, 0x9e, 0xf5, 0xc4, 0xd7, 0xef, 0xcf, 0xfb, 0xfb, 
+  0xf5, 0xaf, 0xa4, 0xa2, 0x4d, 0x87, 0x2e, 0x35, 0xcd, 0x47, 0xeb, 0xa1, 
+  0x45, 0x8e, 0xe5, 0x58, 0x8e, 0xe5, 0x58, 0x8e, 0xe5, 0x58, 0x8e, 0xe5, 
+  0x08, 0x47, 0x38, 0xc2, 0x11, 0x8e, 0x70, 0x84, 0x23, 0x1c, 0xe1, 0x08, 
+  0x47, 0x38, 0xd2, 0x91, 0x8e, 0x74, 0xa4, 0x23, 0x1d, 0xe9, 0x48, 0x47, 
+  0x3a, 0xd2, 0x91, 0x8e, 0x72, 0x94, 0xa3, 0x1c, 0xe5, 0x28, 0x47, 0x39, 
+  0xca, 0x51, 0x8e, 0x72, 0x94, 0x63, 0x3b, 0xb6, 0x63, 0x3b, 0xb6, 0x63, 
+  0x3b, 0xb6, 0x63, 0x3b, 0xb6, 0x63, 0x3b, 0xb6, 0xe3, 0x38, 0x8e, 0xe3, 
+  0x38, 0x8e, 0xe3, 0x38, 0x8e, 0xe3, 0x38, 0x8e, 0xe3, 0x38, 0x8e, 0xe3, 
+  0x3a, 0xae, 0xe3, 0x3a, 0xae, 0xe3, 0x3a, 0xae, 0xe3, 0x3a, 0xae, 0xe3, 
+  0x3a, 0xae, 0xa3, 0x1d, 0xed, 0x68, 0x47, 0x3b, 0xda, 0xd1, 0x8e, 0x76, 
+  0xb4, 0xa3, 0x1d, 0xed, 0x18, 0xc7, 0x38, 0xc6, 0x31, 0x8e, 0x71, 0x8c, 
+  0x63, 0x1c, 0xe3, 0x18, 0xc7, 0x7c, 0x8e, 0x78, 0x1e, 0x5a, 0x14, 0x94, 
+  0xf4, 0x07, 0xcb, 0x10, 0x0a, 0xe1, 0x78, 0xda, 0x3d, 0xcd, 0xb1, 0x71, 
+  0x03, 0x31, 0x0c, 0x00, 0xb0, 0xde, 0x53, 0x78, 0x84, 0x17, 0x49, 0x49, 
+  0xe4, 0x40, 0x2e, 0x72, 0x97, 0xf3, 0xfe, 0x65, 0xaa, 0xa0, 0x43, 0x87, 
+  0x7a, 0xfd, 0xfe, 0x7c, 0x3f, 0xef, 0x27, 0x9e, 0x4d, 0x87, 0x2e, 0x35, 
+  0xcd, 0xbf, 0xd6, 0x43, 0x8b, 0x82, 0x92, 0x8a, 0x1c, 0xcb, 0xb1, 0x1c, 
+  0xcb, 0xb1, 0x1c, 0xe1, 0x08, 0x47, 0x38, 0xc2, 0x11, 0x8e, 0x70, 0x84, 
+  0x23, 0x1c, 0xe1, 0x08, 0x47, 0x3a, 0xd2, 0x91, 0x8e, 0x74, 0xa4, 0x23, 
+  0x1d, 0xe9, 0x48, 0x47, 0x3a, 0xd2, 0x51, 0x8e, 0x72, 0x94, 0xa3, 0x1c, 
+  0xe5, 0x28, 0x47, 0x39, 0xca, 0x51, 0x8e, 0x72, 0x6c, 0xc7, 0x76, 0x6c, 
+  0xc7, 0x76, 0x6c, 0xc7, 0x76, 0x6c, 0xc7, 0x76, 0x6c, 0xc7, 0x76, 0x1c, 
+  0xc7, 0x71, 0x1c, 0xc7, 0x71, 0x1c, 0xc7, 0x71, 0x1c, 0xc7, 0x71, 0x1c, 
+  0xc7, 0x71, 0x5c, 0xc7, 0x75, 0x5c, 0xc7, 0x75, 0x5c, 0xc7, 0x75, 0x5c, 
+  0xc7, 0x75, 0x5c, 0xc7, 0x75, 0xb4, 0xa3, 0x1d, 0xed, 0x68, 0x47, 0x3b, 
+  0xda, 0xd1, 0x8e, 0x76, 0xb4, 0xa3, 0x1d, 0xe3, 0x18, 0xc7, 0x38, 0xc6, 
+  0x31, 0x8e, 0x71, 0x8c, 0x63, 0x1c, 0xe3, 0x98, 0x79, 0xfd, 0x01, 0x7f, 
+  0x3e, 0xf8, 0xa5, 
+};
+
+static const size_t image_bin_size = sizeof(image_bin);
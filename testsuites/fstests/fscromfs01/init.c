@@ -0,0 +1,655 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <rtems/cromfs.h>
+#include <rtems/cromfs-image.h>
+#include <rtems/libio.h>
+
+#include "image.h"
+
+const char rtems_test_name[] = "FSCROMFS 1";
+
+#define MOUNT_POINT "/cromfs"
+
+#define DEVICE "/image"
+
+#define MTIME 1400000000
+
+#define A_TXT_LINES 300
+
+#define A_TXT_LINE_SIZE 10
+
+#define LARGE_MOUNT_POINT "/large"
+
+#define LARGE_BLOCK_SIZE 4096
+
+#define LARGE_BLOCKS 64
+
+#define LARGE_FILE_SIZE (LARGE_BLOCKS * LARGE_BLOCK_SIZE)
+
+#define LARGE_SEQ_CHUNK_SIZE 1024
+
+#define LARGE_RANDOM_CHUNK_SIZE 512
+
+#define LARGE_RANDOM_READS 1024
+
+static const uint32_t cache_sizes[] = { 1, 4, 16, 64 };
+
+static char buf[LARGE_SEQ_CHUNK_SIZE];
+
+static uint32_t lcg(uint32_t *state)
+{
+  *state = *state * 1103515245 + 12345;
+
+  return *state >> 16;
+}
+
+static void mount_image(
+  const char *source,
+  const char *target,
+  const rtems_cromfs_mount_data *mount_data
+)
+{
+  int rv;
+
+  rv = mount_and_make_target_path(
+    source,
+    target,
+    RTEMS_FILESYSTEM_TYPE_CROMFS,
+    RTEMS_FILESYSTEM_READ_ONLY,
+    mount_data
+  );
+  rtems_test_assert(rv == 0);
+}
+
+static void check_a_txt_line(const char *line, int i)
+{
+  char expected[A_TXT_LINE_SIZE + 1];
+
+  snprintf(expected, sizeof(expected), "line %04i\n", i);
+  rtems_test_assert(memcmp(line, expected, A_TXT_LINE_SIZE) == 0);
+}
+
+static void test_stat(void)
+{
+  struct stat st;
+  int rv;
+
+  rv = stat(MOUNT_POINT, &st);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(st.st_mode == (S_IFDIR | 0755));
+  rtems_test_assert(st.st_mtime == MTIME);
+
+  rv = stat(MOUNT_POINT "/README", &st);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(st.st_mode == (S_IFREG | 0644));
+  rtems_test_assert(st.st_size == 15);
+  rtems_test_assert(st.st_mtime == MTIME);
+  rtems_test_assert(st.st_nlink == 1);
+
+  rv = stat(MOUNT_POINT "/dir/a.txt", &st);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(st.st_size == A_TXT_LINES * A_TXT_LINE_SIZE);
+
+  rv = lstat(MOUNT_POINT "/link", &st);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(S_ISLNK(st.st_mode));
+
+  rv = stat(MOUNT_POINT "/link", &st);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(S_ISREG(st.st_mode));
+  rtems_test_assert(st.st_size == A_TXT_LINES * A_TXT_LINE_SIZE);
+
+  rv = stat(MOUNT_POINT "/dir/sub/..", &st);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(S_ISDIR(st.st_mode));
+
+  errno = 0;
+  rv = stat(MOUNT_POINT "/dir/nix", &st);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == ENOENT);
+
+  errno = 0;
+  rv = stat(MOUNT_POINT "/README/nix", &st);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == ENOTDIR);
+}
+
+static void test_read(void)
+{
+  ssize_t n;
+  off_t off;
+  int fd;
+  int rv;
+  int i;
+
+  fd = open(MOUNT_POINT "/README", O_RDONLY);
+  rtems_test_assert(fd >= 0);
+
+  n = read(fd, buf, sizeof(buf));
+  rtems_test_assert(n == 15);
+  rtems_test_assert(memcmp(buf, "Hello, CROMFS!\n", 15) == 0);
+
+  n = read(fd, buf, sizeof(buf));
+  rtems_test_assert(n == 0);
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+
+  /* The chunks cross the block boundaries of the 1024 bytes blocks */
+  fd = open(MOUNT_POINT "/link", O_RDONLY);
+  rtems_test_assert(fd >= 0);
+
+  for (i = 0; i < A_TXT_LINES; i += 7) {
+    int lines = A_TXT_LINES - i < 7 ? A_TXT_LINES - i : 7;
+    int j;
+
+    n = read(fd, buf, 7 * A_TXT_LINE_SIZE);
+    rtems_test_assert(n == lines * A_TXT_LINE_SIZE);
+
+    for (j = 0; j < lines; ++j) {
+      check_a_txt_line(&buf[j * A_TXT_LINE_SIZE], i + j);
+    }
+  }
+
+  n = read(fd, buf, sizeof(buf));
+  rtems_test_assert(n == 0);
+
+  off = lseek(fd, 150 * A_TXT_LINE_SIZE, SEEK_SET);
+  rtems_test_assert(off == 150 * A_TXT_LINE_SIZE);
+
+  n = read(fd, buf, A_TXT_LINE_SIZE);
+  rtems_test_assert(n == A_TXT_LINE_SIZE);
+  check_a_txt_line(buf, 150);
+
+  n = pread(fd, buf, A_TXT_LINE_SIZE, 102 * A_TXT_LINE_SIZE);
+  rtems_test_assert(n == A_TXT_LINE_SIZE);
+  check_a_txt_line(buf, 102);
+
+  errno = 0;
+  n = write(fd, buf, 1);
+  rtems_test_assert(n == -1);
+  rtems_test_assert(errno == EBADF);
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+
+  fd = open(MOUNT_POINT "/dir/empty", O_RDONLY);
+  rtems_test_assert(fd >= 0);
+
+  n = read(fd, buf, sizeof(buf));
+  rtems_test_assert(n == 0);
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+}
+
+static void test_readdir(void)
+{
+  static const char *const names[] = { ".", "..", "README", "dir", "link" };
+  struct dirent *d;
+  DIR *dir;
+  size_t i;
+  int rv;
+
+  dir = opendir(MOUNT_POINT);
+  rtems_test_assert(dir != NULL);
+
+  for (i = 0; i < RTEMS_ARRAY_SIZE(names); ++i) {
+    d = readdir(dir);
+    rtems_test_assert(d != NULL);
+    rtems_test_assert(strcmp(d->d_name, names[i]) == 0);
+  }
+
+  d = readdir(dir);
+  rtems_test_assert(d == NULL);
+
+  rv = closedir(dir);
+  rtems_test_assert(rv == 0);
+
+  dir = opendir(MOUNT_POINT "/dir/sub");
+  rtems_test_assert(dir != NULL);
+
+  d = readdir(dir);
+  rtems_test_assert(d != NULL);
+  rtems_test_assert(strcmp(d->d_name, ".") == 0);
+
+  d = readdir(dir);
+  rtems_test_assert(d != NULL);
+  rtems_test_assert(strcmp(d->d_name, "..") == 0);
+
+  d = readdir(dir);
+  rtems_test_assert(d == NULL);
+
+  rv = closedir(dir);
+  rtems_test_assert(rv == 0);
+}
+
+static void test_readlink(void)
+{
+  char target[16];
+  ssize_t n;
+
+  n = readlink(MOUNT_POINT "/link", target, sizeof(target));
+  rtems_test_assert(n == 9);
+  rtems_test_assert(memcmp(target, "dir/a.txt", 9) == 0);
+
+  errno = 0;
+  n = readlink(MOUNT_POINT "/README", target, sizeof(target));
+  rtems_test_assert(n == -1);
+  rtems_test_assert(errno == EINVAL);
+}
+
+static void test_read_only(void)
+{
+  int fd;
+  int rv;
+
+  errno = 0;
+  fd = open(MOUNT_POINT "/new", O_RDWR | O_CREAT, 0644);
+  rtems_test_assert(fd == -1);
+  rtems_test_assert(errno == EROFS);
+
+  errno = 0;
+  fd = open(MOUNT_POINT "/README", O_WRONLY);
+  rtems_test_assert(fd == -1);
+  rtems_test_assert(errno == EROFS);
+
+  errno = 0;
+  rv = mkdir(MOUNT_POINT "/new", 0755);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == EROFS);
+
+  errno = 0;
+  rv = unlink(MOUNT_POINT "/README");
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == EROFS);
+}
+
+static void test_statvfs(void)
+{
+  struct statvfs st;
+  int rv;
+
+  rv = statvfs(MOUNT_POINT, &st);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(st.f_bsize == 1024);
+  rtems_test_assert(st.f_files == 7);
+  rtems_test_assert(st.f_bfree == 0);
+  rtems_test_assert(st.f_namemax == RTEMS_CROMFS_NAME_MAX);
+}
+
+static void test_files(void)
+{
+  test_stat();
+  test_read();
+  test_readdir();
+  test_readlink();
+  test_read_only();
+  test_statvfs();
+}
+
+static void test_memory_image(void)
+{
+  rtems_cromfs_mount_data mount_data = {
+    .image = image_bin,
+    .image_size = image_bin_size,
+    .cache_blocks = 1
+  };
+  int rv;
+
+  mount_image(NULL, MOUNT_POINT, &mount_data);
+  test_files();
+
+  rv = unmount(MOUNT_POINT);
+  rtems_test_assert(rv == 0);
+}
+
+static void test_device_image(void)
+{
+  ssize_t n;
+  int fd;
+  int rv;
+
+  fd = open(DEVICE, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  rtems_test_assert(fd >= 0);
+
+  n = write(fd, image_bin, image_bin_size);
+  rtems_test_assert(n == (ssize_t) image_bin_size);
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+
+  mount_image(DEVICE, MOUNT_POINT, NULL);
+  test_files();
+
+  rv = unmount(MOUNT_POINT);
+  rtems_test_assert(rv == 0);
+
+  rv = unlink(DEVICE);
+  rtems_test_assert(rv == 0);
+}
+
+static void test_invalid_image(void)
+{
+  rtems_cromfs_mount_data mount_data = {
+    .image_size = image_bin_size
+  };
+  unsigned char *copy;
+  int rv;
+
+  copy = malloc(image_bin_size);
+  rtems_test_assert(copy != NULL);
+  mount_data.image = copy;
+
+  memcpy(copy, image_bin, image_bin_size);
+  copy[RTEMS_CROMFS_SB_MAGIC] ^= 0xff;
+
+  errno = 0;
+  rv = mount_and_make_target_path(
+    NULL,
+    MOUNT_POINT,
+    RTEMS_FILESYSTEM_TYPE_CROMFS,
+    RTEMS_FILESYSTEM_READ_ONLY,
+    &mount_data
+  );
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == EINVAL);
+
+  /* Truncated image */
+  mount_data.image = image_bin;
+  mount_data.image_size = image_bin_size - 1;
+
+  errno = 0;
+  rv = mount(
+    NULL,
+    MOUNT_POINT,
+    RTEMS_FILESYSTEM_TYPE_CROMFS,
+    RTEMS_FILESYSTEM_READ_ONLY,
+    &mount_data
+  );
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == EINVAL);
+
+  /* No image and no device */
+  errno = 0;
+  rv = mount(
+    NULL,
+    MOUNT_POINT,
+    RTEMS_FILESYSTEM_TYPE_CROMFS,
+    RTEMS_FILESYSTEM_READ_ONLY,
+    NULL
+  );
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == EINVAL);
+
+  free(copy);
+}
+
+static uint8_t large_pattern(uint32_t *state)
+{
+  static const char hex[] = "0123456789abcdef";
+
+  return (uint8_t) hex[lcg(state) % 16];
+}
+
+static void set_large_node(
+  uint8_t *node,
+  mode_t mode,
+  uint32_t size,
+  uint32_t name,
+  uint32_t first,
+  uint32_t count
+)
+{
+  rtems_cromfs_set_u32(node + RTEMS_CROMFS_NODE_MODE, mode);
+  rtems_cromfs_set_u32(node + RTEMS_CROMFS_NODE_OWNER, 0);
+  rtems_cromfs_set_u32(node + RTEMS_CROMFS_NODE_MTIME, MTIME);
+  rtems_cromfs_set_u32(node + RTEMS_CROMFS_NODE_SIZE, size);
+  rtems_cromfs_set_u32(node + RTEMS_CROMFS_NODE_NAME, name);
+  rtems_cromfs_set_u32(node + RTEMS_CROMFS_NODE_PARENT, 0);
+  rtems_cromfs_set_u32(node + RTEMS_CROMFS_NODE_FIRST, first);
+  rtems_cromfs_set_u32(node + RTEMS_CROMFS_NODE_COUNT, count);
+}
+
+/*
+ * Creates an image with the file "large" in the root directory.  The file
+ * content is a random sequence of hexadecimal digits, so that the blocks
+ * compress to a bit more than a half.
+ */
+static uint8_t *create_large_image(size_t *image_size)
+{
+  const uint32_t node_offset = RTEMS_CROMFS_SB_SIZE;
+  const uint32_t name_offset = node_offset + 2 * RTEMS_CROMFS_NODE_ENTRY_SIZE;
+  const uint32_t index_offset = (name_offset + sizeof("large") + 3) & ~3U;
+  const uint32_t data_offset = index_offset + (LARGE_BLOCKS + 1) * 4;
+  uLong bound = compressBound(LARGE_BLOCK_SIZE);
+  uint8_t *block;
+  uint8_t *check;
+  uint8_t *image;
+  uint32_t offset;
+  uint32_t state;
+  uint32_t i;
+
+  image = calloc(1, data_offset + LARGE_BLOCKS * bound);
+  block = malloc(LARGE_BLOCK_SIZE);
+  check = malloc(LARGE_BLOCK_SIZE);
+  rtems_test_assert(image != NULL && block != NULL && check != NULL);
+
+  rtems_cromfs_set_u32(image + RTEMS_CROMFS_SB_MAGIC, RTEMS_CROMFS_MAGIC);
+  rtems_cromfs_set_u32(image + RTEMS_CROMFS_SB_VERSION, RTEMS_CROMFS_VERSION);
+  rtems_cromfs_set_u32(image + RTEMS_CROMFS_SB_BLOCK_SIZE, LARGE_BLOCK_SIZE);
+  rtems_cromfs_set_u32(image + RTEMS_CROMFS_SB_NODE_COUNT, 2);
+  rtems_cromfs_set_u32(image + RTEMS_CROMFS_SB_NODE_OFFSET, node_offset);
+  rtems_cromfs_set_u32(image + RTEMS_CROMFS_SB_DATA_OFFSET, data_offset);
+
+  /* The root directory uses the terminating NUL of "large" as its name */
+  set_large_node(
+    image + node_offset,
+    S_IFDIR | 0555,
+    0,
+    name_offset + sizeof("large") - 1,
+    1,
+    1
+  );
+  set_large_node(
+    image + node_offset + RTEMS_CROMFS_NODE_ENTRY_SIZE,
+    S_IFREG | 0444,
+    LARGE_FILE_SIZE,
+    name_offset,
+    index_offset,
+    LARGE_BLOCKS
+  );
+  memcpy(image + name_offset, "large", sizeof("large"));
+
+  state = 0;
+  offset = data_offset;
+
+  for (i = 0; i < LARGE_BLOCKS; ++i) {
+    uLongf size = bound;
+    uLongf check_size = LARGE_BLOCK_SIZE;
+    size_t j;
+    int rv;
+
+    for (j = 0; j < LARGE_BLOCK_SIZE; ++j) {
+      block[j] = large_pattern(&state);
+    }
+
+    rv = compress2(image + offset, &size, block, LARGE_BLOCK_SIZE, 9);
+    rtems_test_assert(rv == Z_OK);
+    rtems_test_assert(size < LARGE_BLOCK_SIZE);
+
+    rv = uncompress(check, &check_size, image + offset, size);
+    rtems_test_assert(rv == Z_OK);
+    rtems_test_assert(check_size == LARGE_BLOCK_SIZE);
+    rtems_test_assert(memcmp(check, block, LARGE_BLOCK_SIZE) == 0);
+
+    rtems_cromfs_set_u32(image + index_offset + i * 4, offset);
+    offset += size;
+  }
+
+  rtems_cromfs_set_u32(image + index_offset + LARGE_BLOCKS * 4, offset);
+  rtems_cromfs_set_u32(image + RTEMS_CROMFS_SB_IMAGE_SIZE, offset);
+
+  free(check);
+  free(block);
+
+  *image_size = offset;
+
+  return image;
+}
+
+static uint8_t *create_large_data(void)
+{
+  uint8_t *data;
+  uint32_t state;
+  size_t i;
+
+  data = malloc(LARGE_FILE_SIZE);
+  rtems_test_assert(data != NULL);
+
+  state = 0;
+
+  for (i = 0; i < LARGE_FILE_SIZE; ++i) {
+    data[i] = large_pattern(&state);
+  }
+
+  return data;
+}
+
+static void sequential_read(const uint8_t *data)
+{
+  off_t off;
+  int fd;
+  int rv;
+
+  fd = open(LARGE_MOUNT_POINT "/large", O_RDONLY);
+  rtems_test_assert(fd >= 0);
+
+  for (off = 0; off < LARGE_FILE_SIZE; off += LARGE_SEQ_CHUNK_SIZE) {
+    ssize_t n = read(fd, buf, LARGE_SEQ_CHUNK_SIZE);
+    rtems_test_assert(n == LARGE_SEQ_CHUNK_SIZE);
+    rtems_test_assert(memcmp(buf, &data[off], LARGE_SEQ_CHUNK_SIZE) == 0);
+  }
+
+  rtems_test_assert(read(fd, buf, LARGE_SEQ_CHUNK_SIZE) == 0);
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+}
+
+static void random_read(const uint8_t *data)
+{
+  uint32_t state = 1;
+  int fd;
+  int rv;
+  int i;
+
+  fd = open(LARGE_MOUNT_POINT "/large", O_RDONLY);
+  rtems_test_assert(fd >= 0);
+
+  for (i = 0; i < LARGE_RANDOM_READS; ++i) {
+    off_t off = (lcg(&state) << 4)
+      % (LARGE_FILE_SIZE - LARGE_RANDOM_CHUNK_SIZE);
+    ssize_t n = pread(fd, buf, LARGE_RANDOM_CHUNK_SIZE, off);
+    rtems_test_assert(n == LARGE_RANDOM_CHUNK_SIZE);
+    rtems_test_assert(memcmp(buf, &data[off], LARGE_RANDOM_CHUNK_SIZE) == 0);
+  }
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+}
+
+/*
+ * Reads a file of many compressed blocks sequentially and at random offsets
+ * with different counts of cached blocks
+ */
+static void test_cache(void)
+{
+  rtems_cromfs_mount_data mount_data;
+  uint8_t *image;
+  uint8_t *data;
+  size_t image_size;
+  size_t i;
+  int rv;
+
+  image = create_large_image(&image_size);
+  rtems_test_assert(image_size < LARGE_FILE_SIZE);
+
+  data = create_large_data();
+
+  mount_data.image = image;
+  mount_data.image_size = image_size;
+
+  for (i = 0; i < RTEMS_ARRAY_SIZE(cache_sizes); ++i) {
+    printf("cache %2" PRIu32 " blocks\n", cache_sizes[i]);
+
+    mount_data.cache_blocks = cache_sizes[i];
+    mount_image(NULL, LARGE_MOUNT_POINT, &mount_data);
+
+    sequential_read(data);
+    random_read(data);
+
+    rv = unmount(LARGE_MOUNT_POINT);
+    rtems_test_assert(rv == 0);
+  }
+
+  free(data);
+  free(image);
+}
+
+static void Init(rtems_task_argument arg)
+{
+  TEST_BEGIN();
+
+  test_memory_image();
+  test_device_image();
+  test_invalid_image();
+  test_cache();
+
+  TEST_END();
+
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_DOES_NOT_NEED_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+
+#define CONFIGURE_FILESYSTEM_CROMFS
+
+#define CONFIGURE_USE_IMFS_AS_BASE_FILESYSTEM
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 8
+
+#define CONFIGURE_MAXIMUM_TASKS 1
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
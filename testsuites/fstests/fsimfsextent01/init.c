@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems/imfs.h>
+#include <rtems/libio_.h>
+
+const char rtems_test_name[] = "FSIMFSEXTENT 1";
+
+#define FILE_NAME "/file"
+
+#define BYTES_PER_BLOCK 16
+
+#define EXTENT_SIZE 1024
+
+#define FILE_SIZE (256 * 1024)
+
+#define CHUNK_SIZE 1000
+
+static uint8_t buf[EXTENT_SIZE];
+
+static uint8_t pattern(off_t offset)
+{
+  return (uint8_t) (offset % 251);
+}
+
+static void write_file(int fd)
+{
+  off_t offset;
+
+  for (offset = 0; offset < FILE_SIZE; offset += CHUNK_SIZE) {
+    size_t size = CHUNK_SIZE;
+    ssize_t n;
+    size_t i;
+
+    if (size > FILE_SIZE - offset) {
+      size = FILE_SIZE - offset;
+    }
+
+    for (i = 0; i < size; ++i) {
+      buf[i] = pattern(offset + (off_t) i);
+    }
+
+    n = write(fd, buf, size);
+    rtems_test_assert(n == (ssize_t) size);
+  }
+}
+
+static void check_file(int fd, size_t chunk_size)
+{
+  off_t offset;
+  off_t off;
+  ssize_t n;
+
+  off = lseek(fd, 0, SEEK_SET);
+  rtems_test_assert(off == 0);
+
+  for (offset = 0; offset < FILE_SIZE; offset += (off_t) n) {
+    ssize_t i;
+
+    n = read(fd, buf, chunk_size);
+    rtems_test_assert(n > 0);
+
+    for (i = 0; i < n; ++i) {
+      rtems_test_assert(buf[i] == pattern(offset + i));
+    }
+  }
+
+  n = read(fd, buf, chunk_size);
+  rtems_test_assert(n == 0);
+}
+
+static void check_zero(int fd, off_t offset, size_t size)
+{
+  ssize_t n;
+  size_t i;
+
+  rtems_test_assert(size <= sizeof(buf));
+
+  n = pread(fd, buf, size, offset);
+  rtems_test_assert(n == (ssize_t) size);
+
+  for (i = 0; i < size; ++i) {
+    rtems_test_assert(buf[i] == 0);
+  }
+}
+
+static void test_data(int fd)
+{
+  struct stat st;
+  int rv;
+
+  rtems_test_assert(IMFS_memfile_maximum_size() > FILE_SIZE);
+
+  write_file(fd);
+
+  rv = fstat(fd, &st);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(st.st_size == FILE_SIZE);
+
+  check_file(fd, CHUNK_SIZE);
+  check_file(fd, 7);
+  check_file(fd, sizeof(buf));
+}
+
+static void test_zero_fill(int fd)
+{
+  uint8_t c = 0xff;
+  ssize_t n;
+  int rv;
+
+  /* Shrink and extend across the extent size and extent boundaries */
+  rv = ftruncate(fd, 3000);
+  rtems_test_assert(rv == 0);
+
+  rv = ftruncate(fd, 10000);
+  rtems_test_assert(rv == 0);
+
+  check_zero(fd, 3000, 1000);
+  check_zero(fd, 4000, 1000);
+  check_zero(fd, 9000, 1000);
+
+  rv = ftruncate(fd, 500);
+  rtems_test_assert(rv == 0);
+
+  n = pwrite(fd, &c, sizeof(c), 20000);
+  rtems_test_assert(n == (ssize_t) sizeof(c));
+
+  check_zero(fd, 500, 1000);
+  check_zero(fd, 10000, 1000);
+  check_zero(fd, 18999, 1000);
+
+  n = pread(fd, &c, sizeof(c), 20000);
+  rtems_test_assert(n == (ssize_t) sizeof(c));
+  rtems_test_assert(c == 0xff);
+
+  rv = ftruncate(fd, 0);
+  rtems_test_assert(rv == 0);
+}
+
+static void test_loan(int fd)
+{
+  rtems_libio_t *iop = rtems_libio_iop(fd);
+  rtems_filesystem_loan loan;
+  ssize_t n;
+
+  /* A loan in the block part ends at the end of the block */
+  n = (*iop->pathinfo.handlers->loan_h)(iop, 8, FILE_SIZE, &loan);
+  rtems_test_assert(n == BYTES_PER_BLOCK - 8);
+  rtems_test_assert(((const uint8_t *) loan.data)[0] == pattern(8));
+  (*loan.release)(&loan);
+
+  /* The third extent covers the file offsets from 4096 up to 8192 */
+  n = (*iop->pathinfo.handlers->loan_h)(iop, 5000, FILE_SIZE, &loan);
+  rtems_test_assert(n == 8192 - 5000);
+  rtems_test_assert(((const uint8_t *) loan.data)[0] == pattern(5000));
+  (*loan.release)(&loan);
+
+  /*
+   * The extent size stops to double at the fifth extent, which covers the
+   * file offsets from 16384 up to 32768.  The extent after it covers the
+   * file offsets from 32768 up to 49152.
+   */
+  n = (*iop->pathinfo.handlers->loan_h)(iop, 20000, FILE_SIZE, &loan);
+  rtems_test_assert(n == 32768 - 20000);
+  rtems_test_assert(((const uint8_t *) loan.data)[0] == pattern(20000));
+  (*loan.release)(&loan);
+
+  n = (*iop->pathinfo.handlers->loan_h)(iop, 40000, FILE_SIZE, &loan);
+  rtems_test_assert(n == 49152 - 40000);
+  rtems_test_assert(((const uint8_t *) loan.data)[0] == pattern(40000));
+  (*loan.release)(&loan);
+
+  n = (*iop->pathinfo.handlers->loan_h)(iop, FILE_SIZE - 1, FILE_SIZE, &loan);
+  rtems_test_assert(n == 1);
+  rtems_test_assert(((const uint8_t *) loan.data)[0] == pattern(FILE_SIZE - 1));
+  (*loan.release)(&loan);
+
+  n = (*iop->pathinfo.handlers->loan_h)(iop, FILE_SIZE, FILE_SIZE, &loan);
+  rtems_test_assert(n == 0);
+}
+
+static void test(void)
+{
+  int fd;
+  int rv;
+
+  fd = open(FILE_NAME, O_CREAT | O_RDWR, S_IRWXU);
+  rtems_test_assert(fd >= 0);
+
+  test_data(fd);
+  test_loan(fd);
+  test_zero_fill(fd);
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+
+  rv = unlink(FILE_NAME);
+  rtems_test_assert(rv == 0);
+}
+
+static void Init(rtems_task_argument arg)
+{
+  TEST_BEGIN();
+
+  test();
+
+  TEST_END();
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_DOES_NOT_NEED_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+
+#define CONFIGURE_USE_IMFS_AS_BASE_FILESYSTEM
+
+#define CONFIGURE_IMFS_MEMFILE_BYTES_PER_BLOCK BYTES_PER_BLOCK
+
+#define CONFIGURE_IMFS_MEMFILE_EXTENT_SIZE EXTENT_SIZE
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 4
+
+#define CONFIGURE_MAXIMUM_TASKS 1
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
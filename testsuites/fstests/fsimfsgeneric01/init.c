@@ -250,7 +250,10 @@ static const rtems_filesystem_file_handlers_r node_handlers = {
   .fdatasync_h = handler_fdatasync,
   .fcntl_h = handler_fcntl,
   .readv_h = handler_readv,
-  .writev_h = handler_writev
+  .writev_h = handler_writev,
+  .loan_h = rtems_filesystem_default_loan,
+  .preadv_h = rtems_filesystem_default_preadv,
+  .pwritev_h = rtems_filesystem_default_pwritev
 };
 
 static IMFS_jnode_t *node_initialize(
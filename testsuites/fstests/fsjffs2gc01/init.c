@@ -0,0 +1,366 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems/jffs2.h>
+#include <rtems/libio.h>
+
+const char rtems_test_name[] = "FSJFFS2GC 1";
+
+#define MOUNT_DIR "/mnt"
+
+#define FILE_STATIC MOUNT_DIR "/static"
+
+#define FILE_LOG MOUNT_DIR "/log"
+
+#define BLOCK_SIZE (16UL * 1024UL)
+
+#define FLASH_SIZE (32UL * BLOCK_SIZE)
+
+#define ERASE_TICKS 2
+
+#define STATIC_SIZE (256UL * 1024UL)
+
+#define LOG_SIZE (32UL * 1024UL)
+
+#define CHUNK_SIZE 1024
+
+#define SAMPLE_COUNT 1024
+
+#define GC_TASK_PRIORITY 250
+
+typedef struct {
+  rtems_jffs2_flash_control super;
+  rtems_id writer;
+  uint32_t writer_erase_count;
+  uint32_t other_erase_count;
+  unsigned char area[FLASH_SIZE];
+} flash_control;
+
+static flash_control *get_flash_control(rtems_jffs2_flash_control *super)
+{
+  return (flash_control *) super;
+}
+
+static int flash_read(
+  rtems_jffs2_flash_control *super,
+  uint32_t offset,
+  unsigned char *buffer,
+  size_t size_of_buffer
+)
+{
+  flash_control *self = get_flash_control(super);
+  unsigned char *chunk = &self->area[offset];
+
+  memcpy(buffer, chunk, size_of_buffer);
+
+  return 0;
+}
+
+static int flash_write(
+  rtems_jffs2_flash_control *super,
+  uint32_t offset,
+  const unsigned char *buffer,
+  size_t size_of_buffer
+)
+{
+  flash_control *self = get_flash_control(super);
+  unsigned char *chunk = &self->area[offset];
+  size_t i;
+
+  for (i = 0; i < size_of_buffer; ++i) {
+    chunk[i] &= buffer[i];
+  }
+
+  return 0;
+}
+
+static int flash_erase(
+  rtems_jffs2_flash_control *super,
+  uint32_t offset
+)
+{
+  flash_control *self = get_flash_control(super);
+  unsigned char *chunk = &self->area[offset];
+  rtems_status_code sc;
+
+  if (rtems_task_self() == self->writer) {
+    ++self->writer_erase_count;
+  } else {
+    ++self->other_erase_count;
+  }
+
+  /* Simulate the erase time of a NOR flash */
+  sc = rtems_task_wake_after(ERASE_TICKS);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  memset(chunk, 0xff, BLOCK_SIZE);
+
+  return 0;
+}
+
+static flash_control flash_instance = {
+  .super = {
+    .block_size = BLOCK_SIZE,
+    .flash_size = FLASH_SIZE,
+    .read = flash_read,
+    .write = flash_write,
+    .erase = flash_erase
+  }
+};
+
+static rtems_jffs2_compressor_control compressor_instance = {
+  .compress = rtems_jffs2_compressor_rtime_compress,
+  .decompress = rtems_jffs2_compressor_rtime_decompress
+};
+
+static rtems_jffs2_mount_data mount_data = {
+  .flash_control = &flash_instance.super,
+  .compressor_control = &compressor_instance
+};
+
+static unsigned char chunk_buf[CHUNK_SIZE];
+
+static uint64_t latencies[SAMPLE_COUNT];
+
+static void fill_chunk(uint32_t seed)
+{
+  uint32_t v = seed + 1;
+  size_t i;
+
+  for (i = 0; i < CHUNK_SIZE; ++i) {
+    v = v * 1103515245 + 12345;
+    chunk_buf[i] = (unsigned char) (v >> 16);
+  }
+}
+
+static void write_file(const char *file, size_t size)
+{
+  size_t done;
+  ssize_t n;
+  int fd;
+  int rv;
+
+  fd = open(file, O_CREAT | O_TRUNC | O_WRONLY, S_IRWXU);
+  rtems_test_assert(fd >= 0);
+
+  for (done = 0; done < size; done += CHUNK_SIZE) {
+    fill_chunk(done / CHUNK_SIZE);
+    n = write(fd, chunk_buf, CHUNK_SIZE);
+    rtems_test_assert(n == CHUNK_SIZE);
+  }
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+}
+
+static void check_file(const char *file, size_t size)
+{
+  unsigned char buf[CHUNK_SIZE];
+  size_t done;
+  ssize_t n;
+  int fd;
+  int rv;
+
+  fd = open(file, O_RDONLY);
+  rtems_test_assert(fd >= 0);
+
+  for (done = 0; done < size; done += CHUNK_SIZE) {
+    fill_chunk(done / CHUNK_SIZE);
+    n = read(fd, buf, CHUNK_SIZE);
+    rtems_test_assert(n == CHUNK_SIZE);
+    rtems_test_assert(memcmp(buf, chunk_buf, CHUNK_SIZE) == 0);
+  }
+
+  n = read(fd, buf, CHUNK_SIZE);
+  rtems_test_assert(n == 0);
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+}
+
+typedef struct {
+  uint32_t writer_erase_count;
+  uint32_t other_erase_count;
+  uint64_t p99;
+} latency_result;
+
+static int compare_latencies(const void *a, const void *b)
+{
+  uint64_t x = *(const uint64_t *) a;
+  uint64_t y = *(const uint64_t *) b;
+
+  return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+/*
+ * Overwrite the log file chunk by chunk.  The writer sleeps between the
+ * writes, so that a garbage collection task can use the idle time.
+ */
+static void overwrite_log(void)
+{
+  size_t chunks = LOG_SIZE / CHUNK_SIZE;
+  int sample;
+  int fd;
+  int rv;
+
+  fd = open(FILE_LOG, O_WRONLY);
+  rtems_test_assert(fd >= 0);
+
+  for (sample = 0; sample < SAMPLE_COUNT; ++sample) {
+    size_t index = (size_t) sample % chunks;
+    rtems_status_code sc;
+    uint64_t start;
+    off_t off;
+    ssize_t n;
+
+    fill_chunk(index);
+
+    start = rtems_clock_get_uptime_nanoseconds();
+
+    off = lseek(fd, (off_t) (index * CHUNK_SIZE), SEEK_SET);
+    rtems_test_assert(off == (off_t) (index * CHUNK_SIZE));
+
+    n = write(fd, chunk_buf, CHUNK_SIZE);
+    rtems_test_assert(n == CHUNK_SIZE);
+
+    latencies[sample] = rtems_clock_get_uptime_nanoseconds() - start;
+
+    sc = rtems_task_wake_after(1);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+}
+
+static void test_latency(
+  rtems_task_priority gc_task_priority,
+  latency_result *result
+)
+{
+  const char *name = gc_task_priority != 0 ? "gc task" : "no gc task";
+  int rv;
+
+  memset(&flash_instance.area[0], 0xff, FLASH_SIZE);
+  flash_instance.writer = rtems_task_self();
+
+  mount_data.gc_task_priority = gc_task_priority;
+
+  rv = mount(
+    NULL,
+    MOUNT_DIR,
+    RTEMS_FILESYSTEM_TYPE_JFFS2,
+    RTEMS_FILESYSTEM_READ_WRITE,
+    &mount_data
+  );
+  rtems_test_assert(rv == 0);
+
+  write_file(FILE_STATIC, STATIC_SIZE);
+  write_file(FILE_LOG, LOG_SIZE);
+
+  flash_instance.writer_erase_count = 0;
+  flash_instance.other_erase_count = 0;
+
+  overwrite_log();
+
+  qsort(&latencies[0], SAMPLE_COUNT, sizeof(latencies[0]), compare_latencies);
+
+  result->writer_erase_count = flash_instance.writer_erase_count;
+  result->other_erase_count = flash_instance.other_erase_count;
+  result->p99 = latencies[(99 * (SAMPLE_COUNT - 1)) / 100];
+
+  check_file(FILE_STATIC, STATIC_SIZE);
+  check_file(FILE_LOG, LOG_SIZE);
+
+  rv = unmount(MOUNT_DIR);
+  rtems_test_assert(rv == 0);
+
+  printf("%s: file content intact\n", name);
+}
+
+static void test(void)
+{
+  latency_result inline_gc;
+  latency_result background_gc;
+  uint64_t erase_ns;
+  int rv;
+
+  rv = mkdir(MOUNT_DIR, S_IRWXU | S_IRWXG | S_IRWXO);
+  rtems_test_assert(rv == 0);
+
+  test_latency(0, &inline_gc);
+  test_latency(GC_TASK_PRIORITY, &background_gc);
+
+  /* A write which waits for an erase takes at least this time */
+  erase_ns = (uint64_t) (ERASE_TICKS - 1)
+    * rtems_configuration_get_nanoseconds_per_tick();
+
+  /* Without the garbage collection task the writer erases all blocks */
+  rtems_test_assert(inline_gc.writer_erase_count > 0);
+  rtems_test_assert(inline_gc.other_erase_count == 0);
+  rtems_test_assert(inline_gc.p99 >= erase_ns);
+
+  /*
+   * With the garbage collection task most erases happen outside the writer,
+   * so that the writer rarely has to wait for an erase.
+   */
+  rtems_test_assert(
+    background_gc.other_erase_count > background_gc.writer_erase_count
+  );
+  rtems_test_assert(
+    background_gc.writer_erase_count < inline_gc.writer_erase_count
+  );
+  rtems_test_assert(background_gc.p99 < erase_ns);
+}
+
+static void Init(rtems_task_argument arg)
+{
+  TEST_BEGIN();
+
+  test();
+
+  TEST_END();
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+
+#define CONFIGURE_USE_IMFS_AS_BASE_FILESYSTEM
+#define CONFIGURE_FILESYSTEM_JFFS2
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 4
+
+#define CONFIGURE_MAXIMUM_TASKS 2
+
+#define CONFIGURE_INIT_TASK_STACK_SIZE (32 * 1024)
+
+#define CONFIGURE_EXTRA_TASK_STACKS (4 * RTEMS_MINIMUM_STACK_SIZE)
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_MAXIMUM_POSIX_KEY_VALUE_PAIRS 1
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
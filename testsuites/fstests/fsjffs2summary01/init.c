@@ -0,0 +1,326 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems/jffs2.h>
+#include <rtems/libio.h>
+
+const char rtems_test_name[] = "FSJFFS2SUMMARY 1";
+
+#define MOUNT_DIR "/mnt"
+
+#define BLOCK_SIZE (16UL * 1024UL)
+
+#define FLASH_SIZE (32UL * BLOCK_SIZE)
+
+#define FILE_COUNT 48
+
+#define FILE_SIZE 4096
+
+/* Magic number of the summary marker at the end of an erase block */
+#define SUM_MAGIC 0x02851885
+
+typedef struct {
+  rtems_jffs2_flash_control super;
+  uint32_t read_count;
+  uint32_t read_bytes;
+  unsigned char area[FLASH_SIZE];
+} flash_control;
+
+static flash_control *get_flash_control(rtems_jffs2_flash_control *super)
+{
+  return (flash_control *) super;
+}
+
+static int flash_read(
+  rtems_jffs2_flash_control *super,
+  uint32_t offset,
+  unsigned char *buffer,
+  size_t size_of_buffer
+)
+{
+  flash_control *self = get_flash_control(super);
+  unsigned char *chunk = &self->area[offset];
+
+  ++self->read_count;
+  self->read_bytes += size_of_buffer;
+
+  memcpy(buffer, chunk, size_of_buffer);
+
+  return 0;
+}
+
+static int flash_write(
+  rtems_jffs2_flash_control *super,
+  uint32_t offset,
+  const unsigned char *buffer,
+  size_t size_of_buffer
+)
+{
+  flash_control *self = get_flash_control(super);
+  unsigned char *chunk = &self->area[offset];
+  size_t i;
+
+  for (i = 0; i < size_of_buffer; ++i) {
+    chunk[i] &= buffer[i];
+  }
+
+  return 0;
+}
+
+static int flash_erase(
+  rtems_jffs2_flash_control *super,
+  uint32_t offset
+)
+{
+  flash_control *self = get_flash_control(super);
+  unsigned char *chunk = &self->area[offset];
+
+  memset(chunk, 0xff, BLOCK_SIZE);
+
+  return 0;
+}
+
+static flash_control flash_instance = {
+  .super = {
+    .block_size = BLOCK_SIZE,
+    .flash_size = FLASH_SIZE,
+    .read = flash_read,
+    .write = flash_write,
+    .erase = flash_erase
+  }
+};
+
+static rtems_jffs2_compressor_control compressor_instance = {
+  .compress = rtems_jffs2_compressor_rtime_compress,
+  .decompress = rtems_jffs2_compressor_rtime_decompress
+};
+
+static const rtems_jffs2_mount_data mount_data = {
+  .flash_control = &flash_instance.super,
+  .compressor_control = &compressor_instance
+};
+
+static unsigned char file_buf[FILE_SIZE];
+
+static void fill_file_buf(int file)
+{
+  uint32_t v = (uint32_t) file + 1;
+  size_t i;
+
+  for (i = 0; i < FILE_SIZE; ++i) {
+    v = v * 1103515245 + 12345;
+    file_buf[i] = (unsigned char) (v >> 16);
+  }
+}
+
+static void file_name(char *name, size_t size, int file)
+{
+  snprintf(name, size, MOUNT_DIR "/file-%02i", file);
+}
+
+static void mount_fs(void)
+{
+  int rv;
+
+  rv = mount(
+    NULL,
+    MOUNT_DIR,
+    RTEMS_FILESYSTEM_TYPE_JFFS2,
+    RTEMS_FILESYSTEM_READ_WRITE,
+    &mount_data
+  );
+  rtems_test_assert(rv == 0);
+}
+
+static void unmount_fs(void)
+{
+  int rv;
+
+  rv = unmount(MOUNT_DIR);
+  rtems_test_assert(rv == 0);
+}
+
+static void create_files(void)
+{
+  int file;
+
+  for (file = 0; file < FILE_COUNT; ++file) {
+    char name[32];
+    ssize_t n;
+    int fd;
+    int rv;
+
+    file_name(name, sizeof(name), file);
+    fill_file_buf(file);
+
+    fd = open(name, O_CREAT | O_WRONLY, S_IRWXU);
+    rtems_test_assert(fd >= 0);
+
+    n = write(fd, file_buf, sizeof(file_buf));
+    rtems_test_assert(n == (ssize_t) sizeof(file_buf));
+
+    rv = close(fd);
+    rtems_test_assert(rv == 0);
+  }
+}
+
+static void check_files(void)
+{
+  int file;
+
+  for (file = 0; file < FILE_COUNT; ++file) {
+    unsigned char buf[FILE_SIZE];
+    char name[32];
+    ssize_t n;
+    int fd;
+    int rv;
+
+    file_name(name, sizeof(name), file);
+    fill_file_buf(file);
+
+    fd = open(name, O_RDONLY);
+    rtems_test_assert(fd >= 0);
+
+    n = read(fd, buf, sizeof(buf));
+    rtems_test_assert(n == (ssize_t) sizeof(buf));
+    rtems_test_assert(memcmp(buf, file_buf, sizeof(buf)) == 0);
+
+    n = read(fd, buf, sizeof(buf));
+    rtems_test_assert(n == 0);
+
+    rv = close(fd);
+    rtems_test_assert(rv == 0);
+  }
+}
+
+static int invalidate_summaries(void)
+{
+  int count = 0;
+  uint32_t offset;
+
+  for (offset = 0; offset < FLASH_SIZE; offset += BLOCK_SIZE) {
+    uint32_t *magic = (uint32_t *)
+      &flash_instance.area[offset + BLOCK_SIZE - sizeof(*magic)];
+
+    if (*magic == SUM_MAGIC) {
+      *magic = 0;
+      ++count;
+    }
+  }
+
+  return count;
+}
+
+typedef struct {
+  uint32_t read_count;
+  uint32_t read_bytes;
+  uint64_t ns;
+} mount_result;
+
+static void measure_mount(mount_result *result)
+{
+  flash_control *self = &flash_instance;
+  uint64_t start;
+
+  self->read_count = 0;
+  self->read_bytes = 0;
+
+  start = rtems_clock_get_uptime_nanoseconds();
+  mount_fs();
+  result->ns = rtems_clock_get_uptime_nanoseconds() - start;
+
+  result->read_count = self->read_count;
+  result->read_bytes = self->read_bytes;
+}
+
+static void test(void)
+{
+  mount_result summary;
+  mount_result full_scan;
+  int summaries;
+  int rv;
+
+  memset(&flash_instance.area[0], 0xff, FLASH_SIZE);
+
+  rv = mkdir(MOUNT_DIR, S_IRWXU | S_IRWXG | S_IRWXO);
+  rtems_test_assert(rv == 0);
+
+  mount_fs();
+  create_files();
+  unmount_fs();
+
+  measure_mount(&summary);
+  check_files();
+  unmount_fs();
+
+  summaries = invalidate_summaries();
+
+  measure_mount(&full_scan);
+  check_files();
+  unmount_fs();
+
+#ifdef RTEMS_JFFS2_SUMMARY
+  /*
+   * The summary mount reads only the summary of the full erase blocks and
+   * does not scan their nodes, so it needs less reads and less time.
+   */
+  rtems_test_assert(summaries > 0);
+  rtems_test_assert(summary.read_bytes < full_scan.read_bytes);
+  rtems_test_assert(summary.read_count < full_scan.read_count);
+  rtems_test_assert(summary.ns < full_scan.ns);
+#else
+  /* Without the summary support all erase blocks are scanned */
+  rtems_test_assert(summaries == 0);
+  rtems_test_assert(summary.read_bytes == full_scan.read_bytes);
+  rtems_test_assert(summary.read_count == full_scan.read_count);
+#endif
+}
+
+static void Init(rtems_task_argument arg)
+{
+  TEST_BEGIN();
+
+  test();
+
+  TEST_END();
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+
+#define CONFIGURE_USE_IMFS_AS_BASE_FILESYSTEM
+#define CONFIGURE_FILESYSTEM_JFFS2
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 4
+
+#define CONFIGURE_MAXIMUM_TASKS 1
+
+#define CONFIGURE_INIT_TASK_STACK_SIZE (32 * 1024)
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_MAXIMUM_POSIX_KEY_VALUE_PAIRS 1
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -12,6 +12,7 @@
 #endif
 
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <string.h>
 #include <stdlib.h>
 #include <fcntl.h>
@@ -559,6 +560,98 @@ truncate_to_zero (void)
   test_case_leave ();
 }
 
+/*
+ * preadv() and pwritev() use the offset argument and do not move the file
+ * offset.  pwritev() writes at the offset even if the file is open for
+ * append.
+ */
+static void
+positional_vector_test (void)
+{
+  int fd;
+  ssize_t n;
+  int status;
+  off_t pos;
+  struct stat st;
+  char data[] = "abcd";
+  char buf[6];
+  struct iovec iov[2];
+
+  test_case_enter (__func__);
+
+  fd = creat ("file", mode);
+  rtems_test_assert (fd >= 0);
+
+  n = write (fd, databuf, len);
+  rtems_test_assert (n == (ssize_t) len);
+
+  status = close (fd);
+  rtems_test_assert (status == 0);
+
+  fd = open ("file", O_RDWR | O_APPEND);
+  rtems_test_assert (fd >= 0);
+
+  pos = lseek (fd, 3, SEEK_SET);
+  rtems_test_assert (pos == 3);
+
+  iov[0].iov_base = &data[0];
+  iov[0].iov_len = 2;
+  iov[1].iov_base = &data[2];
+  iov[1].iov_len = 2;
+  n = pwritev (fd, iov, 2, 1);
+  rtems_test_assert (n == 4);
+
+  pos = lseek (fd, 0, SEEK_CUR);
+  rtems_test_assert (pos == 3);
+
+  status = fstat (fd, &st);
+  rtems_test_assert (status == 0);
+  rtems_test_assert (st.st_size == (off_t) len);
+
+  iov[0].iov_base = &buf[0];
+  iov[0].iov_len = 3;
+  iov[1].iov_base = &buf[3];
+  iov[1].iov_len = 3;
+  n = preadv (fd, iov, 2, 0);
+  rtems_test_assert (n == 6);
+  rtems_test_assert (memcmp (buf, "Habcd ", 6) == 0);
+
+  pos = lseek (fd, 0, SEEK_CUR);
+  rtems_test_assert (pos == 3);
+
+  n = preadv (fd, iov, 2, (off_t) len - 2);
+  rtems_test_assert (n == 2);
+  rtems_test_assert (memcmp (buf, &databuf[len - 2], 2) == 0);
+
+  n = preadv (fd, iov, 2, (off_t) len);
+  rtems_test_assert (n == 0);
+
+  errno = 0;
+  n = preadv (fd, iov, 2, -1);
+  rtems_test_assert (n == -1);
+  rtems_test_assert (errno == EINVAL);
+
+  errno = 0;
+  n = pwritev (fd, iov, 2, -1);
+  rtems_test_assert (n == -1);
+  rtems_test_assert (errno == EINVAL);
+
+  /*
+   * A write() still appends.
+   */
+  n = write (fd, "x", 1);
+  rtems_test_assert (n == 1);
+
+  status = fstat (fd, &st);
+  rtems_test_assert (status == 0);
+  rtems_test_assert (st.st_size == (off_t) len + 1);
+
+  status = close (fd);
+  rtems_test_assert (status == 0);
+
+  test_case_leave ();
+}
+
 static void
 random_fill (char *dst, size_t n)
 {
@@ -814,6 +907,7 @@ test (void)
   lseek_test ();
   truncate_test03 ();
   truncate_to_zero ();
+  positional_vector_test ();
   block_read_and_write ();
   write_until_no_space_is_left ();
 }
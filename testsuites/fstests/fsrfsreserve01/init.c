@@ -0,0 +1,500 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+#include <unistd.h>
+
+#include <rtems/blkdev.h>
+#include <rtems/libio_.h>
+#include <rtems/rfs/rtems-rfs-file.h>
+#include <rtems/rtems-rfs-format.h>
+#include <rtems/sparse-disk.h>
+
+const char rtems_test_name[] = "FSRFSRESERVE 1";
+
+#define DEV_NAME "/dev/sda"
+#define MOUNT_DIR "/mnt"
+#define FILE_A MOUNT_DIR "/a"
+#define FILE_B MOUNT_DIR "/b"
+#define FILE_C MOUNT_DIR "/c"
+
+#define BLOCK_SIZE 512
+#define MEDIA_BLOCKS 4096
+#define FILE_BLOCKS 64
+
+static uint8_t block_buf[BLOCK_SIZE];
+
+static uint8_t file_buf[BLOCK_SIZE * FILE_BLOCKS];
+
+static const char *mount_options;
+
+typedef struct {
+  uint32_t write_transfers;
+  int      interleaved_fragments;
+  int      sequential_fragments;
+} layout_result;
+
+static void fill_block( uint8_t *buf, char file, int block )
+{
+  memset( buf, file + block, BLOCK_SIZE );
+}
+
+static void format_and_mount( bool reserve_blocks, const char *options )
+{
+  rtems_rfs_format_config config;
+  int                     rv;
+
+  memset( &config, 0, sizeof( config ) );
+  config.block_size = BLOCK_SIZE;
+  config.reserve_blocks = reserve_blocks;
+
+  rv = rtems_rfs_format( DEV_NAME, &config );
+  rtems_test_assert( rv == 0 );
+
+  mount_options = options;
+
+  rv = mount( DEV_NAME,
+              MOUNT_DIR,
+              RTEMS_FILESYSTEM_TYPE_RFS,
+              RTEMS_FILESYSTEM_READ_WRITE,
+              mount_options );
+  rtems_test_assert( rv == 0 );
+}
+
+static void remount( void )
+{
+  int rv;
+
+  rv = unmount( MOUNT_DIR );
+  rtems_test_assert( rv == 0 );
+
+  rv = mount( DEV_NAME,
+              MOUNT_DIR,
+              RTEMS_FILESYSTEM_TYPE_RFS,
+              RTEMS_FILESYSTEM_READ_WRITE,
+              mount_options );
+  rtems_test_assert( rv == 0 );
+}
+
+static void device_ioctl( ioctl_command_t command, void *arg )
+{
+  int fd;
+  int rv;
+
+  fd = open( DEV_NAME, O_RDONLY );
+  rtems_test_assert( fd >= 0 );
+
+  rv = ioctl( fd, command, arg );
+  rtems_test_assert( rv == 0 );
+
+  rv = close( fd );
+  rtems_test_assert( rv == 0 );
+}
+
+/*
+ * Append a block to each file in turn so the files grow together. Without
+ * block reservation the blocks of the files are interleaved on the media.
+ */
+static void write_interleaved( void )
+{
+  int     fd_a;
+  int     fd_b;
+  int     block;
+  ssize_t n;
+  int     rv;
+
+  fd_a = open( FILE_A, O_CREAT | O_WRONLY, S_IRWXU );
+  rtems_test_assert( fd_a >= 0 );
+
+  fd_b = open( FILE_B, O_CREAT | O_WRONLY, S_IRWXU );
+  rtems_test_assert( fd_b >= 0 );
+
+  for ( block = 0; block < FILE_BLOCKS; ++block ) {
+    fill_block( block_buf, 'a', block );
+    n = write( fd_a, block_buf, BLOCK_SIZE );
+    rtems_test_assert( n == BLOCK_SIZE );
+
+    fill_block( block_buf, 'b', block );
+    n = write( fd_b, block_buf, BLOCK_SIZE );
+    rtems_test_assert( n == BLOCK_SIZE );
+  }
+
+  rv = close( fd_a );
+  rtems_test_assert( rv == 0 );
+
+  rv = close( fd_b );
+  rtems_test_assert( rv == 0 );
+}
+
+static uint32_t rewrite_file( const char *file )
+{
+  rtems_blkdev_stats stats;
+  int                block;
+  int                fd;
+  ssize_t            n;
+  int                rv;
+
+  for ( block = 0; block < FILE_BLOCKS; ++block ) {
+    fill_block( &file_buf[ block * BLOCK_SIZE ], 'a', block );
+  }
+
+  fd = open( file, O_WRONLY );
+  rtems_test_assert( fd >= 0 );
+
+  rv = fsync( fd );
+  rtems_test_assert( rv == 0 );
+
+  device_ioctl( RTEMS_BLKIO_RESETDEVSTATS, NULL );
+
+  n = write( fd, file_buf, sizeof( file_buf ) );
+  rtems_test_assert( n == (ssize_t) sizeof( file_buf ) );
+
+  rv = fsync( fd );
+  rtems_test_assert( rv == 0 );
+
+  rv = close( fd );
+  rtems_test_assert( rv == 0 );
+
+  device_ioctl( RTEMS_BLKIO_GETDEVSTATS, &stats );
+
+  return stats.write_transfers;
+}
+
+/*
+ * Count the runs of contiguous blocks of a file.  Each run is read back with
+ * a single seek of the media.
+ */
+static int count_fragments( const char *file )
+{
+  rtems_libio_t          *iop;
+  rtems_rfs_file_handle  *handle;
+  rtems_rfs_block_pos     bpos;
+  rtems_rfs_buffer_block  block;
+  rtems_rfs_buffer_block  previous = 0;
+  int                     fragments = 0;
+  int                     fd;
+  int                     rc;
+  int                     rv;
+
+  fd = open( file, O_RDONLY );
+  rtems_test_assert( fd >= 0 );
+
+  iop = rtems_libio_iop( fd );
+  handle = iop->pathinfo.node_access_2;
+
+  rtems_rfs_block_set_bpos_zero( &bpos );
+
+  for ( bpos.bno = 0; bpos.bno < FILE_BLOCKS; ++bpos.bno ) {
+    rc = rtems_rfs_block_map_find(
+      rtems_rfs_file_fs( handle ),
+      rtems_rfs_file_map( handle ),
+      &bpos,
+      &block
+    );
+    rtems_test_assert( rc == 0 );
+
+    if ( bpos.bno == 0 || block != previous + 1 ) {
+      ++fragments;
+    }
+
+    previous = block;
+  }
+
+  rv = close( fd );
+  rtems_test_assert( rv == 0 );
+
+  return fragments;
+}
+
+/*
+ * Write a file with a single write.  With block reservation the blocks the
+ * write needs are taken from the reserved run with one bitmap update.
+ */
+static void write_sequential( void )
+{
+  int     block;
+  int     fd;
+  ssize_t n;
+  int     rv;
+
+  for ( block = 0; block < FILE_BLOCKS; ++block ) {
+    fill_block( &file_buf[ block * BLOCK_SIZE ], 'c', block );
+  }
+
+  fd = open( FILE_C, O_CREAT | O_WRONLY, S_IRWXU );
+  rtems_test_assert( fd >= 0 );
+
+  n = write( fd, file_buf, sizeof( file_buf ) );
+  rtems_test_assert( n == (ssize_t) sizeof( file_buf ) );
+
+  rv = close( fd );
+  rtems_test_assert( rv == 0 );
+}
+
+static void check_file( const char *file, char id )
+{
+  int     block;
+  int     fd;
+  ssize_t n;
+  int     rv;
+
+  fd = open( file, O_RDONLY );
+  rtems_test_assert( fd >= 0 );
+
+  for ( block = 0; block < FILE_BLOCKS; ++block ) {
+    uint8_t expected[ BLOCK_SIZE ];
+
+    fill_block( expected, id, block );
+    n = read( fd, block_buf, BLOCK_SIZE );
+    rtems_test_assert( n == BLOCK_SIZE );
+    rtems_test_assert( memcmp( block_buf, expected, BLOCK_SIZE ) == 0 );
+  }
+
+  n = read( fd, block_buf, BLOCK_SIZE );
+  rtems_test_assert( n == 0 );
+
+  rv = close( fd );
+  rtems_test_assert( rv == 0 );
+}
+
+static fsblkcnt_t free_blocks( void )
+{
+  struct statvfs sb;
+  int            rv;
+
+  rv = statvfs( MOUNT_DIR, &sb );
+  rtems_test_assert( rv == 0 );
+
+  return sb.f_bfree;
+}
+
+/*
+ * The reserved blocks are only held in memory so a file system which is not
+ * unmounted does not lose them.  Only the blocks used by the file are set in
+ * the bitmaps while the file is open.
+ */
+static void check_reservation_in_memory( void )
+{
+  fsblkcnt_t before;
+  fsblkcnt_t used;
+  int        fd;
+  ssize_t    n;
+  int        rv;
+
+  fd = open( FILE_A, O_WRONLY | O_APPEND );
+  rtems_test_assert( fd >= 0 );
+
+  before = free_blocks();
+
+  fill_block( block_buf, 'a', FILE_BLOCKS );
+  n = write( fd, block_buf, BLOCK_SIZE );
+  rtems_test_assert( n == BLOCK_SIZE );
+
+  rv = fsync( fd );
+  rtems_test_assert( rv == 0 );
+
+  used = before - free_blocks();
+  rtems_test_assert( used >= 1 && used <= 2 );
+
+  rv = close( fd );
+  rtems_test_assert( rv == 0 );
+
+  rtems_test_assert( before - free_blocks() == used );
+
+  rv = truncate( FILE_A, BLOCK_SIZE * FILE_BLOCKS );
+  rtems_test_assert( rv == 0 );
+}
+
+static void test_layout(
+  const char    *name,
+  bool           reserve_blocks,
+  const char    *options,
+  layout_result *result
+)
+{
+  int rv;
+
+  printf( "%s\n", name );
+
+  format_and_mount( reserve_blocks, options );
+
+  write_interleaved();
+  write_sequential();
+  remount();
+
+  result->interleaved_fragments = count_fragments( FILE_A );
+  result->sequential_fragments = count_fragments( FILE_C );
+
+  result->write_transfers = rewrite_file( FILE_A );
+
+  remount();
+  device_ioctl( RTEMS_BLKIO_PURGEDEV, NULL );
+
+  check_file( FILE_A, 'a' );
+  check_file( FILE_B, 'b' );
+  check_file( FILE_C, 'c' );
+
+  check_reservation_in_memory();
+  check_file( FILE_A, 'a' );
+
+  rv = unmount( MOUNT_DIR );
+  rtems_test_assert( rv == 0 );
+}
+
+/*
+ * Only the exact option names are accepted.
+ */
+static void test_invalid_options( void )
+{
+  static const char * const options[] = {
+    "reserved",
+    "reservex",
+    "reserve-blocks",
+    "reserve-blocks=0",
+    "reserve-blocks=8x"
+  };
+  size_t i;
+  int    rv;
+
+  for ( i = 0; i < RTEMS_ARRAY_SIZE( options ); ++i ) {
+    errno = 0;
+    rv = mount( DEV_NAME,
+                MOUNT_DIR,
+                RTEMS_FILESYSTEM_TYPE_RFS,
+                RTEMS_FILESYSTEM_READ_WRITE,
+                options[ i ] );
+    rtems_test_assert( rv == -1 );
+    rtems_test_assert( errno == EINVAL );
+  }
+}
+
+static void test( void )
+{
+  rtems_status_code sc;
+  layout_result     interleaved;
+  layout_result     reserved;
+  layout_result     mount_reserve;
+  layout_result     mount_reserve_blocks;
+  int               rv;
+
+  sc = rtems_disk_io_initialize();
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+
+  rv = mkdir( MOUNT_DIR, S_IRWXU | S_IRWXG | S_IRWXO );
+  rtems_test_assert( rv == 0 );
+
+  sc = rtems_sparse_disk_create_and_register(
+    DEV_NAME,
+    BLOCK_SIZE,
+    MEDIA_BLOCKS,
+    MEDIA_BLOCKS,
+    0
+  );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+
+  test_layout( "no reserve", false, NULL, &interleaved );
+  test_layout( "format reserve", true, NULL, &reserved );
+  test_layout( "mount reserve", false, "reserve", &mount_reserve );
+  test_layout(
+    "mount reserve-blocks",
+    false,
+    "reserve-blocks=64",
+    &mount_reserve_blocks
+  );
+
+  /*
+   * Without block reservation the blocks of the files which grow together
+   * alternate on the media.  With block reservation each file gets runs of
+   * the reservation size, apart from the indirect blocks of the map which may
+   * split a run.
+   */
+  rtems_test_assert( interleaved.interleaved_fragments >= FILE_BLOCKS / 2 );
+  rtems_test_assert(
+    reserved.interleaved_fragments
+      <= 2 * FILE_BLOCKS / RTEMS_RFS_FS_RESERVE_BLOCKS
+  );
+  rtems_test_assert(
+    mount_reserve.interleaved_fragments
+      <= 2 * FILE_BLOCKS / RTEMS_RFS_FS_RESERVE_BLOCKS
+  );
+  rtems_test_assert( mount_reserve_blocks.interleaved_fragments <= 4 );
+
+  /* A file written by a single write stays contiguous with reservation */
+  rtems_test_assert( reserved.sequential_fragments <= 4 );
+  rtems_test_assert( mount_reserve.sequential_fragments <= 4 );
+  rtems_test_assert( mount_reserve_blocks.sequential_fragments <= 4 );
+
+  /*
+   * The rewritten file's blocks are contiguous runs with block reservation so
+   * the swapout task can write them with far fewer transfers.
+   */
+  rtems_test_assert( reserved.write_transfers < interleaved.write_transfers );
+  rtems_test_assert(
+    mount_reserve.write_transfers < interleaved.write_transfers
+  );
+  rtems_test_assert(
+    mount_reserve_blocks.write_transfers < interleaved.write_transfers
+  );
+
+  /* A file of the size of the reservation is a single run */
+  rtems_test_assert(
+    mount_reserve_blocks.write_transfers <= reserved.write_transfers
+  );
+
+  test_invalid_options();
+
+  rv = unlink( DEV_NAME );
+  rtems_test_assert( rv == 0 );
+}
+
+static void Init( rtems_task_argument arg )
+{
+  TEST_BEGIN();
+
+  test();
+
+  TEST_END();
+  rtems_test_exit( 0 );
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_LIBBLOCK
+
+#define CONFIGURE_USE_IMFS_AS_BASE_FILESYSTEM
+
+#define CONFIGURE_FILESYSTEM_RFS
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 8
+
+#define CONFIGURE_UNLIMITED_OBJECTS
+#define CONFIGURE_UNIFIED_WORK_AREAS
+
+#define CONFIGURE_INIT_TASK_STACK_SIZE ( 32 * 1024 )
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_BDBUF_CACHE_MEMORY_SIZE ( 256 * 1024 )
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
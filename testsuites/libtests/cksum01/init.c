@@ -0,0 +1,391 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/types.h>
+#include <sys/mbuf.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+#include <netinet/in_systm.h>
+#include <netinet/ip.h>
+#include <netinet/udp.h>
+#include <netinet/udp_var.h>
+#include <netinet/tcp.h>
+#include <netinet/tcp_timer.h>
+#include <netinet/tcp_var.h>
+#include <arpa/inet.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems/rtems_bsdnet.h>
+
+const char rtems_test_name[] = "CKSUM 1";
+
+#define PORT 5000
+
+#define BUF_SIZE (64 * 1024)
+
+#define MAX_OFFSET 8
+
+#define MAX_MBUFS 8
+
+#define RANDOM_RUNS 2000
+
+#define SEGMENT_COUNT 100
+
+#define SEGMENT_MAX 100
+
+/* Kernel checksum routines */
+int in_cksum(struct mbuf *, int);
+u_short in_cksum_add(u_short, u_short, int);
+u_short in_cksum_copy(const void *, void *, int);
+u_short in_cksum_data(const void *, int);
+
+/* Kernel statistics */
+extern struct udpstat udpstat;
+extern struct tcpstat tcpstat;
+
+struct rtems_bsdnet_config rtems_bsdnet_config;
+
+static uint8_t src[BUF_SIZE + MAX_OFFSET];
+
+static uint8_t dst[BUF_SIZE + MAX_OFFSET];
+
+static struct mbuf mbufs[MAX_MBUFS];
+
+static uint32_t random_state = 1;
+
+static uint32_t next_random(void)
+{
+  random_state = random_state * 1103515245 + 12345;
+
+  return random_state >> 8;
+}
+
+static uint8_t pattern(size_t i)
+{
+  return (uint8_t) (i * 7 + (i >> 8));
+}
+
+/*
+ * Byte-wise reference implementation, returns the sum in host byte order.
+ */
+static u_short reference_sum(const uint8_t *p, size_t len)
+{
+  uint32_t sum = 0;
+  size_t i;
+
+  for (i = 0; i < len; ++i) {
+    sum += (i & 1) != 0 ? p[i] : (uint32_t) p[i] << 8;
+  }
+
+  while ((sum >> 16) != 0) {
+    sum = (sum & 0xffff) + (sum >> 16);
+  }
+
+  return (u_short) sum;
+}
+
+static struct mbuf *init_chain(uint8_t *p, size_t len, int count)
+{
+  size_t done = 0;
+  int i;
+
+  memset(mbufs, 0, sizeof(mbufs));
+
+  for (i = 0; i < count; ++i) {
+    size_t mlen = len - done;
+
+    if (i < count - 1 && mlen > 0) {
+      mlen = next_random() % (mlen + 1);
+    }
+
+    mbufs[i].m_data = (caddr_t) p + done;
+    mbufs[i].m_len = (int) mlen;
+    mbufs[i].m_next = i < count - 1 ? &mbufs[i + 1] : NULL;
+    done += mlen;
+  }
+
+  return &mbufs[0];
+}
+
+static void check_sums(size_t src_off, size_t dst_off, size_t len)
+{
+  u_short expected = reference_sum(&src[src_off], len);
+  u_short sum;
+  int count;
+
+  sum = in_cksum_data(&src[src_off], (int) len);
+  rtems_test_assert(ntohs(sum) == expected);
+
+  memset(dst, 0, sizeof(dst));
+  sum = in_cksum_copy(&src[src_off], &dst[dst_off], (int) len);
+  rtems_test_assert(ntohs(sum) == expected);
+  rtems_test_assert(memcmp(&src[src_off], &dst[dst_off], len) == 0);
+
+  count = (int) (next_random() % MAX_MBUFS) + 1;
+  sum = (u_short) in_cksum(init_chain(&src[src_off], len, count), (int) len);
+  rtems_test_assert(ntohs(sum) == (u_short) ~expected);
+}
+
+static void test_correctness(void)
+{
+  size_t i;
+  int run;
+
+  for (i = 0; i < sizeof(src); ++i) {
+    src[i] = (uint8_t) next_random();
+  }
+
+  /* The sum of zeros stays zero, otherwise the end-around carry is used */
+  memset(dst, 0, 64);
+  rtems_test_assert(in_cksum_data(dst, 64) == 0);
+  memset(dst, 0xff, 64);
+  rtems_test_assert(in_cksum_data(dst, 64) == 0xffff);
+
+  /* Parts at odd offsets are swapped */
+  rtems_test_assert(in_cksum_add(0x0102, 0x0304, 0) == 0x0406);
+  rtems_test_assert(in_cksum_add(0x0102, 0x0304, 1) == 0x0505);
+  rtems_test_assert(in_cksum_add(0xffff, 0x0001, 0) == 0x0001);
+
+  for (i = 0; i < 256; ++i) {
+    check_sums(i % MAX_OFFSET, (i / MAX_OFFSET) % MAX_OFFSET, i);
+  }
+
+  for (run = 0; run < RANDOM_RUNS; ++run) {
+    size_t len = next_random() % 2048;
+
+    if (run % 100 == 0) {
+      len = BUF_SIZE;
+    }
+
+    check_sums(
+      next_random() % MAX_OFFSET,
+      next_random() % MAX_OFFSET,
+      len
+    );
+  }
+}
+
+static void init_addr(struct sockaddr_in *addr, int port)
+{
+  memset(addr, 0, sizeof(*addr));
+  addr->sin_len = sizeof(*addr);
+  addr->sin_family = AF_INET;
+  addr->sin_port = htons(port);
+  addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+}
+
+static void connect_pair(int port, int *client, int *server)
+{
+  struct sockaddr_in addr;
+  socklen_t addr_len = sizeof(addr);
+  int listener;
+  int rv;
+
+  init_addr(&addr, port);
+
+  listener = socket(PF_INET, SOCK_STREAM, 0);
+  rtems_test_assert(listener >= 0);
+
+  rv = bind(listener, (struct sockaddr *) &addr, sizeof(addr));
+  rtems_test_assert(rv == 0);
+
+  rv = listen(listener, 1);
+  rtems_test_assert(rv == 0);
+
+  *client = socket(PF_INET, SOCK_STREAM, 0);
+  rtems_test_assert(*client >= 0);
+
+  rv = connect(*client, (struct sockaddr *) &addr, sizeof(addr));
+  rtems_test_assert(rv == 0);
+
+  *server = accept(listener, (struct sockaddr *) &addr, &addr_len);
+  rtems_test_assert(*server >= 0);
+
+  rv = close(listener);
+  rtems_test_assert(rv == 0);
+}
+
+/*
+ * The datagram data is summed while it is copied in by sosend().  Odd
+ * vector lengths put the parts at odd offsets of the datagram.
+ */
+static void test_udp(int port)
+{
+  static const size_t iov_lens[][3] = {
+    { 0, 0, 1 },
+    { 1, 1, 1 },
+    { 1, 333, 1000 },
+    { 7, 4096, 3 },
+    { 2001, 1, 1999 },
+    { 1, 8191, 4097 }
+  };
+  struct sockaddr_in addr;
+  int bufsize = 32 * 1024;
+  u_long badsum = udpstat.udps_badsum;
+  size_t i;
+  int sender;
+  int receiver;
+  int rv;
+
+  for (i = 0; i < sizeof(src); ++i) {
+    src[i] = pattern(i);
+  }
+
+  init_addr(&addr, port);
+
+  receiver = socket(PF_INET, SOCK_DGRAM, 0);
+  rtems_test_assert(receiver >= 0);
+
+  rv = setsockopt(receiver, SOL_SOCKET, SO_RCVBUF, &bufsize, sizeof(bufsize));
+  rtems_test_assert(rv == 0);
+
+  rv = bind(receiver, (struct sockaddr *) &addr, sizeof(addr));
+  rtems_test_assert(rv == 0);
+
+  sender = socket(PF_INET, SOCK_DGRAM, 0);
+  rtems_test_assert(sender >= 0);
+
+  rv = setsockopt(sender, SOL_SOCKET, SO_SNDBUF, &bufsize, sizeof(bufsize));
+  rtems_test_assert(rv == 0);
+
+  for (i = 0; i < RTEMS_ARRAY_SIZE(iov_lens); ++i) {
+    struct iovec iov[3];
+    struct msghdr msg;
+    size_t size = 0;
+    size_t j;
+    ssize_t n;
+
+    for (j = 0; j < RTEMS_ARRAY_SIZE(iov); ++j) {
+      iov[j].iov_base = &src[size];
+      iov[j].iov_len = iov_lens[i][j];
+      size += iov_lens[i][j];
+    }
+
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_name = &addr;
+    msg.msg_namelen = sizeof(addr);
+    msg.msg_iov = iov;
+    msg.msg_iovlen = RTEMS_ARRAY_SIZE(iov);
+
+    n = sendmsg(sender, &msg, 0);
+    rtems_test_assert(n == (ssize_t) size);
+
+    memset(dst, 0, sizeof(dst));
+    n = recv(receiver, dst, sizeof(dst), 0);
+    rtems_test_assert(n == (ssize_t) size);
+    rtems_test_assert(memcmp(dst, src, size) == 0);
+  }
+
+  rtems_test_assert(udpstat.udps_badsum == badsum);
+
+  rv = close(sender);
+  rtems_test_assert(rv == 0);
+
+  rv = close(receiver);
+  rtems_test_assert(rv == 0);
+}
+
+/*
+ * Small segments are copied into the header mbuf by tcp_output() and summed
+ * on the way.
+ */
+static void test_tcp(int port)
+{
+  u_long badsum = tcpstat.tcps_rcvbadsum;
+  size_t total = 0;
+  size_t done = 0;
+  int nodelay = 1;
+  int client;
+  int server;
+  int rv;
+  int i;
+
+  connect_pair(port, &client, &server);
+
+  rv = setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+  rtems_test_assert(rv == 0);
+
+  for (i = 0; i < SEGMENT_COUNT; ++i) {
+    size_t n = (next_random() % SEGMENT_MAX) + 1;
+    ssize_t w;
+
+    w = write(client, &src[total], n);
+    rtems_test_assert(w == (ssize_t) n);
+
+    total += n;
+  }
+
+  memset(dst, 0, sizeof(dst));
+
+  while (done < total) {
+    ssize_t r = read(server, &dst[done], total - done);
+
+    rtems_test_assert(r > 0);
+    done += (size_t) r;
+  }
+
+  rtems_test_assert(memcmp(dst, src, total) == 0);
+  rtems_test_assert(tcpstat.tcps_rcvbadsum == badsum);
+
+  rv = close(client);
+  rtems_test_assert(rv == 0);
+
+  rv = close(server);
+  rtems_test_assert(rv == 0);
+}
+
+static void test_sockets(void)
+{
+  int rv;
+
+  rv = rtems_bsdnet_initialize_network();
+  rtems_test_assert(rv == 0);
+
+  test_udp(PORT);
+  test_tcp(PORT + 1);
+}
+
+static void Init(rtems_task_argument arg)
+{
+  TEST_BEGIN();
+
+  test_correctness();
+  test_sockets();
+
+  TEST_END();
+
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+
+#define CONFIGURE_USE_IMFS_AS_BASE_FILESYSTEM
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 8
+
+#define CONFIGURE_MAXIMUM_TASKS 3
+
+#define CONFIGURE_MAXIMUM_SEMAPHORES 3
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
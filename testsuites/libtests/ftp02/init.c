@@ -0,0 +1,563 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems/dosfs.h>
+#include <rtems/ftpd.h>
+#include <rtems/libio.h>
+#include <rtems/ramdisk.h>
+#include <rtems/rtems-rfs-format.h>
+#include <rtems/rtems_bsdnet.h>
+
+const char rtems_test_name[] = "FTP 2";
+
+#define FTP_PORT 21
+
+#define SEGMENT_COUNT 4
+
+#define FTP_WORKER_TASK_COUNT SEGMENT_COUNT
+
+#define FTP_WORKER_TASK_EXTRA_STACK (FTP_WORKER_TASK_COUNT * FTPD_STACKSIZE)
+
+#define FTP_DATA_BUFFER_SIZE (32 * 1024)
+
+#define BLOCK_SIZE 512
+
+#define BLOCK_COUNT 2048
+
+#define FILE_SIZE (256 * 1024)
+
+#define SEGMENT_SIZE (FILE_SIZE / SEGMENT_COUNT)
+
+#define CHUNK_SIZE 4096
+
+struct rtems_bsdnet_config rtems_bsdnet_config;
+
+struct rtems_ftpd_configuration rtems_ftpd_configuration = {
+  .priority = 90,
+  .max_hook_filesize = 0,
+  .port = FTP_PORT,
+  .hooks = NULL,
+  .root = NULL,
+  .tasks_count = FTP_WORKER_TASK_COUNT,
+  .idle = 0,
+  .access = 0,
+  .data_buffer_size = FTP_DATA_BUFFER_SIZE
+};
+
+typedef struct {
+  int ctrl;
+  int data;
+  size_t begin;
+  size_t end;
+  size_t done;
+} session_context;
+
+static session_context sessions[SEGMENT_COUNT];
+
+static char file_data[FILE_SIZE];
+
+static char rx_data[FILE_SIZE];
+
+static int connect_to(in_port_t port)
+{
+  struct sockaddr_in addr;
+  int fd;
+  int rv;
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_len = sizeof(addr);
+  addr.sin_family = AF_INET;
+  addr.sin_port = port;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  fd = socket(PF_INET, SOCK_STREAM, 0);
+  rtems_test_assert(fd >= 0);
+
+  rv = connect(fd, (struct sockaddr *) &addr, sizeof(addr));
+  rtems_test_assert(rv == 0);
+
+  return fd;
+}
+
+/* The server sends only single line replies */
+static int receive_reply(int ctrl, char *line, size_t size)
+{
+  size_t len = 0;
+
+  while (true) {
+    ssize_t n;
+
+    rtems_test_assert(len < size - 1);
+    n = read(ctrl, &line[len], 1);
+    rtems_test_assert(n == 1);
+
+    ++len;
+    if (line[len - 1] == '\n') {
+      break;
+    }
+  }
+
+  line[len] = '\0';
+  rtems_test_assert(len >= 4 && line[3] == ' ');
+
+  return atoi(line);
+}
+
+static void expect_reply(int ctrl, int expected_code)
+{
+  char line[128];
+  int code;
+
+  code = receive_reply(ctrl, line, sizeof(line));
+  rtems_test_assert(code == expected_code);
+}
+
+static int command(int ctrl, const char *cmd, char *line, size_t size)
+{
+  size_t len = strlen(cmd);
+  ssize_t n;
+
+  n = write(ctrl, cmd, len);
+  rtems_test_assert(n == (ssize_t) len);
+
+  return receive_reply(ctrl, line, size);
+}
+
+static void simple_command(int ctrl, const char *cmd, int expected_code)
+{
+  char line[128];
+  int code;
+
+  code = command(ctrl, cmd, line, sizeof(line));
+  rtems_test_assert(code == expected_code);
+}
+
+static int open_session(void)
+{
+  int ctrl;
+
+  ctrl = connect_to(htons(FTP_PORT));
+  expect_reply(ctrl, 220);
+
+  simple_command(ctrl, "USER anonymous\r\n", 230);
+  simple_command(ctrl, "TYPE I\r\n", 200);
+
+  return ctrl;
+}
+
+static void close_session(int ctrl)
+{
+  int rv;
+
+  simple_command(ctrl, "QUIT\r\n", 221);
+
+  rv = close(ctrl);
+  rtems_test_assert(rv == 0);
+}
+
+static int open_passive_data_connection(int ctrl)
+{
+  char line[128];
+  unsigned int v[6];
+  unsigned char *p;
+  in_port_t port;
+  int code;
+  int rv;
+
+  code = command(ctrl, "PASV\r\n", line, sizeof(line));
+  rtems_test_assert(code == 227);
+
+  rv = sscanf(
+    strchr(line, '('),
+    "(%u,%u,%u,%u,%u,%u)",
+    &v[0],
+    &v[1],
+    &v[2],
+    &v[3],
+    &v[4],
+    &v[5]
+  );
+  rtems_test_assert(rv == 6);
+
+  p = (unsigned char *) &port;
+  p[0] = (unsigned char) v[4];
+  p[1] = (unsigned char) v[5];
+
+  return connect_to(port);
+}
+
+static void start_transfer(
+  int ctrl,
+  int *data,
+  const char *cmd,
+  const char *path,
+  size_t restart
+)
+{
+  char buf[128];
+
+  if (restart != 0) {
+    snprintf(buf, sizeof(buf), "REST %zu\r\n", restart);
+    simple_command(ctrl, buf, 350);
+  }
+
+  *data = open_passive_data_connection(ctrl);
+
+  snprintf(buf, sizeof(buf), "%s %s\r\n", cmd, path);
+  simple_command(ctrl, buf, 150);
+}
+
+static void create_file_data(void)
+{
+  size_t i;
+
+  /* Segments shifted by some bytes do not match */
+  for (i = 0; i < sizeof(file_data); ++i) {
+    file_data[i] = (char) (i + i / 251);
+  }
+}
+
+static void print_transfer(const char *fs, const char *transfer)
+{
+  printf("%s %s: %i KiB\n", fs, transfer, FILE_SIZE / 1024);
+}
+
+static void check_file(const char *path)
+{
+  size_t done;
+  ssize_t n;
+  int fd;
+  int rv;
+
+  memset(rx_data, 0, sizeof(rx_data));
+
+  fd = open(path, O_RDONLY);
+  rtems_test_assert(fd >= 0);
+
+  done = 0;
+  while ((n = read(fd, &rx_data[done], sizeof(rx_data) - done)) > 0) {
+    done += (size_t) n;
+  }
+
+  rtems_test_assert(n == 0);
+  rtems_test_assert(done == sizeof(rx_data));
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+
+  rtems_test_assert(memcmp(rx_data, file_data, sizeof(file_data)) == 0);
+}
+
+static void store_part(int ctrl, const char *path, size_t begin, size_t end)
+{
+  size_t done;
+  int data;
+  int rv;
+
+  start_transfer(ctrl, &data, "STOR", path, begin);
+
+  done = begin;
+  while (done < end) {
+    size_t len = end - done;
+    ssize_t n;
+
+    if (len > CHUNK_SIZE) {
+      len = CHUNK_SIZE;
+    }
+
+    n = write(data, &file_data[done], len);
+    rtems_test_assert(n == (ssize_t) len);
+
+    done += len;
+  }
+
+  rv = close(data);
+  rtems_test_assert(rv == 0);
+
+  expect_reply(ctrl, 226);
+}
+
+/*
+ * The second part is stored at the offset set by the REST command.  The PASV
+ * command in between must not clear this offset.
+ */
+static void test_store(const char *fs, const char *path)
+{
+  int ctrl;
+
+  ctrl = open_session();
+
+  store_part(ctrl, path, 0, FILE_SIZE / 2);
+  store_part(ctrl, path, FILE_SIZE / 2, FILE_SIZE);
+
+  close_session(ctrl);
+
+  check_file(path);
+  print_transfer(fs, "STOR");
+}
+
+static void test_retrieve(const char *fs, const char *path)
+{
+  size_t done;
+  ssize_t n;
+  int ctrl;
+  int data;
+  int rv;
+
+  memset(rx_data, 0, sizeof(rx_data));
+  ctrl = open_session();
+
+  start_transfer(ctrl, &data, "RETR", path, 0);
+
+  done = 0;
+  while ((n = read(data, &rx_data[done], sizeof(rx_data) - done)) > 0) {
+    done += (size_t) n;
+  }
+
+  rtems_test_assert(n == 0);
+  rtems_test_assert(done == sizeof(rx_data));
+
+  rv = close(data);
+  rtems_test_assert(rv == 0);
+
+  expect_reply(ctrl, 226);
+
+  rtems_test_assert(memcmp(rx_data, file_data, sizeof(file_data)) == 0);
+  print_transfer(fs, "RETR");
+
+  close_session(ctrl);
+}
+
+/*
+ * Each session retrieves one segment of the file starting at the offset set by
+ * the REST command.  The client closes the data connection at the end of the
+ * segment.
+ */
+static void test_segmented_retrieve(const char *fs, const char *path)
+{
+  size_t active;
+  size_t i;
+
+  memset(rx_data, 0, sizeof(rx_data));
+
+  for (i = 0; i < SEGMENT_COUNT; ++i) {
+    session_context *session = &sessions[i];
+
+    session->ctrl = open_session();
+    session->begin = i * SEGMENT_SIZE;
+    session->end = session->begin + SEGMENT_SIZE;
+    session->done = 0;
+  }
+
+  for (i = 0; i < SEGMENT_COUNT; ++i) {
+    session_context *session = &sessions[i];
+
+    start_transfer(
+      session->ctrl,
+      &session->data,
+      "RETR",
+      path,
+      session->begin
+    );
+  }
+
+  active = SEGMENT_COUNT;
+  while (active > 0) {
+    for (i = 0; i < SEGMENT_COUNT; ++i) {
+      session_context *session = &sessions[i];
+      size_t pos = session->begin + session->done;
+      size_t len = session->end - pos;
+      ssize_t n;
+
+      if (len == 0) {
+        continue;
+      }
+
+      if (len > CHUNK_SIZE) {
+        len = CHUNK_SIZE;
+      }
+
+      n = read(session->data, &rx_data[pos], len);
+      rtems_test_assert(n > 0);
+
+      session->done += (size_t) n;
+
+      if (session->begin + session->done == session->end) {
+        int rv;
+
+        rv = close(session->data);
+        rtems_test_assert(rv == 0);
+
+        --active;
+      }
+    }
+  }
+
+  rtems_test_assert(memcmp(rx_data, file_data, sizeof(file_data)) == 0);
+  print_transfer(fs, "RETR in segments");
+
+  for (i = 0; i < SEGMENT_COUNT; ++i) {
+    session_context *session = &sessions[i];
+    char line[128];
+    int code;
+
+    /*
+     * Depending on the data still in flight the server noticed the closed
+     * data connection or not.
+     */
+    code = receive_reply(session->ctrl, line, sizeof(line));
+    rtems_test_assert(code == 226 || code == 451);
+
+    close_session(session->ctrl);
+  }
+}
+
+static void test_file_system(const char *fs, const char *path)
+{
+  test_store(fs, path);
+  test_retrieve(fs, path);
+  test_segmented_retrieve(fs, path);
+}
+
+static void create_ramdisk(const char *disk)
+{
+  rtems_status_code sc;
+  dev_t dev;
+
+  sc = ramdisk_register(BLOCK_SIZE, BLOCK_COUNT, false, disk, &dev);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static void mount_rfs(const char *disk, const char *mount_point)
+{
+  static const rtems_rfs_format_config config = {
+    .block_size = BLOCK_SIZE
+  };
+  int rv;
+
+  create_ramdisk(disk);
+
+  rv = rtems_rfs_format(disk, &config);
+  rtems_test_assert(rv == 0);
+
+  rv = mount_and_make_target_path(
+    disk,
+    mount_point,
+    RTEMS_FILESYSTEM_TYPE_RFS,
+    RTEMS_FILESYSTEM_READ_WRITE,
+    NULL
+  );
+  rtems_test_assert(rv == 0);
+}
+
+static void mount_dosfs(const char *disk, const char *mount_point)
+{
+  static const msdos_format_request_param_t rqdata = {
+    .sectors_per_cluster = 8,
+    .quick_format = true
+  };
+  int rv;
+
+  create_ramdisk(disk);
+
+  rv = msdos_format(disk, &rqdata);
+  rtems_test_assert(rv == 0);
+
+  rv = mount_and_make_target_path(
+    disk,
+    mount_point,
+    RTEMS_FILESYSTEM_TYPE_DOSFS,
+    RTEMS_FILESYSTEM_READ_WRITE,
+    NULL
+  );
+  rtems_test_assert(rv == 0);
+}
+
+static void test(void)
+{
+  rtems_status_code sc;
+  int rv;
+
+  rv = rtems_bsdnet_initialize_network();
+  rtems_test_assert(rv == 0);
+
+  rv = rtems_initialize_ftpd();
+  rtems_test_assert(rv == 0);
+
+  sc = rtems_disk_io_initialize();
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  mount_rfs("/dev/rda", "/rfs");
+  mount_dosfs("/dev/rdb", "/dosfs");
+
+  create_file_data();
+
+  test_file_system("RFS", "/rfs/file");
+  test_file_system("DOSFS", "/dosfs/file");
+}
+
+static void Init(rtems_task_argument arg)
+{
+  TEST_BEGIN();
+
+  test();
+
+  TEST_END();
+
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_LIBBLOCK
+
+#define CONFIGURE_USE_IMFS_AS_BASE_FILESYSTEM
+#define CONFIGURE_FILESYSTEM_RFS
+#define CONFIGURE_FILESYSTEM_DOSFS
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 32
+
+#define CONFIGURE_MAXIMUM_DRIVERS 4
+
+#define CONFIGURE_BDBUF_BUFFER_MAX_SIZE BLOCK_SIZE
+#define CONFIGURE_BDBUF_CACHE_MEMORY_SIZE (64 * 1024)
+
+#define CONFIGURE_UNLIMITED_OBJECTS
+
+#define CONFIGURE_UNIFIED_WORK_AREAS
+
+#define CONFIGURE_EXTRA_TASK_STACKS FTP_WORKER_TASK_EXTRA_STACK
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+/* The client must not starve the FTP server tasks */
+#define CONFIGURE_INIT_TASK_PRIORITY 110
+
+#define CONFIGURE_INIT_TASK_STACK_SIZE (16 * 1024)
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -0,0 +1,408 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#define FD_SETSIZE 1024
+
+#include "tmacros.h"
+
+#include <sys/types.h>
+#include <sys/event.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <rtems/rtems_bsdnet.h>
+
+const char rtems_test_name[] = "KQUEUE 1";
+
+#define PORT 5000
+
+#define IDLE_SOCKETS 500
+
+#define ACTIVE_SOCKETS 8
+
+#define SOCKET_COUNT (IDLE_SOCKETS + ACTIVE_SOCKETS)
+
+#define ITERATIONS 100
+
+struct rtems_bsdnet_config rtems_bsdnet_config;
+
+static const struct timespec no_wait;
+
+static int sockets[SOCKET_COUNT];
+
+static struct kevent events[SOCKET_COUNT];
+
+static const struct kevent *find_event(
+  const struct kevent *ev,
+  int n,
+  int fd,
+  short filter
+)
+{
+  int i;
+
+  for (i = 0; i < n; ++i) {
+    if ((int) ev[i].ident == fd && ev[i].filter == filter) {
+      return &ev[i];
+    }
+  }
+
+  return NULL;
+}
+
+static void test_pipe(void)
+{
+  struct kevent ch[2];
+  struct kevent ev[4];
+  const struct kevent *e;
+  char buf[3];
+  int fds[2];
+  int kq;
+  int rv;
+  ssize_t n;
+
+  rv = pipe(fds);
+  rtems_test_assert(rv == 0);
+
+  kq = kqueue();
+  rtems_test_assert(kq >= 0);
+
+  EV_SET(&ch[0], fds[0], EVFILT_READ, EV_ADD, 0, 0, NULL);
+  EV_SET(&ch[1], fds[1], EVFILT_WRITE, EV_ADD, 0, 0, NULL);
+  rv = kevent(kq, ch, 2, NULL, 0, NULL);
+  rtems_test_assert(rv == 0);
+
+  /* Only the write end is ready */
+  rv = kevent(kq, NULL, 0, ev, 4, &no_wait);
+  rtems_test_assert(rv == 1);
+  rtems_test_assert((int) ev[0].ident == fds[1]);
+  rtems_test_assert(ev[0].filter == EVFILT_WRITE);
+  rtems_test_assert(ev[0].data > 0);
+
+  n = write(fds[1], "abc", 3);
+  rtems_test_assert(n == 3);
+
+  rv = kevent(kq, NULL, 0, ev, 4, &no_wait);
+  rtems_test_assert(rv == 2);
+  e = find_event(ev, rv, fds[0], EVFILT_READ);
+  rtems_test_assert(e != NULL);
+  rtems_test_assert(e->data == 3);
+  rtems_test_assert((e->flags & EV_EOF) == 0);
+
+  /* A disabled event is not reported */
+  EV_SET(&ch[0], fds[1], EVFILT_WRITE, EV_DISABLE, 0, 0, NULL);
+  rv = kevent(kq, ch, 1, ev, 4, &no_wait);
+  rtems_test_assert(rv == 1);
+  rtems_test_assert((int) ev[0].ident == fds[0]);
+
+  n = read(fds[0], buf, sizeof(buf));
+  rtems_test_assert(n == 3);
+
+  rv = kevent(kq, NULL, 0, ev, 4, &no_wait);
+  rtems_test_assert(rv == 0);
+
+  EV_SET(&ch[0], fds[1], EVFILT_WRITE, EV_ENABLE, 0, 0, NULL);
+  rv = kevent(kq, ch, 1, ev, 4, &no_wait);
+  rtems_test_assert(rv == 1);
+  rtems_test_assert((int) ev[0].ident == fds[1]);
+
+  /* Registration errors */
+  EV_SET(&ch[0], fds[0], EVFILT_TIMER, EV_ADD, 0, 0, NULL);
+  EV_SET(&ch[1], fds[0], EVFILT_WRITE, EV_DELETE, 0, 0, NULL);
+  rv = kevent(kq, ch, 2, ev, 4, NULL);
+  rtems_test_assert(rv == 2);
+  rtems_test_assert(ev[0].flags == EV_ERROR);
+  rtems_test_assert(ev[0].data == EINVAL);
+  rtems_test_assert(ev[1].flags == EV_ERROR);
+  rtems_test_assert(ev[1].data == ENOENT);
+
+  /* The close() removes the write event, the reader sees the end of file */
+  rv = close(fds[1]);
+  rtems_test_assert(rv == 0);
+
+  rv = kevent(kq, NULL, 0, ev, 4, NULL);
+  rtems_test_assert(rv == 1);
+  rtems_test_assert((int) ev[0].ident == fds[0]);
+  rtems_test_assert(ev[0].filter == EVFILT_READ);
+  rtems_test_assert((ev[0].flags & EV_EOF) != 0);
+
+  EV_SET(&ch[0], fds[0], EVFILT_READ, EV_DELETE, 0, 0, NULL);
+  rv = kevent(kq, ch, 1, NULL, 0, NULL);
+  rtems_test_assert(rv == 0);
+
+  rv = kevent(kq, NULL, 0, ev, 4, &no_wait);
+  rtems_test_assert(rv == 0);
+
+  rv = close(fds[0]);
+  rtems_test_assert(rv == 0);
+
+  rv = close(kq);
+  rtems_test_assert(rv == 0);
+
+  errno = 0;
+  rv = kevent(kq, NULL, 0, ev, 4, &no_wait);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == EBADF);
+}
+
+static void init_addr(struct sockaddr_in *addr, int port)
+{
+  memset(addr, 0, sizeof(*addr));
+  addr->sin_len = sizeof(*addr);
+  addr->sin_family = AF_INET;
+  addr->sin_port = htons(port);
+  addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+}
+
+static int create_sockets(void)
+{
+  struct sockaddr_in addr;
+  int sender;
+  int rv;
+  int i;
+
+  for (i = 0; i < SOCKET_COUNT; ++i) {
+    sockets[i] = socket(PF_INET, SOCK_DGRAM, 0);
+    rtems_test_assert(sockets[i] >= 0);
+  }
+
+  /* The active sockets are the last ones, so select() has to scan them all */
+  for (i = IDLE_SOCKETS; i < SOCKET_COUNT; ++i) {
+    init_addr(&addr, PORT + i);
+    rv = bind(sockets[i], (struct sockaddr *) &addr, sizeof(addr));
+    rtems_test_assert(rv == 0);
+  }
+
+  sender = socket(PF_INET, SOCK_DGRAM, 0);
+  rtems_test_assert(sender >= 0);
+
+  return sender;
+}
+
+static void send_datagrams(int sender)
+{
+  int i;
+
+  for (i = IDLE_SOCKETS; i < SOCKET_COUNT; ++i) {
+    struct sockaddr_in addr;
+    ssize_t n;
+
+    init_addr(&addr, PORT + i);
+    n = sendto(sender, "x", 1, 0, (struct sockaddr *) &addr, sizeof(addr));
+    rtems_test_assert(n == 1);
+  }
+}
+
+static void receive_datagram(int fd)
+{
+  char buf[1];
+  ssize_t n;
+
+  n = recv(fd, buf, sizeof(buf), 0);
+  rtems_test_assert(n == 1);
+}
+
+static uint64_t wait_with_select(int sender)
+{
+  static fd_set fds;
+  uint64_t start;
+  uint64_t ns = 0;
+  int nfds = sockets[SOCKET_COUNT - 1] + 1;
+  int iter;
+
+  for (iter = 0; iter < ITERATIONS; ++iter) {
+    int done = 0;
+
+    send_datagrams(sender);
+    start = rtems_clock_get_uptime_nanoseconds();
+
+    while (done < ACTIVE_SOCKETS) {
+      int rv;
+      int i;
+
+      FD_ZERO(&fds);
+
+      for (i = 0; i < SOCKET_COUNT; ++i) {
+        FD_SET(sockets[i], &fds);
+      }
+
+      rv = select(nfds, &fds, NULL, NULL, NULL);
+      rtems_test_assert(rv > 0);
+
+      for (i = 0; i < SOCKET_COUNT; ++i) {
+        if (FD_ISSET(sockets[i], &fds)) {
+          rtems_test_assert(i >= IDLE_SOCKETS);
+          receive_datagram(sockets[i]);
+          ++done;
+        }
+      }
+    }
+
+    ns += rtems_clock_get_uptime_nanoseconds() - start;
+  }
+
+  return ns;
+}
+
+static uint64_t wait_with_kevent(int sender)
+{
+  static bool received[SOCKET_COUNT];
+  uint64_t start;
+  uint64_t ns = 0;
+  int kq;
+  int rv;
+  int iter;
+  int i;
+
+  kq = kqueue();
+  rtems_test_assert(kq >= 0);
+
+  for (i = 0; i < SOCKET_COUNT; ++i) {
+    EV_SET(
+      &events[i],
+      sockets[i],
+      EVFILT_READ,
+      EV_ADD,
+      0,
+      0,
+      (void *) (intptr_t) i
+    );
+  }
+
+  rv = kevent(kq, events, SOCKET_COUNT, NULL, 0, NULL);
+  rtems_test_assert(rv == 0);
+
+  for (iter = 0; iter < ITERATIONS; ++iter) {
+    int done = 0;
+
+    memset(received, 0, sizeof(received));
+    send_datagrams(sender);
+    start = rtems_clock_get_uptime_nanoseconds();
+
+    while (done < ACTIVE_SOCKETS) {
+      rv = kevent(kq, NULL, 0, events, SOCKET_COUNT, NULL);
+      rtems_test_assert(rv > 0);
+
+      for (i = 0; i < rv; ++i) {
+        int j = (int) (intptr_t) events[i].udata;
+
+        /* Only the active sockets are reported, each one once */
+        rtems_test_assert(j >= IDLE_SOCKETS && j < SOCKET_COUNT);
+        rtems_test_assert((int) events[i].ident == sockets[j]);
+        rtems_test_assert(events[i].filter == EVFILT_READ);
+        rtems_test_assert(events[i].data > 0);
+        rtems_test_assert(!received[j]);
+        received[j] = true;
+        receive_datagram(sockets[j]);
+        ++done;
+      }
+    }
+
+    ns += rtems_clock_get_uptime_nanoseconds() - start;
+
+    rtems_test_assert(done == ACTIVE_SOCKETS);
+
+    /* No socket is ready after all datagrams were received */
+    rv = kevent(kq, NULL, 0, events, SOCKET_COUNT, &no_wait);
+    rtems_test_assert(rv == 0);
+  }
+
+  rv = close(kq);
+  rtems_test_assert(rv == 0);
+
+  return ns;
+}
+
+static void test_sockets(void)
+{
+  uint64_t select_ns;
+  uint64_t kevent_ns;
+  int sender;
+  int rv;
+  int i;
+
+  rv = rtems_bsdnet_initialize_network();
+  rtems_test_assert(rv == 0);
+
+  sender = create_sockets();
+
+  select_ns = wait_with_select(sender);
+  printf(
+    "select(): %i of %i sockets ready\n",
+    ACTIVE_SOCKETS,
+    SOCKET_COUNT
+  );
+
+  kevent_ns = wait_with_kevent(sender);
+  printf(
+    "kevent(): %i of %i sockets ready\n",
+    ACTIVE_SOCKETS,
+    SOCKET_COUNT
+  );
+
+  /* The kevent() does not scan the idle sockets */
+  rtems_test_assert(kevent_ns < select_ns);
+
+  for (i = 0; i < SOCKET_COUNT; ++i) {
+    rv = close(sockets[i]);
+    rtems_test_assert(rv == 0);
+  }
+
+  rv = close(sender);
+  rtems_test_assert(rv == 0);
+}
+
+static void Init(rtems_task_argument arg)
+{
+  TEST_BEGIN();
+
+  test_pipe();
+  test_sockets();
+
+  TEST_END();
+
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+
+#define CONFIGURE_USE_IMFS_AS_BASE_FILESYSTEM
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS (3 + SOCKET_COUNT + 2)
+
+#define CONFIGURE_MAXIMUM_TASKS 3
+
+#define CONFIGURE_MAXIMUM_SEMAPHORES 3
+
+#define CONFIGURE_PIPES_ENABLED
+
+#define CONFIGURE_MAXIMUM_PIPES 1
+
+#define CONFIGURE_UNIFIED_WORK_AREAS
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
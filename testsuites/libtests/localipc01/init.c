@@ -0,0 +1,334 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems/rtems_bsdnet.h>
+
+const char rtems_test_name[] = "LOCALIPC 1";
+
+#define TCP_PORT 7000
+
+#define ROUND_TRIPS 1000
+
+#define CHUNK_SIZE 1024
+
+#define CHUNKS 1024
+
+struct rtems_bsdnet_config rtems_bsdnet_config;
+
+static void close_pair(int sd[2])
+{
+  int rv;
+
+  rv = close(sd[0]);
+  rtems_test_assert(rv == 0);
+
+  rv = close(sd[1]);
+  rtems_test_assert(rv == 0);
+}
+
+static void local_pair(int type, int sd[2])
+{
+  int rv;
+
+  rv = socketpair(PF_LOCAL, type, 0, sd);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(sd[0] >= 0);
+  rtems_test_assert(sd[1] >= 0);
+}
+
+/*
+ * Returns a TCP connection over the loopback interface
+ */
+static void tcp_pair(int sd[2])
+{
+  struct sockaddr_in addr;
+  socklen_t addr_len = sizeof(addr);
+  int nodelay = 1;
+  int listener;
+  int rv;
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_len = sizeof(addr);
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(TCP_PORT);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  listener = socket(PF_INET, SOCK_STREAM, 0);
+  rtems_test_assert(listener >= 0);
+
+  rv = bind(listener, (struct sockaddr *) &addr, sizeof(addr));
+  rtems_test_assert(rv == 0);
+
+  rv = listen(listener, 1);
+  rtems_test_assert(rv == 0);
+
+  sd[0] = socket(PF_INET, SOCK_STREAM, 0);
+  rtems_test_assert(sd[0] >= 0);
+
+  rv = setsockopt(sd[0], IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+  rtems_test_assert(rv == 0);
+
+  rv = connect(sd[0], (struct sockaddr *) &addr, sizeof(addr));
+  rtems_test_assert(rv == 0);
+
+  sd[1] = accept(listener, (struct sockaddr *) &addr, &addr_len);
+  rtems_test_assert(sd[1] >= 0);
+
+  rv = setsockopt(sd[1], IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+  rtems_test_assert(rv == 0);
+
+  rv = close(listener);
+  rtems_test_assert(rv == 0);
+}
+
+static void transfer(int from, int to, char c)
+{
+  ssize_t n;
+
+  n = write(from, &c, sizeof(c));
+  rtems_test_assert(n == (ssize_t) sizeof(c));
+
+  c = 0;
+  n = read(to, &c, sizeof(c));
+  rtems_test_assert(n == (ssize_t) sizeof(c));
+}
+
+static void test_stream(void)
+{
+  char buf[4];
+  ssize_t n;
+  int sd[2];
+  int rv;
+
+  local_pair(SOCK_STREAM, sd);
+
+  n = write(sd[0], "abc", 3);
+  rtems_test_assert(n == 3);
+
+  n = write(sd[1], "xy", 2);
+  rtems_test_assert(n == 2);
+
+  n = read(sd[1], buf, sizeof(buf));
+  rtems_test_assert(n == 3);
+  rtems_test_assert(memcmp(buf, "abc", 3) == 0);
+
+  n = read(sd[0], buf, sizeof(buf));
+  rtems_test_assert(n == 2);
+  rtems_test_assert(memcmp(buf, "xy", 2) == 0);
+
+  /* The data written before the close is still delivered */
+  n = write(sd[0], "z", 1);
+  rtems_test_assert(n == 1);
+
+  rv = close(sd[0]);
+  rtems_test_assert(rv == 0);
+
+  n = read(sd[1], buf, sizeof(buf));
+  rtems_test_assert(n == 1);
+  rtems_test_assert(buf[0] == 'z');
+
+  n = read(sd[1], buf, sizeof(buf));
+  rtems_test_assert(n == 0);
+
+  errno = 0;
+  n = write(sd[1], "z", 1);
+  rtems_test_assert(n == -1);
+  rtems_test_assert(errno == EPIPE);
+
+  rv = close(sd[1]);
+  rtems_test_assert(rv == 0);
+}
+
+static void test_dgram(void)
+{
+  char buf[8];
+  ssize_t n;
+  int sd[2];
+
+  local_pair(SOCK_DGRAM, sd);
+
+  n = send(sd[0], "abc", 3, 0);
+  rtems_test_assert(n == 3);
+
+  n = send(sd[0], "de", 2, 0);
+  rtems_test_assert(n == 2);
+
+  n = send(sd[1], "f", 1, 0);
+  rtems_test_assert(n == 1);
+
+  n = recv(sd[1], buf, sizeof(buf), 0);
+  rtems_test_assert(n == 3);
+  rtems_test_assert(memcmp(buf, "abc", 3) == 0);
+
+  n = recv(sd[1], buf, sizeof(buf), 0);
+  rtems_test_assert(n == 2);
+  rtems_test_assert(memcmp(buf, "de", 2) == 0);
+
+  errno = 0;
+  n = recv(sd[1], buf, sizeof(buf), MSG_DONTWAIT);
+  rtems_test_assert(n == -1);
+  rtems_test_assert(errno == EWOULDBLOCK);
+
+  n = recv(sd[0], buf, sizeof(buf), 0);
+  rtems_test_assert(n == 1);
+  rtems_test_assert(buf[0] == 'f');
+
+  close_pair(sd);
+}
+
+static void test_errors(void)
+{
+  struct sockaddr_un addr;
+  int sd[2];
+  int rv;
+
+  local_pair(SOCK_STREAM, sd);
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_len = sizeof(addr);
+  addr.sun_family = AF_LOCAL;
+  strcpy(addr.sun_path, "/sock");
+
+  errno = 0;
+  rv = bind(sd[0], (struct sockaddr *) &addr, sizeof(addr));
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == EOPNOTSUPP);
+
+  close_pair(sd);
+
+  errno = 0;
+  rv = socketpair(PF_INET, SOCK_STREAM, 0, sd);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == EOPNOTSUPP);
+  rtems_test_assert(sd[0] == -1);
+  rtems_test_assert(sd[1] == -1);
+
+  errno = 0;
+  rv = socketpair(PF_LOCAL, SOCK_STREAM, 0, NULL);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == EFAULT);
+}
+
+static void round_trips(int sd[2])
+{
+  int i;
+
+  for (i = 0; i < ROUND_TRIPS; ++i) {
+    transfer(sd[0], sd[1], 'p');
+    transfer(sd[1], sd[0], 'q');
+  }
+}
+
+/*
+ * Transfer chunks of data, the reads may return partial chunks
+ */
+static void bulk_transfer(int sd[2])
+{
+  static char out[CHUNK_SIZE];
+  static char in[CHUNK_SIZE];
+  int i;
+
+  for (i = 0; i < CHUNKS; ++i) {
+    size_t done;
+    ssize_t n;
+
+    memset(out, 'a' + i % 26, sizeof(out));
+
+    n = write(sd[0], out, sizeof(out));
+    rtems_test_assert(n == (ssize_t) sizeof(out));
+
+    for (done = 0; done < sizeof(in); done += (size_t) n) {
+      n = read(sd[1], &in[done], sizeof(in) - done);
+      rtems_test_assert(n > 0);
+    }
+
+    rtems_test_assert(memcmp(in, out, sizeof(in)) == 0);
+  }
+}
+
+static void test_transfers(void)
+{
+  int sd[2];
+
+  local_pair(SOCK_STREAM, sd);
+  round_trips(sd);
+  bulk_transfer(sd);
+  close_pair(sd);
+
+  printf(
+    "socketpair: %i round-trips, %i bytes\n",
+    ROUND_TRIPS,
+    CHUNKS * CHUNK_SIZE
+  );
+
+  tcp_pair(sd);
+  round_trips(sd);
+  bulk_transfer(sd);
+  close_pair(sd);
+
+  printf(
+    "loopback:   %i round-trips, %i bytes\n",
+    ROUND_TRIPS,
+    CHUNKS * CHUNK_SIZE
+  );
+}
+
+static void Init(rtems_task_argument arg)
+{
+  int rv;
+
+  TEST_BEGIN();
+
+  rv = rtems_bsdnet_initialize_network();
+  rtems_test_assert(rv == 0);
+
+  test_stream();
+  test_dgram();
+  test_errors();
+  test_transfers();
+
+  TEST_END();
+
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+
+#define CONFIGURE_USE_IMFS_AS_BASE_FILESYSTEM
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 8
+
+#define CONFIGURE_MAXIMUM_TASKS 3
+
+#define CONFIGURE_MAXIMUM_SEMAPHORES 3
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
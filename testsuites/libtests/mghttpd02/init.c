@@ -0,0 +1,441 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems/libcsupport.h>
+#include <rtems/rtems_bsdnet.h>
+#include <mghttpd/mongoose.h>
+
+const char rtems_test_name[] = "MGHTTPD 2";
+
+#define HTTP_PORT "8080"
+
+#define FILE_PATH "/www/index.html"
+
+#define FILE_SIZE 1024
+
+#define CONNECTION_COUNT 8
+
+#define ROUND_COUNT 50
+
+/* Requests sent at once on each connection in each round */
+#define PIPELINE_DEPTH 2
+
+#define REQUEST_COUNT (CONNECTION_COUNT * ROUND_COUNT * PIPELINE_DEPTH)
+
+#define RX_SIZE (PIPELINE_DEPTH * (FILE_SIZE + 512))
+
+/* Value of the thread_stack_size option */
+#define THREAD_STACK_SIZE 16384
+
+struct rtems_bsdnet_config rtems_bsdnet_config;
+
+typedef struct {
+  int fd;
+  size_t rx_len;
+  char rx_buf[RX_SIZE];
+} connection_context;
+
+static connection_context connections[CONNECTION_COUNT];
+
+static char file_data[FILE_SIZE];
+
+static const char request[] =
+  "GET /index.html HTTP/1.1\r\n"
+  "Host: 127.0.0.1\r\n"
+  "\r\n";
+
+static void write_file(char first)
+{
+  ssize_t n;
+  size_t i;
+  int fd;
+  int rv;
+
+  for (i = 0; i < sizeof(file_data); ++i) {
+    file_data[i] = (char) (first + i % 26);
+  }
+
+  fd = open(FILE_PATH, O_CREAT | O_WRONLY, S_IRWXU | S_IRWXG | S_IRWXO);
+  rtems_test_assert(fd >= 0);
+
+  n = write(fd, file_data, sizeof(file_data));
+  rtems_test_assert(n == (ssize_t) sizeof(file_data));
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+}
+
+static void open_connection(connection_context *conn)
+{
+  struct sockaddr_in addr;
+  int rv;
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_len = sizeof(addr);
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(atoi(HTTP_PORT));
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  conn->fd = socket(PF_INET, SOCK_STREAM, 0);
+  rtems_test_assert(conn->fd >= 0);
+
+  rv = connect(conn->fd, (struct sockaddr *) &addr, sizeof(addr));
+  rtems_test_assert(rv == 0);
+
+  conn->rx_len = 0;
+}
+
+static void close_connection(connection_context *conn)
+{
+  int rv;
+
+  rtems_test_assert(conn->rx_len == 0);
+
+  rv = close(conn->fd);
+  rtems_test_assert(rv == 0);
+}
+
+static void send_requests(connection_context *conn)
+{
+  char buf[PIPELINE_DEPTH * (sizeof(request) - 1)];
+  ssize_t n;
+  int i;
+
+  for (i = 0; i < PIPELINE_DEPTH; ++i) {
+    memcpy(&buf[i * (sizeof(request) - 1)], request, sizeof(request) - 1);
+  }
+
+  n = write(conn->fd, buf, sizeof(buf));
+  rtems_test_assert(n == (ssize_t) sizeof(buf));
+}
+
+static char *find_header_end(connection_context *conn)
+{
+  size_t i;
+
+  for (i = 3; i < conn->rx_len; ++i) {
+    if (memcmp(&conn->rx_buf[i - 3], "\r\n\r\n", 4) == 0) {
+      return &conn->rx_buf[i + 1];
+    }
+  }
+
+  return NULL;
+}
+
+static void receive_response(connection_context *conn)
+{
+  char *body = NULL;
+  const char *cl;
+  size_t header_len;
+  size_t len;
+
+  while (true) {
+    ssize_t n;
+
+    if (body == NULL) {
+      body = find_header_end(conn);
+    }
+
+    if (body != NULL) {
+      header_len = (size_t) (body - &conn->rx_buf[0]);
+
+      if (conn->rx_len >= header_len + FILE_SIZE) {
+        break;
+      }
+    }
+
+    rtems_test_assert(conn->rx_len < sizeof(conn->rx_buf));
+    n = read(
+      conn->fd,
+      &conn->rx_buf[conn->rx_len],
+      sizeof(conn->rx_buf) - conn->rx_len
+    );
+    rtems_test_assert(n > 0);
+
+    conn->rx_len += (size_t) n;
+  }
+
+  *(body - 1) = '\0';
+  rtems_test_assert(strncmp(conn->rx_buf, "HTTP/1.1 200 OK\r\n", 17) == 0);
+  rtems_test_assert(strstr(conn->rx_buf, "Connection: keep-alive\r\n") != NULL);
+
+  cl = strstr(conn->rx_buf, "Content-Length: ");
+  rtems_test_assert(cl != NULL);
+  rtems_test_assert(atoi(cl + 16) == FILE_SIZE);
+
+  rtems_test_assert(memcmp(body, file_data, FILE_SIZE) == 0);
+
+  len = header_len + FILE_SIZE;
+  memmove(&conn->rx_buf[0], &conn->rx_buf[len], conn->rx_len - len);
+  conn->rx_len -= len;
+}
+
+static void run_rounds(int round_count)
+{
+  int round;
+  int i;
+
+  for (round = 0; round < round_count; ++round) {
+    for (i = 0; i < CONNECTION_COUNT; ++i) {
+      int j;
+
+      send_requests(&connections[i]);
+
+      for (j = 0; j < PIPELINE_DEPTH; ++j) {
+        receive_response(&connections[i]);
+      }
+    }
+  }
+}
+
+typedef struct {
+  size_t start_heap;
+  size_t idle_connection_heap;
+  int idle_connection_count;
+} load_result;
+
+/* The last worker parks its connection after the response is sent */
+static int wait_for_idle_connections(struct mg_context *mg, int expected)
+{
+  int count;
+  int i;
+
+  for (i = 0; i < 100; ++i) {
+    rtems_status_code sc;
+
+    count = mg_get_idle_connection_count(mg);
+    if (count == expected) {
+      break;
+    }
+
+    sc = rtems_task_wake_after(1);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+
+  return count;
+}
+
+/*
+ * The clients use all connections in turn, so each connection is idle most of
+ * the time.  With less worker threads than connections this works only if
+ * idle connections are parked in the master thread.  Returns the heap used
+ * by the server after the start, the heap used by each idle connection
+ * including the client side and the count of parked connections.
+ */
+static void test_load(
+  const char *name,
+  const char **options,
+  int expected_idle_connections,
+  load_result *result
+)
+{
+  const struct mg_callbacks callbacks = {
+    NULL
+  };
+  struct mg_context *mg;
+  size_t free_space;
+  int i;
+
+  free_space = malloc_free_space();
+
+  mg = mg_start(&callbacks, NULL, options);
+  rtems_test_assert(mg != NULL);
+
+  result->start_heap = free_space - malloc_free_space();
+  free_space = malloc_free_space();
+
+  for (i = 0; i < CONNECTION_COUNT; ++i) {
+    open_connection(&connections[i]);
+  }
+
+  run_rounds(ROUND_COUNT);
+
+  result->idle_connection_count =
+    wait_for_idle_connections(mg, expected_idle_connections);
+  result->idle_connection_heap =
+    (free_space - malloc_free_space()) / CONNECTION_COUNT;
+
+  for (i = 0; i < CONNECTION_COUNT; ++i) {
+    close_connection(&connections[i]);
+  }
+
+  mg_stop(mg);
+
+  printf("%s: %i requests\n", name, REQUEST_COUNT);
+}
+
+/*
+ * A file changed after it was cached must be served with the new content,
+ * even if the change keeps the size and happens within the second in which
+ * the file was cached.
+ */
+static void test_file_cache(const char **options)
+{
+  const struct mg_callbacks callbacks = {
+    NULL
+  };
+  struct mg_context *mg;
+  rtems_status_code sc;
+  int i;
+
+  /* Files changed in the current second are not cached */
+  sc = rtems_task_wake_after(2 * rtems_clock_get_ticks_per_second());
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  mg = mg_start(&callbacks, NULL, options);
+  rtems_test_assert(mg != NULL);
+
+  for (i = 0; i < CONNECTION_COUNT; ++i) {
+    open_connection(&connections[i]);
+  }
+
+  run_rounds(1);
+  write_file('A');
+  run_rounds(1);
+  write_file('a');
+  run_rounds(1);
+
+  for (i = 0; i < CONNECTION_COUNT; ++i) {
+    close_connection(&connections[i]);
+  }
+
+  mg_stop(mg);
+
+  printf("file cache: changed file served\n");
+}
+
+static void test(void)
+{
+  static const char *thread_per_connection_options[] = {
+    "listening_ports", HTTP_PORT,
+    "document_root", "/www",
+    "enable_keep_alive", "yes",
+    "num_threads", "8",
+    "thread_stack_size", "16384",
+    NULL
+  };
+  static const char *parked_options[] = {
+    "listening_ports", HTTP_PORT,
+    "document_root", "/www",
+    "enable_keep_alive", "yes",
+    "enable_tcp_nodelay", "yes",
+    "num_threads", "2",
+    "max_idle_connections", "8",
+    "thread_stack_size", "16384",
+    NULL
+  };
+  static const char *parked_cached_options[] = {
+    "listening_ports", HTTP_PORT,
+    "document_root", "/www",
+    "enable_keep_alive", "yes",
+    "enable_tcp_nodelay", "yes",
+    "num_threads", "2",
+    "max_idle_connections", "8",
+    "file_cache_size", "65536",
+    "thread_stack_size", "16384",
+    NULL
+  };
+  load_result thread_per_connection;
+  load_result parked;
+  load_result parked_cached;
+  int rv;
+
+  rv = rtems_bsdnet_initialize_network();
+  rtems_test_assert(rv == 0);
+
+  rv = mkdir("/www", S_IRWXU | S_IRWXG | S_IRWXO);
+  rtems_test_assert(rv == 0);
+
+  write_file('a');
+
+  test_load(
+    "thread per connection",
+    thread_per_connection_options,
+    0,
+    &thread_per_connection
+  );
+  test_load(
+    "parked connections",
+    parked_options,
+    CONNECTION_COUNT,
+    &parked
+  );
+  test_load(
+    "parked connections, file cache",
+    parked_cached_options,
+    CONNECTION_COUNT,
+    &parked_cached
+  );
+
+  /* Without parking, each connection stays with its worker thread */
+  rtems_test_assert(thread_per_connection.idle_connection_count == 0);
+
+  /* All idle connections are parked, up to max_idle_connections */
+  rtems_test_assert(parked.idle_connection_count == CONNECTION_COUNT);
+  rtems_test_assert(parked_cached.idle_connection_count == CONNECTION_COUNT);
+
+  /* Parked connections need less worker threads */
+  rtems_test_assert(parked.start_heap < thread_per_connection.start_heap);
+
+  /*
+   * A parked connection needs only its sockets and no worker thread, so it
+   * uses much less heap than the stack of a worker thread.
+   */
+  rtems_test_assert(parked.idle_connection_heap < THREAD_STACK_SIZE / 4);
+  rtems_test_assert(parked_cached.idle_connection_heap < THREAD_STACK_SIZE / 4);
+
+  test_file_cache(parked_cached_options);
+}
+
+static void Init(rtems_task_argument arg)
+{
+  TEST_BEGIN();
+
+  test();
+
+  TEST_END();
+
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+
+#define CONFIGURE_USE_IMFS_AS_BASE_FILESYSTEM
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 32
+
+#define CONFIGURE_UNLIMITED_OBJECTS
+
+#define CONFIGURE_UNIFIED_WORK_AREAS
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT_TASK_STACK_SIZE (16 * 1024)
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
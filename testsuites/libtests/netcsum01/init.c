@@ -0,0 +1,399 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/socket.h>
+#include <sys/sockio.h>
+#include <sys/ioctl.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <netinet/in_systm.h>
+#include <netinet/ip.h>
+#include <netinet/ip_var.h>
+#include <netinet/udp.h>
+#include <netinet/udp_var.h>
+#include <netinet/tcp.h>
+#include <netinet/tcp_timer.h>
+#include <netinet/tcp_var.h>
+#include <arpa/inet.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems/rtems_bsdnet.h>
+
+const char rtems_test_name[] = "NETCSUM 1";
+
+#define PORT 5000
+
+#define TRANSFER_SIZE (1024 * 1024)
+
+#define CHUNK_SIZE (16 * 1024)
+
+#define DATAGRAM_MAX 20000
+
+#define WORKER_PRIORITY 110
+
+/* Kernel statistics */
+extern struct ipstat ipstat;
+extern struct udpstat udpstat;
+extern struct tcpstat tcpstat;
+
+struct rtems_bsdnet_config rtems_bsdnet_config;
+
+typedef struct {
+  int fd;
+  size_t done;
+  rtems_id done_sema;
+  char buf[CHUNK_SIZE];
+} receiver_context;
+
+static receiver_context receiver;
+
+static char sender_buf[CHUNK_SIZE];
+
+static char datagram_out[DATAGRAM_MAX];
+
+static char datagram_in[DATAGRAM_MAX];
+
+static const size_t datagram_sizes[] = {
+  0, 1, 2, 3, 1471, 1472, 8000, 16000, DATAGRAM_MAX
+};
+
+static char pattern(size_t i)
+{
+  return (char) (i * 7 + (i >> 8));
+}
+
+static void receiver_task(rtems_task_argument arg)
+{
+  receiver_context *ctx = (receiver_context *) arg;
+  rtems_status_code sc;
+
+  while (ctx->done < TRANSFER_SIZE) {
+    ssize_t r = read(ctx->fd, ctx->buf, sizeof(ctx->buf));
+    ssize_t i;
+
+    rtems_test_assert(r > 0);
+
+    for (i = 0; i < r; ++i) {
+      rtems_test_assert(ctx->buf[i] == pattern(ctx->done + (size_t) i));
+    }
+
+    ctx->done += (size_t) r;
+  }
+
+  sc = rtems_semaphore_release(ctx->done_sema);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  rtems_task_delete(RTEMS_SELF);
+}
+
+static void init_addr(struct sockaddr_in *addr, int port)
+{
+  memset(addr, 0, sizeof(*addr));
+  addr->sin_len = sizeof(*addr);
+  addr->sin_family = AF_INET;
+  addr->sin_port = htons(port);
+  addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+}
+
+static void connect_pair(int port, int *client, int *server)
+{
+  struct sockaddr_in addr;
+  socklen_t addr_len = sizeof(addr);
+  int listener;
+  int rv;
+
+  init_addr(&addr, port);
+
+  listener = socket(PF_INET, SOCK_STREAM, 0);
+  rtems_test_assert(listener >= 0);
+
+  rv = bind(listener, (struct sockaddr *) &addr, sizeof(addr));
+  rtems_test_assert(rv == 0);
+
+  rv = listen(listener, 1);
+  rtems_test_assert(rv == 0);
+
+  *client = socket(PF_INET, SOCK_STREAM, 0);
+  rtems_test_assert(*client >= 0);
+
+  rv = connect(*client, (struct sockaddr *) &addr, sizeof(addr));
+  rtems_test_assert(rv == 0);
+
+  *server = accept(listener, (struct sockaddr *) &addr, &addr_len);
+  rtems_test_assert(*server >= 0);
+
+  rv = close(listener);
+  rtems_test_assert(rv == 0);
+}
+
+static void init_ifreq(struct ifreq *ifr)
+{
+  memset(ifr, 0, sizeof(*ifr));
+  strncpy(ifr->ifr_name, "lo0", sizeof(ifr->ifr_name));
+}
+
+static void set_capabilities(int fd, int caps)
+{
+  struct ifreq ifr;
+  int rv;
+
+  init_ifreq(&ifr);
+  ifr.ifr_reqcap = caps;
+  rv = ioctl(fd, SIOCSIFCAP, &ifr);
+  rtems_test_assert(rv == 0);
+
+  init_ifreq(&ifr);
+  rv = ioctl(fd, SIOCGIFCAP, &ifr);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(ifr.ifr_reqcap == IFCAP_HWCSUM);
+  rtems_test_assert(ifr.ifr_curcap == caps);
+}
+
+static void test_capabilities(int fd)
+{
+  struct ifreq ifr;
+  int rv;
+
+  /* The loopback interface uses software checksums by default */
+  init_ifreq(&ifr);
+  rv = ioctl(fd, SIOCGIFCAP, &ifr);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(ifr.ifr_reqcap == IFCAP_HWCSUM);
+  rtems_test_assert(ifr.ifr_curcap == 0);
+
+  /* Capabilities not provided by the interface cannot be enabled */
+  init_ifreq(&ifr);
+  ifr.ifr_reqcap = IFCAP_HWCSUM | IFCAP_TSO4;
+  errno = 0;
+  rv = ioctl(fd, SIOCSIFCAP, &ifr);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == EINVAL);
+
+  set_capabilities(fd, IFCAP_TXCSUM);
+  set_capabilities(fd, 0);
+}
+
+static void test_tcp(rtems_id done_sema, int port, const char *mode)
+{
+  rtems_status_code sc;
+  rtems_id id;
+  size_t done = 0;
+  int client;
+  int server;
+  int rv;
+
+  connect_pair(port, &client, &server);
+
+  receiver.fd = server;
+  receiver.done = 0;
+  receiver.done_sema = done_sema;
+
+  sc = rtems_task_create(
+    rtems_build_name('R', 'E', 'C', 'V'),
+    WORKER_PRIORITY,
+    RTEMS_MINIMUM_STACK_SIZE,
+    RTEMS_DEFAULT_MODES,
+    RTEMS_DEFAULT_ATTRIBUTES,
+    &id
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_task_start(id, receiver_task, (rtems_task_argument) &receiver);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  while (done < TRANSFER_SIZE) {
+    size_t n = TRANSFER_SIZE - done;
+    ssize_t w;
+    size_t i;
+
+    if (n > sizeof(sender_buf)) {
+      n = sizeof(sender_buf);
+    }
+
+    for (i = 0; i < n; ++i) {
+      sender_buf[i] = pattern(done + i);
+    }
+
+    w = write(client, sender_buf, n);
+    rtems_test_assert(w > 0);
+
+    done += (size_t) w;
+  }
+
+  sc = rtems_semaphore_obtain(done_sema, RTEMS_WAIT, RTEMS_NO_TIMEOUT);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  rtems_test_assert(receiver.done == TRANSFER_SIZE);
+
+  printf("%s: TCP %i KiB\n", mode, TRANSFER_SIZE / 1024);
+
+  rv = close(client);
+  rtems_test_assert(rv == 0);
+
+  rv = close(server);
+  rtems_test_assert(rv == 0);
+}
+
+static void test_udp(int port)
+{
+  struct sockaddr_in addr;
+  int bufsize = 2 * DATAGRAM_MAX;
+  size_t i;
+  int sender;
+  int receiver_fd;
+  int rv;
+
+  for (i = 0; i < sizeof(datagram_out); ++i) {
+    datagram_out[i] = pattern(i);
+  }
+
+  init_addr(&addr, port);
+
+  receiver_fd = socket(PF_INET, SOCK_DGRAM, 0);
+  rtems_test_assert(receiver_fd >= 0);
+
+  rv = setsockopt(
+    receiver_fd,
+    SOL_SOCKET,
+    SO_RCVBUF,
+    &bufsize,
+    sizeof(bufsize)
+  );
+  rtems_test_assert(rv == 0);
+
+  rv = bind(receiver_fd, (struct sockaddr *) &addr, sizeof(addr));
+  rtems_test_assert(rv == 0);
+
+  sender = socket(PF_INET, SOCK_DGRAM, 0);
+  rtems_test_assert(sender >= 0);
+
+  rv = setsockopt(sender, SOL_SOCKET, SO_SNDBUF, &bufsize, sizeof(bufsize));
+  rtems_test_assert(rv == 0);
+
+  /*
+   * The largest datagrams exceed the MTU of the loopback interface, so the
+   * data checksum must be computed before the fragmentation.
+   */
+  for (i = 0; i < RTEMS_ARRAY_SIZE(datagram_sizes); ++i) {
+    size_t size = datagram_sizes[i];
+    ssize_t n;
+
+    n = sendto(
+      sender,
+      datagram_out,
+      size,
+      0,
+      (struct sockaddr *) &addr,
+      sizeof(addr)
+    );
+    rtems_test_assert(n == (ssize_t) size);
+
+    memset(datagram_in, 0, sizeof(datagram_in));
+    n = recv(receiver_fd, datagram_in, sizeof(datagram_in), 0);
+    rtems_test_assert(n == (ssize_t) size);
+    rtems_test_assert(memcmp(datagram_in, datagram_out, size) == 0);
+  }
+
+  rv = close(sender);
+  rtems_test_assert(rv == 0);
+
+  rv = close(receiver_fd);
+  rtems_test_assert(rv == 0);
+}
+
+static void test_mode(rtems_id done_sema, int fd, int caps, int port)
+{
+  const char *mode = caps != 0 ? "offload" : "software";
+  u_long ip_badsum = ipstat.ips_badsum;
+  u_long udp_badsum = udpstat.udps_badsum;
+  u_long tcp_badsum = tcpstat.tcps_rcvbadsum;
+
+  set_capabilities(fd, caps);
+
+  test_udp(port);
+  test_tcp(done_sema, port + 1, mode);
+
+  rtems_test_assert(ipstat.ips_badsum == ip_badsum);
+  rtems_test_assert(udpstat.udps_badsum == udp_badsum);
+  rtems_test_assert(tcpstat.tcps_rcvbadsum == tcp_badsum);
+}
+
+static void test(void)
+{
+  rtems_status_code sc;
+  rtems_id done_sema;
+  int fd;
+  int rv;
+
+  rv = rtems_bsdnet_initialize_network();
+  rtems_test_assert(rv == 0);
+
+  sc = rtems_semaphore_create(
+    rtems_build_name('D', 'O', 'N', 'E'),
+    0,
+    RTEMS_COUNTING_SEMAPHORE,
+    0,
+    &done_sema
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  fd = socket(PF_INET, SOCK_DGRAM, 0);
+  rtems_test_assert(fd >= 0);
+
+  test_capabilities(fd);
+
+  test_mode(done_sema, fd, 0, PORT);
+  test_mode(done_sema, fd, IFCAP_HWCSUM, PORT + 2);
+  test_mode(done_sema, fd, IFCAP_TXCSUM, PORT + 4);
+  test_mode(done_sema, fd, 0, PORT + 6);
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+
+  sc = rtems_semaphore_delete(done_sema);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static void Init(rtems_task_argument arg)
+{
+  TEST_BEGIN();
+
+  test();
+
+  TEST_END();
+
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+
+#define CONFIGURE_USE_IMFS_AS_BASE_FILESYSTEM
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 8
+
+#define CONFIGURE_MAXIMUM_TASKS 4
+
+#define CONFIGURE_MAXIMUM_SEMAPHORES 3
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
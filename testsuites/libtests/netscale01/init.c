@@ -0,0 +1,361 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems/rtems_bsdnet.h>
+
+const char rtems_test_name[] = "NETSCALE 1";
+
+#define PORT 5000
+
+#define CONNECTION_MAX 4
+
+#define TRANSFER_SIZE (1024 * 1024)
+
+#define CHUNK_SIZE (16 * 1024)
+
+#define WORKER_PRIORITY 110
+
+struct rtems_bsdnet_config rtems_bsdnet_config;
+
+typedef struct {
+  int fd;
+  size_t size;
+  size_t done;
+  rtems_id done_sema;
+  char buf[CHUNK_SIZE];
+} worker_context;
+
+static worker_context senders[CONNECTION_MAX + 1];
+
+static worker_context receivers[CONNECTION_MAX];
+
+static int receiver_count;
+
+static bool receiver_finished;
+
+static size_t progress_at_first_finish[CONNECTION_MAX];
+
+static void sender_task(rtems_task_argument arg)
+{
+  worker_context *ctx = (worker_context *) arg;
+  rtems_status_code sc;
+
+  memset(ctx->buf, 0xa5, sizeof(ctx->buf));
+
+  while (ctx->done < ctx->size) {
+    size_t n = ctx->size - ctx->done;
+    ssize_t w;
+
+    if (n > sizeof(ctx->buf)) {
+      n = sizeof(ctx->buf);
+    }
+
+    w = write(ctx->fd, ctx->buf, n);
+    rtems_test_assert(w > 0);
+
+    ctx->done += (size_t) w;
+  }
+
+  sc = rtems_semaphore_release(ctx->done_sema);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  rtems_task_delete(RTEMS_SELF);
+}
+
+static void receiver_task(rtems_task_argument arg)
+{
+  worker_context *ctx = (worker_context *) arg;
+  rtems_status_code sc;
+
+  while (ctx->done < ctx->size) {
+    ssize_t r = read(ctx->fd, ctx->buf, sizeof(ctx->buf));
+
+    rtems_test_assert(r > 0);
+
+    ctx->done += (size_t) r;
+  }
+
+  /*
+   * Record how far the other connections got when the first one is done.
+   * The workers have equal priority, so the others do not run meanwhile.
+   */
+  if (!receiver_finished) {
+    int i;
+
+    receiver_finished = true;
+
+    for (i = 0; i < receiver_count; ++i) {
+      progress_at_first_finish[i] = receivers[i].done;
+    }
+  }
+
+  sc = rtems_semaphore_release(ctx->done_sema);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  rtems_task_delete(RTEMS_SELF);
+}
+
+static void start_worker(
+  rtems_task_entry entry,
+  worker_context *ctx,
+  int fd,
+  size_t size,
+  rtems_id done_sema
+)
+{
+  rtems_status_code sc;
+  rtems_id id;
+
+  ctx->fd = fd;
+  ctx->size = size;
+  ctx->done = 0;
+  ctx->done_sema = done_sema;
+
+  sc = rtems_task_create(
+    rtems_build_name('W', 'O', 'R', 'K'),
+    WORKER_PRIORITY,
+    RTEMS_MINIMUM_STACK_SIZE,
+    RTEMS_DEFAULT_MODES,
+    RTEMS_DEFAULT_ATTRIBUTES,
+    &id
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_task_start(id, entry, (rtems_task_argument) ctx);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static void wait_for_workers(rtems_id done_sema, int count)
+{
+  int i;
+
+  for (i = 0; i < count; ++i) {
+    rtems_status_code sc;
+
+    sc = rtems_semaphore_obtain(done_sema, RTEMS_WAIT, RTEMS_NO_TIMEOUT);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+}
+
+static void connect_pair(int port, int *client, int *server)
+{
+  struct sockaddr_in addr;
+  socklen_t addr_len = sizeof(addr);
+  int listener;
+  int rv;
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_len = sizeof(addr);
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  listener = socket(PF_INET, SOCK_STREAM, 0);
+  rtems_test_assert(listener >= 0);
+
+  rv = bind(listener, (struct sockaddr *) &addr, sizeof(addr));
+  rtems_test_assert(rv == 0);
+
+  rv = listen(listener, 1);
+  rtems_test_assert(rv == 0);
+
+  *client = socket(PF_INET, SOCK_STREAM, 0);
+  rtems_test_assert(*client >= 0);
+
+  rv = connect(*client, (struct sockaddr *) &addr, sizeof(addr));
+  rtems_test_assert(rv == 0);
+
+  *server = accept(listener, (struct sockaddr *) &addr, &addr_len);
+  rtems_test_assert(*server >= 0);
+
+  rv = close(listener);
+  rtems_test_assert(rv == 0);
+}
+
+/*
+ * Two tasks write to the same socket.  The second writer must wait for the
+ * socket buffer lock while the first one copies its data.
+ */
+static void test_shared_socket(rtems_id done_sema)
+{
+  int client;
+  int server;
+  int rv;
+
+  connect_pair(PORT, &client, &server);
+
+  receiver_count = 1;
+  receiver_finished = false;
+
+  start_worker(receiver_task, &receivers[0], server, TRANSFER_SIZE, done_sema);
+  start_worker(sender_task, &senders[0], client, TRANSFER_SIZE / 2, done_sema);
+  start_worker(sender_task, &senders[1], client, TRANSFER_SIZE / 2, done_sema);
+
+  wait_for_workers(done_sema, 3);
+
+  rtems_test_assert(receivers[0].done == TRANSFER_SIZE);
+
+  printf("shared socket: %i KiB\n", TRANSFER_SIZE / 1024);
+
+  rv = close(client);
+  rtems_test_assert(rv == 0);
+
+  rv = close(server);
+  rtems_test_assert(rv == 0);
+}
+
+/*
+ * Transfer TRANSFER_SIZE bytes over each of count concurrent connections and
+ * return the time needed for all of them.
+ */
+static uint64_t test_connections(rtems_id done_sema, int count)
+{
+  int client[CONNECTION_MAX];
+  int server[CONNECTION_MAX];
+  uint64_t start;
+  uint64_t ns;
+  int i;
+
+  for (i = 0; i < count; ++i) {
+    connect_pair(PORT + 1 + i, &client[i], &server[i]);
+  }
+
+  receiver_count = count;
+  receiver_finished = false;
+
+  start = rtems_clock_get_uptime_nanoseconds();
+
+  for (i = 0; i < count; ++i) {
+    start_worker(
+      receiver_task,
+      &receivers[i],
+      server[i],
+      TRANSFER_SIZE,
+      done_sema
+    );
+    start_worker(
+      sender_task,
+      &senders[i],
+      client[i],
+      TRANSFER_SIZE,
+      done_sema
+    );
+  }
+
+  wait_for_workers(done_sema, 2 * count);
+
+  ns = rtems_clock_get_uptime_nanoseconds() - start;
+
+  for (i = 0; i < count; ++i) {
+    int rv;
+
+    rtems_test_assert(receivers[i].done == TRANSFER_SIZE);
+
+    /*
+     * The connections progress in parallel.  None of them waits for another
+     * connection to finish its transfer before it moves its own data.
+     */
+    rtems_test_assert(progress_at_first_finish[i] >= TRANSFER_SIZE / 4);
+
+    rv = close(client[i]);
+    rtems_test_assert(rv == 0);
+
+    rv = close(server[i]);
+    rtems_test_assert(rv == 0);
+  }
+
+  printf(
+    "%i connection(s): %i KiB\n",
+    count,
+    count * TRANSFER_SIZE / 1024
+  );
+
+  return ns;
+}
+
+/*
+ * The aggregate throughput of count connections which took ns must be at
+ * least half the throughput of a single connection which took single_ns.
+ * Concurrent connections must not be slowed down by waiting for each other.
+ */
+static void check_throughput(int count, uint64_t ns, uint64_t single_ns)
+{
+  rtems_test_assert(ns <= 2 * (uint64_t) count * single_ns);
+}
+
+static void test(void)
+{
+  rtems_status_code sc;
+  rtems_id done_sema;
+  uint64_t single_ns;
+  int rv;
+
+  rv = rtems_bsdnet_initialize_network();
+  rtems_test_assert(rv == 0);
+
+  sc = rtems_semaphore_create(
+    rtems_build_name('D', 'O', 'N', 'E'),
+    0,
+    RTEMS_COUNTING_SEMAPHORE,
+    0,
+    &done_sema
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  test_shared_socket(done_sema);
+
+  single_ns = test_connections(done_sema, 1);
+  check_throughput(2, test_connections(done_sema, 2), single_ns);
+  check_throughput(4, test_connections(done_sema, 4), single_ns);
+
+  sc = rtems_semaphore_delete(done_sema);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static void Init(rtems_task_argument arg)
+{
+  TEST_BEGIN();
+
+  test();
+
+  TEST_END();
+
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+
+#define CONFIGURE_USE_IMFS_AS_BASE_FILESYSTEM
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS (3 + 2 * CONNECTION_MAX + 1)
+
+#define CONFIGURE_MAXIMUM_TASKS (3 + 2 * CONNECTION_MAX)
+
+#define CONFIGURE_MAXIMUM_SEMAPHORES 3
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -0,0 +1,719 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/stat.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rpc/rpc.h>
+#include <rpc/pmap_prot.h>
+
+#include <librtemsNfs.h>
+#include <rtems/libio.h>
+#include <rtems/rtems_bsdnet.h>
+
+const char rtems_test_name[] = "NFS 1";
+
+/*
+ * A minimal NFS version 2 server on the loopback interface.  It exports a
+ * directory with two regular files and answers the portmapper, MOUNT and
+ * NFS calls of the client on the portmapper port.
+ */
+
+#define NFS_PROGRAM 100003
+
+#define NFS_VERSION 2
+
+#define NFSPROC_NULL 0
+
+#define NFSPROC_GETATTR 1
+
+#define NFSPROC_LOOKUP 4
+
+#define NFSPROC_READ 6
+
+#define MOUNTPROG 100005
+
+#define MOUNTVERS 1
+
+#define MOUNTPROC_NULL 0
+
+#define MOUNTPROC_MNT 1
+
+#define MOUNTPROC_UMNT 3
+
+#define NFS_OK 0
+
+#define NFSERR_NOENT 2
+
+#define NFSERR_IO 5
+
+#define NFSERR_STALE 70
+
+#define NFS_FHSIZE 32
+
+#define NFS_MAXNAMLEN 255
+
+#define NFS_MAXPATHLEN 1024
+
+#define NFS_MAXDATA 8192
+
+#define NFREG 1
+
+#define NFDIR 2
+
+#define FILE_SIZE (16 * NFS_MAXDATA)
+
+#define SERVER_TASK_PRIORITY 100
+
+#define SERVER_READY_EVENT RTEMS_EVENT_0
+
+#define MOUNT_POINT "/nfs"
+
+struct rtems_bsdnet_config rtems_bsdnet_config;
+
+typedef struct {
+  uint32_t id;
+  uint32_t type;
+  uint32_t mode;
+  uint32_t size;
+  const char *name;
+} test_node;
+
+typedef struct {
+  char fh[NFS_FHSIZE];
+  char name[NFS_MAXNAMLEN + 1];
+} test_dirop_args;
+
+typedef struct {
+  char fh[NFS_FHSIZE];
+  u_int offset;
+  u_int count;
+  u_int totalcount;
+} test_read_args;
+
+typedef struct {
+  uint32_t status;
+  const test_node *node;
+} test_attr_res;
+
+typedef struct {
+  uint32_t status;
+  const test_node *node;
+  char *data;
+  u_int len;
+} test_read_res;
+
+static test_node test_nodes[] = {
+  { 1, NFDIR, S_IFDIR | 0755, 512, "" },
+  { 2, NFREG, S_IFREG | 0644, FILE_SIZE, "a" },
+  { 3, NFREG, S_IFREG | 0644, FILE_SIZE, "b" }
+};
+
+static rtems_id init_task;
+
+static uint32_t read_count;
+
+static uint32_t fail_offset = UINT32_MAX;
+
+static char file_data[FILE_SIZE];
+
+static char read_data[NFS_MAXDATA];
+
+static const test_node *get_node(const char *fh)
+{
+  uint32_t id;
+  size_t i;
+
+  memcpy(&id, fh, sizeof(id));
+
+  for (i = 0; i < RTEMS_ARRAY_SIZE(test_nodes); ++i) {
+    if (test_nodes[i].id == id) {
+      return &test_nodes[i];
+    }
+  }
+
+  return NULL;
+}
+
+static bool_t xdr_test_fh(XDR *xdrs, char *fh)
+{
+  return xdr_opaque(xdrs, fh, NFS_FHSIZE);
+}
+
+static bool_t xdr_test_node_fh(XDR *xdrs, const test_node *node)
+{
+  char fh[NFS_FHSIZE];
+
+  memset(fh, 0, sizeof(fh));
+  memcpy(fh, &node->id, sizeof(node->id));
+
+  return xdr_test_fh(xdrs, fh);
+}
+
+static bool_t xdr_test_fattr(XDR *xdrs, const test_node *node)
+{
+  u_int attr[] = {
+    node->type,
+    node->mode,
+    1,
+    0,
+    0,
+    node->size,
+    NFS_MAXDATA,
+    0,
+    (node->size + 511) / 512,
+    1,
+    node->id,
+    0, 0,
+    0, 0,
+    0, 0
+  };
+  size_t i;
+
+  for (i = 0; i < RTEMS_ARRAY_SIZE(attr); ++i) {
+    if (!xdr_u_int(xdrs, &attr[i])) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+static bool_t xdr_test_attr_res(XDR *xdrs, test_attr_res *res)
+{
+  if (!xdr_u_int(xdrs, &res->status)) {
+    return FALSE;
+  }
+
+  if (res->status != NFS_OK) {
+    return TRUE;
+  }
+
+  return xdr_test_fattr(xdrs, res->node);
+}
+
+static bool_t xdr_test_dirop_res(XDR *xdrs, test_attr_res *res)
+{
+  if (!xdr_u_int(xdrs, &res->status)) {
+    return FALSE;
+  }
+
+  if (res->status != NFS_OK) {
+    return TRUE;
+  }
+
+  return xdr_test_node_fh(xdrs, res->node)
+    && xdr_test_fattr(xdrs, res->node);
+}
+
+static bool_t xdr_test_read_res(XDR *xdrs, test_read_res *res)
+{
+  if (!xdr_u_int(xdrs, &res->status)) {
+    return FALSE;
+  }
+
+  if (res->status != NFS_OK) {
+    return TRUE;
+  }
+
+  return xdr_test_fattr(xdrs, res->node)
+    && xdr_bytes(xdrs, &res->data, &res->len, NFS_MAXDATA);
+}
+
+static bool_t xdr_test_fhstatus(XDR *xdrs, const test_node *node)
+{
+  u_int status = NFS_OK;
+
+  return xdr_u_int(xdrs, &status) && xdr_test_node_fh(xdrs, node);
+}
+
+static bool_t xdr_test_path(XDR *xdrs, char *path)
+{
+  return xdr_string(xdrs, &path, NFS_MAXPATHLEN);
+}
+
+static bool_t get_path(SVCXPRT *xprt, char *path)
+{
+  return svc_getargs(xprt, (xdrproc_t) xdr_test_path, (caddr_t) path);
+}
+
+static void pmap_dispatch(struct svc_req *req, SVCXPRT *xprt)
+{
+  struct pmap args;
+  u_long port;
+
+  switch (req->rq_proc) {
+    case PMAPPROC_NULL:
+      svc_sendreply(xprt, (xdrproc_t) xdr_void, NULL);
+      break;
+    case PMAPPROC_GETPORT:
+      if (!svc_getargs(xprt, (xdrproc_t) xdr_pmap, (caddr_t) &args)) {
+        svcerr_decode(xprt);
+        break;
+      }
+
+      if (
+        (args.pm_prog == NFS_PROGRAM || args.pm_prog == MOUNTPROG)
+          && args.pm_prot == IPPROTO_UDP
+      ) {
+        port = PMAPPORT;
+      } else {
+        port = 0;
+      }
+
+      svc_sendreply(xprt, (xdrproc_t) xdr_u_long, (caddr_t) &port);
+      break;
+    default:
+      svcerr_noproc(xprt);
+      break;
+  }
+}
+
+static void mount_dispatch(struct svc_req *req, SVCXPRT *xprt)
+{
+  char path[NFS_MAXPATHLEN + 1];
+
+  switch (req->rq_proc) {
+    case MOUNTPROC_NULL:
+      svc_sendreply(xprt, (xdrproc_t) xdr_void, NULL);
+      break;
+    case MOUNTPROC_MNT:
+      if (!get_path(xprt, path)) {
+        svcerr_decode(xprt);
+        break;
+      }
+
+      rtems_test_assert(strcmp(path, "/export") == 0);
+      svc_sendreply(
+        xprt,
+        (xdrproc_t) xdr_test_fhstatus,
+        (caddr_t) &test_nodes[0]
+      );
+      break;
+    case MOUNTPROC_UMNT:
+      if (!get_path(xprt, path)) {
+        svcerr_decode(xprt);
+        break;
+      }
+
+      svc_sendreply(xprt, (xdrproc_t) xdr_void, NULL);
+      break;
+    default:
+      svcerr_noproc(xprt);
+      break;
+  }
+}
+
+static void nfs_getattr(SVCXPRT *xprt)
+{
+  char fh[NFS_FHSIZE];
+  test_attr_res res;
+
+  if (!svc_getargs(xprt, (xdrproc_t) xdr_test_fh, (caddr_t) fh)) {
+    svcerr_decode(xprt);
+    return;
+  }
+
+  res.node = get_node(fh);
+  res.status = res.node != NULL ? NFS_OK : NFSERR_STALE;
+  svc_sendreply(xprt, (xdrproc_t) xdr_test_attr_res, (caddr_t) &res);
+}
+
+static bool_t xdr_test_dirop_args(XDR *xdrs, test_dirop_args *args)
+{
+  char *name = args->name;
+
+  return xdr_test_fh(xdrs, args->fh)
+    && xdr_string(xdrs, &name, NFS_MAXNAMLEN);
+}
+
+static void nfs_lookup(SVCXPRT *xprt)
+{
+  test_dirop_args args;
+  const test_node *dir;
+  test_attr_res res;
+  size_t i;
+
+  if (!svc_getargs(xprt, (xdrproc_t) xdr_test_dirop_args, (caddr_t) &args)) {
+    svcerr_decode(xprt);
+    return;
+  }
+
+  dir = get_node(args.fh);
+  res.status = dir != NULL && dir->type == NFDIR ? NFSERR_NOENT : NFSERR_STALE;
+  res.node = NULL;
+
+  for (i = 1; i < RTEMS_ARRAY_SIZE(test_nodes); ++i) {
+    if (dir != NULL && strcmp(args.name, test_nodes[i].name) == 0) {
+      res.status = NFS_OK;
+      res.node = &test_nodes[i];
+    }
+  }
+
+  svc_sendreply(xprt, (xdrproc_t) xdr_test_dirop_res, (caddr_t) &res);
+}
+
+static bool_t xdr_test_read_args(XDR *xdrs, test_read_args *args)
+{
+  return xdr_test_fh(xdrs, args->fh)
+    && xdr_u_int(xdrs, &args->offset)
+    && xdr_u_int(xdrs, &args->count)
+    && xdr_u_int(xdrs, &args->totalcount);
+}
+
+static void nfs_read(SVCXPRT *xprt)
+{
+  test_read_args args;
+  uint32_t offset;
+  uint32_t count;
+  test_read_res res;
+
+  if (!svc_getargs(xprt, (xdrproc_t) xdr_test_read_args, (caddr_t) &args)) {
+    svcerr_decode(xprt);
+    return;
+  }
+
+  offset = args.offset;
+  count = args.count;
+  read_count = count;
+
+  res.node = get_node(args.fh);
+
+  if (res.node == NULL || res.node->type != NFREG) {
+    res.status = NFSERR_STALE;
+  } else if (offset >= fail_offset) {
+    res.status = NFSERR_IO;
+  } else {
+    res.status = NFS_OK;
+
+    if (offset > FILE_SIZE) {
+      offset = FILE_SIZE;
+    }
+
+    if (count > FILE_SIZE - offset) {
+      count = FILE_SIZE - offset;
+    }
+
+    memcpy(read_data, &file_data[offset], count);
+    res.data = read_data;
+    res.len = count;
+  }
+
+  svc_sendreply(xprt, (xdrproc_t) xdr_test_read_res, (caddr_t) &res);
+}
+
+static void nfs_dispatch(struct svc_req *req, SVCXPRT *xprt)
+{
+  switch (req->rq_proc) {
+    case NFSPROC_NULL:
+      svc_sendreply(xprt, (xdrproc_t) xdr_void, NULL);
+      break;
+    case NFSPROC_GETATTR:
+      nfs_getattr(xprt);
+      break;
+    case NFSPROC_LOOKUP:
+      nfs_lookup(xprt);
+      break;
+    case NFSPROC_READ:
+      nfs_read(xprt);
+      break;
+    default:
+      svcerr_noproc(xprt);
+      break;
+  }
+}
+
+static void server_task(rtems_task_argument arg)
+{
+  rtems_status_code sc;
+  struct sockaddr_in addr;
+  SVCXPRT *xprt;
+  bool_t ok;
+  int sd;
+  int rv;
+
+  rv = rtems_rpc_task_init();
+  rtems_test_assert(rv == RTEMS_SUCCESSFUL);
+
+  sd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  rtems_test_assert(sd >= 0);
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_len = sizeof(addr);
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(PMAPPORT);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  rv = bind(sd, (struct sockaddr *) &addr, sizeof(addr));
+  rtems_test_assert(rv == 0);
+
+  xprt = svcudp_create(sd);
+  rtems_test_assert(xprt != NULL);
+
+  /* A protocol of zero does not register the program at a portmapper */
+  ok = svc_register(xprt, PMAPPROG, PMAPVERS, pmap_dispatch, 0);
+  rtems_test_assert(ok);
+
+  ok = svc_register(xprt, MOUNTPROG, MOUNTVERS, mount_dispatch, 0);
+  rtems_test_assert(ok);
+
+  ok = svc_register(xprt, NFS_PROGRAM, NFS_VERSION, nfs_dispatch, 0);
+  rtems_test_assert(ok);
+
+  sc = rtems_event_send(init_task, SERVER_READY_EVENT);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  svc_run();
+  rtems_test_assert(0);
+}
+
+static void start_server(void)
+{
+  rtems_status_code sc;
+  rtems_event_set events;
+  rtems_id id;
+
+  init_task = rtems_task_self();
+
+  sc = rtems_task_create(
+    rtems_build_name('N', 'F', 'S', 'D'),
+    SERVER_TASK_PRIORITY,
+    RTEMS_MINIMUM_STACK_SIZE + 8 * 1024,
+    RTEMS_DEFAULT_MODES,
+    RTEMS_DEFAULT_ATTRIBUTES,
+    &id
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_task_start(id, server_task, 0);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_event_receive(
+    SERVER_READY_EVENT,
+    RTEMS_EVENT_ALL | RTEMS_WAIT,
+    RTEMS_NO_TIMEOUT,
+    &events
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static void create_file_data(void)
+{
+  size_t i;
+
+  for (i = 0; i < sizeof(file_data); ++i) {
+    file_data[i] = (char) (i * 7 + i / 251);
+  }
+}
+
+static void check_read(int fd, off_t offset, size_t count, ssize_t expected)
+{
+  char buf[256];
+  ssize_t n;
+
+  rtems_test_assert(count <= sizeof(buf));
+
+  n = read(fd, buf, count);
+  rtems_test_assert(n == expected);
+  rtems_test_assert(memcmp(buf, &file_data[offset], (size_t) n) == 0);
+  rtems_test_assert(lseek(fd, 0, SEEK_CUR) == offset + n);
+}
+
+static void test_partial_read(void)
+{
+  off_t window_size = nfsGetWindow() * NFS_MAXDATA;
+  char buf[100];
+  off_t offset;
+  ssize_t n;
+  int fd;
+  int rv;
+
+  puts("test partial read");
+
+  fd = open(MOUNT_POINT "/a", O_RDONLY);
+  rtems_test_assert(fd >= 0);
+
+  /* Fill the read-ahead buffer */
+  check_read(fd, 0, 100, 100);
+  rtems_test_assert(read_count == NFS_MAXDATA);
+
+  /*
+   * The data preceding the end of the read-ahead buffer must be returned
+   * even if the refill fails.
+   */
+  offset = lseek(fd, window_size - 50, SEEK_SET);
+  rtems_test_assert(offset == window_size - 50);
+
+  fail_offset = window_size;
+  check_read(fd, offset, 100, 50);
+
+  errno = 0;
+  n = read(fd, buf, sizeof(buf));
+  rtems_test_assert(n == -1);
+  rtems_test_assert(errno == EIO);
+  rtems_test_assert(lseek(fd, 0, SEEK_CUR) == window_size);
+
+  fail_offset = UINT32_MAX;
+  check_read(fd, window_size, 100, 100);
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+}
+
+static void test_read_ahead_limit(void)
+{
+  uint32_t window_size = nfsGetWindow() * NFS_MAXDATA;
+  uint32_t max = nfsGetReadAheadMax();
+  int fa;
+  int fb;
+  int rv;
+
+  puts("test read-ahead limit");
+
+  nfsSetReadAheadMax(window_size);
+  rtems_test_assert(nfsGetReadAheadMax() == window_size);
+
+  fa = open(MOUNT_POINT "/a", O_RDONLY);
+  rtems_test_assert(fa >= 0);
+
+  fb = open(MOUNT_POINT "/b", O_RDONLY);
+  rtems_test_assert(fb >= 0);
+
+  /* The first file uses up the limit */
+  check_read(fa, 0, 100, 100);
+  rtems_test_assert(read_count == NFS_MAXDATA);
+
+  /* The second file is read without read-ahead */
+  check_read(fb, 0, 100, 100);
+  rtems_test_assert(read_count == 100);
+
+  /* Closing the first file releases its buffer */
+  rv = close(fa);
+  rtems_test_assert(rv == 0);
+
+  check_read(fb, 100, 100, 100);
+  rtems_test_assert(read_count == NFS_MAXDATA);
+
+  read_count = 0;
+  check_read(fb, 200, 100, 100);
+  rtems_test_assert(read_count == 0);
+
+  rv = close(fb);
+  rtems_test_assert(rv == 0);
+
+  nfsSetReadAheadMax(max);
+}
+
+static void test_close_to_open(void)
+{
+  test_node *node = &test_nodes[2];
+  struct stat st;
+  int fd;
+  int rv;
+
+  puts("test close-to-open consistency");
+
+  rv = stat(MOUNT_POINT "/b", &st);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(st.st_size == FILE_SIZE);
+
+  /* Another client truncates the file */
+  node->size = FILE_SIZE / 2;
+
+  fd = open(MOUNT_POINT "/b", O_RDONLY);
+  rtems_test_assert(fd >= 0);
+
+  rv = fstat(fd, &st);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(st.st_size == FILE_SIZE / 2);
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+
+  /* The name lookup cache has the new attributes as well */
+  rv = stat(MOUNT_POINT "/b", &st);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(st.st_size == FILE_SIZE / 2);
+
+  node->size = FILE_SIZE;
+}
+
+static void test(void)
+{
+  int rv;
+
+  rv = rtems_bsdnet_initialize_network();
+  rtems_test_assert(rv == 0);
+
+  create_file_data();
+  start_server();
+
+  rv = mount_and_make_target_path(
+    "0.0@127.0.0.1:/export",
+    MOUNT_POINT,
+    RTEMS_FILESYSTEM_TYPE_NFS,
+    RTEMS_FILESYSTEM_READ_ONLY,
+    NULL
+  );
+  rtems_test_assert(rv == 0);
+
+  test_partial_read();
+  test_read_ahead_limit();
+  test_close_to_open();
+
+  rv = unmount(MOUNT_POINT);
+  rtems_test_assert(rv == 0);
+}
+
+static void Init(rtems_task_argument arg)
+{
+  TEST_BEGIN();
+
+  test();
+
+  TEST_END();
+
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+
+#define CONFIGURE_USE_IMFS_AS_BASE_FILESYSTEM
+#define CONFIGURE_FILESYSTEM_NFS
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 32
+
+#define CONFIGURE_MAXIMUM_DRIVERS 4
+
+#define CONFIGURE_UNLIMITED_OBJECTS
+
+#define CONFIGURE_UNIFIED_WORK_AREAS
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+/* The client must not starve the server task */
+#define CONFIGURE_INIT_TASK_PRIORITY 110
+
+#define CONFIGURE_INIT_TASK_STACK_SIZE (16 * 1024)
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
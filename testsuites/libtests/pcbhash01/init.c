@@ -0,0 +1,432 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems/rtems_bsdnet.h>
+
+const char rtems_test_name[] = "PCBHASH 1";
+
+#define UDP_PORT 5000
+
+#define TCP_PORT 6000
+
+#define UDP_SOCKETS 256
+
+#define TCP_PAIRS 32
+
+#define ROUNDS 4
+
+/* Rounded down to 64 chains */
+#define UDP_HASH_SIZE 100
+
+#define TCP_HASH_SIZE 128
+
+struct rtems_bsdnet_config rtems_bsdnet_config = {
+  .udp_hash_size = UDP_HASH_SIZE,
+  .tcp_hash_size = TCP_HASH_SIZE
+};
+
+static int udp_sockets[UDP_SOCKETS];
+
+static int tcp_clients[TCP_PAIRS];
+
+static int tcp_servers[TCP_PAIRS];
+
+static void init_addr(struct sockaddr_in *addr, int port)
+{
+  memset(addr, 0, sizeof(*addr));
+  addr->sin_len = sizeof(*addr);
+  addr->sin_family = AF_INET;
+  addr->sin_port = htons(port);
+  addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+}
+
+static void connect_pair(int port, int *client, int *server)
+{
+  struct sockaddr_in addr;
+  socklen_t addr_len = sizeof(addr);
+  int listener;
+  int rv;
+
+  init_addr(&addr, port);
+
+  listener = socket(PF_INET, SOCK_STREAM, 0);
+  rtems_test_assert(listener >= 0);
+
+  rv = bind(listener, (struct sockaddr *) &addr, sizeof(addr));
+  rtems_test_assert(rv == 0);
+
+  rv = listen(listener, 1);
+  rtems_test_assert(rv == 0);
+
+  *client = socket(PF_INET, SOCK_STREAM, 0);
+  rtems_test_assert(*client >= 0);
+
+  rv = connect(*client, (struct sockaddr *) &addr, sizeof(addr));
+  rtems_test_assert(rv == 0);
+
+  *server = accept(listener, (struct sockaddr *) &addr, &addr_len);
+  rtems_test_assert(*server >= 0);
+
+  rv = close(listener);
+  rtems_test_assert(rv == 0);
+}
+
+static void get_stats(int protocol, struct rtems_bsdnet_pcb_hash_stats *st)
+{
+  int rv;
+
+  rv = rtems_bsdnet_pcb_hash_stats(protocol, st);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(st->conn_max <= st->pcb_count);
+  rtems_test_assert(st->wild_max <= st->pcb_count);
+  rtems_test_assert(st->port_max <= st->pcb_count);
+  rtems_test_assert(st->conn_used <= st->chain_count);
+  rtems_test_assert(st->wild_used <= st->chain_count);
+  rtems_test_assert(st->port_used <= st->chain_count);
+}
+
+static void resize(int protocol, unsigned long chain_count)
+{
+  int rv;
+
+  rv = rtems_bsdnet_pcb_hash_resize(protocol, chain_count);
+  rtems_test_assert(rv == 0);
+}
+
+static void test_errors(void)
+{
+  struct rtems_bsdnet_pcb_hash_stats st;
+  int rv;
+
+  errno = 0;
+  rv = rtems_bsdnet_pcb_hash_resize(IPPROTO_ICMP, 1);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == EINVAL);
+
+  errno = 0;
+  rv = rtems_bsdnet_pcb_hash_stats(IPPROTO_ICMP, &st);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == EINVAL);
+
+  errno = 0;
+  rv = rtems_bsdnet_pcb_hash_stats(IPPROTO_UDP, NULL);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == EINVAL);
+}
+
+static void test_config(void)
+{
+  struct rtems_bsdnet_pcb_hash_stats st;
+
+  get_stats(IPPROTO_UDP, &st);
+  rtems_test_assert(st.chain_count == 64);
+
+  get_stats(IPPROTO_TCP, &st);
+  rtems_test_assert(st.chain_count == TCP_HASH_SIZE);
+
+  rtems_bsdnet_show_pcb_hash_stats();
+}
+
+static void open_udp_sockets(int count)
+{
+  struct sockaddr_in addr;
+  int i;
+
+  for (i = 0; i < count; ++i) {
+    int rv;
+
+    udp_sockets[i] = socket(PF_INET, SOCK_DGRAM, 0);
+    rtems_test_assert(udp_sockets[i] >= 0);
+
+    init_addr(&addr, UDP_PORT + i);
+    rv = bind(udp_sockets[i], (struct sockaddr *) &addr, sizeof(addr));
+    rtems_test_assert(rv == 0);
+  }
+
+  /* A second bind to a used port is still detected */
+  init_addr(&addr, UDP_PORT + count - 1);
+  i = socket(PF_INET, SOCK_DGRAM, 0);
+  rtems_test_assert(i >= 0);
+  rtems_test_assert(bind(i, (struct sockaddr *) &addr, sizeof(addr)) == -1);
+  rtems_test_assert(errno == EADDRINUSE);
+  rtems_test_assert(close(i) == 0);
+}
+
+static void close_udp_sockets(int count)
+{
+  int i;
+
+  for (i = 0; i < count; ++i) {
+    int rv;
+
+    rv = close(udp_sockets[i]);
+    rtems_test_assert(rv == 0);
+  }
+}
+
+/*
+ * Send one datagram to each of the count sockets and receive it.
+ */
+static void udp_round_trip(int sender, int count)
+{
+  struct sockaddr_in addr;
+  int round;
+  int i;
+
+  for (round = 0; round < ROUNDS; ++round) {
+    for (i = 0; i < count; ++i) {
+      char buf[4] = { 0, 1, 2, 3 };
+      ssize_t n;
+
+      init_addr(&addr, UDP_PORT + i);
+      n = sendto(
+        sender,
+        buf,
+        sizeof(buf),
+        0,
+        (struct sockaddr *) &addr,
+        sizeof(addr)
+      );
+      rtems_test_assert(n == (ssize_t) sizeof(buf));
+
+      n = recv(udp_sockets[i], buf, sizeof(buf), 0);
+      rtems_test_assert(n == (ssize_t) sizeof(buf));
+      rtems_test_assert(buf[3] == 3);
+    }
+  }
+}
+
+/*
+ * Return the PCBs compared per lookup in hundredths for the lookups done
+ * since the statistics in before were obtained.
+ */
+static unsigned long steps_per_lookup(
+  const struct rtems_bsdnet_pcb_hash_stats *before,
+  const struct rtems_bsdnet_pcb_hash_stats *after
+)
+{
+  unsigned long lookups = after->lookups - before->lookups;
+  unsigned long steps = after->lookup_steps - before->lookup_steps;
+
+  rtems_test_assert(lookups > 0);
+
+  return (steps * 100) / lookups;
+}
+
+static void test_udp(void)
+{
+  static const int counts[] = { 16, 64, UDP_SOCKETS };
+  static const unsigned long chains[] = { 1, UDP_SOCKETS };
+  unsigned long steps[RTEMS_ARRAY_SIZE(chains)];
+  struct rtems_bsdnet_pcb_hash_stats st;
+  int sender;
+  size_t i;
+  size_t j;
+  int rv;
+
+  sender = socket(PF_INET, SOCK_DGRAM, 0);
+  rtems_test_assert(sender >= 0);
+
+  for (i = 0; i < RTEMS_ARRAY_SIZE(counts); ++i) {
+    open_udp_sockets(counts[i]);
+
+    for (j = 0; j < RTEMS_ARRAY_SIZE(chains); ++j) {
+      struct rtems_bsdnet_pcb_hash_stats before;
+
+      resize(IPPROTO_UDP, chains[j]);
+      get_stats(IPPROTO_UDP, &before);
+      udp_round_trip(sender, counts[i]);
+      get_stats(IPPROTO_UDP, &st);
+      steps[j] = steps_per_lookup(&before, &st);
+
+      /* The sender is bound by its first datagram */
+      if (chains[j] == 1) {
+        rtems_test_assert(st.wild_max == (unsigned long) counts[i] + 1);
+      } else {
+        rtems_test_assert(st.wild_max <= 2);
+      }
+
+      printf("UDP: %4i sockets, %5lu chains\n", counts[i], st.chain_count);
+    }
+
+    /* The demultiplexing compares less PCBs with more chains */
+    rtems_test_assert(steps[1] < steps[0]);
+
+    /* The sockets of the last row are used by the checks below */
+    if (counts[i] != UDP_SOCKETS) {
+      close_udp_sockets(counts[i]);
+    }
+  }
+
+  /* The sender is bound now, all sockets are unconnected */
+  get_stats(IPPROTO_UDP, &st);
+  rtems_test_assert(st.pcb_count == UDP_SOCKETS + 1);
+  rtems_test_assert(st.conn_used == 0);
+  rtems_test_assert(st.wild_max <= 2);
+  rtems_test_assert(st.port_max <= 2);
+
+  resize(IPPROTO_UDP, 1);
+  get_stats(IPPROTO_UDP, &st);
+  rtems_test_assert(st.chain_count == 1);
+  rtems_test_assert(st.wild_max == UDP_SOCKETS + 1);
+  rtems_test_assert(st.port_max == UDP_SOCKETS + 1);
+
+  /* The rounding of the size */
+  resize(IPPROTO_UDP, UDP_SOCKETS + 1);
+  get_stats(IPPROTO_UDP, &st);
+  rtems_test_assert(st.chain_count == UDP_SOCKETS);
+
+  rv = close(sender);
+  rtems_test_assert(rv == 0);
+
+  close_udp_sockets(UDP_SOCKETS);
+
+  get_stats(IPPROTO_UDP, &st);
+  rtems_test_assert(st.pcb_count == 0);
+  rtems_test_assert(st.wild_used == 0);
+  rtems_test_assert(st.port_used == 0);
+}
+
+static void tcp_round_trip(void)
+{
+  int round;
+  int i;
+
+  for (round = 0; round < ROUNDS; ++round) {
+    for (i = 0; i < TCP_PAIRS; ++i) {
+      char c = (char) i;
+      ssize_t n;
+
+      n = write(tcp_clients[i], &c, sizeof(c));
+      rtems_test_assert(n == (ssize_t) sizeof(c));
+
+      n = read(tcp_servers[i], &c, sizeof(c));
+      rtems_test_assert(n == (ssize_t) sizeof(c));
+      rtems_test_assert(c == (char) i);
+    }
+  }
+}
+
+static void test_tcp(void)
+{
+  static const unsigned long chains[] = { 1, TCP_HASH_SIZE };
+  unsigned long steps[RTEMS_ARRAY_SIZE(chains)];
+  struct rtems_bsdnet_pcb_hash_stats st;
+  int nodelay = 1;
+  size_t j;
+  int rv;
+  int i;
+
+  for (i = 0; i < TCP_PAIRS; ++i) {
+    connect_pair(TCP_PORT + i, &tcp_clients[i], &tcp_servers[i]);
+
+    rv = setsockopt(
+      tcp_clients[i],
+      IPPROTO_TCP,
+      TCP_NODELAY,
+      &nodelay,
+      sizeof(nodelay)
+    );
+    rtems_test_assert(rv == 0);
+  }
+
+  get_stats(IPPROTO_TCP, &st);
+  rtems_test_assert(st.pcb_count == 2 * TCP_PAIRS);
+  rtems_test_assert(st.wild_used == 0);
+  rtems_test_assert(st.conn_used > 0);
+
+  for (j = 0; j < RTEMS_ARRAY_SIZE(chains); ++j) {
+    struct rtems_bsdnet_pcb_hash_stats before;
+
+    resize(IPPROTO_TCP, chains[j]);
+    get_stats(IPPROTO_TCP, &before);
+    tcp_round_trip();
+
+    get_stats(IPPROTO_TCP, &st);
+    rtems_test_assert(st.chain_count == chains[j]);
+    rtems_test_assert(st.pcb_count == 2 * TCP_PAIRS);
+    steps[j] = steps_per_lookup(&before, &st);
+
+    if (chains[j] == 1) {
+      rtems_test_assert(st.conn_max == 2 * TCP_PAIRS);
+    }
+
+    printf(
+      "TCP: %4i connections, %5lu chains\n",
+      2 * TCP_PAIRS,
+      st.chain_count
+    );
+  }
+
+  rtems_test_assert(steps[1] < steps[0]);
+
+  rtems_test_assert(st.conn_max < 2 * TCP_PAIRS);
+
+  for (i = 0; i < TCP_PAIRS; ++i) {
+    rv = close(tcp_clients[i]);
+    rtems_test_assert(rv == 0);
+
+    rv = close(tcp_servers[i]);
+    rtems_test_assert(rv == 0);
+  }
+}
+
+static void Init(rtems_task_argument arg)
+{
+  int rv;
+
+  TEST_BEGIN();
+
+  rv = rtems_bsdnet_initialize_network();
+  rtems_test_assert(rv == 0);
+
+  test_errors();
+  test_config();
+  test_udp();
+  test_tcp();
+
+  TEST_END();
+
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+
+#define CONFIGURE_USE_IMFS_AS_BASE_FILESYSTEM
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS \
+  (UDP_SOCKETS + 2 * TCP_PAIRS + 8)
+
+#define CONFIGURE_MAXIMUM_TASKS 3
+
+#define CONFIGURE_MAXIMUM_SEMAPHORES 3
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
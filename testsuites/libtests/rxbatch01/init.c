@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems/rtems_bsdnet.h>
+
+#include "tapif.h"
+
+const char rtems_test_name[] = "RXBATCH 1";
+
+#define UDP_PORT 5000
+
+#define PACKETS 1024
+
+static struct rtems_bsdnet_ifconfig tapif_config = {
+  .name = TAPIF_NAME,
+  .attach = tapif_attach,
+  .ip_address = TAPIF_ADDRESS,
+  .ip_netmask = TAPIF_NETMASK
+};
+
+struct rtems_bsdnet_config rtems_bsdnet_config = {
+  .ifconfig = &tapif_config
+};
+
+static int open_socket(void)
+{
+  struct sockaddr_in addr;
+  int sd;
+  int rv;
+
+  sd = socket(PF_INET, SOCK_DGRAM, 0);
+  rtems_test_assert(sd >= 0);
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_len = sizeof(addr);
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(UDP_PORT);
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  rv = bind(sd, (struct sockaddr *) &addr, sizeof(addr));
+  rtems_test_assert(rv == 0);
+
+  return sd;
+}
+
+static void receive(int sd, uint32_t expected_seq)
+{
+  uint32_t seq;
+  ssize_t n;
+
+  n = recv(sd, &seq, sizeof(seq), 0);
+  rtems_test_assert(n == (ssize_t) sizeof(seq));
+  rtems_test_assert(ntohl(seq) == expected_seq);
+}
+
+static void receive_nothing(int sd)
+{
+  uint32_t seq;
+  ssize_t n;
+
+  errno = 0;
+  n = recv(sd, &seq, sizeof(seq), MSG_DONTWAIT);
+  rtems_test_assert(n == -1);
+  rtems_test_assert(errno == EWOULDBLOCK);
+}
+
+static void test_chain(int sd)
+{
+  int i;
+
+  /* The order of the frames is preserved */
+  tapif_receive(UDP_PORT, 0, 16, true);
+  for (i = 0; i < 16; ++i) {
+    receive(sd, i);
+  }
+  receive_nothing(sd);
+
+  /* A frame of an unknown type is dropped, the others are delivered */
+  tapif_receive_mixed(UDP_PORT, 100);
+  receive(sd, 100);
+  receive(sd, 101);
+  receive_nothing(sd);
+}
+
+/*
+ * Receive the packets in batches passed one by one or as a chain
+ */
+static void receive_batches(int sd, int batch, bool chain)
+{
+  uint32_t seq;
+
+  for (seq = 0; seq < PACKETS; seq += batch) {
+    int i;
+
+    tapif_receive(UDP_PORT, seq, batch, chain);
+
+    for (i = 0; i < batch; ++i) {
+      receive(sd, seq + i);
+    }
+  }
+}
+
+static void test_batches(int sd)
+{
+  static const int batches[] = { 1, 4, 16 };
+  size_t i;
+
+  for (i = 0; i < RTEMS_ARRAY_SIZE(batches); ++i) {
+    receive_batches(sd, batches[i], false);
+    receive_batches(sd, batches[i], true);
+
+    printf("batch %2i: %i packets\n", batches[i], PACKETS);
+  }
+
+  receive_nothing(sd);
+}
+
+static void Init(rtems_task_argument arg)
+{
+  int sd;
+  int rv;
+
+  TEST_BEGIN();
+
+  rv = rtems_bsdnet_initialize_network();
+  rtems_test_assert(rv == 0);
+
+  sd = open_socket();
+
+  test_chain(sd);
+  test_batches(sd);
+
+  rv = close(sd);
+  rtems_test_assert(rv == 0);
+
+  TEST_END();
+
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+
+#define CONFIGURE_USE_IMFS_AS_BASE_FILESYSTEM
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 8
+
+#define CONFIGURE_MAXIMUM_TASKS 3
+
+#define CONFIGURE_MAXIMUM_SEMAPHORES 3
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
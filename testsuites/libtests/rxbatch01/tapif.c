@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+/*
+ * A software Ethernet interface.  The test feeds received frames into it,
+ * transmitted frames are discarded.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#define __INSIDE_RTEMS_BSD_TCPIP_STACK__ 1
+#define __BSD_VISIBLE 1
+
+#include <errno.h>
+#include <string.h>
+
+#include <rtems.h>
+#include <rtems/rtems_bsdnet.h>
+
+#include <sys/param.h>
+#include <sys/mbuf.h>
+#include <sys/socket.h>
+#include <sys/sockio.h>
+
+#include <net/if.h>
+#include <net/ethernet.h>
+#include <netinet/in.h>
+#include <netinet/if_ether.h>
+#include <netinet/in_systm.h>
+#include <netinet/ip.h>
+#include <netinet/udp.h>
+
+#include "tapif.h"
+
+/* 10.0.0.2 and 10.0.0.1 */
+#define TAPIF_SOURCE 0x0a000002
+
+#define TAPIF_DESTINATION 0x0a000001
+
+#define TAPIF_SOURCE_PORT 9
+
+#define TAPIF_UNKNOWN_TYPE 0x88b5
+
+typedef struct {
+  struct arpcom arpcom;
+  uint16_t ip_id;
+} tapif_control;
+
+static tapif_control tapif;
+
+static const uint8_t tapif_peer[ETHER_ADDR_LEN] =
+  { 0x02, 0x00, 0x00, 0x00, 0x00, 0x02 };
+
+/*
+ * Returns a frame like a driver hands it to ether_input(), the data starts
+ * after the ether header.  The IP header checksum is marked as checked by
+ * the hardware and the UDP checksum is not used.
+ */
+static struct mbuf *tapif_frame(
+  tapif_control *self,
+  uint16_t type,
+  uint16_t port,
+  uint32_t seq
+)
+{
+  struct ifnet *ifp = &self->arpcom.ac_if;
+  struct ether_header *eh;
+  struct ip *ip;
+  struct udphdr *uh;
+  struct mbuf *m;
+  int len = sizeof(*ip) + sizeof(*uh) + sizeof(seq);
+
+  MGETHDR(m, M_WAIT, MT_DATA);
+  m->m_pkthdr.rcvif = ifp;
+  m->m_pkthdr.csum_flags = CSUM_IP_CHECKED | CSUM_IP_VALID;
+
+  /* Align the IP header on a 32-bit boundary */
+  m->m_data += 2;
+
+  eh = mtod(m, struct ether_header *);
+  memcpy(eh->ether_dhost, self->arpcom.ac_enaddr, ETHER_ADDR_LEN);
+  memcpy(eh->ether_shost, tapif_peer, ETHER_ADDR_LEN);
+  eh->ether_type = htons(type);
+
+  ip = (struct ip *) (eh + 1);
+  memset(ip, 0, sizeof(*ip));
+  ip->ip_v = IPVERSION;
+  ip->ip_hl = sizeof(*ip) >> 2;
+  ip->ip_len = htons(len);
+  ip->ip_id = htons(self->ip_id++);
+  ip->ip_ttl = 64;
+  ip->ip_p = IPPROTO_UDP;
+  ip->ip_src.s_addr = htonl(TAPIF_SOURCE);
+  ip->ip_dst.s_addr = htonl(TAPIF_DESTINATION);
+
+  uh = (struct udphdr *) (ip + 1);
+  uh->uh_sport = htons(TAPIF_SOURCE_PORT);
+  uh->uh_dport = htons(port);
+  uh->uh_ulen = htons(sizeof(*uh) + sizeof(seq));
+  uh->uh_sum = 0;
+
+  seq = htonl(seq);
+  memcpy(uh + 1, &seq, sizeof(seq));
+
+  m->m_data += sizeof(*eh);
+  m->m_len = len;
+  m->m_pkthdr.len = len;
+
+  return m;
+}
+
+void tapif_receive(uint16_t port, uint32_t seq, int count, bool chain)
+{
+  tapif_control *self = &tapif;
+  struct ifnet *ifp = &self->arpcom.ac_if;
+  struct mbuf *head = NULL;
+  struct mbuf **tail = &head;
+  int i;
+
+  rtems_bsdnet_semaphore_obtain();
+
+  for (i = 0; i < count; ++i) {
+    struct mbuf *m = tapif_frame(self, ETHERTYPE_IP, port, seq + i);
+
+    if (chain) {
+      *tail = m;
+      tail = &m->m_nextpkt;
+    } else {
+      ether_input(ifp, mtod(m, struct ether_header *) - 1, m);
+    }
+  }
+
+  if (chain) {
+    ether_input_chain(ifp, head);
+  }
+
+  rtems_bsdnet_semaphore_release();
+}
+
+void tapif_receive_mixed(uint16_t port, uint32_t seq)
+{
+  tapif_control *self = &tapif;
+  struct mbuf *m;
+
+  rtems_bsdnet_semaphore_obtain();
+
+  m = tapif_frame(self, ETHERTYPE_IP, port, seq);
+  m->m_nextpkt = tapif_frame(self, TAPIF_UNKNOWN_TYPE, port, seq);
+  m->m_nextpkt->m_nextpkt = tapif_frame(self, ETHERTYPE_IP, port, seq + 1);
+  ether_input_chain(&self->arpcom.ac_if, m);
+
+  rtems_bsdnet_semaphore_release();
+}
+
+static void tapif_init(void *arg)
+{
+  tapif_control *self = arg;
+
+  self->arpcom.ac_if.if_flags |= IFF_RUNNING;
+}
+
+static void tapif_start(struct ifnet *ifp)
+{
+  struct mbuf *m;
+
+  while (true) {
+    IF_DEQUEUE(&ifp->if_snd, m);
+    if (m == NULL) {
+      break;
+    }
+
+    ++ifp->if_opackets;
+    m_freem(m);
+  }
+
+  ifp->if_flags &= ~IFF_OACTIVE;
+}
+
+static int tapif_ioctl(struct ifnet *ifp, ioctl_command_t cmd, caddr_t data)
+{
+  int error = 0;
+
+  switch (cmd) {
+    case SIOCGIFADDR:
+    case SIOCSIFADDR:
+      ether_ioctl(ifp, cmd, data);
+      break;
+    case SIOCSIFFLAGS:
+      if ((ifp->if_flags & IFF_UP) != 0) {
+        tapif_init(ifp->if_softc);
+      } else {
+        ifp->if_flags &= ~IFF_RUNNING;
+      }
+      break;
+    default:
+      error = EINVAL;
+      break;
+  }
+
+  return error;
+}
+
+int tapif_attach(struct rtems_bsdnet_ifconfig *config, int attaching)
+{
+  tapif_control *self = &tapif;
+  struct ifnet *ifp = &self->arpcom.ac_if;
+
+  if (!attaching) {
+    return 0;
+  }
+
+  if (config->hardware_address != NULL) {
+    memcpy(self->arpcom.ac_enaddr, config->hardware_address, ETHER_ADDR_LEN);
+  } else {
+    static const uint8_t mac[ETHER_ADDR_LEN] =
+      { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 };
+
+    memcpy(self->arpcom.ac_enaddr, mac, ETHER_ADDR_LEN);
+  }
+
+  ifp->if_softc = self;
+  ifp->if_name = "tap";
+  ifp->if_unit = 1;
+  ifp->if_mtu = config->mtu != 0 ? config->mtu : ETHERMTU;
+  ifp->if_init = tapif_init;
+  ifp->if_ioctl = tapif_ioctl;
+  ifp->if_start = tapif_start;
+  ifp->if_output = ether_output;
+  ifp->if_flags = IFF_BROADCAST | IFF_SIMPLEX;
+  ifp->if_snd.ifq_maxlen = ifqmaxlen;
+  if_attach(ifp);
+  ether_ifattach(ifp);
+
+  return 1;
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifndef TAPIF_H
+#define TAPIF_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <rtems/rtems_bsdnet.h>
+
+#define TAPIF_NAME "tap1"
+
+#define TAPIF_ADDRESS "10.0.0.1"
+
+#define TAPIF_NETMASK "255.255.255.0"
+
+int tapif_attach(struct rtems_bsdnet_ifconfig *config, int attaching);
+
+/*
+ * Receive count UDP datagrams to the port on the interface like a driver
+ * which took them from its receive ring.  The payload of a datagram is its
+ * 32-bit sequence number starting at seq.  With chain set the frames are
+ * passed with one ether_input_chain(), otherwise with one ether_input()
+ * each.
+ */
+void tapif_receive(uint16_t port, uint32_t seq, int count, bool chain);
+
+/*
+ * Receive a batch of three frames with one ether_input_chain(): a datagram
+ * with sequence number seq, a frame of an unknown type and a datagram with
+ * sequence number seq + 1.
+ */
+void tapif_receive_mixed(uint16_t port, uint32_t seq);
+
+#endif /* TAPIF_H */
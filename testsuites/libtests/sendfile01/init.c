@@ -0,0 +1,538 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems/rtems_bsdnet.h>
+#include <mghttpd/mongoose.h>
+
+const char rtems_test_name[] = "SENDFILE 1";
+
+#define PORT 5000
+
+#define HTTP_PORT "8080"
+
+#define FILE_SIZE (1024 * 1024)
+
+#define FILE_PATH "/www/large.bin"
+
+#define RX_SIZE (64 * 1024)
+
+#define CHUNK_SIZE (16 * 1024)
+
+#define WORKER_PRIORITY 110
+
+struct rtems_bsdnet_config rtems_bsdnet_config;
+
+typedef struct {
+  int fd;
+  size_t size;
+  size_t done;
+  bool keep;
+  rtems_id done_sema;
+  unsigned char buf[RX_SIZE];
+} receiver_context;
+
+static receiver_context receiver;
+
+static unsigned char chunk[CHUNK_SIZE];
+
+static int zero_copy_done_count;
+
+static unsigned char pattern(size_t i)
+{
+  return (unsigned char) (i ^ (i >> 8));
+}
+
+static void receiver_task(rtems_task_argument arg)
+{
+  receiver_context *ctx = (receiver_context *) arg;
+  rtems_status_code sc;
+
+  while (ctx->done < ctx->size) {
+    size_t n = ctx->size - ctx->done;
+    unsigned char *buf = ctx->buf;
+    ssize_t r;
+
+    if (ctx->keep) {
+      buf += ctx->done;
+    } else if (n > sizeof(ctx->buf)) {
+      n = sizeof(ctx->buf);
+    }
+
+    r = read(ctx->fd, buf, n);
+    rtems_test_assert(r > 0);
+
+    if (!ctx->keep) {
+      ssize_t i;
+
+      for (i = 0; i < r; ++i) {
+        rtems_test_assert(buf[i] == pattern(ctx->done + (size_t) i));
+      }
+    }
+
+    ctx->done += (size_t) r;
+  }
+
+  sc = rtems_semaphore_release(ctx->done_sema);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  rtems_task_delete(RTEMS_SELF);
+}
+
+static void start_receiver(int fd, size_t size, bool keep, rtems_id done_sema)
+{
+  receiver_context *ctx = &receiver;
+  rtems_status_code sc;
+  rtems_id id;
+
+  rtems_test_assert(!keep || size <= sizeof(ctx->buf));
+
+  ctx->fd = fd;
+  ctx->size = size;
+  ctx->done = 0;
+  ctx->keep = keep;
+  ctx->done_sema = done_sema;
+
+  sc = rtems_task_create(
+    rtems_build_name('R', 'E', 'C', 'V'),
+    WORKER_PRIORITY,
+    RTEMS_MINIMUM_STACK_SIZE,
+    RTEMS_DEFAULT_MODES,
+    RTEMS_DEFAULT_ATTRIBUTES,
+    &id
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_task_start(id, receiver_task, (rtems_task_argument) ctx);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static void wait_for_receiver(rtems_id done_sema)
+{
+  rtems_status_code sc;
+
+  sc = rtems_semaphore_obtain(done_sema, RTEMS_WAIT, RTEMS_NO_TIMEOUT);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static void init_addr(struct sockaddr_in *addr, int port)
+{
+  memset(addr, 0, sizeof(*addr));
+  addr->sin_len = sizeof(*addr);
+  addr->sin_family = AF_INET;
+  addr->sin_port = htons(port);
+  addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+}
+
+static void connect_pair(int port, int *client, int *server)
+{
+  struct sockaddr_in addr;
+  socklen_t addr_len = sizeof(addr);
+  int listener;
+  int rv;
+
+  init_addr(&addr, port);
+
+  listener = socket(PF_INET, SOCK_STREAM, 0);
+  rtems_test_assert(listener >= 0);
+
+  rv = bind(listener, (struct sockaddr *) &addr, sizeof(addr));
+  rtems_test_assert(rv == 0);
+
+  rv = listen(listener, 1);
+  rtems_test_assert(rv == 0);
+
+  *client = socket(PF_INET, SOCK_STREAM, 0);
+  rtems_test_assert(*client >= 0);
+
+  rv = connect(*client, (struct sockaddr *) &addr, sizeof(addr));
+  rtems_test_assert(rv == 0);
+
+  *server = accept(listener, (struct sockaddr *) &addr, &addr_len);
+  rtems_test_assert(*server >= 0);
+
+  rv = close(listener);
+  rtems_test_assert(rv == 0);
+}
+
+static void close_pair(int client, int server)
+{
+  int rv;
+
+  rv = close(client);
+  rtems_test_assert(rv == 0);
+
+  rv = close(server);
+  rtems_test_assert(rv == 0);
+}
+
+static void create_file(void)
+{
+  size_t done = 0;
+  int fd;
+  int rv;
+
+  rv = mkdir("/www", S_IRWXU | S_IRWXG | S_IRWXO);
+  rtems_test_assert(rv == 0);
+
+  fd = open(FILE_PATH, O_CREAT | O_WRONLY, S_IRWXU | S_IRWXG | S_IRWXO);
+  rtems_test_assert(fd >= 0);
+
+  while (done < FILE_SIZE) {
+    ssize_t n;
+    size_t i;
+
+    for (i = 0; i < sizeof(chunk); ++i) {
+      chunk[i] = pattern(done + i);
+    }
+
+    n = write(fd, chunk, sizeof(chunk));
+    rtems_test_assert(n == (ssize_t) sizeof(chunk));
+
+    done += sizeof(chunk);
+  }
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+}
+
+static void check_file_data(const unsigned char *buf, off_t offset, size_t n)
+{
+  size_t i;
+
+  for (i = 0; i < n; ++i) {
+    rtems_test_assert(buf[i] == pattern((size_t) offset + i));
+  }
+}
+
+static void test_sendfile(rtems_id done_sema)
+{
+  static const char hdr[] = "HEADER";
+  static const char trl[] = "TRAILER";
+  struct iovec hdr_iov;
+  struct iovec trl_iov;
+  struct sf_hdtr hdtr;
+  off_t offset = 100;
+  size_t nbytes = 50000;
+  size_t hdr_len = sizeof(hdr) - 1;
+  size_t trl_len = sizeof(trl) - 1;
+  size_t total = hdr_len + nbytes + trl_len;
+  off_t sbytes;
+  int client;
+  int server;
+  int fd;
+  int dgram;
+  int rv;
+
+  fd = open(FILE_PATH, O_RDONLY);
+  rtems_test_assert(fd >= 0);
+
+  connect_pair(PORT, &client, &server);
+
+  /* Headers, a file range and trailers */
+  hdr_iov.iov_base = RTEMS_DECONST(char *, hdr);
+  hdr_iov.iov_len = hdr_len;
+  trl_iov.iov_base = RTEMS_DECONST(char *, trl);
+  trl_iov.iov_len = trl_len;
+  hdtr.headers = &hdr_iov;
+  hdtr.hdr_cnt = 1;
+  hdtr.trailers = &trl_iov;
+  hdtr.trl_cnt = 1;
+
+  start_receiver(server, total, true, done_sema);
+  rv = sendfile(fd, client, offset, nbytes, &hdtr, &sbytes, 0);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(sbytes == (off_t) total);
+  wait_for_receiver(done_sema);
+
+  rtems_test_assert(memcmp(&receiver.buf[0], hdr, hdr_len) == 0);
+  check_file_data(&receiver.buf[hdr_len], offset, nbytes);
+  rtems_test_assert(memcmp(&receiver.buf[hdr_len + nbytes], trl, trl_len) == 0);
+
+  /* A byte count of zero sends up to the end of file */
+  offset = FILE_SIZE - 20000;
+  start_receiver(server, FILE_SIZE - (size_t) offset, true, done_sema);
+  rv = sendfile(fd, client, offset, 0, NULL, &sbytes, 0);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(sbytes == FILE_SIZE - offset);
+  wait_for_receiver(done_sema);
+
+  check_file_data(&receiver.buf[0], offset, FILE_SIZE - (size_t) offset);
+
+  /* Nothing to send beyond the end of file */
+  rv = sendfile(fd, client, FILE_SIZE, 0, NULL, &sbytes, 0);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(sbytes == 0);
+
+  /* Errors */
+  errno = 0;
+  rv = sendfile(fd, client, 0, 1, NULL, NULL, 1);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == EINVAL);
+
+  errno = 0;
+  rv = sendfile(-1, client, 0, 1, NULL, NULL, 0);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == EBADF);
+
+  errno = 0;
+  rv = sendfile(fd, fd, 0, 1, NULL, NULL, 0);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == ENOTSOCK);
+
+  dgram = socket(PF_INET, SOCK_DGRAM, 0);
+  rtems_test_assert(dgram >= 0);
+
+  errno = 0;
+  rv = sendfile(fd, dgram, 0, 1, NULL, NULL, 0);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == EINVAL);
+
+  rv = close(dgram);
+  rtems_test_assert(rv == 0);
+
+  close_pair(client, server);
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+}
+
+static void zero_copy_done(void *arg)
+{
+  rtems_test_assert(arg == &zero_copy_done_count);
+
+  ++zero_copy_done_count;
+}
+
+static void test_zero_copy(rtems_id done_sema)
+{
+  int client;
+  int server;
+  ssize_t n;
+  size_t i;
+  int retries;
+
+  for (i = 0; i < sizeof(chunk); ++i) {
+    chunk[i] = pattern(i);
+  }
+
+  connect_pair(PORT + 1, &client, &server);
+
+  start_receiver(server, sizeof(chunk), true, done_sema);
+  n = rtems_bsdnet_send_zero_copy(
+    client,
+    chunk,
+    sizeof(chunk),
+    0,
+    zero_copy_done,
+    &zero_copy_done_count
+  );
+  rtems_test_assert(n == (ssize_t) sizeof(chunk));
+  wait_for_receiver(done_sema);
+
+  check_file_data(&receiver.buf[0], 0, sizeof(chunk));
+
+  /* The done handler runs once the peer acknowledged all data */
+  for (retries = 0; zero_copy_done_count == 0 && retries < 100; ++retries) {
+    rtems_task_wake_after(1);
+  }
+
+  rtems_test_assert(zero_copy_done_count == 1);
+
+  /* The done handler is called even if nothing was sent */
+  n = rtems_bsdnet_send_zero_copy(
+    -1,
+    chunk,
+    sizeof(chunk),
+    0,
+    zero_copy_done,
+    &zero_copy_done_count
+  );
+  rtems_test_assert(n == -1);
+  rtems_test_assert(errno == EBADF);
+  rtems_test_assert(zero_copy_done_count == 2);
+
+  close_pair(client, server);
+}
+
+static void test_large_file(rtems_id done_sema)
+{
+  size_t done = 0;
+  off_t sbytes;
+  int client;
+  int server;
+  int fd;
+  int rv;
+
+  fd = open(FILE_PATH, O_RDONLY);
+  rtems_test_assert(fd >= 0);
+
+  connect_pair(PORT + 2, &client, &server);
+
+  start_receiver(server, FILE_SIZE, false, done_sema);
+
+  while (done < FILE_SIZE) {
+    ssize_t n;
+
+    n = read(fd, chunk, sizeof(chunk));
+    rtems_test_assert(n > 0);
+
+    n = write(client, chunk, (size_t) n);
+    rtems_test_assert(n > 0);
+
+    done += (size_t) n;
+  }
+
+  wait_for_receiver(done_sema);
+  rtems_test_assert(receiver.done == FILE_SIZE);
+
+  printf("read() and write(): %i KiB\n", FILE_SIZE / 1024);
+
+  start_receiver(server, FILE_SIZE, false, done_sema);
+
+  rv = sendfile(fd, client, 0, FILE_SIZE, NULL, &sbytes, 0);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(sbytes == FILE_SIZE);
+
+  wait_for_receiver(done_sema);
+  rtems_test_assert(receiver.done == FILE_SIZE);
+
+  printf("sendfile(): %i KiB\n", FILE_SIZE / 1024);
+
+  close_pair(client, server);
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+}
+
+static void test_mghttpd(void)
+{
+  static const char request[] = "GET /large.bin HTTP/1.0\r\n\r\n";
+  const struct mg_callbacks callbacks = {
+    NULL
+  };
+  const char *options[] = {
+    "listening_ports", HTTP_PORT,
+    "document_root", "/www",
+    "num_threads", "1",
+    "thread_stack_size", "16384",
+    NULL
+  };
+  struct mg_context *mg;
+  struct sockaddr_in addr;
+  size_t done = 0;
+  ssize_t n;
+  int fd;
+  int rv;
+
+  mg = mg_start(&callbacks, NULL, options);
+  rtems_test_assert(mg != NULL);
+
+  init_addr(&addr, atoi(HTTP_PORT));
+
+  fd = socket(PF_INET, SOCK_STREAM, 0);
+  rtems_test_assert(fd >= 0);
+
+  rv = connect(fd, (struct sockaddr *) &addr, sizeof(addr));
+  rtems_test_assert(rv == 0);
+
+  n = write(fd, request, sizeof(request) - 1);
+  rtems_test_assert(n == (ssize_t) sizeof(request) - 1);
+
+  while ((n = read(fd, chunk, sizeof(chunk))) > 0) {
+    done += (size_t) n;
+  }
+
+  rtems_test_assert(n == 0);
+  rtems_test_assert(done > FILE_SIZE);
+
+  printf("mghttpd GET: %i KiB\n", FILE_SIZE / 1024);
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+
+  mg_stop(mg);
+}
+
+static void test(void)
+{
+  rtems_status_code sc;
+  rtems_id done_sema;
+  int rv;
+
+  rv = rtems_bsdnet_initialize_network();
+  rtems_test_assert(rv == 0);
+
+  sc = rtems_semaphore_create(
+    rtems_build_name('D', 'O', 'N', 'E'),
+    0,
+    RTEMS_COUNTING_SEMAPHORE,
+    0,
+    &done_sema
+  );
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  create_file();
+
+  test_sendfile(done_sema);
+  test_zero_copy(done_sema);
+  test_large_file(done_sema);
+  test_mghttpd();
+
+  sc = rtems_semaphore_delete(done_sema);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+}
+
+static void Init(rtems_task_argument arg)
+{
+  TEST_BEGIN();
+
+  test();
+
+  TEST_END();
+
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+
+#define CONFIGURE_USE_IMFS_AS_BASE_FILESYSTEM
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 16
+
+#define CONFIGURE_UNLIMITED_OBJECTS
+
+#define CONFIGURE_UNIFIED_WORK_AREAS
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT_TASK_STACK_SIZE (16 * 1024)
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -57,10 +57,8 @@ void test_tarfs_load(void)
   test_cat( "/home/test_file", 0, 0 );
   
   /******************/
-#if 0
   printf( "========= /symlink =========\n" );
   test_cat( "/symlink", 0, 0 );
-#endif
 }
 
 rtems_task Init(
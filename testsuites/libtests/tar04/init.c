@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/stat.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <tar.h>
+#include <unistd.h>
+
+#include <rtems/imfs.h>
+#include <rtems/libcsupport.h>
+#include <rtems/untar.h>
+
+const char rtems_test_name[] = "TAR 4";
+
+#define DIRS 8
+
+#define FILES_PER_DIR 16
+
+#define FILE_SIZE 1024
+
+#define MTIME 1000000000
+
+#define IMAGE_SIZE \
+  (512 * (DIRS + DIRS * FILES_PER_DIR * (1 + FILE_SIZE / 512) + 11 + 2))
+
+static uint8_t image[IMAGE_SIZE];
+
+static size_t image_size;
+
+static size_t bench_size;
+
+static uint8_t buf[FILE_SIZE];
+
+static void add_header(const char *name, char type, size_t size,
+  const char *linkname)
+{
+  char *hdr = (char *) &image[image_size];
+  int sum;
+
+  rtems_test_assert(image_size + 512 <= sizeof(image));
+
+  memset(hdr, 0, 512);
+  strncpy(&hdr[0], name, 99);
+  sprintf(&hdr[100], "%07o", 0644);
+  sprintf(&hdr[108], "%07o", 0);
+  sprintf(&hdr[116], "%07o", 0);
+  sprintf(&hdr[124], "%011o", (unsigned) size);
+  sprintf(&hdr[136], "%011o", (unsigned) MTIME);
+  hdr[156] = type;
+  if (linkname != NULL) {
+    strncpy(&hdr[157], linkname, 99);
+  }
+  memcpy(&hdr[257], "ustar", 6);
+  memcpy(&hdr[263], "00", 2);
+
+  sum = _rtems_tar_header_checksum(hdr);
+  sprintf(&hdr[148], "%06o", sum);
+  hdr[155] = ' ';
+
+  image_size += 512;
+}
+
+static uint8_t pattern(int dir, int file, size_t i)
+{
+  return (uint8_t) (dir * 31 + file * 7 + i);
+}
+
+static void add_file(const char *name, int dir, int file)
+{
+  size_t i;
+
+  add_header(name, REGTYPE, FILE_SIZE, NULL);
+
+  for (i = 0; i < FILE_SIZE; ++i) {
+    image[image_size + i] = pattern(dir, file, i);
+  }
+
+  image_size += (FILE_SIZE + 511) & ~511;
+}
+
+static void add_end(void)
+{
+  rtems_test_assert(image_size + 1024 <= sizeof(image));
+
+  memset(&image[image_size], 0, 1024);
+  image_size += 1024;
+}
+
+/*
+ * Build an image with directories of files, a file in directories without
+ * an entry of their own, a file in the root directory after a file in a
+ * directory and a symbolic link.  The heap comparison uses the directories
+ * of files only, since Untar_FromMemory() cannot create files in directories
+ * without an entry.
+ */
+static void build_image(void)
+{
+  char name[32];
+  int dir;
+  int file;
+
+  for (dir = 0; dir < DIRS; ++dir) {
+    sprintf(name, "d%i/", dir);
+    add_header(name, DIRTYPE, 0, NULL);
+
+    for (file = 0; file < FILES_PER_DIR; ++file) {
+      sprintf(name, "d%i/f%i", dir, file);
+      add_file(name, dir, file);
+    }
+  }
+
+  bench_size = image_size;
+
+  add_file("x/y/z", DIRS, 0);
+  add_header("dir/", DIRTYPE, 0, NULL);
+  add_file("dir/x", DIRS, 1);
+  add_file("rootfile", DIRS, 2);
+  add_header("link", SYMTYPE, 0, "d0/f0");
+  add_end();
+}
+
+static void check_file(const char *path, int dir, int file)
+{
+  ssize_t n;
+  size_t i;
+  int fd;
+  int rv;
+
+  fd = open(path, O_RDONLY);
+  rtems_test_assert(fd >= 0);
+
+  n = read(fd, buf, sizeof(buf));
+  rtems_test_assert(n == FILE_SIZE);
+
+  for (i = 0; i < FILE_SIZE; ++i) {
+    rtems_test_assert(buf[i] == pattern(dir, file, i));
+  }
+
+  n = read(fd, buf, sizeof(buf));
+  rtems_test_assert(n == 0);
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+}
+
+static void check_dirs(const char *root)
+{
+  char path[64];
+  int dir;
+  int file;
+
+  for (dir = 0; dir < DIRS; ++dir) {
+    for (file = 0; file < FILES_PER_DIR; ++file) {
+      sprintf(path, "%s/d%i/f%i", root, dir, file);
+      check_file(path, dir, file);
+    }
+  }
+}
+
+static void test_tarfs_load(void)
+{
+  struct stat st;
+  int rv;
+
+  rv = mkdir("/tarfs", S_IRWXU);
+  rtems_test_assert(rv == 0);
+
+  /* The directory exists already */
+  rv = mkdir("/tarfs/d1", S_IRWXU);
+  rtems_test_assert(rv == 0);
+
+  rv = rtems_tarfs_load("/tarfs", image, image_size);
+  rtems_test_assert(rv == 0);
+
+  check_dirs("/tarfs");
+  check_file("/tarfs/x/y/z", DIRS, 0);
+  check_file("/tarfs/dir/x", DIRS, 1);
+  check_file("/tarfs/rootfile", DIRS, 2);
+  check_file("/tarfs/link", 0, 0);
+
+  /* The files refer to the image data */
+  rv = stat("/tarfs/d0/f0", &st);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(st.st_size == FILE_SIZE);
+  rtems_test_assert(st.st_mtime == MTIME);
+}
+
+/*
+ * Loads an image which conflicts with the nodes created by
+ * test_tarfs_load()
+ */
+static void load_conflict(const char *name, char type, const char *linkname)
+{
+  int rv;
+
+  image_size = 0;
+  add_header(name, type, 0, linkname);
+  add_end();
+
+  errno = 0;
+  rv = rtems_tarfs_load("/tarfs", image, image_size);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == EEXIST);
+}
+
+static void test_conflicts(void)
+{
+  /* A directory entry must not refer to a file */
+  load_conflict("d0/f0", DIRTYPE, NULL);
+
+  /* A symbolic link must not replace a node */
+  load_conflict("link", SYMTYPE, "d0/f1");
+}
+
+/*
+ * Returns the heap usage to load the image
+ */
+static size_t load(bool tarfs)
+{
+  const char *root = tarfs ? "/heap-tarfs" : "/heap-untar";
+  size_t free_space;
+  size_t heap;
+  int rv;
+
+  rv = mkdir(root, S_IRWXU);
+  rtems_test_assert(rv == 0);
+
+  free_space = malloc_free_space();
+
+  if (tarfs) {
+    rv = rtems_tarfs_load(root, image, bench_size);
+    rtems_test_assert(rv == 0);
+  } else {
+    rv = chdir(root);
+    rtems_test_assert(rv == 0);
+
+    rv = Untar_FromMemory(image, bench_size);
+    rtems_test_assert(rv == UNTAR_SUCCESSFUL);
+
+    rv = chdir("/");
+    rtems_test_assert(rv == 0);
+  }
+
+  heap = free_space - malloc_free_space();
+
+  check_dirs(root);
+
+  return heap;
+}
+
+static void test_heap_usage(void)
+{
+  size_t untar_heap;
+  size_t tarfs_heap;
+
+  untar_heap = load(false);
+  tarfs_heap = load(true);
+
+  /* The file data is not copied */
+  rtems_test_assert(tarfs_heap + DIRS * FILES_PER_DIR * FILE_SIZE <= untar_heap);
+}
+
+static void Init(rtems_task_argument arg)
+{
+  TEST_BEGIN();
+
+  build_image();
+  test_tarfs_load();
+  test_heap_usage();
+  test_conflicts();
+
+  TEST_END();
+
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_DOES_NOT_NEED_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+
+#define CONFIGURE_USE_IMFS_AS_BASE_FILESYSTEM
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 4
+
+#define CONFIGURE_MAXIMUM_TASKS 1
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
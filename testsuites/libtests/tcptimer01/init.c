@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/sysctl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netinet/tcp_var.h>
+#include <arpa/inet.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems/rtems_bsdnet.h>
+
+#include "lossyif.h"
+
+const char rtems_test_name[] = "TCPTIMER 1";
+
+#define MICROSECONDS_PER_TICK 250
+
+#define DELACK_USEC 2000
+
+#define REXMIT_MIN_USEC 5000
+
+#define TCP_PORT 7000
+
+#define USEC_TO_TICKS(usec) \
+  (((usec) + MICROSECONDS_PER_TICK - 1) / MICROSECONDS_PER_TICK)
+
+/* The TCP timers count in TCP_HZ units of 100 microseconds */
+#define MICROSECONDS_PER_TCP_TICK 100
+
+#define USEC_TO_TCP_TICKS(usec) \
+  (((usec) + MICROSECONDS_PER_TCP_TICK - 1) / MICROSECONDS_PER_TCP_TICK)
+
+static struct rtems_bsdnet_ifconfig lossyif_config = {
+  .name = LOSSYIF_NAME,
+  .attach = lossyif_attach,
+  .ip_address = LOSSYIF_ADDRESS,
+  .ip_netmask = LOSSYIF_NETMASK
+};
+
+struct rtems_bsdnet_config rtems_bsdnet_config = {
+  .ifconfig = &lossyif_config,
+  .tcp_delack_time = DELACK_USEC,
+  .tcp_rexmit_min = REXMIT_MIN_USEC
+};
+
+static void init_addr(struct sockaddr_in *addr, int port)
+{
+  memset(addr, 0, sizeof(*addr));
+  addr->sin_len = sizeof(*addr);
+  addr->sin_family = AF_INET;
+  addr->sin_port = htons(port);
+  addr->sin_addr.s_addr = inet_addr(LOSSYIF_ADDRESS);
+}
+
+static void connect_pair(int port, int *client, int *server)
+{
+  struct sockaddr_in addr;
+  socklen_t addr_len = sizeof(addr);
+  int nodelay = 1;
+  int listener;
+  int rv;
+
+  init_addr(&addr, port);
+
+  listener = socket(PF_INET, SOCK_STREAM, 0);
+  rtems_test_assert(listener >= 0);
+
+  rv = bind(listener, (struct sockaddr *) &addr, sizeof(addr));
+  rtems_test_assert(rv == 0);
+
+  rv = listen(listener, 1);
+  rtems_test_assert(rv == 0);
+
+  *client = socket(PF_INET, SOCK_STREAM, 0);
+  rtems_test_assert(*client >= 0);
+
+  rv = setsockopt(
+    *client,
+    IPPROTO_TCP,
+    TCP_NODELAY,
+    &nodelay,
+    sizeof(nodelay)
+  );
+  rtems_test_assert(rv == 0);
+
+  rv = connect(*client, (struct sockaddr *) &addr, sizeof(addr));
+  rtems_test_assert(rv == 0);
+
+  *server = accept(listener, (struct sockaddr *) &addr, &addr_len);
+  rtems_test_assert(*server >= 0);
+
+  rv = close(listener);
+  rtems_test_assert(rv == 0);
+}
+
+static void close_pair(int client, int server)
+{
+  int rv;
+
+  rv = close(client);
+  rtems_test_assert(rv == 0);
+
+  rv = close(server);
+  rtems_test_assert(rv == 0);
+}
+
+static int get_tcp_sysctl(int name)
+{
+  int mib[] = { CTL_NET, PF_INET, IPPROTO_TCP, name };
+  size_t len = sizeof(int);
+  int value = -1;
+  int rv;
+
+  rv = sysctl(mib, RTEMS_ARRAY_SIZE(mib), &value, &len, NULL, 0);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(len == sizeof(int));
+
+  return value;
+}
+
+static void set_tcp_sysctl(int name, int value)
+{
+  int mib[] = { CTL_NET, PF_INET, IPPROTO_TCP, name };
+  int rv;
+
+  rv = sysctl(mib, RTEMS_ARRAY_SIZE(mib), NULL, NULL, &value, sizeof(value));
+  rtems_test_assert(rv == 0);
+}
+
+static void transfer(int client, int server)
+{
+  char c = 'x';
+  ssize_t n;
+
+  n = write(client, &c, sizeof(c));
+  rtems_test_assert(n == (ssize_t) sizeof(c));
+
+  c = 0;
+  n = read(server, &c, sizeof(c));
+  rtems_test_assert(n == (ssize_t) sizeof(c));
+  rtems_test_assert(c == 'x');
+}
+
+/*
+ * Drop the first transmission of a one byte segment and return the time
+ * until the retransmission delivered it.  There is only one segment in
+ * flight, so no duplicate ACKs trigger a fast retransmit and only the
+ * retransmit timer recovers the loss.
+ */
+static uint64_t recovery_time(int port)
+{
+  lossyif_stats stats;
+  uint64_t start;
+  int client;
+  int server;
+  int i;
+
+  connect_pair(port, &client, &server);
+
+  /* Get a round-trip time estimate */
+  for (i = 0; i < 8; ++i) {
+    transfer(client, server);
+  }
+
+  lossyif_watch(port, 1);
+  start = rtems_clock_get_uptime_nanoseconds();
+  transfer(client, server);
+  start = rtems_clock_get_uptime_nanoseconds() - start;
+
+  lossyif_get_stats(&stats);
+  rtems_test_assert(stats.dropped == 1);
+
+  close_pair(client, server);
+
+  return start;
+}
+
+static void test_config(void)
+{
+  rtems_test_assert(
+    get_tcp_sysctl(TCPCTL_DELACKTIME) == USEC_TO_TCP_TICKS(DELACK_USEC)
+  );
+  rtems_test_assert(
+    get_tcp_sysctl(TCPCTL_REXMITMIN) == USEC_TO_TCP_TICKS(REXMIT_MIN_USEC)
+  );
+}
+
+static void test_delayed_ack(void)
+{
+  lossyif_stats stats;
+  uint64_t delay;
+  int client;
+  int server;
+
+  connect_pair(TCP_PORT, &client, &server);
+
+  lossyif_watch(TCP_PORT, 0);
+  transfer(client, server);
+
+  /* Wait for the delayed ACK */
+  rtems_task_wake_after(USEC_TO_TICKS(4 * DELACK_USEC));
+
+  lossyif_get_stats(&stats);
+  rtems_test_assert(stats.dropped == 0);
+  rtems_test_assert(stats.ack_ns > stats.data_ns);
+
+  delay = stats.ack_ns - stats.data_ns;
+  printf("delayed ACK\n");
+  rtems_test_assert(
+    delay >= (uint64_t) (DELACK_USEC - MICROSECONDS_PER_TICK) * 1000
+  );
+  rtems_test_assert(delay < (uint64_t) 4 * DELACK_USEC * 1000);
+
+  close_pair(client, server);
+}
+
+static void test_retransmit(void)
+{
+  int rexmit_min = get_tcp_sysctl(TCPCTL_REXMITMIN);
+  uint64_t fine;
+  uint64_t coarse;
+
+  fine = recovery_time(TCP_PORT + 1);
+  printf("recovery with %i us minimum RTO\n", REXMIT_MIN_USEC);
+
+  /* The minimum RTO of the former slow timeout based timers */
+  set_tcp_sysctl(TCPCTL_REXMITMIN, USEC_TO_TCP_TICKS(1000000));
+
+  coarse = recovery_time(TCP_PORT + 2);
+  printf("recovery with 1000000 us minimum RTO\n");
+
+  set_tcp_sysctl(TCPCTL_REXMITMIN, rexmit_min);
+
+  rtems_test_assert(fine >= (uint64_t) REXMIT_MIN_USEC * 1000);
+  rtems_test_assert(coarse >= (uint64_t) 1000000 * 1000);
+  rtems_test_assert(4 * fine < coarse);
+}
+
+static void Init(rtems_task_argument arg)
+{
+  int rv;
+
+  TEST_BEGIN();
+
+  rv = rtems_bsdnet_initialize_network();
+  rtems_test_assert(rv == 0);
+
+  test_config();
+  test_delayed_ack();
+  test_retransmit();
+
+  TEST_END();
+
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+
+#define CONFIGURE_MICROSECONDS_PER_TICK MICROSECONDS_PER_TICK
+
+#define CONFIGURE_USE_IMFS_AS_BASE_FILESYSTEM
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 8
+
+#define CONFIGURE_MAXIMUM_TASKS 3
+
+#define CONFIGURE_MAXIMUM_SEMAPHORES 3
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
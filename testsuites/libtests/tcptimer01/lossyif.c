@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+/*
+ * A loopback interface which drops selected TCP data segments.  It has no
+ * link-level broadcast, so packets to the local address of the interface
+ * are sent through the interface and not through lo0.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#define __INSIDE_RTEMS_BSD_TCPIP_STACK__ 1
+#define __BSD_VISIBLE 1
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <rtems.h>
+#include <rtems/rtems_bsdnet.h>
+
+#include <sys/param.h>
+#include <sys/mbuf.h>
+#include <sys/socket.h>
+#include <sys/sockio.h>
+
+#include <net/if.h>
+#include <net/if_types.h>
+#include <netinet/in.h>
+#include <netinet/in_systm.h>
+#include <netinet/ip.h>
+#include <netinet/tcp.h>
+
+#include "lossyif.h"
+
+typedef struct {
+  struct ifnet ifnet;
+  uint16_t port;
+  int drop_count;
+  lossyif_stats stats;
+} lossyif_control;
+
+static lossyif_control lossyif;
+
+static bool lossyif_drop(lossyif_control *self, struct mbuf *m)
+{
+  const struct ip *ip;
+  const struct tcphdr *th;
+  int hlen;
+  int len;
+
+  if (m->m_len < (int) sizeof(*ip)) {
+    return false;
+  }
+
+  ip = mtod(m, const struct ip *);
+  hlen = ip->ip_hl << 2;
+  if (ip->ip_p != IPPROTO_TCP || m->m_len < hlen + (int) sizeof(*th)) {
+    return false;
+  }
+
+  th = (const struct tcphdr *) ((const char *) ip + hlen);
+  len = ntohs(ip->ip_len) - hlen - (th->th_off << 2);
+
+  if (len > 0 && ntohs(th->th_dport) == self->port) {
+    self->stats.data_ns = rtems_clock_get_uptime_nanoseconds();
+    self->stats.ack_ns = 0;
+
+    if (self->drop_count > 0) {
+      --self->drop_count;
+      ++self->stats.dropped;
+
+      return true;
+    }
+  } else if (
+    len == 0
+      && th->th_flags == TH_ACK
+      && ntohs(th->th_sport) == self->port
+      && self->stats.ack_ns == 0
+  ) {
+    self->stats.ack_ns = rtems_clock_get_uptime_nanoseconds();
+  }
+
+  return false;
+}
+
+static int lossyif_output(
+  struct ifnet *ifp,
+  struct mbuf *m,
+  struct sockaddr *dst,
+  struct rtentry *rt
+)
+{
+  lossyif_control *self = ifp->if_softc;
+
+  if (dst->sa_family == AF_INET && lossyif_drop(self, m)) {
+    m_freem(m);
+
+    return 0;
+  }
+
+  return looutput(ifp, m, dst, rt);
+}
+
+static int lossyif_ioctl(struct ifnet *ifp, ioctl_command_t cmd, caddr_t data)
+{
+  switch (cmd) {
+    case SIOCSIFADDR:
+      ifp->if_flags |= IFF_UP | IFF_RUNNING;
+      return 0;
+    case SIOCSIFFLAGS:
+      return 0;
+    default:
+      return EINVAL;
+  }
+}
+
+int lossyif_attach(struct rtems_bsdnet_ifconfig *config, int attaching)
+{
+  lossyif_control *self = &lossyif;
+  struct ifnet *ifp = &self->ifnet;
+
+  if (!attaching) {
+    return 0;
+  }
+
+  ifp->if_softc = self;
+  ifp->if_name = "lossy";
+  ifp->if_unit = 1;
+  ifp->if_mtu = config->mtu != 0 ? config->mtu : 1500;
+  ifp->if_flags = IFF_SIMPLEX;
+  ifp->if_type = IFT_OTHER;
+  ifp->if_output = lossyif_output;
+  ifp->if_ioctl = lossyif_ioctl;
+  ifp->if_snd.ifq_maxlen = ifqmaxlen;
+  if_attach(ifp);
+
+  return 1;
+}
+
+void lossyif_watch(uint16_t port, int drop_count)
+{
+  lossyif_control *self = &lossyif;
+
+  rtems_bsdnet_semaphore_obtain();
+  self->port = port;
+  self->drop_count = drop_count;
+  memset(&self->stats, 0, sizeof(self->stats));
+  rtems_bsdnet_semaphore_release();
+}
+
+void lossyif_get_stats(lossyif_stats *stats)
+{
+  lossyif_control *self = &lossyif;
+
+  rtems_bsdnet_semaphore_obtain();
+  *stats = self->stats;
+  rtems_bsdnet_semaphore_release();
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifndef LOSSYIF_H
+#define LOSSYIF_H
+
+#include <stdint.h>
+
+#include <rtems/rtems_bsdnet.h>
+
+#define LOSSYIF_NAME "lossy1"
+
+#define LOSSYIF_ADDRESS "10.0.0.1"
+
+#define LOSSYIF_NETMASK "255.255.255.0"
+
+/*
+ * Observations of the TCP segments sent to and from the watched port.
+ */
+typedef struct {
+  /* Data segments to the port which were dropped */
+  int dropped;
+
+  /* Uptime of the last data segment to the port */
+  uint64_t data_ns;
+
+  /* Uptime of the first pure ACK from the port after this data segment */
+  uint64_t ack_ns;
+} lossyif_stats;
+
+int lossyif_attach(struct rtems_bsdnet_ifconfig *config, int attaching);
+
+/*
+ * Watch the TCP segments to and from the port and drop the next drop_count
+ * data segments to it.  Resets the statistics.
+ */
+void lossyif_watch(uint16_t port, int drop_count);
+
+void lossyif_get_stats(lossyif_stats *stats);
+
+#endif /* LOSSYIF_H */
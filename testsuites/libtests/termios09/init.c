@@ -0,0 +1,383 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/ioctl.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <rtems/libio.h>
+#include <rtems/termiostypes.h>
+
+const char rtems_test_name[] = "TERMIOS 9";
+
+#define DEVICE_NAME "/dev/loop"
+
+#define RAW_INPUT_SIZE 1024
+
+#define RAW_OUTPUT_SIZE 512
+
+#define CHUNK_SIZE 500
+
+#define CHUNK_COUNT 16
+
+#define OVERFLOW_SIZE (RAW_INPUT_SIZE + 476)
+
+/*
+ * The loopback device feeds each transmitted span back into the receive path
+ * of the same terminal one clock tick later.  The timer service routine acts
+ * as a DMA completion interrupt for both directions.
+ */
+typedef struct {
+  struct rtems_termios_tty *tty;
+  rtems_id timer;
+  const char *buf;
+  size_t len;
+} loopback_device;
+
+static loopback_device loopback;
+
+static char tx_buf[OVERFLOW_SIZE];
+
+static char rx_buf[OVERFLOW_SIZE];
+
+static rtems_timer_service_routine loopback_isr(rtems_id timer, void *arg)
+{
+  loopback_device *dev = arg;
+  const char *buf = dev->buf;
+  size_t len = dev->len;
+
+  dev->len = 0;
+  rtems_termios_enqueue_raw_characters(dev->tty, buf, (int) len);
+  rtems_termios_dequeue_characters(dev->tty, (int) len);
+}
+
+static ssize_t loopback_write(int minor, const char *buf, size_t len)
+{
+  loopback_device *dev = &loopback;
+
+  if (len > 0) {
+    rtems_status_code sc;
+
+    rtems_test_assert(dev->len == 0);
+    dev->buf = buf;
+    dev->len = len;
+
+    sc = rtems_timer_fire_after(dev->timer, 1, loopback_isr, dev);
+    rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+  }
+
+  return 0;
+}
+
+static rtems_device_driver loopback_initialize(
+  rtems_device_major_number major,
+  rtems_device_minor_number minor,
+  void *arg
+)
+{
+  rtems_status_code sc;
+
+  rtems_termios_initialize();
+
+  sc = rtems_termios_bufsize(256, RAW_INPUT_SIZE, RAW_OUTPUT_SIZE);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_io_register_name(DEVICE_NAME, major, 0);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  sc = rtems_timer_create(rtems_build_name('L', 'O', 'O', 'P'), &loopback.timer);
+  rtems_test_assert(sc == RTEMS_SUCCESSFUL);
+
+  return RTEMS_SUCCESSFUL;
+}
+
+static rtems_device_driver loopback_open(
+  rtems_device_major_number major,
+  rtems_device_minor_number minor,
+  void *arg
+)
+{
+  static const rtems_termios_callbacks callbacks = {
+    .write = loopback_write,
+    .outputUsesInterrupts = TERMIOS_IRQ_DRIVEN
+  };
+  rtems_libio_open_close_args_t *args = arg;
+  rtems_status_code sc;
+
+  sc = rtems_termios_open(major, minor, arg, &callbacks);
+  if (sc == RTEMS_SUCCESSFUL) {
+    loopback.tty = args->iop->data1;
+  }
+
+  return sc;
+}
+
+static rtems_device_driver loopback_close(
+  rtems_device_major_number major,
+  rtems_device_minor_number minor,
+  void *arg
+)
+{
+  return rtems_termios_close(arg);
+}
+
+static rtems_device_driver loopback_read(
+  rtems_device_major_number major,
+  rtems_device_minor_number minor,
+  void *arg
+)
+{
+  return rtems_termios_read(arg);
+}
+
+static rtems_device_driver loopback_write_entry(
+  rtems_device_major_number major,
+  rtems_device_minor_number minor,
+  void *arg
+)
+{
+  return rtems_termios_write(arg);
+}
+
+static rtems_device_driver loopback_control(
+  rtems_device_major_number major,
+  rtems_device_minor_number minor,
+  void *arg
+)
+{
+  return rtems_termios_ioctl(arg);
+}
+
+static void set_mode(int fd, bool canonical, cc_t vmin, cc_t vtime)
+{
+  struct termios term;
+  int rv;
+
+  rv = tcgetattr(fd, &term);
+  rtems_test_assert(rv == 0);
+
+  term.c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL
+    | IXON | IXOFF);
+  term.c_oflag &= ~OPOST;
+  term.c_lflag &= ~(ECHO | ECHONL | ICANON | ISIG | IEXTEN);
+  term.c_cflag &= ~CRTSCTS;
+
+  if (canonical) {
+    term.c_lflag |= ICANON;
+  }
+
+  term.c_cc[VMIN] = vmin;
+  term.c_cc[VTIME] = vtime;
+
+  rv = tcsetattr(fd, TCSANOW, &term);
+  rtems_test_assert(rv == 0);
+}
+
+static void get_statistics(int fd, rtems_termios_statistics *stats)
+{
+  int rv;
+
+  rv = ioctl(fd, RTEMS_IO_GET_STATISTICS, stats);
+  rtems_test_assert(rv == 0);
+}
+
+static void print_statistics(const rtems_termios_statistics *stats)
+{
+  printf(
+    "rx characters %" PRIu64 ", dropped %" PRIu64
+      ", tx characters %" PRIu64 "\n",
+    stats->rx_characters,
+    stats->rx_dropped,
+    stats->tx_characters
+  );
+}
+
+static void fill_pattern(size_t n, unsigned seed)
+{
+  size_t i;
+
+  for (i = 0; i < n; ++i) {
+    tx_buf[i] = (char) (seed + i * 7);
+  }
+}
+
+static void read_all(int fd, size_t n)
+{
+  size_t done = 0;
+
+  memset(rx_buf, 0, sizeof(rx_buf));
+
+  while (done < n) {
+    ssize_t m = read(fd, &rx_buf[done], n - done);
+
+    rtems_test_assert(m > 0);
+    done += (size_t) m;
+  }
+
+  rtems_test_assert(memcmp(rx_buf, tx_buf, n) == 0);
+}
+
+static void test_raw_loopback(int fd)
+{
+  rtems_termios_statistics before;
+  rtems_termios_statistics after;
+  uint64_t total = CHUNK_SIZE * CHUNK_COUNT;
+  int i;
+
+  puts("raw mode loopback");
+
+  set_mode(fd, false, 1, 0);
+  get_statistics(fd, &before);
+
+  for (i = 0; i < CHUNK_COUNT; ++i) {
+    ssize_t n;
+
+    fill_pattern(CHUNK_SIZE, (unsigned) i);
+
+    n = write(fd, tx_buf, CHUNK_SIZE);
+    rtems_test_assert(n == CHUNK_SIZE);
+
+    read_all(fd, CHUNK_SIZE);
+  }
+
+  get_statistics(fd, &after);
+  print_statistics(&after);
+
+  rtems_test_assert(after.rx_characters - before.rx_characters == total);
+  rtems_test_assert(after.tx_characters - before.tx_characters == total);
+  rtems_test_assert(after.rx_dropped == before.rx_dropped);
+
+  /* The spans are much larger than single characters */
+  rtems_test_assert(after.rx_bursts - before.rx_bursts < total / 32);
+  rtems_test_assert(after.tx_bursts - before.tx_bursts < total / 32);
+  rtems_test_assert(after.rx_raw_reads - before.rx_raw_reads >= CHUNK_COUNT);
+  rtems_test_assert(after.rx_raw_reads - before.rx_raw_reads < total / 32);
+}
+
+static void test_raw_overflow(int fd)
+{
+  rtems_termios_statistics before;
+  rtems_termios_statistics after;
+  ssize_t n;
+  int rv;
+
+  puts("raw mode overflow");
+
+  set_mode(fd, false, 0, 0);
+  get_statistics(fd, &before);
+
+  fill_pattern(OVERFLOW_SIZE, 0x55);
+
+  n = write(fd, tx_buf, OVERFLOW_SIZE);
+  rtems_test_assert(n == OVERFLOW_SIZE);
+
+  /* The last span is received before the transmitter becomes idle */
+  rv = tcdrain(fd);
+  rtems_test_assert(rv == 0);
+
+  /* One slot of the ring buffer stays empty */
+  memset(rx_buf, 0, sizeof(rx_buf));
+  n = read(fd, rx_buf, sizeof(rx_buf));
+  rtems_test_assert(n == RAW_INPUT_SIZE - 1);
+  rtems_test_assert(memcmp(rx_buf, tx_buf, RAW_INPUT_SIZE - 1) == 0);
+
+  n = read(fd, rx_buf, sizeof(rx_buf));
+  rtems_test_assert(n == 0);
+
+  get_statistics(fd, &after);
+  print_statistics(&after);
+
+  rtems_test_assert(
+    after.rx_dropped - before.rx_dropped
+      == OVERFLOW_SIZE - (RAW_INPUT_SIZE - 1)
+  );
+}
+
+static void test_canonical(int fd)
+{
+  rtems_termios_statistics before;
+  rtems_termios_statistics after;
+  char buf[8];
+  ssize_t n;
+
+  puts("canonical mode loopback");
+
+  set_mode(fd, true, 1, 0);
+  get_statistics(fd, &before);
+
+  n = write(fd, "abc\nde\n", 7);
+  rtems_test_assert(n == 7);
+
+  n = read(fd, buf, sizeof(buf));
+  rtems_test_assert(n == 4);
+  rtems_test_assert(memcmp(buf, "abc\n", 4) == 0);
+
+  n = read(fd, buf, sizeof(buf));
+  rtems_test_assert(n == 3);
+  rtems_test_assert(memcmp(buf, "de\n", 3) == 0);
+
+  get_statistics(fd, &after);
+  print_statistics(&after);
+
+  rtems_test_assert(after.rx_raw_reads == before.rx_raw_reads);
+}
+
+static void Init(rtems_task_argument arg)
+{
+  int fd;
+  int rv;
+
+  TEST_BEGIN();
+
+  fd = open(DEVICE_NAME, O_RDWR);
+  rtems_test_assert(fd >= 0);
+
+  test_raw_loopback(fd);
+  test_raw_overflow(fd);
+  test_canonical(fd);
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+
+  TEST_END();
+
+  rtems_test_exit(0);
+}
+
+#define LOOPBACK_DRIVER_TABLE_ENTRY \
+  { loopback_initialize, loopback_open, loopback_close, \
+    loopback_read, loopback_write_entry, loopback_control }
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+#define CONFIGURE_APPLICATION_EXTRA_DRIVERS LOOPBACK_DRIVER_TABLE_ENTRY
+
+#define CONFIGURE_NUMBER_OF_TERMIOS_PORTS 2
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 4
+
+#define CONFIGURE_MAXIMUM_TASKS 1
+
+#define CONFIGURE_MAXIMUM_TIMERS 1
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
@@ -0,0 +1,400 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include "config.h"
+#endif
+
+#include "tmacros.h"
+
+#include <sys/stat.h>
+#include <aio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <sched.h>
+#include <signal.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems/posix/aio_misc.h>
+
+const char rtems_test_name[] = "PSXAIO 4";
+
+#define FILE_NAME "/file"
+
+#define CHUNK_SIZE 16
+
+#define CHUNK_COUNT 4
+
+#define SIGNAL_VALUE 0x1234
+
+static char buffers[CHUNK_COUNT + 1][CHUNK_SIZE];
+
+static struct aiocb aiocbs[CHUNK_COUNT + 1];
+
+static struct aiocb *list[CHUNK_COUNT + 1];
+
+static void init_request(
+  int i,
+  int fd,
+  int opcode,
+  off_t offset,
+  size_t nbytes
+)
+{
+  struct aiocb *aiocbp = &aiocbs[i];
+
+  memset(aiocbp, 0, sizeof(*aiocbp));
+  aiocbp->aio_fildes = fd;
+  aiocbp->aio_offset = offset;
+  aiocbp->aio_buf = &buffers[i][0];
+  aiocbp->aio_nbytes = nbytes;
+  aiocbp->aio_lio_opcode = opcode;
+  list[i] = aiocbp;
+}
+
+static void init_requests(int fd, int opcode)
+{
+  int i;
+
+  for (i = 0; i < CHUNK_COUNT; i++) {
+    init_request(i, fd, opcode, i * CHUNK_SIZE, CHUNK_SIZE);
+  }
+}
+
+static void check_request(int i, int eno, ssize_t n)
+{
+  rtems_test_assert(aio_error(&aiocbs[i]) == eno);
+  rtems_test_assert(aio_return(&aiocbs[i]) == n);
+}
+
+static void wait_for_request(int i)
+{
+  while (aio_error(&aiocbs[i]) == EINPROGRESS) {
+    sched_yield();
+  }
+}
+
+static void test_wait(int fd)
+{
+  int rv;
+  int i;
+
+  /* The adjacent writes are served by one pwritev() call */
+  init_requests(fd, LIO_WRITE);
+  for (i = 0; i < CHUNK_COUNT; i++) {
+    memset(&buffers[i][0], 'a' + i, CHUNK_SIZE);
+  }
+
+  rv = lio_listio(LIO_WAIT, list, CHUNK_COUNT, NULL);
+  rtems_test_assert(rv == 0);
+
+  for (i = 0; i < CHUNK_COUNT; i++) {
+    check_request(i, 0, CHUNK_SIZE);
+  }
+
+  /* The reads are served in reverse order of the list entries */
+  init_requests(fd, LIO_READ);
+  for (i = 0; i < CHUNK_COUNT; i++) {
+    memset(&buffers[i][0], 0, CHUNK_SIZE);
+    list[i] = &aiocbs[CHUNK_COUNT - 1 - i];
+  }
+
+  rv = lio_listio(LIO_WAIT, list, CHUNK_COUNT, NULL);
+  rtems_test_assert(rv == 0);
+
+  for (i = 0; i < CHUNK_COUNT; i++) {
+    char expected[CHUNK_SIZE];
+
+    check_request(i, 0, CHUNK_SIZE);
+    memset(expected, 'a' + i, CHUNK_SIZE);
+    rtems_test_assert(memcmp(&buffers[i][0], expected, CHUNK_SIZE) == 0);
+  }
+}
+
+static void test_short_read(int fd)
+{
+  int rv;
+
+  /* The file ends in the middle of the third request */
+  rv = ftruncate(fd, 2 * CHUNK_SIZE + CHUNK_SIZE / 2);
+  rtems_test_assert(rv == 0);
+
+  init_requests(fd, LIO_READ);
+
+  rv = lio_listio(LIO_WAIT, list, CHUNK_COUNT, NULL);
+  rtems_test_assert(rv == 0);
+
+  check_request(0, 0, CHUNK_SIZE);
+  check_request(1, 0, CHUNK_SIZE);
+  check_request(2, 0, CHUNK_SIZE / 2);
+  check_request(3, 0, 0);
+
+  rv = ftruncate(fd, CHUNK_COUNT * CHUNK_SIZE);
+  rtems_test_assert(rv == 0);
+}
+
+static void test_nop(int fd)
+{
+  int rv;
+
+  init_requests(fd, LIO_READ);
+  aiocbs[1].aio_lio_opcode = LIO_NOP;
+  list[2] = NULL;
+
+  rv = lio_listio(LIO_WAIT, list, CHUNK_COUNT, NULL);
+  rtems_test_assert(rv == 0);
+
+  check_request(0, 0, CHUNK_SIZE);
+  check_request(3, 0, CHUNK_SIZE);
+
+  rv = lio_listio(LIO_WAIT, list, 0, NULL);
+  rtems_test_assert(rv == 0);
+}
+
+static void test_errors(int fd)
+{
+  int rv;
+
+  errno = 0;
+  rv = lio_listio(LIO_WAIT + LIO_NOWAIT + 1, list, 1, NULL);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == EINVAL);
+
+  errno = 0;
+  rv = lio_listio(LIO_WAIT, list, AIO_LISTIO_MAX + 1, NULL);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == EINVAL);
+
+  errno = 0;
+  rv = lio_listio(LIO_WAIT, list, -1, NULL);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == EINVAL);
+
+  /* The valid requests are performed despite the invalid ones */
+  init_requests(fd, LIO_READ);
+  aiocbs[1].aio_offset = -1;
+  aiocbs[2].aio_reqprio = AIO_PRIO_DELTA_MAX + 1;
+  aiocbs[3].aio_fildes = -1;
+
+  errno = 0;
+  rv = lio_listio(LIO_WAIT, list, CHUNK_COUNT, NULL);
+  rtems_test_assert(rv == -1);
+  rtems_test_assert(errno == EIO);
+
+  check_request(0, 0, CHUNK_SIZE);
+  check_request(1, EINVAL, -1);
+  check_request(2, EINVAL, -1);
+  check_request(3, EBADF, -1);
+}
+
+static void test_nowait_signal(int fd)
+{
+  struct sigevent sig;
+  struct timespec timeout;
+  siginfo_t info;
+  sigset_t set;
+  int rv;
+  int i;
+
+  sigemptyset(&set);
+  sigaddset(&set, SIGUSR1);
+  rv = pthread_sigmask(SIG_BLOCK, &set, NULL);
+  rtems_test_assert(rv == 0);
+
+  memset(&sig, 0, sizeof(sig));
+  sig.sigev_notify = SIGEV_SIGNAL;
+  sig.sigev_signo = SIGUSR1;
+  sig.sigev_value.sival_int = SIGNAL_VALUE;
+
+  init_requests(fd, LIO_READ);
+
+  rv = lio_listio(LIO_NOWAIT, list, CHUNK_COUNT, &sig);
+  rtems_test_assert(rv == 0);
+
+  timeout.tv_sec = 1;
+  timeout.tv_nsec = 0;
+  rv = sigtimedwait(&set, &info, &timeout);
+  rtems_test_assert(rv == SIGUSR1);
+  rtems_test_assert(info.si_value.sival_int == SIGNAL_VALUE);
+
+  for (i = 0; i < CHUNK_COUNT; i++) {
+    check_request(i, 0, CHUNK_SIZE);
+  }
+
+  /* An empty list is complete immediately */
+  rv = lio_listio(LIO_NOWAIT, list, 0, &sig);
+  rtems_test_assert(rv == 0);
+
+  rv = sigtimedwait(&set, &info, &timeout);
+  rtems_test_assert(rv == SIGUSR1);
+
+  /* The notification of an individual request */
+  init_request(0, fd, LIO_READ, 0, CHUNK_SIZE);
+  aiocbs[0].aio_sigevent = sig;
+
+  rv = aio_read(&aiocbs[0]);
+  rtems_test_assert(rv == 0);
+
+  rv = sigtimedwait(&set, &info, &timeout);
+  rtems_test_assert(rv == SIGUSR1);
+  check_request(0, 0, CHUNK_SIZE);
+
+  rv = pthread_sigmask(SIG_UNBLOCK, &set, NULL);
+  rtems_test_assert(rv == 0);
+}
+
+static void test_fd_order(int fd)
+{
+  char expected[CHUNK_SIZE];
+  int rv;
+
+  /* Requests of equal priority on one file descriptor keep their order */
+  init_request(0, fd, LIO_WRITE, CHUNK_SIZE, CHUNK_SIZE);
+  memset(&buffers[0][0], 'x', CHUNK_SIZE);
+  init_request(1, fd, LIO_READ, CHUNK_SIZE, CHUNK_SIZE);
+  memset(&buffers[1][0], 0, CHUNK_SIZE);
+  init_request(2, fd, LIO_WRITE, CHUNK_SIZE, CHUNK_SIZE);
+  memset(&buffers[2][0], 'y', CHUNK_SIZE);
+
+  rv = aio_write(&aiocbs[0]);
+  rtems_test_assert(rv == 0);
+
+  rv = aio_read(&aiocbs[1]);
+  rtems_test_assert(rv == 0);
+
+  rv = aio_write(&aiocbs[2]);
+  rtems_test_assert(rv == 0);
+
+  wait_for_request(0);
+  wait_for_request(1);
+  wait_for_request(2);
+
+  check_request(0, 0, CHUNK_SIZE);
+  check_request(1, 0, CHUNK_SIZE);
+  check_request(2, 0, CHUNK_SIZE);
+
+  memset(expected, 'x', CHUNK_SIZE);
+  rtems_test_assert(memcmp(&buffers[1][0], expected, CHUNK_SIZE) == 0);
+}
+
+static void check_data(int fd, off_t offset, char c)
+{
+  char expected[CHUNK_SIZE];
+  char data[CHUNK_SIZE];
+  ssize_t n;
+
+  n = pread(fd, data, CHUNK_SIZE, offset);
+  rtems_test_assert(n == CHUNK_SIZE);
+
+  memset(expected, c, CHUNK_SIZE);
+  rtems_test_assert(memcmp(data, expected, CHUNK_SIZE) == 0);
+}
+
+static void test_append(int fd)
+{
+  struct stat st;
+  off_t size;
+  int append_fd;
+  int rv;
+
+  rv = fstat(fd, &st);
+  rtems_test_assert(rv == 0);
+  size = st.st_size;
+
+  append_fd = open(FILE_NAME, O_WRONLY | O_APPEND);
+  rtems_test_assert(append_fd >= 0);
+
+  /* Writes to a file opened with O_APPEND ignore the request offset */
+  init_request(0, append_fd, LIO_WRITE, 0, CHUNK_SIZE);
+  memset(&buffers[0][0], 'u', CHUNK_SIZE);
+
+  rv = aio_write(&aiocbs[0]);
+  rtems_test_assert(rv == 0);
+
+  wait_for_request(0);
+  check_request(0, 0, CHUNK_SIZE);
+
+  /* Adjacent requests are appended in the order of the list */
+  init_request(0, append_fd, LIO_WRITE, 0, CHUNK_SIZE);
+  memset(&buffers[0][0], 'v', CHUNK_SIZE);
+  init_request(1, append_fd, LIO_WRITE, CHUNK_SIZE, CHUNK_SIZE);
+  memset(&buffers[1][0], 'w', CHUNK_SIZE);
+
+  rv = lio_listio(LIO_WAIT, list, 2, NULL);
+  rtems_test_assert(rv == 0);
+
+  check_request(0, 0, CHUNK_SIZE);
+  check_request(1, 0, CHUNK_SIZE);
+
+  rv = fstat(fd, &st);
+  rtems_test_assert(rv == 0);
+  rtems_test_assert(st.st_size == size + 3 * CHUNK_SIZE);
+
+  check_data(fd, 0, 'a');
+  check_data(fd, size, 'u');
+  check_data(fd, size + CHUNK_SIZE, 'v');
+  check_data(fd, size + 2 * CHUNK_SIZE, 'w');
+
+  rv = close(append_fd);
+  rtems_test_assert(rv == 0);
+}
+
+static void Init(rtems_task_argument arg)
+{
+  int fd;
+  int rv;
+
+  TEST_BEGIN();
+
+  rv = rtems_aio_init_with_max_threads(0);
+  rtems_test_assert(rv == EINVAL);
+
+  rv = rtems_aio_init_with_max_threads(2);
+  rtems_test_assert(rv == 0);
+
+  fd = open(FILE_NAME, O_CREAT | O_RDWR, S_IRWXU);
+  rtems_test_assert(fd >= 0);
+
+  test_wait(fd);
+  test_short_read(fd);
+  test_nop(fd);
+  test_errors(fd);
+  test_nowait_signal(fd);
+  test_fd_order(fd);
+  test_append(fd);
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+
+  TEST_END();
+
+  rtems_test_exit(0);
+}
+
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+
+#define CONFIGURE_USE_IMFS_AS_BASE_FILESYSTEM
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 5
+
+#define CONFIGURE_MAXIMUM_TASKS 1
+
+#define CONFIGURE_MAXIMUM_POSIX_THREADS 2
+#define CONFIGURE_MAXIMUM_POSIX_MUTEXES 4
+#define CONFIGURE_MAXIMUM_POSIX_CONDITION_VARIABLES 4
+
+#define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
+
+#define CONFIGURE_RTEMS_INIT_TASKS_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
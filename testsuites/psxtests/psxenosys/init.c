@@ -55,10 +55,6 @@ void *POSIX_Init(
 
   TEST_BEGIN();
 
-  puts( "lio_listio -- ENOSYS" );
-  sc = lio_listio( 0, NULL, 0, NULL );
-  check_enosys( sc );
-
   puts( "aio_suspend -- ENOSYS" );
   sc = aio_suspend( NULL, 0, NULL );
   check_enosys( sc );
@@ -18,7 +18,12 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <errno.h>
+#include <limits.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/uio.h>
 #include <rtems/libcsupport.h>
+#include <rtems/pipe.h>
 #include <rtems/malloc.h>
 
 const char rtems_test_name[] = "PSXPIPE 1";
@@ -26,6 +31,187 @@ const char rtems_test_name[] = "PSXPIPE 1";
 /* forward declarations to avoid warnings */
 rtems_task Init(rtems_task_argument ignored);
 
+#define LARGE_PIPE_SIZE (4 * PIPE_BUF)
+
+static char out_buf[LARGE_PIPE_SIZE];
+
+static char in_buf[LARGE_PIPE_SIZE];
+
+static void write_and_read(int fd[2], size_t to_write, size_t to_read)
+{
+  ssize_t n;
+
+  n = write( fd[1], out_buf, to_write );
+  rtems_test_assert( n == (ssize_t) to_write );
+
+  n = read( fd[0], in_buf, to_read );
+  rtems_test_assert( n == (ssize_t) to_read );
+}
+
+static void test_pipe_size(void)
+{
+  int fd[2] = {0,0};
+  int status = 0;
+  int size = 0;
+  size_t i;
+  ssize_t n;
+
+  for ( i = 0; i < sizeof(out_buf); ++i )
+    out_buf[i] = (char) i;
+
+  puts( "Init - create pipe -- OK" );
+  status = pipe( fd );
+  rtems_test_assert( status == 0 );
+
+  puts( "Init - get pipe size -- OK" );
+  status = ioctl( fd[0], RTEMS_IO_GET_PIPE_SIZE, &size );
+  rtems_test_assert( status == 0 );
+  rtems_test_assert( size == PIPE_BUF );
+
+  puts( "Init - set pipe size too small -- expect EINVAL" );
+  size = PIPE_BUF - 1;
+  status = ioctl( fd[1], RTEMS_IO_SET_PIPE_SIZE, &size );
+  rtems_test_assert( status == -1 );
+  rtems_test_assert( errno == EINVAL );
+
+  puts( "Init - set pipe size too large -- expect EINVAL" );
+  size = PIPE_MAX_SIZE + 1;
+  status = ioctl( fd[1], RTEMS_IO_SET_PIPE_SIZE, &size );
+  rtems_test_assert( status == -1 );
+  rtems_test_assert( errno == EINVAL );
+
+  /* Leave wrapped around data in the pipe */
+  write_and_read( fd, 3000, 2000 );
+  n = write( fd[1], &out_buf[3000], 2000 );
+  rtems_test_assert( n == 2000 );
+
+  puts( "Init - set pipe size with data in pipe -- OK" );
+  size = LARGE_PIPE_SIZE;
+  status = ioctl( fd[1], RTEMS_IO_SET_PIPE_SIZE, &size );
+  rtems_test_assert( status == 0 );
+
+  status = ioctl( fd[0], RTEMS_IO_GET_PIPE_SIZE, &size );
+  rtems_test_assert( status == 0 );
+  rtems_test_assert( size == LARGE_PIPE_SIZE );
+
+  puts( "Init - set pipe size below data length -- expect EBUSY" );
+  size = PIPE_BUF;
+  status = ioctl( fd[1], RTEMS_IO_SET_PIPE_SIZE, &size );
+  rtems_test_assert( status == -1 );
+  rtems_test_assert( errno == EBUSY );
+
+  n = read( fd[0], in_buf, sizeof(in_buf) );
+  rtems_test_assert( n == 3000 );
+  rtems_test_assert( memcmp( in_buf, &out_buf[2000], 3000 ) == 0 );
+
+  puts( "Init - write more than the default pipe size at once -- OK" );
+  write_and_read( fd, LARGE_PIPE_SIZE, LARGE_PIPE_SIZE );
+  rtems_test_assert( memcmp( in_buf, out_buf, LARGE_PIPE_SIZE ) == 0 );
+
+  status = close( fd[0] );
+  status |= close( fd[1] );
+  rtems_test_assert( status == 0 );
+}
+
+typedef struct {
+  int fd;
+  rtems_id master;
+  ssize_t n;
+  int error;
+} blocked_read_context;
+
+static void blocked_reader(rtems_task_argument arg)
+{
+  blocked_read_context *ctx = (blocked_read_context *) arg;
+  rtems_status_code sc;
+  char c;
+
+  ctx->n = read( ctx->fd, &c, 1 );
+  ctx->error = errno;
+
+  sc = rtems_event_transient_send( ctx->master );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+
+  rtems_task_delete( RTEMS_SELF );
+  rtems_test_assert( 0 );
+}
+
+static void test_close_blocked_read(void)
+{
+  blocked_read_context ctx;
+  rtems_status_code sc;
+  rtems_id id;
+  int fd[2] = {0,0};
+  int status = 0;
+
+  puts( "Init - create pipe -- OK" );
+  status = pipe( fd );
+  rtems_test_assert( status == 0 );
+
+  ctx.fd = fd[0];
+  ctx.master = rtems_task_self();
+  ctx.n = 0;
+  ctx.error = 0;
+
+  sc = rtems_task_create(
+    rtems_build_name( 'R', 'E', 'A', 'D' ),
+    RTEMS_MAXIMUM_PRIORITY - 1,
+    RTEMS_MINIMUM_STACK_SIZE,
+    RTEMS_DEFAULT_MODES,
+    RTEMS_DEFAULT_ATTRIBUTES,
+    &id
+  );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+
+  sc = rtems_task_start( id, blocked_reader, (rtems_task_argument) &ctx );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+
+  /* Let the reader block on the empty pipe */
+  sc = rtems_task_wake_after( 2 );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+
+  puts( "Init - close pipe with blocked reader -- OK" );
+  status = close( fd[0] );
+  rtems_test_assert( status == 0 );
+
+  sc = rtems_event_transient_receive( RTEMS_WAIT, RTEMS_NO_TIMEOUT );
+  rtems_test_assert( sc == RTEMS_SUCCESSFUL );
+  rtems_test_assert( ctx.n == -1 );
+  rtems_test_assert( ctx.error == EBADF );
+
+  status = close( fd[1] );
+  rtems_test_assert( status == 0 );
+}
+
+static void test_positional_io(void)
+{
+  struct iovec iov;
+  int fd[2] = {0,0};
+  int status = 0;
+  ssize_t n;
+
+  puts( "Init - create pipe -- OK" );
+  status = pipe( fd );
+  rtems_test_assert( status == 0 );
+
+  iov.iov_base = in_buf;
+  iov.iov_len = 1;
+
+  puts( "Init - pwritev on pipe -- expect ESPIPE" );
+  n = pwritev( fd[1], &iov, 1, 0 );
+  rtems_test_assert( n == -1 );
+  rtems_test_assert( errno == ESPIPE );
+
+  puts( "Init - preadv on pipe -- expect ESPIPE" );
+  n = preadv( fd[0], &iov, 1, 0 );
+  rtems_test_assert( n == -1 );
+  rtems_test_assert( errno == ESPIPE );
+
+  status = close( fd[0] );
+  status |= close( fd[1] );
+  rtems_test_assert( status == 0 );
+}
+
 rtems_task Init(
   rtems_task_argument ignored
 )
@@ -58,6 +244,12 @@ rtems_task Init(
   status |= close( fd[1] );
   rtems_test_assert( status == 0 );
 
+  test_pipe_size();
+
+  test_close_blocked_read();
+
+  test_positional_io();
+
   opaque = rtems_heap_greedy_allocate( NULL, 0 );
 
   /* case where mkfifo fails */
@@ -105,7 +297,7 @@ rtems_task Init(
 #define CONFIGURE_USE_IMFS_AS_BASE_FILESYSTEM
 #define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 5
 
-#define CONFIGURE_MAXIMUM_TASKS 1
+#define CONFIGURE_MAXIMUM_TASKS 2
 #define CONFIGURE_INITIAL_EXTENSIONS RTEMS_TEST_INITIAL_EXTENSION
 
 #define CONFIGURE_RTEMS_INIT_TASKS_TABLE
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <timesys.h>
+#include <rtems/timerdrv.h>
+#include "test_support.h"
+
+#include <sys/stat.h>
+#include <aio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rtems/posix/aio_misc.h>
+
+const char rtems_test_name[] = "PSXTMAIO 01";
+
+#define FILE_NAME "/file"
+
+#define REQUEST_COUNT 32
+
+#define REQUEST_SIZE 64
+
+#define FILE_SIZE (2 * REQUEST_COUNT * REQUEST_SIZE)
+
+/* forward declarations to avoid warnings */
+void *POSIX_Init(void *argument);
+
+static char buffers[REQUEST_COUNT][REQUEST_SIZE];
+
+static struct aiocb aiocbs[REQUEST_COUNT];
+
+static struct aiocb *list[REQUEST_COUNT];
+
+/*
+ * Adjacent requests can be served by one preadv() or pwritev() call, the
+ * scattered requests leave a gap of one request size between them.
+ */
+static void init_requests(int fd, int opcode, off_t stride)
+{
+  int i;
+
+  for (i = 0; i < REQUEST_COUNT; i++) {
+    struct aiocb *aiocbp = &aiocbs[i];
+
+    memset(aiocbp, 0, sizeof(*aiocbp));
+    aiocbp->aio_fildes = fd;
+    aiocbp->aio_offset = i * stride;
+    aiocbp->aio_buf = &buffers[i][0];
+    aiocbp->aio_nbytes = REQUEST_SIZE;
+    aiocbp->aio_lio_opcode = opcode;
+    list[i] = aiocbp;
+  }
+}
+
+static void check_requests(void)
+{
+  int i;
+
+  for (i = 0; i < REQUEST_COUNT; i++) {
+    rtems_test_assert(aio_error(&aiocbs[i]) == 0);
+    rtems_test_assert(aio_return(&aiocbs[i]) == REQUEST_SIZE);
+  }
+}
+
+static void wait_for_requests(void)
+{
+  int i;
+
+  for (i = 0; i < REQUEST_COUNT; i++) {
+    while (aio_error(&aiocbs[i]) == EINPROGRESS) {
+      sched_yield();
+    }
+  }
+}
+
+static void benchmark_aio_read(int fd)
+{
+  benchmark_timer_t end_time;
+  int rv;
+  int i;
+  int j;
+
+  init_requests(fd, LIO_READ, REQUEST_SIZE);
+
+  benchmark_timer_initialize();
+  for (i = 0; i < OPERATION_COUNT; i++) {
+    for (j = 0; j < REQUEST_COUNT; j++) {
+      rv = aio_read(&aiocbs[j]);
+      rtems_test_assert(rv == 0);
+    }
+
+    wait_for_requests();
+  }
+  end_time = benchmark_timer_read();
+  check_requests();
+
+  put_time(
+    "aio_read: 32 adjacent requests of 64 bytes",
+    end_time,
+    OPERATION_COUNT,
+    0,
+    0
+  );
+}
+
+static void benchmark_lio_listio(
+  const char *message,
+  int fd,
+  int opcode,
+  off_t stride
+)
+{
+  benchmark_timer_t end_time;
+  int rv;
+  int i;
+
+  init_requests(fd, opcode, stride);
+
+  benchmark_timer_initialize();
+  for (i = 0; i < OPERATION_COUNT; i++) {
+    rv = lio_listio(LIO_WAIT, list, REQUEST_COUNT, NULL);
+    rtems_test_assert(rv == 0);
+  }
+  end_time = benchmark_timer_read();
+  check_requests();
+
+  put_time(
+    message,
+    end_time,
+    OPERATION_COUNT,
+    0,
+    0
+  );
+}
+
+static int create_file(void)
+{
+  char buf[FILE_SIZE];
+  ssize_t n;
+  int fd;
+
+  memset(buf, 'x', sizeof(buf));
+
+  fd = open(FILE_NAME, O_CREAT | O_RDWR, S_IRWXU);
+  rtems_test_assert(fd >= 0);
+
+  n = write(fd, buf, sizeof(buf));
+  rtems_test_assert(n == (ssize_t) sizeof(buf));
+
+  return fd;
+}
+
+void *POSIX_Init(void *argument)
+{
+  int fd;
+  int rv;
+
+  TEST_BEGIN();
+
+  rv = rtems_aio_init();
+  rtems_test_assert(rv == 0);
+
+  fd = create_file();
+  benchmark_aio_read(fd);
+  benchmark_lio_listio(
+    "lio_listio: 32 adjacent reads of 64 bytes",
+    fd,
+    LIO_READ,
+    REQUEST_SIZE
+  );
+  benchmark_lio_listio(
+    "lio_listio: 32 scattered reads of 64 bytes",
+    fd,
+    LIO_READ,
+    2 * REQUEST_SIZE
+  );
+  benchmark_lio_listio(
+    "lio_listio: 32 adjacent writes of 64 bytes",
+    fd,
+    LIO_WRITE,
+    REQUEST_SIZE
+  );
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+
+  TEST_END();
+
+  rtems_test_exit(0);
+}
+
+/* configuration information */
+
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_TIMER_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+
+#define CONFIGURE_USE_IMFS_AS_BASE_FILESYSTEM
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 4
+
+#define CONFIGURE_MAXIMUM_POSIX_THREADS (1 + AIO_MAX_THREADS)
+#define CONFIGURE_MAXIMUM_POSIX_MUTEXES 2
+#define CONFIGURE_MAXIMUM_POSIX_CONDITION_VARIABLES 2
+#define CONFIGURE_POSIX_INIT_THREAD_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
+/* end of file */
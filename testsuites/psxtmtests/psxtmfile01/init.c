@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <timesys.h>
+#include <rtems/timerdrv.h>
+#include "test_support.h"
+
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+const char rtems_test_name[] = "PSXTMFILE 01";
+
+#define FILE_NAME "/file"
+
+/* forward declarations to avoid warnings */
+void *POSIX_Init(void *argument);
+
+static int fds[OPERATION_COUNT];
+
+static void benchmark_open_close(void)
+{
+  benchmark_timer_t end_time;
+  int rv;
+  int i;
+
+  benchmark_timer_initialize();
+  for (i = 0; i < OPERATION_COUNT; i++) {
+    fds[i] = open(FILE_NAME, O_RDONLY);
+  }
+  end_time = benchmark_timer_read();
+
+  for (i = 0; i < OPERATION_COUNT; i++) {
+    rtems_test_assert(fds[i] >= 0);
+  }
+
+  put_time(
+    "open: allocate a file descriptor",
+    end_time,
+    OPERATION_COUNT,
+    0,
+    0
+  );
+
+  benchmark_timer_initialize();
+  for (i = 0; i < OPERATION_COUNT; i++) {
+    rv = close(fds[i]);
+  }
+  end_time = benchmark_timer_read();
+  rtems_test_assert(rv == 0);
+
+  put_time(
+    "close: free a file descriptor",
+    end_time,
+    OPERATION_COUNT,
+    0,
+    0
+  );
+}
+
+static void benchmark_open_close_storm(void)
+{
+  benchmark_timer_t end_time;
+  int rv = 0;
+  int i;
+
+  benchmark_timer_initialize();
+  for (i = 0; i < OPERATION_COUNT; i++) {
+    rv |= close(open(FILE_NAME, O_RDONLY));
+  }
+  end_time = benchmark_timer_read();
+  rtems_test_assert(rv == 0);
+
+  put_time(
+    "open/close: storm on one file",
+    end_time,
+    OPERATION_COUNT,
+    0,
+    0
+  );
+}
+
+static void benchmark_lseek_read(void)
+{
+  benchmark_timer_t end_time;
+  ssize_t n = 0;
+  off_t off = 0;
+  char c;
+  int fd;
+  int rv;
+  int i;
+
+  fd = open(FILE_NAME, O_RDONLY);
+  rtems_test_assert(fd >= 0);
+
+  benchmark_timer_initialize();
+  for (i = 0; i < OPERATION_COUNT; i++) {
+    off |= lseek(fd, 0, SEEK_SET);
+  }
+  end_time = benchmark_timer_read();
+  rtems_test_assert(off == 0);
+
+  put_time(
+    "lseek: with file descriptor reference",
+    end_time,
+    OPERATION_COUNT,
+    0,
+    0
+  );
+
+  benchmark_timer_initialize();
+  for (i = 0; i < OPERATION_COUNT; i++) {
+    n += read(fd, &c, sizeof(c));
+  }
+  end_time = benchmark_timer_read();
+  rtems_test_assert(n == OPERATION_COUNT);
+
+  put_time(
+    "read: one byte with file descriptor reference",
+    end_time,
+    OPERATION_COUNT,
+    0,
+    0
+  );
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+}
+
+static void create_file(void)
+{
+  char buf[OPERATION_COUNT];
+  ssize_t n;
+  int fd;
+  int rv;
+
+  memset(buf, 'x', sizeof(buf));
+
+  fd = open(FILE_NAME, O_CREAT | O_WRONLY, S_IRWXU);
+  rtems_test_assert(fd >= 0);
+
+  n = write(fd, buf, sizeof(buf));
+  rtems_test_assert(n == (ssize_t) sizeof(buf));
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+}
+
+void *POSIX_Init(void *argument)
+{
+  TEST_BEGIN();
+
+  create_file();
+  benchmark_open_close();
+  benchmark_open_close_storm();
+  benchmark_lseek_read();
+
+  TEST_END();
+
+  rtems_test_exit(0);
+}
+
+/* configuration information */
+
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_TIMER_DRIVER
+
+#define CONFIGURE_USE_IMFS_AS_BASE_FILESYSTEM
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS (OPERATION_COUNT + 4)
+
+#define CONFIGURE_MAXIMUM_POSIX_THREADS     1
+#define CONFIGURE_POSIX_INIT_THREAD_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
+/* end of file */
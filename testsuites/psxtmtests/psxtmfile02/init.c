@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <timesys.h>
+#include <rtems/timerdrv.h>
+#include "test_support.h"
+
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+const char rtems_test_name[] = "PSXTMFILE 02";
+
+#define FILE_NAME "/file"
+
+#define SEGMENT_COUNT 16
+
+#define SEGMENT_SIZE 64
+
+#define FILE_SIZE (2 * SEGMENT_COUNT * SEGMENT_SIZE)
+
+/* forward declarations to avoid warnings */
+void *POSIX_Init(void *argument);
+
+static char segments[SEGMENT_COUNT][SEGMENT_SIZE];
+
+static struct iovec iov[SEGMENT_COUNT];
+
+static void init_iov(void)
+{
+  int i;
+
+  for (i = 0; i < SEGMENT_COUNT; i++) {
+    iov[i].iov_base = &segments[i][0];
+    iov[i].iov_len = SEGMENT_SIZE;
+  }
+}
+
+static void benchmark_read(int fd)
+{
+  benchmark_timer_t end_time;
+  ssize_t n = 0;
+  off_t off = 0;
+  int i;
+
+  benchmark_timer_initialize();
+  for (i = 0; i < OPERATION_COUNT; i++) {
+    off |= lseek(fd, SEGMENT_SIZE, SEEK_SET);
+    n += readv(fd, iov, SEGMENT_COUNT);
+  }
+  end_time = benchmark_timer_read();
+  rtems_test_assert(off == SEGMENT_SIZE);
+  rtems_test_assert(n == OPERATION_COUNT * SEGMENT_COUNT * SEGMENT_SIZE);
+
+  put_time(
+    "lseek/readv: 16 segments",
+    end_time,
+    OPERATION_COUNT,
+    0,
+    0
+  );
+
+  n = 0;
+  benchmark_timer_initialize();
+  for (i = 0; i < OPERATION_COUNT; i++) {
+    n += preadv(fd, iov, SEGMENT_COUNT, SEGMENT_SIZE);
+  }
+  end_time = benchmark_timer_read();
+  rtems_test_assert(n == OPERATION_COUNT * SEGMENT_COUNT * SEGMENT_SIZE);
+
+  /* The file offset stays at the end of the last readv() */
+  off = lseek(fd, 0, SEEK_CUR);
+  rtems_test_assert(off == (SEGMENT_COUNT + 1) * SEGMENT_SIZE);
+
+  put_time(
+    "preadv: 16 segments",
+    end_time,
+    OPERATION_COUNT,
+    0,
+    0
+  );
+}
+
+static void benchmark_write(int fd)
+{
+  benchmark_timer_t end_time;
+  ssize_t n = 0;
+  off_t off = 0;
+  int i;
+
+  benchmark_timer_initialize();
+  for (i = 0; i < OPERATION_COUNT; i++) {
+    off |= lseek(fd, SEGMENT_SIZE, SEEK_SET);
+    n += writev(fd, iov, SEGMENT_COUNT);
+  }
+  end_time = benchmark_timer_read();
+  rtems_test_assert(off == SEGMENT_SIZE);
+  rtems_test_assert(n == OPERATION_COUNT * SEGMENT_COUNT * SEGMENT_SIZE);
+
+  put_time(
+    "lseek/writev: 16 segments",
+    end_time,
+    OPERATION_COUNT,
+    0,
+    0
+  );
+
+  n = 0;
+  benchmark_timer_initialize();
+  for (i = 0; i < OPERATION_COUNT; i++) {
+    n += pwritev(fd, iov, SEGMENT_COUNT, SEGMENT_SIZE);
+  }
+  end_time = benchmark_timer_read();
+  rtems_test_assert(n == OPERATION_COUNT * SEGMENT_COUNT * SEGMENT_SIZE);
+
+  off = lseek(fd, 0, SEEK_CUR);
+  rtems_test_assert(off == (SEGMENT_COUNT + 1) * SEGMENT_SIZE);
+
+  put_time(
+    "pwritev: 16 segments",
+    end_time,
+    OPERATION_COUNT,
+    0,
+    0
+  );
+}
+
+static int create_file(void)
+{
+  char buf[FILE_SIZE];
+  ssize_t n;
+  int fd;
+
+  memset(buf, 'x', sizeof(buf));
+
+  fd = open(FILE_NAME, O_CREAT | O_RDWR, S_IRWXU);
+  rtems_test_assert(fd >= 0);
+
+  n = write(fd, buf, sizeof(buf));
+  rtems_test_assert(n == (ssize_t) sizeof(buf));
+
+  return fd;
+}
+
+void *POSIX_Init(void *argument)
+{
+  int fd;
+  int rv;
+
+  TEST_BEGIN();
+
+  init_iov();
+  fd = create_file();
+  benchmark_read(fd);
+  benchmark_write(fd);
+
+  rv = close(fd);
+  rtems_test_assert(rv == 0);
+
+  TEST_END();
+
+  rtems_test_exit(0);
+}
+
+/* configuration information */
+
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_TIMER_DRIVER
+
+#define CONFIGURE_USE_IMFS_AS_BASE_FILESYSTEM
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 4
+
+#define CONFIGURE_MAXIMUM_POSIX_THREADS     1
+#define CONFIGURE_POSIX_INIT_THREAD_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
+/* end of file */
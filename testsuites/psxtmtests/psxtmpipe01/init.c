@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <timesys.h>
+#include <rtems/timerdrv.h>
+#include "test_support.h"
+
+#include <sys/ioctl.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <string.h>
+#include <unistd.h>
+
+const char rtems_test_name[] = "PSXTMPIPE 01";
+
+#define TRANSFER_SIZE (256 * 1024)
+
+#define MAX_MESSAGE_SIZE 4096
+
+/* forward declarations to avoid warnings */
+void *POSIX_Init(void *argument);
+
+static int fds[2];
+
+static sem_t start;
+
+static size_t message_size;
+
+static char write_buffer[MAX_MESSAGE_SIZE];
+
+static char read_buffer[MAX_MESSAGE_SIZE];
+
+/*
+ * The writer runs at the priority of the reader.  It transfers the data of
+ * each benchmark in messages of the selected size.
+ */
+static void *writer(void *arg)
+{
+  while (true) {
+    size_t i;
+    int rv;
+
+    rv = sem_wait(&start);
+    rtems_test_assert(rv == 0);
+
+    for (i = 0; i < TRANSFER_SIZE / message_size; i++) {
+      ssize_t n = write(fds[1], write_buffer, message_size);
+      rtems_test_assert(n == (ssize_t) message_size);
+    }
+  }
+
+  return NULL;
+}
+
+static void set_pipe_size(int size)
+{
+  int rv;
+
+  rv = ioctl(fds[1], RTEMS_IO_SET_PIPE_SIZE, &size);
+  rtems_test_assert(rv == 0);
+}
+
+static void benchmark_pipe(const char *message, int pipe_size, size_t size)
+{
+  benchmark_timer_t end_time;
+  size_t done = 0;
+  int rv;
+
+  set_pipe_size(pipe_size);
+  message_size = size;
+
+  benchmark_timer_initialize();
+  rv = sem_post(&start);
+  rtems_test_assert(rv == 0);
+
+  while (done < TRANSFER_SIZE) {
+    ssize_t n = read(fds[0], read_buffer, size);
+    rtems_test_assert(n > 0);
+    done += (size_t) n;
+  }
+  end_time = benchmark_timer_read();
+
+  rtems_test_assert(done == TRANSFER_SIZE);
+
+  put_time(
+    message,
+    end_time,
+    TRANSFER_SIZE / size,
+    0,
+    0
+  );
+}
+
+void *POSIX_Init(void *argument)
+{
+  pthread_t thread;
+  int rv;
+
+  TEST_BEGIN();
+
+  memset(write_buffer, 'x', sizeof(write_buffer));
+
+  rv = pipe(fds);
+  rtems_test_assert(rv == 0);
+
+  rv = sem_init(&start, 0, 0);
+  rtems_test_assert(rv == 0);
+
+  rv = pthread_create(&thread, NULL, writer, NULL);
+  rtems_test_assert(rv == 0);
+
+  benchmark_pipe("pipe: 16 byte messages, 4 KiB buffer", 4096, 16);
+  benchmark_pipe("pipe: 256 byte messages, 4 KiB buffer", 4096, 256);
+  benchmark_pipe("pipe: 4096 byte messages, 4 KiB buffer", 4096, 4096);
+  benchmark_pipe("pipe: 16 byte messages, 64 KiB buffer", 65536, 16);
+  benchmark_pipe("pipe: 256 byte messages, 64 KiB buffer", 65536, 256);
+  benchmark_pipe("pipe: 4096 byte messages, 64 KiB buffer", 65536, 4096);
+
+  TEST_END();
+
+  rtems_test_exit(0);
+}
+
+/* configuration information */
+
+#define CONFIGURE_APPLICATION_NEEDS_CONSOLE_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_TIMER_DRIVER
+#define CONFIGURE_APPLICATION_NEEDS_CLOCK_DRIVER
+
+#define CONFIGURE_USE_IMFS_AS_BASE_FILESYSTEM
+
+#define CONFIGURE_LIBIO_MAXIMUM_FILE_DESCRIPTORS 5
+
+#define CONFIGURE_PIPES_ENABLED
+#define CONFIGURE_MAXIMUM_PIPES 1
+
+#define CONFIGURE_MAXIMUM_POSIX_THREADS 2
+#define CONFIGURE_MAXIMUM_POSIX_SEMAPHORES 1
+#define CONFIGURE_POSIX_INIT_THREAD_TABLE
+
+#define CONFIGURE_INIT
+
+#include <rtems/confdefs.h>
+/* end of file */
@@ -0,0 +1,510 @@
+/*
+ * Copyright (c) 2026 agent <agent@local>
+ *
+ * The license and distribution terms for this file may be
+ * found in the file LICENSE in this distribution or at
+ * http://www.rtems.org/license/LICENSE.
+ */
+
+/*
+ * rtems-mkcromfs.c
+ *
+ * Create a Compressed ROM File System (CROMFS) image from a directory tree.
+ * The image format is defined in cpukit/libfs/src/cromfs/cromfs-image.h.
+ *
+ * syntax:  rtems-mkcromfs [-b block_size] [-l level] [-v] <directory> <image>
+ *
+ *    -b    block size in bytes, a power of two, the default is 4096
+ *    -l    zlib compression level from 1 to 9, the default is 9
+ *    -v    verbose
+ *
+ * Directories, regular files and symbolic links are added to the image, all
+ * other file types are skipped.  The permissions and the modification time
+ * are taken from the host files, the owner and group are always zero.
+ *
+ * examples:
+ *     rtems-mkcromfs -b 8192 www www.img
+ *     rtems-bin2c -C www.img www_img
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include "cromfs-image.h"
+
+#define DEFAULT_BLOCK_SIZE 4096
+
+typedef struct {
+  char *path;
+  char *name;
+  struct stat st;
+  uint32_t parent;
+  uint32_t first;
+  uint32_t count;
+  uint32_t name_offset;
+  char *target;
+} node_t;
+
+static node_t *nodes;
+static uint32_t node_count;
+static uint32_t node_capacity;
+
+static uint8_t *image;
+static size_t image_size;
+static size_t image_capacity;
+
+static uint32_t block_size = DEFAULT_BLOCK_SIZE;
+static int level = Z_BEST_COMPRESSION;
+static int verbose;
+
+static void *xmalloc(size_t size)
+{
+  void *p = malloc(size);
+
+  if (p == NULL) {
+    fprintf(stderr, "error: out of memory\n");
+    exit(1);
+  }
+
+  return p;
+}
+
+static char *xstrdup(const char *s)
+{
+  return strcpy(xmalloc(strlen(s) + 1), s);
+}
+
+static char *join_path(const char *dir, const char *name)
+{
+  char *path = xmalloc(strlen(dir) + strlen(name) + 2);
+
+  sprintf(path, "%s/%s", dir, name);
+
+  return path;
+}
+
+static uint32_t add_node(const char *path, const char *name, uint32_t parent)
+{
+  node_t *node;
+
+  if (node_count == node_capacity) {
+    node_capacity = node_capacity != 0 ? 2 * node_capacity : 64;
+    nodes = realloc(nodes, node_capacity * sizeof(*nodes));
+    if (nodes == NULL) {
+      fprintf(stderr, "error: out of memory\n");
+      exit(1);
+    }
+  }
+
+  node = &nodes[node_count];
+  memset(node, 0, sizeof(*node));
+  node->path = xstrdup(path);
+  node->name = xstrdup(name);
+  node->parent = parent;
+
+  if (lstat(path, &node->st) != 0) {
+    fprintf(stderr, "error: %s: %s\n", path, strerror(errno));
+    exit(1);
+  }
+
+  return node_count++;
+}
+
+static int compare_names(const void *a, const void *b)
+{
+  return strcmp(*(char * const *) a, *(char * const *) b);
+}
+
+/*
+ * Adds the entries of a directory sorted by name, so that the nodes of a
+ * directory are contiguous in the node table.
+ */
+static void add_directory_entries(uint32_t index)
+{
+  const char *path = nodes[index].path;
+  DIR *dir = opendir(path);
+  struct dirent *de;
+  char **names = NULL;
+  size_t n = 0;
+  size_t i;
+
+  if (dir == NULL) {
+    fprintf(stderr, "error: %s: %s\n", path, strerror(errno));
+    exit(1);
+  }
+
+  while ((de = readdir(dir)) != NULL) {
+    if (strcmp(de->d_name, ".") == 0 || strcmp(de->d_name, "..") == 0) {
+      continue;
+    }
+
+    if (strlen(de->d_name) > RTEMS_CROMFS_NAME_MAX) {
+      fprintf(stderr, "error: %s/%s: name too long\n", path, de->d_name);
+      exit(1);
+    }
+
+    names = realloc(names, (n + 1) * sizeof(*names));
+    if (names == NULL) {
+      fprintf(stderr, "error: out of memory\n");
+      exit(1);
+    }
+
+    names[n] = xstrdup(de->d_name);
+    ++n;
+  }
+
+  closedir(dir);
+
+  qsort(names, n, sizeof(*names), compare_names);
+
+  nodes[index].first = node_count;
+
+  for (i = 0; i < n; ++i) {
+    char *child_path = join_path(path, names[i]);
+    struct stat st;
+
+    if (lstat(child_path, &st) != 0) {
+      fprintf(stderr, "error: %s: %s\n", child_path, strerror(errno));
+      exit(1);
+    }
+
+    if (S_ISDIR(st.st_mode) || S_ISREG(st.st_mode) || S_ISLNK(st.st_mode)) {
+      add_node(child_path, names[i], index);
+    } else {
+      fprintf(stderr, "warning: %s: unsupported file type, skipped\n",
+        child_path);
+    }
+
+    free(child_path);
+    free(names[i]);
+  }
+
+  free(names);
+
+  nodes[index].count = node_count - nodes[index].first;
+}
+
+static size_t image_reserve(size_t size)
+{
+  size_t offset = image_size;
+
+  if ((uint64_t) image_size + size > UINT32_MAX) {
+    fprintf(stderr, "error: image too large\n");
+    exit(1);
+  }
+
+  if (image_size + size > image_capacity) {
+    while (image_size + size > image_capacity) {
+      image_capacity = image_capacity != 0 ? 2 * image_capacity : 65536;
+    }
+
+    image = realloc(image, image_capacity);
+    if (image == NULL) {
+      fprintf(stderr, "error: out of memory\n");
+      exit(1);
+    }
+  }
+
+  memset(image + offset, 0, size);
+  image_size += size;
+
+  return offset;
+}
+
+static uint8_t *read_file(const node_t *node)
+{
+  size_t size = (size_t) node->st.st_size;
+  uint8_t *data = xmalloc(size + 1);
+  FILE *file = fopen(node->path, "rb");
+
+  if (file == NULL || fread(data, 1, size, file) != size) {
+    fprintf(stderr, "error: %s: cannot read file\n", node->path);
+    exit(1);
+  }
+
+  fclose(file);
+
+  return data;
+}
+
+/*
+ * Writes the blocks of a regular file to the data area and fills its block
+ * index.  A block is stored uncompressed if the compression does not save
+ * space.
+ */
+static void add_file_data(const node_t *node, size_t index_offset)
+{
+  uint32_t size = (uint32_t) node->st.st_size;
+  uint8_t *data = read_file(node);
+  uLongf bound = compressBound(block_size);
+  uint8_t *compressed = xmalloc(bound);
+  uint32_t block;
+  uint32_t offset = 0;
+
+  for (block = 0; block < node->count; ++block) {
+    uint32_t len = size - offset < block_size ? size - offset : block_size;
+    uLongf compressed_len = bound;
+    int z;
+    size_t data_offset;
+
+    z = compress2(compressed, &compressed_len, data + offset, len, level);
+    if (z != Z_OK) {
+      fprintf(stderr, "error: %s: compression failed\n", node->path);
+      exit(1);
+    }
+
+    rtems_cromfs_set_u32(
+      image + index_offset + 4 * block,
+      (uint32_t) image_size
+    );
+
+    if (compressed_len < len) {
+      data_offset = image_reserve(compressed_len);
+      memcpy(image + data_offset, compressed, compressed_len);
+    } else {
+      data_offset = image_reserve(len);
+      memcpy(image + data_offset, data + offset, len);
+    }
+
+    offset += len;
+  }
+
+  rtems_cromfs_set_u32(
+    image + index_offset + 4 * node->count,
+    (uint32_t) image_size
+  );
+
+  free(compressed);
+  free(data);
+}
+
+static size_t add_string(const char *s)
+{
+  size_t len = strlen(s) + 1;
+  size_t offset = image_reserve(len);
+
+  memcpy(image + offset, s, len);
+
+  return offset;
+}
+
+static char *read_link(const node_t *node)
+{
+  size_t size = (size_t) node->st.st_size + 1;
+  char *target = xmalloc(size);
+  ssize_t n = readlink(node->path, target, size);
+
+  if (n < 0 || (size_t) n >= size) {
+    fprintf(stderr, "error: %s: cannot read link\n", node->path);
+    exit(1);
+  }
+
+  target[n] = '\0';
+
+  return target;
+}
+
+static void create_image(const char *root)
+{
+  size_t node_offset;
+  size_t *first_offsets;
+  uint32_t i;
+
+  add_node(root, "", 0);
+  if (!S_ISDIR(nodes[0].st.st_mode)) {
+    fprintf(stderr, "error: %s: not a directory\n", root);
+    exit(1);
+  }
+
+  for (i = 0; i < node_count; ++i) {
+    node_t *node = &nodes[i];
+
+    if (S_ISDIR(node->st.st_mode)) {
+      add_directory_entries(i);
+    } else if (S_ISREG(node->st.st_mode)) {
+      if ((uint64_t) node->st.st_size > UINT32_MAX) {
+        fprintf(stderr, "error: %s: file too large\n", node->path);
+        exit(1);
+      }
+
+      node->count = (uint32_t)
+        (((uint64_t) node->st.st_size + block_size - 1) / block_size);
+    } else {
+      node->target = read_link(node);
+    }
+  }
+
+  first_offsets = xmalloc(node_count * sizeof(*first_offsets));
+
+  image_reserve(RTEMS_CROMFS_SB_SIZE);
+  node_offset = image_reserve(node_count * RTEMS_CROMFS_NODE_ENTRY_SIZE);
+
+  for (i = 0; i < node_count; ++i) {
+    node_t *node = &nodes[i];
+
+    node->name_offset = (uint32_t) add_string(node->name);
+
+    if (S_ISLNK(node->st.st_mode)) {
+      first_offsets[i] = add_string(node->target);
+    }
+  }
+
+  image_reserve((4 - image_size % 4) % 4);
+
+  for (i = 0; i < node_count; ++i) {
+    node_t *node = &nodes[i];
+
+    if (S_ISREG(node->st.st_mode)) {
+      first_offsets[i] = image_reserve(4 * ((size_t) node->count + 1));
+    }
+  }
+
+  rtems_cromfs_set_u32(
+    image + RTEMS_CROMFS_SB_DATA_OFFSET,
+    (uint32_t) image_size
+  );
+
+  for (i = 0; i < node_count; ++i) {
+    node_t *node = &nodes[i];
+    uint8_t *entry;
+    uint32_t size = 0;
+    uint32_t first = 0;
+
+    if (S_ISDIR(node->st.st_mode)) {
+      first = node->first;
+    } else if (S_ISREG(node->st.st_mode)) {
+      add_file_data(node, first_offsets[i]);
+      size = (uint32_t) node->st.st_size;
+      first = (uint32_t) first_offsets[i];
+    } else {
+      size = (uint32_t) strlen(node->target);
+      first = (uint32_t) first_offsets[i];
+    }
+
+    /* The file data may have moved the image */
+    entry = image + node_offset + i * RTEMS_CROMFS_NODE_ENTRY_SIZE;
+
+    rtems_cromfs_set_u32(entry + RTEMS_CROMFS_NODE_MODE, node->st.st_mode);
+    rtems_cromfs_set_u32(entry + RTEMS_CROMFS_NODE_OWNER, 0);
+    rtems_cromfs_set_u32(
+      entry + RTEMS_CROMFS_NODE_MTIME,
+      (uint32_t) node->st.st_mtime
+    );
+    rtems_cromfs_set_u32(entry + RTEMS_CROMFS_NODE_SIZE, size);
+    rtems_cromfs_set_u32(entry + RTEMS_CROMFS_NODE_NAME, node->name_offset);
+    rtems_cromfs_set_u32(entry + RTEMS_CROMFS_NODE_PARENT, node->parent);
+    rtems_cromfs_set_u32(entry + RTEMS_CROMFS_NODE_FIRST, first);
+    rtems_cromfs_set_u32(entry + RTEMS_CROMFS_NODE_COUNT, node->count);
+
+    if (verbose) {
+      printf("%s\n", node->path);
+    }
+  }
+
+  rtems_cromfs_set_u32(image + RTEMS_CROMFS_SB_MAGIC, RTEMS_CROMFS_MAGIC);
+  rtems_cromfs_set_u32(image + RTEMS_CROMFS_SB_VERSION, RTEMS_CROMFS_VERSION);
+  rtems_cromfs_set_u32(image + RTEMS_CROMFS_SB_BLOCK_SIZE, block_size);
+  rtems_cromfs_set_u32(image + RTEMS_CROMFS_SB_NODE_COUNT, node_count);
+  rtems_cromfs_set_u32(
+    image + RTEMS_CROMFS_SB_NODE_OFFSET,
+    (uint32_t) node_offset
+  );
+  rtems_cromfs_set_u32(
+    image + RTEMS_CROMFS_SB_IMAGE_SIZE,
+    (uint32_t) image_size
+  );
+
+  free(first_offsets);
+}
+
+static void write_image(const char *path)
+{
+  FILE *file = fopen(path, "wb");
+
+  if (
+    file == NULL
+      || fwrite(image, 1, image_size, file) != image_size
+      || fclose(file) != 0
+  ) {
+    fprintf(stderr, "error: %s: cannot write image\n", path);
+    exit(1);
+  }
+}
+
+static void usage(void)
+{
+  fprintf(stderr,
+    "usage: rtems-mkcromfs [-b block_size] [-l level] [-v] "
+      "<directory> <image>\n"
+    "  -b  block size in bytes, a power of two from %lu to %lu "
+      "(default %u)\n"
+    "  -l  zlib compression level from 1 to 9 (default %i)\n"
+    "  -v  verbose\n",
+    (unsigned long) RTEMS_CROMFS_MIN_BLOCK_SIZE,
+    (unsigned long) RTEMS_CROMFS_MAX_BLOCK_SIZE,
+    DEFAULT_BLOCK_SIZE,
+    Z_BEST_COMPRESSION
+  );
+  exit(1);
+}
+
+int main(int argc, char **argv)
+{
+  int c;
+
+  while ((c = getopt(argc, argv, "b:l:v")) != -1) {
+    switch (c) {
+      case 'b':
+        block_size = (uint32_t) strtoul(optarg, NULL, 0);
+        if (
+          block_size < RTEMS_CROMFS_MIN_BLOCK_SIZE
+            || block_size > RTEMS_CROMFS_MAX_BLOCK_SIZE
+            || (block_size & (block_size - 1)) != 0
+        ) {
+          usage();
+        }
+        break;
+      case 'l':
+        level = atoi(optarg);
+        if (level < 1 || level > 9) {
+          usage();
+        }
+        break;
+      case 'v':
+        verbose = 1;
+        break;
+      default:
+        usage();
+        break;
+    }
+  }
+
+  if (argc - optind != 2) {
+    usage();
+  }
+
+  create_image(argv[optind]);
+  write_image(argv[optind + 1]);
+
+  if (verbose) {
+    printf(
+      "%lu nodes, %lu bytes image\n",
+      (unsigned long) node_count,
+      (unsigned long) image_size
+    );
+  }
+
+  return 0;
+}